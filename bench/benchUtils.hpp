@@ -0,0 +1,84 @@
+/**
+ * @file benchUtils.hpp
+ * @brief Shared input generators and helpers for the benchmarks.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ */
+
+#ifndef BENCH_UTILS_HPP
+#define BENCH_UTILS_HPP
+
+/* Standard Library Includes */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+/* Project Includes */
+
+extern "C" {
+#include "huffmanCoding/huffmanTree.h"
+#include "huffmanCoding/task3.h"
+#include "huffmanCoding/task4.h"
+#include "huffmanCoding/task5.h"
+#include "huffmanCoding/task6.h"
+}
+
+/* Function Definitions */
+
+/**
+ * @brief Generate a NULL-free text drawn uniformly from an alphabet.
+ *
+ * Alphabets of up to 94 symbols use printable ASCII so the text also reads
+ * sensibly in a debugger, larger alphabets use the byte values 1 to 255.
+ *
+ * @param i_size The number of characters to generate.
+ * @param i_alphabetSize The number of distinct characters (1 to 255).
+ * @param i_seed The seed for the pseudo-random generator.
+ * @return std::string The generated text.
+ */
+inline std::string generateText(size_t i_size, size_t i_alphabetSize,
+                                uint32_t i_seed = 42) {
+  std::mt19937 generator(i_seed);
+  std::uniform_int_distribution<size_t> distribution(0, i_alphabetSize - 1);
+  const size_t firstSymbol = (i_alphabetSize <= 94) ? '!' : 1;
+
+  std::string text(i_size, '\0');
+  for (size_t i = 0; i < i_size; i++) {
+    text[i] = (char)(firstSymbol + distribution(generator));
+  }
+
+  /* Make sure every symbol of the alphabet is present at least once. */
+  for (size_t i = 0; i < i_alphabetSize && i < i_size; i++) {
+    text[i] = (char)(firstSymbol + i);
+  }
+
+  return text;
+}
+
+/**
+ * @brief Create a binary tree node list for the given text.
+ *
+ * @param i_text The text to count the letter frequencies of.
+ * @return sBinaryTreeListNode_t* The head of the binary tree node list, which
+ * owns the letter-frequency pairs of its nodes.
+ */
+inline sBinaryTreeListNode_t* createBinaryTreeNodeListFromText(
+    const std::string& i_text) {
+  sLetterFrequencyNode_t* psLetterFrequencyHead = NULL;
+  sBinaryTreeListNode_t* psHead = NULL;
+
+  if (createLetterFrequencyListFromText(&psLetterFrequencyHead,
+                                        i_text.c_str()) == EXIT_FAILURE ||
+      createBinaryTreeNodeListFromLetterFrequencyPairList(
+          &psHead, psLetterFrequencyHead) == EXIT_FAILURE) {
+    std::abort();
+  }
+
+  return psHead;
+}
+
+#endif /* BENCH_UTILS_HPP */
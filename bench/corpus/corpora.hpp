@@ -0,0 +1,257 @@
+/**
+ * @file corpora.hpp
+ * @brief Synthetic corpus generators for the end-to-end benchmarks.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ */
+
+#ifndef CORPORA_HPP
+#define CORPORA_HPP
+
+/* Standard Library Includes */
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+/* Type Definitions */
+
+/**
+ * @brief A named generator of synthetic data of a requested size.
+ */
+struct Corpus {
+  const char* name;
+  std::vector<uint8_t> (*generate)(size_t i_size, uint32_t i_seed);
+};
+
+/* Function Definitions */
+
+/**
+ * @brief Build Zipf weights 1 / rank^s for a number of ranks.
+ *
+ * @param i_count The number of ranks.
+ * @param i_exponent The Zipf exponent s.
+ * @return std::vector<double> The weight of each rank, starting at rank 1.
+ */
+inline std::vector<double> zipfWeights(size_t i_count, double i_exponent) {
+  std::vector<double> weights(i_count);
+  for (size_t i = 0; i < i_count; i++) {
+    weights[i] = 1.0 / std::pow((double)(i + 1), i_exponent);
+  }
+  return weights;
+}
+
+/**
+ * @brief Generate English-like prose from a Zipf distribution over common
+ * words, with capitalised sentences, punctuation and paragraphs.
+ *
+ * @param i_size The number of bytes to generate.
+ * @param i_seed The seed for the pseudo-random generator.
+ * @return std::vector<uint8_t> The generated text.
+ */
+inline std::vector<uint8_t> generateEnglishText(size_t i_size,
+                                                uint32_t i_seed) {
+  static const char* const WORDS[] = {
+      "the",     "of",      "and",    "to",       "a",      "in",
+      "is",      "you",     "that",   "it",       "he",     "was",
+      "for",     "on",      "are",    "as",       "with",   "his",
+      "they",    "I",       "at",     "be",       "this",   "have",
+      "from",    "or",      "one",    "had",      "by",     "word",
+      "but",     "not",     "what",   "all",      "were",   "we",
+      "when",    "your",    "can",    "said",     "there",  "use",
+      "an",      "each",    "which",  "she",      "do",     "how",
+      "their",   "if",      "will",   "up",       "other",  "about",
+      "out",     "many",    "then",   "them",     "these",  "so",
+      "some",    "her",     "would",  "make",     "like",   "him",
+      "into",    "time",    "has",    "look",     "two",    "more",
+      "write",   "go",      "see",    "number",   "no",     "way",
+      "could",   "people",  "my",     "than",     "first",  "water",
+      "been",    "call",    "who",    "oil",      "its",    "now",
+      "find",    "long",    "down",   "day",      "did",    "get",
+      "come",    "made",    "may",    "part",     "over",   "new",
+      "sound",   "take",    "only",   "little",   "work",   "know",
+      "place",   "year",    "live",   "me",       "back",   "give",
+      "most",    "very",    "after",  "thing",    "our",    "just",
+      "name",    "good",    "sentence", "man",    "think",  "say",
+      "great",   "where",   "help",   "through",  "much",   "before",
+      "line",    "right",   "too",    "mean",     "old",    "any",
+      "same",    "tell",    "boy",    "follow",   "came",   "want",
+      "show",    "also",    "around", "form",     "three",  "small",
+      "set",     "put",     "end",    "does",     "another", "well",
+      "large",   "must",    "big",    "even",     "such",   "because",
+      "turn",    "here",    "why",    "ask",      "went",   "men",
+      "read",    "need",    "land",   "different", "home",  "us",
+      "move",    "try",     "kind",   "hand",     "picture", "again",
+      "change",  "off",     "play",   "spell",    "air",    "away",
+      "animal",  "house",   "point",  "page",     "letter", "mother",
+      "answer",  "found",   "study",  "still",    "learn",  "should",
+      "America", "world",   "Huffman", "compression", "entropy", "symbol"};
+  const size_t wordCount = sizeof(WORDS) / sizeof(WORDS[0]);
+
+  std::mt19937 generator(i_seed);
+  const std::vector<double> weights = zipfWeights(wordCount, 1.0);
+  std::discrete_distribution<size_t> wordDistribution(weights.begin(),
+                                                      weights.end());
+  std::uniform_int_distribution<int> sentenceLength(4, 20);
+  std::uniform_int_distribution<int> percent(0, 99);
+
+  std::vector<uint8_t> text;
+  text.reserve(i_size + 64);
+  while (text.size() < i_size) {
+    const int words = sentenceLength(generator);
+    for (int i = 0; i < words; i++) {
+      std::string word = WORDS[wordDistribution(generator)];
+      if (i == 0) {
+        word[0] = (char)std::toupper((unsigned char)word[0]);
+      } else {
+        text.push_back(' ');
+      }
+      text.insert(text.end(), word.begin(), word.end());
+      if (i + 1 < words && percent(generator) < 8) {
+        text.push_back(',');
+      }
+    }
+
+    const int ending = percent(generator);
+    text.push_back(ending < 85 ? '.' : (ending < 95 ? '?' : '!'));
+    text.push_back(percent(generator) < 10 ? '\n' : ' ');
+  }
+
+  text.resize(i_size);
+  return text;
+}
+
+/**
+ * @brief Generate bytes whose frequencies follow a skewed Zipf distribution
+ * over all 256 byte values.
+ *
+ * @param i_size The number of bytes to generate.
+ * @param i_seed The seed for the pseudo-random generator.
+ * @return std::vector<uint8_t> The generated bytes.
+ */
+inline std::vector<uint8_t> generateZipfBytes(size_t i_size, uint32_t i_seed) {
+  std::mt19937 generator(i_seed);
+  const std::vector<double> weights = zipfWeights(256, 1.3);
+  std::discrete_distribution<int> distribution(weights.begin(), weights.end());
+
+  /* Scatter the ranks over the byte values. */
+  std::array<uint8_t, 256> symbols;
+  for (size_t i = 0; i < symbols.size(); i++) {
+    symbols[i] = (uint8_t)i;
+  }
+  std::shuffle(symbols.begin(), symbols.end(), generator);
+
+  std::vector<uint8_t> bytes(i_size);
+  for (uint8_t& byte : bytes) {
+    byte = symbols[(size_t)distribution(generator)];
+  }
+  return bytes;
+}
+
+/**
+ * @brief Generate uniformly random bytes, which cannot be compressed.
+ *
+ * @param i_size The number of bytes to generate.
+ * @param i_seed The seed for the pseudo-random generator.
+ * @return std::vector<uint8_t> The generated bytes.
+ */
+inline std::vector<uint8_t> generateUniformBytes(size_t i_size,
+                                                 uint32_t i_seed) {
+  std::mt19937_64 generator(i_seed);
+  std::vector<uint8_t> bytes(i_size);
+
+  for (size_t i = 0; i < i_size; i += sizeof(uint64_t)) {
+    const uint64_t word = generator();
+    for (size_t j = 0; j < sizeof(uint64_t) && i + j < i_size; j++) {
+      bytes[i + j] = (uint8_t)(word >> (8 * j));
+    }
+  }
+  return bytes;
+}
+
+/**
+ * @brief Generate a run of a single repeated symbol.
+ *
+ * @param i_size The number of bytes to generate.
+ * @param i_seed Unused.
+ * @return std::vector<uint8_t> The generated bytes.
+ */
+inline std::vector<uint8_t> generateSingleSymbol(size_t i_size,
+                                                 uint32_t i_seed) {
+  (void)i_seed;
+  return std::vector<uint8_t>(i_size, 'A');
+}
+
+/**
+ * @brief Generate service log lines mixing timestamps, levels, request paths,
+ * hexadecimal identifiers and free-text messages.
+ *
+ * @param i_size The number of bytes to generate.
+ * @param i_seed The seed for the pseudo-random generator.
+ * @return std::vector<uint8_t> The generated log text.
+ */
+inline std::vector<uint8_t> generateLogLines(size_t i_size, uint32_t i_seed) {
+  static const char* const LEVELS[] = {"INFO", "INFO", "INFO", "DEBUG",
+                                       "WARN", "ERROR"};
+  static const char* const METHODS[] = {"GET", "GET", "GET", "POST", "PUT",
+                                        "DELETE"};
+  static const char* const PATHS[] = {
+      "/api/v1/users",  "/api/v1/orders", "/api/v1/search", "/healthz",
+      "/api/v2/events", "/static/app.js", "/api/v1/login",  "/metrics"};
+  static const int STATUSES[] = {200, 200, 200, 200, 201, 204,
+                                 301, 404, 500, 503};
+  static const char* const MESSAGES[] = {
+      "request completed",       "cache miss, fetching from origin",
+      "retrying upstream call",  "slow query detected",
+      "connection reset by peer", "user session refreshed"};
+
+  std::mt19937 generator(i_seed);
+  std::uniform_int_distribution<int> small(0, 5);
+  std::uniform_int_distribution<int> path(0, 7);
+  std::uniform_int_distribution<int> status(0, 9);
+  std::uniform_int_distribution<int> latency(1, 900);
+  std::uniform_int_distribution<int> octet(0, 255);
+  std::uniform_int_distribution<uint32_t> id;
+  std::uniform_int_distribution<int> step(0, 250);
+
+  std::vector<uint8_t> text;
+  text.reserve(i_size + 256);
+  long long milliseconds = 0;
+  char line[256];
+  while (text.size() < i_size) {
+    milliseconds += step(generator);
+    const long long seconds = milliseconds / 1000;
+    const int length = std::snprintf(
+        line, sizeof(line),
+        "2026-10-19T%02lld:%02lld:%02lld.%03lldZ %-5s [worker-%d] %s %s/%u "
+        "%d %dms ip=10.%d.%d.%d req=%08x%08x msg=\"%s\"\n",
+        (seconds / 3600) % 24, (seconds / 60) % 60, seconds % 60,
+        milliseconds % 1000, LEVELS[small(generator)], small(generator),
+        METHODS[small(generator)], PATHS[path(generator)],
+        id(generator) % 100000, STATUSES[status(generator)],
+        latency(generator), octet(generator), octet(generator),
+        octet(generator), id(generator), id(generator),
+        MESSAGES[small(generator)]);
+    text.insert(text.end(), line, line + length);
+  }
+
+  text.resize(i_size);
+  return text;
+}
+
+/**< The synthetic corpora, in the order they are reported. */
+inline const Corpus SYNTHETIC_CORPORA[] = {
+    {"english", generateEnglishText},   {"zipf", generateZipfBytes},
+    {"uniform", generateUniformBytes},  {"single", generateSingleSymbol},
+    {"logs", generateLogLines},
+};
+
+#endif /* CORPORA_HPP */
@@ -0,0 +1,387 @@
+/**
+ * @file main.cpp
+ * @brief End-to-end compression throughput and ratio benchmark driver.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ * Each corpus, synthetic or read from the data directory, is run in its own
+ * child process so that the reported peak resident set size belongs to that
+ * corpus alone. Results are printed as a table and written as JSON.
+ */
+
+/* Standard Library Includes */
+
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+/* Project Includes */
+
+#include "corpus/corpora.hpp"
+
+extern "C" {
+#include "huffmanCoding/codec.h"
+#include "huffmanCoding/stats.h"
+}
+
+/* Type Definitions */
+
+/**
+ * @brief Settings parsed from the command line.
+ */
+struct Settings {
+  size_t corpusSize = (size_t)16 * 1024 * 1024;
+  size_t blockSize = HUFFMAN_DEFAULT_BLOCK_SIZE;
+  int iterations = 5;
+  std::string dataDirectory = HUFFMAN_DATA_DIR;
+  std::string jsonPath = "corpus_results.json";
+};
+
+/**
+ * @brief Measurements of one corpus, passed from the child process.
+ */
+struct Result {
+  char name[64];
+  size_t inputSize;
+  size_t compressedSize;
+  double compressSeconds;
+  double decompressSeconds;
+  long peakRssKiB;
+  bool verified;
+  bool failed;
+  sHuffmanStats_t stats;
+};
+
+/* Function Definitions */
+
+/**
+ * @brief Print the command line usage.
+ *
+ * @param i_program The name of the program.
+ */
+static void printUsage(const char* i_program) {
+  std::fprintf(stderr,
+               "Usage: %s [--size BYTES] [--block-size BYTES] "
+               "[--iterations N] [--data-dir DIR] [--json PATH]\n",
+               i_program);
+}
+
+/**
+ * @brief Parse the command line into settings.
+ *
+ * @param argc Number of command line arguments.
+ * @param argv Command line arguments.
+ * @param o_settings The parsed settings.
+ * @return bool true if the command line is valid.
+ */
+static bool parseArguments(int argc, char** argv, Settings& o_settings) {
+  for (int i = 1; i < argc; i++) {
+    const std::string argument = argv[i];
+    if (i + 1 >= argc) {
+      return false;
+    }
+    const char* value = argv[++i];
+
+    if (argument == "--size") {
+      o_settings.corpusSize = std::strtoull(value, NULL, 10);
+    } else if (argument == "--block-size") {
+      o_settings.blockSize = std::strtoull(value, NULL, 10);
+    } else if (argument == "--iterations") {
+      o_settings.iterations = std::max(1, std::atoi(value));
+    } else if (argument == "--data-dir") {
+      o_settings.dataDirectory = value;
+    } else if (argument == "--json") {
+      o_settings.jsonPath = value;
+    } else {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * @brief Read a whole file into memory.
+ *
+ * @param i_path The path of the file.
+ * @return std::vector<uint8_t> The contents of the file.
+ */
+static std::vector<uint8_t> readFile(const std::filesystem::path& i_path) {
+  std::ifstream file(i_path, std::ios::binary);
+  return std::vector<uint8_t>(std::istreambuf_iterator<char>(file),
+                              std::istreambuf_iterator<char>());
+}
+
+/**
+ * @brief Time the best of several compress and decompress round trips.
+ *
+ * @param i_input The bytes to compress.
+ * @param i_settings The benchmark settings.
+ * @param io_result The result to fill in.
+ */
+static void measureRoundTrip(const std::vector<uint8_t>& i_input,
+                             const Settings& i_settings, Result& io_result) {
+  using Clock = std::chrono::steady_clock;
+
+  sHuffmanCompressOptions_t sOptions;
+  initCompressOptions(&sOptions);
+  sOptions.blockSize = i_settings.blockSize;
+
+  std::vector<uint8_t> compressed(
+      getCompressBound(i_input.size(), &sOptions));
+  std::vector<uint8_t> decompressed(i_input.size());
+  size_t compressedSize = 0;
+  size_t decompressedSize = 0;
+
+  io_result.inputSize = i_input.size();
+  io_result.compressSeconds = 1e300;
+  io_result.decompressSeconds = 1e300;
+
+  for (int i = 0; i < i_settings.iterations; i++) {
+    const Clock::time_point start = Clock::now();
+    if (compressBuffer(i_input.data(), i_input.size(), compressed.data(),
+                       compressed.size(), &compressedSize,
+                       &sOptions) == EXIT_FAILURE) {
+      io_result.failed = true;
+      return;
+    }
+    const Clock::time_point end = Clock::now();
+    io_result.compressSeconds = std::min(
+        io_result.compressSeconds,
+        std::chrono::duration<double>(end - start).count());
+  }
+  io_result.compressedSize = compressedSize;
+
+  for (int i = 0; i < i_settings.iterations; i++) {
+    const Clock::time_point start = Clock::now();
+    if (decompressBuffer(compressed.data(), compressedSize,
+                         decompressed.data(), decompressed.size(),
+                         &decompressedSize) == EXIT_FAILURE) {
+      io_result.failed = true;
+      return;
+    }
+    const Clock::time_point end = Clock::now();
+    io_result.decompressSeconds = std::min(
+        io_result.decompressSeconds,
+        std::chrono::duration<double>(end - start).count());
+  }
+
+  io_result.verified = (decompressedSize == i_input.size() &&
+                        std::equal(i_input.begin(), i_input.end(),
+                                   decompressed.begin()));
+}
+
+/**
+ * @brief Run one corpus in a child process.
+ *
+ * @param i_name The name of the corpus.
+ * @param i_load Produces the corpus bytes inside the child process.
+ * @param i_settings The benchmark settings.
+ * @return Result The measurements of the corpus.
+ */
+template <typename Loader>
+static Result runCorpus(const std::string& i_name, const Loader& i_load,
+                        const Settings& i_settings) {
+  Result result = {};
+  (void)std::snprintf(result.name, sizeof(result.name), "%s", i_name.c_str());
+  result.failed = true;
+
+  int pipeFds[2];
+  if (pipe(pipeFds) != 0) {
+    std::perror("ERROR");
+    return result;
+  }
+
+  const pid_t child = fork();
+  if (child < 0) {
+    std::perror("ERROR");
+    (void)close(pipeFds[0]);
+    (void)close(pipeFds[1]);
+    return result;
+  }
+
+  if (child == 0) {
+    (void)close(pipeFds[0]);
+    result.failed = false;
+    resetHuffmanStats();
+    measureRoundTrip(i_load(), i_settings, result);
+    getHuffmanStats(&result.stats);
+    const ssize_t written = write(pipeFds[1], &result, sizeof(result));
+    _exit(written == (ssize_t)sizeof(result) ? EXIT_SUCCESS : EXIT_FAILURE);
+  }
+
+  (void)close(pipeFds[1]);
+  Result childResult = {};
+  const ssize_t bytesRead = read(pipeFds[0], &childResult, sizeof(childResult));
+  (void)close(pipeFds[0]);
+
+  int status = 0;
+  struct rusage usage = {};
+  (void)wait4(child, &status, 0, &usage);
+
+  if (bytesRead != (ssize_t)sizeof(childResult) || !WIFEXITED(status) ||
+      WEXITSTATUS(status) != EXIT_SUCCESS) {
+    return result;
+  }
+
+#ifdef __APPLE__
+  /* macOS reports the maximum resident set size in bytes. */
+  childResult.peakRssKiB = usage.ru_maxrss / 1024;
+#else
+  childResult.peakRssKiB = usage.ru_maxrss;
+#endif
+  return childResult;
+}
+
+/**
+ * @brief Convert a size and duration into megabytes per second.
+ *
+ * @param i_bytes The number of bytes processed.
+ * @param i_seconds The time taken.
+ * @return double The throughput in MB/s.
+ */
+static double megabytesPerSecond(size_t i_bytes, double i_seconds) {
+  return (i_seconds > 0.0) ? ((double)i_bytes / 1e6) / i_seconds : 0.0;
+}
+
+/**
+ * @brief Find the compression ratio of a result.
+ *
+ * @param i_result The measurements of a corpus.
+ * @return double The uncompressed size divided by the compressed size.
+ */
+static double compressionRatio(const Result& i_result) {
+  return (i_result.compressedSize > 0)
+             ? (double)i_result.inputSize / (double)i_result.compressedSize
+             : 0.0;
+}
+
+/**
+ * @brief Print the results as a table.
+ *
+ * @param i_results The measurements of each corpus.
+ */
+static void printTable(const std::vector<Result>& i_results) {
+  std::printf("%-24s %12s %12s %8s %12s %12s %10s %8s\n", "corpus", "bytes",
+              "compressed", "ratio", "comp MB/s", "decomp MB/s", "peak KiB",
+              "verified");
+  for (const Result& result : i_results) {
+    if (result.failed) {
+      std::printf("%-24s %12s\n", result.name, "FAILED");
+      continue;
+    }
+    std::printf("%-24s %12zu %12zu %8.3f %12.1f %12.1f %10ld %8s\n",
+                result.name, result.inputSize, result.compressedSize,
+                compressionRatio(result),
+                megabytesPerSecond(result.inputSize, result.compressSeconds),
+                megabytesPerSecond(result.inputSize, result.decompressSeconds),
+                result.peakRssKiB, result.verified ? "yes" : "NO");
+  }
+}
+
+/**
+ * @brief Write the results as JSON.
+ *
+ * @param i_results The measurements of each corpus.
+ * @param i_settings The benchmark settings.
+ * @return bool true if the file was written.
+ */
+static bool writeJson(const std::vector<Result>& i_results,
+                      const Settings& i_settings) {
+  FILE* pFile = std::fopen(i_settings.jsonPath.c_str(), "w");
+  if (pFile == NULL) {
+    std::perror("ERROR");
+    return false;
+  }
+
+  std::fprintf(pFile,
+               "{\n  \"block_size\": %zu,\n  \"iterations\": %d,\n"
+               "  \"corpora\": [\n",
+               i_settings.blockSize, i_settings.iterations);
+  for (size_t i = 0; i < i_results.size(); i++) {
+    const Result& result = i_results[i];
+    std::fprintf(
+        pFile,
+        "    {\"name\": \"%s\", \"failed\": %s, \"bytes\": %zu, "
+        "\"compressed_bytes\": %zu, \"ratio\": %.6f, "
+        "\"compress_mb_per_s\": %.3f, \"decompress_mb_per_s\": %.3f, "
+        "\"peak_rss_kib\": %ld, \"verified\": %s",
+        result.name, result.failed ? "true" : "false", result.inputSize,
+        result.compressedSize, compressionRatio(result),
+        megabytesPerSecond(result.inputSize, result.compressSeconds),
+        megabytesPerSecond(result.inputSize, result.decompressSeconds),
+        result.peakRssKiB, result.verified ? "true" : "false");
+
+    /* Statistics accumulate over every iteration of the round trip. */
+    if (isHuffmanStatsEnabled()) {
+      std::fprintf(pFile, ", \"stats\": ");
+      (void)writeHuffmanStatsJson(pFile, &result.stats);
+    }
+    std::fprintf(pFile, "}%s\n", (i + 1 < i_results.size()) ? "," : "");
+  }
+  std::fprintf(pFile, "  ]\n}\n");
+
+  return std::fclose(pFile) == 0;
+}
+
+/**
+ * @brief Program entry function.
+ *
+ * Runs a compress and decompress round trip over every synthetic corpus and
+ * every file in the data directory.
+ *
+ * @param argc Number of command line arguments.
+ * @param argv Command line arguments.
+ * @return int EXIT_SUCCESS if every corpus round-tripped, else EXIT_FAILURE.
+ */
+int main(int argc, char** argv) {
+  Settings settings;
+  if (!parseArguments(argc, argv, settings)) {
+    printUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  std::vector<Result> results;
+  for (const Corpus& corpus : SYNTHETIC_CORPORA) {
+    results.push_back(runCorpus(
+        corpus.name,
+        [&]() { return corpus.generate(settings.corpusSize, 42); }, settings));
+  }
+
+  /* Add any files dropped into the data directory, in name order. */
+  std::vector<std::filesystem::path> files;
+  std::error_code error;
+  for (const auto& entry :
+       std::filesystem::directory_iterator(settings.dataDirectory, error)) {
+    if (entry.is_regular_file()) {
+      files.push_back(entry.path());
+    }
+  }
+  std::sort(files.begin(), files.end());
+  for (const std::filesystem::path& file : files) {
+    results.push_back(runCorpus("data/" + file.filename().string(),
+                                [&]() { return readFile(file); }, settings));
+  }
+
+  printTable(results);
+  const bool written = writeJson(results, settings);
+
+  const bool allVerified =
+      std::all_of(results.begin(), results.end(), [](const Result& result) {
+        return !result.failed && result.verified;
+      });
+  return (written && allVerified) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
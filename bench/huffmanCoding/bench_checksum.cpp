@@ -0,0 +1,132 @@
+/**
+ * @file bench_checksum.cpp
+ * @brief Benchmarks for checksum.c and the cost of block checksums.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ */
+
+/* External Includes */
+
+#include <benchmark/benchmark.h>
+
+/* Standard Library Includes */
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+/* Project Includes */
+
+#include "benchUtils.hpp"
+
+extern "C" {
+#include "huffmanCoding/checksum.h"
+#include "huffmanCoding/codec.h"
+}
+
+/* Constants */
+
+/**< The number of uncompressed bytes in each codec benchmark input. */
+static const size_t INPUT_SIZE = (size_t)1 << 20;
+
+/* Benchmarks */
+
+/**
+ * @brief Benchmark checksumming a buffer with each checksum kernel.
+ *
+ * @param state The benchmark state, range(0) is the checksum kernel and
+ * range(1) the input size.
+ */
+static void BM_updateCrc32c(benchmark::State& state) {
+  const eHuffmanChecksumKernel_t eKernel =
+      (eHuffmanChecksumKernel_t)state.range(0);
+  state.SetLabel(getChecksumKernelName(eKernel));
+  const eHuffmanChecksumKernel_t ePrevious = getChecksumKernel();
+  if (setChecksumKernel(eKernel) == EXIT_FAILURE) {
+    state.SkipWithError("Checksum kernel is not supported");
+    return;
+  }
+
+  const std::string text = generateText((size_t)state.range(1), 64);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        updateCrc32c(0, (const uint8_t*)text.data(), text.size()));
+  }
+
+  (void)setChecksumKernel(ePrevious);
+  state.SetBytesProcessed((int64_t)state.iterations() * state.range(1));
+}
+BENCHMARK(BM_updateCrc32c)
+    ->ArgsProduct({{HUFFMAN_CHECKSUM_KERNEL_PORTABLE,
+                    HUFFMAN_CHECKSUM_KERNEL_SSE42},
+                   {4096, 256 * 1024}});
+
+/**
+ * @brief Benchmark compressing with and without block checksums.
+ *
+ * @param state The benchmark state, range(0) is whether checksums are
+ * enabled and range(1) the alphabet size.
+ */
+static void BM_compressChecksum(benchmark::State& state) {
+  const std::string text = generateText(INPUT_SIZE, (size_t)state.range(1));
+  sHuffmanCompressOptions_t sOptions;
+  initCompressOptions(&sOptions);
+  sOptions.isChecksumEnabled = (state.range(0) != 0);
+  state.SetLabel(sOptions.isChecksumEnabled ? "checksum" : "none");
+  std::vector<uint8_t> output(getCompressBound(text.size(), &sOptions));
+  size_t outputSize = 0;
+  sHuffmanContext_t* psContext = createHuffmanContext(NULL);
+
+  for (auto _ : state) {
+    if (compressBufferWithContext(psContext, (const uint8_t*)text.data(),
+                                  text.size(), output.data(), output.size(),
+                                  &outputSize, &sOptions) == EXIT_FAILURE) {
+      state.SkipWithError("Unable to compress the buffer");
+      break;
+    }
+    benchmark::DoNotOptimize(output.data());
+  }
+
+  freeHuffmanContext(psContext);
+  state.SetBytesProcessed((int64_t)(state.iterations() * INPUT_SIZE));
+}
+BENCHMARK(BM_compressChecksum)->ArgsProduct({{0, 1}, {4, 64}});
+
+/**
+ * @brief Benchmark decompressing with and without block checksums.
+ *
+ * @param state The benchmark state, range(0) is whether checksums are
+ * enabled and range(1) the alphabet size.
+ */
+static void BM_decompressChecksum(benchmark::State& state) {
+  const std::string text = generateText(INPUT_SIZE, (size_t)state.range(1));
+  sHuffmanCompressOptions_t sOptions;
+  initCompressOptions(&sOptions);
+  sOptions.isChecksumEnabled = (state.range(0) != 0);
+  state.SetLabel(sOptions.isChecksumEnabled ? "checksum" : "none");
+  std::vector<uint8_t> compressed(getCompressBound(text.size(), &sOptions));
+  std::vector<uint8_t> output(text.size());
+  size_t compressedSize = 0;
+  size_t outputSize = 0;
+  (void)compressBuffer((const uint8_t*)text.data(), text.size(),
+                       compressed.data(), compressed.size(), &compressedSize,
+                       &sOptions);
+  sHuffmanContext_t* psContext = createHuffmanContext(NULL);
+
+  for (auto _ : state) {
+    if (decompressBufferWithContext(psContext, compressed.data(),
+                                    compressedSize, output.data(),
+                                    output.size(),
+                                    &outputSize) == EXIT_FAILURE) {
+      state.SkipWithError("Unable to decompress the buffer");
+      break;
+    }
+    benchmark::DoNotOptimize(output.data());
+  }
+
+  freeHuffmanContext(psContext);
+  state.SetBytesProcessed((int64_t)(state.iterations() * INPUT_SIZE));
+}
+BENCHMARK(BM_decompressChecksum)->ArgsProduct({{0, 1}, {4, 64}});
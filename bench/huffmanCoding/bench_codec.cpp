@@ -0,0 +1,351 @@
+/**
+ * @file bench_codec.cpp
+ * @brief Benchmarks for codec.c.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ */
+
+/* External Includes */
+
+#include <benchmark/benchmark.h>
+
+/* Standard Library Includes */
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+/* Project Includes */
+
+#include "benchUtils.hpp"
+#include "testUtils.hpp"
+
+extern "C" {
+#include "huffmanCoding/codec.h"
+}
+
+/* Constants */
+
+/**< The number of buffers in each batch. */
+static const size_t BATCH_COUNT = 256;
+
+
+/* Helper Functions */
+
+/**
+ * @brief Generate a batch of small text buffers.
+ *
+ * @param i_bufferSize The number of bytes in each buffer.
+ * @return std::vector<std::string> The buffers.
+ */
+static std::vector<std::string> generateBatch(size_t i_bufferSize) {
+  const std::string text = generateText(i_bufferSize * BATCH_COUNT, 64);
+  std::vector<std::string> buffers;
+  for (size_t i = 0; i < BATCH_COUNT; i++) {
+    buffers.push_back(text.substr(i * i_bufferSize, i_bufferSize));
+  }
+  return buffers;
+}
+
+/* Benchmarks */
+
+/**
+ * @brief Benchmark compressing a buffer with compressBuffer, which builds its
+ * trees from freshly allocated lists on every call.
+ *
+ * @param state The benchmark state, range(0) is the input size.
+ */
+static void BM_compressBuffer(benchmark::State& state) {
+  const std::string text = generateText((size_t)state.range(0), 64);
+  std::vector<uint8_t> output(getCompressBound(text.size(), NULL));
+  size_t outputSize = 0;
+
+  for (auto _ : state) {
+    if (compressBuffer((const uint8_t*)text.data(), text.size(), output.data(),
+                       output.size(), &outputSize, NULL) == EXIT_FAILURE) {
+      state.SkipWithError("Unable to compress the buffer");
+      break;
+    }
+    benchmark::DoNotOptimize(output.data());
+  }
+
+  state.SetBytesProcessed((int64_t)state.iterations() * state.range(0));
+}
+BENCHMARK(BM_compressBuffer)->Arg(64)->Arg(1024)->Arg(16 * 1024);
+
+/**
+ * @brief Benchmark compressing a buffer with a reused context.
+ *
+ * @param state The benchmark state, range(0) is the input size.
+ */
+static void BM_compressBufferWithContext(benchmark::State& state) {
+  const std::string text = generateText((size_t)state.range(0), 64);
+  std::vector<uint8_t> output(getCompressBound(text.size(), NULL));
+  size_t outputSize = 0;
+  sHuffmanContext_t* psContext = createHuffmanContext(NULL);
+
+  for (auto _ : state) {
+    if (compressBufferWithContext(psContext, (const uint8_t*)text.data(),
+                                  text.size(), output.data(), output.size(),
+                                  &outputSize, NULL) == EXIT_FAILURE) {
+      state.SkipWithError("Unable to compress the buffer");
+      break;
+    }
+    benchmark::DoNotOptimize(output.data());
+  }
+
+  freeHuffmanContext(psContext);
+  state.SetBytesProcessed((int64_t)state.iterations() * state.range(0));
+}
+BENCHMARK(BM_compressBufferWithContext)->Arg(64)->Arg(1024)->Arg(16 * 1024);
+
+/**
+ * @brief Benchmark decompressing a buffer with decompressBuffer.
+ *
+ * @param state The benchmark state, range(0) is the input size.
+ */
+static void BM_decompressBuffer(benchmark::State& state) {
+  const std::string text = generateText((size_t)state.range(0), 64);
+  std::vector<uint8_t> compressed(getCompressBound(text.size(), NULL));
+  std::vector<uint8_t> output(text.size());
+  size_t compressedSize = 0;
+  size_t outputSize = 0;
+  (void)compressBuffer((const uint8_t*)text.data(), text.size(),
+                       compressed.data(), compressed.size(), &compressedSize,
+                       NULL);
+
+  for (auto _ : state) {
+    if (decompressBuffer(compressed.data(), compressedSize, output.data(),
+                         output.size(), &outputSize) == EXIT_FAILURE) {
+      state.SkipWithError("Unable to decompress the buffer");
+      break;
+    }
+    benchmark::DoNotOptimize(output.data());
+  }
+
+  state.SetBytesProcessed((int64_t)state.iterations() * state.range(0));
+}
+BENCHMARK(BM_decompressBuffer)->Arg(64)->Arg(1024)->Arg(16 * 1024);
+
+/**
+ * @brief Benchmark decompressing a buffer with a reused context, which keeps
+ * its decode table between calls.
+ *
+ * @param state The benchmark state, range(0) is the input size.
+ */
+static void BM_decompressBufferWithContext(benchmark::State& state) {
+  const std::string text = generateText((size_t)state.range(0), 64);
+  std::vector<uint8_t> compressed(getCompressBound(text.size(), NULL));
+  std::vector<uint8_t> output(text.size());
+  size_t compressedSize = 0;
+  size_t outputSize = 0;
+  (void)compressBuffer((const uint8_t*)text.data(), text.size(),
+                       compressed.data(), compressed.size(), &compressedSize,
+                       NULL);
+  sHuffmanContext_t* psContext = createHuffmanContext(NULL);
+
+  for (auto _ : state) {
+    if (decompressBufferWithContext(psContext, compressed.data(),
+                                    compressedSize, output.data(),
+                                    output.size(),
+                                    &outputSize) == EXIT_FAILURE) {
+      state.SkipWithError("Unable to decompress the buffer");
+      break;
+    }
+    benchmark::DoNotOptimize(output.data());
+  }
+
+  freeHuffmanContext(psContext);
+  state.SetBytesProcessed((int64_t)state.iterations() * state.range(0));
+}
+BENCHMARK(BM_decompressBufferWithContext)->Arg(64)->Arg(1024)->Arg(16 * 1024);
+
+/**
+ * @brief Benchmark compressing a batch of small buffers one at a time with a
+ * reused context.
+ *
+ * @param state The benchmark state, range(0) is the size of each buffer.
+ */
+static void BM_compressBuffersWithContext(benchmark::State& state) {
+  const std::vector<std::string> buffers =
+      generateBatch((size_t)state.range(0));
+  std::vector<uint8_t> output(getCompressBound(buffers[0].size(), NULL));
+  size_t outputSize = 0;
+  sHuffmanContext_t* psContext = createHuffmanContext(NULL);
+
+  for (auto _ : state) {
+    for (const std::string& buffer : buffers) {
+      if (compressBufferWithContext(psContext, (const uint8_t*)buffer.data(),
+                                    buffer.size(), output.data(), output.size(),
+                                    &outputSize, NULL) == EXIT_FAILURE) {
+        state.SkipWithError("Unable to compress the buffer");
+        break;
+      }
+      benchmark::DoNotOptimize(output.data());
+    }
+  }
+
+  freeHuffmanContext(psContext);
+  state.SetBytesProcessed((int64_t)(state.iterations() * BATCH_COUNT) *
+                          state.range(0));
+}
+BENCHMARK(BM_compressBuffersWithContext)->Arg(16)->Arg(64)->Arg(256);
+
+/**
+ * @brief Benchmark compressing a batch of small buffers with one shared
+ * table.
+ *
+ * @param state The benchmark state, range(0) is the size of each buffer.
+ */
+static void BM_compressBatchWithContext(benchmark::State& state) {
+  const std::vector<std::string> buffers =
+      generateBatch((size_t)state.range(0));
+  std::vector<const uint8_t*> inputs;
+  std::vector<size_t> inputSizes;
+  for (const std::string& buffer : buffers) {
+    inputs.push_back((const uint8_t*)buffer.data());
+    inputSizes.push_back(buffer.size());
+  }
+  std::vector<uint8_t> output(
+      getBatchCompressBound(BATCH_COUNT, BATCH_COUNT * state.range(0)));
+  std::vector<size_t> offsets(BATCH_COUNT + 1);
+  size_t outputSize = 0;
+  sHuffmanContext_t* psContext = createHuffmanContext(NULL);
+
+  for (auto _ : state) {
+    if (compressBatchWithContext(psContext, inputs.data(), inputSizes.data(),
+                                 BATCH_COUNT, output.data(), output.size(),
+                                 offsets.data(), &outputSize) == EXIT_FAILURE) {
+      state.SkipWithError("Unable to compress the batch");
+      break;
+    }
+    benchmark::DoNotOptimize(output.data());
+  }
+
+  freeHuffmanContext(psContext);
+  state.SetBytesProcessed((int64_t)(state.iterations() * BATCH_COUNT) *
+                          state.range(0));
+}
+BENCHMARK(BM_compressBatchWithContext)->Arg(16)->Arg(64)->Arg(256);
+
+/**
+ * @brief Benchmark decompressing a batch of small buffers with one shared
+ * table.
+ *
+ * @param state The benchmark state, range(0) is the size of each buffer.
+ */
+static void BM_decompressBatchWithContext(benchmark::State& state) {
+  const std::vector<std::string> buffers =
+      generateBatch((size_t)state.range(0));
+  std::vector<const uint8_t*> inputs;
+  std::vector<size_t> inputSizes;
+  for (const std::string& buffer : buffers) {
+    inputs.push_back((const uint8_t*)buffer.data());
+    inputSizes.push_back(buffer.size());
+  }
+  std::vector<uint8_t> compressed(
+      getBatchCompressBound(BATCH_COUNT, BATCH_COUNT * state.range(0)));
+  std::vector<uint8_t> output(BATCH_COUNT * state.range(0));
+  std::vector<size_t> offsets(BATCH_COUNT + 1);
+  size_t compressedSize = 0;
+  size_t outputSize = 0;
+  sHuffmanContext_t* psContext = createHuffmanContext(NULL);
+  (void)compressBatchWithContext(psContext, inputs.data(), inputSizes.data(),
+                                 BATCH_COUNT, compressed.data(),
+                                 compressed.size(), NULL, &compressedSize);
+
+  for (auto _ : state) {
+    if (decompressBatchWithContext(psContext, compressed.data(),
+                                   compressedSize, output.data(),
+                                   output.size(), offsets.data(),
+                                   &outputSize) == EXIT_FAILURE) {
+      state.SkipWithError("Unable to decompress the batch");
+      break;
+    }
+    benchmark::DoNotOptimize(output.data());
+  }
+
+  freeHuffmanContext(psContext);
+  state.SetBytesProcessed((int64_t)(state.iterations() * BATCH_COUNT) *
+                          state.range(0));
+}
+BENCHMARK(BM_decompressBatchWithContext)->Arg(16)->Arg(64)->Arg(256);
+
+/**
+ * @brief Benchmark decompressing 256-byte ranges from the middle of a 1 MiB
+ * block with a reused context.
+ *
+ * @param state The benchmark state, range(0) is the sync interval, or 0 for
+ * none.
+ */
+static void BM_decompressRangeWithContext(benchmark::State& state) {
+  const std::string text = generateText((size_t)1 << 20, 64);
+  sHuffmanCompressOptions_t sOptions;
+  initCompressOptions(&sOptions);
+  sOptions.blockSize = text.size();
+  sOptions.syncInterval = (size_t)state.range(0);
+  std::vector<uint8_t> compressed(getCompressBound(text.size(), &sOptions));
+  size_t compressedSize = 0;
+  (void)compressBuffer((const uint8_t*)text.data(), text.size(),
+                       compressed.data(), compressed.size(), &compressedSize,
+                       &sOptions);
+  sHuffmanContext_t* psContext = createHuffmanContext(NULL);
+  std::vector<uint8_t> output(256);
+  size_t offset = 0;
+
+  for (auto _ : state) {
+    offset = (offset + 40503) % (text.size() - output.size());
+    if (decompressRangeWithContext(psContext, compressed.data(),
+                                   compressedSize, offset, output.size(),
+                                   output.data()) == EXIT_FAILURE) {
+      state.SkipWithError("Unable to decompress the range");
+      break;
+    }
+    benchmark::DoNotOptimize(output.data());
+  }
+
+  freeHuffmanContext(psContext);
+  state.SetBytesProcessed((int64_t)(state.iterations() * output.size()));
+}
+BENCHMARK(BM_decompressRangeWithContext)->Arg(0)->Arg(1024)->Arg(4096);
+
+/**
+ * @brief Benchmark decompressing 1 MiB of geometric bytes, whose rare
+ * symbols are decoded with the nibble tree.
+ *
+ * @param state The benchmark state, range(0) is the distribution's parameter
+ * in percent and range(1) is whether to reuse a context.
+ */
+static void BM_decompressSkewed(benchmark::State& state) {
+  const std::vector<uint8_t> input = generateGeometricBytes(
+      (size_t)1 << 20, (double)state.range(0) / 100.0, 50);
+  std::vector<uint8_t> compressed(getCompressBound(input.size(), NULL));
+  std::vector<uint8_t> output(input.size());
+  size_t compressedSize = 0;
+  size_t outputSize = 0;
+  (void)compressBuffer(input.data(), input.size(), compressed.data(),
+                       compressed.size(), &compressedSize, NULL);
+  sHuffmanContext_t* psContext =
+      (state.range(1) != 0) ? createHuffmanContext(NULL) : NULL;
+
+  for (auto _ : state) {
+    const int result =
+        (psContext != NULL)
+            ? decompressBufferWithContext(psContext, compressed.data(),
+                                          compressedSize, output.data(),
+                                          output.size(), &outputSize)
+            : decompressBuffer(compressed.data(), compressedSize,
+                               output.data(), output.size(), &outputSize);
+    if (result == EXIT_FAILURE) {
+      state.SkipWithError("Unable to decompress the buffer");
+      break;
+    }
+    benchmark::DoNotOptimize(output.data());
+  }
+
+  freeHuffmanContext(psContext);
+  state.SetBytesProcessed((int64_t)(state.iterations() * input.size()));
+}
+BENCHMARK(BM_decompressSkewed)->ArgsProduct({{2, 5, 10}, {0, 1}});
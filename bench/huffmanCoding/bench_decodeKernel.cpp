@@ -0,0 +1,127 @@
+/**
+ * @file bench_decodeKernel.cpp
+ * @brief Benchmarks for decodeKernel.c.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ */
+
+/* External Includes */
+
+#include <benchmark/benchmark.h>
+
+/* Standard Library Includes */
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+/* Project Includes */
+
+#include "benchUtils.hpp"
+#include "testUtils.hpp"
+
+extern "C" {
+#include "huffmanCoding/codec.h"
+#include "huffmanCoding/decodeKernel.h"
+}
+
+/* Constants */
+
+/**< The number of uncompressed bytes in each benchmark input. */
+static const size_t INPUT_SIZE = (size_t)1 << 20;
+
+/* Helper Functions */
+
+/**
+ * @brief Benchmark decompressing a container with a decode kernel,
+ * reporting timestamp counter cycles per decoded byte on x86-64.
+ *
+ * @param state The benchmark state, range(0) is the decode kernel.
+ * @param i_input The bytes to compress and then decompress.
+ */
+static void benchmarkDecodeKernel(benchmark::State& state,
+                                  const std::vector<uint8_t>& i_input) {
+  const eHuffmanDecodeKernel_t eKernel =
+      (eHuffmanDecodeKernel_t)state.range(0);
+  state.SetLabel(getDecodeKernelName(eKernel));
+  const eHuffmanDecodeKernel_t ePrevious = getDecodeKernel();
+  if (setDecodeKernel(eKernel) == EXIT_FAILURE) {
+    state.SkipWithError("Decode kernel is not supported");
+    return;
+  }
+
+  std::vector<uint8_t> compressed(getCompressBound(i_input.size(), NULL));
+  std::vector<uint8_t> output(i_input.size());
+  size_t compressedSize = 0;
+  size_t outputSize = 0;
+  (void)compressBuffer(i_input.data(), i_input.size(), compressed.data(),
+                       compressed.size(), &compressedSize, NULL);
+  sHuffmanContext_t* psContext = createHuffmanContext(NULL);
+  uint64_t cycles = 0;
+
+  for (auto _ : state) {
+#if defined(__x86_64__)
+    const uint64_t start = __rdtsc();
+#endif
+    if (decompressBufferWithContext(psContext, compressed.data(),
+                                    compressedSize, output.data(),
+                                    output.size(),
+                                    &outputSize) == EXIT_FAILURE) {
+      state.SkipWithError("Unable to decompress the buffer");
+      break;
+    }
+#if defined(__x86_64__)
+    cycles += __rdtsc() - start;
+#endif
+    benchmark::DoNotOptimize(output.data());
+  }
+
+  freeHuffmanContext(psContext);
+  (void)setDecodeKernel(ePrevious);
+  state.SetBytesProcessed((int64_t)(state.iterations() * i_input.size()));
+  if (cycles > 0) {
+    state.counters["cycles_per_byte"] =
+        (double)cycles / (double)(state.iterations() * i_input.size());
+  }
+}
+
+/* Benchmarks */
+
+/**
+ * @brief Benchmark decompressing text with each decode kernel.
+ *
+ * @param state The benchmark state, range(0) is the decode kernel and
+ * range(1) the alphabet size.
+ */
+static void BM_decodeKernel(benchmark::State& state) {
+  const std::string text = generateText(INPUT_SIZE, (size_t)state.range(1));
+  benchmarkDecodeKernel(state,
+                        std::vector<uint8_t>(text.begin(), text.end()));
+}
+BENCHMARK(BM_decodeKernel)
+    ->ArgsProduct({{HUFFMAN_DECODE_KERNEL_PORTABLE,
+                    HUFFMAN_DECODE_KERNEL_BMI2},
+                   {4, 16, 64}});
+
+/**
+ * @brief Benchmark decompressing geometrically distributed bytes, whose
+ * code lengths vary, with each decode kernel.
+ *
+ * @param state The benchmark state, range(0) is the decode kernel and
+ * range(1) the distribution's parameter in percent.
+ */
+static void BM_decodeKernelGeometric(benchmark::State& state) {
+  benchmarkDecodeKernel(
+      state, generateGeometricBytes(INPUT_SIZE,
+                                    (double)state.range(1) / 100.0, 51));
+}
+BENCHMARK(BM_decodeKernelGeometric)
+    ->ArgsProduct({{HUFFMAN_DECODE_KERNEL_PORTABLE,
+                    HUFFMAN_DECODE_KERNEL_BMI2},
+                   {5, 20}});
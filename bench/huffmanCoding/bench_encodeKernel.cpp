@@ -0,0 +1,79 @@
+/**
+ * @file bench_encodeKernel.cpp
+ * @brief Benchmarks for encodeKernel.c.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ */
+
+/* External Includes */
+
+#include <benchmark/benchmark.h>
+
+/* Standard Library Includes */
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+/* Project Includes */
+
+#include "benchUtils.hpp"
+
+extern "C" {
+#include "huffmanCoding/bitStream.h"
+#include "huffmanCoding/encodeKernel.h"
+#include "huffmanCoding/huffmanTree.h"
+#include "huffmanCoding/task4.h"
+}
+
+/* Constants */
+
+/**< The number of bytes in each benchmark input. */
+static const size_t INPUT_SIZE = (size_t)1 << 20;
+
+/* Benchmarks */
+
+/**
+ * @brief Benchmark coding a buffer with each encode kernel.
+ *
+ * @param state The benchmark state, range(0) is the encode kernel and
+ * range(1) the alphabet size.
+ */
+static void BM_encodeKernel(benchmark::State& state) {
+  const eHuffmanEncodeKernel_t eKernel =
+      (eHuffmanEncodeKernel_t)state.range(0);
+  state.SetLabel(getEncodeKernelName(eKernel));
+  const eHuffmanEncodeKernel_t ePrevious = getEncodeKernel();
+  if (setEncodeKernel(eKernel) == EXIT_FAILURE) {
+    state.SkipWithError("Encode kernel is not supported");
+    return;
+  }
+
+  const std::string text =
+      generateText(INPUT_SIZE, (size_t)state.range(1));
+  size_t aFrequencies[HUFFMAN_ALPHABET_SIZE] = {0};
+  uint8_t aCodeLengths[HUFFMAN_ALPHABET_SIZE] = {0};
+  sHuffmanCodeTable_t sCodeTable;
+  countByteFrequencies((const uint8_t*)text.data(), text.size(),
+                       aFrequencies);
+  (void)createCodeLengthsFromFrequencies(aFrequencies, aCodeLengths);
+  (void)createCanonicalCodeTable(aCodeLengths, &sCodeTable);
+  std::vector<uint8_t> output(text.size() * 2);
+
+  for (auto _ : state) {
+    sBitWriter_t sWriter;
+    initBitWriter(&sWriter, output.data());
+    encodeTableSymbols(&sCodeTable, (const uint8_t*)text.data(), text.size(),
+                       &sWriter);
+    benchmark::DoNotOptimize(flushBitWriter(&sWriter));
+  }
+
+  (void)setEncodeKernel(ePrevious);
+  state.SetBytesProcessed((int64_t)(state.iterations() * INPUT_SIZE));
+}
+BENCHMARK(BM_encodeKernel)
+    ->ArgsProduct({{HUFFMAN_ENCODE_KERNEL_PORTABLE,
+                    HUFFMAN_ENCODE_KERNEL_AVX2},
+                   {4, 16, 64}});
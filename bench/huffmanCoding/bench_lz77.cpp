@@ -0,0 +1,100 @@
+/**
+ * @file bench_lz77.cpp
+ * @brief Benchmarks for lz77.c.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ */
+
+/* External Includes */
+
+#include <benchmark/benchmark.h>
+
+/* Standard Library Includes */
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+/* Project Includes */
+
+#include "corpus/corpora.hpp"
+
+extern "C" {
+#include "huffmanCoding/lz77.h"
+}
+
+/* Constants */
+
+/**< The number of bytes in each benchmark input. */
+static const size_t INPUT_SIZE = (size_t)1 << 22;
+
+/**< The level names, indexed by level. */
+static const char* const LEVEL_NAMES[] = {"fast", "greedy"};
+
+/* Benchmarks */
+
+/**
+ * @brief Benchmark compressing log lines at each level.
+ *
+ * @param state The benchmark state, range(0) is the level.
+ */
+static void BM_compressLz77Buffer(benchmark::State& state) {
+  const std::vector<uint8_t> input = generateLogLines(INPUT_SIZE, 1);
+  sHuffmanLz77Options_t sOptions;
+  initLz77Options(&sOptions);
+  sOptions.eLevel = (eHuffmanLz77Level_t)state.range(0);
+  state.SetLabel(LEVEL_NAMES[state.range(0)]);
+  std::vector<uint8_t> output(getLz77CompressBound(input.size(), &sOptions));
+  size_t outputSize = 0;
+
+  for (auto _ : state) {
+    if (compressLz77Buffer(input.data(), input.size(), output.data(),
+                           output.size(), &outputSize,
+                           &sOptions) == EXIT_FAILURE) {
+      state.SkipWithError("compressLz77Buffer failed");
+      return;
+    }
+    benchmark::DoNotOptimize(output.data());
+  }
+
+  state.counters["ratio"] = (double)input.size() / (double)outputSize;
+  state.SetBytesProcessed((int64_t)(state.iterations() * INPUT_SIZE));
+}
+BENCHMARK(BM_compressLz77Buffer)
+    ->Arg(HUFFMAN_LZ77_LEVEL_FAST)
+    ->Arg(HUFFMAN_LZ77_LEVEL_GREEDY);
+
+/**
+ * @brief Benchmark decompressing log lines compressed at each level.
+ *
+ * @param state The benchmark state, range(0) is the level.
+ */
+static void BM_decompressLz77Buffer(benchmark::State& state) {
+  const std::vector<uint8_t> input = generateLogLines(INPUT_SIZE, 1);
+  sHuffmanLz77Options_t sOptions;
+  initLz77Options(&sOptions);
+  sOptions.eLevel = (eHuffmanLz77Level_t)state.range(0);
+  state.SetLabel(LEVEL_NAMES[state.range(0)]);
+  std::vector<uint8_t> compressed(
+      getLz77CompressBound(input.size(), &sOptions));
+  size_t compressedSize = 0;
+  (void)compressLz77Buffer(input.data(), input.size(), compressed.data(),
+                           compressed.size(), &compressedSize, &sOptions);
+  std::vector<uint8_t> output(input.size());
+  size_t outputSize = 0;
+
+  for (auto _ : state) {
+    if (decompressLz77Buffer(compressed.data(), compressedSize, output.data(),
+                             output.size(), &outputSize) == EXIT_FAILURE) {
+      state.SkipWithError("decompressLz77Buffer failed");
+      return;
+    }
+    benchmark::DoNotOptimize(output.data());
+  }
+
+  state.SetBytesProcessed((int64_t)(state.iterations() * INPUT_SIZE));
+}
+BENCHMARK(BM_decompressLz77Buffer)
+    ->Arg(HUFFMAN_LZ77_LEVEL_FAST)
+    ->Arg(HUFFMAN_LZ77_LEVEL_GREEDY);
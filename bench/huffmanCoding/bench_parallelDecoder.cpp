@@ -0,0 +1,84 @@
+/**
+ * @file bench_parallelDecoder.cpp
+ * @brief Benchmarks for parallelDecoder.c.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ */
+
+/* External Includes */
+
+#include <benchmark/benchmark.h>
+
+/* Standard Library Includes */
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+/* Project Includes */
+
+#include "benchUtils.hpp"
+
+extern "C" {
+#include "huffmanCoding/bitStream.h"
+#include "huffmanCoding/encodeKernel.h"
+#include "huffmanCoding/huffmanTree.h"
+#include "huffmanCoding/parallelDecoder.h"
+#include "huffmanCoding/task4.h"
+}
+
+/* Constants */
+
+/**< The number of bytes in each benchmark input. */
+static const size_t INPUT_SIZE = (size_t)16 << 20;
+
+/* Benchmarks */
+
+/**
+ * @brief Benchmark decoding one large payload with each number of threads.
+ *
+ * @param state The benchmark state, range(0) is the number of threads.
+ */
+static void BM_decodeTableSymbolsParallel(benchmark::State& state) {
+  const std::string text = generateText(INPUT_SIZE, 64);
+  size_t aFrequencies[HUFFMAN_ALPHABET_SIZE] = {0};
+  uint8_t aCodeLengths[HUFFMAN_ALPHABET_SIZE] = {0};
+  sHuffmanCodeTable_t sCodeTable;
+  decodeTableEntry_t aDecodeTable[HUFFMAN_DECODE_TABLE_SIZE];
+  sHuffmanNibbleTree_t sTree;
+  countByteFrequencies((const uint8_t*)text.data(), text.size(),
+                       aFrequencies);
+  (void)createCodeLengthsFromFrequencies(aFrequencies, aCodeLengths);
+  (void)createCanonicalCodeTable(aCodeLengths, &sCodeTable);
+  (void)createDecodeTable(&sCodeTable, aDecodeTable);
+  createNibbleTree(&sCodeTable, &sTree);
+
+  std::vector<uint8_t> payload(text.size() * 2);
+  sBitWriter_t sWriter;
+  initBitWriter(&sWriter, payload.data());
+  encodeTableSymbols(&sCodeTable, (const uint8_t*)text.data(), text.size(),
+                     &sWriter);
+  payload.resize(flushBitWriter(&sWriter));
+  std::vector<uint8_t> output(text.size());
+
+  for (auto _ : state) {
+    if (decodeTableSymbolsParallel(aDecodeTable, &sTree, payload.data(),
+                                   payload.size(), output.data(),
+                                   output.size(), (size_t)state.range(0),
+                                   NULL) == EXIT_FAILURE) {
+      state.SkipWithError("decodeTableSymbolsParallel failed");
+      return;
+    }
+    benchmark::DoNotOptimize(output.data());
+  }
+
+  state.SetBytesProcessed((int64_t)(state.iterations() * INPUT_SIZE));
+}
+BENCHMARK(BM_decodeTableSymbolsParallel)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime();
@@ -0,0 +1,66 @@
+/**
+ * @file bench_parallelEncoder.cpp
+ * @brief Benchmarks for parallelEncoder.c.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ */
+
+/* External Includes */
+
+#include <benchmark/benchmark.h>
+
+/* Standard Library Includes */
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+/* Project Includes */
+
+#include "benchUtils.hpp"
+
+extern "C" {
+#include "huffmanCoding/huffmanTree.h"
+#include "huffmanCoding/parallelEncoder.h"
+#include "huffmanCoding/task4.h"
+}
+
+/* Constants */
+
+/**< The number of bytes in each benchmark input. */
+static const size_t INPUT_SIZE = (size_t)16 << 20;
+
+/* Benchmarks */
+
+/**
+ * @brief Benchmark coding one large buffer with each number of threads.
+ *
+ * @param state The benchmark state, range(0) is the number of threads.
+ */
+static void BM_encodeTableSymbolsParallel(benchmark::State& state) {
+  const std::string text = generateText(INPUT_SIZE, 64);
+  size_t aFrequencies[HUFFMAN_ALPHABET_SIZE] = {0};
+  uint8_t aCodeLengths[HUFFMAN_ALPHABET_SIZE] = {0};
+  sHuffmanCodeTable_t sCodeTable;
+  countByteFrequencies((const uint8_t*)text.data(), text.size(),
+                       aFrequencies);
+  (void)createCodeLengthsFromFrequencies(aFrequencies, aCodeLengths);
+  (void)createCanonicalCodeTable(aCodeLengths, &sCodeTable);
+  std::vector<uint8_t> output(text.size() * 2);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(encodeTableSymbolsParallel(
+        &sCodeTable, (const uint8_t*)text.data(), text.size(),
+        (size_t)state.range(0), output.data()));
+  }
+
+  state.SetBytesProcessed((int64_t)(state.iterations() * INPUT_SIZE));
+}
+BENCHMARK(BM_encodeTableSymbolsParallel)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime();
@@ -0,0 +1,76 @@
+/**
+ * @file bench_sampling.cpp
+ * @brief Benchmarks for compressing large blocks with sampled frequencies.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ */
+
+/* External Includes */
+
+#include <benchmark/benchmark.h>
+
+/* Standard Library Includes */
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+/* Project Includes */
+
+#include "benchUtils.hpp"
+
+extern "C" {
+#include "huffmanCoding/codec.h"
+#include "huffmanCoding/sampling.h"
+}
+
+/* Constants */
+
+/**< The number of uncompressed bytes in each benchmark input. */
+static const size_t INPUT_SIZE = (size_t)16 << 20;
+
+/**< The number of uncompressed bytes in each block. */
+static const size_t BLOCK_SIZE = (size_t)4 << 20;
+
+/* Benchmarks */
+
+/**
+ * @brief Benchmark compressing large blocks with each sample interval, and
+ * report the estimated ratio loss as a percentage.
+ *
+ * @param state The benchmark state, range(0) is the sample interval and
+ * range(1) the alphabet size.
+ */
+static void BM_compressSampled(benchmark::State& state) {
+  const std::string text = generateText(INPUT_SIZE, (size_t)state.range(1));
+  sHuffmanCompressOptions_t sOptions;
+  initCompressOptions(&sOptions);
+  sOptions.blockSize = BLOCK_SIZE;
+  sOptions.sampleInterval = (size_t)state.range(0);
+  std::vector<uint8_t> output(getCompressBound(text.size(), &sOptions));
+  size_t outputSize = 0;
+  sHuffmanContext_t* psContext = createHuffmanContext(NULL);
+
+  for (auto _ : state) {
+    if (compressBufferWithContext(psContext, (const uint8_t*)text.data(),
+                                  text.size(), output.data(), output.size(),
+                                  &outputSize, &sOptions) == EXIT_FAILURE) {
+      state.SkipWithError("Unable to compress the buffer");
+      break;
+    }
+    benchmark::DoNotOptimize(output.data());
+  }
+
+  sHuffmanSamplingLoss_t sLoss = {0, 0};
+  for (size_t offset = 0; offset < text.size(); offset += BLOCK_SIZE) {
+    (void)addSamplingLoss((const uint8_t*)&text[offset], BLOCK_SIZE,
+                          sOptions.sampleInterval, &sLoss);
+  }
+  state.counters["loss_pct"] =
+      100.0 * ((double)sLoss.sampledBits / (double)sLoss.exactBits - 1.0);
+  freeHuffmanContext(psContext);
+  state.SetBytesProcessed((int64_t)(state.iterations() * INPUT_SIZE));
+}
+BENCHMARK(BM_compressSampled)->ArgsProduct({{0, 4, 8, 16, 64}, {64, 200}});
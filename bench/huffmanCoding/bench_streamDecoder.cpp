@@ -0,0 +1,106 @@
+/**
+ * @file bench_streamDecoder.cpp
+ * @brief Benchmarks for streamDecoder.c.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ */
+
+/* External Includes */
+
+#include <benchmark/benchmark.h>
+
+/* Standard Library Includes */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+/* Project Includes */
+
+#include "benchUtils.hpp"
+
+extern "C" {
+#include "huffmanCoding/codec.h"
+#include "huffmanCoding/streamDecoder.h"
+}
+
+/* Constants */
+
+/**< The number of uncompressed bytes in each benchmark input. */
+static const size_t INPUT_SIZE = (size_t)4 << 20;
+
+/* Benchmarks */
+
+/**
+ * @brief Benchmark decompressing a container in chunks through an output
+ * window of the same size.
+ *
+ * @param state The benchmark state, range(0) is the chunk and window size.
+ */
+static void BM_decompressStream(benchmark::State& state) {
+  const std::string text = generateText(INPUT_SIZE, 64);
+  std::vector<uint8_t> compressed(getCompressBound(text.size(), NULL));
+  size_t compressedSize = 0;
+  (void)compressBuffer((const uint8_t*)text.data(), text.size(),
+                       compressed.data(), compressed.size(), &compressedSize,
+                       NULL);
+  const size_t chunkSize = (size_t)state.range(0);
+  std::vector<uint8_t> window(chunkSize);
+  sHuffmanStreamDecoder_t* psDecoder = createStreamDecoder(NULL);
+
+  for (auto _ : state) {
+    eHuffmanStreamStatus_t eStatus = HUFFMAN_STREAM_CONTINUE;
+    size_t position = 0;
+    resetStreamDecoder(psDecoder);
+    while (eStatus == HUFFMAN_STREAM_CONTINUE) {
+      size_t consumed = 0;
+      size_t outputSize = 0;
+      eStatus = decompressStream(
+          psDecoder, &compressed[position],
+          std::min(chunkSize, compressedSize - position), &consumed,
+          window.data(), window.size(), &outputSize);
+      position += consumed;
+      benchmark::DoNotOptimize(window.data());
+    }
+    if (eStatus == HUFFMAN_STREAM_ERROR) {
+      state.SkipWithError("Unable to decompress the stream");
+      break;
+    }
+  }
+
+  freeStreamDecoder(psDecoder);
+  state.SetBytesProcessed((int64_t)(state.iterations() * INPUT_SIZE));
+}
+BENCHMARK(BM_decompressStream)->Arg(4096)->Arg(64 * 1024);
+
+/**
+ * @brief Benchmark decompressing the same container in one call, for
+ * comparison.
+ *
+ * @param state The benchmark state.
+ */
+static void BM_decompressStreamBaseline(benchmark::State& state) {
+  const std::string text = generateText(INPUT_SIZE, 64);
+  std::vector<uint8_t> compressed(getCompressBound(text.size(), NULL));
+  std::vector<uint8_t> output(text.size());
+  size_t compressedSize = 0;
+  size_t outputSize = 0;
+  (void)compressBuffer((const uint8_t*)text.data(), text.size(),
+                       compressed.data(), compressed.size(), &compressedSize,
+                       NULL);
+
+  for (auto _ : state) {
+    if (decompressBuffer(compressed.data(), compressedSize, output.data(),
+                         output.size(), &outputSize) == EXIT_FAILURE) {
+      state.SkipWithError("Unable to decompress the buffer");
+      break;
+    }
+    benchmark::DoNotOptimize(output.data());
+  }
+
+  state.SetBytesProcessed((int64_t)(state.iterations() * INPUT_SIZE));
+}
+BENCHMARK(BM_decompressStreamBaseline);
@@ -0,0 +1,62 @@
+/**
+ * @file bench_task2.cpp
+ * @brief Benchmarks for task2.c.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ */
+
+/* External Includes */
+
+#include <benchmark/benchmark.h>
+
+/* Standard Library Includes */
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+/* Project Includes */
+
+#include "benchUtils.hpp"
+
+extern "C" {
+#include "huffmanCoding/task2.h"
+}
+
+/* Benchmarks */
+
+/**
+ * @brief Benchmark reading text files of increasing size.
+ *
+ * @param state The benchmark state, range(0) is the file size in bytes.
+ */
+static void BM_readTextFile(benchmark::State& state) {
+  const size_t fileSize = (size_t)state.range(0);
+  const std::string filePath =
+      "bench_readTextFile_" + std::to_string(fileSize) + ".txt";
+
+  /* Write the input file once, outside of the timed region. */
+  const std::string text = generateText(fileSize, 64);
+  FILE* pFile = std::fopen(filePath.c_str(), "w");
+  if (pFile == NULL) {
+    state.SkipWithError("Unable to create the input file");
+    return;
+  }
+  (void)std::fwrite(text.data(), sizeof(char), text.size(), pFile);
+  (void)std::fclose(pFile);
+
+  std::vector<char> buffer(MAX_FILE_SIZE);
+  for (auto _ : state) {
+    if (readTextFile(filePath.c_str(), buffer.data()) == EXIT_FAILURE) {
+      state.SkipWithError("Unable to read the input file");
+      break;
+    }
+    benchmark::DoNotOptimize(buffer.data());
+  }
+
+  state.SetBytesProcessed((int64_t)state.iterations() * (int64_t)fileSize);
+  (void)std::remove(filePath.c_str());
+}
+BENCHMARK(BM_readTextFile)->RangeMultiplier(4)->Range(16, MAX_FILE_SIZE - 1);
@@ -0,0 +1,56 @@
+/**
+ * @file bench_task4.cpp
+ * @brief Benchmarks for task4.c.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ */
+
+/* External Includes */
+
+#include <benchmark/benchmark.h>
+
+/* Standard Library Includes */
+
+#include <cstdlib>
+#include <string>
+
+/* Project Includes */
+
+#include "benchUtils.hpp"
+
+extern "C" {
+#include "huffmanCoding/task3.h"
+#include "huffmanCoding/task4.h"
+}
+
+/* Benchmarks */
+
+/**
+ * @brief Benchmark counting the letter frequencies of a text.
+ *
+ * @param state The benchmark state, range(0) is the text size in bytes and
+ * range(1) is the alphabet size.
+ */
+static void BM_createLetterFrequencyListFromText(benchmark::State& state) {
+  const size_t textSize = (size_t)state.range(0);
+  const size_t alphabetSize = (size_t)state.range(1);
+  const std::string text = generateText(textSize, alphabetSize);
+
+  for (auto _ : state) {
+    sLetterFrequencyNode_t* psHead = NULL;
+    if (createLetterFrequencyListFromText(&psHead, text.c_str()) ==
+        EXIT_FAILURE) {
+      state.SkipWithError("Unable to create the letter-frequency list");
+      break;
+    }
+    benchmark::DoNotOptimize(psHead);
+    freeLetterFrequencyPairList(&psHead);
+  }
+
+  state.SetBytesProcessed((int64_t)state.iterations() * (int64_t)textSize);
+  state.SetItemsProcessed((int64_t)state.iterations() * (int64_t)textSize);
+}
+BENCHMARK(BM_createLetterFrequencyListFromText)
+    ->ArgNames({"bytes", "alphabet"})
+    ->ArgsProduct({{1 << 10, 1 << 13, 1 << 16}, {2, 16, 64, 255}});
@@ -0,0 +1,81 @@
+/**
+ * @file bench_task5.cpp
+ * @brief Benchmarks for task5.c.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ */
+
+/* External Includes */
+
+#include <benchmark/benchmark.h>
+
+/* Standard Library Includes */
+
+#include <cstdlib>
+#include <string>
+
+/* Project Includes */
+
+#include "benchUtils.hpp"
+
+extern "C" {
+#include "huffmanCoding/task5.h"
+#include "huffmanCoding/task6.h"
+}
+
+/* Benchmarks */
+
+/**
+ * @brief Benchmark building a Huffman tree by merging binary tree nodes.
+ *
+ * Each iteration pops and merges the nodes of an alphabet-sized list until a
+ * single root remains, so one item is one call to mergeBinaryTreeNodes.
+ *
+ * @param state The benchmark state, range(0) is the alphabet size.
+ */
+static void BM_mergeBinaryTreeNodes(benchmark::State& state) {
+  const size_t alphabetSize = (size_t)state.range(0);
+  const std::string text = generateText(alphabetSize * 16, alphabetSize);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    sBinaryTreeListNode_t* psHead = createBinaryTreeNodeListFromText(text);
+    state.ResumeTiming();
+
+    sBinaryTreeNode_t* psRoot = createHuffmanTree(&psHead);
+    benchmark::DoNotOptimize(psRoot);
+
+    state.PauseTiming();
+    freeBinaryTree(psRoot);
+    state.ResumeTiming();
+  }
+
+  state.SetItemsProcessed((int64_t)state.iterations() *
+                          (int64_t)(alphabetSize - 1));
+}
+BENCHMARK(BM_mergeBinaryTreeNodes)->Arg(2)->Arg(16)->Arg(64)->Arg(255);
+
+/**
+ * @brief Benchmark freeing a complete Huffman tree.
+ *
+ * @param state The benchmark state, range(0) is the alphabet size.
+ */
+static void BM_freeBinaryTree(benchmark::State& state) {
+  const size_t alphabetSize = (size_t)state.range(0);
+  const std::string text = generateText(alphabetSize * 16, alphabetSize);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    sBinaryTreeListNode_t* psHead = createBinaryTreeNodeListFromText(text);
+    sBinaryTreeNode_t* psRoot = createHuffmanTree(&psHead);
+    state.ResumeTiming();
+
+    freeBinaryTree(psRoot);
+  }
+
+  /* A tree of n leaves has 2n - 1 nodes. */
+  state.SetItemsProcessed((int64_t)state.iterations() *
+                          (int64_t)(2 * alphabetSize - 1));
+}
+BENCHMARK(BM_freeBinaryTree)->Arg(2)->Arg(16)->Arg(64)->Arg(255);
@@ -0,0 +1,105 @@
+/**
+ * @file bench_task6.cpp
+ * @brief Benchmarks for task6.c.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ */
+
+/* External Includes */
+
+#include <benchmark/benchmark.h>
+
+/* Standard Library Includes */
+
+#include <cstdlib>
+#include <string>
+
+/* Project Includes */
+
+#include "benchUtils.hpp"
+
+extern "C" {
+#include "huffmanCoding/task3.h"
+#include "huffmanCoding/task4.h"
+#include "huffmanCoding/task5.h"
+#include "huffmanCoding/task6.h"
+}
+
+/* Benchmarks */
+
+/**
+ * @brief Benchmark creating a binary tree node list from a letter-frequency
+ * pair list.
+ *
+ * @param state The benchmark state, range(0) is the alphabet size.
+ */
+static void BM_createBinaryTreeNodeListFromLetterFrequencyPairList(
+    benchmark::State& state) {
+  const size_t alphabetSize = (size_t)state.range(0);
+  const std::string text = generateText(alphabetSize * 16, alphabetSize);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    sLetterFrequencyNode_t* psLetterFrequencyHead = NULL;
+    sBinaryTreeListNode_t* psHead = NULL;
+    (void)createLetterFrequencyListFromText(&psLetterFrequencyHead,
+                                            text.c_str());
+    state.ResumeTiming();
+
+    if (createBinaryTreeNodeListFromLetterFrequencyPairList(
+            &psHead, psLetterFrequencyHead) == EXIT_FAILURE) {
+      state.SkipWithError("Unable to create the binary tree node list");
+      break;
+    }
+    benchmark::DoNotOptimize(psHead);
+
+    /* The binary tree node list owns the letter-frequency pairs. */
+    state.PauseTiming();
+    freeBinaryTreeList(&psHead);
+    state.ResumeTiming();
+  }
+
+  state.SetItemsProcessed((int64_t)state.iterations() * (int64_t)alphabetSize);
+}
+BENCHMARK(BM_createBinaryTreeNodeListFromLetterFrequencyPairList)
+    ->Arg(2)
+    ->Arg(16)
+    ->Arg(64)
+    ->Arg(255);
+
+/**
+ * @brief Benchmark popping every node of a binary tree node list in order of
+ * lowest frequency.
+ *
+ * @param state The benchmark state, range(0) is the alphabet size.
+ */
+static void BM_popLowestFrequencyBinaryTreeNode(benchmark::State& state) {
+  const size_t alphabetSize = (size_t)state.range(0);
+  const std::string text = generateText(alphabetSize * 16, alphabetSize);
+  sBinaryTreeNode_t* apsPopped[256];
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    sBinaryTreeListNode_t* psHead = createBinaryTreeNodeListFromText(text);
+    state.ResumeTiming();
+
+    for (size_t i = 0; i < alphabetSize; i++) {
+      apsPopped[i] = popLowestFrequencyBinaryTreeNode(&psHead);
+    }
+    benchmark::DoNotOptimize(apsPopped);
+
+    state.PauseTiming();
+    for (size_t i = 0; i < alphabetSize; i++) {
+      freeBinaryTree(apsPopped[i]);
+    }
+    state.ResumeTiming();
+  }
+
+  state.SetItemsProcessed((int64_t)state.iterations() * (int64_t)alphabetSize);
+}
+BENCHMARK(BM_popLowestFrequencyBinaryTreeNode)
+    ->Arg(2)
+    ->Arg(16)
+    ->Arg(64)
+    ->Arg(255);
@@ -0,0 +1,280 @@
+/**
+ * @file main.cpp
+ * @brief Load generator for the compression daemon.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ * Each connection runs on its own thread and sends compress requests for log
+ * lines, followed by decompress requests for the containers it got back.
+ * Every request is timed from sending to receiving the whole response, and
+ * the latency percentiles and request rate are printed once every connection
+ * has finished. Unless a socket is given, a daemon is started in-process on
+ * a temporary socket.
+ */
+
+/* Standard Library Includes */
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* Project Includes */
+
+#include "corpus/corpora.hpp"
+
+extern "C" {
+#include "huffmanCoding/codec.h"
+#include "huffmanCoding/daemon.h"
+#include "huffmanCoding/daemonClient.h"
+}
+
+/* Type Definitions */
+
+/**
+ * @brief Settings parsed from the command line.
+ */
+struct Settings {
+  std::string socketPath;
+  size_t connections = 4;
+  size_t requests = 1000;
+  size_t messageSize = (size_t)64 * 1024;
+  size_t workers = HUFFMAN_DAEMON_DEFAULT_WORKERS;
+};
+
+/**
+ * @brief The latencies measured by one connection.
+ */
+struct Latencies {
+  std::vector<double> compress;
+  std::vector<double> decompress;
+  bool failed = false;
+};
+
+/* Function Definitions */
+
+/**
+ * @brief Print the command line usage.
+ *
+ * @param i_program The name of the program.
+ */
+static void printUsage(const char* i_program) {
+  std::fprintf(stderr,
+               "Usage: %s [--socket PATH] [--connections N] [--requests N] "
+               "[--size BYTES] [--workers N]\n",
+               i_program);
+}
+
+/**
+ * @brief Parse the command line into settings.
+ *
+ * @param argc Number of command line arguments.
+ * @param argv Command line arguments.
+ * @param o_settings The parsed settings.
+ * @return bool true if the command line is valid.
+ */
+static bool parseArguments(int argc, char** argv, Settings& o_settings) {
+  for (int i = 1; i < argc; i++) {
+    const std::string argument = argv[i];
+    if (i + 1 >= argc) {
+      return false;
+    }
+    const char* value = argv[++i];
+
+    if (argument == "--socket") {
+      o_settings.socketPath = value;
+    } else if (argument == "--connections") {
+      o_settings.connections =
+          std::max<size_t>(1, std::strtoull(value, NULL, 10));
+    } else if (argument == "--requests") {
+      o_settings.requests =
+          std::max<size_t>(1, std::strtoull(value, NULL, 10));
+    } else if (argument == "--size") {
+      o_settings.messageSize = std::strtoull(value, NULL, 10);
+    } else if (argument == "--workers") {
+      o_settings.workers = std::strtoull(value, NULL, 10);
+    } else {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * @brief Send a connection's requests and time each one.
+ *
+ * @param i_settings The load settings.
+ * @param i_seed The seed of the connection's messages.
+ * @param o_latencies The latency of each request, in microseconds.
+ */
+static void runConnection(const Settings& i_settings, uint32_t i_seed,
+                          Latencies& o_latencies) {
+  using Clock = std::chrono::steady_clock;
+
+  sHuffmanDaemonClient_t sClient;
+  if (connectHuffmanDaemon(&sClient, i_settings.socketPath.c_str()) ==
+      EXIT_FAILURE) {
+    o_latencies.failed = true;
+    return;
+  }
+
+  const std::vector<uint8_t> input =
+      generateLogLines(i_settings.messageSize, i_seed);
+  std::vector<uint8_t> compressed(getCompressBound(input.size(), NULL));
+  std::vector<uint8_t> output(input.size());
+  o_latencies.compress.reserve(i_settings.requests);
+  o_latencies.decompress.reserve(i_settings.requests);
+
+  for (size_t i = 0; i < i_settings.requests; i++) {
+    size_t compressedSize = 0;
+    size_t outputSize = 0;
+    const Clock::time_point start = Clock::now();
+    const int compressResult = requestHuffmanDaemon(
+        &sClient, HUFFMAN_DAEMON_COMPRESS, input.data(), input.size(),
+        compressed.data(), compressed.size(), &compressedSize);
+    const Clock::time_point middle = Clock::now();
+    const int decompressResult =
+        (compressResult == EXIT_SUCCESS)
+            ? requestHuffmanDaemon(&sClient, HUFFMAN_DAEMON_DECOMPRESS,
+                                   compressed.data(), compressedSize,
+                                   output.data(), output.size(), &outputSize)
+            : EXIT_FAILURE;
+    const Clock::time_point end = Clock::now();
+
+    if (decompressResult == EXIT_FAILURE || output != input) {
+      o_latencies.failed = true;
+      break;
+    }
+    o_latencies.compress.push_back(
+        std::chrono::duration<double, std::micro>(middle - start).count());
+    o_latencies.decompress.push_back(
+        std::chrono::duration<double, std::micro>(end - middle).count());
+  }
+
+  disconnectHuffmanDaemon(&sClient);
+}
+
+/**
+ * @brief Find a percentile of sorted latencies.
+ *
+ * @param i_sorted The latencies, in ascending order.
+ * @param i_percentile The percentile, from 0 to 100.
+ * @return double The latency at the percentile.
+ */
+static double percentile(const std::vector<double>& i_sorted,
+                         double i_percentile) {
+  if (i_sorted.empty()) {
+    return 0.0;
+  }
+  const size_t index =
+      (size_t)((i_percentile / 100.0) * (double)(i_sorted.size() - 1) + 0.5);
+  return i_sorted[index];
+}
+
+/**
+ * @brief Print the latency percentiles of one kind of request.
+ *
+ * @param i_name The kind of request.
+ * @param io_latencies The latencies, sorted in place.
+ */
+static void printLatencies(const char* i_name,
+                           std::vector<double>& io_latencies) {
+  std::sort(io_latencies.begin(), io_latencies.end());
+  std::printf("%-12s %10zu %12.1f %12.1f %12.1f\n", i_name,
+              io_latencies.size(), percentile(io_latencies, 50.0),
+              percentile(io_latencies, 99.0),
+              io_latencies.empty() ? 0.0 : io_latencies.back());
+}
+
+/**
+ * @brief Program entry function.
+ *
+ * Runs every connection to completion and prints the latency percentiles
+ * and request rate.
+ *
+ * @param argc Number of command line arguments.
+ * @param argv Command line arguments.
+ * @return int EXIT_SUCCESS if every request round-tripped, else EXIT_FAILURE.
+ */
+int main(int argc, char** argv) {
+  Settings settings;
+  if (!parseArguments(argc, argv, settings)) {
+    printUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  /* Start a daemon in-process unless one is already listening. */
+  sHuffmanDaemon_t* psDaemon = NULL;
+  std::thread daemonThread;
+  if (settings.socketPath.empty()) {
+    settings.socketPath =
+        "/tmp/huffman_loadgen_" + std::to_string(getpid()) + ".sock";
+    sHuffmanDaemonOptions_t sOptions;
+    initDaemonOptions(&sOptions);
+    sOptions.pSocketPath = settings.socketPath.c_str();
+    sOptions.workerCount = settings.workers;
+    psDaemon = createHuffmanDaemon(&sOptions);
+    if (psDaemon == NULL) {
+      return EXIT_FAILURE;
+    }
+    daemonThread = std::thread([psDaemon]() {
+      (void)runHuffmanDaemon(psDaemon);
+    });
+  }
+
+  std::vector<Latencies> latencies(settings.connections);
+  std::vector<std::thread> threads;
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < settings.connections; i++) {
+    threads.emplace_back(runConnection, std::cref(settings), (uint32_t)i + 1,
+                         std::ref(latencies[i]));
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  const double seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+          .count();
+
+  if (psDaemon != NULL) {
+    stopHuffmanDaemon(psDaemon);
+    daemonThread.join();
+    freeHuffmanDaemon(psDaemon);
+  }
+
+  std::vector<double> compress;
+  std::vector<double> decompress;
+  bool failed = false;
+  for (const Latencies& connection : latencies) {
+    compress.insert(compress.end(), connection.compress.begin(),
+                    connection.compress.end());
+    decompress.insert(decompress.end(), connection.decompress.begin(),
+                      connection.decompress.end());
+    failed = failed || connection.failed;
+  }
+
+  const size_t requestCount = compress.size() + decompress.size();
+  std::printf("%zu connections, %zu-byte messages, %.2f s\n",
+              settings.connections, settings.messageSize, seconds);
+  std::printf("%-12s %10s %12s %12s %12s\n", "request", "count", "p50 us",
+              "p99 us", "max us");
+  printLatencies("compress", compress);
+  printLatencies("decompress", decompress);
+  std::printf("%.0f requests/s, %.1f MB/s uncompressed\n",
+              (double)requestCount / seconds,
+              ((double)requestCount * (double)settings.messageSize / 1e6) /
+                  seconds);
+
+  if (failed) {
+    std::fprintf(stderr, "ERROR: A request failed or did not round-trip\n");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,30 @@
+/**
+ * @file main.cpp
+ * @brief Entry point for the Google Benchmark framework.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ */
+
+/* External Includes */
+
+#include <benchmark/benchmark.h>
+
+/* Function Definitons. */
+
+/**
+ * @brief Runs all benchmarks.
+ *
+ * @param argc Number of command line arguments.
+ * @param argv Command line arguments.
+ * @return int 0 if all benchmarks ran successfully, or 1 otherwise.
+ */
+int main(int argc, char **argv) {
+  ::benchmark::Initialize(&argc, argv);
+  if (::benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  ::benchmark::RunSpecifiedBenchmarks();
+  ::benchmark::Shutdown();
+  return 0;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file allocator.c
+ * @brief Pluggable memory allocator used by the Huffman data structures.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+/* Standard Library Includes */
+
+#include <stddef.h>
+#include <stdlib.h>
+
+/* Project Includes */
+
+#include "huffmanCoding/allocator.h"
+#include "huffmanCoding/stats.h"
+
+/* Function Prototypes */
+
+/**
+ * @brief Allocate memory with malloc.
+ *
+ * @param[inout] io_pUser Unused.
+ * @param[in] i_size The number of bytes to allocate.
+ * @return void* The allocated memory, else NULL.
+ */
+static void* defaultAlloc(void* io_pUser, size_t i_size);
+
+/**
+ * @brief Free memory with free.
+ *
+ * @param[inout] io_pUser Unused.
+ * @param[in] io_pMemory The memory to free.
+ */
+static void defaultFree(void* io_pUser, void* io_pMemory);
+
+/* Global Variables */
+
+/**< The allocator used when none is given. */
+static const sHuffmanAllocator_t DEFAULT_ALLOCATOR = {defaultAlloc,
+                                                      defaultFree, NULL};
+
+/* Function Definitions */
+
+/**
+ * @brief Allocate memory with malloc.
+ *
+ * @param[inout] io_pUser Unused.
+ * @param[in] i_size The number of bytes to allocate.
+ * @return void* The allocated memory, else NULL.
+ */
+static void* defaultAlloc(void* io_pUser, size_t i_size) {
+  (void)io_pUser;
+  return malloc(i_size);
+}
+
+/**
+ * @brief Free memory with free.
+ *
+ * @param[inout] io_pUser Unused.
+ * @param[in] io_pMemory The memory to free.
+ */
+static void defaultFree(void* io_pUser, void* io_pMemory) {
+  (void)io_pUser;
+  free(io_pMemory);
+}
+
+/**
+ * @brief Get the default allocator, which uses malloc and free.
+ *
+ * @return const sHuffmanAllocator_t* The default allocator.
+ */
+const sHuffmanAllocator_t* getDefaultHuffmanAllocator(void) {
+  return &DEFAULT_ALLOCATOR;
+}
+
+/**
+ * @brief Allocate memory with an allocator.
+ *
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ * @param[in] i_size The number of bytes to allocate.
+ * @return void* The allocated memory, else NULL.
+ */
+void* allocateHuffmanMemory(const sHuffmanAllocator_t* i_psAllocator,
+                            size_t i_size) {
+  if (i_psAllocator == NULL) {
+    i_psAllocator = &DEFAULT_ALLOCATOR;
+  }
+
+  void* pMemory = i_psAllocator->pfnAlloc(i_psAllocator->pUser, i_size);
+  if (pMemory != NULL) {
+    HUFFMAN_STATS_ADD(allocations, 1);
+  }
+  return pMemory;
+}
+
+/**
+ * @brief Free memory with the allocator that allocated it.
+ *
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ * @param[in] io_pMemory The memory to free. Nothing is done if it is NULL.
+ */
+void freeHuffmanMemory(const sHuffmanAllocator_t* i_psAllocator,
+                       void* io_pMemory) {
+  if (io_pMemory == NULL) {
+    return;
+  }
+  if (i_psAllocator == NULL) {
+    i_psAllocator = &DEFAULT_ALLOCATOR;
+  }
+
+  i_psAllocator->pfnFree(i_psAllocator->pUser, io_pMemory);
+  HUFFMAN_STATS_ADD(frees, 1);
+}
@@ -0,0 +1,77 @@
+/**
+ * @file allocator.h
+ * @brief Pluggable memory allocator used by the Huffman data structures.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ * Every function that allocates list or tree nodes has a WithAllocator variant
+ * taking an allocator. Passing NULL, or calling the variant without the
+ * suffix, uses the default allocator, which wraps malloc and free. Memory must
+ * be freed with the same allocator that allocated it.
+ */
+
+#ifndef ALLOCATOR_H
+#define ALLOCATOR_H
+
+/* Standard Library Includes */
+
+#include <stddef.h>
+
+/* Type Definitions */
+
+/**
+ * @brief Allocate memory, returning NULL on failure.
+ *
+ * @param[inout] io_pUser The allocator's user pointer.
+ * @param[in] i_size The number of bytes to allocate.
+ * @return void* The allocated memory, else NULL.
+ */
+typedef void* (*pfnHuffmanAlloc_t)(void* io_pUser, size_t i_size);
+
+/**
+ * @brief Free memory returned by the matching allocation function.
+ *
+ * @param[inout] io_pUser The allocator's user pointer.
+ * @param[in] io_pMemory The memory to free, never NULL.
+ */
+typedef void (*pfnHuffmanFree_t)(void* io_pUser, void* io_pMemory);
+
+/**
+ * @brief Allocation and free functions with a user pointer passed to both.
+ */
+typedef struct sHuffmanAllocator {
+  pfnHuffmanAlloc_t pfnAlloc;
+  pfnHuffmanFree_t pfnFree;
+  void* pUser;
+} sHuffmanAllocator_t;
+
+/* Function Prototypes */
+
+/**
+ * @brief Get the default allocator, which uses malloc and free.
+ *
+ * @return const sHuffmanAllocator_t* The default allocator.
+ */
+extern const sHuffmanAllocator_t* getDefaultHuffmanAllocator(void);
+
+/**
+ * @brief Allocate memory with an allocator.
+ *
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ * @param[in] i_size The number of bytes to allocate.
+ * @return void* The allocated memory, else NULL.
+ */
+extern void* allocateHuffmanMemory(const sHuffmanAllocator_t* i_psAllocator,
+                                   size_t i_size);
+
+/**
+ * @brief Free memory with the allocator that allocated it.
+ *
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ * @param[in] io_pMemory The memory to free. Nothing is done if it is NULL.
+ */
+extern void freeHuffmanMemory(const sHuffmanAllocator_t* i_psAllocator,
+                              void* io_pMemory);
+
+#endif  // ALLOCATOR_H
@@ -0,0 +1,1363 @@
+/**
+ * @file archive.c
+ * @brief Compress many files into one archive with several threads.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+/* Standard Library Includes */
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+/* Project Includes */
+
+#include "huffmanCoding/allocator.h"
+#include "huffmanCoding/archive.h"
+#include "huffmanCoding/codec.h"
+
+/* Constants */
+
+/**< The magic bytes at the start of an archive. */
+static const uint8_t ARCHIVE_MAGIC[4] = {'H', 'U', 'F', 'A'};
+
+/**< The magic bytes at the end of an archive. */
+static const uint8_t ARCHIVE_TRAILER_MAGIC[4] = {'H', 'U', 'F', 'Z'};
+
+/**< The most threads an archive is compressed with. */
+#define MAX_ARCHIVE_THREADS 64
+
+/**< The jobs each thread may compress ahead of the one being written. */
+#define JOBS_PER_THREAD 4
+
+/**< The number of bytes in a directory entry before its name and members. */
+#define ENTRY_FIXED_SIZE 18
+
+/**< The number of bytes in each member of a directory entry. */
+#define MEMBER_SIZE 16
+
+/**< The batch index of an entry that is not batched. */
+#define NOT_BATCHED UINT32_MAX
+
+/* Type Definitions */
+
+/**
+ * @brief A file to add to an archive.
+ */
+typedef struct sArchiveFile {
+  char* pPath;
+  uint64_t size;
+  uint32_t batchIndex; /**< The index in its batch, or NOT_BATCHED. */
+  size_t firstJob;     /**< The job of its first part, or its batch. */
+  size_t jobCount;
+} sArchiveFile_t;
+
+/**
+ * @brief The files found for an archive.
+ */
+typedef struct sArchiveFileList {
+  sArchiveFile_t* asFiles;
+  size_t count;
+  size_t capacity;
+} sArchiveFileList_t;
+
+/**
+ * @brief A part of a large file, or a batch of small files, to compress.
+ *
+ * A part names its file directly, while a batch names a run of the writer's
+ * batched files, which are listed in the order they are batched.
+ */
+typedef struct sArchiveJob {
+  bool isBatch;
+  size_t firstFile; /**< The part's file or the batch's first batched file. */
+  size_t fileCount;
+  uint64_t offset; /**< The part's offset in its file. */
+  size_t size;     /**< The uncompressed bytes. */
+  uint8_t* pOutput;
+  size_t outputSize;
+  uint64_t archiveOffset; /**< Set once the output is written. */
+  bool isDone;            /**< Guarded by the writer's mutex. */
+} sArchiveJob_t;
+
+/**
+ * @brief The jobs of an archive being written and their progress.
+ *
+ * Workers take jobs in order but may finish them out of order. The calling
+ * thread writes each job's output once it is done, so the archive does not
+ * depend on the number of threads, and workers stay at most a window of jobs
+ * ahead of it so the outputs held in memory are bounded.
+ */
+typedef struct sArchiveWriter {
+  sArchiveFile_t* asFiles;
+  size_t fileCount;
+  size_t* aBatchFiles; /**< The indices of the batched files. */
+  sArchiveJob_t* asJobs;
+  size_t jobCount;
+  size_t windowSize;
+  pthread_mutex_t mutex;
+  pthread_cond_t changed;
+  size_t nextJob;      /**< Guarded by the mutex. */
+  size_t writtenCount; /**< Guarded by the mutex. */
+  bool isFailed;       /**< Guarded by the mutex. */
+} sArchiveWriter_t;
+
+/**
+ * @brief A thread compressing jobs and the context it compresses batches with.
+ */
+typedef struct sArchiveWorker {
+  sArchiveWriter_t* psWriter;
+  sHuffmanContext_t* psContext;
+  pthread_t thread;
+} sArchiveWorker_t;
+
+/**
+ * @brief A compressed member of an archive.
+ */
+typedef struct sArchiveMember {
+  uint64_t offset;
+  uint64_t size;
+} sArchiveMember_t;
+
+/**
+ * @brief A file in an archive's directory.
+ */
+typedef struct sArchiveEntry {
+  const char* pName;
+  uint64_t size;
+  uint32_t batchIndex;
+  size_t firstMember;
+  size_t memberCount;
+} sArchiveEntry_t;
+
+struct sHuffmanArchive {
+  int file;
+  uint64_t directoryOffset;
+  sArchiveEntry_t* asEntries;
+  size_t entryCount;
+  sArchiveMember_t* asMembers;
+  char* pNames;
+};
+
+/* Function Prototypes */
+
+/**
+ * @brief Write a little-endian integer.
+ *
+ * @param[out] o_pDest The buffer to write to.
+ * @param[in] i_value The value to write.
+ * @param[in] i_size The number of bytes to write.
+ */
+static void writeInteger(uint8_t* o_pDest, uint64_t i_value, size_t i_size);
+
+/**
+ * @brief Read a little-endian integer.
+ *
+ * @param[in] i_pSource The buffer to read from.
+ * @param[in] i_size The number of bytes to read.
+ * @return uint64_t The value read.
+ */
+static uint64_t readInteger(const uint8_t* i_pSource, size_t i_size);
+
+/**
+ * @brief Compare two names for sorting.
+ *
+ * @param[in] i_pLeft A pointer to the first name.
+ * @param[in] i_pRight A pointer to the second name.
+ * @return int The order of the names, as for strcmp.
+ */
+static int compareNames(const void* i_pLeft, const void* i_pRight);
+
+/**
+ * @brief Add a regular file to a list of files.
+ *
+ * @param[inout] io_psList The list.
+ * @param[in] i_pPath The path of the file.
+ * @param[in] i_size The size of the file.
+ * @return int EXIT_SUCCESS if the file was added, else EXIT_FAILURE.
+ */
+static int addFile(sArchiveFileList_t* io_psList, const char* i_pPath,
+                   uint64_t i_size);
+
+/**
+ * @brief Add a file, or a directory's regular files, to a list of files.
+ *
+ * Anything other than a regular file or directory found inside a directory
+ * is skipped.
+ *
+ * @param[inout] io_psList The list.
+ * @param[in] i_pPath The path to add.
+ * @param[in] i_isNamed Whether the path was named by the caller.
+ * @return int EXIT_SUCCESS if the path was added, else EXIT_FAILURE.
+ */
+static int addPath(sArchiveFileList_t* io_psList, const char* i_pPath,
+                   bool i_isNamed);
+
+/**
+ * @brief Free a list of files.
+ *
+ * @param[inout] io_psList The list.
+ */
+static void freeFileList(sArchiveFileList_t* io_psList);
+
+/**
+ * @brief Split the files into parts and batches.
+ *
+ * @param[inout] io_psWriter The writer, holding the files.
+ * @param[in] i_psOptions The archive options.
+ * @return int EXIT_SUCCESS if the jobs were planned, else EXIT_FAILURE.
+ */
+static int planJobs(sArchiveWriter_t* io_psWriter,
+                    const sHuffmanArchiveOptions_t* i_psOptions);
+
+/**
+ * @brief Read a range of bytes from a file.
+ *
+ * @param[in] i_pPath The path of the file.
+ * @param[in] i_offset The offset of the first byte.
+ * @param[out] o_pOutput The buffer to read into.
+ * @param[in] i_size The number of bytes to read.
+ * @return int EXIT_SUCCESS if every byte was read, else EXIT_FAILURE.
+ */
+static int readFileRange(const char* i_pPath, uint64_t i_offset,
+                         uint8_t* o_pOutput, size_t i_size);
+
+/**
+ * @brief Compress one part of a large file.
+ *
+ * @param[in] i_psWriter The writer.
+ * @param[inout] io_psJob The job.
+ * @return int EXIT_SUCCESS if the part was compressed, else EXIT_FAILURE.
+ */
+static int compressPart(const sArchiveWriter_t* i_psWriter,
+                        sArchiveJob_t* io_psJob);
+
+/**
+ * @brief Compress a batch of small files.
+ *
+ * @param[inout] io_psWorker The worker, whose context is used.
+ * @param[inout] io_psJob The job.
+ * @return int EXIT_SUCCESS if the batch was compressed, else EXIT_FAILURE.
+ */
+static int compressBatch(sArchiveWorker_t* io_psWorker,
+                         sArchiveJob_t* io_psJob);
+
+/**
+ * @brief Compress jobs until there are none left or one fails.
+ *
+ * @param[inout] io_pWorker The worker.
+ * @return void* NULL.
+ */
+static void* runArchiveWorker(void* io_pWorker);
+
+/**
+ * @brief Mark the archive as failed and wake every thread.
+ *
+ * @param[inout] io_psWriter The writer.
+ */
+static void failArchive(sArchiveWriter_t* io_psWriter);
+
+/**
+ * @brief Write each job's output to the archive in order.
+ *
+ * @param[inout] io_psWriter The writer.
+ * @param[inout] io_pFile The archive, positioned after its header.
+ * @return int EXIT_SUCCESS if every member was written, else EXIT_FAILURE.
+ */
+static int writeMembers(sArchiveWriter_t* io_psWriter, FILE* io_pFile);
+
+/**
+ * @brief Write the directory and trailer of the archive.
+ *
+ * @param[in] i_psWriter The writer, whose members have been written.
+ * @param[inout] io_pFile The archive, positioned after its last member.
+ * @return int EXIT_SUCCESS if the directory was written, else EXIT_FAILURE.
+ */
+static int writeDirectory(const sArchiveWriter_t* i_psWriter, FILE* io_pFile);
+
+/**
+ * @brief Read bytes from an archive at an offset.
+ *
+ * @param[in] i_file The archive's file descriptor.
+ * @param[out] o_pOutput The buffer to read into.
+ * @param[in] i_size The number of bytes to read.
+ * @param[in] i_offset The offset of the first byte.
+ * @return int EXIT_SUCCESS if every byte was read, else EXIT_FAILURE.
+ */
+static int readArchive(int i_file, uint8_t* o_pOutput, size_t i_size,
+                       uint64_t i_offset);
+
+/**
+ * @brief Parse and check an archive's directory.
+ *
+ * @param[inout] io_psArchive The archive, whose entries are filled in.
+ * @param[in] i_pDirectory The directory.
+ * @param[in] i_directorySize The number of bytes in the directory.
+ * @return int EXIT_SUCCESS if the directory is valid, else EXIT_FAILURE.
+ */
+static int parseDirectory(sHuffmanArchive_t* io_psArchive,
+                          const uint8_t* i_pDirectory, size_t i_directorySize);
+
+/**
+ * @brief Extract a file from its batch.
+ *
+ * @param[in] i_psEntry The entry.
+ * @param[in] i_pMember The batch.
+ * @param[in] i_memberSize The number of bytes in the batch.
+ * @param[out] o_pOutput The buffer to write the file's bytes to.
+ * @return int EXIT_SUCCESS if the file was extracted, else EXIT_FAILURE.
+ */
+static int extractBatchedEntry(const sArchiveEntry_t* i_psEntry,
+                               const uint8_t* i_pMember, size_t i_memberSize,
+                               uint8_t* o_pOutput);
+
+/* Function Definitions */
+
+/**
+ * @brief Write a little-endian integer.
+ *
+ * @param[out] o_pDest The buffer to write to.
+ * @param[in] i_value The value to write.
+ * @param[in] i_size The number of bytes to write.
+ */
+static void writeInteger(uint8_t* o_pDest, uint64_t i_value, size_t i_size) {
+  for (size_t i = 0; i < i_size; i++) {
+    o_pDest[i] = (uint8_t)(i_value >> (8 * i));
+  }
+}
+
+/**
+ * @brief Read a little-endian integer.
+ *
+ * @param[in] i_pSource The buffer to read from.
+ * @param[in] i_size The number of bytes to read.
+ * @return uint64_t The value read.
+ */
+static uint64_t readInteger(const uint8_t* i_pSource, size_t i_size) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < i_size; i++) {
+    value |= (uint64_t)i_pSource[i] << (8 * i);
+  }
+  return value;
+}
+
+/**
+ * @brief Compare two names for sorting.
+ *
+ * @param[in] i_pLeft A pointer to the first name.
+ * @param[in] i_pRight A pointer to the second name.
+ * @return int The order of the names, as for strcmp.
+ */
+static int compareNames(const void* i_pLeft, const void* i_pRight) {
+  return strcmp(*(const char* const*)i_pLeft, *(const char* const*)i_pRight);
+}
+
+/**
+ * @brief Add a regular file to a list of files.
+ *
+ * @param[inout] io_psList The list.
+ * @param[in] i_pPath The path of the file.
+ * @param[in] i_size The size of the file.
+ * @return int EXIT_SUCCESS if the file was added, else EXIT_FAILURE.
+ */
+static int addFile(sArchiveFileList_t* io_psList, const char* i_pPath,
+                   uint64_t i_size) {
+  const size_t pathSize = strlen(i_pPath);
+  if (pathSize > HUFFMAN_ARCHIVE_MAX_NAME_SIZE) {
+    (void)fprintf(stderr, "ERROR: Path is too long: %s\n", i_pPath);
+    return EXIT_FAILURE;
+  }
+
+  if (io_psList->count == io_psList->capacity) {
+    const size_t capacity =
+        (io_psList->capacity == 0) ? 16 : 2 * io_psList->capacity;
+    sArchiveFile_t* asFiles = (sArchiveFile_t*)allocateHuffmanMemory(
+        NULL, capacity * sizeof(sArchiveFile_t));
+    if (asFiles == NULL) {
+      return EXIT_FAILURE;
+    }
+    if (io_psList->count > 0) {
+      (void)memcpy(asFiles, io_psList->asFiles,
+                   io_psList->count * sizeof(sArchiveFile_t));
+    }
+    freeHuffmanMemory(NULL, io_psList->asFiles);
+    io_psList->asFiles = asFiles;
+    io_psList->capacity = capacity;
+  }
+
+  char* pPath = (char*)allocateHuffmanMemory(NULL, pathSize + 1);
+  if (pPath == NULL) {
+    return EXIT_FAILURE;
+  }
+  (void)memcpy(pPath, i_pPath, pathSize + 1);
+
+  sArchiveFile_t* psFile = &io_psList->asFiles[io_psList->count++];
+  (void)memset(psFile, 0, sizeof(*psFile));
+  psFile->pPath = pPath;
+  psFile->size = i_size;
+  psFile->batchIndex = NOT_BATCHED;
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Add a file, or a directory's regular files, to a list of files.
+ *
+ * Anything other than a regular file or directory found inside a directory
+ * is skipped.
+ *
+ * @param[inout] io_psList The list.
+ * @param[in] i_pPath The path to add.
+ * @param[in] i_isNamed Whether the path was named by the caller.
+ * @return int EXIT_SUCCESS if the path was added, else EXIT_FAILURE.
+ */
+static int addPath(sArchiveFileList_t* io_psList, const char* i_pPath,
+                   bool i_isNamed) {
+  struct stat sStat;
+  if (stat(i_pPath, &sStat) != 0) {
+    perror(i_pPath);
+    return EXIT_FAILURE;
+  }
+
+  if (S_ISREG(sStat.st_mode)) {
+    return addFile(io_psList, i_pPath, (uint64_t)sStat.st_size);
+  }
+  if (!S_ISDIR(sStat.st_mode)) {
+    if (i_isNamed) {
+      (void)fprintf(stderr, "ERROR: Not a file or directory: %s\n", i_pPath);
+      return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+  }
+
+  DIR* pDirectory = opendir(i_pPath);
+  if (pDirectory == NULL) {
+    perror(i_pPath);
+    return EXIT_FAILURE;
+  }
+
+  /* Gather the directory's names so they can be added in sorted order. */
+  const size_t pathSize = strlen(i_pPath);
+  const bool hasSeparator = (pathSize > 0 && i_pPath[pathSize - 1] == '/');
+  char** apPaths = NULL;
+  size_t pathCount = 0;
+  size_t pathCapacity = 0;
+  int result = EXIT_SUCCESS;
+
+  for (const struct dirent* psEntry = readdir(pDirectory); psEntry != NULL;
+       psEntry = readdir(pDirectory)) {
+    if (strcmp(psEntry->d_name, ".") == 0 ||
+        strcmp(psEntry->d_name, "..") == 0) {
+      continue;
+    }
+
+    if (pathCount == pathCapacity) {
+      const size_t capacity = (pathCapacity == 0) ? 16 : 2 * pathCapacity;
+      char** apGrown =
+          (char**)allocateHuffmanMemory(NULL, capacity * sizeof(char*));
+      if (apGrown == NULL) {
+        result = EXIT_FAILURE;
+        break;
+      }
+      if (pathCount > 0) {
+        (void)memcpy(apGrown, apPaths, pathCount * sizeof(char*));
+      }
+      freeHuffmanMemory(NULL, apPaths);
+      apPaths = apGrown;
+      pathCapacity = capacity;
+    }
+
+    const size_t nameSize = strlen(psEntry->d_name);
+    const size_t size = pathSize + (hasSeparator ? 0 : 1) + nameSize + 1;
+    char* pPath = (char*)allocateHuffmanMemory(NULL, size);
+    if (pPath == NULL) {
+      result = EXIT_FAILURE;
+      break;
+    }
+    (void)snprintf(pPath, size, "%s%s%s", i_pPath, hasSeparator ? "" : "/",
+                   psEntry->d_name);
+    apPaths[pathCount++] = pPath;
+  }
+  (void)closedir(pDirectory);
+
+  if (pathCount > 1) {
+    qsort(apPaths, pathCount, sizeof(char*), compareNames);
+  }
+
+  for (size_t i = 0; i < pathCount; i++) {
+    if (result == EXIT_SUCCESS) {
+      result = addPath(io_psList, apPaths[i], false);
+    }
+    freeHuffmanMemory(NULL, apPaths[i]);
+  }
+  freeHuffmanMemory(NULL, apPaths);
+  return result;
+}
+
+/**
+ * @brief Free a list of files.
+ *
+ * @param[inout] io_psList The list.
+ */
+static void freeFileList(sArchiveFileList_t* io_psList) {
+  for (size_t i = 0; i < io_psList->count; i++) {
+    freeHuffmanMemory(NULL, io_psList->asFiles[i].pPath);
+  }
+  freeHuffmanMemory(NULL, io_psList->asFiles);
+  (void)memset(io_psList, 0, sizeof(*io_psList));
+}
+
+/**
+ * @brief Split the files into parts and batches.
+ *
+ * @param[inout] io_psWriter The writer, holding the files.
+ * @param[in] i_psOptions The archive options.
+ * @return int EXIT_SUCCESS if the jobs were planned, else EXIT_FAILURE.
+ */
+static int planJobs(sArchiveWriter_t* io_psWriter,
+                    const sHuffmanArchiveOptions_t* i_psOptions) {
+  /* Count the jobs, so they can be allocated at once. */
+  size_t jobCount = 0;
+  size_t batchedCount = 0;
+  uint64_t batchSize = 0;
+  bool isBatchOpen = false;
+  for (size_t i = 0; i < io_psWriter->fileCount; i++) {
+    const uint64_t size = io_psWriter->asFiles[i].size;
+    if (size > i_psOptions->smallFileSize) {
+      jobCount += (size_t)((size - 1) / i_psOptions->partSize + 1);
+      continue;
+    }
+    if (!isBatchOpen || batchSize + size > i_psOptions->batchSize) {
+      jobCount++;
+      batchSize = 0;
+      isBatchOpen = true;
+    }
+    batchSize += size;
+    batchedCount++;
+  }
+
+  io_psWriter->asJobs = (sArchiveJob_t*)allocateHuffmanMemory(
+      NULL, (jobCount + 1) * sizeof(sArchiveJob_t));
+  io_psWriter->aBatchFiles = (size_t*)allocateHuffmanMemory(
+      NULL, (batchedCount + 1) * sizeof(size_t));
+  if (io_psWriter->asJobs == NULL || io_psWriter->aBatchFiles == NULL) {
+    return EXIT_FAILURE;
+  }
+  (void)memset(io_psWriter->asJobs, 0, (jobCount + 1) * sizeof(sArchiveJob_t));
+
+  /* Split each large file into parts, and add each small file to the open
+   * batch, starting a new batch when it would grow too large. */
+  sArchiveJob_t* psBatch = NULL;
+  io_psWriter->jobCount = 0;
+  batchedCount = 0;
+  for (size_t i = 0; i < io_psWriter->fileCount; i++) {
+    sArchiveFile_t* psFile = &io_psWriter->asFiles[i];
+
+    if (psFile->size > i_psOptions->smallFileSize) {
+      psFile->firstJob = io_psWriter->jobCount;
+      for (uint64_t offset = 0; offset < psFile->size;
+           offset += i_psOptions->partSize) {
+        const uint64_t remaining = psFile->size - offset;
+        sArchiveJob_t* psJob = &io_psWriter->asJobs[io_psWriter->jobCount++];
+        psJob->firstFile = i;
+        psJob->fileCount = 1;
+        psJob->offset = offset;
+        psJob->size = (remaining < i_psOptions->partSize)
+                          ? (size_t)remaining
+                          : i_psOptions->partSize;
+        psFile->jobCount++;
+      }
+      continue;
+    }
+
+    if (psBatch == NULL ||
+        (uint64_t)psBatch->size + psFile->size > i_psOptions->batchSize) {
+      psBatch = &io_psWriter->asJobs[io_psWriter->jobCount++];
+      psBatch->isBatch = true;
+      psBatch->firstFile = batchedCount;
+    }
+    psFile->batchIndex = (uint32_t)psBatch->fileCount;
+    psFile->firstJob = (size_t)(psBatch - io_psWriter->asJobs);
+    psFile->jobCount = 1;
+    psBatch->fileCount++;
+    psBatch->size += (size_t)psFile->size;
+    io_psWriter->aBatchFiles[batchedCount++] = i;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Read a range of bytes from a file.
+ *
+ * @param[in] i_pPath The path of the file.
+ * @param[in] i_offset The offset of the first byte.
+ * @param[out] o_pOutput The buffer to read into.
+ * @param[in] i_size The number of bytes to read.
+ * @return int EXIT_SUCCESS if every byte was read, else EXIT_FAILURE.
+ */
+static int readFileRange(const char* i_pPath, uint64_t i_offset,
+                         uint8_t* o_pOutput, size_t i_size) {
+  FILE* pFile = fopen(i_pPath, "rb");
+  if (pFile == NULL) {
+    perror(i_pPath);
+    return EXIT_FAILURE;
+  }
+
+  int result = EXIT_SUCCESS;
+  if ((i_offset > 0 && fseeko(pFile, (off_t)i_offset, SEEK_SET) != 0) ||
+      fread(o_pOutput, 1, i_size, pFile) != i_size) {
+    (void)fprintf(stderr, "ERROR: Could not read %s\n", i_pPath);
+    result = EXIT_FAILURE;
+  }
+  (void)fclose(pFile);
+  return result;
+}
+
+/**
+ * @brief Compress one part of a large file.
+ *
+ * @param[in] i_psWriter The writer.
+ * @param[inout] io_psJob The job.
+ * @return int EXIT_SUCCESS if the part was compressed, else EXIT_FAILURE.
+ */
+static int compressPart(const sArchiveWriter_t* i_psWriter,
+                        sArchiveJob_t* io_psJob) {
+  const sArchiveFile_t* psFile = &i_psWriter->asFiles[io_psJob->firstFile];
+  const size_t capacity = getCompressBound(io_psJob->size, NULL);
+  uint8_t* pInput = (uint8_t*)allocateHuffmanMemory(NULL, io_psJob->size);
+  io_psJob->pOutput = (uint8_t*)allocateHuffmanMemory(NULL, capacity);
+
+  /* Compressing without a context builds the histogram and tree with the
+   * same routines as the original file compressor. */
+  int result = EXIT_FAILURE;
+  if (pInput != NULL && io_psJob->pOutput != NULL &&
+      readFileRange(psFile->pPath, io_psJob->offset, pInput, io_psJob->size) ==
+          EXIT_SUCCESS) {
+    result = compressBuffer(pInput, io_psJob->size, io_psJob->pOutput,
+                            capacity, &io_psJob->outputSize, NULL);
+  }
+  freeHuffmanMemory(NULL, pInput);
+  return result;
+}
+
+/**
+ * @brief Compress a batch of small files.
+ *
+ * @param[inout] io_psWorker The worker, whose context is used.
+ * @param[inout] io_psJob The job.
+ * @return int EXIT_SUCCESS if the batch was compressed, else EXIT_FAILURE.
+ */
+static int compressBatch(sArchiveWorker_t* io_psWorker,
+                         sArchiveJob_t* io_psJob) {
+  const sArchiveWriter_t* psWriter = io_psWorker->psWriter;
+  const size_t count = io_psJob->fileCount;
+  const size_t capacity = getBatchCompressBound(count, io_psJob->size);
+  uint8_t* pInput = (uint8_t*)allocateHuffmanMemory(NULL, io_psJob->size + 1);
+  const uint8_t** apInputs =
+      (const uint8_t**)allocateHuffmanMemory(NULL, count * sizeof(uint8_t*));
+  size_t* aInputSizes =
+      (size_t*)allocateHuffmanMemory(NULL, count * sizeof(size_t));
+  io_psJob->pOutput = (uint8_t*)allocateHuffmanMemory(NULL, capacity);
+
+  int result = EXIT_FAILURE;
+  if (pInput != NULL && apInputs != NULL && aInputSizes != NULL &&
+      io_psJob->pOutput != NULL) {
+    result = EXIT_SUCCESS;
+    size_t position = 0;
+    for (size_t i = 0; i < count && result == EXIT_SUCCESS; i++) {
+      const sArchiveFile_t* psFile =
+          &psWriter->asFiles[psWriter->aBatchFiles[io_psJob->firstFile + i]];
+      apInputs[i] = &pInput[position];
+      aInputSizes[i] = (size_t)psFile->size;
+      result = readFileRange(psFile->pPath, 0, &pInput[position],
+                             aInputSizes[i]);
+      position += aInputSizes[i];
+    }
+  }
+
+  if (result == EXIT_SUCCESS) {
+    result = compressBatchWithContext(io_psWorker->psContext, apInputs,
+                                      aInputSizes, count, io_psJob->pOutput,
+                                      capacity, NULL, &io_psJob->outputSize);
+  }
+  freeHuffmanMemory(NULL, aInputSizes);
+  freeHuffmanMemory(NULL, (void*)apInputs);
+  freeHuffmanMemory(NULL, pInput);
+  return result;
+}
+
+/**
+ * @brief Compress jobs until there are none left or one fails.
+ *
+ * @param[inout] io_pWorker The worker.
+ * @return void* NULL.
+ */
+static void* runArchiveWorker(void* io_pWorker) {
+  sArchiveWorker_t* psWorker = (sArchiveWorker_t*)io_pWorker;
+  sArchiveWriter_t* psWriter = psWorker->psWriter;
+
+  for (;;) {
+    (void)pthread_mutex_lock(&psWriter->mutex);
+    while (!psWriter->isFailed && psWriter->nextJob < psWriter->jobCount &&
+           psWriter->nextJob >=
+               psWriter->writtenCount + psWriter->windowSize) {
+      (void)pthread_cond_wait(&psWriter->changed, &psWriter->mutex);
+    }
+    if (psWriter->isFailed || psWriter->nextJob == psWriter->jobCount) {
+      (void)pthread_mutex_unlock(&psWriter->mutex);
+      return NULL;
+    }
+    sArchiveJob_t* psJob = &psWriter->asJobs[psWriter->nextJob++];
+    (void)pthread_mutex_unlock(&psWriter->mutex);
+
+    const int result = psJob->isBatch ? compressBatch(psWorker, psJob)
+                                      : compressPart(psWriter, psJob);
+
+    (void)pthread_mutex_lock(&psWriter->mutex);
+    psJob->isDone = true;
+    if (result == EXIT_FAILURE) {
+      psWriter->isFailed = true;
+    }
+    (void)pthread_cond_broadcast(&psWriter->changed);
+    (void)pthread_mutex_unlock(&psWriter->mutex);
+  }
+}
+
+/**
+ * @brief Mark the archive as failed and wake every thread.
+ *
+ * @param[inout] io_psWriter The writer.
+ */
+static void failArchive(sArchiveWriter_t* io_psWriter) {
+  (void)pthread_mutex_lock(&io_psWriter->mutex);
+  io_psWriter->isFailed = true;
+  (void)pthread_cond_broadcast(&io_psWriter->changed);
+  (void)pthread_mutex_unlock(&io_psWriter->mutex);
+}
+
+/**
+ * @brief Write each job's output to the archive in order.
+ *
+ * @param[inout] io_psWriter The writer.
+ * @param[inout] io_pFile The archive, positioned after its header.
+ * @return int EXIT_SUCCESS if every member was written, else EXIT_FAILURE.
+ */
+static int writeMembers(sArchiveWriter_t* io_psWriter, FILE* io_pFile) {
+  uint64_t position = HUFFMAN_ARCHIVE_HEADER_SIZE;
+
+  for (size_t i = 0; i < io_psWriter->jobCount; i++) {
+    sArchiveJob_t* psJob = &io_psWriter->asJobs[i];
+
+    (void)pthread_mutex_lock(&io_psWriter->mutex);
+    while (!psJob->isDone && !io_psWriter->isFailed) {
+      (void)pthread_cond_wait(&io_psWriter->changed, &io_psWriter->mutex);
+    }
+    const bool isFailed = io_psWriter->isFailed;
+    (void)pthread_mutex_unlock(&io_psWriter->mutex);
+    if (isFailed) {
+      return EXIT_FAILURE;
+    }
+
+    if (fwrite(psJob->pOutput, 1, psJob->outputSize, io_pFile) !=
+        psJob->outputSize) {
+      perror("fwrite");
+      failArchive(io_psWriter);
+      return EXIT_FAILURE;
+    }
+    psJob->archiveOffset = position;
+    position += psJob->outputSize;
+    freeHuffmanMemory(NULL, psJob->pOutput);
+    psJob->pOutput = NULL;
+
+    (void)pthread_mutex_lock(&io_psWriter->mutex);
+    io_psWriter->writtenCount++;
+    (void)pthread_cond_broadcast(&io_psWriter->changed);
+    (void)pthread_mutex_unlock(&io_psWriter->mutex);
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Write the directory and trailer of the archive.
+ *
+ * @param[in] i_psWriter The writer, whose members have been written.
+ * @param[inout] io_pFile The archive, positioned after its last member.
+ * @return int EXIT_SUCCESS if the directory was written, else EXIT_FAILURE.
+ */
+static int writeDirectory(const sArchiveWriter_t* i_psWriter, FILE* io_pFile) {
+  const off_t directoryOffset = ftello(io_pFile);
+  if (directoryOffset < 0 || i_psWriter->fileCount > UINT32_MAX) {
+    (void)fprintf(stderr, "ERROR: Could not write the archive directory\n");
+    return EXIT_FAILURE;
+  }
+
+  /* Each entry is written through one buffer sized for the largest. */
+  size_t capacity = 0;
+  for (size_t i = 0; i < i_psWriter->fileCount; i++) {
+    const sArchiveFile_t* psFile = &i_psWriter->asFiles[i];
+    const size_t size = ENTRY_FIXED_SIZE + strlen(psFile->pPath) +
+                        psFile->jobCount * MEMBER_SIZE;
+    capacity = (size > capacity) ? size : capacity;
+  }
+  capacity = (capacity < HUFFMAN_ARCHIVE_TRAILER_SIZE)
+                 ? HUFFMAN_ARCHIVE_TRAILER_SIZE
+                 : capacity;
+  uint8_t* pBuffer = (uint8_t*)allocateHuffmanMemory(NULL, capacity);
+  if (pBuffer == NULL) {
+    return EXIT_FAILURE;
+  }
+
+  int result = EXIT_SUCCESS;
+  for (size_t i = 0; i < i_psWriter->fileCount && result == EXIT_SUCCESS;
+       i++) {
+    const sArchiveFile_t* psFile = &i_psWriter->asFiles[i];
+    const size_t nameSize = strlen(psFile->pPath);
+    writeInteger(pBuffer, nameSize, 2);
+    (void)memcpy(&pBuffer[2], psFile->pPath, nameSize);
+    size_t position = 2 + nameSize;
+    writeInteger(&pBuffer[position], psFile->size, 8);
+    writeInteger(&pBuffer[position + 8], psFile->batchIndex, 4);
+    writeInteger(&pBuffer[position + 12], psFile->jobCount, 4);
+    position += 16;
+
+    for (size_t j = 0; j < psFile->jobCount; j++) {
+      const sArchiveJob_t* psJob = &i_psWriter->asJobs[psFile->firstJob + j];
+      writeInteger(&pBuffer[position], psJob->archiveOffset, 8);
+      writeInteger(&pBuffer[position + 8], psJob->outputSize, 8);
+      position += MEMBER_SIZE;
+    }
+
+    if (fwrite(pBuffer, 1, position, io_pFile) != position) {
+      result = EXIT_FAILURE;
+    }
+  }
+
+  writeInteger(pBuffer, (uint64_t)directoryOffset, 8);
+  writeInteger(&pBuffer[8], i_psWriter->fileCount, 4);
+  (void)memcpy(&pBuffer[12], ARCHIVE_TRAILER_MAGIC,
+               sizeof(ARCHIVE_TRAILER_MAGIC));
+  if (result == EXIT_SUCCESS &&
+      fwrite(pBuffer, 1, HUFFMAN_ARCHIVE_TRAILER_SIZE, io_pFile) !=
+          HUFFMAN_ARCHIVE_TRAILER_SIZE) {
+    result = EXIT_FAILURE;
+  }
+  if (result == EXIT_FAILURE) {
+    perror("fwrite");
+  }
+
+  freeHuffmanMemory(NULL, pBuffer);
+  return result;
+}
+
+/**
+ * @brief Initialise archive options to the defaults.
+ *
+ * @param[out] o_psOptions The options to initialise.
+ */
+void initArchiveOptions(sHuffmanArchiveOptions_t* o_psOptions) {
+  o_psOptions->threadCount = 0;
+  o_psOptions->smallFileSize = HUFFMAN_ARCHIVE_DEFAULT_SMALL_FILE_SIZE;
+  o_psOptions->batchSize = HUFFMAN_ARCHIVE_DEFAULT_BATCH_SIZE;
+  o_psOptions->partSize = HUFFMAN_ARCHIVE_DEFAULT_PART_SIZE;
+}
+
+/**
+ * @brief Compress files into an archive.
+ *
+ * Each path may be a file or a directory, whose regular files are added
+ * recursively in name order. Entries are named by the path they were found
+ * at. The files are compressed by a pool of threads and written in order,
+ * so the archive does not depend on the number of threads. The archive is
+ * removed if any file cannot be read or compressed.
+ *
+ * @param[in] i_apPaths The files and directories to add.
+ * @param[in] i_pathCount The number of paths.
+ * @param[in] i_pArchivePath The path to write the archive to.
+ * @param[in] i_psOptions The archive options, or NULL for the defaults.
+ * @return int EXIT_SUCCESS if the archive was written, else EXIT_FAILURE.
+ */
+int createArchive(const char* const* i_apPaths, size_t i_pathCount,
+                  const char* i_pArchivePath,
+                  const sHuffmanArchiveOptions_t* i_psOptions) {
+  sHuffmanArchiveOptions_t sOptions;
+  initArchiveOptions(&sOptions);
+  if (i_psOptions != NULL) {
+    sOptions = *i_psOptions;
+  }
+  if (sOptions.partSize == 0 ||
+      sOptions.smallFileSize > HUFFMAN_MAX_BLOCK_SIZE) {
+    (void)fprintf(stderr, "ERROR: Invalid archive options\n");
+    return EXIT_FAILURE;
+  }
+
+  /* Find the files to add. */
+  sArchiveFileList_t sList = {NULL, 0, 0};
+  for (size_t i = 0; i < i_pathCount; i++) {
+    if (addPath(&sList, i_apPaths[i], true) == EXIT_FAILURE) {
+      freeFileList(&sList);
+      return EXIT_FAILURE;
+    }
+  }
+
+  sArchiveWriter_t sWriter;
+  (void)memset(&sWriter, 0, sizeof(sWriter));
+  sWriter.asFiles = sList.asFiles;
+  sWriter.fileCount = sList.count;
+  if (sWriter.fileCount > UINT32_MAX) {
+    (void)fprintf(stderr, "ERROR: Too many files to archive\n");
+  }
+  if (sWriter.fileCount > UINT32_MAX ||
+      planJobs(&sWriter, &sOptions) == EXIT_FAILURE) {
+    freeHuffmanMemory(NULL, sWriter.asJobs);
+    freeHuffmanMemory(NULL, sWriter.aBatchFiles);
+    freeFileList(&sList);
+    return EXIT_FAILURE;
+  }
+
+  size_t threadCount = sOptions.threadCount;
+  if (threadCount == 0) {
+    const long onlineCount = sysconf(_SC_NPROCESSORS_ONLN);
+    threadCount = (onlineCount > 0) ? (size_t)onlineCount : 1;
+  }
+  threadCount =
+      (threadCount > MAX_ARCHIVE_THREADS) ? MAX_ARCHIVE_THREADS : threadCount;
+  threadCount = (threadCount > sWriter.jobCount) ? sWriter.jobCount
+                                                 : threadCount;
+  sWriter.windowSize = JOBS_PER_THREAD * ((threadCount > 0) ? threadCount : 1);
+
+  FILE* pFile = fopen(i_pArchivePath, "wb");
+  if (pFile == NULL) {
+    perror(i_pArchivePath);
+    freeHuffmanMemory(NULL, sWriter.asJobs);
+    freeHuffmanMemory(NULL, sWriter.aBatchFiles);
+    freeFileList(&sList);
+    return EXIT_FAILURE;
+  }
+
+  uint8_t aHeader[HUFFMAN_ARCHIVE_HEADER_SIZE] = {0};
+  (void)memcpy(aHeader, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC));
+  aHeader[4] = HUFFMAN_ARCHIVE_VERSION;
+  int result = (fwrite(aHeader, 1, sizeof(aHeader), pFile) == sizeof(aHeader))
+                   ? EXIT_SUCCESS
+                   : EXIT_FAILURE;
+
+  /* Start the workers, each with a context for compressing batches. */
+  (void)pthread_mutex_init(&sWriter.mutex, NULL);
+  (void)pthread_cond_init(&sWriter.changed, NULL);
+  sArchiveWorker_t asWorkers[MAX_ARCHIVE_THREADS];
+  size_t startedCount = 0;
+  for (size_t i = 0; i < threadCount && result == EXIT_SUCCESS; i++) {
+    asWorkers[i].psWriter = &sWriter;
+    asWorkers[i].psContext = createHuffmanContext(NULL);
+    if (asWorkers[i].psContext == NULL) {
+      break;
+    }
+    if (pthread_create(&asWorkers[i].thread, NULL, runArchiveWorker,
+                       &asWorkers[i]) != 0) {
+      freeHuffmanContext(asWorkers[i].psContext);
+      break;
+    }
+    startedCount++;
+  }
+  if (startedCount == 0 && sWriter.jobCount > 0) {
+    (void)fprintf(stderr, "ERROR: Could not start the archive threads\n");
+    result = EXIT_FAILURE;
+  }
+
+  /* Write the members as they are compressed, then the directory. */
+  if (result == EXIT_SUCCESS) {
+    result = writeMembers(&sWriter, pFile);
+  }
+  if (result == EXIT_FAILURE) {
+    failArchive(&sWriter);
+  }
+  for (size_t i = 0; i < startedCount; i++) {
+    (void)pthread_join(asWorkers[i].thread, NULL);
+    freeHuffmanContext(asWorkers[i].psContext);
+  }
+  if (result == EXIT_SUCCESS) {
+    result = writeDirectory(&sWriter, pFile);
+  }
+  if (fclose(pFile) != 0 && result == EXIT_SUCCESS) {
+    perror(i_pArchivePath);
+    result = EXIT_FAILURE;
+  }
+  if (result == EXIT_FAILURE) {
+    (void)remove(i_pArchivePath);
+  }
+
+  (void)pthread_cond_destroy(&sWriter.changed);
+  (void)pthread_mutex_destroy(&sWriter.mutex);
+  for (size_t i = 0; i < sWriter.jobCount; i++) {
+    freeHuffmanMemory(NULL, sWriter.asJobs[i].pOutput);
+  }
+  freeHuffmanMemory(NULL, sWriter.asJobs);
+  freeHuffmanMemory(NULL, sWriter.aBatchFiles);
+  freeFileList(&sList);
+  return result;
+}
+
+/**
+ * @brief Read bytes from an archive at an offset.
+ *
+ * @param[in] i_file The archive's file descriptor.
+ * @param[out] o_pOutput The buffer to read into.
+ * @param[in] i_size The number of bytes to read.
+ * @param[in] i_offset The offset of the first byte.
+ * @return int EXIT_SUCCESS if every byte was read, else EXIT_FAILURE.
+ */
+static int readArchive(int i_file, uint8_t* o_pOutput, size_t i_size,
+                       uint64_t i_offset) {
+  size_t position = 0;
+  while (position < i_size) {
+    const ssize_t count = pread(i_file, &o_pOutput[position],
+                                i_size - position,
+                                (off_t)(i_offset + position));
+    if (count <= 0) {
+      (void)fprintf(stderr, "ERROR: Could not read the archive\n");
+      return EXIT_FAILURE;
+    }
+    position += (size_t)count;
+  }
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Parse and check an archive's directory.
+ *
+ * @param[inout] io_psArchive The archive, whose entries are filled in.
+ * @param[in] i_pDirectory The directory.
+ * @param[in] i_directorySize The number of bytes in the directory.
+ * @return int EXIT_SUCCESS if the directory is valid, else EXIT_FAILURE.
+ */
+static int parseDirectory(sHuffmanArchive_t* io_psArchive,
+                          const uint8_t* i_pDirectory,
+                          size_t i_directorySize) {
+  /* Every name and member fits in the directory, which bounds the memory
+   * needed before the entries are read. */
+  const size_t entryCount = io_psArchive->entryCount;
+  io_psArchive->asEntries = (sArchiveEntry_t*)allocateHuffmanMemory(
+      NULL, (entryCount + 1) * sizeof(sArchiveEntry_t));
+  io_psArchive->asMembers = (sArchiveMember_t*)allocateHuffmanMemory(
+      NULL, (i_directorySize / MEMBER_SIZE + 1) * sizeof(sArchiveMember_t));
+  io_psArchive->pNames =
+      (char*)allocateHuffmanMemory(NULL, i_directorySize + entryCount + 1);
+  if (io_psArchive->asEntries == NULL || io_psArchive->asMembers == NULL ||
+      io_psArchive->pNames == NULL) {
+    return EXIT_FAILURE;
+  }
+
+  size_t position = 0;
+  size_t memberCount = 0;
+  char* pName = io_psArchive->pNames;
+  for (size_t i = 0; i < entryCount; i++) {
+    sArchiveEntry_t* psEntry = &io_psArchive->asEntries[i];
+    if (i_directorySize - position < 2) {
+      return EXIT_FAILURE;
+    }
+    const size_t nameSize = (size_t)readInteger(&i_pDirectory[position], 2);
+    position += 2;
+    if (i_directorySize - position < nameSize + ENTRY_FIXED_SIZE - 2) {
+      return EXIT_FAILURE;
+    }
+    (void)memcpy(pName, &i_pDirectory[position], nameSize);
+    pName[nameSize] = '\0';
+    psEntry->pName = pName;
+    pName += nameSize + 1;
+    position += nameSize;
+
+    psEntry->size = readInteger(&i_pDirectory[position], 8);
+    psEntry->batchIndex = (uint32_t)readInteger(&i_pDirectory[position + 8], 4);
+    psEntry->memberCount = (size_t)readInteger(&i_pDirectory[position + 12], 4);
+    psEntry->firstMember = memberCount;
+    position += 16;
+    if ((i_directorySize - position) / MEMBER_SIZE < psEntry->memberCount ||
+        (psEntry->batchIndex != NOT_BATCHED && psEntry->memberCount != 1)) {
+      return EXIT_FAILURE;
+    }
+
+    for (size_t j = 0; j < psEntry->memberCount; j++) {
+      sArchiveMember_t* psMember = &io_psArchive->asMembers[memberCount++];
+      psMember->offset = readInteger(&i_pDirectory[position], 8);
+      psMember->size = readInteger(&i_pDirectory[position + 8], 8);
+      position += MEMBER_SIZE;
+      if (psMember->offset < HUFFMAN_ARCHIVE_HEADER_SIZE ||
+          psMember->offset > io_psArchive->directoryOffset ||
+          psMember->size > io_psArchive->directoryOffset - psMember->offset) {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return (position == i_directorySize) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @brief Open an archive and read its directory.
+ *
+ * @param[in] i_pArchivePath The path of the archive.
+ * @return sHuffmanArchive_t* The archive, else NULL.
+ */
+sHuffmanArchive_t* openArchive(const char* i_pArchivePath) {
+  const int file = open(i_pArchivePath, O_RDONLY);
+  if (file < 0) {
+    perror(i_pArchivePath);
+    return NULL;
+  }
+
+  sHuffmanArchive_t* psArchive =
+      (sHuffmanArchive_t*)allocateHuffmanMemory(NULL, sizeof(*psArchive));
+  if (psArchive == NULL) {
+    (void)close(file);
+    return NULL;
+  }
+  (void)memset(psArchive, 0, sizeof(*psArchive));
+  psArchive->file = file;
+
+  /* Check the header and trailer, then read the directory between the last
+   * member and the trailer. */
+  struct stat sStat;
+  uint8_t aHeader[HUFFMAN_ARCHIVE_HEADER_SIZE];
+  uint8_t aTrailer[HUFFMAN_ARCHIVE_TRAILER_SIZE];
+  bool isValid =
+      fstat(file, &sStat) == 0 &&
+      (uint64_t)sStat.st_size >=
+          HUFFMAN_ARCHIVE_HEADER_SIZE + HUFFMAN_ARCHIVE_TRAILER_SIZE &&
+      readArchive(file, aHeader, sizeof(aHeader), 0) == EXIT_SUCCESS &&
+      readArchive(file, aTrailer, sizeof(aTrailer),
+                  (uint64_t)sStat.st_size - sizeof(aTrailer)) ==
+          EXIT_SUCCESS &&
+      memcmp(aHeader, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC)) == 0 &&
+      aHeader[4] == HUFFMAN_ARCHIVE_VERSION &&
+      memcmp(&aTrailer[12], ARCHIVE_TRAILER_MAGIC,
+             sizeof(ARCHIVE_TRAILER_MAGIC)) == 0;
+
+  uint8_t* pDirectory = NULL;
+  if (isValid) {
+    const uint64_t directoryEnd = (uint64_t)sStat.st_size - sizeof(aTrailer);
+    psArchive->directoryOffset = readInteger(aTrailer, 8);
+    psArchive->entryCount = (size_t)readInteger(&aTrailer[8], 4);
+    isValid = psArchive->directoryOffset >= HUFFMAN_ARCHIVE_HEADER_SIZE &&
+              psArchive->directoryOffset <= directoryEnd;
+
+    const size_t directorySize =
+        isValid ? (size_t)(directoryEnd - psArchive->directoryOffset) : 0;
+    isValid = isValid &&
+              psArchive->entryCount <= directorySize / ENTRY_FIXED_SIZE;
+    if (isValid) {
+      pDirectory = (uint8_t*)allocateHuffmanMemory(NULL, directorySize + 1);
+      isValid = pDirectory != NULL &&
+                readArchive(file, pDirectory, directorySize,
+                            psArchive->directoryOffset) == EXIT_SUCCESS &&
+                parseDirectory(psArchive, pDirectory, directorySize) ==
+                    EXIT_SUCCESS;
+    }
+  }
+  freeHuffmanMemory(NULL, pDirectory);
+
+  if (!isValid) {
+    (void)fprintf(stderr, "ERROR: Invalid archive: %s\n", i_pArchivePath);
+    closeArchive(psArchive);
+    return NULL;
+  }
+  return psArchive;
+}
+
+/**
+ * @brief Close an archive.
+ *
+ * @param[inout] io_psArchive The archive, or NULL.
+ */
+void closeArchive(sHuffmanArchive_t* io_psArchive) {
+  if (io_psArchive == NULL) {
+    return;
+  }
+  (void)close(io_psArchive->file);
+  freeHuffmanMemory(NULL, io_psArchive->asEntries);
+  freeHuffmanMemory(NULL, io_psArchive->asMembers);
+  freeHuffmanMemory(NULL, io_psArchive->pNames);
+  freeHuffmanMemory(NULL, io_psArchive);
+}
+
+/**
+ * @brief Find the number of files in an archive.
+ *
+ * @param[in] i_psArchive The archive.
+ * @return size_t The number of entries.
+ */
+size_t getArchiveEntryCount(const sHuffmanArchive_t* i_psArchive) {
+  return i_psArchive->entryCount;
+}
+
+/**
+ * @brief Find the name of a file in an archive.
+ *
+ * @param[in] i_psArchive The archive.
+ * @param[in] i_index The index of the entry.
+ * @return const char* The entry's name, owned by the archive.
+ */
+const char* getArchiveEntryName(const sHuffmanArchive_t* i_psArchive,
+                                size_t i_index) {
+  return i_psArchive->asEntries[i_index].pName;
+}
+
+/**
+ * @brief Find the uncompressed size of a file in an archive.
+ *
+ * @param[in] i_psArchive The archive.
+ * @param[in] i_index The index of the entry.
+ * @return uint64_t The entry's uncompressed size.
+ */
+uint64_t getArchiveEntrySize(const sHuffmanArchive_t* i_psArchive,
+                             size_t i_index) {
+  return i_psArchive->asEntries[i_index].size;
+}
+
+/**
+ * @brief Find a file in an archive by name.
+ *
+ * @param[in] i_psArchive The archive.
+ * @param[in] i_pName The name to find.
+ * @param[out] o_pIndex The index of the first entry with the name.
+ * @return int EXIT_SUCCESS if the name was found, else EXIT_FAILURE.
+ */
+int findArchiveEntry(const sHuffmanArchive_t* i_psArchive, const char* i_pName,
+                     size_t* o_pIndex) {
+  for (size_t i = 0; i < i_psArchive->entryCount; i++) {
+    if (strcmp(i_psArchive->asEntries[i].pName, i_pName) == 0) {
+      *o_pIndex = i;
+      return EXIT_SUCCESS;
+    }
+  }
+  return EXIT_FAILURE;
+}
+
+/**
+ * @brief Extract a file from its batch.
+ *
+ * @param[in] i_psEntry The entry.
+ * @param[in] i_pMember The batch.
+ * @param[in] i_memberSize The number of bytes in the batch.
+ * @param[out] o_pOutput The buffer to write the file's bytes to.
+ * @return int EXIT_SUCCESS if the file was extracted, else EXIT_FAILURE.
+ */
+static int extractBatchedEntry(const sArchiveEntry_t* i_psEntry,
+                               const uint8_t* i_pMember, size_t i_memberSize,
+                               uint8_t* o_pOutput) {
+  size_t bufferCount = 0;
+  size_t decompressedSize = 0;
+  if (getBatchInfo(i_pMember, i_memberSize, &bufferCount, &decompressedSize) ==
+          EXIT_FAILURE ||
+      i_psEntry->batchIndex >= bufferCount) {
+    return EXIT_FAILURE;
+  }
+
+  /* The whole batch shares one payload, so it is decoded together. */
+  sHuffmanContext_t* psContext = createHuffmanContext(NULL);
+  uint8_t* pBatch = (uint8_t*)allocateHuffmanMemory(NULL, decompressedSize + 1);
+  size_t* aOffsets = (size_t*)allocateHuffmanMemory(
+      NULL, (bufferCount + 1) * sizeof(size_t));
+  size_t outputSize = 0;
+  int result = EXIT_FAILURE;
+  if (psContext != NULL && pBatch != NULL && aOffsets != NULL &&
+      decompressBatchWithContext(psContext, i_pMember, i_memberSize, pBatch,
+                                 decompressedSize, aOffsets,
+                                 &outputSize) == EXIT_SUCCESS) {
+    const size_t offset = aOffsets[i_psEntry->batchIndex];
+    const size_t size = aOffsets[i_psEntry->batchIndex + 1] - offset;
+    if (size == i_psEntry->size) {
+      if (size > 0) {
+        (void)memcpy(o_pOutput, &pBatch[offset], size);
+      }
+      result = EXIT_SUCCESS;
+    }
+  }
+
+  freeHuffmanMemory(NULL, aOffsets);
+  freeHuffmanMemory(NULL, pBatch);
+  freeHuffmanContext(psContext);
+  return result;
+}
+
+/**
+ * @brief Extract one file from an archive.
+ *
+ * Only the entry's own members are read from the archive.
+ *
+ * @param[in] i_psArchive The archive.
+ * @param[in] i_index The index of the entry.
+ * @param[out] o_pOutput The buffer to write the file's bytes to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @return int EXIT_SUCCESS if the file was extracted, else EXIT_FAILURE.
+ */
+int extractArchiveEntry(const sHuffmanArchive_t* i_psArchive, size_t i_index,
+                        uint8_t* o_pOutput, size_t i_outputCapacity) {
+  if (i_index >= i_psArchive->entryCount) {
+    (void)fprintf(stderr, "ERROR: No such archive entry\n");
+    return EXIT_FAILURE;
+  }
+  const sArchiveEntry_t* psEntry = &i_psArchive->asEntries[i_index];
+  if (psEntry->size > i_outputCapacity) {
+    (void)fprintf(stderr, "ERROR: Output buffer is too small\n");
+    return EXIT_FAILURE;
+  }
+
+  /* Read each member through one buffer sized for the largest. */
+  const sArchiveMember_t* asMembers =
+      &i_psArchive->asMembers[psEntry->firstMember];
+  size_t bufferSize = 0;
+  for (size_t i = 0; i < psEntry->memberCount; i++) {
+    bufferSize = (asMembers[i].size > bufferSize) ? (size_t)asMembers[i].size
+                                                  : bufferSize;
+  }
+  uint8_t* pBuffer = (uint8_t*)allocateHuffmanMemory(NULL, bufferSize + 1);
+  if (pBuffer == NULL) {
+    return EXIT_FAILURE;
+  }
+
+  int result = EXIT_SUCCESS;
+  size_t position = 0;
+  for (size_t i = 0; i < psEntry->memberCount && result == EXIT_SUCCESS;
+       i++) {
+    const size_t memberSize = (size_t)asMembers[i].size;
+    result = readArchive(i_psArchive->file, pBuffer, memberSize,
+                         asMembers[i].offset);
+    if (result == EXIT_FAILURE) {
+      break;
+    }
+
+    if (psEntry->batchIndex != NOT_BATCHED) {
+      result = extractBatchedEntry(psEntry, pBuffer, memberSize, o_pOutput);
+      position = (size_t)psEntry->size;
+    } else {
+      size_t outputSize = 0;
+      result = decompressBuffer(pBuffer, memberSize, &o_pOutput[position],
+                                (size_t)psEntry->size - position,
+                                &outputSize);
+      position += outputSize;
+    }
+  }
+  if (result == EXIT_SUCCESS && position != psEntry->size) {
+    result = EXIT_FAILURE;
+  }
+  if (result == EXIT_FAILURE) {
+    (void)fprintf(stderr, "ERROR: Could not extract %s\n", psEntry->pName);
+  }
+
+  freeHuffmanMemory(NULL, pBuffer);
+  return result;
+}
@@ -0,0 +1,174 @@
+/**
+ * @file archive.h
+ * @brief Compress many files into one archive with several threads.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ * An archive is laid out as follows, with every integer stored
+ * little-endian:
+ *
+ *   header     "HUFA", uint8 version, uint8 flags, uint16 reserved
+ *   member*    a container or a batch
+ *   entry*     uint16 name size, name, uint64 uncompressed size,
+ *              uint32 index in batch, uint32 member count,
+ *              (uint64 member offset, uint64 member size)*
+ *   trailer    uint64 directory offset, uint32 entry count, "HUFZ"
+ *
+ * Files larger than the small file size are split into parts, each coded as
+ * its own container, so the parts of one large file are compressed in
+ * parallel. Smaller files are grouped into batches that share one code table,
+ * and each of their entries names the batch as its only member, with its
+ * index in the batch. Batched entries have an index below UINT32_MAX, and
+ * the others UINT32_MAX.
+ *
+ * The directory of entries at the end lets a file be extracted by reading
+ * only the trailer, the directory and the file's own members.
+ */
+
+#ifndef ARCHIVE_H
+#define ARCHIVE_H
+
+/* Standard Library Includes */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Constants */
+
+/**< The archive format version. */
+#define HUFFMAN_ARCHIVE_VERSION 1
+
+/**< The number of bytes in the archive header. */
+#define HUFFMAN_ARCHIVE_HEADER_SIZE 8
+
+/**< The number of bytes in the archive trailer. */
+#define HUFFMAN_ARCHIVE_TRAILER_SIZE 16
+
+/**< The default largest file that is batched with others. */
+#define HUFFMAN_ARCHIVE_DEFAULT_SMALL_FILE_SIZE ((size_t)64 * 1024)
+
+/**< The default number of uncompressed bytes in each batch. */
+#define HUFFMAN_ARCHIVE_DEFAULT_BATCH_SIZE ((size_t)1 << 20)
+
+/**< The default number of uncompressed bytes in each part of a large file. */
+#define HUFFMAN_ARCHIVE_DEFAULT_PART_SIZE ((size_t)4 << 20)
+
+/**< The longest name an entry can have. */
+#define HUFFMAN_ARCHIVE_MAX_NAME_SIZE ((size_t)UINT16_MAX)
+
+/* Type Definitions */
+
+/**
+ * @brief Options for creating an archive.
+ */
+typedef struct sHuffmanArchiveOptions {
+  size_t threadCount;   /**< Compressing threads, 0 for one per core. */
+  size_t smallFileSize; /**< The largest file that is batched. */
+  size_t batchSize;     /**< The uncompressed bytes in each batch. */
+  size_t partSize;      /**< The uncompressed bytes in each part. */
+} sHuffmanArchiveOptions_t;
+
+/**
+ * @brief An open archive and its directory.
+ */
+typedef struct sHuffmanArchive sHuffmanArchive_t;
+
+/* Function Prototypes */
+
+/**
+ * @brief Initialise archive options to the defaults.
+ *
+ * @param[out] o_psOptions The options to initialise.
+ */
+extern void initArchiveOptions(sHuffmanArchiveOptions_t* o_psOptions);
+
+/**
+ * @brief Compress files into an archive.
+ *
+ * Each path may be a file or a directory, whose regular files are added
+ * recursively in name order. Entries are named by the path they were found
+ * at. The files are compressed by a pool of threads and written in order,
+ * so the archive does not depend on the number of threads. The archive is
+ * removed if any file cannot be read or compressed.
+ *
+ * @param[in] i_apPaths The files and directories to add.
+ * @param[in] i_pathCount The number of paths.
+ * @param[in] i_pArchivePath The path to write the archive to.
+ * @param[in] i_psOptions The archive options, or NULL for the defaults.
+ * @return int EXIT_SUCCESS if the archive was written, else EXIT_FAILURE.
+ */
+extern int createArchive(const char* const* i_apPaths, size_t i_pathCount,
+                         const char* i_pArchivePath,
+                         const sHuffmanArchiveOptions_t* i_psOptions);
+
+/**
+ * @brief Open an archive and read its directory.
+ *
+ * @param[in] i_pArchivePath The path of the archive.
+ * @return sHuffmanArchive_t* The archive, else NULL.
+ */
+extern sHuffmanArchive_t* openArchive(const char* i_pArchivePath);
+
+/**
+ * @brief Close an archive.
+ *
+ * @param[inout] io_psArchive The archive, or NULL.
+ */
+extern void closeArchive(sHuffmanArchive_t* io_psArchive);
+
+/**
+ * @brief Find the number of files in an archive.
+ *
+ * @param[in] i_psArchive The archive.
+ * @return size_t The number of entries.
+ */
+extern size_t getArchiveEntryCount(const sHuffmanArchive_t* i_psArchive);
+
+/**
+ * @brief Find the name of a file in an archive.
+ *
+ * @param[in] i_psArchive The archive.
+ * @param[in] i_index The index of the entry.
+ * @return const char* The entry's name, owned by the archive.
+ */
+extern const char* getArchiveEntryName(const sHuffmanArchive_t* i_psArchive,
+                                       size_t i_index);
+
+/**
+ * @brief Find the uncompressed size of a file in an archive.
+ *
+ * @param[in] i_psArchive The archive.
+ * @param[in] i_index The index of the entry.
+ * @return uint64_t The entry's uncompressed size.
+ */
+extern uint64_t getArchiveEntrySize(const sHuffmanArchive_t* i_psArchive,
+                                    size_t i_index);
+
+/**
+ * @brief Find a file in an archive by name.
+ *
+ * @param[in] i_psArchive The archive.
+ * @param[in] i_pName The name to find.
+ * @param[out] o_pIndex The index of the first entry with the name.
+ * @return int EXIT_SUCCESS if the name was found, else EXIT_FAILURE.
+ */
+extern int findArchiveEntry(const sHuffmanArchive_t* i_psArchive,
+                            const char* i_pName, size_t* o_pIndex);
+
+/**
+ * @brief Extract one file from an archive.
+ *
+ * Only the entry's own members are read from the archive.
+ *
+ * @param[in] i_psArchive The archive.
+ * @param[in] i_index The index of the entry.
+ * @param[out] o_pOutput The buffer to write the file's bytes to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @return int EXIT_SUCCESS if the file was extracted, else EXIT_FAILURE.
+ */
+extern int extractArchiveEntry(const sHuffmanArchive_t* i_psArchive,
+                               size_t i_index, uint8_t* o_pOutput,
+                               size_t i_outputCapacity);
+
+#endif  // ARCHIVE_H
@@ -0,0 +1,253 @@
+/**
+ * @file bitStream.h
+ * @brief Least significant bit first bit writer and reader.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ * The writer and reader are defined inline as they sit in the innermost loop
+ * of the encoder and decoder. Bits are packed into bytes starting from the
+ * least significant bit, and multi-byte words are little-endian.
+ */
+
+#ifndef BIT_STREAM_H
+#define BIT_STREAM_H
+
+/* Standard Library Includes */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/* Type Definitions */
+
+/**
+ * @brief Bit writer over a caller-provided output buffer.
+ *
+ * The output buffer must be large enough for every bit written, rounded up to
+ * a whole byte.
+ */
+typedef struct sBitWriter {
+  uint8_t* pOutput;
+  size_t position;
+  uint64_t bitBuffer;
+  size_t bitCount;
+} sBitWriter_t;
+
+/**
+ * @brief Bit reader over a caller-provided input buffer.
+ *
+ * Reading past the end of the input yields zero bits, which the caller
+ * detects by comparing getBitReaderPosition with the input size.
+ */
+typedef struct sBitReader {
+  const uint8_t* pInput;
+  size_t size;
+  size_t position;
+  uint64_t bitBuffer;
+  size_t bitCount;
+} sBitReader_t;
+
+/* Function Definitions */
+
+/**
+ * @brief Load a little-endian 64-bit word from unaligned memory.
+ *
+ * @param[in] i_pSource The address of the first byte of the word.
+ * @return uint64_t The loaded word.
+ */
+static inline uint64_t loadLittleEndian64(const uint8_t* i_pSource) {
+  uint64_t word = 0;
+  (void)memcpy(&word, i_pSource, sizeof(word));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  word = __builtin_bswap64(word);
+#endif
+  return word;
+}
+
+/**
+ * @brief Load a little-endian 32-bit word from unaligned memory.
+ *
+ * @param[in] i_pSource The address of the first byte of the word.
+ * @return uint32_t The loaded word.
+ */
+static inline uint32_t loadLittleEndian32(const uint8_t* i_pSource) {
+  uint32_t word = 0;
+  (void)memcpy(&word, i_pSource, sizeof(word));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  word = __builtin_bswap32(word);
+#endif
+  return word;
+}
+
+/**
+ * @brief Store a little-endian 32-bit word to unaligned memory.
+ *
+ * @param[out] o_pDest The address of the first byte of the word.
+ * @param[in] i_word The word to store.
+ */
+static inline void storeLittleEndian32(uint8_t* o_pDest, uint32_t i_word) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  i_word = __builtin_bswap32(i_word);
+#endif
+  (void)memcpy(o_pDest, &i_word, sizeof(i_word));
+}
+
+/**
+ * @brief Store a little-endian 64-bit word to unaligned memory.
+ *
+ * @param[out] o_pDest The address of the first byte of the word.
+ * @param[in] i_word The word to store.
+ */
+static inline void storeLittleEndian64(uint8_t* o_pDest, uint64_t i_word) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  i_word = __builtin_bswap64(i_word);
+#endif
+  (void)memcpy(o_pDest, &i_word, sizeof(i_word));
+}
+
+/**
+ * @brief Initialise a bit writer.
+ *
+ * @param[out] o_psWriter The bit writer to initialise.
+ * @param[in] i_pOutput The buffer to write bits into.
+ */
+static inline void initBitWriter(sBitWriter_t* o_psWriter, uint8_t* i_pOutput) {
+  o_psWriter->pOutput = i_pOutput;
+  o_psWriter->position = 0;
+  o_psWriter->bitBuffer = 0;
+  o_psWriter->bitCount = 0;
+}
+
+/**
+ * @brief Write up to 32 bits, least significant bit first.
+ *
+ * @param[inout] io_psWriter The bit writer.
+ * @param[in] i_bits The bits to write, with no bits set above i_count.
+ * @param[in] i_count The number of bits to write.
+ */
+static inline void writeBits(sBitWriter_t* io_psWriter, uint32_t i_bits,
+                             size_t i_count) {
+  io_psWriter->bitBuffer |= (uint64_t)i_bits << io_psWriter->bitCount;
+  io_psWriter->bitCount += i_count;
+
+  if (io_psWriter->bitCount >= 32) {
+    storeLittleEndian32(&io_psWriter->pOutput[io_psWriter->position],
+                        (uint32_t)io_psWriter->bitBuffer);
+    io_psWriter->position += 4;
+    io_psWriter->bitBuffer >>= 32;
+    io_psWriter->bitCount -= 32;
+  }
+}
+
+/**
+ * @brief Write any buffered bits, padding the final byte with zeros.
+ *
+ * @param[inout] io_psWriter The bit writer.
+ * @return size_t The total number of bytes written.
+ */
+static inline size_t flushBitWriter(sBitWriter_t* io_psWriter) {
+  while (io_psWriter->bitCount > 0) {
+    io_psWriter->pOutput[io_psWriter->position++] =
+        (uint8_t)io_psWriter->bitBuffer;
+    io_psWriter->bitBuffer >>= 8;
+    io_psWriter->bitCount =
+        (io_psWriter->bitCount > 8) ? io_psWriter->bitCount - 8 : 0;
+  }
+
+  return io_psWriter->position;
+}
+
+/**
+ * @brief Initialise a bit reader.
+ *
+ * @param[out] o_psReader The bit reader to initialise.
+ * @param[in] i_pInput The buffer to read bits from.
+ * @param[in] i_size The number of bytes in the buffer.
+ */
+static inline void initBitReader(sBitReader_t* o_psReader,
+                                 const uint8_t* i_pInput, size_t i_size) {
+  o_psReader->pInput = i_pInput;
+  o_psReader->size = i_size;
+  o_psReader->position = 0;
+  o_psReader->bitBuffer = 0;
+  o_psReader->bitCount = 0;
+}
+
+/**
+ * @brief Refill the bit buffer so that it holds at least 56 bits.
+ *
+ * @param[inout] io_psReader The bit reader.
+ */
+static inline void refillBitReader(sBitReader_t* io_psReader) {
+  if (io_psReader->position + 8 <= io_psReader->size) {
+    /* Fast path, load a whole word and keep the bytes that fit. */
+    io_psReader->bitBuffer |=
+        loadLittleEndian64(&io_psReader->pInput[io_psReader->position])
+        << io_psReader->bitCount;
+    io_psReader->position += (63 - io_psReader->bitCount) >> 3;
+    io_psReader->bitCount |= 56;
+    return;
+  }
+
+  while (io_psReader->bitCount <= 56) {
+    /* Past the end of the input the reader supplies zero bytes. */
+    if (io_psReader->position < io_psReader->size) {
+      io_psReader->bitBuffer |=
+          (uint64_t)io_psReader->pInput[io_psReader->position]
+          << io_psReader->bitCount;
+    }
+    io_psReader->position++;
+    io_psReader->bitCount += 8;
+  }
+}
+
+/**
+ * @brief Look at the next bits without consuming them.
+ *
+ * @param[in] i_psReader The bit reader, holding at least i_count bits.
+ * @param[in] i_count The number of bits to look at, less than 64.
+ * @return uint64_t The next bits, least significant bit first.
+ */
+static inline uint64_t peekBits(const sBitReader_t* i_psReader,
+                                size_t i_count) {
+  return i_psReader->bitBuffer & (((uint64_t)1 << i_count) - 1);
+}
+
+/**
+ * @brief Consume bits that have been looked at.
+ *
+ * @param[inout] io_psReader The bit reader, holding at least i_count bits.
+ * @param[in] i_count The number of bits to consume.
+ */
+static inline void consumeBits(sBitReader_t* io_psReader, size_t i_count) {
+  io_psReader->bitBuffer >>= i_count;
+  io_psReader->bitCount -= i_count;
+}
+
+/**
+ * @brief Move a freshly initialised bit reader to a bit offset in its input.
+ *
+ * @param[inout] io_psReader The bit reader, which must not have been read.
+ * @param[in] i_bitOffset The offset of the next bit, at most the input size
+ * in bits.
+ */
+static inline void seekBitReader(sBitReader_t* io_psReader,
+                                 uint64_t i_bitOffset) {
+  io_psReader->position = (size_t)(i_bitOffset / 8);
+  refillBitReader(io_psReader);
+  consumeBits(io_psReader, (size_t)(i_bitOffset % 8));
+}
+
+/**
+ * @brief Find the number of whole or partial input bytes consumed so far.
+ *
+ * @param[in] i_psReader The bit reader.
+ * @return size_t The number of bytes consumed, which exceeds the input size
+ * if the reader ran past the end of the input.
+ */
+static inline size_t getBitReaderPosition(const sBitReader_t* i_psReader) {
+  return i_psReader->position - (i_psReader->bitCount / 8);
+}
+
+#endif  // BIT_STREAM_H
@@ -0,0 +1,497 @@
+/**
+ * @file checksum.c
+ * @brief CRC32C checksums of uncompressed data with runtime CPU dispatch.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+/* Standard Library Includes */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#endif
+
+/* Project Includes */
+
+#include "huffmanCoding/bitStream.h"
+#include "huffmanCoding/checksum.h"
+#include "huffmanCoding/huffmanTree.h"
+
+/* Constants */
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+/**< Whether the SSE4.2 kernel is built in. */
+#define HUFFMAN_HAS_SSE42_KERNEL
+#endif
+
+/**< The reflected CRC32C (Castagnoli) polynomial. */
+#define CRC32C_POLYNOMIAL 0x82F63B78U
+
+/**< The number of bytes in each of the SSE4.2 kernel's three lanes. */
+#define CRC_LANE_SIZE 1024
+
+/**< The name of each checksum kernel. */
+static const char* const KERNEL_NAMES[HUFFMAN_CHECKSUM_KERNEL_MAX] = {
+    "portable", "sse4.2"};
+
+/* Type Definitions */
+
+/**
+ * @brief A checksum kernel, updating an unfinalised CRC with more bytes.
+ */
+typedef uint32_t (*checksumKernelFunction_t)(uint32_t, const uint8_t*,
+                                             size_t);
+
+/**
+ * @brief A counting checksum kernel, with the signature of
+ * countByteFrequenciesWithCrc32c but taking an unfinalised CRC.
+ */
+typedef uint32_t (*countKernelFunction_t)(uint32_t, const uint8_t*, size_t,
+                                          size_t*);
+
+/* Function Prototypes */
+
+/**
+ * @brief Build the slicing-by-8 tables and the lane shift tables.
+ *
+ */
+static void createChecksumTables(void);
+
+/**
+ * @brief Multiply two polynomials modulo the CRC32C polynomial.
+ *
+ * @param[in] i_a The first polynomial, reflected.
+ * @param[in] i_b The second polynomial, reflected.
+ * @return uint32_t The product, reflected.
+ */
+static uint32_t multiplyModCrc32c(uint32_t i_a, uint32_t i_b);
+
+/**
+ * @brief Find x^(8n) modulo the CRC32C polynomial, which shifts a CRC past n
+ * zero bytes.
+ *
+ * @param[in] i_byteCount The number of bytes n.
+ * @return uint32_t The polynomial, reflected.
+ */
+static uint32_t getShiftOperator(size_t i_byteCount);
+
+/**
+ * @brief The portable checksum kernel.
+ *
+ * @param[in] i_crc The unfinalised CRC of the bytes so far.
+ * @param[in] i_pData The bytes to add.
+ * @param[in] i_size The number of bytes to add.
+ * @return uint32_t The unfinalised CRC including the bytes.
+ */
+static uint32_t updatePortable(uint32_t i_crc, const uint8_t* i_pData,
+                               size_t i_size);
+
+/**
+ * @brief The portable counting checksum kernel.
+ *
+ * @param[in] i_crc The unfinalised CRC of the bytes so far.
+ * @param[in] i_pData The bytes to count and add.
+ * @param[in] i_size The number of bytes to count and add.
+ * @param[inout] io_aFrequencies The zeroed frequency of each byte value.
+ * @return uint32_t The unfinalised CRC including the bytes.
+ */
+static uint32_t countPortable(uint32_t i_crc, const uint8_t* i_pData,
+                              size_t i_size, size_t* io_aFrequencies);
+
+#ifdef HUFFMAN_HAS_SSE42_KERNEL
+/**
+ * @brief The SSE4.2 checksum kernel.
+ *
+ * @param[in] i_crc The unfinalised CRC of the bytes so far.
+ * @param[in] i_pData The bytes to add.
+ * @param[in] i_size The number of bytes to add.
+ * @return uint32_t The unfinalised CRC including the bytes.
+ */
+__attribute__((target("sse4.2"))) static uint32_t updateSse42(
+    uint32_t i_crc, const uint8_t* i_pData, size_t i_size);
+
+/**
+ * @brief The SSE4.2 counting checksum kernel.
+ *
+ * @param[in] i_crc The unfinalised CRC of the bytes so far.
+ * @param[in] i_pData The bytes to count and add.
+ * @param[in] i_size The number of bytes to count and add.
+ * @param[inout] io_aFrequencies The zeroed frequency of each byte value.
+ * @return uint32_t The unfinalised CRC including the bytes.
+ */
+__attribute__((target("sse4.2"))) static uint32_t countSse42(
+    uint32_t i_crc, const uint8_t* i_pData, size_t i_size,
+    size_t* io_aFrequencies);
+#endif
+
+/* Global Variables */
+
+/**< Builds the tables once, before the first checksum. */
+static pthread_once_t g_tablesOnce = PTHREAD_ONCE_INIT;
+
+/**< The slicing-by-8 tables, where table k adds a byte followed by k zero
+ * bytes. */
+static uint32_t g_aaSliceTables[8][256];
+
+/**< The tables that shift a CRC past one and two lanes of zero bytes, each
+ * indexed by one byte of the CRC. */
+static uint32_t g_aaaLaneShiftTables[2][4][256];
+
+/**< The checksum kernel in use. */
+static eHuffmanChecksumKernel_t g_eChecksumKernel =
+    HUFFMAN_CHECKSUM_KERNEL_PORTABLE;
+
+/**< The function of the checksum kernel in use. */
+static checksumKernelFunction_t g_pfnChecksumKernel = updatePortable;
+
+/**< The counting function of the checksum kernel in use. */
+static countKernelFunction_t g_pfnCountKernel = countPortable;
+
+/* Function Definitions */
+
+/**
+ * @brief Build the slicing-by-8 tables and the lane shift tables.
+ *
+ */
+static void createChecksumTables(void) {
+  for (uint32_t byte = 0; byte < 256; byte++) {
+    uint32_t crc = byte;
+    for (size_t bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ ((crc & 1U) != 0 ? CRC32C_POLYNOMIAL : 0);
+    }
+    g_aaSliceTables[0][byte] = crc;
+  }
+  for (size_t table = 1; table < 8; table++) {
+    for (size_t byte = 0; byte < 256; byte++) {
+      const uint32_t previous = g_aaSliceTables[table - 1][byte];
+      g_aaSliceTables[table][byte] =
+          (previous >> 8) ^ g_aaSliceTables[0][previous & 0xFFU];
+    }
+  }
+
+  for (size_t lanes = 1; lanes <= 2; lanes++) {
+    const uint32_t shiftOperator = getShiftOperator(lanes * CRC_LANE_SIZE);
+    for (size_t k = 0; k < 4; k++) {
+      for (uint32_t byte = 0; byte < 256; byte++) {
+        g_aaaLaneShiftTables[lanes - 1][k][byte] =
+            multiplyModCrc32c(shiftOperator, byte << (8 * k));
+      }
+    }
+  }
+}
+
+/**
+ * @brief Multiply two polynomials modulo the CRC32C polynomial.
+ *
+ * @param[in] i_a The first polynomial, reflected.
+ * @param[in] i_b The second polynomial, reflected.
+ * @return uint32_t The product, reflected.
+ */
+static uint32_t multiplyModCrc32c(uint32_t i_a, uint32_t i_b) {
+  uint32_t product = 0;
+  uint32_t b = i_b;
+  for (uint32_t mask = 1U << 31; mask != 0; mask >>= 1) {
+    if ((i_a & mask) != 0) {
+      product ^= b;
+    }
+    b = (b >> 1) ^ ((b & 1U) != 0 ? CRC32C_POLYNOMIAL : 0);
+  }
+  return product;
+}
+
+/**
+ * @brief Find x^(8n) modulo the CRC32C polynomial, which shifts a CRC past n
+ * zero bytes.
+ *
+ * @param[in] i_byteCount The number of bytes n.
+ * @return uint32_t The polynomial, reflected.
+ */
+static uint32_t getShiftOperator(size_t i_byteCount) {
+  uint32_t result = 1U << 31;  /* x^0 */
+  uint32_t power = 1U << 23;   /* x^8 */
+  for (size_t n = i_byteCount; n != 0; n >>= 1) {
+    if ((n & 1U) != 0) {
+      result = multiplyModCrc32c(result, power);
+    }
+    power = multiplyModCrc32c(power, power);
+  }
+  return result;
+}
+
+/**
+ * @brief Add eight bytes to an unfinalised CRC with the slicing-by-8 tables.
+ *
+ * @param[in] i_crc The unfinalised CRC.
+ * @param[in] i_word The eight bytes, little-endian.
+ * @return uint32_t The unfinalised CRC including the bytes.
+ */
+static inline uint32_t sliceWord(uint32_t i_crc, uint64_t i_word) {
+  const uint64_t word = i_word ^ i_crc;
+  return g_aaSliceTables[7][word & 0xFFU] ^
+         g_aaSliceTables[6][(word >> 8) & 0xFFU] ^
+         g_aaSliceTables[5][(word >> 16) & 0xFFU] ^
+         g_aaSliceTables[4][(word >> 24) & 0xFFU] ^
+         g_aaSliceTables[3][(word >> 32) & 0xFFU] ^
+         g_aaSliceTables[2][(word >> 40) & 0xFFU] ^
+         g_aaSliceTables[1][(word >> 48) & 0xFFU] ^
+         g_aaSliceTables[0][word >> 56];
+}
+
+/**
+ * @brief Add a byte to an unfinalised CRC with the first slicing table.
+ *
+ * @param[in] i_crc The unfinalised CRC.
+ * @param[in] i_byte The byte.
+ * @return uint32_t The unfinalised CRC including the byte.
+ */
+static inline uint32_t sliceByte(uint32_t i_crc, uint8_t i_byte) {
+  return (i_crc >> 8) ^ g_aaSliceTables[0][(i_crc ^ i_byte) & 0xFFU];
+}
+
+/**
+ * @brief The portable checksum kernel.
+ *
+ * @param[in] i_crc The unfinalised CRC of the bytes so far.
+ * @param[in] i_pData The bytes to add.
+ * @param[in] i_size The number of bytes to add.
+ * @return uint32_t The unfinalised CRC including the bytes.
+ */
+static uint32_t updatePortable(uint32_t i_crc, const uint8_t* i_pData,
+                               size_t i_size) {
+  uint32_t crc = i_crc;
+  size_t i = 0;
+  for (; i + 8 <= i_size; i += 8) {
+    crc = sliceWord(crc, loadLittleEndian64(&i_pData[i]));
+  }
+  for (; i < i_size; i++) {
+    crc = sliceByte(crc, i_pData[i]);
+  }
+  return crc;
+}
+
+/**
+ * @brief The portable counting checksum kernel.
+ *
+ * @param[in] i_crc The unfinalised CRC of the bytes so far.
+ * @param[in] i_pData The bytes to count and add.
+ * @param[in] i_size The number of bytes to count and add.
+ * @param[inout] io_aFrequencies The zeroed frequency of each byte value.
+ * @return uint32_t The unfinalised CRC including the bytes.
+ */
+static uint32_t countPortable(uint32_t i_crc, const uint8_t* i_pData,
+                              size_t i_size, size_t* io_aFrequencies) {
+  uint32_t crc = i_crc;
+  size_t i = 0;
+  for (; i + 8 <= i_size; i += 8) {
+    const uint64_t word = loadLittleEndian64(&i_pData[i]);
+    crc = sliceWord(crc, word);
+    for (size_t k = 0; k < 64; k += 8) {
+      io_aFrequencies[(word >> k) & 0xFFU]++;
+    }
+  }
+  for (; i < i_size; i++) {
+    crc = sliceByte(crc, i_pData[i]);
+    io_aFrequencies[i_pData[i]]++;
+  }
+  return crc;
+}
+
+#ifdef HUFFMAN_HAS_SSE42_KERNEL
+/**
+ * @brief The SSE4.2 checksum kernel.
+ *
+ * The crc32 instruction has a latency of three cycles but a throughput of
+ * one, so three consecutive lanes are checksummed in independent chains.
+ * The first lane's CRC is then shifted past the other two, and the second's
+ * past the third, with the lane shift tables.
+ *
+ * @param[in] i_crc The unfinalised CRC of the bytes so far.
+ * @param[in] i_pData The bytes to add.
+ * @param[in] i_size The number of bytes to add.
+ * @return uint32_t The unfinalised CRC including the bytes.
+ */
+__attribute__((target("sse4.2"))) static uint32_t updateSse42(
+    uint32_t i_crc, const uint8_t* i_pData, size_t i_size) {
+  uint64_t crc = i_crc;
+  size_t i = 0;
+  for (; i + (3 * CRC_LANE_SIZE) <= i_size; i += 3 * CRC_LANE_SIZE) {
+    const uint8_t* pLane = &i_pData[i];
+    uint64_t crc1 = 0;
+    uint64_t crc2 = 0;
+    for (size_t j = 0; j < CRC_LANE_SIZE; j += 8) {
+      crc = _mm_crc32_u64(crc, loadLittleEndian64(&pLane[j]));
+      crc1 = _mm_crc32_u64(crc1,
+                           loadLittleEndian64(&pLane[CRC_LANE_SIZE + j]));
+      crc2 = _mm_crc32_u64(
+          crc2, loadLittleEndian64(&pLane[(2 * CRC_LANE_SIZE) + j]));
+    }
+
+    uint32_t shifted = (uint32_t)crc2;
+    for (size_t k = 0; k < 4; k++) {
+      shifted ^= g_aaaLaneShiftTables[1][k][(crc >> (8 * k)) & 0xFFU] ^
+                 g_aaaLaneShiftTables[0][k][(crc1 >> (8 * k)) & 0xFFU];
+    }
+    crc = shifted;
+  }
+  for (; i + 8 <= i_size; i += 8) {
+    crc = _mm_crc32_u64(crc, loadLittleEndian64(&i_pData[i]));
+  }
+  for (; i < i_size; i++) {
+    crc = _mm_crc32_u8((uint32_t)crc, i_pData[i]);
+  }
+  return (uint32_t)crc;
+}
+
+/**
+ * @brief The SSE4.2 counting checksum kernel.
+ *
+ * Counting is bound by the eight increments per word, so a single crc32
+ * chain keeps up with it.
+ *
+ * @param[in] i_crc The unfinalised CRC of the bytes so far.
+ * @param[in] i_pData The bytes to count and add.
+ * @param[in] i_size The number of bytes to count and add.
+ * @param[inout] io_aFrequencies The zeroed frequency of each byte value.
+ * @return uint32_t The unfinalised CRC including the bytes.
+ */
+__attribute__((target("sse4.2"))) static uint32_t countSse42(
+    uint32_t i_crc, const uint8_t* i_pData, size_t i_size,
+    size_t* io_aFrequencies) {
+  uint64_t crc = i_crc;
+  size_t i = 0;
+  for (; i + 8 <= i_size; i += 8) {
+    const uint64_t word = loadLittleEndian64(&i_pData[i]);
+    crc = _mm_crc32_u64(crc, word);
+    for (size_t k = 0; k < 64; k += 8) {
+      io_aFrequencies[(word >> k) & 0xFFU]++;
+    }
+  }
+  for (; i < i_size; i++) {
+    crc = _mm_crc32_u8((uint32_t)crc, i_pData[i]);
+    io_aFrequencies[i_pData[i]]++;
+  }
+  return (uint32_t)crc;
+}
+
+/**
+ * @brief Select the fastest supported checksum kernel at startup.
+ *
+ */
+__attribute__((constructor)) static void selectChecksumKernel(void) {
+  __builtin_cpu_init();
+  (void)setChecksumKernel(HUFFMAN_CHECKSUM_KERNEL_SSE42);
+}
+#endif
+
+/**
+ * @brief Find whether a checksum kernel can run on this CPU.
+ *
+ * @param[in] i_eKernel The checksum kernel.
+ * @return bool Whether the kernel is built in and supported by the CPU.
+ */
+bool isChecksumKernelSupported(eHuffmanChecksumKernel_t i_eKernel) {
+  switch (i_eKernel) {
+    case HUFFMAN_CHECKSUM_KERNEL_PORTABLE:
+      return true;
+#ifdef HUFFMAN_HAS_SSE42_KERNEL
+    case HUFFMAN_CHECKSUM_KERNEL_SSE42:
+      return __builtin_cpu_supports("sse4.2") != 0;
+#endif
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief Find the checksum kernel in use.
+ *
+ * @return eHuffmanChecksumKernel_t The checksum kernel.
+ */
+eHuffmanChecksumKernel_t getChecksumKernel(void) { return g_eChecksumKernel; }
+
+/**
+ * @brief Select the checksum kernel, e.g. to compare kernels.
+ *
+ * This function must not be called while other threads are computing
+ * checksums.
+ *
+ * @param[in] i_eKernel The checksum kernel.
+ * @return int EXIT_SUCCESS if the kernel was selected, else EXIT_FAILURE if
+ * it is not supported.
+ */
+int setChecksumKernel(eHuffmanChecksumKernel_t i_eKernel) {
+  if (!isChecksumKernelSupported(i_eKernel)) {
+    return EXIT_FAILURE;
+  }
+
+  g_eChecksumKernel = i_eKernel;
+#ifdef HUFFMAN_HAS_SSE42_KERNEL
+  if (i_eKernel == HUFFMAN_CHECKSUM_KERNEL_SSE42) {
+    g_pfnChecksumKernel = updateSse42;
+    g_pfnCountKernel = countSse42;
+    return EXIT_SUCCESS;
+  }
+#endif
+  g_pfnChecksumKernel = updatePortable;
+  g_pfnCountKernel = countPortable;
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Get the name of a checksum kernel.
+ *
+ * @param[in] i_eKernel The checksum kernel.
+ * @return const char* The name of the kernel.
+ */
+const char* getChecksumKernelName(eHuffmanChecksumKernel_t i_eKernel) {
+  if ((int)i_eKernel < 0 || i_eKernel >= HUFFMAN_CHECKSUM_KERNEL_MAX) {
+    return "unknown";
+  }
+  return KERNEL_NAMES[i_eKernel];
+}
+
+/**
+ * @brief Update a CRC32C checksum with more bytes.
+ *
+ * A checksum starts at 0, and updating it with two buffers in turn gives
+ * the checksum of their concatenation.
+ *
+ * @param[in] i_checksum The checksum of the bytes so far.
+ * @param[in] i_pData The bytes to add.
+ * @param[in] i_size The number of bytes to add.
+ * @return uint32_t The checksum including the bytes.
+ */
+uint32_t updateCrc32c(uint32_t i_checksum, const uint8_t* i_pData,
+                      size_t i_size) {
+  (void)pthread_once(&g_tablesOnce, createChecksumTables);
+  return ~g_pfnChecksumKernel(~i_checksum, i_pData, i_size);
+}
+
+/**
+ * @brief Count the frequency of every byte value in a buffer and find its
+ * CRC32C checksum in the same pass.
+ *
+ * Each eight-byte word is loaded once, added to the CRC and split into its
+ * bytes for counting.
+ *
+ * @param[in] i_pData The buffer to count the byte frequencies of.
+ * @param[in] i_size The number of bytes in the buffer.
+ * @param[out] o_aFrequencies The frequency of each byte value.
+ * @return uint32_t The checksum of the buffer.
+ */
+uint32_t countByteFrequenciesWithCrc32c(
+    const uint8_t* i_pData, size_t i_size,
+    size_t o_aFrequencies[HUFFMAN_ALPHABET_SIZE]) {
+  (void)pthread_once(&g_tablesOnce, createChecksumTables);
+  (void)memset(o_aFrequencies, 0, HUFFMAN_ALPHABET_SIZE * sizeof(size_t));
+  return ~g_pfnCountKernel(~0U, i_pData, i_size, o_aFrequencies);
+}
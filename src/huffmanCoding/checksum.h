@@ -0,0 +1,109 @@
+/**
+ * @file checksum.h
+ * @brief CRC32C checksums of uncompressed data with runtime CPU dispatch.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ * Blocks may carry the CRC32C (Castagnoli) checksum of their uncompressed
+ * bytes. The portable kernel is always available and processes eight bytes
+ * per step with slicing-by-8 tables. On x86-64 an SSE4.2 kernel, which runs
+ * three independent crc32 instruction chains and combines them, is selected
+ * once at startup when cpuid reports SSE4.2 support. Every kernel computes
+ * identical checksums.
+ *
+ * When compressing, the checksum is computed in the same pass over a block
+ * as its byte frequencies, so the block is only read once.
+ */
+
+#ifndef CHECKSUM_H
+#define CHECKSUM_H
+
+/* Standard Library Includes */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Project Includes */
+
+#include "huffmanCoding/huffmanTree.h"
+
+/* Type Definitions */
+
+/**
+ * @brief The checksum kernels.
+ */
+typedef enum eHuffmanChecksumKernel {
+  HUFFMAN_CHECKSUM_KERNEL_PORTABLE, /**< Plain C, for any CPU. */
+  HUFFMAN_CHECKSUM_KERNEL_SSE42,    /**< x86-64 with SSE4.2. */
+  HUFFMAN_CHECKSUM_KERNEL_MAX
+} eHuffmanChecksumKernel_t;
+
+/* Function Prototypes */
+
+/**
+ * @brief Find whether a checksum kernel can run on this CPU.
+ *
+ * @param[in] i_eKernel The checksum kernel.
+ * @return bool Whether the kernel is built in and supported by the CPU.
+ */
+extern bool isChecksumKernelSupported(eHuffmanChecksumKernel_t i_eKernel);
+
+/**
+ * @brief Find the checksum kernel in use.
+ *
+ * @return eHuffmanChecksumKernel_t The checksum kernel.
+ */
+extern eHuffmanChecksumKernel_t getChecksumKernel(void);
+
+/**
+ * @brief Select the checksum kernel, e.g. to compare kernels.
+ *
+ * This function must not be called while other threads are computing
+ * checksums.
+ *
+ * @param[in] i_eKernel The checksum kernel.
+ * @return int EXIT_SUCCESS if the kernel was selected, else EXIT_FAILURE if
+ * it is not supported.
+ */
+extern int setChecksumKernel(eHuffmanChecksumKernel_t i_eKernel);
+
+/**
+ * @brief Get the name of a checksum kernel.
+ *
+ * @param[in] i_eKernel The checksum kernel.
+ * @return const char* The name of the kernel.
+ */
+extern const char* getChecksumKernelName(eHuffmanChecksumKernel_t i_eKernel);
+
+/**
+ * @brief Update a CRC32C checksum with more bytes.
+ *
+ * A checksum starts at 0, and updating it with two buffers in turn gives
+ * the checksum of their concatenation.
+ *
+ * @param[in] i_checksum The checksum of the bytes so far.
+ * @param[in] i_pData The bytes to add.
+ * @param[in] i_size The number of bytes to add.
+ * @return uint32_t The checksum including the bytes.
+ */
+extern uint32_t updateCrc32c(uint32_t i_checksum, const uint8_t* i_pData,
+                             size_t i_size);
+
+/**
+ * @brief Count the frequency of every byte value in a buffer and find its
+ * CRC32C checksum in the same pass.
+ *
+ * The frequencies are the same as countByteFrequencies's.
+ *
+ * @param[in] i_pData The buffer to count the byte frequencies of.
+ * @param[in] i_size The number of bytes in the buffer.
+ * @param[out] o_aFrequencies The frequency of each byte value.
+ * @return uint32_t The checksum of the buffer.
+ */
+extern uint32_t countByteFrequenciesWithCrc32c(
+    const uint8_t* i_pData, size_t i_size,
+    size_t o_aFrequencies[HUFFMAN_ALPHABET_SIZE]);
+
+#endif  // CHECKSUM_H
@@ -0,0 +1,3013 @@
+/**
+ * @file codec.c
+ * @brief Compress and decompress buffers with block-wise Huffman coding.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+/* Standard Library Includes */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Project Includes */
+
+#include "huffmanCoding/allocator.h"
+#include "huffmanCoding/bitStream.h"
+#include "huffmanCoding/checksum.h"
+#include "huffmanCoding/codec.h"
+#include "huffmanCoding/decodeKernel.h"
+#include "huffmanCoding/encodeKernel.h"
+#include "huffmanCoding/huffmanTree.h"
+#include "huffmanCoding/parallelDecoder.h"
+#include "huffmanCoding/parallelEncoder.h"
+#include "huffmanCoding/sampling.h"
+#include "huffmanCoding/stats.h"
+#include "huffmanCoding/task4.h"
+#include "huffmanCoding/task5.h"
+
+/* Constants */
+
+/**< The magic bytes at the start of a container. */
+static const uint8_t HEADER_MAGIC[4] = {'H', 'U', 'F', 'F'};
+
+/**< The magic bytes at the end of a container. */
+static const uint8_t TRAILER_MAGIC[4] = {'H', 'U', 'F', 'X'};
+
+/**< The magic bytes at the start of a batch. */
+static const uint8_t BATCH_MAGIC[4] = {'H', 'U', 'F', 'B'};
+
+/**< The fraction, 1 / N, by which reusing the previous block's code lengths
+ * may grow a block's coded size. */
+#define CODE_LENGTH_REUSE_TOLERANCE 64
+
+/**< The number of bytes decoded between checksum updates, small enough to
+ * still be in the L1 cache. */
+#define CHECKSUM_CHUNK_SIZE ((size_t)12 * 1024)
+
+/**< The number of payload bytes searched for candidate matches at a time. */
+#define SEARCH_WINDOW_SIZE ((size_t)4096)
+
+/**< The number of symbols decoded at a time when checking candidates. */
+#define SEARCH_CHUNK_SIZE ((size_t)256)
+
+/**< The number of bytes of a search pattern's codes, after up to 7 bits of
+ * shift, plus the bytes a bit writer may store past them. */
+#define SEARCH_PATTERN_BITS_SIZE                                           \
+  ((((HUFFMAN_MAX_SEARCH_PATTERN_SIZE * HUFFMAN_MAX_CODE_LENGTH) + 14) / \
+    8) +                                                                   \
+   4)
+
+/* Type Definitions */
+
+/**
+ * @brief Scratch memory for compressing and decompressing blocks.
+ *
+ * Contexts returned by createHuffmanContext build code lengths in the tree
+ * workspace, so they never allocate once created. compressBuffer uses a
+ * context on the stack that builds trees from the linked lists with its
+ * allocator instead, unless the input is small enough that the allocations
+ * would cost more than the coding, in which case it uses the workspace too.
+ * Long codes are always decoded with the nibble tree, which is built in the
+ * context.
+ */
+struct sHuffmanContext {
+  const sHuffmanAllocator_t* psAllocator;
+  bool isAllocationFree; /**< Whether to build trees in the workspace. */
+  size_t threadCount;    /**< Threads decoding each block, 1 for one. */
+  size_t aFrequencies[HUFFMAN_ALPHABET_SIZE];
+  uint8_t aCodeLengths[HUFFMAN_ALPHABET_SIZE];
+  sHuffmanCodeTable_t sCodeTable;
+  sHuffmanTreeWorkspace_t sTreeWorkspace;
+  sHuffmanNibbleTree_t sNibbleTree; /**< Only built for long codes. */
+  decodeTableEntry_t aDecodeTable[HUFFMAN_DECODE_TABLE_SIZE];
+  size_t maxDecodeLength; /**< The maximum code length in the table. */
+  multiSymbolEntry_t aMultiSymbolTable[HUFFMAN_DECODE_TABLE_SIZE];
+  bool isMultiSymbolTableValid; /**< Whether the alphabet is tiny. */
+  bool isDecodeTableValid;
+  uint8_t aDecodeTableLengths[HUFFMAN_CODE_LENGTHS_SIZE]; /**< Packed. */
+};
+
+/**
+ * @brief The parts of a block, found from its header.
+ */
+typedef struct sBlockLayout {
+  size_t outputSize;  /**< The number of uncompressed bytes. */
+  size_t payloadSize; /**< The number of bytes in the payload. */
+  bool isStored;
+  const uint8_t* pCodeLengths; /**< Packed, or NULL if stored. */
+  const uint8_t* pSyncPoints;  /**< The sync points, or NULL if none. */
+  size_t syncPointCount;
+  const uint8_t* pPayload;
+  bool hasChecksum;
+  uint32_t checksum; /**< The CRC32C of the uncompressed bytes, if any. */
+  size_t blockSize;  /**< The number of bytes the block occupies. */
+} sBlockLayout_t;
+
+/**
+ * @brief The offsets found by a search.
+ */
+typedef struct sSearchResults {
+  size_t* aOffsets;
+  size_t maxOffsets;
+  size_t count;
+  size_t startOffset; /**< Hits before this offset are not recorded. */
+} sSearchResults_t;
+
+/**
+ * @brief A search pattern and its codes in one block, starting at each bit
+ * of a byte.
+ */
+typedef struct sSearchPattern {
+  const uint8_t* pBytes;
+  size_t size;
+  size_t bitCount; /**< The number of bits of codes, 0 if any is unused. */
+  uint8_t aCodeLengths[HUFFMAN_ALPHABET_SIZE];
+  uint8_t aaShiftedCodes[8][SEARCH_PATTERN_BITS_SIZE];
+} sSearchPattern_t;
+
+/**
+ * @brief The bytes before a block that a match ending in it may start at.
+ *
+ * After a block at least as long as them, they are left in that block and
+ * only decoded when the next block starts with the rest of the pattern.
+ */
+typedef struct sSearchCarry {
+  uint8_t aBytes[2 * (HUFFMAN_MAX_SEARCH_PATTERN_SIZE - 1)];
+  size_t size;
+  bool isDecoded;          /**< Whether the bytes are in aBytes. */
+  sBlockLayout_t sPrevious; /**< The block holding them, if not decoded. */
+} sSearchCarry_t;
+
+/* Function Prototypes */
+
+/**
+ * @brief Write a little-endian 32-bit integer.
+ *
+ * @param[out] o_pDest The buffer to write to.
+ * @param[in] i_value The value to write.
+ */
+static void writeUint32(uint8_t* o_pDest, uint32_t i_value);
+
+/**
+ * @brief Write a little-endian 64-bit integer.
+ *
+ * @param[out] o_pDest The buffer to write to.
+ * @param[in] i_value The value to write.
+ */
+static void writeUint64(uint8_t* o_pDest, uint64_t i_value);
+
+/**
+ * @brief Read a little-endian 32-bit integer.
+ *
+ * @param[in] i_pSource The buffer to read from.
+ * @return uint32_t The value read.
+ */
+static uint32_t readUint32(const uint8_t* i_pSource);
+
+/**
+ * @brief Read a little-endian 64-bit integer.
+ *
+ * @param[in] i_pSource The buffer to read from.
+ * @return uint64_t The value read.
+ */
+static uint64_t readUint64(const uint8_t* i_pSource);
+
+/**
+ * @brief Initialise a context on the stack for an input of a given size.
+ *
+ * @param[out] o_psContext The context to initialise.
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ * @param[in] i_inputSize The number of uncompressed bytes.
+ */
+static void initStackContext(sHuffmanContext_t* o_psContext,
+                             const sHuffmanAllocator_t* i_psAllocator,
+                             size_t i_inputSize);
+
+/**
+ * @brief Compress a single block.
+ *
+ * @param[inout] io_psContext The scratch memory for the block.
+ * @param[in] i_pInput The bytes of the block.
+ * @param[in] i_inputSize The number of bytes in the block.
+ * @param[out] o_pOutput The buffer to write the block to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @param[in] i_syncInterval The number of bytes between sync points, or 0
+ * for none.
+ * @param[in] i_threadCount The number of threads to code the block with.
+ * @param[in] i_isChecksumEnabled Whether to end the block with a checksum.
+ * @param[in] i_sampleInterval The number of runs in each window sampled for
+ * the frequencies of large blocks, or 0 or 1 to count every byte.
+ * @param[in] i_pPreviousCodeLengths The previous block's packed code lengths
+ * to reuse if they cost little more, or NULL.
+ * @param[out] o_pBlockSize The number of bytes written.
+ * @return int EXIT_SUCCESS if the block was compressed successfully, else
+ * EXIT_FAILURE.
+ */
+static int encodeBlock(sHuffmanContext_t* io_psContext,
+                       const uint8_t* i_pInput, size_t i_inputSize,
+                       uint8_t* o_pOutput, size_t i_outputCapacity,
+                       size_t i_syncInterval, size_t i_threadCount,
+                       bool i_isChecksumEnabled, size_t i_sampleInterval,
+                       const uint8_t* i_pPreviousCodeLengths,
+                       size_t* o_pBlockSize);
+
+/**
+ * @brief Build the code lengths and canonical code table of a context from
+ * its frequencies.
+ *
+ * @param[inout] io_psContext The context holding the frequencies.
+ * @return int EXIT_SUCCESS if the code table was built successfully, else
+ * EXIT_FAILURE.
+ */
+static int buildCodeTable(sHuffmanContext_t* io_psContext);
+
+/**
+ * @brief Replace the code lengths of a context with the previous block's, if
+ * they code its frequencies almost as well.
+ *
+ * @param[inout] io_psContext The context holding the frequencies and lengths.
+ * @param[in] i_pCodeLengths The previous block's packed code lengths.
+ */
+static void reuseCodeLengths(sHuffmanContext_t* io_psContext,
+                             const uint8_t* i_pCodeLengths);
+
+/**
+ * @brief Find the number of bits needed to code the frequencies of a context
+ * with its code lengths.
+ *
+ * @param[in] i_psContext The context holding the frequencies and lengths.
+ * @return uint64_t The number of coded bits.
+ */
+static uint64_t getCodedBits(const sHuffmanContext_t* i_psContext);
+
+/**
+ * @brief Pack two 4-bit code lengths into each byte.
+ *
+ * @param[in] i_aCodeLengths The code length of each symbol.
+ * @param[out] o_pOutput The HUFFMAN_CODE_LENGTHS_SIZE bytes to write to.
+ */
+static void packCodeLengths(const uint8_t i_aCodeLengths[HUFFMAN_ALPHABET_SIZE],
+                            uint8_t* o_pOutput);
+
+/**
+ * @brief Code bytes with a canonical code table.
+ *
+ * @param[in] i_psCodeTable The canonical code table.
+ * @param[in] i_pInput The bytes to code.
+ * @param[in] i_inputSize The number of bytes to code.
+ * @param[in] i_syncInterval The number of bytes between sync points, or 0
+ * for none.
+ * @param[out] o_pSyncPoints The buffer to write the sync points to, or NULL
+ * if there are none.
+ * @param[in] i_threadCount The number of threads to code with.
+ * @param[in] i_outputCapacity The most bytes the codes may take, or SIZE_MAX
+ * if they are known to fit.
+ * @param[out] o_pOutput The buffer to write the codes to.
+ * @param[out] o_pOutputSize The number of bytes written.
+ * @return int EXIT_SUCCESS if the bytes were coded, else EXIT_FAILURE if the
+ * codes would not fit.
+ */
+static int encodePayload(const sHuffmanCodeTable_t* i_psCodeTable,
+                         const uint8_t* i_pInput, size_t i_inputSize,
+                         size_t i_syncInterval, uint8_t* o_pSyncPoints,
+                         size_t i_threadCount, size_t i_outputCapacity,
+                         uint8_t* o_pOutput, size_t* o_pOutputSize);
+
+/**
+ * @brief Find the number of sync points in a coded block.
+ *
+ * @param[in] i_inputSize The number of uncompressed bytes in the block.
+ * @param[in] i_syncInterval The number of bytes between sync points, or 0
+ * for none.
+ * @return size_t The number of sync points.
+ */
+static size_t getSyncPointCount(size_t i_inputSize, size_t i_syncInterval);
+
+/**
+ * @brief Find the parts of a block from its header.
+ *
+ * @param[in] i_pInput The block, starting at its header.
+ * @param[in] i_inputSize The number of bytes available in the input.
+ * @param[out] o_psLayout The parts of the block.
+ * @return int EXIT_SUCCESS if the block fits in the input, else EXIT_FAILURE.
+ */
+static int readBlockLayout(const uint8_t* i_pInput, size_t i_inputSize,
+                           sBlockLayout_t* o_psLayout);
+
+/**
+ * @brief Record where the payload of a block starts, and read the checksum
+ * after it.
+ *
+ * @param[in] i_pInput The block, starting at its header.
+ * @param[in] i_pPayload The payload, which with any checksum fits in the
+ * input.
+ * @param[inout] io_psLayout The parts of the block, with the payload size.
+ */
+static void setBlockPayload(const uint8_t* i_pInput,
+                            const uint8_t* i_pPayload,
+                            sBlockLayout_t* io_psLayout);
+
+/**
+ * @brief Decompress a single block.
+ *
+ * @param[inout] io_psContext The scratch memory for the block.
+ * @param[in] i_pInput The block, starting at its header.
+ * @param[in] i_inputSize The number of bytes available in the input.
+ * @param[out] o_pOutput The buffer to write the uncompressed bytes to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @param[out] o_pBlockSize The number of input bytes the block occupies.
+ * @param[out] o_pOutputSize The number of bytes written to the output.
+ * @return int EXIT_SUCCESS if the block was decompressed successfully, else
+ * EXIT_FAILURE.
+ */
+static int decodeBlock(sHuffmanContext_t* io_psContext,
+                       const uint8_t* i_pInput, size_t i_inputSize,
+                       uint8_t* o_pOutput, size_t i_outputCapacity,
+                       size_t* o_pBlockSize, size_t* o_pOutputSize);
+
+/**
+ * @brief Load the decoding tables of a context from packed code lengths.
+ *
+ * @param[inout] io_psContext The context to load the tables into.
+ * @param[in] i_pCodeLengths The HUFFMAN_CODE_LENGTHS_SIZE packed code lengths.
+ * @return int EXIT_SUCCESS if the tables were loaded successfully, else
+ * EXIT_FAILURE.
+ */
+static int loadDecodeTables(sHuffmanContext_t* io_psContext,
+                            const uint8_t* i_pCodeLengths);
+
+/**
+ * @brief Decode a coded payload with the tables loaded in a context.
+ *
+ * @param[in] i_psContext The context holding the decoding tables.
+ * @param[in] i_pPayload The coded payload.
+ * @param[in] i_payloadSize The number of bytes in the payload.
+ * @param[out] o_pOutput The buffer to write the decoded bytes to.
+ * @param[in] i_outputSize The number of bytes to decode.
+ * @param[out] o_pChecksum The checksum of the decoded bytes, or NULL to not
+ * find it.
+ * @return int EXIT_SUCCESS if the payload was decoded successfully, else
+ * EXIT_FAILURE.
+ */
+static int decodePayload(const sHuffmanContext_t* i_psContext,
+                         const uint8_t* i_pPayload, size_t i_payloadSize,
+                         uint8_t* o_pOutput, size_t i_outputSize,
+                         uint32_t* o_pChecksum);
+
+/**
+ * @brief Decode symbols from a bit reader with the tables loaded in a
+ * context.
+ *
+ * @param[in] i_psContext The context holding the decoding tables.
+ * @param[inout] io_psReader The bit reader positioned at the first code.
+ * @param[out] o_pOutput The buffer to write the decoded bytes to.
+ * @param[in] i_outputSize The number of bytes to decode.
+ * @return int EXIT_SUCCESS if the symbols were decoded successfully, else
+ * EXIT_FAILURE.
+ */
+static int decodeSymbols(const sHuffmanContext_t* i_psContext,
+                         sBitReader_t* io_psReader, uint8_t* o_pOutput,
+                         size_t i_outputSize);
+
+/**
+ * @brief Decompress part of a single block, starting from the nearest sync
+ * point.
+ *
+ * @param[inout] io_psContext The scratch memory for the block.
+ * @param[in] i_psLayout The parts of the block.
+ * @param[in] i_offset The offset of the first byte to decode in the block.
+ * @param[in] i_length The number of bytes to decode.
+ * @param[out] o_pOutput The buffer to write the i_length bytes to.
+ * @return int EXIT_SUCCESS if the range was decompressed successfully, else
+ * EXIT_FAILURE.
+ */
+static int decodeBlockRange(sHuffmanContext_t* io_psContext,
+                            const sBlockLayout_t* i_psLayout, size_t i_offset,
+                            size_t i_length, uint8_t* o_pOutput);
+
+/**
+ * @brief Record a search hit, unless it is before the start offset.
+ *
+ * @param[inout] io_psResults The search results.
+ * @param[in] i_offset The uncompressed offset of the hit.
+ * @return bool Whether the results are now full.
+ */
+static bool addSearchHit(sSearchResults_t* io_psResults, size_t i_offset);
+
+/**
+ * @brief Find a pattern in uncompressed bytes.
+ *
+ * @param[in] i_pData The bytes to search.
+ * @param[in] i_size The number of bytes to search.
+ * @param[in] i_dataOffset The uncompressed offset of the first byte.
+ * @param[in] i_psPattern The pattern.
+ * @param[inout] io_psResults The search results.
+ * @return bool Whether the results are now full.
+ */
+static bool searchBytes(const uint8_t* i_pData, size_t i_size,
+                        size_t i_dataOffset,
+                        const sSearchPattern_t* i_psPattern,
+                        sSearchResults_t* io_psResults);
+
+/**
+ * @brief Write a search pattern's codes in a block, shifted by each number
+ * of bits from 0 to 7.
+ *
+ * @param[in] i_pCodeLengths The block's packed code lengths.
+ * @param[inout] io_psPattern The pattern to write the codes of.
+ * @return int EXIT_SUCCESS if the code lengths are valid, else EXIT_FAILURE.
+ */
+static int loadSearchPattern(const uint8_t* i_pCodeLengths,
+                             sSearchPattern_t* io_psPattern);
+
+/**
+ * @brief Mark the bits of a window of a payload where the pattern's codes
+ * start.
+ *
+ * @param[in] i_psPattern The pattern, loaded for the block.
+ * @param[in] i_psLayout The parts of the block.
+ * @param[in] i_windowStart The offset of the window in the payload.
+ * @param[in] i_windowEnd The offset of the end of the window.
+ * @param[out] o_aCandidates A bit for each bit of the window.
+ * @return bool Whether any bit was marked.
+ */
+static bool findSearchCandidates(const sSearchPattern_t* i_psPattern,
+                                 const sBlockLayout_t* i_psLayout,
+                                 size_t i_windowStart, size_t i_windowEnd,
+                                 uint64_t* o_aCandidates);
+
+/**
+ * @brief Find a pattern in a coded block.
+ *
+ * @param[inout] io_psContext The scratch memory for the block.
+ * @param[in] i_psLayout The parts of the block.
+ * @param[in] i_blockStart The uncompressed offset of the block.
+ * @param[inout] io_psPattern The pattern.
+ * @param[inout] io_psResults The search results.
+ * @return int EXIT_SUCCESS if the block was searched successfully, else
+ * EXIT_FAILURE.
+ */
+static int searchCodedBlock(sHuffmanContext_t* io_psContext,
+                            const sBlockLayout_t* i_psLayout,
+                            size_t i_blockStart, sSearchPattern_t* io_psPattern,
+                            sSearchResults_t* io_psResults);
+
+/**
+ * @brief Find the matches that start before a block and end in it, and keep
+ * the bytes before the next block.
+ *
+ * @param[inout] io_psContext The scratch memory for the blocks.
+ * @param[in] i_psLayout The parts of the block.
+ * @param[in] i_blockStart The uncompressed offset of the block.
+ * @param[in] i_psPattern The pattern.
+ * @param[inout] io_psCarry The bytes before the block.
+ * @param[inout] io_psResults The search results.
+ * @return int EXIT_SUCCESS if the blocks were searched successfully, else
+ * EXIT_FAILURE.
+ */
+static int searchBlockBoundary(sHuffmanContext_t* io_psContext,
+                               const sBlockLayout_t* i_psLayout,
+                               size_t i_blockStart,
+                               const sSearchPattern_t* i_psPattern,
+                               sSearchCarry_t* io_psCarry,
+                               sSearchResults_t* io_psResults);
+
+/**
+ * @brief Find the offset of the block index from the trailer.
+ *
+ * @param[in] i_pInput The container.
+ * @param[in] i_inputSize The number of bytes in the container.
+ * @param[out] o_pIndexOffset The offset of the block index.
+ * @param[out] o_pBlockCount The number of blocks in the container.
+ * @return int EXIT_SUCCESS if the trailer is valid, else EXIT_FAILURE.
+ */
+static int readTrailer(const uint8_t* i_pInput, size_t i_inputSize,
+                       size_t* o_pIndexOffset, size_t* o_pBlockCount);
+
+/**
+ * @brief Find the block size to compress with, or 0 if the options are
+ * invalid.
+ *
+ * @param[in] i_psOptions The compression options, or NULL for the defaults.
+ * @return size_t The block size, else 0.
+ */
+static size_t getValidBlockSize(const sHuffmanCompressOptions_t* i_psOptions);
+
+/**
+ * @brief Write blocks, the end marker, the block index and the trailer.
+ *
+ * Blocks are written from an offset in the container, and the index lists
+ * the given offsets of any blocks before them followed by the new blocks.
+ *
+ * @param[inout] io_psContext The scratch memory for each block.
+ * @param[in] i_pInput The bytes to compress.
+ * @param[in] i_inputSize The number of bytes to compress.
+ * @param[inout] io_pContainer The container to write the blocks to.
+ * @param[in] i_containerCapacity The number of bytes available in the
+ * container.
+ * @param[in] i_blocksOffset The offset to write the first block at.
+ * @param[in] i_pIndex The block index entries of any earlier blocks.
+ * @param[in] i_indexCount The number of earlier blocks.
+ * @param[in] i_previousSize The uncompressed size of the earlier blocks.
+ * @param[in] i_pPreviousCodeLengths The last earlier block's packed code
+ * lengths, or NULL.
+ * @param[in] i_isCodeLengthReuse Whether each block may reuse the code
+ * lengths of the block before it.
+ * @param[in] i_blockSize The number of uncompressed bytes in each block.
+ * @param[in] i_syncInterval The number of bytes between sync points, or 0
+ * for none.
+ * @param[in] i_threadCount The number of threads to code each block with.
+ * @param[in] i_isChecksumEnabled Whether to end each block with a checksum.
+ * @param[in] i_sampleInterval The number of runs in each window sampled for
+ * the frequencies of large blocks, or 0 or 1 to count every byte.
+ * @param[out] o_pContainerSize The size of the container.
+ * @return int EXIT_SUCCESS if the blocks were written successfully, else
+ * EXIT_FAILURE.
+ */
+static int writeBlocks(sHuffmanContext_t* io_psContext,
+                       const uint8_t* i_pInput, size_t i_inputSize,
+                       uint8_t* io_pContainer, size_t i_containerCapacity,
+                       size_t i_blocksOffset, const uint8_t* i_pIndex,
+                       size_t i_indexCount, uint64_t i_previousSize,
+                       const uint8_t* i_pPreviousCodeLengths,
+                       bool i_isCodeLengthReuse, size_t i_blockSize,
+                       size_t i_syncInterval, size_t i_threadCount,
+                       bool i_isChecksumEnabled, size_t i_sampleInterval,
+                       size_t* o_pContainerSize);
+
+/**
+ * @brief Compress a buffer into a Huffman container using a context.
+ *
+ * @param[inout] io_psContext The scratch memory for each block.
+ * @param[in] i_pInput The bytes to compress.
+ * @param[in] i_inputSize The number of bytes to compress.
+ * @param[out] o_pOutput The buffer to write the container to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @param[out] o_pOutputSize The number of bytes written to the output.
+ * @param[in] i_blockSize The number of uncompressed bytes in each block.
+ * @param[in] i_syncInterval The number of bytes between sync points, or 0
+ * for none.
+ * @param[in] i_threadCount The number of threads to code each block with.
+ * @param[in] i_isChecksumEnabled Whether to end each block with a checksum.
+ * @param[in] i_sampleInterval The number of runs in each window sampled for
+ * the frequencies of large blocks, or 0 or 1 to count every byte.
+ * @return int EXIT_SUCCESS if the input was compressed successfully, else
+ * EXIT_FAILURE.
+ */
+static int compressBlocks(sHuffmanContext_t* io_psContext,
+                          const uint8_t* i_pInput, size_t i_inputSize,
+                          uint8_t* o_pOutput, size_t i_outputCapacity,
+                          size_t* o_pOutputSize, size_t i_blockSize,
+                          size_t i_syncInterval, size_t i_threadCount,
+                          bool i_isChecksumEnabled, size_t i_sampleInterval);
+
+/**
+ * @brief Decompress a Huffman container into a buffer using a context.
+ *
+ * @param[inout] io_psContext The scratch memory for each block.
+ * @param[in] i_pInput The container.
+ * @param[in] i_inputSize The number of bytes in the container.
+ * @param[out] o_pOutput The buffer to write the uncompressed bytes to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @param[out] o_pOutputSize The number of bytes written to the output.
+ * @return int EXIT_SUCCESS if the container was decompressed successfully,
+ * else EXIT_FAILURE.
+ */
+static int decompressBlocks(sHuffmanContext_t* io_psContext,
+                            const uint8_t* i_pInput, size_t i_inputSize,
+                            uint8_t* o_pOutput, size_t i_outputCapacity,
+                            size_t* o_pOutputSize);
+
+/**
+ * @brief Validate a batch header and its entries.
+ *
+ * @param[in] i_pInput The batch.
+ * @param[in] i_inputSize The number of bytes in the batch.
+ * @param[out] o_pBufferCount The number of buffers in the batch.
+ * @param[out] o_pEntriesOffset The offset of the first entry.
+ * @param[out] o_pDecompressedSize The total uncompressed size.
+ * @return int EXIT_SUCCESS if the batch is valid, else EXIT_FAILURE.
+ */
+static int readBatchHeader(const uint8_t* i_pInput, size_t i_inputSize,
+                           size_t* o_pBufferCount, size_t* o_pEntriesOffset,
+                           size_t* o_pDecompressedSize);
+
+/* Function Definitions */
+
+/**
+ * @brief Write a little-endian 32-bit integer.
+ *
+ * @param[out] o_pDest The buffer to write to.
+ * @param[in] i_value The value to write.
+ */
+static void writeUint32(uint8_t* o_pDest, uint32_t i_value) {
+  for (size_t i = 0; i < sizeof(i_value); i++) {
+    o_pDest[i] = (uint8_t)(i_value >> (8 * i));
+  }
+}
+
+/**
+ * @brief Write a little-endian 64-bit integer.
+ *
+ * @param[out] o_pDest The buffer to write to.
+ * @param[in] i_value The value to write.
+ */
+static void writeUint64(uint8_t* o_pDest, uint64_t i_value) {
+  for (size_t i = 0; i < sizeof(i_value); i++) {
+    o_pDest[i] = (uint8_t)(i_value >> (8 * i));
+  }
+}
+
+/**
+ * @brief Read a little-endian 32-bit integer.
+ *
+ * @param[in] i_pSource The buffer to read from.
+ * @return uint32_t The value read.
+ */
+static uint32_t readUint32(const uint8_t* i_pSource) {
+  uint32_t value = 0;
+  for (size_t i = 0; i < sizeof(value); i++) {
+    value |= (uint32_t)i_pSource[i] << (8 * i);
+  }
+  return value;
+}
+
+/**
+ * @brief Read a little-endian 64-bit integer.
+ *
+ * @param[in] i_pSource The buffer to read from.
+ * @return uint64_t The value read.
+ */
+static uint64_t readUint64(const uint8_t* i_pSource) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < sizeof(value); i++) {
+    value |= (uint64_t)i_pSource[i] << (8 * i);
+  }
+  return value;
+}
+
+/**
+ * @brief Initialise a context on the stack for an input of a given size.
+ *
+ * Inputs of at most HUFFMAN_SMALL_INPUT_SIZE bytes build trees in the
+ * workspace, so compressing them does not allocate. Larger inputs build trees
+ * from the linked lists with the allocator. Decompressing never allocates.
+ *
+ * @param[out] o_psContext The context to initialise.
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ * @param[in] i_inputSize The number of uncompressed bytes.
+ */
+static void initStackContext(sHuffmanContext_t* o_psContext,
+                             const sHuffmanAllocator_t* i_psAllocator,
+                             size_t i_inputSize) {
+  o_psContext->psAllocator = i_psAllocator;
+  o_psContext->isAllocationFree = (i_inputSize <= HUFFMAN_SMALL_INPUT_SIZE);
+  o_psContext->threadCount = 1;
+  o_psContext->isDecodeTableValid = false;
+}
+
+/**
+ * @brief Compress a single block.
+ *
+ * This function counts the byte frequencies of the block, builds a canonical
+ * code table from them and, if coding makes the block smaller, writes the
+ * packed code lengths followed by the coded payload. Otherwise the block is
+ * stored as-is. Either way, the block may end with the checksum of its
+ * bytes, found in the same pass as their frequencies.
+ *
+ * The frequencies of large blocks may instead be sampled. The coded size is
+ * then only an estimate, so the block is coded before its header is written
+ * and is stored if its codes turn out not to make it smaller.
+ *
+ * @param[inout] io_psContext The scratch memory for the block.
+ * @param[in] i_pInput The bytes of the block.
+ * @param[in] i_inputSize The number of bytes in the block.
+ * @param[out] o_pOutput The buffer to write the block to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @param[in] i_syncInterval The number of bytes between sync points, or 0
+ * for none.
+ * @param[in] i_threadCount The number of threads to code the block with.
+ * @param[in] i_isChecksumEnabled Whether to end the block with a checksum.
+ * @param[in] i_sampleInterval The number of runs in each window sampled for
+ * the frequencies of large blocks, or 0 or 1 to count every byte.
+ * @param[in] i_pPreviousCodeLengths The previous block's packed code lengths
+ * to reuse if they cost little more, or NULL.
+ * @param[out] o_pBlockSize The number of bytes written.
+ * @return int EXIT_SUCCESS if the block was compressed successfully, else
+ * EXIT_FAILURE.
+ */
+static int encodeBlock(sHuffmanContext_t* io_psContext,
+                       const uint8_t* i_pInput, size_t i_inputSize,
+                       uint8_t* o_pOutput, size_t i_outputCapacity,
+                       size_t i_syncInterval, size_t i_threadCount,
+                       bool i_isChecksumEnabled, size_t i_sampleInterval,
+                       const uint8_t* i_pPreviousCodeLengths,
+                       size_t* o_pBlockSize) {
+  /* The checksum is found in the same pass as the frequencies. Sampling
+   * would not save that pass, or the parallel encoder's own counting. */
+  HUFFMAN_STATS_BEGIN_STAGE(HUFFMAN_STAGE_HISTOGRAM);
+  uint32_t checksum = 0;
+  bool isSampled = false;
+  if (i_isChecksumEnabled) {
+    checksum = countByteFrequenciesWithCrc32c(i_pInput, i_inputSize,
+                                              io_psContext->aFrequencies);
+  } else if (i_threadCount <= 1 &&
+             isBlockSampled(i_inputSize, i_sampleInterval)) {
+    /* Tiny alphabets are counted exactly, keeping their fast kernels. */
+    isSampled = sampleByteFrequencies(i_pInput, i_inputSize, i_sampleInterval,
+                                      io_psContext->aFrequencies) >
+                HUFFMAN_TINY_ALPHABET_SIZE;
+    if (!isSampled) {
+      countByteFrequencies(i_pInput, i_inputSize, io_psContext->aFrequencies);
+    }
+  } else {
+    countByteFrequencies(i_pInput, i_inputSize, io_psContext->aFrequencies);
+  }
+  HUFFMAN_STATS_END_STAGE(HUFFMAN_STAGE_HISTOGRAM, i_inputSize);
+
+  if (buildCodeTable(io_psContext) == EXIT_FAILURE) {
+    return EXIT_FAILURE;
+  }
+  if (i_pPreviousCodeLengths != NULL) {
+    reuseCodeLengths(io_psContext, i_pPreviousCodeLengths);
+  }
+
+  /* The coded size is known exactly before writing anything, unless the
+   * frequencies were sampled. */
+  size_t codedSize = (size_t)((getCodedBits(io_psContext) + 7) / 8);
+  const size_t syncPointCount = getSyncPointCount(i_inputSize, i_syncInterval);
+  const size_t syncTableSize =
+      (syncPointCount > 0) ? 4 + (syncPointCount * HUFFMAN_SYNC_POINT_SIZE)
+                           : 0;
+  const size_t headersSize = HUFFMAN_CODE_LENGTHS_SIZE + syncTableSize;
+  const size_t checksumSize = i_isChecksumEnabled ? HUFFMAN_CHECKSUM_SIZE : 0;
+  bool isStored = (headersSize + codedSize >= i_inputSize);
+  uint8_t* pBody = &o_pOutput[HUFFMAN_BLOCK_HEADER_SIZE];
+  uint8_t* pSyncPoints = (syncPointCount > 0)
+                             ? &pBody[HUFFMAN_CODE_LENGTHS_SIZE + 4]
+                             : NULL;
+
+  if (isSampled && !isStored) {
+    /* Code first, and store the block if the codes outgrow it. */
+    const size_t bodyOffset =
+        HUFFMAN_BLOCK_HEADER_SIZE + headersSize + checksumSize;
+    size_t payloadCapacity = i_inputSize - headersSize - 1;
+    if (i_outputCapacity < bodyOffset) {
+      payloadCapacity = 0;
+    } else if (i_outputCapacity - bodyOffset < payloadCapacity) {
+      payloadCapacity = i_outputCapacity - bodyOffset;
+    }
+    isStored = (encodePayload(&io_psContext->sCodeTable, i_pInput,
+                              i_inputSize, i_syncInterval, pSyncPoints,
+                              i_threadCount, payloadCapacity,
+                              &pBody[headersSize],
+                              &codedSize) == EXIT_FAILURE);
+  }
+  if (isSampled) {
+    HUFFMAN_STATS_ADD(blocksSampled, 1);
+  }
+
+  const size_t blockSize =
+      HUFFMAN_BLOCK_HEADER_SIZE +
+      (isStored ? i_inputSize : headersSize + codedSize) + checksumSize;
+  if (blockSize > i_outputCapacity) {
+    (void)fprintf(stderr, "ERROR: Output buffer is too small\n");
+    return EXIT_FAILURE;
+  }
+
+  writeUint32(&o_pOutput[0], (uint32_t)i_inputSize);
+  writeUint32(&o_pOutput[4], (uint32_t)(isStored ? i_inputSize : codedSize));
+  o_pOutput[8] = isStored               ? HUFFMAN_BLOCK_FLAG_STORED
+                 : (syncPointCount > 0) ? HUFFMAN_BLOCK_FLAG_SYNC_POINTS
+                                        : 0;
+  if (i_isChecksumEnabled) {
+    o_pOutput[8] |= HUFFMAN_BLOCK_FLAG_CHECKSUM;
+    writeUint32(&o_pOutput[blockSize - HUFFMAN_CHECKSUM_SIZE], checksum);
+  }
+  HUFFMAN_STATS_ADD(blocksEncoded, 1);
+
+  if (isStored) {
+    (void)memcpy(pBody, i_pInput, i_inputSize);
+    HUFFMAN_STATS_ADD(blocksStored, 1);
+    *o_pBlockSize = blockSize;
+    return EXIT_SUCCESS;
+  }
+
+  packCodeLengths(io_psContext->aCodeLengths, pBody);
+  HUFFMAN_STATS_CODE_LENGTHS(io_psContext->aCodeLengths);
+  if (syncPointCount > 0) {
+    writeUint32(&pBody[HUFFMAN_CODE_LENGTHS_SIZE], (uint32_t)syncPointCount);
+  }
+  if (!isSampled) {
+    (void)encodePayload(&io_psContext->sCodeTable, i_pInput, i_inputSize,
+                        i_syncInterval, pSyncPoints, i_threadCount, SIZE_MAX,
+                        &pBody[headersSize], &codedSize);
+  }
+
+  *o_pBlockSize = blockSize;
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Build the code lengths and canonical code table of a context from
+ * its frequencies.
+ *
+ * @param[inout] io_psContext The context holding the frequencies.
+ * @return int EXIT_SUCCESS if the code table was built successfully, else
+ * EXIT_FAILURE.
+ */
+static int buildCodeTable(sHuffmanContext_t* io_psContext) {
+  HUFFMAN_STATS_BEGIN_STAGE(HUFFMAN_STAGE_TREE_BUILD);
+  if (io_psContext->isAllocationFree) {
+    createCodeLengthsWithWorkspace(io_psContext->aFrequencies,
+                                   io_psContext->aCodeLengths,
+                                   &io_psContext->sTreeWorkspace);
+  } else {
+    const eHuffmanStage_t ePreviousStage =
+        setHuffmanAllocationStage(HUFFMAN_STAGE_TREE_BUILD);
+    const int result = createCodeLengthsFromFrequenciesWithAllocator(
+        io_psContext->aFrequencies, io_psContext->aCodeLengths,
+        io_psContext->psAllocator);
+    (void)setHuffmanAllocationStage(ePreviousStage);
+    if (result == EXIT_FAILURE) {
+      return EXIT_FAILURE;
+    }
+  }
+  if (createCanonicalCodeTable(io_psContext->aCodeLengths,
+                               &io_psContext->sCodeTable) == EXIT_FAILURE) {
+    return EXIT_FAILURE;
+  }
+  HUFFMAN_STATS_END_STAGE(HUFFMAN_STAGE_TREE_BUILD, 0);
+
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Replace the code lengths of a context with the previous block's, if
+ * they code its frequencies almost as well.
+ *
+ * Blocks with the same code lengths share one decode table, which a context
+ * only rebuilds when the lengths change.
+ *
+ * @param[inout] io_psContext The context holding the frequencies and lengths.
+ * @param[in] i_pCodeLengths The previous block's packed code lengths.
+ */
+static void reuseCodeLengths(sHuffmanContext_t* io_psContext,
+                             const uint8_t* i_pCodeLengths) {
+  uint8_t aCodeLengths[HUFFMAN_ALPHABET_SIZE];
+  uint64_t reusedBits = 0;
+  for (size_t i = 0; i < HUFFMAN_CODE_LENGTHS_SIZE; i++) {
+    aCodeLengths[2 * i] = i_pCodeLengths[i] & 0x0FU;
+    aCodeLengths[(2 * i) + 1] = i_pCodeLengths[i] >> 4;
+  }
+  for (size_t symbol = 0; symbol < HUFFMAN_ALPHABET_SIZE; symbol++) {
+    if (io_psContext->aFrequencies[symbol] > 0 &&
+        aCodeLengths[symbol] == 0) {
+      return;
+    }
+    reusedBits +=
+        (uint64_t)io_psContext->aFrequencies[symbol] * aCodeLengths[symbol];
+  }
+
+  const uint64_t codedBits = getCodedBits(io_psContext);
+  sHuffmanCodeTable_t sCodeTable;
+  if (reusedBits > codedBits + (codedBits / CODE_LENGTH_REUSE_TOLERANCE) ||
+      createCanonicalCodeTable(aCodeLengths, &sCodeTable) == EXIT_FAILURE) {
+    return;
+  }
+  (void)memcpy(io_psContext->aCodeLengths, aCodeLengths,
+               sizeof(aCodeLengths));
+  io_psContext->sCodeTable = sCodeTable;
+}
+
+/**
+ * @brief Find the number of bits needed to code the frequencies of a context
+ * with its code lengths.
+ *
+ * @param[in] i_psContext The context holding the frequencies and lengths.
+ * @return uint64_t The number of coded bits.
+ */
+static uint64_t getCodedBits(const sHuffmanContext_t* i_psContext) {
+  uint64_t codedBits = 0;
+  for (size_t symbol = 0; symbol < HUFFMAN_ALPHABET_SIZE; symbol++) {
+    codedBits += (uint64_t)i_psContext->aFrequencies[symbol] *
+                 i_psContext->aCodeLengths[symbol];
+  }
+  return codedBits;
+}
+
+/**
+ * @brief Pack two 4-bit code lengths into each byte.
+ *
+ * @param[in] i_aCodeLengths The code length of each symbol.
+ * @param[out] o_pOutput The HUFFMAN_CODE_LENGTHS_SIZE bytes to write to.
+ */
+static void packCodeLengths(const uint8_t i_aCodeLengths[HUFFMAN_ALPHABET_SIZE],
+                            uint8_t* o_pOutput) {
+  for (size_t i = 0; i < HUFFMAN_CODE_LENGTHS_SIZE; i++) {
+    o_pOutput[i] = (uint8_t)(i_aCodeLengths[2 * i] |
+                             (i_aCodeLengths[(2 * i) + 1] << 4));
+  }
+}
+
+/**
+ * @brief Code bytes with a canonical code table.
+ *
+ * When there are sync points, the bit offset of the code for every
+ * i_syncInterval-th byte is recorded as it is reached. Otherwise, the bytes
+ * may be coded by several threads if they are known to fit.
+ *
+ * Codes from sampled frequencies may not fit, so with a capacity the bytes
+ * are coded in pieces that would fit even if every code were
+ * HUFFMAN_MAX_CODE_LENGTH bits. Coding only gives up when there is no room
+ * left for one more code.
+ *
+ * @param[in] i_psCodeTable The canonical code table.
+ * @param[in] i_pInput The bytes to code.
+ * @param[in] i_inputSize The number of bytes to code.
+ * @param[in] i_syncInterval The number of bytes between sync points, or 0
+ * for none.
+ * @param[out] o_pSyncPoints The buffer to write the sync points to, or NULL
+ * if there are none.
+ * @param[in] i_threadCount The number of threads to code with.
+ * @param[in] i_outputCapacity The most bytes the codes may take, or SIZE_MAX
+ * if they are known to fit.
+ * @param[out] o_pOutput The buffer to write the codes to.
+ * @param[out] o_pOutputSize The number of bytes written.
+ * @return int EXIT_SUCCESS if the bytes were coded, else EXIT_FAILURE if the
+ * codes would not fit.
+ */
+static int encodePayload(const sHuffmanCodeTable_t* i_psCodeTable,
+                         const uint8_t* i_pInput, size_t i_inputSize,
+                         size_t i_syncInterval, uint8_t* o_pSyncPoints,
+                         size_t i_threadCount, size_t i_outputCapacity,
+                         uint8_t* o_pOutput, size_t* o_pOutputSize) {
+  HUFFMAN_STATS_BEGIN_STAGE(HUFFMAN_STAGE_ENCODE);
+  if (o_pSyncPoints == NULL && i_threadCount > 1 &&
+      i_outputCapacity == SIZE_MAX) {
+    *o_pOutputSize = encodeTableSymbolsParallel(
+        i_psCodeTable, i_pInput, i_inputSize, i_threadCount, o_pOutput);
+    HUFFMAN_STATS_END_STAGE(HUFFMAN_STAGE_ENCODE, i_inputSize);
+    HUFFMAN_STATS_ADD(symbolsEncoded, i_inputSize);
+    return EXIT_SUCCESS;
+  }
+
+  sBitWriter_t sWriter;
+  initBitWriter(&sWriter, o_pOutput);
+  const size_t segmentSize =
+      (o_pSyncPoints != NULL) ? i_syncInterval : i_inputSize;
+  size_t segmentEnd = (i_inputSize < segmentSize) ? i_inputSize : segmentSize;
+  size_t i = 0;
+  while (i < i_inputSize) {
+    size_t end = segmentEnd;
+    if (i_outputCapacity != SIZE_MAX) {
+      const uint64_t freeBits =
+          ((uint64_t)(i_outputCapacity - sWriter.position) * 8) -
+          sWriter.bitCount;
+      const size_t maxSymbols = (size_t)(freeBits / HUFFMAN_MAX_CODE_LENGTH);
+      if (maxSymbols == 0) {
+        HUFFMAN_STATS_END_STAGE(HUFFMAN_STAGE_ENCODE, i);
+        return EXIT_FAILURE;
+      }
+      end = (end - i < maxSymbols) ? end : i + maxSymbols;
+    }
+    encodeTableSymbols(i_psCodeTable, &i_pInput[i], end - i, &sWriter);
+    i = end;
+    if (i < segmentEnd || i == i_inputSize) {
+      continue;
+    }
+
+    writeUint32(&o_pSyncPoints[0], (uint32_t)i);
+    writeUint64(&o_pSyncPoints[4],
+                ((uint64_t)sWriter.position * 8) + sWriter.bitCount);
+    o_pSyncPoints += HUFFMAN_SYNC_POINT_SIZE;
+    segmentEnd =
+        (i_inputSize - i < segmentSize) ? i_inputSize : i + segmentSize;
+  }
+  *o_pOutputSize = flushBitWriter(&sWriter);
+  HUFFMAN_STATS_END_STAGE(HUFFMAN_STAGE_ENCODE, i_inputSize);
+  HUFFMAN_STATS_ADD(symbolsEncoded, i_inputSize);
+
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Find the number of sync points in a coded block.
+ *
+ * A sync point is recorded every i_syncInterval bytes after the start of the
+ * block, which needs none as decoding can always start there.
+ *
+ * @param[in] i_inputSize The number of uncompressed bytes in the block.
+ * @param[in] i_syncInterval The number of bytes between sync points, or 0
+ * for none.
+ * @return size_t The number of sync points.
+ */
+static size_t getSyncPointCount(size_t i_inputSize, size_t i_syncInterval) {
+  if (i_syncInterval == 0 || i_inputSize == 0) {
+    return 0;
+  }
+  return (i_inputSize - 1) / i_syncInterval;
+}
+
+/**
+ * @brief Decompress a single block.
+ *
+ * Codes of up to HUFFMAN_DECODE_TABLE_BITS bits are decoded with a single
+ * table lookup. Longer codes fall back to walking the nibble tree
+ * HUFFMAN_NIBBLE_TREE_BITS bits at a time. The decode table is kept in the
+ * context and only rebuilt when a block's code lengths differ from the
+ * previous block's.
+ * Blocks without sync points are decoded with the context's threads, if it
+ * has more than one. A block's checksum, if it has one, is verified against
+ * its decoded bytes.
+ *
+ * @param[inout] io_psContext The scratch memory for the block.
+ * @param[in] i_pInput The block, starting at its header.
+ * @param[in] i_inputSize The number of bytes available in the input.
+ * @param[out] o_pOutput The buffer to write the uncompressed bytes to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @param[out] o_pBlockSize The number of input bytes the block occupies.
+ * @param[out] o_pOutputSize The number of bytes written to the output.
+ * @return int EXIT_SUCCESS if the block was decompressed successfully, else
+ * EXIT_FAILURE.
+ */
+static int decodeBlock(sHuffmanContext_t* io_psContext,
+                       const uint8_t* i_pInput, size_t i_inputSize,
+                       uint8_t* o_pOutput, size_t i_outputCapacity,
+                       size_t* o_pBlockSize, size_t* o_pOutputSize) {
+  sBlockLayout_t sLayout;
+  if (readBlockLayout(i_pInput, i_inputSize, &sLayout) == EXIT_FAILURE) {
+    return EXIT_FAILURE;
+  }
+
+  if (sLayout.outputSize > i_outputCapacity) {
+    (void)fprintf(stderr, "ERROR: Output buffer is too small\n");
+    return EXIT_FAILURE;
+  }
+
+  uint32_t checksum = 0;
+  if (sLayout.isStored) {
+    (void)memcpy(o_pOutput, sLayout.pPayload, sLayout.payloadSize);
+    if (sLayout.hasChecksum) {
+      checksum = updateCrc32c(0, o_pOutput, sLayout.outputSize);
+    }
+  } else {
+    if (loadDecodeTables(io_psContext, sLayout.pCodeLengths) == EXIT_FAILURE) {
+      return EXIT_FAILURE;
+    }
+
+    int result = EXIT_FAILURE;
+    if (sLayout.pSyncPoints == NULL && io_psContext->threadCount > 1) {
+      HUFFMAN_STATS_BEGIN_STAGE(HUFFMAN_STAGE_DECODE);
+      result = decodeTableSymbolsParallel(
+          io_psContext->aDecodeTable,
+          (io_psContext->maxDecodeLength > HUFFMAN_DECODE_TABLE_BITS)
+              ? &io_psContext->sNibbleTree
+              : NULL,
+          sLayout.pPayload, sLayout.payloadSize, o_pOutput,
+          sLayout.outputSize, io_psContext->threadCount,
+          io_psContext->psAllocator);
+      if (result == EXIT_SUCCESS) {
+        HUFFMAN_STATS_END_STAGE(HUFFMAN_STAGE_DECODE, sLayout.outputSize);
+        HUFFMAN_STATS_ADD(symbolsDecoded, sLayout.outputSize);
+        if (sLayout.hasChecksum) {
+          checksum = updateCrc32c(0, o_pOutput, sLayout.outputSize);
+        }
+      }
+    } else {
+      result = decodePayload(io_psContext, sLayout.pPayload,
+                             sLayout.payloadSize, o_pOutput,
+                             sLayout.outputSize,
+                             sLayout.hasChecksum ? &checksum : NULL);
+    }
+    if (result == EXIT_FAILURE) {
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (sLayout.hasChecksum && checksum != sLayout.checksum) {
+    (void)fprintf(stderr, "ERROR: Block checksum mismatch\n");
+    return EXIT_FAILURE;
+  }
+  HUFFMAN_STATS_ADD(blocksDecoded, 1);
+
+  *o_pBlockSize = sLayout.blockSize;
+  *o_pOutputSize = sLayout.outputSize;
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Find the parts of a block from its header.
+ *
+ * Stored blocks must hold exactly their uncompressed size, and coded blocks
+ * their code lengths, any sync points and their payload. Either may end
+ * with a checksum.
+ *
+ * @param[in] i_pInput The block, starting at its header.
+ * @param[in] i_inputSize The number of bytes available in the input.
+ * @param[out] o_psLayout The parts of the block.
+ * @return int EXIT_SUCCESS if the block fits in the input, else EXIT_FAILURE.
+ */
+static int readBlockLayout(const uint8_t* i_pInput, size_t i_inputSize,
+                           sBlockLayout_t* o_psLayout) {
+  if (i_inputSize < HUFFMAN_BLOCK_HEADER_SIZE) {
+    (void)fprintf(stderr, "ERROR: Truncated block header\n");
+    return EXIT_FAILURE;
+  }
+
+  const uint8_t blockFlags = i_pInput[8];
+  const uint8_t* pBody = &i_pInput[HUFFMAN_BLOCK_HEADER_SIZE];
+  size_t bodyCapacity = i_inputSize - HUFFMAN_BLOCK_HEADER_SIZE;
+  o_psLayout->outputSize = readUint32(&i_pInput[0]);
+  o_psLayout->payloadSize = readUint32(&i_pInput[4]);
+  o_psLayout->isStored = (blockFlags & HUFFMAN_BLOCK_FLAG_STORED) != 0;
+  o_psLayout->pCodeLengths = NULL;
+  o_psLayout->pSyncPoints = NULL;
+  o_psLayout->syncPointCount = 0;
+  o_psLayout->hasChecksum = (blockFlags & HUFFMAN_BLOCK_FLAG_CHECKSUM) != 0;
+  o_psLayout->checksum = 0;
+
+  /* The checksum follows the payload, so set its bytes aside first. */
+  const size_t checksumSize =
+      o_psLayout->hasChecksum ? HUFFMAN_CHECKSUM_SIZE : 0;
+  if (bodyCapacity < checksumSize) {
+    (void)fprintf(stderr, "ERROR: Truncated block\n");
+    return EXIT_FAILURE;
+  }
+  bodyCapacity -= checksumSize;
+
+  if (o_psLayout->isStored) {
+    if (o_psLayout->payloadSize != o_psLayout->outputSize ||
+        o_psLayout->payloadSize > bodyCapacity) {
+      (void)fprintf(stderr, "ERROR: Malformed stored block\n");
+      return EXIT_FAILURE;
+    }
+    setBlockPayload(i_pInput, pBody, o_psLayout);
+    return EXIT_SUCCESS;
+  }
+
+  if (bodyCapacity < HUFFMAN_CODE_LENGTHS_SIZE) {
+    (void)fprintf(stderr, "ERROR: Truncated block\n");
+    return EXIT_FAILURE;
+  }
+  o_psLayout->pCodeLengths = pBody;
+  pBody += HUFFMAN_CODE_LENGTHS_SIZE;
+  bodyCapacity -= HUFFMAN_CODE_LENGTHS_SIZE;
+
+  if ((blockFlags & HUFFMAN_BLOCK_FLAG_SYNC_POINTS) != 0) {
+    if (bodyCapacity < 4 ||
+        readUint32(pBody) > (bodyCapacity - 4) / HUFFMAN_SYNC_POINT_SIZE) {
+      (void)fprintf(stderr, "ERROR: Truncated sync points\n");
+      return EXIT_FAILURE;
+    }
+    o_psLayout->syncPointCount = readUint32(pBody);
+    o_psLayout->pSyncPoints = &pBody[4];
+    const size_t syncTableSize =
+        4 + (o_psLayout->syncPointCount * HUFFMAN_SYNC_POINT_SIZE);
+    pBody += syncTableSize;
+    bodyCapacity -= syncTableSize;
+  }
+
+  if (o_psLayout->payloadSize > bodyCapacity) {
+    (void)fprintf(stderr, "ERROR: Truncated block\n");
+    return EXIT_FAILURE;
+  }
+  setBlockPayload(i_pInput, pBody, o_psLayout);
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Record where the payload of a block starts, and read the checksum
+ * after it.
+ *
+ * @param[in] i_pInput The block, starting at its header.
+ * @param[in] i_pPayload The payload, which with any checksum fits in the
+ * input.
+ * @param[inout] io_psLayout The parts of the block, with the payload size.
+ */
+static void setBlockPayload(const uint8_t* i_pInput,
+                            const uint8_t* i_pPayload,
+                            sBlockLayout_t* io_psLayout) {
+  io_psLayout->pPayload = i_pPayload;
+  io_psLayout->blockSize =
+      (size_t)(i_pPayload - i_pInput) + io_psLayout->payloadSize;
+  if (io_psLayout->hasChecksum) {
+    io_psLayout->checksum = readUint32(&i_pInput[io_psLayout->blockSize]);
+    io_psLayout->blockSize += HUFFMAN_CHECKSUM_SIZE;
+  }
+}
+
+/**
+ * @brief Load the decoding tables of a context from packed code lengths.
+ *
+ * The tables are only rebuilt when the code lengths differ from those they
+ * were built from. The nibble tree is only built when there are codes longer
+ * than the decode table width.
+ *
+ * @param[inout] io_psContext The context to load the tables into.
+ * @param[in] i_pCodeLengths The HUFFMAN_CODE_LENGTHS_SIZE packed code lengths.
+ * @return int EXIT_SUCCESS if the tables were loaded successfully, else
+ * EXIT_FAILURE.
+ */
+static int loadDecodeTables(sHuffmanContext_t* io_psContext,
+                            const uint8_t* i_pCodeLengths) {
+  HUFFMAN_STATS_BEGIN_STAGE(HUFFMAN_STAGE_TABLE_BUILD);
+  uint8_t* aCodeLengths = io_psContext->aCodeLengths;
+  if (!io_psContext->isDecodeTableValid ||
+      memcmp(io_psContext->aDecodeTableLengths, i_pCodeLengths,
+             HUFFMAN_CODE_LENGTHS_SIZE) != 0) {
+    io_psContext->isDecodeTableValid = false;
+    for (size_t i = 0; i < HUFFMAN_CODE_LENGTHS_SIZE; i++) {
+      aCodeLengths[2 * i] = i_pCodeLengths[i] & 0x0FU;
+      aCodeLengths[(2 * i) + 1] = i_pCodeLengths[i] >> 4;
+    }
+    if (createCanonicalCodeTable(aCodeLengths, &io_psContext->sCodeTable) ==
+        EXIT_FAILURE) {
+      return EXIT_FAILURE;
+    }
+
+    io_psContext->maxDecodeLength = createDecodeTable(
+        &io_psContext->sCodeTable, io_psContext->aDecodeTable);
+    io_psContext->isMultiSymbolTableValid = createMultiSymbolDecodeTable(
+        &io_psContext->sCodeTable, io_psContext->aDecodeTable,
+        io_psContext->aMultiSymbolTable);
+    if (io_psContext->maxDecodeLength > HUFFMAN_DECODE_TABLE_BITS) {
+      createNibbleTree(&io_psContext->sCodeTable, &io_psContext->sNibbleTree);
+    }
+    (void)memcpy(io_psContext->aDecodeTableLengths, i_pCodeLengths,
+                 HUFFMAN_CODE_LENGTHS_SIZE);
+    io_psContext->isDecodeTableValid = true;
+  }
+  HUFFMAN_STATS_END_STAGE(HUFFMAN_STAGE_TABLE_BUILD, 0);
+
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Decode a coded payload with the tables loaded in a context.
+ *
+ * @param[in] i_psContext The context holding the decoding tables.
+ * @param[in] i_pPayload The coded payload.
+ * @param[in] i_payloadSize The number of bytes in the payload.
+ * @param[out] o_pOutput The buffer to write the decoded bytes to.
+ * @param[in] i_outputSize The number of bytes to decode.
+ * @param[out] o_pChecksum The checksum of the decoded bytes, or NULL to not
+ * find it.
+ * @return int EXIT_SUCCESS if the payload was decoded successfully, else
+ * EXIT_FAILURE.
+ */
+static int decodePayload(const sHuffmanContext_t* i_psContext,
+                         const uint8_t* i_pPayload, size_t i_payloadSize,
+                         uint8_t* o_pOutput, size_t i_outputSize,
+                         uint32_t* o_pChecksum) {
+  HUFFMAN_STATS_BEGIN_STAGE(HUFFMAN_STAGE_DECODE);
+  sBitReader_t sReader;
+  initBitReader(&sReader, i_pPayload, i_payloadSize);
+
+  /* Tiny alphabets are checksummed in the multi-symbol decode loop, and
+   * anything left in chunks while it is still in the L1 cache. */
+  uint32_t checksum = 0;
+  size_t start = 0;
+  if ((o_pChecksum != NULL) && i_psContext->isMultiSymbolTableValid) {
+    start = decodeMultiSymbolsWithCrc32c(i_psContext->aMultiSymbolTable,
+                                         &sReader, o_pOutput, i_outputSize,
+                                         &checksum);
+  }
+  const size_t chunkSize =
+      (o_pChecksum != NULL) ? CHECKSUM_CHUNK_SIZE : i_outputSize;
+  for (size_t i = start; i < i_outputSize; i += chunkSize) {
+    const size_t count =
+        (i_outputSize - i < chunkSize) ? i_outputSize - i : chunkSize;
+    if (decodeSymbols(i_psContext, &sReader, &o_pOutput[i], count) ==
+        EXIT_FAILURE) {
+      return EXIT_FAILURE;
+    }
+    if (o_pChecksum != NULL) {
+      checksum = updateCrc32c(checksum, &o_pOutput[i], count);
+    }
+  }
+
+  if (getBitReaderPosition(&sReader) > i_payloadSize) {
+    (void)fprintf(stderr, "ERROR: Block payload is truncated\n");
+    return EXIT_FAILURE;
+  }
+  HUFFMAN_STATS_END_STAGE(HUFFMAN_STAGE_DECODE, i_outputSize);
+  HUFFMAN_STATS_ADD(symbolsDecoded, i_outputSize);
+
+  if (o_pChecksum != NULL) {
+    *o_pChecksum = checksum;
+  }
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Decode symbols from a bit reader with the tables loaded in a
+ * context.
+ *
+ * Codes up to the decode table width are looked up with decodeTableSymbols,
+ * or several at a time with decodeMultiSymbols for tiny alphabets, and
+ * longer codes are decoded with the nibble tree.
+ *
+ * @param[in] i_psContext The context holding the decoding tables.
+ * @param[inout] io_psReader The bit reader positioned at the first code.
+ * @param[out] o_pOutput The buffer to write the decoded bytes to.
+ * @param[in] i_outputSize The number of bytes to decode.
+ * @return int EXIT_SUCCESS if the symbols were decoded successfully, else
+ * EXIT_FAILURE.
+ */
+static int decodeSymbols(const sHuffmanContext_t* i_psContext,
+                         sBitReader_t* io_psReader, uint8_t* o_pOutput,
+                         size_t i_outputSize) {
+  size_t i = 0;
+  if (i_psContext->isMultiSymbolTableValid) {
+    i = decodeMultiSymbols(i_psContext->aMultiSymbolTable, io_psReader,
+                           o_pOutput, i_outputSize);
+  }
+  while (true) {
+    i += decodeTableSymbols(i_psContext->aDecodeTable, io_psReader,
+                            &o_pOutput[i], i_outputSize - i);
+    if (i == i_outputSize) {
+      break;
+    }
+
+    /* The kernel stopped at a code longer than the table width, which is
+     * invalid if there are none, e.g. a single symbol's unused code. The
+     * nibble tree is only built when there are. */
+    if (io_psReader->bitCount <= HUFFMAN_MAX_CODE_LENGTH) {
+      refillBitReader(io_psReader);
+    }
+    if (decodeNibbleTreeCode(
+            (i_psContext->maxDecodeLength > HUFFMAN_DECODE_TABLE_BITS)
+                ? &i_psContext->sNibbleTree
+                : NULL,
+            io_psReader, &o_pOutput[i]) == EXIT_FAILURE) {
+      (void)fprintf(stderr, "ERROR: Invalid code in block\n");
+      return EXIT_FAILURE;
+    }
+    i++;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Decompress part of a single block, starting from the nearest sync
+ * point.
+ *
+ * The sync points are searched for the last one at or before the offset.
+ * The bytes between it and the offset are decoded into a small scratch
+ * buffer and discarded.
+ *
+ * @param[inout] io_psContext The scratch memory for the block.
+ * @param[in] i_psLayout The parts of the block.
+ * @param[in] i_offset The offset of the first byte to decode in the block.
+ * @param[in] i_length The number of bytes to decode.
+ * @param[out] o_pOutput The buffer to write the i_length bytes to.
+ * @return int EXIT_SUCCESS if the range was decompressed successfully, else
+ * EXIT_FAILURE.
+ */
+static int decodeBlockRange(sHuffmanContext_t* io_psContext,
+                            const sBlockLayout_t* i_psLayout, size_t i_offset,
+                            size_t i_length, uint8_t* o_pOutput) {
+  if (i_psLayout->isStored) {
+    (void)memcpy(o_pOutput, &i_psLayout->pPayload[i_offset], i_length);
+    return EXIT_SUCCESS;
+  }
+
+  /* Find the last sync point at or before the offset. */
+  size_t syncOffset = 0;
+  uint64_t bitOffset = 0;
+  size_t low = 0;
+  size_t high = i_psLayout->syncPointCount;
+  while (low < high) {
+    const size_t middle = low + ((high - low) / 2);
+    const uint8_t* pSyncPoint =
+        &i_psLayout->pSyncPoints[middle * HUFFMAN_SYNC_POINT_SIZE];
+    if (readUint32(pSyncPoint) <= i_offset) {
+      syncOffset = readUint32(pSyncPoint);
+      bitOffset = readUint64(&pSyncPoint[4]);
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  if (bitOffset > (uint64_t)i_psLayout->payloadSize * 8) {
+    (void)fprintf(stderr, "ERROR: Malformed sync point\n");
+    return EXIT_FAILURE;
+  }
+
+  if (loadDecodeTables(io_psContext, i_psLayout->pCodeLengths) ==
+      EXIT_FAILURE) {
+    return EXIT_FAILURE;
+  }
+
+  HUFFMAN_STATS_BEGIN_STAGE(HUFFMAN_STAGE_DECODE);
+  sBitReader_t sReader;
+  initBitReader(&sReader, i_psLayout->pPayload, i_psLayout->payloadSize);
+  seekBitReader(&sReader, bitOffset);
+
+  uint8_t aScratch[256];
+  size_t skip = i_offset - syncOffset;
+  int result = EXIT_SUCCESS;
+  while (result == EXIT_SUCCESS && skip > 0) {
+    const size_t count = (skip < sizeof(aScratch)) ? skip : sizeof(aScratch);
+    result = decodeSymbols(io_psContext, &sReader, aScratch, count);
+    skip -= count;
+  }
+  if (result == EXIT_SUCCESS) {
+    result = decodeSymbols(io_psContext, &sReader, o_pOutput, i_length);
+  }
+  if (result == EXIT_FAILURE) {
+    return EXIT_FAILURE;
+  }
+
+  if (getBitReaderPosition(&sReader) > i_psLayout->payloadSize) {
+    (void)fprintf(stderr, "ERROR: Block payload is truncated\n");
+    return EXIT_FAILURE;
+  }
+  HUFFMAN_STATS_END_STAGE(HUFFMAN_STAGE_DECODE, i_offset - syncOffset +
+                                                    i_length);
+  HUFFMAN_STATS_ADD(symbolsDecoded, i_offset - syncOffset + i_length);
+
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Record a search hit, unless it is before the start offset.
+ *
+ * @param[inout] io_psResults The search results.
+ * @param[in] i_offset The uncompressed offset of the hit.
+ * @return bool Whether the results are now full.
+ */
+static bool addSearchHit(sSearchResults_t* io_psResults, size_t i_offset) {
+  if (i_offset >= io_psResults->startOffset) {
+    io_psResults->aOffsets[io_psResults->count++] = i_offset;
+  }
+  return io_psResults->count == io_psResults->maxOffsets;
+}
+
+/**
+ * @brief Find a pattern in uncompressed bytes.
+ *
+ * @param[in] i_pData The bytes to search.
+ * @param[in] i_size The number of bytes to search.
+ * @param[in] i_dataOffset The uncompressed offset of the first byte.
+ * @param[in] i_psPattern The pattern.
+ * @param[inout] io_psResults The search results.
+ * @return bool Whether the results are now full.
+ */
+static bool searchBytes(const uint8_t* i_pData, size_t i_size,
+                        size_t i_dataOffset,
+                        const sSearchPattern_t* i_psPattern,
+                        sSearchResults_t* io_psResults) {
+  const size_t patternSize = i_psPattern->size;
+  size_t position = 0;
+  while (i_size - position >= patternSize) {
+    const uint8_t* pFirst =
+        (const uint8_t*)memchr(&i_pData[position], i_psPattern->pBytes[0],
+                               i_size - position - patternSize + 1);
+    if (pFirst == NULL) {
+      break;
+    }
+    position = (size_t)(pFirst - i_pData);
+    if (memcmp(pFirst, i_psPattern->pBytes, patternSize) == 0 &&
+        addSearchHit(io_psResults, i_dataOffset + position)) {
+      return true;
+    }
+    position++;
+  }
+  return false;
+}
+
+/**
+ * @brief Write a search pattern's codes in a block, shifted by each number
+ * of bits from 0 to 7.
+ *
+ * @param[in] i_pCodeLengths The block's packed code lengths.
+ * @param[inout] io_psPattern The pattern to write the codes of.
+ * @return int EXIT_SUCCESS if the code lengths are valid, else EXIT_FAILURE.
+ */
+static int loadSearchPattern(const uint8_t* i_pCodeLengths,
+                             sSearchPattern_t* io_psPattern) {
+  uint8_t* aCodeLengths = io_psPattern->aCodeLengths;
+  for (size_t i = 0; i < HUFFMAN_CODE_LENGTHS_SIZE; i++) {
+    aCodeLengths[2 * i] = i_pCodeLengths[i] & 0x0FU;
+    aCodeLengths[(2 * i) + 1] = i_pCodeLengths[i] >> 4;
+  }
+  sHuffmanCodeTable_t sCodeTable;
+  if (createCanonicalCodeTable(aCodeLengths, &sCodeTable) == EXIT_FAILURE) {
+    return EXIT_FAILURE;
+  }
+
+  /* A byte without a code never occurs in the block. */
+  io_psPattern->bitCount = 0;
+  for (size_t i = 0; i < io_psPattern->size; i++) {
+    if (aCodeLengths[io_psPattern->pBytes[i]] == 0) {
+      io_psPattern->bitCount = 0;
+      return EXIT_SUCCESS;
+    }
+    io_psPattern->bitCount += aCodeLengths[io_psPattern->pBytes[i]];
+  }
+
+  for (size_t shift = 0; shift < 8; shift++) {
+    sBitWriter_t sWriter;
+    initBitWriter(&sWriter, io_psPattern->aaShiftedCodes[shift]);
+    writeBits(&sWriter, 0, shift);
+    for (size_t i = 0; i < io_psPattern->size; i++) {
+      const uint8_t symbol = io_psPattern->pBytes[i];
+      writeBits(&sWriter, sCodeTable.aCodes[symbol], aCodeLengths[symbol]);
+    }
+    (void)flushBitWriter(&sWriter);
+  }
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Mark the bits of a window of a payload where the pattern's codes
+ * start.
+ *
+ * The codes are compared a byte at a time for each of the 8 bit offsets a
+ * match can start at, looking for their whole middle bytes with memchr and
+ * memcmp and then masking the partial bytes at either end.
+ *
+ * @param[in] i_psPattern The pattern, loaded for the block.
+ * @param[in] i_psLayout The parts of the block.
+ * @param[in] i_windowStart The offset of the window in the payload.
+ * @param[in] i_windowEnd The offset of the end of the window.
+ * @param[out] o_aCandidates A bit for each bit of the window.
+ * @return bool Whether any bit was marked.
+ */
+static bool findSearchCandidates(const sSearchPattern_t* i_psPattern,
+                                 const sBlockLayout_t* i_psLayout,
+                                 size_t i_windowStart, size_t i_windowEnd,
+                                 uint64_t* o_aCandidates) {
+  const uint8_t* pPayload = i_psLayout->pPayload;
+  bool isAnyCandidate = false;
+  (void)memset(o_aCandidates, 0, SEARCH_WINDOW_SIZE);
+
+  for (size_t shift = 0; shift < 8; shift++) {
+    const uint8_t* pCodes = i_psPattern->aaShiftedCodes[shift];
+    const size_t byteCount = (shift + i_psPattern->bitCount + 7) / 8;
+    if (byteCount > i_psLayout->payloadSize) {
+      continue;
+    }
+    const size_t lastByteCount = i_psLayout->payloadSize - byteCount + 1;
+    const size_t end =
+        (i_windowEnd < lastByteCount) ? i_windowEnd : lastByteCount;
+    const size_t lastBits = (shift + i_psPattern->bitCount) % 8;
+    const uint8_t lastMask =
+        (lastBits != 0) ? (uint8_t)((1U << lastBits) - 1) : 0xFFU;
+    const uint8_t firstMask = (uint8_t)((0xFFU << shift) &
+                                        ((byteCount == 1) ? lastMask : 0xFFU));
+
+    size_t start = i_windowStart;
+    while (start < end) {
+      if (byteCount >= 3) {
+        const uint8_t* pMiddle = (const uint8_t*)memchr(
+            &pPayload[start + 1], pCodes[1], end - start);
+        if (pMiddle == NULL) {
+          break;
+        }
+        start = (size_t)(pMiddle - pPayload) - 1;
+        if (memcmp(pMiddle, &pCodes[1], byteCount - 2) != 0) {
+          start++;
+          continue;
+        }
+      }
+      if ((pPayload[start] & firstMask) == pCodes[0] &&
+          (byteCount == 1 ||
+           (pPayload[start + byteCount - 1] & lastMask) ==
+               pCodes[byteCount - 1])) {
+        const size_t bit = ((start - i_windowStart) * 8) + shift;
+        o_aCandidates[bit / 64] |= (uint64_t)1 << (bit % 64);
+        isAnyCandidate = true;
+      }
+      start++;
+    }
+  }
+  return isAnyCandidate;
+}
+
+/**
+ * @brief Find a pattern in a coded block.
+ *
+ * The payload is scanned for the bits of the pattern's codes without
+ * decoding it. A candidate is only a match if a code starts at its bit, so
+ * the codes are walked from the last sync point before the first candidate
+ * of each window, or from wherever the previous window's walk stopped, up to
+ * its last candidate. Windows without candidates are never decoded.
+ *
+ * @param[inout] io_psContext The scratch memory for the block.
+ * @param[in] i_psLayout The parts of the block.
+ * @param[in] i_blockStart The uncompressed offset of the block.
+ * @param[inout] io_psPattern The pattern.
+ * @param[inout] io_psResults The search results.
+ * @return int EXIT_SUCCESS if the block was searched successfully, else
+ * EXIT_FAILURE.
+ */
+static int searchCodedBlock(sHuffmanContext_t* io_psContext,
+                            const sBlockLayout_t* i_psLayout,
+                            size_t i_blockStart, sSearchPattern_t* io_psPattern,
+                            sSearchResults_t* io_psResults) {
+  if (loadSearchPattern(i_psLayout->pCodeLengths, io_psPattern) ==
+      EXIT_FAILURE) {
+    return EXIT_FAILURE;
+  }
+  if (io_psPattern->bitCount == 0 ||
+      i_psLayout->outputSize < io_psPattern->size) {
+    return EXIT_SUCCESS;
+  }
+
+  if (loadDecodeTables(io_psContext, i_psLayout->pCodeLengths) ==
+      EXIT_FAILURE) {
+    return EXIT_FAILURE;
+  }
+
+  /* The cursor is at the start of a code, and the codes between it and the
+   * reader are decoded into the chunk. */
+  const uint64_t payloadBits = (uint64_t)i_psLayout->payloadSize * 8;
+  const size_t lastOffset = i_psLayout->outputSize - io_psPattern->size;
+  sBitReader_t sReader;
+  initBitReader(&sReader, i_psLayout->pPayload, i_psLayout->payloadSize);
+  uint64_t cursorBit = 0;
+  size_t cursorOffset = 0;
+  size_t decodedOffset = 0;
+  uint8_t aChunk[SEARCH_CHUNK_SIZE];
+  size_t chunkIndex = 0;
+  size_t chunkCount = 0;
+  uint64_t aCandidates[SEARCH_WINDOW_SIZE / 8];
+  int result = EXIT_SUCCESS;
+  bool isFull = false;
+
+  for (size_t windowStart = 0;
+       windowStart < i_psLayout->payloadSize && result == EXIT_SUCCESS &&
+       !isFull && cursorOffset <= lastOffset;
+       windowStart += SEARCH_WINDOW_SIZE) {
+    const size_t windowEnd =
+        (i_psLayout->payloadSize - windowStart > SEARCH_WINDOW_SIZE)
+            ? windowStart + SEARCH_WINDOW_SIZE
+            : i_psLayout->payloadSize;
+    if (!findSearchCandidates(io_psPattern, i_psLayout, windowStart,
+                              windowEnd, aCandidates)) {
+      continue;
+    }
+
+    const uint64_t windowBit = (uint64_t)windowStart * 8;
+    size_t first = SIZE_MAX;
+    size_t last = 0;
+    for (size_t i = 0; i < SEARCH_WINDOW_SIZE / 8; i++) {
+      if (aCandidates[i] != 0) {
+        if (first == SIZE_MAX) {
+          first = (i * 64) + (size_t)__builtin_ctzll(aCandidates[i]);
+        }
+        last = (i * 64) + 63 - (size_t)__builtin_clzll(aCandidates[i]);
+      }
+    }
+
+    /* Jump to the last sync point at or before the first candidate. */
+    const uint8_t* pSyncPoint = NULL;
+    size_t low = 0;
+    size_t high = i_psLayout->syncPointCount;
+    while (low < high) {
+      const size_t middle = low + ((high - low) / 2);
+      const uint8_t* pMiddle =
+          &i_psLayout->pSyncPoints[middle * HUFFMAN_SYNC_POINT_SIZE];
+      if (readUint64(&pMiddle[4]) <= windowBit + first) {
+        pSyncPoint = pMiddle;
+        low = middle + 1;
+      } else {
+        high = middle;
+      }
+    }
+    if (pSyncPoint != NULL && readUint64(&pSyncPoint[4]) > cursorBit) {
+      if (readUint64(&pSyncPoint[4]) > payloadBits ||
+          readUint32(pSyncPoint) > i_psLayout->outputSize) {
+        (void)fprintf(stderr, "ERROR: Malformed sync point\n");
+        result = EXIT_FAILURE;
+        break;
+      }
+      cursorBit = readUint64(&pSyncPoint[4]);
+      cursorOffset = readUint32(pSyncPoint);
+      initBitReader(&sReader, i_psLayout->pPayload, i_psLayout->payloadSize);
+      seekBitReader(&sReader, cursorBit);
+      decodedOffset = cursorOffset;
+      chunkIndex = 0;
+      chunkCount = 0;
+    }
+
+    /* Walk the codes up to the last candidate, checking each code start. */
+    while (result == EXIT_SUCCESS && cursorBit <= windowBit + last &&
+           cursorOffset <= lastOffset) {
+      if (chunkIndex == chunkCount) {
+        const size_t remaining = i_psLayout->outputSize - decodedOffset;
+        chunkCount =
+            (remaining < SEARCH_CHUNK_SIZE) ? remaining : SEARCH_CHUNK_SIZE;
+        chunkIndex = 0;
+        result =
+            decodeSymbols(io_psContext, &sReader, aChunk, chunkCount);
+        decodedOffset += chunkCount;
+        continue;
+      }
+      if (cursorBit >= windowBit) {
+        const uint64_t bit = cursorBit - windowBit;
+        if (((aCandidates[bit / 64] >> (bit % 64)) & 1U) != 0 &&
+            addSearchHit(io_psResults, i_blockStart + cursorOffset)) {
+          isFull = true;
+          break;
+        }
+      }
+      cursorBit += io_psPattern->aCodeLengths[aChunk[chunkIndex++]];
+      cursorOffset++;
+    }
+  }
+
+  if (result == EXIT_SUCCESS && cursorBit > payloadBits) {
+    (void)fprintf(stderr, "ERROR: Block payload is truncated\n");
+    return EXIT_FAILURE;
+  }
+  return result;
+}
+
+/**
+ * @brief Find the matches that start before a block and end in it, and keep
+ * the bytes before the next block.
+ *
+ * @param[inout] io_psContext The scratch memory for the blocks.
+ * @param[in] i_psLayout The parts of the block.
+ * @param[in] i_blockStart The uncompressed offset of the block.
+ * @param[in] i_psPattern The pattern.
+ * @param[inout] io_psCarry The bytes before the block.
+ * @param[inout] io_psResults The search results.
+ * @return int EXIT_SUCCESS if the blocks were searched successfully, else
+ * EXIT_FAILURE.
+ */
+static int searchBlockBoundary(sHuffmanContext_t* io_psContext,
+                               const sBlockLayout_t* i_psLayout,
+                               size_t i_blockStart,
+                               const sSearchPattern_t* i_psPattern,
+                               sSearchCarry_t* io_psCarry,
+                               sSearchResults_t* io_psResults) {
+  const size_t patternSize = i_psPattern->size;
+  const size_t overlap = patternSize - 1;
+  const size_t outputSize = i_psLayout->outputSize;
+  const size_t headSize = (outputSize < overlap) ? outputSize : overlap;
+  uint8_t* aBytes = io_psCarry->aBytes;
+
+  if (io_psCarry->size > 0 || outputSize < overlap) {
+    if (decodeBlockRange(io_psContext, i_psLayout, 0, headSize,
+                         &aBytes[io_psCarry->size]) == EXIT_FAILURE) {
+      return EXIT_FAILURE;
+    }
+
+    /* Only decode the previous block's tail from the first byte a match
+     * could start at, given the start of this block. */
+    size_t needed = io_psCarry->size;
+    if (!io_psCarry->isDecoded && outputSize >= overlap) {
+      while (needed > 0 && memcmp(&i_psPattern->pBytes[needed],
+                                  &aBytes[io_psCarry->size],
+                                  patternSize - needed) != 0) {
+        needed--;
+      }
+    }
+    if (!io_psCarry->isDecoded && needed > 0 &&
+        decodeBlockRange(io_psContext, &io_psCarry->sPrevious,
+                         io_psCarry->sPrevious.outputSize - needed, needed,
+                         &aBytes[io_psCarry->size - needed]) ==
+            EXIT_FAILURE) {
+      return EXIT_FAILURE;
+    }
+
+    for (size_t start = io_psCarry->size - needed;
+         start + patternSize <= io_psCarry->size + headSize; start++) {
+      if (start + patternSize > io_psCarry->size &&
+          memcmp(&aBytes[start], i_psPattern->pBytes, patternSize) == 0 &&
+          addSearchHit(io_psResults,
+                       i_blockStart - io_psCarry->size + start)) {
+        return EXIT_SUCCESS;
+      }
+    }
+  }
+
+  if (outputSize >= overlap) {
+    io_psCarry->size = overlap;
+    io_psCarry->isDecoded = false;
+    io_psCarry->sPrevious = *i_psLayout;
+  } else {
+    const size_t total = io_psCarry->size + outputSize;
+    const size_t keep = (total < overlap) ? total : overlap;
+    (void)memmove(aBytes, &aBytes[total - keep], keep);
+    io_psCarry->size = keep;
+    io_psCarry->isDecoded = true;
+  }
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Find the offset of the block index from the trailer.
+ *
+ * @param[in] i_pInput The container.
+ * @param[in] i_inputSize The number of bytes in the container.
+ * @param[out] o_pIndexOffset The offset of the block index.
+ * @param[out] o_pBlockCount The number of blocks in the container.
+ * @return int EXIT_SUCCESS if the trailer is valid, else EXIT_FAILURE.
+ */
+static int readTrailer(const uint8_t* i_pInput, size_t i_inputSize,
+                       size_t* o_pIndexOffset, size_t* o_pBlockCount) {
+  if (i_inputSize < HUFFMAN_HEADER_SIZE + 4 + HUFFMAN_TRAILER_SIZE ||
+      memcmp(i_pInput, HEADER_MAGIC, sizeof(HEADER_MAGIC)) != 0 ||
+      i_pInput[4] != HUFFMAN_FORMAT_VERSION) {
+    (void)fprintf(stderr, "ERROR: Not a Huffman container\n");
+    return EXIT_FAILURE;
+  }
+
+  const uint8_t* pTrailer = &i_pInput[i_inputSize - HUFFMAN_TRAILER_SIZE];
+  if (memcmp(&pTrailer[12], TRAILER_MAGIC, sizeof(TRAILER_MAGIC)) != 0) {
+    (void)fprintf(stderr, "ERROR: Missing container trailer\n");
+    return EXIT_FAILURE;
+  }
+
+  const size_t blockCount = readUint32(&pTrailer[8]);
+  const size_t available =
+      i_inputSize - HUFFMAN_HEADER_SIZE - 4 - HUFFMAN_TRAILER_SIZE;
+  if (blockCount > available / sizeof(uint64_t)) {
+    (void)fprintf(stderr, "ERROR: Malformed block index\n");
+    return EXIT_FAILURE;
+  }
+
+  *o_pIndexOffset =
+      i_inputSize - HUFFMAN_TRAILER_SIZE - (blockCount * sizeof(uint64_t));
+  *o_pBlockCount = blockCount;
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Find the block size to compress with, or 0 if the options are
+ * invalid.
+ *
+ * @param[in] i_psOptions The compression options, or NULL for the defaults.
+ * @return size_t The block size, else 0.
+ */
+static size_t getValidBlockSize(const sHuffmanCompressOptions_t* i_psOptions) {
+  const size_t blockSize = (i_psOptions != NULL) ? i_psOptions->blockSize
+                                                 : HUFFMAN_DEFAULT_BLOCK_SIZE;
+
+  if (blockSize == 0 || blockSize > HUFFMAN_MAX_BLOCK_SIZE) {
+    (void)fprintf(stderr, "ERROR: Invalid block size %zu\n", blockSize);
+    return 0;
+  }
+
+  return blockSize;
+}
+
+/**
+ * @brief Compress a buffer into a Huffman container using a context.
+ *
+ * @param[inout] io_psContext The scratch memory for each block.
+ * @param[in] i_pInput The bytes to compress.
+ * @param[in] i_inputSize The number of bytes to compress.
+ * @param[out] o_pOutput The buffer to write the container to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @param[out] o_pOutputSize The number of bytes written to the output.
+ * @param[in] i_blockSize The number of uncompressed bytes in each block.
+ * @param[in] i_syncInterval The number of bytes between sync points, or 0
+ * for none.
+ * @param[in] i_threadCount The number of threads to code each block with.
+ * @param[in] i_isChecksumEnabled Whether to end each block with a checksum.
+ * @param[in] i_sampleInterval The number of runs in each window sampled for
+ * the frequencies of large blocks, or 0 or 1 to count every byte.
+ * @return int EXIT_SUCCESS if the input was compressed successfully, else
+ * EXIT_FAILURE.
+ */
+static int compressBlocks(sHuffmanContext_t* io_psContext,
+                          const uint8_t* i_pInput, size_t i_inputSize,
+                          uint8_t* o_pOutput, size_t i_outputCapacity,
+                          size_t* o_pOutputSize, size_t i_blockSize,
+                          size_t i_syncInterval, size_t i_threadCount,
+                          bool i_isChecksumEnabled, size_t i_sampleInterval) {
+  if (i_outputCapacity < HUFFMAN_HEADER_SIZE) {
+    (void)fprintf(stderr, "ERROR: Output buffer is too small\n");
+    return EXIT_FAILURE;
+  }
+
+  /* Write the container header. */
+  (void)memcpy(o_pOutput, HEADER_MAGIC, sizeof(HEADER_MAGIC));
+  o_pOutput[4] = HUFFMAN_FORMAT_VERSION;
+  o_pOutput[5] = 0;
+  o_pOutput[6] = 0;
+  o_pOutput[7] = 0;
+
+  return writeBlocks(io_psContext, i_pInput, i_inputSize, o_pOutput,
+                     i_outputCapacity, HUFFMAN_HEADER_SIZE, NULL, 0, 0, NULL,
+                     false, i_blockSize, i_syncInterval, i_threadCount,
+                     i_isChecksumEnabled, i_sampleInterval, o_pOutputSize);
+}
+
+/**
+ * @brief Write blocks, the end marker, the block index and the trailer.
+ *
+ * Blocks are written from an offset in the container, and the index lists
+ * the given offsets of any blocks before them followed by the new blocks.
+ *
+ * @param[inout] io_psContext The scratch memory for each block.
+ * @param[in] i_pInput The bytes to compress.
+ * @param[in] i_inputSize The number of bytes to compress.
+ * @param[inout] io_pContainer The container to write the blocks to.
+ * @param[in] i_containerCapacity The number of bytes available in the
+ * container.
+ * @param[in] i_blocksOffset The offset to write the first block at.
+ * @param[in] i_pIndex The block index entries of any earlier blocks.
+ * @param[in] i_indexCount The number of earlier blocks.
+ * @param[in] i_previousSize The uncompressed size of the earlier blocks.
+ * @param[in] i_pPreviousCodeLengths The last earlier block's packed code
+ * lengths, or NULL.
+ * @param[in] i_isCodeLengthReuse Whether each block may reuse the code
+ * lengths of the block before it.
+ * @param[in] i_blockSize The number of uncompressed bytes in each block.
+ * @param[in] i_syncInterval The number of bytes between sync points, or 0
+ * for none.
+ * @param[in] i_threadCount The number of threads to code each block with.
+ * @param[in] i_isChecksumEnabled Whether to end each block with a checksum.
+ * @param[in] i_sampleInterval The number of runs in each window sampled for
+ * the frequencies of large blocks, or 0 or 1 to count every byte.
+ * @param[out] o_pContainerSize The size of the container.
+ * @return int EXIT_SUCCESS if the blocks were written successfully, else
+ * EXIT_FAILURE.
+ */
+static int writeBlocks(sHuffmanContext_t* io_psContext,
+                       const uint8_t* i_pInput, size_t i_inputSize,
+                       uint8_t* io_pContainer, size_t i_containerCapacity,
+                       size_t i_blocksOffset, const uint8_t* i_pIndex,
+                       size_t i_indexCount, uint64_t i_previousSize,
+                       const uint8_t* i_pPreviousCodeLengths,
+                       bool i_isCodeLengthReuse, size_t i_blockSize,
+                       size_t i_syncInterval, size_t i_threadCount,
+                       bool i_isChecksumEnabled, size_t i_sampleInterval,
+                       size_t* o_pContainerSize) {
+  size_t position = i_blocksOffset;
+  const uint8_t* pPreviousCodeLengths = i_pPreviousCodeLengths;
+
+  /* Write each block. */
+  size_t blockCount = 0;
+  for (size_t offset = 0; offset < i_inputSize; offset += i_blockSize) {
+    const size_t remaining = i_inputSize - offset;
+    const size_t inputSize =
+        (remaining < i_blockSize) ? remaining : i_blockSize;
+    size_t blockSize = 0;
+
+    if (encodeBlock(io_psContext, &i_pInput[offset], inputSize,
+                    &io_pContainer[position], i_containerCapacity - position,
+                    i_syncInterval, i_threadCount, i_isChecksumEnabled,
+                    i_sampleInterval, pPreviousCodeLengths,
+                    &blockSize) == EXIT_FAILURE) {
+      return EXIT_FAILURE;
+    }
+    if (i_isCodeLengthReuse &&
+        (io_pContainer[position + 8] & HUFFMAN_BLOCK_FLAG_STORED) == 0) {
+      pPreviousCodeLengths =
+          &io_pContainer[position + HUFFMAN_BLOCK_HEADER_SIZE];
+    }
+    position += blockSize;
+    blockCount++;
+  }
+
+  if (blockCount > UINT32_MAX - i_indexCount) {
+    (void)fprintf(stderr, "ERROR: Too many blocks\n");
+    return EXIT_FAILURE;
+  }
+  const size_t indexSize = (i_indexCount + blockCount) * sizeof(uint64_t);
+  if (i_containerCapacity - position < 4 + indexSize + HUFFMAN_TRAILER_SIZE) {
+    (void)fprintf(stderr, "ERROR: Output buffer is too small\n");
+    return EXIT_FAILURE;
+  }
+
+  /* Write the end marker. */
+  writeUint32(&io_pContainer[position], 0);
+  position += 4;
+
+  /* Write the block index by walking the new block headers again. */
+  if (i_indexCount > 0) {
+    (void)memmove(&io_pContainer[position], i_pIndex,
+                  i_indexCount * sizeof(uint64_t));
+    position += i_indexCount * sizeof(uint64_t);
+  }
+  size_t blockOffset = i_blocksOffset;
+  for (size_t i = 0; i < blockCount; i++) {
+    sBlockLayout_t sLayout;
+    (void)readBlockLayout(&io_pContainer[blockOffset], position - blockOffset,
+                          &sLayout);
+
+    writeUint64(&io_pContainer[position], blockOffset);
+    position += sizeof(uint64_t);
+    blockOffset += sLayout.blockSize;
+  }
+
+  /* Write the trailer. */
+  writeUint64(&io_pContainer[position], i_previousSize + i_inputSize);
+  writeUint32(&io_pContainer[position + 8],
+              (uint32_t)(i_indexCount + blockCount));
+  (void)memcpy(&io_pContainer[position + 12], TRAILER_MAGIC,
+               sizeof(TRAILER_MAGIC));
+  position += HUFFMAN_TRAILER_SIZE;
+
+  *o_pContainerSize = position;
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Decompress a Huffman container into a buffer using a context.
+ *
+ * @param[inout] io_psContext The scratch memory for each block.
+ * @param[in] i_pInput The container.
+ * @param[in] i_inputSize The number of bytes in the container.
+ * @param[out] o_pOutput The buffer to write the uncompressed bytes to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @param[out] o_pOutputSize The number of bytes written to the output.
+ * @return int EXIT_SUCCESS if the container was decompressed successfully,
+ * else EXIT_FAILURE.
+ */
+static int decompressBlocks(sHuffmanContext_t* io_psContext,
+                            const uint8_t* i_pInput, size_t i_inputSize,
+                            uint8_t* o_pOutput, size_t i_outputCapacity,
+                            size_t* o_pOutputSize) {
+  size_t indexOffset = 0;
+  size_t blockCount = 0;
+
+  if (readTrailer(i_pInput, i_inputSize, &indexOffset, &blockCount) ==
+      EXIT_FAILURE) {
+    return EXIT_FAILURE;
+  }
+
+  /* Blocks run from the header up to the end marker before the index. */
+  const size_t blocksEnd = indexOffset - 4;
+  size_t position = HUFFMAN_HEADER_SIZE;
+  size_t outputPosition = 0;
+
+  for (size_t i = 0; i < blockCount; i++) {
+    if (readUint64(&i_pInput[indexOffset + (i * sizeof(uint64_t))]) !=
+        position) {
+      (void)fprintf(stderr, "ERROR: Block index does not match blocks\n");
+      return EXIT_FAILURE;
+    }
+
+    size_t blockSize = 0;
+    size_t outputSize = 0;
+    if (decodeBlock(io_psContext, &i_pInput[position], blocksEnd - position,
+                    &o_pOutput[outputPosition],
+                    i_outputCapacity - outputPosition, &blockSize,
+                    &outputSize) == EXIT_FAILURE) {
+      return EXIT_FAILURE;
+    }
+    position += blockSize;
+    outputPosition += outputSize;
+  }
+
+  if (position != blocksEnd || readUint32(&i_pInput[blocksEnd]) != 0) {
+    (void)fprintf(stderr, "ERROR: Missing end of blocks marker\n");
+    return EXIT_FAILURE;
+  }
+  if (outputPosition !=
+      readUint64(&i_pInput[i_inputSize - HUFFMAN_TRAILER_SIZE])) {
+    (void)fprintf(stderr, "ERROR: Trailer does not match blocks\n");
+    return EXIT_FAILURE;
+  }
+
+  *o_pOutputSize = outputPosition;
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Validate a batch header and its entries.
+ *
+ * The payload sizes in the entries must account for every byte after them,
+ * and stored payloads must be the same size as their buffers.
+ *
+ * @param[in] i_pInput The batch.
+ * @param[in] i_inputSize The number of bytes in the batch.
+ * @param[out] o_pBufferCount The number of buffers in the batch.
+ * @param[out] o_pEntriesOffset The offset of the first entry.
+ * @param[out] o_pDecompressedSize The total uncompressed size.
+ * @return int EXIT_SUCCESS if the batch is valid, else EXIT_FAILURE.
+ */
+static int readBatchHeader(const uint8_t* i_pInput, size_t i_inputSize,
+                           size_t* o_pBufferCount, size_t* o_pEntriesOffset,
+                           size_t* o_pDecompressedSize) {
+  if (i_inputSize < HUFFMAN_BATCH_HEADER_SIZE ||
+      memcmp(i_pInput, BATCH_MAGIC, sizeof(BATCH_MAGIC)) != 0 ||
+      i_pInput[4] != HUFFMAN_FORMAT_VERSION) {
+    (void)fprintf(stderr, "ERROR: Not a Huffman batch\n");
+    return EXIT_FAILURE;
+  }
+
+  const int isStored = (i_pInput[5] & HUFFMAN_BLOCK_FLAG_STORED) != 0;
+  const size_t bufferCount = readUint32(&i_pInput[8]);
+  const size_t entriesOffset =
+      HUFFMAN_BATCH_HEADER_SIZE + (isStored ? 0 : HUFFMAN_CODE_LENGTHS_SIZE);
+  if (i_inputSize < entriesOffset ||
+      bufferCount >
+          (i_inputSize - entriesOffset) / HUFFMAN_BATCH_ENTRY_SIZE) {
+    (void)fprintf(stderr, "ERROR: Truncated batch entries\n");
+    return EXIT_FAILURE;
+  }
+
+  const size_t payloadsOffset =
+      entriesOffset + (bufferCount * HUFFMAN_BATCH_ENTRY_SIZE);
+  size_t payloadsSize = 0;
+  size_t decompressedSize = 0;
+  for (size_t i = 0; i < bufferCount; i++) {
+    const uint8_t* pEntry =
+        &i_pInput[entriesOffset + (i * HUFFMAN_BATCH_ENTRY_SIZE)];
+    const size_t outputSize = readUint32(&pEntry[0]);
+    const size_t payloadSize = readUint32(&pEntry[4]);
+    if ((isStored && payloadSize != outputSize) ||
+        payloadSize > i_inputSize - payloadsOffset - payloadsSize) {
+      (void)fprintf(stderr, "ERROR: Malformed batch entry\n");
+      return EXIT_FAILURE;
+    }
+    payloadsSize += payloadSize;
+    decompressedSize += outputSize;
+  }
+
+  if (payloadsOffset + payloadsSize != i_inputSize) {
+    (void)fprintf(stderr, "ERROR: Batch payloads do not match entries\n");
+    return EXIT_FAILURE;
+  }
+
+  *o_pBufferCount = bufferCount;
+  *o_pEntriesOffset = entriesOffset;
+  *o_pDecompressedSize = decompressedSize;
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Initialise compression options to their defaults.
+ *
+ * @param[out] o_psOptions The options to initialise.
+ */
+void initCompressOptions(sHuffmanCompressOptions_t* o_psOptions) {
+  o_psOptions->blockSize = HUFFMAN_DEFAULT_BLOCK_SIZE;
+  o_psOptions->syncInterval = 0;
+  o_psOptions->threadCount = 1;
+  o_psOptions->psAllocator = NULL;
+  o_psOptions->isChecksumEnabled = false;
+  o_psOptions->sampleInterval = 0;
+}
+
+/**
+ * @brief Find the maximum compressed size of an input.
+ *
+ * @param[in] i_inputSize The number of bytes to compress.
+ * @param[in] i_psOptions The compression options, or NULL for the defaults.
+ * @return size_t The output capacity that compressBuffer never exceeds.
+ */
+size_t getCompressBound(size_t i_inputSize,
+                        const sHuffmanCompressOptions_t* i_psOptions) {
+  const size_t blockSize = (i_psOptions != NULL && i_psOptions->blockSize != 0)
+                               ? i_psOptions->blockSize
+                               : HUFFMAN_DEFAULT_BLOCK_SIZE;
+  const size_t blockCount = (i_inputSize + blockSize - 1) / blockSize;
+  const size_t checksumSize =
+      (i_psOptions != NULL && i_psOptions->isChecksumEnabled)
+          ? HUFFMAN_CHECKSUM_SIZE
+          : 0;
+
+  /* Blocks that would not shrink are stored, so never exceed their input. */
+  return HUFFMAN_HEADER_SIZE + i_inputSize +
+         (blockCount * (HUFFMAN_BLOCK_HEADER_SIZE + HUFFMAN_CODE_LENGTHS_SIZE +
+                        checksumSize + sizeof(uint64_t))) +
+         4 + HUFFMAN_TRAILER_SIZE;
+}
+
+/**
+ * @brief Compress a buffer into a Huffman container.
+ *
+ * This function splits the input into blocks, builds a canonical Huffman code
+ * table for each block from its byte frequencies, and writes the coded blocks
+ * followed by the block index. It returns EXIT_FAILURE if the options are
+ * invalid, the output is too small or memory cannot be allocated.
+ *
+ * @param[in] i_pInput The bytes to compress.
+ * @param[in] i_inputSize The number of bytes to compress.
+ * @param[out] o_pOutput The buffer to write the container to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @param[out] o_pOutputSize The number of bytes written to the output.
+ * @param[in] i_psOptions The compression options, or NULL for the defaults.
+ * @return int EXIT_SUCCESS if the input was compressed successfully, else
+ * EXIT_FAILURE.
+ */
+int compressBuffer(const uint8_t* i_pInput, size_t i_inputSize,
+                   uint8_t* o_pOutput, size_t i_outputCapacity,
+                   size_t* o_pOutputSize,
+                   const sHuffmanCompressOptions_t* i_psOptions) {
+  const size_t blockSize = getValidBlockSize(i_psOptions);
+  if (blockSize == 0) {
+    return EXIT_FAILURE;
+  }
+
+  sHuffmanContext_t sContext;
+  initStackContext(&sContext,
+                   (i_psOptions != NULL) ? i_psOptions->psAllocator : NULL,
+                   i_inputSize);
+
+  return compressBlocks(
+      &sContext, i_pInput, i_inputSize, o_pOutput, i_outputCapacity,
+      o_pOutputSize, blockSize,
+      (i_psOptions != NULL) ? i_psOptions->syncInterval : 0,
+      (i_psOptions != NULL) ? i_psOptions->threadCount : 1,
+      (i_psOptions != NULL) && i_psOptions->isChecksumEnabled,
+      (i_psOptions != NULL) ? i_psOptions->sampleInterval : 0);
+}
+
+/**
+ * @brief Find the maximum size of a container after appending an input.
+ *
+ * @param[in] i_containerSize The number of bytes in the container.
+ * @param[in] i_inputSize The number of bytes to append.
+ * @param[in] i_psOptions The compression options, or NULL for the defaults.
+ * @return size_t The container capacity that appendBuffer never exceeds.
+ */
+size_t getAppendBound(size_t i_containerSize, size_t i_inputSize,
+                      const sHuffmanCompressOptions_t* i_psOptions) {
+  /* The container already holds a header, an end marker and a trailer. */
+  return i_containerSize + getCompressBound(i_inputSize, i_psOptions) -
+         (HUFFMAN_HEADER_SIZE + 4 + HUFFMAN_TRAILER_SIZE);
+}
+
+/**
+ * @brief Append an input to a Huffman container in place.
+ *
+ * This function compresses the input into new blocks written over the end
+ * marker, block index and trailer, then rewrites them after the new blocks.
+ * The existing blocks are not decoded or recompressed, and a new block reuses
+ * the code lengths of the block before it when they cost at most 1/64 more.
+ * It returns EXIT_FAILURE, leaving the container unchanged, if the options or
+ * the container are invalid, the capacity is too small or memory cannot be
+ * allocated.
+ *
+ * @param[inout] io_pContainer The container to append to.
+ * @param[in] i_containerSize The number of bytes in the container.
+ * @param[in] i_containerCapacity The number of bytes available for the
+ * container, at most getAppendBound.
+ * @param[in] i_pInput The bytes to append.
+ * @param[in] i_inputSize The number of bytes to append.
+ * @param[out] o_pContainerSize The number of bytes in the container after
+ * appending.
+ * @param[in] i_psOptions The compression options, or NULL for the defaults.
+ * @return int EXIT_SUCCESS if the input was appended successfully, else
+ * EXIT_FAILURE.
+ */
+int appendBuffer(uint8_t* io_pContainer, size_t i_containerSize,
+                 size_t i_containerCapacity, const uint8_t* i_pInput,
+                 size_t i_inputSize, size_t* o_pContainerSize,
+                 const sHuffmanCompressOptions_t* i_psOptions) {
+  const size_t blockSize = getValidBlockSize(i_psOptions);
+  size_t indexOffset = 0;
+  size_t blockCount = 0;
+  if (blockSize == 0 || i_containerCapacity < i_containerSize ||
+      readTrailer(io_pContainer, i_containerSize, &indexOffset,
+                  &blockCount) == EXIT_FAILURE) {
+    return EXIT_FAILURE;
+  }
+
+  /* Only the last block is checked, as the new blocks follow it. */
+  const size_t blocksEnd = indexOffset - 4;
+  const uint8_t* pPreviousCodeLengths = NULL;
+  if (readUint32(&io_pContainer[blocksEnd]) != 0) {
+    (void)fprintf(stderr, "ERROR: Missing end of blocks marker\n");
+    return EXIT_FAILURE;
+  }
+  if (blockCount > 0) {
+    const uint64_t lastOffset = readUint64(
+        &io_pContainer[indexOffset + ((blockCount - 1) * sizeof(uint64_t))]);
+    sBlockLayout_t sLayout;
+    if (lastOffset < HUFFMAN_HEADER_SIZE || lastOffset >= blocksEnd ||
+        readBlockLayout(&io_pContainer[lastOffset], blocksEnd - lastOffset,
+                        &sLayout) == EXIT_FAILURE ||
+        lastOffset + sLayout.blockSize != blocksEnd) {
+      (void)fprintf(stderr, "ERROR: Block index does not match blocks\n");
+      return EXIT_FAILURE;
+    }
+    pPreviousCodeLengths = sLayout.pCodeLengths;
+  } else if (blocksEnd != HUFFMAN_HEADER_SIZE) {
+    (void)fprintf(stderr, "ERROR: Block index does not match blocks\n");
+    return EXIT_FAILURE;
+  }
+
+  const uint64_t previousSize =
+      readUint64(&io_pContainer[i_containerSize - HUFFMAN_TRAILER_SIZE]);
+  if (i_inputSize > SIZE_MAX - previousSize) {
+    (void)fprintf(stderr, "ERROR: Container is too large to append to\n");
+    return EXIT_FAILURE;
+  }
+
+  /* Keep the old index and trailer, as the new blocks overwrite them. */
+  const sHuffmanAllocator_t* psAllocator =
+      (i_psOptions != NULL) ? i_psOptions->psAllocator : NULL;
+  const size_t tailSize = i_containerSize - blocksEnd;
+  uint8_t* pTail = (uint8_t*)allocateHuffmanMemory(psAllocator, tailSize);
+  if (pTail == NULL) {
+    perror("ERROR: Failed to allocate memory for block index");
+    return EXIT_FAILURE;
+  }
+  (void)memcpy(pTail, &io_pContainer[blocksEnd], tailSize);
+
+  sHuffmanContext_t sContext;
+  initStackContext(&sContext, psAllocator, i_inputSize);
+  const int result = writeBlocks(
+      &sContext, i_pInput, i_inputSize, io_pContainer, i_containerCapacity,
+      blocksEnd, &pTail[4], blockCount, previousSize, pPreviousCodeLengths,
+      true, blockSize, (i_psOptions != NULL) ? i_psOptions->syncInterval : 0,
+      (i_psOptions != NULL) ? i_psOptions->threadCount : 1,
+      (i_psOptions != NULL) && i_psOptions->isChecksumEnabled,
+      (i_psOptions != NULL) ? i_psOptions->sampleInterval : 0,
+      o_pContainerSize);
+  if (result == EXIT_FAILURE) {
+    (void)memcpy(&io_pContainer[blocksEnd], pTail, tailSize);
+  }
+
+  freeHuffmanMemory(psAllocator, pTail);
+  return result;
+}
+
+/**
+ * @brief Read the uncompressed size of a Huffman container.
+ *
+ * @param[in] i_pInput The container.
+ * @param[in] i_inputSize The number of bytes in the container.
+ * @param[out] o_pDecompressedSize The total uncompressed size.
+ * @return int EXIT_SUCCESS if the size was read successfully, else
+ * EXIT_FAILURE.
+ */
+int getDecompressedSize(const uint8_t* i_pInput, size_t i_inputSize,
+                        size_t* o_pDecompressedSize) {
+  size_t indexOffset = 0;
+  size_t blockCount = 0;
+
+  if (readTrailer(i_pInput, i_inputSize, &indexOffset, &blockCount) ==
+      EXIT_FAILURE) {
+    return EXIT_FAILURE;
+  }
+
+  *o_pDecompressedSize =
+      (size_t)readUint64(&i_pInput[i_inputSize - HUFFMAN_TRAILER_SIZE]);
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Decompress a Huffman container into a buffer.
+ *
+ * This function decodes each block in turn, verifying any block checksums.
+ * It returns EXIT_FAILURE if the container is malformed, a checksum does not
+ * match or the output is too small.
+ *
+ * @param[in] i_pInput The container.
+ * @param[in] i_inputSize The number of bytes in the container.
+ * @param[out] o_pOutput The buffer to write the uncompressed bytes to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @param[out] o_pOutputSize The number of bytes written to the output.
+ * @return int EXIT_SUCCESS if the container was decompressed successfully,
+ * else EXIT_FAILURE.
+ */
+int decompressBuffer(const uint8_t* i_pInput, size_t i_inputSize,
+                     uint8_t* o_pOutput, size_t i_outputCapacity,
+                     size_t* o_pOutputSize) {
+  /* A malformed trailer is reported by decompressBlocks. */
+  size_t decompressedSize = SIZE_MAX;
+  (void)getDecompressedSize(i_pInput, i_inputSize, &decompressedSize);
+
+  sHuffmanContext_t sContext;
+  initStackContext(&sContext, NULL, decompressedSize);
+
+  return decompressBlocks(&sContext, i_pInput, i_inputSize, o_pOutput,
+                          i_outputCapacity, o_pOutputSize);
+}
+
+/**
+ * @brief Decompress a range of bytes from a Huffman container.
+ *
+ * This function finds the block holding the start of the range from the
+ * block index, and starts decoding from the last sync point at or before
+ * it rather than from the start of the block. Block checksums are not
+ * verified, as they cover whole blocks. It returns EXIT_FAILURE if the
+ * container is malformed or the range extends past its end.
+ *
+ * @param[in] i_pInput The container.
+ * @param[in] i_inputSize The number of bytes in the container.
+ * @param[in] i_offset The uncompressed offset of the first byte to decode.
+ * @param[in] i_length The number of bytes to decode.
+ * @param[out] o_pOutput The buffer to write the i_length bytes to.
+ * @return int EXIT_SUCCESS if the range was decompressed successfully, else
+ * EXIT_FAILURE.
+ */
+int decompressRange(const uint8_t* i_pInput, size_t i_inputSize,
+                    size_t i_offset, size_t i_length, uint8_t* o_pOutput) {
+  sHuffmanContext_t sContext;
+  initStackContext(&sContext, NULL, i_length);
+
+  return decompressRangeWithContext(&sContext, i_pInput, i_inputSize,
+                                    i_offset, i_length, o_pOutput);
+}
+
+/**
+ * @brief Find the uncompressed offsets of a pattern in a Huffman container.
+ *
+ * Each coded block is searched for the bits of the pattern's codes in that
+ * block's code table, without decoding it. Only the codes from the last sync
+ * point before each candidate are decoded, to check a code starts at it and
+ * to find its offset, so blocks with sync points are searched much faster
+ * than they decode. Matches spanning blocks are found by decoding the ends
+ * of the blocks. The offsets are found in ascending order, from i_offset on,
+ * until i_maxOffsets have been found.
+ *
+ * @param[in] i_pInput The container.
+ * @param[in] i_inputSize The number of bytes in the container.
+ * @param[in] i_pPattern The bytes to search for.
+ * @param[in] i_patternSize The number of bytes in the pattern, from 1 to
+ * HUFFMAN_MAX_SEARCH_PATTERN_SIZE.
+ * @param[in] i_offset The uncompressed offset to search from.
+ * @param[out] o_aOffsets The buffer to write the offsets of matches to.
+ * @param[in] i_maxOffsets The number of offsets available in the buffer.
+ * @param[out] o_pOffsetCount The number of offsets written to the buffer.
+ * @return int EXIT_SUCCESS if the container was searched successfully, else
+ * EXIT_FAILURE.
+ */
+int searchContainer(const uint8_t* i_pInput, size_t i_inputSize,
+                    const uint8_t* i_pPattern, size_t i_patternSize,
+                    size_t i_offset, size_t* o_aOffsets, size_t i_maxOffsets,
+                    size_t* o_pOffsetCount) {
+  sHuffmanContext_t sContext;
+  initStackContext(&sContext, NULL, 0);
+
+  return searchContainerWithContext(&sContext, i_pInput, i_inputSize,
+                                    i_pPattern, i_patternSize, i_offset,
+                                    o_aOffsets, i_maxOffsets, o_pOffsetCount);
+}
+
+/**
+ * @brief Decompress a Huffman container into a buffer with the given
+ * allocator.
+ *
+ * @deprecated Decompressing no longer allocates, as long codes are decoded
+ * with a nibble tree in the context on the stack, so the allocator is
+ * ignored. Use decompressBuffer instead.
+ *
+ * @param[in] i_pInput The container.
+ * @param[in] i_inputSize The number of bytes in the container.
+ * @param[out] o_pOutput The buffer to write the uncompressed bytes to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @param[out] o_pOutputSize The number of bytes written to the output.
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ * @return int EXIT_SUCCESS if the container was decompressed successfully,
+ * else EXIT_FAILURE.
+ */
+int decompressBufferWithAllocator(const uint8_t* i_pInput, size_t i_inputSize,
+                                  uint8_t* o_pOutput, size_t i_outputCapacity,
+                                  size_t* o_pOutputSize,
+                                  const sHuffmanAllocator_t* i_psAllocator) {
+  (void)i_psAllocator;
+  return decompressBuffer(i_pInput, i_inputSize, o_pOutput, i_outputCapacity,
+                          o_pOutputSize);
+}
+
+/**
+ * @brief Decompress a Huffman container into a buffer, decoding each block
+ * with several threads.
+ *
+ * Blocks without sync points are split between the threads, which guess
+ * where codes start and synchronise with each other. The output is identical
+ * to decompressBuffer's, which a block is decoded with instead if the threads
+ * fail to synchronise.
+ *
+ * @param[in] i_pInput The container.
+ * @param[in] i_inputSize The number of bytes in the container.
+ * @param[out] o_pOutput The buffer to write the uncompressed bytes to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @param[out] o_pOutputSize The number of bytes written to the output.
+ * @param[in] i_threadCount The number of threads to decode each block with.
+ * @return int EXIT_SUCCESS if the container was decompressed successfully,
+ * else EXIT_FAILURE.
+ */
+int decompressBufferWithThreads(const uint8_t* i_pInput, size_t i_inputSize,
+                                uint8_t* o_pOutput, size_t i_outputCapacity,
+                                size_t* o_pOutputSize, size_t i_threadCount) {
+  size_t decompressedSize = SIZE_MAX;
+  (void)getDecompressedSize(i_pInput, i_inputSize, &decompressedSize);
+
+  sHuffmanContext_t sContext;
+  initStackContext(&sContext, NULL, decompressedSize);
+  sContext.threadCount = i_threadCount;
+
+  return decompressBlocks(&sContext, i_pInput, i_inputSize, o_pOutput,
+                          i_outputCapacity, o_pOutputSize);
+}
+
+/**
+ * @brief Create a reusable compression and decompression context.
+ *
+ * The context owns all the scratch memory needed to compress or decompress a
+ * block and is allocated once, here. Compressing or decompressing with the
+ * context never allocates.
+ *
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ * @return sHuffmanContext_t* The context, else NULL.
+ */
+sHuffmanContext_t* createHuffmanContext(
+    const sHuffmanAllocator_t* i_psAllocator) {
+  sHuffmanContext_t* psContext = (sHuffmanContext_t*)allocateHuffmanMemory(
+      i_psAllocator, sizeof(sHuffmanContext_t));
+  if (psContext == NULL) {
+    perror("ERROR: Failed to allocate memory for Huffman context");
+    return NULL;
+  }
+
+  psContext->psAllocator = i_psAllocator;
+  psContext->isAllocationFree = true;
+  psContext->threadCount = 1;
+  resetHuffmanContext(psContext);
+
+  return psContext;
+}
+
+/**
+ * @brief Free a context created by createHuffmanContext.
+ *
+ * @param[inout] io_psContext The context to free, or NULL.
+ */
+void freeHuffmanContext(sHuffmanContext_t* io_psContext) {
+  if (io_psContext == NULL) {
+    return;
+  }
+
+  freeHuffmanMemory(io_psContext->psAllocator, io_psContext);
+}
+
+/**
+ * @brief Discard any state a context has cached from previous calls.
+ *
+ * Only the cached decode table is invalidated, so resetting costs the same
+ * regardless of how much scratch memory the context owns.
+ *
+ * @param[inout] io_psContext The context to reset.
+ */
+void resetHuffmanContext(sHuffmanContext_t* io_psContext) {
+  io_psContext->isDecodeTableValid = false;
+}
+
+/**
+ * @brief Compress a buffer into a Huffman container using a context.
+ *
+ * The output is identical to compressBuffer's. The allocator in the options
+ * is ignored, as the context does not allocate.
+ *
+ * @param[inout] io_psContext The context.
+ * @param[in] i_pInput The bytes to compress.
+ * @param[in] i_inputSize The number of bytes to compress.
+ * @param[out] o_pOutput The buffer to write the container to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @param[out] o_pOutputSize The number of bytes written to the output.
+ * @param[in] i_psOptions The compression options, or NULL for the defaults.
+ * @return int EXIT_SUCCESS if the input was compressed successfully, else
+ * EXIT_FAILURE.
+ */
+int compressBufferWithContext(sHuffmanContext_t* io_psContext,
+                              const uint8_t* i_pInput, size_t i_inputSize,
+                              uint8_t* o_pOutput, size_t i_outputCapacity,
+                              size_t* o_pOutputSize,
+                              const sHuffmanCompressOptions_t* i_psOptions) {
+  const size_t blockSize = getValidBlockSize(i_psOptions);
+  if (blockSize == 0) {
+    return EXIT_FAILURE;
+  }
+
+  return compressBlocks(
+      io_psContext, i_pInput, i_inputSize, o_pOutput, i_outputCapacity,
+      o_pOutputSize, blockSize,
+      (i_psOptions != NULL) ? i_psOptions->syncInterval : 0,
+      (i_psOptions != NULL) ? i_psOptions->threadCount : 1,
+      (i_psOptions != NULL) && i_psOptions->isChecksumEnabled,
+      (i_psOptions != NULL) ? i_psOptions->sampleInterval : 0);
+}
+
+/**
+ * @brief Decompress a Huffman container into a buffer using a context.
+ *
+ * The decode table is kept between blocks and calls, and is only rebuilt
+ * when a block's code lengths differ from those it was built from.
+ *
+ * @param[inout] io_psContext The context.
+ * @param[in] i_pInput The container.
+ * @param[in] i_inputSize The number of bytes in the container.
+ * @param[out] o_pOutput The buffer to write the uncompressed bytes to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @param[out] o_pOutputSize The number of bytes written to the output.
+ * @return int EXIT_SUCCESS if the container was decompressed successfully,
+ * else EXIT_FAILURE.
+ */
+int decompressBufferWithContext(sHuffmanContext_t* io_psContext,
+                                const uint8_t* i_pInput, size_t i_inputSize,
+                                uint8_t* o_pOutput, size_t i_outputCapacity,
+                                size_t* o_pOutputSize) {
+  return decompressBlocks(io_psContext, i_pInput, i_inputSize, o_pOutput,
+                          i_outputCapacity, o_pOutputSize);
+}
+
+/**
+ * @brief Decompress a range of bytes from a Huffman container using a
+ * context.
+ *
+ * Blocks before the range are skipped by their uncompressed size alone,
+ * and only the blocks that overlap it are decoded.
+ *
+ * @param[inout] io_psContext The context.
+ * @param[in] i_pInput The container.
+ * @param[in] i_inputSize The number of bytes in the container.
+ * @param[in] i_offset The uncompressed offset of the first byte to decode.
+ * @param[in] i_length The number of bytes to decode.
+ * @param[out] o_pOutput The buffer to write the i_length bytes to.
+ * @return int EXIT_SUCCESS if the range was decompressed successfully, else
+ * EXIT_FAILURE.
+ */
+int decompressRangeWithContext(sHuffmanContext_t* io_psContext,
+                               const uint8_t* i_pInput, size_t i_inputSize,
+                               size_t i_offset, size_t i_length,
+                               uint8_t* o_pOutput) {
+  size_t indexOffset = 0;
+  size_t blockCount = 0;
+
+  if (readTrailer(i_pInput, i_inputSize, &indexOffset, &blockCount) ==
+      EXIT_FAILURE) {
+    return EXIT_FAILURE;
+  }
+
+  const uint64_t totalSize =
+      readUint64(&i_pInput[i_inputSize - HUFFMAN_TRAILER_SIZE]);
+  if (i_length > totalSize || i_offset > totalSize - i_length) {
+    (void)fprintf(stderr, "ERROR: Range is past the end of the container\n");
+    return EXIT_FAILURE;
+  }
+
+  const size_t blocksEnd = indexOffset - 4;
+  size_t blockStart = 0;
+  size_t outputPosition = 0;
+  for (size_t i = 0; i < blockCount && outputPosition < i_length; i++) {
+    const uint64_t blockOffset =
+        readUint64(&i_pInput[indexOffset + (i * sizeof(uint64_t))]);
+    sBlockLayout_t sLayout;
+    if (blockOffset < HUFFMAN_HEADER_SIZE || blockOffset >= blocksEnd ||
+        readBlockLayout(&i_pInput[blockOffset], blocksEnd - blockOffset,
+                        &sLayout) == EXIT_FAILURE) {
+      (void)fprintf(stderr, "ERROR: Block index does not match blocks\n");
+      return EXIT_FAILURE;
+    }
+
+    /* Skip blocks that end before the range starts. */
+    const size_t blockEnd = blockStart + sLayout.outputSize;
+    const size_t rangeStart = i_offset + outputPosition;
+    if (blockEnd > rangeStart) {
+      const size_t offset = rangeStart - blockStart;
+      const size_t available = sLayout.outputSize - offset;
+      const size_t remaining = i_length - outputPosition;
+      const size_t count = (remaining < available) ? remaining : available;
+      if (decodeBlockRange(io_psContext, &sLayout, offset, count,
+                           &o_pOutput[outputPosition]) == EXIT_FAILURE) {
+        return EXIT_FAILURE;
+      }
+      outputPosition += count;
+    }
+    blockStart = blockEnd;
+  }
+
+  if (outputPosition != i_length) {
+    (void)fprintf(stderr, "ERROR: Blocks do not match the container size\n");
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Find the uncompressed offsets of a pattern in a Huffman container
+ * using a context.
+ *
+ * The offsets are identical to searchContainer's.
+ *
+ * @param[inout] io_psContext The context.
+ * @param[in] i_pInput The container.
+ * @param[in] i_inputSize The number of bytes in the container.
+ * @param[in] i_pPattern The bytes to search for.
+ * @param[in] i_patternSize The number of bytes in the pattern, from 1 to
+ * HUFFMAN_MAX_SEARCH_PATTERN_SIZE.
+ * @param[in] i_offset The uncompressed offset to search from.
+ * @param[out] o_aOffsets The buffer to write the offsets of matches to.
+ * @param[in] i_maxOffsets The number of offsets available in the buffer.
+ * @param[out] o_pOffsetCount The number of offsets written to the buffer.
+ * @return int EXIT_SUCCESS if the container was searched successfully, else
+ * EXIT_FAILURE.
+ */
+int searchContainerWithContext(sHuffmanContext_t* io_psContext,
+                               const uint8_t* i_pInput, size_t i_inputSize,
+                               const uint8_t* i_pPattern, size_t i_patternSize,
+                               size_t i_offset, size_t* o_aOffsets,
+                               size_t i_maxOffsets, size_t* o_pOffsetCount) {
+  if (i_patternSize == 0 || i_patternSize > HUFFMAN_MAX_SEARCH_PATTERN_SIZE) {
+    (void)fprintf(stderr, "ERROR: Invalid search pattern size %zu\n",
+                  i_patternSize);
+    return EXIT_FAILURE;
+  }
+  if (i_maxOffsets == 0) {
+    (void)fprintf(stderr, "ERROR: No room for search results\n");
+    return EXIT_FAILURE;
+  }
+
+  size_t indexOffset = 0;
+  size_t blockCount = 0;
+  if (readTrailer(i_pInput, i_inputSize, &indexOffset, &blockCount) ==
+      EXIT_FAILURE) {
+    return EXIT_FAILURE;
+  }
+
+  sSearchResults_t sResults = {o_aOffsets, i_maxOffsets, 0, i_offset};
+  sSearchPattern_t sPattern;
+  sPattern.pBytes = i_pPattern;
+  sPattern.size = i_patternSize;
+  sSearchCarry_t sCarry;
+  sCarry.size = 0;
+  sCarry.isDecoded = true;
+
+  const size_t blocksEnd = indexOffset - 4;
+  size_t blockStart = 0;
+  for (size_t i = 0; i < blockCount && sResults.count < i_maxOffsets; i++) {
+    const uint64_t blockOffset =
+        readUint64(&i_pInput[indexOffset + (i * sizeof(uint64_t))]);
+    sBlockLayout_t sLayout;
+    if (blockOffset < HUFFMAN_HEADER_SIZE || blockOffset >= blocksEnd ||
+        readBlockLayout(&i_pInput[blockOffset], blocksEnd - blockOffset,
+                        &sLayout) == EXIT_FAILURE) {
+      (void)fprintf(stderr, "ERROR: Block index does not match blocks\n");
+      return EXIT_FAILURE;
+    }
+
+    /* Skip blocks that end before the search starts. */
+    const size_t blockEnd = blockStart + sLayout.outputSize;
+    if (blockEnd > i_offset) {
+      if (i_patternSize > 1 &&
+          searchBlockBoundary(io_psContext, &sLayout, blockStart, &sPattern,
+                              &sCarry, &sResults) == EXIT_FAILURE) {
+        return EXIT_FAILURE;
+      }
+      if (sResults.count == i_maxOffsets) {
+        break;
+      }
+
+      if (sLayout.isStored) {
+        (void)searchBytes(sLayout.pPayload, sLayout.outputSize, blockStart,
+                          &sPattern, &sResults);
+      } else if (searchCodedBlock(io_psContext, &sLayout, blockStart,
+                                  &sPattern, &sResults) == EXIT_FAILURE) {
+        return EXIT_FAILURE;
+      }
+    }
+    blockStart = blockEnd;
+  }
+
+  if (sResults.count < i_maxOffsets &&
+      blockStart != readUint64(&i_pInput[i_inputSize - HUFFMAN_TRAILER_SIZE])) {
+    (void)fprintf(stderr, "ERROR: Blocks do not match the container size\n");
+    return EXIT_FAILURE;
+  }
+
+  *o_pOffsetCount = sResults.count;
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Find the maximum size of a compressed batch.
+ *
+ * @param[in] i_bufferCount The number of buffers in the batch.
+ * @param[in] i_totalInputSize The total number of bytes in the buffers.
+ * @return size_t The output capacity that compressBatchWithContext never
+ * exceeds.
+ */
+size_t getBatchCompressBound(size_t i_bufferCount, size_t i_totalInputSize) {
+  /* Batches that would not shrink are stored, so never exceed their input. */
+  return HUFFMAN_BATCH_HEADER_SIZE + HUFFMAN_CODE_LENGTHS_SIZE +
+         (i_bufferCount * HUFFMAN_BATCH_ENTRY_SIZE) + i_totalInputSize;
+}
+
+/**
+ * @brief Compress many small buffers with one shared code table.
+ *
+ * This function builds a single histogram over every buffer and a single
+ * canonical code table from it, then codes the buffers back-to-back after
+ * the batch header and entries. The offset of each buffer's payload within
+ * the output is written to o_aOffsets, followed by the size of the output.
+ * It returns EXIT_FAILURE if a buffer is too large or the output is smaller
+ * than getBatchCompressBound.
+ *
+ * The table build and the per-call overhead are paid once per batch rather
+ * than once per buffer, at the cost of coding every buffer with the
+ * combined distribution.
+ *
+ * @param[inout] io_psContext The context.
+ * @param[in] i_apInputs The buffers to compress.
+ * @param[in] i_aInputSizes The number of bytes in each buffer.
+ * @param[in] i_bufferCount The number of buffers.
+ * @param[out] o_pOutput The buffer to write the batch to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @param[out] o_aOffsets The i_bufferCount + 1 payload offsets, or NULL.
+ * @param[out] o_pOutputSize The number of bytes written to the output.
+ * @return int EXIT_SUCCESS if the batch was compressed successfully, else
+ * EXIT_FAILURE.
+ */
+int compressBatchWithContext(sHuffmanContext_t* io_psContext,
+                             const uint8_t* const* i_apInputs,
+                             const size_t* i_aInputSizes, size_t i_bufferCount,
+                             uint8_t* o_pOutput, size_t i_outputCapacity,
+                             size_t* o_aOffsets, size_t* o_pOutputSize) {
+  if (i_bufferCount > HUFFMAN_MAX_BATCH_COUNT) {
+    (void)fprintf(stderr, "ERROR: Too many buffers in batch\n");
+    return EXIT_FAILURE;
+  }
+
+  /* Count the frequencies of every buffer into one histogram. */
+  HUFFMAN_STATS_BEGIN_STAGE(HUFFMAN_STAGE_HISTOGRAM);
+  size_t* aFrequencies = io_psContext->aFrequencies;
+  size_t totalInputSize = 0;
+  (void)memset(aFrequencies, 0, HUFFMAN_ALPHABET_SIZE * sizeof(size_t));
+  for (size_t i = 0; i < i_bufferCount; i++) {
+    if (i_aInputSizes[i] > HUFFMAN_MAX_BLOCK_SIZE) {
+      (void)fprintf(stderr, "ERROR: Batch buffer %zu is too large\n", i);
+      return EXIT_FAILURE;
+    }
+    for (size_t j = 0; j < i_aInputSizes[i]; j++) {
+      aFrequencies[i_apInputs[i][j]]++;
+    }
+    totalInputSize += i_aInputSizes[i];
+  }
+  HUFFMAN_STATS_END_STAGE(HUFFMAN_STAGE_HISTOGRAM, totalInputSize);
+
+  if (buildCodeTable(io_psContext) == EXIT_FAILURE) {
+    return EXIT_FAILURE;
+  }
+
+  /* Each payload is padded to a byte, so allow up to a byte per buffer. */
+  const size_t codedBound =
+      (size_t)((getCodedBits(io_psContext) + 7) / 8) + i_bufferCount;
+  const int isStored =
+      (HUFFMAN_CODE_LENGTHS_SIZE + codedBound >= totalInputSize);
+  const size_t entriesOffset =
+      HUFFMAN_BATCH_HEADER_SIZE + (isStored ? 0 : HUFFMAN_CODE_LENGTHS_SIZE);
+
+  if (i_outputCapacity < entriesOffset ||
+      i_bufferCount >
+          (i_outputCapacity - entriesOffset) / HUFFMAN_BATCH_ENTRY_SIZE ||
+      (isStored ? totalInputSize : codedBound) >
+          i_outputCapacity - entriesOffset -
+              (i_bufferCount * HUFFMAN_BATCH_ENTRY_SIZE)) {
+    (void)fprintf(stderr, "ERROR: Output buffer is too small\n");
+    return EXIT_FAILURE;
+  }
+
+  /* Write the batch header. */
+  (void)memcpy(o_pOutput, BATCH_MAGIC, sizeof(BATCH_MAGIC));
+  o_pOutput[4] = HUFFMAN_FORMAT_VERSION;
+  o_pOutput[5] = isStored ? HUFFMAN_BLOCK_FLAG_STORED : 0;
+  o_pOutput[6] = 0;
+  o_pOutput[7] = 0;
+  writeUint32(&o_pOutput[8], (uint32_t)i_bufferCount);
+  HUFFMAN_STATS_ADD(blocksEncoded, 1);
+  if (isStored) {
+    HUFFMAN_STATS_ADD(blocksStored, 1);
+  } else {
+    packCodeLengths(io_psContext->aCodeLengths,
+                    &o_pOutput[HUFFMAN_BATCH_HEADER_SIZE]);
+    HUFFMAN_STATS_CODE_LENGTHS(io_psContext->aCodeLengths);
+  }
+
+  /* Write each payload back-to-back, followed by its entry. */
+  size_t position = entriesOffset + (i_bufferCount * HUFFMAN_BATCH_ENTRY_SIZE);
+  for (size_t i = 0; i < i_bufferCount; i++) {
+    size_t payloadSize = i_aInputSizes[i];
+    if (!isStored) {
+      (void)encodePayload(&io_psContext->sCodeTable, i_apInputs[i],
+                          i_aInputSizes[i], 0, NULL, 1, SIZE_MAX,
+                          &o_pOutput[position], &payloadSize);
+    } else if (payloadSize > 0) {
+      /* Empty buffers may not have a data pointer to copy from. */
+      (void)memcpy(&o_pOutput[position], i_apInputs[i], payloadSize);
+    }
+
+    uint8_t* pEntry =
+        &o_pOutput[entriesOffset + (i * HUFFMAN_BATCH_ENTRY_SIZE)];
+    writeUint32(&pEntry[0], (uint32_t)i_aInputSizes[i]);
+    writeUint32(&pEntry[4], (uint32_t)payloadSize);
+    if (o_aOffsets != NULL) {
+      o_aOffsets[i] = position;
+    }
+    position += payloadSize;
+  }
+
+  if (o_aOffsets != NULL) {
+    o_aOffsets[i_bufferCount] = position;
+  }
+  *o_pOutputSize = position;
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Read the number of buffers and their total size from a batch.
+ *
+ * @param[in] i_pInput The batch.
+ * @param[in] i_inputSize The number of bytes in the batch.
+ * @param[out] o_pBufferCount The number of buffers in the batch.
+ * @param[out] o_pDecompressedSize The total uncompressed size.
+ * @return int EXIT_SUCCESS if the batch is valid, else EXIT_FAILURE.
+ */
+int getBatchInfo(const uint8_t* i_pInput, size_t i_inputSize,
+                 size_t* o_pBufferCount, size_t* o_pDecompressedSize) {
+  size_t entriesOffset = 0;
+
+  return readBatchHeader(i_pInput, i_inputSize, o_pBufferCount,
+                         &entriesOffset, o_pDecompressedSize);
+}
+
+/**
+ * @brief Decompress a batch of buffers back-to-back into one output.
+ *
+ * The shared code table is loaded once for the whole batch. The offset of
+ * each buffer within the output is written to o_aOffsets, followed by the
+ * total size, so buffer i occupies o_aOffsets[i] to o_aOffsets[i + 1].
+ *
+ * @param[inout] io_psContext The context.
+ * @param[in] i_pInput The batch.
+ * @param[in] i_inputSize The number of bytes in the batch.
+ * @param[out] o_pOutput The buffer to write the uncompressed bytes to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @param[out] o_aOffsets The buffer count + 1 output offsets, or NULL.
+ * @param[out] o_pOutputSize The number of bytes written to the output.
+ * @return int EXIT_SUCCESS if the batch was decompressed successfully, else
+ * EXIT_FAILURE.
+ */
+int decompressBatchWithContext(sHuffmanContext_t* io_psContext,
+                               const uint8_t* i_pInput, size_t i_inputSize,
+                               uint8_t* o_pOutput, size_t i_outputCapacity,
+                               size_t* o_aOffsets, size_t* o_pOutputSize) {
+  size_t bufferCount = 0;
+  size_t entriesOffset = 0;
+  size_t decompressedSize = 0;
+
+  if (readBatchHeader(i_pInput, i_inputSize, &bufferCount, &entriesOffset,
+                      &decompressedSize) == EXIT_FAILURE) {
+    return EXIT_FAILURE;
+  }
+
+  if (decompressedSize > i_outputCapacity) {
+    (void)fprintf(stderr, "ERROR: Output buffer is too small\n");
+    return EXIT_FAILURE;
+  }
+
+  const int isStored = (i_pInput[5] & HUFFMAN_BLOCK_FLAG_STORED) != 0;
+  if (!isStored &&
+      loadDecodeTables(io_psContext, &i_pInput[HUFFMAN_BATCH_HEADER_SIZE]) ==
+          EXIT_FAILURE) {
+    return EXIT_FAILURE;
+  }
+
+  size_t position = entriesOffset + (bufferCount * HUFFMAN_BATCH_ENTRY_SIZE);
+  size_t outputPosition = 0;
+  for (size_t i = 0; i < bufferCount; i++) {
+    const uint8_t* pEntry =
+        &i_pInput[entriesOffset + (i * HUFFMAN_BATCH_ENTRY_SIZE)];
+    const size_t outputSize = readUint32(&pEntry[0]);
+    const size_t payloadSize = readUint32(&pEntry[4]);
+
+    if (!isStored) {
+      if (decodePayload(io_psContext, &i_pInput[position], payloadSize,
+                        &o_pOutput[outputPosition], outputSize,
+                        NULL) == EXIT_FAILURE) {
+        return EXIT_FAILURE;
+      }
+    } else if (payloadSize > 0) {
+      (void)memcpy(&o_pOutput[outputPosition], &i_pInput[position],
+                   payloadSize);
+    }
+
+    if (o_aOffsets != NULL) {
+      o_aOffsets[i] = outputPosition;
+    }
+    position += payloadSize;
+    outputPosition += outputSize;
+  }
+
+  HUFFMAN_STATS_ADD(blocksDecoded, 1);
+
+  if (o_aOffsets != NULL) {
+    o_aOffsets[bufferCount] = outputPosition;
+  }
+  *o_pOutputSize = outputPosition;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,525 @@
+/**
+ * @file codec.h
+ * @brief Compress and decompress buffers with block-wise Huffman coding.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ * The compressed container is laid out as follows, with every integer stored
+ * little-endian:
+ *
+ *   header   "HUFF", uint8 version, uint8 flags, uint16 reserved
+ *   block*   uint32 uncompressed size (non-zero), uint32 payload size,
+ *            uint8 block flags, [128 bytes of 4-bit code lengths],
+ *            [uint32 sync point count, sync point*], payload,
+ *            [uint32 CRC32C of the uncompressed bytes]
+ *   end      uint32 0
+ *   index    uint64 offset of each block
+ *   trailer  uint64 total uncompressed size, uint32 block count, "HUFX"
+ *
+ * Each block is coded independently with its own canonical code table, or
+ * stored as-is when coding would not make it smaller. Coded blocks may list
+ * sync points, each a uint32 uncompressed offset into the block followed by
+ * the uint64 bit offset into the payload of the code for that byte, so that
+ * decoding can start part way through the block. Blocks compressed with
+ * checksums enabled end with the CRC32C of their uncompressed bytes, which
+ * is verified when the whole block is decompressed. The code table of a
+ * large block may be built from a sample of its bytes, as in sampling.h,
+ * without changing the format.
+ *
+ * A batch of small buffers shares a single code table instead:
+ *
+ *   header   "HUFB", uint8 version, uint8 flags, uint16 reserved,
+ *            uint32 buffer count, [128 bytes of 4-bit code lengths]
+ *   entry*   uint32 uncompressed size, uint32 payload size
+ *   payload* each buffer's codes, starting on a byte boundary
+ *
+ * The batch is stored as-is, without code lengths, when the shared table
+ * would not make it smaller.
+ */
+
+#ifndef CODEC_H
+#define CODEC_H
+
+/* Standard Library Includes */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Project Includes */
+
+#include "huffmanCoding/allocator.h"
+#include "huffmanCoding/huffmanTree.h"
+
+/* Constants */
+
+/**< The default number of uncompressed bytes in a block. */
+#define HUFFMAN_DEFAULT_BLOCK_SIZE ((size_t)256 * 1024)
+
+/**< The maximum number of uncompressed bytes in a block. */
+#define HUFFMAN_MAX_BLOCK_SIZE ((size_t)1 << 30)
+
+/**< Inputs of at most this many uncompressed bytes never allocate. */
+#define HUFFMAN_SMALL_INPUT_SIZE ((size_t)4 * 1024)
+
+/**< The container format version. */
+#define HUFFMAN_FORMAT_VERSION 1
+
+/**< The number of bytes in the container header. */
+#define HUFFMAN_HEADER_SIZE 8
+
+/**< The number of bytes in a block header, excluding the code lengths. */
+#define HUFFMAN_BLOCK_HEADER_SIZE 9
+
+/**< The number of bytes of packed 4-bit code lengths in a block header. */
+#define HUFFMAN_CODE_LENGTHS_SIZE (HUFFMAN_ALPHABET_SIZE / 2)
+
+/**< The number of bytes in the trailer, excluding the block index. */
+#define HUFFMAN_TRAILER_SIZE 16
+
+/**< Block flag set when the payload is the uncompressed data. */
+#define HUFFMAN_BLOCK_FLAG_STORED 0x01U
+
+/**< Block flag set when a coded block lists sync points. */
+#define HUFFMAN_BLOCK_FLAG_SYNC_POINTS 0x02U
+
+/**< Block flag set when a block ends with a checksum. */
+#define HUFFMAN_BLOCK_FLAG_CHECKSUM 0x04U
+
+/**< The number of bytes in a block checksum. */
+#define HUFFMAN_CHECKSUM_SIZE 4
+
+/**< The number of bytes in each sync point. */
+#define HUFFMAN_SYNC_POINT_SIZE 12
+
+/**< The number of bytes in a batch header, excluding the code lengths. */
+#define HUFFMAN_BATCH_HEADER_SIZE 12
+
+/**< The number of bytes in each entry of a batch. */
+#define HUFFMAN_BATCH_ENTRY_SIZE 8
+
+/**< The maximum number of bytes in a search pattern. */
+#define HUFFMAN_MAX_SEARCH_PATTERN_SIZE 256
+
+/**< The maximum number of buffers in a batch. */
+#define HUFFMAN_MAX_BATCH_COUNT ((size_t)UINT32_MAX)
+
+/* Type Definitions */
+
+/**
+ * @brief Options that control compression.
+ */
+typedef struct sHuffmanCompressOptions {
+  size_t blockSize;
+  size_t syncInterval; /**< Bytes between sync points, 0 for none. */
+  size_t threadCount;  /**< Threads coding each block, 0 or 1 for one. */
+  const sHuffmanAllocator_t* psAllocator; /**< NULL for the default. */
+  bool isChecksumEnabled; /**< Whether blocks end with a CRC32C. */
+  size_t sampleInterval;  /**< Sample 1 run in this many, 0 or 1 for all. */
+} sHuffmanCompressOptions_t;
+
+/**
+ * @brief Opaque, reusable scratch memory for compression and decompression.
+ *
+ * A context must not be used by more than one thread at a time.
+ */
+typedef struct sHuffmanContext sHuffmanContext_t;
+
+/* Function Prototypes */
+
+/**
+ * @brief Initialise compression options to their defaults.
+ *
+ * @param[out] o_psOptions The options to initialise.
+ */
+extern void initCompressOptions(sHuffmanCompressOptions_t* o_psOptions);
+
+/**
+ * @brief Find the maximum compressed size of an input.
+ *
+ * @param[in] i_inputSize The number of bytes to compress.
+ * @param[in] i_psOptions The compression options, or NULL for the defaults.
+ * @return size_t The output capacity that compressBuffer never exceeds.
+ */
+extern size_t getCompressBound(size_t i_inputSize,
+                               const sHuffmanCompressOptions_t* i_psOptions);
+
+/**
+ * @brief Compress a buffer into a Huffman container.
+ *
+ * This function splits the input into blocks, builds a canonical Huffman code
+ * table for each block from its byte frequencies, and writes the coded blocks
+ * followed by the block index. It returns EXIT_FAILURE if the options are
+ * invalid, the output is too small or memory cannot be allocated.
+ *
+ * @param[in] i_pInput The bytes to compress.
+ * @param[in] i_inputSize The number of bytes to compress.
+ * @param[out] o_pOutput The buffer to write the container to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @param[out] o_pOutputSize The number of bytes written to the output.
+ * @param[in] i_psOptions The compression options, or NULL for the defaults.
+ * @return int EXIT_SUCCESS if the input was compressed successfully, else
+ * EXIT_FAILURE.
+ */
+extern int compressBuffer(const uint8_t* i_pInput, size_t i_inputSize,
+                          uint8_t* o_pOutput, size_t i_outputCapacity,
+                          size_t* o_pOutputSize,
+                          const sHuffmanCompressOptions_t* i_psOptions);
+
+/**
+ * @brief Find the maximum size of a container after appending an input.
+ *
+ * @param[in] i_containerSize The number of bytes in the container.
+ * @param[in] i_inputSize The number of bytes to append.
+ * @param[in] i_psOptions The compression options, or NULL for the defaults.
+ * @return size_t The container capacity that appendBuffer never exceeds.
+ */
+extern size_t getAppendBound(size_t i_containerSize, size_t i_inputSize,
+                             const sHuffmanCompressOptions_t* i_psOptions);
+
+/**
+ * @brief Append an input to a Huffman container in place.
+ *
+ * This function compresses the input into new blocks written over the end
+ * marker, block index and trailer, then rewrites them after the new blocks.
+ * The existing blocks are not decoded or recompressed, and a new block reuses
+ * the code lengths of the block before it when they cost at most 1/64 more.
+ * It returns EXIT_FAILURE, leaving the container unchanged, if the options or
+ * the container are invalid, the capacity is too small or memory cannot be
+ * allocated.
+ *
+ * @param[inout] io_pContainer The container to append to.
+ * @param[in] i_containerSize The number of bytes in the container.
+ * @param[in] i_containerCapacity The number of bytes available for the
+ * container, at most getAppendBound.
+ * @param[in] i_pInput The bytes to append.
+ * @param[in] i_inputSize The number of bytes to append.
+ * @param[out] o_pContainerSize The number of bytes in the container after
+ * appending.
+ * @param[in] i_psOptions The compression options, or NULL for the defaults.
+ * @return int EXIT_SUCCESS if the input was appended successfully, else
+ * EXIT_FAILURE.
+ */
+extern int appendBuffer(uint8_t* io_pContainer, size_t i_containerSize,
+                        size_t i_containerCapacity, const uint8_t* i_pInput,
+                        size_t i_inputSize, size_t* o_pContainerSize,
+                        const sHuffmanCompressOptions_t* i_psOptions);
+
+/**
+ * @brief Read the uncompressed size of a Huffman container.
+ *
+ * @param[in] i_pInput The container.
+ * @param[in] i_inputSize The number of bytes in the container.
+ * @param[out] o_pDecompressedSize The total uncompressed size.
+ * @return int EXIT_SUCCESS if the size was read successfully, else
+ * EXIT_FAILURE.
+ */
+extern int getDecompressedSize(const uint8_t* i_pInput, size_t i_inputSize,
+                               size_t* o_pDecompressedSize);
+
+/**
+ * @brief Decompress a Huffman container into a buffer.
+ *
+ * This function decodes each block in turn, verifying any block checksums.
+ * It returns EXIT_FAILURE if the container is malformed, a checksum does not
+ * match or the output is too small.
+ *
+ * @param[in] i_pInput The container.
+ * @param[in] i_inputSize The number of bytes in the container.
+ * @param[out] o_pOutput The buffer to write the uncompressed bytes to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @param[out] o_pOutputSize The number of bytes written to the output.
+ * @return int EXIT_SUCCESS if the container was decompressed successfully,
+ * else EXIT_FAILURE.
+ */
+extern int decompressBuffer(const uint8_t* i_pInput, size_t i_inputSize,
+                            uint8_t* o_pOutput, size_t i_outputCapacity,
+                            size_t* o_pOutputSize);
+
+/**
+ * @brief Decompress a range of bytes from a Huffman container.
+ *
+ * This function finds the block holding the start of the range from the
+ * block index, and starts decoding from the last sync point at or before
+ * it rather than from the start of the block. Block checksums are not
+ * verified, as they cover whole blocks. It returns EXIT_FAILURE if the
+ * container is malformed or the range extends past its end.
+ *
+ * @param[in] i_pInput The container.
+ * @param[in] i_inputSize The number of bytes in the container.
+ * @param[in] i_offset The uncompressed offset of the first byte to decode.
+ * @param[in] i_length The number of bytes to decode.
+ * @param[out] o_pOutput The buffer to write the i_length bytes to.
+ * @return int EXIT_SUCCESS if the range was decompressed successfully, else
+ * EXIT_FAILURE.
+ */
+extern int decompressRange(const uint8_t* i_pInput, size_t i_inputSize,
+                           size_t i_offset, size_t i_length,
+                           uint8_t* o_pOutput);
+
+/**
+ * @brief Find the uncompressed offsets of a pattern in a Huffman container.
+ *
+ * Each coded block is searched for the bits of the pattern's codes in that
+ * block's code table, without decoding it. Only the codes from the last sync
+ * point before each candidate are decoded, to check a code starts at it and
+ * to find its offset, so blocks with sync points are searched much faster
+ * than they decode. Matches spanning blocks are found by decoding the ends
+ * of the blocks. The offsets are found in ascending order, from i_offset on,
+ * until i_maxOffsets have been found.
+ *
+ * @param[in] i_pInput The container.
+ * @param[in] i_inputSize The number of bytes in the container.
+ * @param[in] i_pPattern The bytes to search for.
+ * @param[in] i_patternSize The number of bytes in the pattern, from 1 to
+ * HUFFMAN_MAX_SEARCH_PATTERN_SIZE.
+ * @param[in] i_offset The uncompressed offset to search from.
+ * @param[out] o_aOffsets The buffer to write the offsets of matches to.
+ * @param[in] i_maxOffsets The number of offsets available in the buffer.
+ * @param[out] o_pOffsetCount The number of offsets written to the buffer.
+ * @return int EXIT_SUCCESS if the container was searched successfully, else
+ * EXIT_FAILURE.
+ */
+extern int searchContainer(const uint8_t* i_pInput, size_t i_inputSize,
+                           const uint8_t* i_pPattern, size_t i_patternSize,
+                           size_t i_offset, size_t* o_aOffsets,
+                           size_t i_maxOffsets, size_t* o_pOffsetCount);
+
+/**
+ * @brief Decompress a Huffman container into a buffer with the given
+ * allocator.
+ *
+ * @deprecated Decompressing no longer allocates, as long codes are decoded
+ * with a nibble tree in the context on the stack, so the allocator is
+ * ignored. Use decompressBuffer instead.
+ *
+ * @param[in] i_pInput The container.
+ * @param[in] i_inputSize The number of bytes in the container.
+ * @param[out] o_pOutput The buffer to write the uncompressed bytes to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @param[out] o_pOutputSize The number of bytes written to the output.
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ * @return int EXIT_SUCCESS if the container was decompressed successfully,
+ * else EXIT_FAILURE.
+ */
+extern int decompressBufferWithAllocator(
+    const uint8_t* i_pInput, size_t i_inputSize, uint8_t* o_pOutput,
+    size_t i_outputCapacity, size_t* o_pOutputSize,
+    const sHuffmanAllocator_t* i_psAllocator);
+
+/**
+ * @brief Decompress a Huffman container into a buffer, decoding each block
+ * with several threads.
+ *
+ * Blocks without sync points are split between the threads, which guess
+ * where codes start and synchronise with each other. The output is identical
+ * to decompressBuffer's, which a block is decoded with instead if the threads
+ * fail to synchronise.
+ *
+ * @param[in] i_pInput The container.
+ * @param[in] i_inputSize The number of bytes in the container.
+ * @param[out] o_pOutput The buffer to write the uncompressed bytes to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @param[out] o_pOutputSize The number of bytes written to the output.
+ * @param[in] i_threadCount The number of threads to decode each block with.
+ * @return int EXIT_SUCCESS if the container was decompressed successfully,
+ * else EXIT_FAILURE.
+ */
+extern int decompressBufferWithThreads(const uint8_t* i_pInput,
+                                       size_t i_inputSize, uint8_t* o_pOutput,
+                                       size_t i_outputCapacity,
+                                       size_t* o_pOutputSize,
+                                       size_t i_threadCount);
+
+/**
+ * @brief Create a reusable compression and decompression context.
+ *
+ * The context owns all the scratch memory needed to compress or decompress a
+ * block and is allocated once, here. Compressing or decompressing with the
+ * context never allocates.
+ *
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ * @return sHuffmanContext_t* The context, else NULL.
+ */
+extern sHuffmanContext_t* createHuffmanContext(
+    const sHuffmanAllocator_t* i_psAllocator);
+
+/**
+ * @brief Free a context created by createHuffmanContext.
+ *
+ * @param[inout] io_psContext The context to free, or NULL.
+ */
+extern void freeHuffmanContext(sHuffmanContext_t* io_psContext);
+
+/**
+ * @brief Discard any state a context has cached from previous calls.
+ *
+ * Only the cached decode table is invalidated, so resetting costs the same
+ * regardless of how much scratch memory the context owns.
+ *
+ * @param[inout] io_psContext The context to reset.
+ */
+extern void resetHuffmanContext(sHuffmanContext_t* io_psContext);
+
+/**
+ * @brief Compress a buffer into a Huffman container using a context.
+ *
+ * The output is identical to compressBuffer's. The allocator in the options
+ * is ignored, as the context does not allocate.
+ *
+ * @param[inout] io_psContext The context.
+ * @param[in] i_pInput The bytes to compress.
+ * @param[in] i_inputSize The number of bytes to compress.
+ * @param[out] o_pOutput The buffer to write the container to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @param[out] o_pOutputSize The number of bytes written to the output.
+ * @param[in] i_psOptions The compression options, or NULL for the defaults.
+ * @return int EXIT_SUCCESS if the input was compressed successfully, else
+ * EXIT_FAILURE.
+ */
+extern int compressBufferWithContext(
+    sHuffmanContext_t* io_psContext, const uint8_t* i_pInput,
+    size_t i_inputSize, uint8_t* o_pOutput, size_t i_outputCapacity,
+    size_t* o_pOutputSize, const sHuffmanCompressOptions_t* i_psOptions);
+
+/**
+ * @brief Decompress a Huffman container into a buffer using a context.
+ *
+ * The decode table is kept between blocks and calls, and is only rebuilt
+ * when a block's code lengths differ from those it was built from.
+ *
+ * @param[inout] io_psContext The context.
+ * @param[in] i_pInput The container.
+ * @param[in] i_inputSize The number of bytes in the container.
+ * @param[out] o_pOutput The buffer to write the uncompressed bytes to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @param[out] o_pOutputSize The number of bytes written to the output.
+ * @return int EXIT_SUCCESS if the container was decompressed successfully,
+ * else EXIT_FAILURE.
+ */
+extern int decompressBufferWithContext(sHuffmanContext_t* io_psContext,
+                                       const uint8_t* i_pInput,
+                                       size_t i_inputSize, uint8_t* o_pOutput,
+                                       size_t i_outputCapacity,
+                                       size_t* o_pOutputSize);
+
+/**
+ * @brief Decompress a range of bytes from a Huffman container using a
+ * context.
+ *
+ * @param[inout] io_psContext The context.
+ * @param[in] i_pInput The container.
+ * @param[in] i_inputSize The number of bytes in the container.
+ * @param[in] i_offset The uncompressed offset of the first byte to decode.
+ * @param[in] i_length The number of bytes to decode.
+ * @param[out] o_pOutput The buffer to write the i_length bytes to.
+ * @return int EXIT_SUCCESS if the range was decompressed successfully, else
+ * EXIT_FAILURE.
+ */
+extern int decompressRangeWithContext(sHuffmanContext_t* io_psContext,
+                                      const uint8_t* i_pInput,
+                                      size_t i_inputSize, size_t i_offset,
+                                      size_t i_length, uint8_t* o_pOutput);
+
+/**
+ * @brief Find the uncompressed offsets of a pattern in a Huffman container
+ * using a context.
+ *
+ * The offsets are identical to searchContainer's.
+ *
+ * @param[inout] io_psContext The context.
+ * @param[in] i_pInput The container.
+ * @param[in] i_inputSize The number of bytes in the container.
+ * @param[in] i_pPattern The bytes to search for.
+ * @param[in] i_patternSize The number of bytes in the pattern, from 1 to
+ * HUFFMAN_MAX_SEARCH_PATTERN_SIZE.
+ * @param[in] i_offset The uncompressed offset to search from.
+ * @param[out] o_aOffsets The buffer to write the offsets of matches to.
+ * @param[in] i_maxOffsets The number of offsets available in the buffer.
+ * @param[out] o_pOffsetCount The number of offsets written to the buffer.
+ * @return int EXIT_SUCCESS if the container was searched successfully, else
+ * EXIT_FAILURE.
+ */
+extern int searchContainerWithContext(
+    sHuffmanContext_t* io_psContext, const uint8_t* i_pInput,
+    size_t i_inputSize, const uint8_t* i_pPattern, size_t i_patternSize,
+    size_t i_offset, size_t* o_aOffsets, size_t i_maxOffsets,
+    size_t* o_pOffsetCount);
+
+/**
+ * @brief Find the maximum size of a compressed batch.
+ *
+ * @param[in] i_bufferCount The number of buffers in the batch.
+ * @param[in] i_totalInputSize The total number of bytes in the buffers.
+ * @return size_t The output capacity that compressBatchWithContext never
+ * exceeds.
+ */
+extern size_t getBatchCompressBound(size_t i_bufferCount,
+                                    size_t i_totalInputSize);
+
+/**
+ * @brief Compress many small buffers with one shared code table.
+ *
+ * This function builds a single histogram over every buffer and a single
+ * canonical code table from it, then codes the buffers back-to-back after
+ * the batch header and entries. The offset of each buffer's payload within
+ * the output is written to o_aOffsets, followed by the size of the output.
+ * It returns EXIT_FAILURE if a buffer is too large or the output is smaller
+ * than getBatchCompressBound.
+ *
+ * @param[inout] io_psContext The context.
+ * @param[in] i_apInputs The buffers to compress.
+ * @param[in] i_aInputSizes The number of bytes in each buffer.
+ * @param[in] i_bufferCount The number of buffers.
+ * @param[out] o_pOutput The buffer to write the batch to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @param[out] o_aOffsets The i_bufferCount + 1 payload offsets, or NULL.
+ * @param[out] o_pOutputSize The number of bytes written to the output.
+ * @return int EXIT_SUCCESS if the batch was compressed successfully, else
+ * EXIT_FAILURE.
+ */
+extern int compressBatchWithContext(sHuffmanContext_t* io_psContext,
+                                    const uint8_t* const* i_apInputs,
+                                    const size_t* i_aInputSizes,
+                                    size_t i_bufferCount, uint8_t* o_pOutput,
+                                    size_t i_outputCapacity, size_t* o_aOffsets,
+                                    size_t* o_pOutputSize);
+
+/**
+ * @brief Read the number of buffers and their total size from a batch.
+ *
+ * @param[in] i_pInput The batch.
+ * @param[in] i_inputSize The number of bytes in the batch.
+ * @param[out] o_pBufferCount The number of buffers in the batch.
+ * @param[out] o_pDecompressedSize The total uncompressed size.
+ * @return int EXIT_SUCCESS if the batch is valid, else EXIT_FAILURE.
+ */
+extern int getBatchInfo(const uint8_t* i_pInput, size_t i_inputSize,
+                        size_t* o_pBufferCount, size_t* o_pDecompressedSize);
+
+/**
+ * @brief Decompress a batch of buffers back-to-back into one output.
+ *
+ * The shared code table is loaded once for the whole batch. The offset of
+ * each buffer within the output is written to o_aOffsets, followed by the
+ * total size, so buffer i occupies o_aOffsets[i] to o_aOffsets[i + 1].
+ *
+ * @param[inout] io_psContext The context.
+ * @param[in] i_pInput The batch.
+ * @param[in] i_inputSize The number of bytes in the batch.
+ * @param[out] o_pOutput The buffer to write the uncompressed bytes to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @param[out] o_aOffsets The buffer count + 1 output offsets, or NULL.
+ * @param[out] o_pOutputSize The number of bytes written to the output.
+ * @return int EXIT_SUCCESS if the batch was decompressed successfully, else
+ * EXIT_FAILURE.
+ */
+extern int decompressBatchWithContext(sHuffmanContext_t* io_psContext,
+                                      const uint8_t* i_pInput,
+                                      size_t i_inputSize, uint8_t* o_pOutput,
+                                      size_t i_outputCapacity,
+                                      size_t* o_aOffsets,
+                                      size_t* o_pOutputSize);
+
+#endif  // CODEC_H
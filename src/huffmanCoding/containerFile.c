@@ -0,0 +1,152 @@
+/**
+ * @file containerFile.c
+ * @brief Append to and search Huffman container files in place.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+/* Standard Library Includes */
+
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+/* Project Includes */
+
+#include "huffmanCoding/codec.h"
+#include "huffmanCoding/containerFile.h"
+
+/* Function Definitions */
+
+/**
+ * @brief Append bytes to a Huffman container file.
+ *
+ * The file is created if it does not exist, and an empty file is treated as
+ * an empty container. It is left unchanged if appending fails.
+ *
+ * @param[in] i_pPath The path of the container file.
+ * @param[in] i_pInput The bytes to append.
+ * @param[in] i_inputSize The number of bytes to append.
+ * @param[in] i_psOptions The compression options, or NULL for the defaults.
+ * @return int EXIT_SUCCESS if the bytes were appended, else EXIT_FAILURE.
+ */
+int appendToContainerFile(const char* i_pPath, const uint8_t* i_pInput,
+                          size_t i_inputSize,
+                          const sHuffmanCompressOptions_t* i_psOptions) {
+  const int file = open(i_pPath, O_RDWR | O_CREAT, 0644);
+  if (file < 0) {
+    perror(i_pPath);
+    return EXIT_FAILURE;
+  }
+
+  struct stat sStat;
+  if (fstat(file, &sStat) != 0) {
+    perror(i_pPath);
+    (void)close(file);
+    return EXIT_FAILURE;
+  }
+
+  /* Grow the file to the bound, so the new blocks are written in place. */
+  const size_t containerSize = (size_t)sStat.st_size;
+  const size_t capacity =
+      (containerSize == 0)
+          ? getCompressBound(i_inputSize, i_psOptions)
+          : getAppendBound(containerSize, i_inputSize, i_psOptions);
+  if (ftruncate(file, (off_t)capacity) != 0) {
+    perror(i_pPath);
+    (void)close(file);
+    return EXIT_FAILURE;
+  }
+
+  /* Only the pages of the last block, the index and the new blocks are
+   * touched through the mapping. */
+  uint8_t* pContainer = (uint8_t*)mmap(NULL, capacity, PROT_READ | PROT_WRITE,
+                                       MAP_SHARED, file, 0);
+  int result = EXIT_FAILURE;
+  size_t newSize = containerSize;
+  if (pContainer == MAP_FAILED) {
+    perror(i_pPath);
+  } else {
+    result = (containerSize == 0)
+                 ? compressBuffer(i_pInput, i_inputSize, pContainer, capacity,
+                                  &newSize, i_psOptions)
+                 : appendBuffer(pContainer, containerSize, capacity, i_pInput,
+                                i_inputSize, &newSize, i_psOptions);
+    if (result == EXIT_FAILURE) {
+      newSize = containerSize;
+    }
+    (void)munmap(pContainer, capacity);
+  }
+
+  if (ftruncate(file, (off_t)newSize) != 0) {
+    perror(i_pPath);
+    result = EXIT_FAILURE;
+  }
+  if (close(file) != 0) {
+    perror(i_pPath);
+    result = EXIT_FAILURE;
+  }
+  return result;
+}
+
+/**
+ * @brief Find the uncompressed offsets of a pattern in a Huffman container
+ * file.
+ *
+ * @param[in] i_pPath The path of the container file.
+ * @param[in] i_pPattern The bytes to search for.
+ * @param[in] i_patternSize The number of bytes in the pattern.
+ * @param[in] i_offset The uncompressed offset to search from.
+ * @param[out] o_aOffsets The buffer to write the offsets of matches to.
+ * @param[in] i_maxOffsets The number of offsets available in the buffer.
+ * @param[out] o_pOffsetCount The number of offsets written to the buffer.
+ * @return int EXIT_SUCCESS if the file was searched successfully, else
+ * EXIT_FAILURE.
+ */
+int searchContainerFile(const char* i_pPath, const uint8_t* i_pPattern,
+                        size_t i_patternSize, size_t i_offset,
+                        size_t* o_aOffsets, size_t i_maxOffsets,
+                        size_t* o_pOffsetCount) {
+  const int file = open(i_pPath, O_RDONLY);
+  if (file < 0) {
+    perror(i_pPath);
+    return EXIT_FAILURE;
+  }
+
+  struct stat sStat;
+  if (fstat(file, &sStat) != 0) {
+    perror(i_pPath);
+    (void)close(file);
+    return EXIT_FAILURE;
+  }
+  const size_t containerSize = (size_t)sStat.st_size;
+  if (containerSize == 0) {
+    (void)fprintf(stderr, "ERROR: Not a Huffman container\n");
+    (void)close(file);
+    return EXIT_FAILURE;
+  }
+
+  const uint8_t* pContainer = (const uint8_t*)mmap(
+      NULL, containerSize, PROT_READ, MAP_PRIVATE, file, 0);
+  (void)close(file);
+  if (pContainer == MAP_FAILED) {
+    perror(i_pPath);
+    return EXIT_FAILURE;
+  }
+
+  const int result =
+      searchContainer(pContainer, containerSize, i_pPattern, i_patternSize,
+                      i_offset, o_aOffsets, i_maxOffsets, o_pOffsetCount);
+  (void)munmap((void*)pContainer, containerSize);
+  return result;
+}
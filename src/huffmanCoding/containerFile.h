@@ -0,0 +1,63 @@
+/**
+ * @file containerFile.h
+ * @brief Append to and search Huffman container files in place.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ * Appending maps the file, compresses the new data into blocks after the
+ * existing ones and rewrites the block index and trailer, so its cost depends
+ * on the new data rather than the size of the file. Searching maps the file
+ * read-only, so only the pages of the blocks that are searched are read.
+ */
+
+#ifndef CONTAINER_FILE_H
+#define CONTAINER_FILE_H
+
+/* Standard Library Includes */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Project Includes */
+
+#include "huffmanCoding/codec.h"
+
+/* Function Prototypes */
+
+/**
+ * @brief Append bytes to a Huffman container file.
+ *
+ * The file is created if it does not exist, and an empty file is treated as
+ * an empty container. It is left unchanged if appending fails.
+ *
+ * @param[in] i_pPath The path of the container file.
+ * @param[in] i_pInput The bytes to append.
+ * @param[in] i_inputSize The number of bytes to append.
+ * @param[in] i_psOptions The compression options, or NULL for the defaults.
+ * @return int EXIT_SUCCESS if the bytes were appended, else EXIT_FAILURE.
+ */
+extern int appendToContainerFile(const char* i_pPath, const uint8_t* i_pInput,
+                                 size_t i_inputSize,
+                                 const sHuffmanCompressOptions_t* i_psOptions);
+
+/**
+ * @brief Find the uncompressed offsets of a pattern in a Huffman container
+ * file.
+ *
+ * @param[in] i_pPath The path of the container file.
+ * @param[in] i_pPattern The bytes to search for.
+ * @param[in] i_patternSize The number of bytes in the pattern.
+ * @param[in] i_offset The uncompressed offset to search from.
+ * @param[out] o_aOffsets The buffer to write the offsets of matches to.
+ * @param[in] i_maxOffsets The number of offsets available in the buffer.
+ * @param[out] o_pOffsetCount The number of offsets written to the buffer.
+ * @return int EXIT_SUCCESS if the file was searched successfully, else
+ * EXIT_FAILURE.
+ */
+extern int searchContainerFile(const char* i_pPath, const uint8_t* i_pPattern,
+                               size_t i_patternSize, size_t i_offset,
+                               size_t* o_aOffsets, size_t i_maxOffsets,
+                               size_t* o_pOffsetCount);
+
+#endif  // CONTAINER_FILE_H
@@ -0,0 +1,899 @@
+/**
+ * @file daemon.c
+ * @brief Serve compression requests over a Unix domain socket.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+/* Standard Library Includes */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/* Project Includes */
+
+#include "huffmanCoding/allocator.h"
+#include "huffmanCoding/bitStream.h"
+#include "huffmanCoding/codec.h"
+#include "huffmanCoding/daemon.h"
+
+/* Constants */
+
+/**< The most events handled by each wait of the event loop. */
+#define EVENT_BATCH_SIZE 64
+
+/**< The length of the queue of connections waiting to be accepted. */
+#define LISTEN_BACKLOG 128
+
+/**< The first capacity of a request buffer, doubled as the payload arrives. */
+#define REQUEST_CHUNK_SIZE ((size_t)64 << 10)
+
+/* Type Definitions */
+
+/**
+ * @brief A client connection and its current request.
+ *
+ * A connection is either reading a request, queued for or being served by a
+ * worker, or writing a response. It is only watched by the event loop while
+ * reading or writing, so a worker is the only thread that touches it while
+ * it is being served. Its buffers are kept between requests.
+ */
+typedef struct sDaemonConnection {
+  int socket;
+  uint8_t aHeader[HUFFMAN_DAEMON_HEADER_SIZE];
+  size_t received; /**< The bytes of the request read so far. */
+  uint32_t operation;
+  uint8_t* pRequest;
+  size_t requestSize;
+  size_t requestCapacity;
+  uint8_t* pResponse; /**< The response, starting at its header. */
+  size_t responseSize;
+  size_t responseCapacity;
+  size_t sent; /**< The bytes of the response written so far. */
+  struct sDaemonConnection* psPrevious;
+  struct sDaemonConnection* psNext;
+  struct sDaemonConnection* psNextQueued; /**< In a work or done queue. */
+} sDaemonConnection_t;
+
+/**
+ * @brief A worker thread and the context it serves requests with.
+ */
+typedef struct sDaemonWorker {
+  struct sHuffmanDaemon* psDaemon;
+  sHuffmanContext_t* psContext;
+  pthread_t thread;
+  bool isThreadStarted;
+} sDaemonWorker_t;
+
+/**
+ * @brief A queue of connections, oldest first.
+ */
+typedef struct sConnectionQueue {
+  sDaemonConnection_t* psHead;
+  sDaemonConnection_t* psTail;
+} sConnectionQueue_t;
+
+struct sHuffmanDaemon {
+  char aSocketPath[sizeof(((struct sockaddr_un*)NULL)->sun_path)];
+  int listenSocket;
+  int epoll;
+  int wakeEvent; /**< Signalled when a request is served or on stopping. */
+  atomic_bool isStopping; /**< Lock-free, so safe in a signal handler. */
+  pthread_mutex_t mutex;
+  pthread_cond_t queued;
+  sConnectionQueue_t sWorkQueue; /**< Requests waiting for a worker. */
+  sConnectionQueue_t sDoneQueue; /**< Responses waiting to be written. */
+  bool isWorkerStopping;         /**< Guarded by the mutex. */
+  sDaemonConnection_t* psConnections;
+  size_t connectionCount;
+  size_t maxConnections;
+  size_t workerCount;
+  sDaemonWorker_t asWorkers[HUFFMAN_DAEMON_MAX_WORKERS];
+};
+
+/* Function Prototypes */
+
+/**
+ * @brief Add a connection to the back of a queue.
+ *
+ * @param[inout] io_psQueue The queue.
+ * @param[inout] io_psConnection The connection.
+ */
+static void pushConnection(sConnectionQueue_t* io_psQueue,
+                           sDaemonConnection_t* io_psConnection);
+
+/**
+ * @brief Remove the connection at the front of a queue.
+ *
+ * @param[inout] io_psQueue The queue.
+ * @return sDaemonConnection_t* The connection, or NULL if the queue is empty.
+ */
+static sDaemonConnection_t* popConnection(sConnectionQueue_t* io_psQueue);
+
+/**
+ * @brief Make sure a buffer can hold a number of bytes.
+ *
+ * @param[inout] io_ppBuffer The buffer, replaced if it is too small.
+ * @param[inout] io_pCapacity The capacity of the buffer.
+ * @param[in] i_size The number of bytes needed.
+ * @return int EXIT_SUCCESS if the buffer is large enough, else EXIT_FAILURE.
+ */
+static int reserveBuffer(uint8_t** io_ppBuffer, size_t* io_pCapacity,
+                         size_t i_size);
+
+/**
+ * @brief Grow a buffer, keeping the bytes it already holds.
+ *
+ * @param[inout] io_ppBuffer The buffer, replaced by a larger one.
+ * @param[inout] io_pCapacity The capacity of the buffer.
+ * @param[in] i_used The number of bytes to keep.
+ * @param[in] i_size The number of bytes needed, more than the capacity.
+ * @return int EXIT_SUCCESS if the buffer was grown, else EXIT_FAILURE.
+ */
+static int growBuffer(uint8_t** io_ppBuffer, size_t* io_pCapacity,
+                      size_t i_used, size_t i_size);
+
+/**
+ * @brief Serve a connection's request with a worker's context.
+ *
+ * @param[inout] io_psWorker The worker.
+ * @param[inout] io_psConnection The connection holding a whole request.
+ */
+static void serveRequest(sDaemonWorker_t* io_psWorker,
+                         sDaemonConnection_t* io_psConnection);
+
+/**
+ * @brief Serve requests from the work queue until the daemon stops.
+ *
+ * @param[inout] io_pWorker The worker, an sDaemonWorker_t.
+ * @return void* NULL.
+ */
+static void* runWorker(void* io_pWorker);
+
+/**
+ * @brief Watch a connection for events, or stop watching it.
+ *
+ * @param[inout] io_psDaemon The daemon.
+ * @param[in] i_psConnection The connection.
+ * @param[in] i_operation The epoll_ctl operation.
+ * @param[in] i_events The events to watch for.
+ * @return int EXIT_SUCCESS if the connection is watched, else EXIT_FAILURE.
+ */
+static int watchConnection(sHuffmanDaemon_t* io_psDaemon,
+                           sDaemonConnection_t* i_psConnection,
+                           int i_operation, uint32_t i_events);
+
+/**
+ * @brief Accept every connection waiting on the listening socket.
+ *
+ * @param[inout] io_psDaemon The daemon.
+ */
+static void acceptConnections(sHuffmanDaemon_t* io_psDaemon);
+
+/**
+ * @brief Close a connection and free its buffers.
+ *
+ * @param[inout] io_psDaemon The daemon.
+ * @param[inout] io_psConnection The connection.
+ */
+static void closeConnection(sHuffmanDaemon_t* io_psDaemon,
+                            sDaemonConnection_t* io_psConnection);
+
+/**
+ * @brief Read as much of a connection's request as is available.
+ *
+ * @param[inout] io_psDaemon The daemon.
+ * @param[inout] io_psConnection The connection.
+ */
+static void readRequest(sHuffmanDaemon_t* io_psDaemon,
+                        sDaemonConnection_t* io_psConnection);
+
+/**
+ * @brief Write as much of a connection's response as the socket accepts.
+ *
+ * @param[inout] io_psDaemon The daemon.
+ * @param[inout] io_psConnection The connection.
+ */
+static void writeResponse(sHuffmanDaemon_t* io_psDaemon,
+                          sDaemonConnection_t* io_psConnection);
+
+/**
+ * @brief Start writing the responses the workers have served.
+ *
+ * @param[inout] io_psDaemon The daemon.
+ */
+static void writeServedResponses(sHuffmanDaemon_t* io_psDaemon);
+
+/* Function Definitions */
+
+/**
+ * @brief Add a connection to the back of a queue.
+ *
+ * @param[inout] io_psQueue The queue.
+ * @param[inout] io_psConnection The connection.
+ */
+static void pushConnection(sConnectionQueue_t* io_psQueue,
+                           sDaemonConnection_t* io_psConnection) {
+  io_psConnection->psNextQueued = NULL;
+  if (io_psQueue->psTail == NULL) {
+    io_psQueue->psHead = io_psConnection;
+  } else {
+    io_psQueue->psTail->psNextQueued = io_psConnection;
+  }
+  io_psQueue->psTail = io_psConnection;
+}
+
+/**
+ * @brief Remove the connection at the front of a queue.
+ *
+ * @param[inout] io_psQueue The queue.
+ * @return sDaemonConnection_t* The connection, or NULL if the queue is empty.
+ */
+static sDaemonConnection_t* popConnection(sConnectionQueue_t* io_psQueue) {
+  sDaemonConnection_t* psConnection = io_psQueue->psHead;
+  if (psConnection != NULL) {
+    io_psQueue->psHead = psConnection->psNextQueued;
+    if (io_psQueue->psHead == NULL) {
+      io_psQueue->psTail = NULL;
+    }
+  }
+  return psConnection;
+}
+
+/**
+ * @brief Make sure a buffer can hold a number of bytes.
+ *
+ * The buffer only grows, so a connection sending requests of similar sizes
+ * allocates once.
+ *
+ * @param[inout] io_ppBuffer The buffer, replaced if it is too small.
+ * @param[inout] io_pCapacity The capacity of the buffer.
+ * @param[in] i_size The number of bytes needed.
+ * @return int EXIT_SUCCESS if the buffer is large enough, else EXIT_FAILURE.
+ */
+static int reserveBuffer(uint8_t** io_ppBuffer, size_t* io_pCapacity,
+                         size_t i_size) {
+  if (i_size <= *io_pCapacity) {
+    return EXIT_SUCCESS;
+  }
+
+  freeHuffmanMemory(NULL, *io_ppBuffer);
+  *io_pCapacity = 0;
+  *io_ppBuffer = (uint8_t*)allocateHuffmanMemory(NULL, i_size);
+  if (*io_ppBuffer == NULL) {
+    perror("ERROR: Failed to allocate memory for daemon buffer");
+    return EXIT_FAILURE;
+  }
+  *io_pCapacity = i_size;
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Grow a buffer, keeping the bytes it already holds.
+ *
+ * @param[inout] io_ppBuffer The buffer, replaced by a larger one.
+ * @param[inout] io_pCapacity The capacity of the buffer.
+ * @param[in] i_used The number of bytes to keep.
+ * @param[in] i_size The number of bytes needed, more than the capacity.
+ * @return int EXIT_SUCCESS if the buffer was grown, else EXIT_FAILURE.
+ */
+static int growBuffer(uint8_t** io_ppBuffer, size_t* io_pCapacity,
+                      size_t i_used, size_t i_size) {
+  uint8_t* pBuffer = (uint8_t*)allocateHuffmanMemory(NULL, i_size);
+  if (pBuffer == NULL) {
+    perror("ERROR: Failed to allocate memory for daemon buffer");
+    return EXIT_FAILURE;
+  }
+  if (i_used > 0) {
+    (void)memcpy(pBuffer, *io_ppBuffer, i_used);
+  }
+  freeHuffmanMemory(NULL, *io_ppBuffer);
+  *io_ppBuffer = pBuffer;
+  *io_pCapacity = i_size;
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Serve a connection's request with a worker's context.
+ *
+ * The response buffer is sized for the largest possible result before
+ * coding, so the codec writes the payload straight after the header. A
+ * compress request was limited as it was read, so only a decompress
+ * response's size has to be checked.
+ *
+ * @param[inout] io_psWorker The worker.
+ * @param[inout] io_psConnection The connection holding a whole request.
+ */
+static void serveRequest(sDaemonWorker_t* io_psWorker,
+                         sDaemonConnection_t* io_psConnection) {
+  const uint8_t* pRequest = io_psConnection->pRequest;
+  const size_t requestSize = io_psConnection->requestSize;
+  size_t capacity = 0;
+  bool isValid = true;
+
+  if (io_psConnection->operation == HUFFMAN_DAEMON_COMPRESS) {
+    capacity = getCompressBound(requestSize, NULL);
+  } else if (io_psConnection->operation == HUFFMAN_DAEMON_DECOMPRESS) {
+    isValid = (getDecompressedSize(pRequest, requestSize, &capacity) ==
+               EXIT_SUCCESS);
+  } else {
+    (void)fprintf(stderr, "ERROR: Unknown daemon operation %u\n",
+                  (unsigned)io_psConnection->operation);
+    isValid = false;
+  }
+  if (isValid && io_psConnection->operation == HUFFMAN_DAEMON_DECOMPRESS &&
+      capacity > HUFFMAN_DAEMON_MAX_MESSAGE_SIZE) {
+    (void)fprintf(stderr, "ERROR: Daemon response is too large\n");
+    isValid = false;
+  }
+  if (!isValid) {
+    capacity = 0;
+  }
+
+  if (reserveBuffer(&io_psConnection->pResponse,
+                    &io_psConnection->responseCapacity,
+                    HUFFMAN_DAEMON_HEADER_SIZE + capacity) == EXIT_FAILURE) {
+    io_psConnection->responseSize = 0;
+    return;
+  }
+
+  uint8_t* pPayload = &io_psConnection->pResponse[HUFFMAN_DAEMON_HEADER_SIZE];
+  size_t payloadSize = 0;
+  int result = EXIT_FAILURE;
+  if (isValid && io_psConnection->operation == HUFFMAN_DAEMON_COMPRESS) {
+    result = compressBufferWithContext(io_psWorker->psContext, pRequest,
+                                       requestSize, pPayload, capacity,
+                                       &payloadSize, NULL);
+  } else if (isValid) {
+    result = decompressBufferWithContext(io_psWorker->psContext, pRequest,
+                                         requestSize, pPayload, capacity,
+                                         &payloadSize);
+  }
+  if (result == EXIT_FAILURE) {
+    payloadSize = 0;
+  }
+
+  storeLittleEndian32(io_psConnection->pResponse,
+                      (result == EXIT_SUCCESS) ? HUFFMAN_DAEMON_STATUS_OK
+                                               : HUFFMAN_DAEMON_STATUS_FAILED);
+  storeLittleEndian32(&io_psConnection->pResponse[4], (uint32_t)payloadSize);
+  io_psConnection->responseSize = HUFFMAN_DAEMON_HEADER_SIZE + payloadSize;
+}
+
+/**
+ * @brief Serve requests from the work queue until the daemon stops.
+ *
+ * Each served connection is moved to the done queue, and the event loop is
+ * woken to write its response.
+ *
+ * @param[inout] io_pWorker The worker, an sDaemonWorker_t.
+ * @return void* NULL.
+ */
+static void* runWorker(void* io_pWorker) {
+  sDaemonWorker_t* psWorker = (sDaemonWorker_t*)io_pWorker;
+  sHuffmanDaemon_t* psDaemon = psWorker->psDaemon;
+  const uint64_t wake = 1;
+
+  while (true) {
+    (void)pthread_mutex_lock(&psDaemon->mutex);
+    sDaemonConnection_t* psConnection = NULL;
+    while (!psDaemon->isWorkerStopping &&
+           (psConnection = popConnection(&psDaemon->sWorkQueue)) == NULL) {
+      (void)pthread_cond_wait(&psDaemon->queued, &psDaemon->mutex);
+    }
+    (void)pthread_mutex_unlock(&psDaemon->mutex);
+    if (psConnection == NULL) {
+      break;
+    }
+
+    serveRequest(psWorker, psConnection);
+
+    (void)pthread_mutex_lock(&psDaemon->mutex);
+    pushConnection(&psDaemon->sDoneQueue, psConnection);
+    (void)pthread_mutex_unlock(&psDaemon->mutex);
+    (void)write(psDaemon->wakeEvent, &wake, sizeof(wake));
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Watch a connection for events, or stop watching it.
+ *
+ * @param[inout] io_psDaemon The daemon.
+ * @param[in] i_psConnection The connection.
+ * @param[in] i_operation The epoll_ctl operation.
+ * @param[in] i_events The events to watch for.
+ * @return int EXIT_SUCCESS if the connection is watched, else EXIT_FAILURE.
+ */
+static int watchConnection(sHuffmanDaemon_t* io_psDaemon,
+                           sDaemonConnection_t* i_psConnection,
+                           int i_operation, uint32_t i_events) {
+  struct epoll_event sEvent;
+  sEvent.events = i_events;
+  sEvent.data.ptr = i_psConnection;
+  if (epoll_ctl(io_psDaemon->epoll, i_operation, i_psConnection->socket,
+                &sEvent) != 0) {
+    perror("ERROR: Failed to watch daemon connection");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Accept every connection waiting on the listening socket.
+ *
+ * A connection beyond the daemon's limit is closed straight away, rather
+ * than left waiting, so the listening socket does not keep waking the event
+ * loop.
+ *
+ * @param[inout] io_psDaemon The daemon.
+ */
+static void acceptConnections(sHuffmanDaemon_t* io_psDaemon) {
+  while (true) {
+    const int clientSocket = accept(io_psDaemon->listenSocket, NULL, NULL);
+    if (clientSocket < 0) {
+      if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+        perror("ERROR: Failed to accept daemon connection");
+      }
+      return;
+    }
+    if (io_psDaemon->connectionCount >= io_psDaemon->maxConnections) {
+      (void)fprintf(stderr, "ERROR: Too many daemon connections\n");
+      (void)close(clientSocket);
+      continue;
+    }
+
+    sDaemonConnection_t* psConnection =
+        (sDaemonConnection_t*)allocateHuffmanMemory(
+            NULL, sizeof(sDaemonConnection_t));
+    if (psConnection == NULL ||
+        fcntl(clientSocket, F_SETFL, O_NONBLOCK) != 0) {
+      perror("ERROR: Failed to set up daemon connection");
+      freeHuffmanMemory(NULL, psConnection);
+      (void)close(clientSocket);
+      continue;
+    }
+    (void)memset(psConnection, 0, sizeof(*psConnection));
+    psConnection->socket = clientSocket;
+
+    psConnection->psNext = io_psDaemon->psConnections;
+    if (io_psDaemon->psConnections != NULL) {
+      io_psDaemon->psConnections->psPrevious = psConnection;
+    }
+    io_psDaemon->psConnections = psConnection;
+    io_psDaemon->connectionCount++;
+
+    if (watchConnection(io_psDaemon, psConnection, EPOLL_CTL_ADD, EPOLLIN) ==
+        EXIT_FAILURE) {
+      closeConnection(io_psDaemon, psConnection);
+    }
+  }
+}
+
+/**
+ * @brief Close a connection and free its buffers.
+ *
+ * Closing the socket also removes it from the epoll set.
+ *
+ * @param[inout] io_psDaemon The daemon.
+ * @param[inout] io_psConnection The connection.
+ */
+static void closeConnection(sHuffmanDaemon_t* io_psDaemon,
+                            sDaemonConnection_t* io_psConnection) {
+  if (io_psConnection->psPrevious != NULL) {
+    io_psConnection->psPrevious->psNext = io_psConnection->psNext;
+  } else {
+    io_psDaemon->psConnections = io_psConnection->psNext;
+  }
+  if (io_psConnection->psNext != NULL) {
+    io_psConnection->psNext->psPrevious = io_psConnection->psPrevious;
+  }
+  io_psDaemon->connectionCount--;
+
+  (void)close(io_psConnection->socket);
+  freeHuffmanMemory(NULL, io_psConnection->pRequest);
+  freeHuffmanMemory(NULL, io_psConnection->pResponse);
+  freeHuffmanMemory(NULL, io_psConnection);
+}
+
+/**
+ * @brief Read as much of a connection's request as is available.
+ *
+ * Only the bytes of the current request are read, so any pipelined request
+ * stays in the socket until this one is answered. The request buffer starts
+ * at REQUEST_CHUNK_SIZE and doubles whenever it fills, so a header claiming
+ * a large payload costs nothing until the payload is sent. Once the request
+ * is whole, the connection stops being watched and is queued for a worker.
+ * The connection is closed at the end of the stream, on an error or if the
+ * request is too large.
+ *
+ * @param[inout] io_psDaemon The daemon.
+ * @param[inout] io_psConnection The connection.
+ */
+static void readRequest(sHuffmanDaemon_t* io_psDaemon,
+                        sDaemonConnection_t* io_psConnection) {
+  while (true) {
+    uint8_t* pDest = NULL;
+    size_t wanted = 0;
+    if (io_psConnection->received < HUFFMAN_DAEMON_HEADER_SIZE) {
+      pDest = &io_psConnection->aHeader[io_psConnection->received];
+      wanted = HUFFMAN_DAEMON_HEADER_SIZE - io_psConnection->received;
+    } else {
+      const size_t offset =
+          io_psConnection->received - HUFFMAN_DAEMON_HEADER_SIZE;
+      if (offset == io_psConnection->requestCapacity &&
+          offset < io_psConnection->requestSize) {
+        size_t capacity = (offset < REQUEST_CHUNK_SIZE / 2)
+                              ? REQUEST_CHUNK_SIZE
+                              : offset * 2;
+        if (capacity > io_psConnection->requestSize) {
+          capacity = io_psConnection->requestSize;
+        }
+        if (growBuffer(&io_psConnection->pRequest,
+                       &io_psConnection->requestCapacity, offset,
+                       capacity) == EXIT_FAILURE) {
+          closeConnection(io_psDaemon, io_psConnection);
+          return;
+        }
+      }
+      const size_t available =
+          (io_psConnection->requestCapacity < io_psConnection->requestSize)
+              ? io_psConnection->requestCapacity
+              : io_psConnection->requestSize;
+      pDest = &io_psConnection->pRequest[offset];
+      wanted = available - offset;
+    }
+
+    if (wanted > 0) {
+      const ssize_t count = read(io_psConnection->socket, pDest, wanted);
+      if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK ||
+                        errno == EINTR)) {
+        return;
+      }
+      if (count <= 0) {
+        closeConnection(io_psDaemon, io_psConnection);
+        return;
+      }
+      io_psConnection->received += (size_t)count;
+    }
+
+    if (io_psConnection->received == HUFFMAN_DAEMON_HEADER_SIZE &&
+        wanted > 0) {
+      io_psConnection->operation = loadLittleEndian32(io_psConnection->aHeader);
+      io_psConnection->requestSize =
+          loadLittleEndian32(&io_psConnection->aHeader[4]);
+      const size_t limit =
+          (io_psConnection->operation == HUFFMAN_DAEMON_DECOMPRESS)
+              ? HUFFMAN_DAEMON_MAX_CONTAINER_SIZE
+              : HUFFMAN_DAEMON_MAX_MESSAGE_SIZE;
+      if (io_psConnection->requestSize > limit) {
+        (void)fprintf(stderr, "ERROR: Daemon request is too large\n");
+        closeConnection(io_psDaemon, io_psConnection);
+        return;
+      }
+    }
+
+    if (io_psConnection->received ==
+        HUFFMAN_DAEMON_HEADER_SIZE + io_psConnection->requestSize) {
+      (void)watchConnection(io_psDaemon, io_psConnection, EPOLL_CTL_DEL, 0);
+      (void)pthread_mutex_lock(&io_psDaemon->mutex);
+      pushConnection(&io_psDaemon->sWorkQueue, io_psConnection);
+      (void)pthread_cond_signal(&io_psDaemon->queued);
+      (void)pthread_mutex_unlock(&io_psDaemon->mutex);
+      return;
+    }
+  }
+}
+
+/**
+ * @brief Write as much of a connection's response as the socket accepts.
+ *
+ * Once the response is written, the connection is watched for its next
+ * request. The connection is closed on an error.
+ *
+ * @param[inout] io_psDaemon The daemon.
+ * @param[inout] io_psConnection The connection.
+ */
+static void writeResponse(sHuffmanDaemon_t* io_psDaemon,
+                          sDaemonConnection_t* io_psConnection) {
+  while (io_psConnection->sent < io_psConnection->responseSize) {
+    const ssize_t count =
+        send(io_psConnection->socket,
+             &io_psConnection->pResponse[io_psConnection->sent],
+             io_psConnection->responseSize - io_psConnection->sent,
+             MSG_NOSIGNAL);
+    if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      return;
+    }
+    if (count < 0 && errno == EINTR) {
+      continue;
+    }
+    if (count <= 0) {
+      closeConnection(io_psDaemon, io_psConnection);
+      return;
+    }
+    io_psConnection->sent += (size_t)count;
+  }
+
+  io_psConnection->received = 0;
+  io_psConnection->sent = 0;
+  io_psConnection->responseSize = 0;
+  if (watchConnection(io_psDaemon, io_psConnection, EPOLL_CTL_MOD,
+                      EPOLLIN) == EXIT_FAILURE) {
+    closeConnection(io_psDaemon, io_psConnection);
+  }
+}
+
+/**
+ * @brief Start writing the responses the workers have served.
+ *
+ * Each connection is watched again, for writing until its response is
+ * sent. A connection whose response could not be allocated is closed.
+ *
+ * @param[inout] io_psDaemon The daemon.
+ */
+static void writeServedResponses(sHuffmanDaemon_t* io_psDaemon) {
+  uint64_t wakes = 0;
+  (void)read(io_psDaemon->wakeEvent, &wakes, sizeof(wakes));
+
+  (void)pthread_mutex_lock(&io_psDaemon->mutex);
+  sConnectionQueue_t sDone = io_psDaemon->sDoneQueue;
+  io_psDaemon->sDoneQueue.psHead = NULL;
+  io_psDaemon->sDoneQueue.psTail = NULL;
+  (void)pthread_mutex_unlock(&io_psDaemon->mutex);
+
+  sDaemonConnection_t* psConnection = NULL;
+  while ((psConnection = popConnection(&sDone)) != NULL) {
+    if (psConnection->responseSize == 0 ||
+        watchConnection(io_psDaemon, psConnection, EPOLL_CTL_ADD,
+                        EPOLLOUT) == EXIT_FAILURE) {
+      closeConnection(io_psDaemon, psConnection);
+      continue;
+    }
+    writeResponse(io_psDaemon, psConnection);
+  }
+}
+
+/**
+ * @brief Initialise daemon options to the defaults.
+ *
+ * @param[out] o_psOptions The options to initialise.
+ */
+void initDaemonOptions(sHuffmanDaemonOptions_t* o_psOptions) {
+  o_psOptions->pSocketPath = NULL;
+  o_psOptions->workerCount = HUFFMAN_DAEMON_DEFAULT_WORKERS;
+  o_psOptions->maxConnections = HUFFMAN_DAEMON_DEFAULT_MAX_CONNECTIONS;
+}
+
+/**
+ * @brief Create a daemon listening on a Unix domain socket.
+ *
+ * Any file already at the socket path is replaced. The workers' contexts are
+ * created here, but no requests are served until runHuffmanDaemon is called.
+ *
+ * @param[in] i_psOptions The daemon options.
+ * @return sHuffmanDaemon_t* The daemon, else NULL.
+ */
+sHuffmanDaemon_t* createHuffmanDaemon(
+    const sHuffmanDaemonOptions_t* i_psOptions) {
+  size_t workerCount = i_psOptions->workerCount;
+  if (workerCount == 0) {
+    workerCount = HUFFMAN_DAEMON_DEFAULT_WORKERS;
+  }
+  if (i_psOptions->pSocketPath == NULL ||
+      workerCount > HUFFMAN_DAEMON_MAX_WORKERS) {
+    (void)fprintf(stderr, "ERROR: Invalid daemon options\n");
+    return NULL;
+  }
+
+  sHuffmanDaemon_t* psDaemon = (sHuffmanDaemon_t*)allocateHuffmanMemory(
+      NULL, sizeof(sHuffmanDaemon_t));
+  if (psDaemon == NULL) {
+    perror("ERROR: Failed to allocate memory for daemon");
+    return NULL;
+  }
+  (void)memset(psDaemon, 0, sizeof(*psDaemon));
+  atomic_init(&psDaemon->isStopping, false);
+  psDaemon->listenSocket = -1;
+  psDaemon->epoll = -1;
+  psDaemon->wakeEvent = -1;
+  (void)pthread_mutex_init(&psDaemon->mutex, NULL);
+  (void)pthread_cond_init(&psDaemon->queued, NULL);
+  psDaemon->maxConnections = (i_psOptions->maxConnections != 0)
+                                 ? i_psOptions->maxConnections
+                                 : HUFFMAN_DAEMON_DEFAULT_MAX_CONNECTIONS;
+
+  if (strlen(i_psOptions->pSocketPath) >= sizeof(psDaemon->aSocketPath)) {
+    (void)fprintf(stderr, "ERROR: Daemon socket path is too long\n");
+    freeHuffmanDaemon(psDaemon);
+    return NULL;
+  }
+  (void)strcpy(psDaemon->aSocketPath, i_psOptions->pSocketPath);
+
+  for (size_t i = 0; i < workerCount; i++) {
+    psDaemon->asWorkers[i].psDaemon = psDaemon;
+    psDaemon->asWorkers[i].psContext = createHuffmanContext(NULL);
+    psDaemon->workerCount = i + 1;
+    if (psDaemon->asWorkers[i].psContext == NULL) {
+      freeHuffmanDaemon(psDaemon);
+      return NULL;
+    }
+  }
+
+  struct sockaddr_un sAddress;
+  (void)memset(&sAddress, 0, sizeof(sAddress));
+  sAddress.sun_family = AF_UNIX;
+  (void)strcpy(sAddress.sun_path, psDaemon->aSocketPath);
+  (void)unlink(psDaemon->aSocketPath);
+
+  psDaemon->listenSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+  psDaemon->epoll = epoll_create1(0);
+  psDaemon->wakeEvent = eventfd(0, EFD_NONBLOCK);
+  if (psDaemon->listenSocket < 0 || psDaemon->epoll < 0 ||
+      psDaemon->wakeEvent < 0 ||
+      bind(psDaemon->listenSocket, (const struct sockaddr*)&sAddress,
+           sizeof(sAddress)) != 0 ||
+      listen(psDaemon->listenSocket, LISTEN_BACKLOG) != 0 ||
+      fcntl(psDaemon->listenSocket, F_SETFL, O_NONBLOCK) != 0) {
+    perror("ERROR: Failed to listen on daemon socket");
+    freeHuffmanDaemon(psDaemon);
+    return NULL;
+  }
+
+  /* The listening socket is tagged with NULL and the wake event with the
+     daemon, so neither is mistaken for a connection. */
+  struct epoll_event sEvent;
+  sEvent.events = EPOLLIN;
+  sEvent.data.ptr = NULL;
+  const int listenResult = epoll_ctl(psDaemon->epoll, EPOLL_CTL_ADD,
+                                     psDaemon->listenSocket, &sEvent);
+  sEvent.data.ptr = psDaemon;
+  if (listenResult != 0 || epoll_ctl(psDaemon->epoll, EPOLL_CTL_ADD,
+                                     psDaemon->wakeEvent, &sEvent) != 0) {
+    perror("ERROR: Failed to watch daemon socket");
+    freeHuffmanDaemon(psDaemon);
+    return NULL;
+  }
+
+  return psDaemon;
+}
+
+/**
+ * @brief Serve requests until stopHuffmanDaemon is called.
+ *
+ * This function starts the workers, runs the event loop on the calling
+ * thread and joins the workers before returning. Open connections are closed
+ * once it returns.
+ *
+ * @param[inout] io_psDaemon The daemon.
+ * @return int EXIT_SUCCESS if the daemon was stopped, else EXIT_FAILURE.
+ */
+int runHuffmanDaemon(sHuffmanDaemon_t* io_psDaemon) {
+  int result = EXIT_SUCCESS;
+  size_t startedCount = 0;
+  for (size_t i = 0; i < io_psDaemon->workerCount; i++) {
+    sDaemonWorker_t* psWorker = &io_psDaemon->asWorkers[i];
+    psWorker->isThreadStarted =
+        (pthread_create(&psWorker->thread, NULL, runWorker, psWorker) == 0);
+    startedCount += psWorker->isThreadStarted ? 1 : 0;
+  }
+  if (startedCount == 0) {
+    (void)fprintf(stderr, "ERROR: Failed to start daemon workers\n");
+    return EXIT_FAILURE;
+  }
+
+  struct epoll_event asEvents[EVENT_BATCH_SIZE];
+  while (!atomic_load(&io_psDaemon->isStopping)) {
+    const int eventCount =
+        epoll_wait(io_psDaemon->epoll, asEvents, EVENT_BATCH_SIZE, -1);
+    if (eventCount < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      perror("ERROR: Failed to wait for daemon events");
+      result = EXIT_FAILURE;
+      break;
+    }
+
+    /* Wake events are handled last, so a connection closed by an earlier
+       event in the batch is never served one of its own events. */
+    bool isWoken = false;
+    for (int i = 0; i < eventCount; i++) {
+      sDaemonConnection_t* psConnection =
+          (sDaemonConnection_t*)asEvents[i].data.ptr;
+      if (asEvents[i].data.ptr == NULL) {
+        acceptConnections(io_psDaemon);
+      } else if (asEvents[i].data.ptr == (void*)io_psDaemon) {
+        isWoken = true;
+      } else if ((asEvents[i].events & EPOLLOUT) != 0) {
+        writeResponse(io_psDaemon, psConnection);
+      } else {
+        readRequest(io_psDaemon, psConnection);
+      }
+    }
+    if (isWoken) {
+      writeServedResponses(io_psDaemon);
+    }
+  }
+
+  (void)pthread_mutex_lock(&io_psDaemon->mutex);
+  io_psDaemon->isWorkerStopping = true;
+  (void)pthread_cond_broadcast(&io_psDaemon->queued);
+  (void)pthread_mutex_unlock(&io_psDaemon->mutex);
+  for (size_t i = 0; i < io_psDaemon->workerCount; i++) {
+    if (io_psDaemon->asWorkers[i].isThreadStarted) {
+      (void)pthread_join(io_psDaemon->asWorkers[i].thread, NULL);
+      io_psDaemon->asWorkers[i].isThreadStarted = false;
+    }
+  }
+
+  while (io_psDaemon->psConnections != NULL) {
+    closeConnection(io_psDaemon, io_psDaemon->psConnections);
+  }
+  io_psDaemon->sWorkQueue.psHead = NULL;
+  io_psDaemon->sWorkQueue.psTail = NULL;
+  io_psDaemon->sDoneQueue.psHead = NULL;
+  io_psDaemon->sDoneQueue.psTail = NULL;
+
+  return result;
+}
+
+/**
+ * @brief Ask a running daemon to stop.
+ *
+ * This function may be called from any thread or from a signal handler, as
+ * it only sets a flag and signals the wake event.
+ *
+ * @param[inout] io_psDaemon The daemon.
+ */
+void stopHuffmanDaemon(sHuffmanDaemon_t* io_psDaemon) {
+  const uint64_t wake = 1;
+  atomic_store(&io_psDaemon->isStopping, true);
+  (void)write(io_psDaemon->wakeEvent, &wake, sizeof(wake));
+}
+
+/**
+ * @brief Free a daemon and remove its socket.
+ *
+ * @param[inout] io_psDaemon The daemon, which must not be running, or NULL.
+ */
+void freeHuffmanDaemon(sHuffmanDaemon_t* io_psDaemon) {
+  if (io_psDaemon == NULL) {
+    return;
+  }
+
+  if (io_psDaemon->listenSocket >= 0) {
+    (void)close(io_psDaemon->listenSocket);
+    (void)unlink(io_psDaemon->aSocketPath);
+  }
+  if (io_psDaemon->epoll >= 0) {
+    (void)close(io_psDaemon->epoll);
+  }
+  if (io_psDaemon->wakeEvent >= 0) {
+    (void)close(io_psDaemon->wakeEvent);
+  }
+  for (size_t i = 0; i < io_psDaemon->workerCount; i++) {
+    freeHuffmanContext(io_psDaemon->asWorkers[i].psContext);
+  }
+  (void)pthread_cond_destroy(&io_psDaemon->queued);
+  (void)pthread_mutex_destroy(&io_psDaemon->mutex);
+  freeHuffmanMemory(NULL, io_psDaemon);
+}
@@ -0,0 +1,147 @@
+/**
+ * @file daemon.h
+ * @brief Serve compression requests over a Unix domain socket.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ * Every request and response is a header followed by a payload, with every
+ * integer stored little-endian:
+ *
+ *   request   uint32 operation, uint32 payload size, payload
+ *   response  uint32 status, uint32 payload size, payload
+ *
+ * A compress request's payload is the bytes to compress and its response's
+ * payload is the container, as written by compressBuffer with the default
+ * options. A decompress request's payload is a container and its response's
+ * payload is the uncompressed bytes. A failed request has an empty response
+ * payload, and the connection stays open for further requests. Uncompressed
+ * payloads are limited to HUFFMAN_DAEMON_MAX_MESSAGE_SIZE bytes and
+ * containers to HUFFMAN_DAEMON_MAX_CONTAINER_SIZE bytes, so any container the
+ * daemon writes can be sent back to it.
+ *
+ * The daemon reads requests and writes responses on a single thread with
+ * epoll, and hands each complete request to a pool of workers. Each worker
+ * owns a context created once when the daemon starts, so requests never pay
+ * for allocating one, and repeated decompress requests with the same code
+ * lengths reuse the worker's decode table. A request's buffer grows as its
+ * payload arrives, rather than to the size its header claims, and
+ * connections beyond the daemon's limit are closed as soon as they are
+ * accepted.
+ */
+
+#ifndef DAEMON_H
+#define DAEMON_H
+
+/* Standard Library Includes */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Project Includes */
+
+#include "huffmanCoding/codec.h"
+
+/* Constants */
+
+/**< The number of bytes in a request or response header. */
+#define HUFFMAN_DAEMON_HEADER_SIZE 8
+
+/**< The largest compress request or decompress response payload. */
+#define HUFFMAN_DAEMON_MAX_MESSAGE_SIZE ((size_t)64 << 20)
+
+/**< The largest decompress request or compress response payload. */
+#define HUFFMAN_DAEMON_MAX_CONTAINER_SIZE \
+  getCompressBound(HUFFMAN_DAEMON_MAX_MESSAGE_SIZE, NULL)
+
+/**< The default number of workers. */
+#define HUFFMAN_DAEMON_DEFAULT_WORKERS 4
+
+/**< The most workers a daemon runs. */
+#define HUFFMAN_DAEMON_MAX_WORKERS 256
+
+/**< The default number of open connections. */
+#define HUFFMAN_DAEMON_DEFAULT_MAX_CONNECTIONS 1024
+
+/* Type Definitions */
+
+/**
+ * @brief The operation a request asks for.
+ */
+typedef enum eHuffmanDaemonOperation {
+  HUFFMAN_DAEMON_COMPRESS = 1,
+  HUFFMAN_DAEMON_DECOMPRESS = 2,
+} eHuffmanDaemonOperation_t;
+
+/**
+ * @brief The outcome of a request.
+ */
+typedef enum eHuffmanDaemonStatus {
+  HUFFMAN_DAEMON_STATUS_OK = 0,
+  HUFFMAN_DAEMON_STATUS_FAILED = 1,
+} eHuffmanDaemonStatus_t;
+
+/**
+ * @brief Options for starting a daemon.
+ */
+typedef struct sHuffmanDaemonOptions {
+  const char* pSocketPath; /**< The path to listen on. */
+  size_t workerCount;      /**< The number of workers, 0 for the default. */
+  size_t maxConnections;   /**< The most open connections, 0 for the default. */
+} sHuffmanDaemonOptions_t;
+
+/**
+ * @brief A daemon's listening socket, workers and connections.
+ */
+typedef struct sHuffmanDaemon sHuffmanDaemon_t;
+
+/* Function Prototypes */
+
+/**
+ * @brief Initialise daemon options to the defaults.
+ *
+ * @param[out] o_psOptions The options to initialise.
+ */
+extern void initDaemonOptions(sHuffmanDaemonOptions_t* o_psOptions);
+
+/**
+ * @brief Create a daemon listening on a Unix domain socket.
+ *
+ * Any file already at the socket path is replaced. The workers' contexts are
+ * created here, but no requests are served until runHuffmanDaemon is called.
+ *
+ * @param[in] i_psOptions The daemon options.
+ * @return sHuffmanDaemon_t* The daemon, else NULL.
+ */
+extern sHuffmanDaemon_t* createHuffmanDaemon(
+    const sHuffmanDaemonOptions_t* i_psOptions);
+
+/**
+ * @brief Serve requests until stopHuffmanDaemon is called.
+ *
+ * This function starts the workers, runs the event loop on the calling
+ * thread and joins the workers before returning. Open connections are closed
+ * once it returns.
+ *
+ * @param[inout] io_psDaemon The daemon.
+ * @return int EXIT_SUCCESS if the daemon was stopped, else EXIT_FAILURE.
+ */
+extern int runHuffmanDaemon(sHuffmanDaemon_t* io_psDaemon);
+
+/**
+ * @brief Ask a running daemon to stop.
+ *
+ * This function may be called from any thread or from a signal handler.
+ *
+ * @param[inout] io_psDaemon The daemon.
+ */
+extern void stopHuffmanDaemon(sHuffmanDaemon_t* io_psDaemon);
+
+/**
+ * @brief Free a daemon and remove its socket.
+ *
+ * @param[inout] io_psDaemon The daemon, which must not be running, or NULL.
+ */
+extern void freeHuffmanDaemon(sHuffmanDaemon_t* io_psDaemon);
+
+#endif  // DAEMON_H
@@ -0,0 +1,214 @@
+/**
+ * @file daemonClient.c
+ * @brief Send compression requests to a daemon over a Unix domain socket.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+/* Standard Library Includes */
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/* Project Includes */
+
+#include "huffmanCoding/bitStream.h"
+#include "huffmanCoding/daemon.h"
+#include "huffmanCoding/daemonClient.h"
+
+/* Constants */
+
+/**< The number of bytes discarded at a time from a response that does not
+ * fit in the output. */
+#define DISCARD_SIZE 4096
+
+/* Function Prototypes */
+
+/**
+ * @brief Write all of a buffer to a socket.
+ *
+ * @param[in] i_socket The socket.
+ * @param[in] i_pData The bytes to write.
+ * @param[in] i_size The number of bytes to write.
+ * @return int EXIT_SUCCESS if every byte was written, else EXIT_FAILURE.
+ */
+static int sendAll(int i_socket, const uint8_t* i_pData, size_t i_size);
+
+/**
+ * @brief Read a number of bytes from a socket.
+ *
+ * @param[in] i_socket The socket.
+ * @param[out] o_pData The buffer to read into.
+ * @param[in] i_size The number of bytes to read.
+ * @return int EXIT_SUCCESS if every byte was read, else EXIT_FAILURE.
+ */
+static int receiveAll(int i_socket, uint8_t* o_pData, size_t i_size);
+
+/* Function Definitions */
+
+/**
+ * @brief Write all of a buffer to a socket.
+ *
+ * @param[in] i_socket The socket.
+ * @param[in] i_pData The bytes to write.
+ * @param[in] i_size The number of bytes to write.
+ * @return int EXIT_SUCCESS if every byte was written, else EXIT_FAILURE.
+ */
+static int sendAll(int i_socket, const uint8_t* i_pData, size_t i_size) {
+  size_t sent = 0;
+  while (sent < i_size) {
+    const ssize_t count =
+        send(i_socket, &i_pData[sent], i_size - sent, MSG_NOSIGNAL);
+    if (count < 0 && errno == EINTR) {
+      continue;
+    }
+    if (count <= 0) {
+      perror("ERROR: Failed to send daemon request");
+      return EXIT_FAILURE;
+    }
+    sent += (size_t)count;
+  }
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Read a number of bytes from a socket.
+ *
+ * @param[in] i_socket The socket.
+ * @param[out] o_pData The buffer to read into.
+ * @param[in] i_size The number of bytes to read.
+ * @return int EXIT_SUCCESS if every byte was read, else EXIT_FAILURE.
+ */
+static int receiveAll(int i_socket, uint8_t* o_pData, size_t i_size) {
+  size_t received = 0;
+  while (received < i_size) {
+    const ssize_t count = read(i_socket, &o_pData[received], i_size - received);
+    if (count < 0 && errno == EINTR) {
+      continue;
+    }
+    if (count <= 0) {
+      (void)fprintf(stderr, "ERROR: Daemon closed the connection\n");
+      return EXIT_FAILURE;
+    }
+    received += (size_t)count;
+  }
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Connect to a daemon.
+ *
+ * @param[out] o_psClient The client to connect.
+ * @param[in] i_pSocketPath The path the daemon listens on.
+ * @return int EXIT_SUCCESS if the client connected, else EXIT_FAILURE.
+ */
+int connectHuffmanDaemon(sHuffmanDaemonClient_t* o_psClient,
+                         const char* i_pSocketPath) {
+  struct sockaddr_un sAddress;
+  (void)memset(&sAddress, 0, sizeof(sAddress));
+  sAddress.sun_family = AF_UNIX;
+  if (strlen(i_pSocketPath) >= sizeof(sAddress.sun_path)) {
+    (void)fprintf(stderr, "ERROR: Daemon socket path is too long\n");
+    return EXIT_FAILURE;
+  }
+  (void)strcpy(sAddress.sun_path, i_pSocketPath);
+
+  o_psClient->socket = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (o_psClient->socket < 0 ||
+      connect(o_psClient->socket, (const struct sockaddr*)&sAddress,
+              sizeof(sAddress)) != 0) {
+    perror("ERROR: Failed to connect to daemon");
+    disconnectHuffmanDaemon(o_psClient);
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Close a client's connection.
+ *
+ * @param[inout] io_psClient The client.
+ */
+void disconnectHuffmanDaemon(sHuffmanDaemonClient_t* io_psClient) {
+  if (io_psClient->socket >= 0) {
+    (void)close(io_psClient->socket);
+  }
+  io_psClient->socket = -1;
+}
+
+/**
+ * @brief Send a request to a daemon and wait for its response.
+ *
+ * A response that does not fit in the output is read and discarded, so the
+ * connection can still be used afterwards.
+ *
+ * @param[inout] io_psClient The client.
+ * @param[in] i_eOperation The operation to ask for.
+ * @param[in] i_pInput The request payload.
+ * @param[in] i_inputSize The number of bytes in the request payload.
+ * @param[out] o_pOutput The buffer to write the response payload to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @param[out] o_pOutputSize The number of bytes written to the output.
+ * @return int EXIT_SUCCESS if the daemon served the request and the response
+ * fits in the output, else EXIT_FAILURE.
+ */
+int requestHuffmanDaemon(sHuffmanDaemonClient_t* io_psClient,
+                         eHuffmanDaemonOperation_t i_eOperation,
+                         const uint8_t* i_pInput, size_t i_inputSize,
+                         uint8_t* o_pOutput, size_t i_outputCapacity,
+                         size_t* o_pOutputSize) {
+  const size_t limit = (i_eOperation == HUFFMAN_DAEMON_DECOMPRESS)
+                           ? HUFFMAN_DAEMON_MAX_CONTAINER_SIZE
+                           : HUFFMAN_DAEMON_MAX_MESSAGE_SIZE;
+  if (i_inputSize > limit) {
+    (void)fprintf(stderr, "ERROR: Daemon request is too large\n");
+    return EXIT_FAILURE;
+  }
+
+  uint8_t aHeader[HUFFMAN_DAEMON_HEADER_SIZE];
+  storeLittleEndian32(aHeader, (uint32_t)i_eOperation);
+  storeLittleEndian32(&aHeader[4], (uint32_t)i_inputSize);
+  if (sendAll(io_psClient->socket, aHeader, sizeof(aHeader)) ==
+          EXIT_FAILURE ||
+      sendAll(io_psClient->socket, i_pInput, i_inputSize) == EXIT_FAILURE ||
+      receiveAll(io_psClient->socket, aHeader, sizeof(aHeader)) ==
+          EXIT_FAILURE) {
+    return EXIT_FAILURE;
+  }
+
+  const uint32_t status = loadLittleEndian32(aHeader);
+  const size_t payloadSize = loadLittleEndian32(&aHeader[4]);
+  if (payloadSize > i_outputCapacity) {
+    uint8_t aDiscard[DISCARD_SIZE];
+    for (size_t left = payloadSize; left > 0;) {
+      const size_t count = (left < DISCARD_SIZE) ? left : DISCARD_SIZE;
+      if (receiveAll(io_psClient->socket, aDiscard, count) == EXIT_FAILURE) {
+        return EXIT_FAILURE;
+      }
+      left -= count;
+    }
+    (void)fprintf(stderr, "ERROR: Output buffer is too small\n");
+    return EXIT_FAILURE;
+  }
+  if (receiveAll(io_psClient->socket, o_pOutput, payloadSize) ==
+      EXIT_FAILURE) {
+    return EXIT_FAILURE;
+  }
+
+  if (status != HUFFMAN_DAEMON_STATUS_OK) {
+    (void)fprintf(stderr, "ERROR: Daemon failed the request\n");
+    return EXIT_FAILURE;
+  }
+  *o_pOutputSize = payloadSize;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,75 @@
+/**
+ * @file daemonClient.h
+ * @brief Send compression requests to a daemon over a Unix domain socket.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ * A client holds one connection to a daemon and sends one request at a
+ * time, waiting for each response. Clients are not thread-safe, so each
+ * thread should connect its own.
+ */
+
+#ifndef DAEMON_CLIENT_H
+#define DAEMON_CLIENT_H
+
+/* Standard Library Includes */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Project Includes */
+
+#include "huffmanCoding/daemon.h"
+
+/* Type Definitions */
+
+/**
+ * @brief A connection to a daemon.
+ */
+typedef struct sHuffmanDaemonClient {
+  int socket;
+} sHuffmanDaemonClient_t;
+
+/* Function Prototypes */
+
+/**
+ * @brief Connect to a daemon.
+ *
+ * @param[out] o_psClient The client to connect.
+ * @param[in] i_pSocketPath The path the daemon listens on.
+ * @return int EXIT_SUCCESS if the client connected, else EXIT_FAILURE.
+ */
+extern int connectHuffmanDaemon(sHuffmanDaemonClient_t* o_psClient,
+                                const char* i_pSocketPath);
+
+/**
+ * @brief Close a client's connection.
+ *
+ * @param[inout] io_psClient The client.
+ */
+extern void disconnectHuffmanDaemon(sHuffmanDaemonClient_t* io_psClient);
+
+/**
+ * @brief Send a request to a daemon and wait for its response.
+ *
+ * A response that does not fit in the output is read and discarded, so the
+ * connection can still be used afterwards.
+ *
+ * @param[inout] io_psClient The client.
+ * @param[in] i_eOperation The operation to ask for.
+ * @param[in] i_pInput The request payload.
+ * @param[in] i_inputSize The number of bytes in the request payload.
+ * @param[out] o_pOutput The buffer to write the response payload to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @param[out] o_pOutputSize The number of bytes written to the output.
+ * @return int EXIT_SUCCESS if the daemon served the request and the response
+ * fits in the output, else EXIT_FAILURE.
+ */
+extern int requestHuffmanDaemon(sHuffmanDaemonClient_t* io_psClient,
+                                eHuffmanDaemonOperation_t i_eOperation,
+                                const uint8_t* i_pInput, size_t i_inputSize,
+                                uint8_t* o_pOutput, size_t i_outputCapacity,
+                                size_t* o_pOutputSize);
+
+#endif  // DAEMON_CLIENT_H
@@ -0,0 +1,775 @@
+/**
+ * @file decodeKernel.c
+ * @brief Table-driven decoding kernels with runtime CPU dispatch.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+/* Standard Library Includes */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#endif
+
+/* Project Includes */
+
+#include "huffmanCoding/bitStream.h"
+#include "huffmanCoding/checksum.h"
+#include "huffmanCoding/decodeKernel.h"
+#include "huffmanCoding/huffmanTree.h"
+
+/* Constants */
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+/**< Whether the BMI2 kernel is built in. */
+#define HUFFMAN_HAS_BMI2_KERNEL
+#endif
+
+/**< The number of codes the BMI2 kernel decodes per refill. A refill leaves
+ * at least 56 bits, enough for four codes of HUFFMAN_DECODE_TABLE_BITS. */
+#define BMI2_CODES_PER_REFILL 4
+
+/**< The output the BMI2 multi-symbol kernel needs for a group of lookups,
+ * as each lookup stores eight bytes but decodes at most
+ * HUFFMAN_MULTI_SYMBOL_MAX_CODES. */
+#define BMI2_MULTI_SYMBOL_GROUP_SIZE                                  \
+  (((BMI2_CODES_PER_REFILL - 1) * HUFFMAN_MULTI_SYMBOL_MAX_CODES) + \
+   sizeof(multiSymbolEntry_t))
+
+/**< The number of bytes the fused checksum trails the output by, so that it
+ * loads bytes stored several lookups earlier. */
+#define CHECKSUM_LAG 32
+
+/**< The name of each decode kernel. */
+static const char* const KERNEL_NAMES[HUFFMAN_DECODE_KERNEL_MAX] = {
+    "portable", "bmi2"};
+
+/* Type Definitions */
+
+/**
+ * @brief A decode kernel, with the signature of decodeTableSymbols.
+ */
+typedef size_t (*decodeKernelFunction_t)(const decodeTableEntry_t*,
+                                         sBitReader_t*, uint8_t*, size_t);
+
+/**
+ * @brief A multi-symbol decode kernel, with the signature of
+ * decodeMultiSymbols.
+ */
+typedef size_t (*multiSymbolKernelFunction_t)(const multiSymbolEntry_t*,
+                                              sBitReader_t*, uint8_t*,
+                                              size_t);
+
+/**
+ * @brief A nibble tree walk, decoding one code of a non-NULL tree.
+ */
+typedef int (*nibbleTreeKernelFunction_t)(const sHuffmanNibbleTree_t*,
+                                          sBitReader_t*, uint8_t*);
+
+/* Function Prototypes */
+
+/**
+ * @brief The portable decode kernel.
+ *
+ * @param[in] i_aDecodeTable The decode table.
+ * @param[inout] io_psReader The bit reader positioned at the first code.
+ * @param[out] o_pOutput The buffer to write the decoded bytes to.
+ * @param[in] i_outputSize The maximum number of bytes to decode.
+ * @return size_t The number of bytes decoded.
+ */
+static size_t decodePortable(const decodeTableEntry_t* i_aDecodeTable,
+                             sBitReader_t* io_psReader, uint8_t* o_pOutput,
+                             size_t i_outputSize);
+
+/**
+ * @brief The portable multi-symbol decode kernel.
+ *
+ * @param[in] i_aMultiSymbolTable The multi-symbol decode table.
+ * @param[inout] io_psReader The bit reader positioned at the first code.
+ * @param[out] o_pOutput The buffer to write the decoded bytes to.
+ * @param[in] i_outputSize The maximum number of bytes to decode.
+ * @return size_t The number of bytes decoded.
+ */
+static size_t decodeMultiSymbolPortable(
+    const multiSymbolEntry_t* i_aMultiSymbolTable, sBitReader_t* io_psReader,
+    uint8_t* o_pOutput, size_t i_outputSize);
+
+/**
+ * @brief The portable nibble tree walk.
+ *
+ * @param[in] i_psTree The nibble tree.
+ * @param[inout] io_psReader The bit reader positioned at the code.
+ * @param[out] o_pSymbol The decoded symbol.
+ * @return int EXIT_SUCCESS if a symbol was decoded, else EXIT_FAILURE.
+ */
+static int walkNibbleTreePortable(const sHuffmanNibbleTree_t* i_psTree,
+                                  sBitReader_t* io_psReader,
+                                  uint8_t* o_pSymbol);
+
+#ifdef HUFFMAN_HAS_BMI2_KERNEL
+/**
+ * @brief Refill a bit reader with one unaligned load, without branching.
+ *
+ * @param[inout] io_psReader The bit reader, with at least eight bytes left.
+ */
+__attribute__((target("bmi,bmi2"))) static inline void refillBitsBmi2(
+    sBitReader_t* io_psReader);
+
+/**
+ * @brief Decode one code with a decode table, peeking it with bzhi.
+ *
+ * @param[in] i_aDecodeTable The decode table.
+ * @param[inout] io_psReader The bit reader positioned at the code.
+ * @param[out] o_pSymbol The decoded symbol.
+ * @return bool Whether the code was in the table.
+ */
+__attribute__((target("bmi,bmi2"))) static inline bool decodeCodeBmi2(
+    const decodeTableEntry_t* i_aDecodeTable, sBitReader_t* io_psReader,
+    uint8_t* o_pSymbol);
+
+/**
+ * @brief Decode the codes of one multi-symbol table entry, peeking them
+ * with bzhi.
+ *
+ * @param[in] i_aMultiSymbolTable The multi-symbol decode table.
+ * @param[inout] io_psReader The bit reader positioned at the first code.
+ * @param[out] o_pOutput The buffer to store the entry's eight bytes to.
+ * @return size_t The number of bytes decoded, or 0 for an invalid code.
+ */
+__attribute__((target("bmi,bmi2"))) static inline size_t
+decodeMultiSymbolCodeBmi2(const multiSymbolEntry_t* i_aMultiSymbolTable,
+                          sBitReader_t* io_psReader, uint8_t* o_pOutput);
+
+/**
+ * @brief The BMI2 decode kernel.
+ *
+ * @param[in] i_aDecodeTable The decode table.
+ * @param[inout] io_psReader The bit reader positioned at the first code.
+ * @param[out] o_pOutput The buffer to write the decoded bytes to.
+ * @param[in] i_outputSize The maximum number of bytes to decode.
+ * @return size_t The number of bytes decoded.
+ */
+__attribute__((target("bmi,bmi2"))) static size_t decodeBmi2(
+    const decodeTableEntry_t* i_aDecodeTable, sBitReader_t* io_psReader,
+    uint8_t* o_pOutput, size_t i_outputSize);
+
+/**
+ * @brief The BMI2 multi-symbol decode kernel.
+ *
+ * @param[in] i_aMultiSymbolTable The multi-symbol decode table.
+ * @param[inout] io_psReader The bit reader positioned at the first code.
+ * @param[out] o_pOutput The buffer to write the decoded bytes to.
+ * @param[in] i_outputSize The maximum number of bytes to decode.
+ * @return size_t The number of bytes decoded.
+ */
+__attribute__((target("bmi,bmi2"))) static size_t decodeMultiSymbolBmi2(
+    const multiSymbolEntry_t* i_aMultiSymbolTable, sBitReader_t* io_psReader,
+    uint8_t* o_pOutput, size_t i_outputSize);
+
+/**
+ * @brief The BMI2 nibble tree walk.
+ *
+ * @param[in] i_psTree The nibble tree.
+ * @param[inout] io_psReader The bit reader positioned at the code.
+ * @param[out] o_pSymbol The decoded symbol.
+ * @return int EXIT_SUCCESS if a symbol was decoded, else EXIT_FAILURE.
+ */
+__attribute__((target("bmi,bmi2"))) static int walkNibbleTreeBmi2(
+    const sHuffmanNibbleTree_t* i_psTree, sBitReader_t* io_psReader,
+    uint8_t* o_pSymbol);
+
+/**
+ * @brief The BMI2 multi-symbol decode kernel, checksumming its output with
+ * SSE4.2 as it goes.
+ *
+ * @param[in] i_aMultiSymbolTable The multi-symbol decode table.
+ * @param[inout] io_psReader The bit reader positioned at the first code.
+ * @param[out] o_pOutput The buffer to write the decoded bytes to.
+ * @param[in] i_outputSize The maximum number of bytes to decode.
+ * @param[inout] io_pChecksum The CRC32C checksum to add the bytes to.
+ * @return size_t The number of bytes decoded.
+ */
+__attribute__((target("bmi,bmi2,sse4.2"))) static size_t
+decodeMultiSymbolCrc32cBmi2(const multiSymbolEntry_t* i_aMultiSymbolTable,
+                            sBitReader_t* io_psReader, uint8_t* o_pOutput,
+                            size_t i_outputSize, uint32_t* io_pChecksum);
+#endif
+
+/* Global Variables */
+
+/**< The decode kernel in use. */
+static eHuffmanDecodeKernel_t g_eDecodeKernel = HUFFMAN_DECODE_KERNEL_PORTABLE;
+
+/**< The function of the decode kernel in use. */
+static decodeKernelFunction_t g_pfnDecodeKernel = decodePortable;
+
+/**< The multi-symbol function of the decode kernel in use. */
+static multiSymbolKernelFunction_t g_pfnMultiSymbolKernel =
+    decodeMultiSymbolPortable;
+
+/**< The nibble tree walk of the decode kernel in use. */
+static nibbleTreeKernelFunction_t g_pfnNibbleTreeKernel =
+    walkNibbleTreePortable;
+
+/* Function Definitions */
+
+/**
+ * @brief The portable decode kernel.
+ *
+ * The buffer is refilled whenever it may not hold a whole code, and the
+ * per-symbol dependency chain is a table load followed by a shift by the
+ * code length.
+ *
+ * @param[in] i_aDecodeTable The decode table.
+ * @param[inout] io_psReader The bit reader positioned at the first code.
+ * @param[out] o_pOutput The buffer to write the decoded bytes to.
+ * @param[in] i_outputSize The maximum number of bytes to decode.
+ * @return size_t The number of bytes decoded.
+ */
+static size_t decodePortable(const decodeTableEntry_t* i_aDecodeTable,
+                             sBitReader_t* io_psReader, uint8_t* o_pOutput,
+                             size_t i_outputSize) {
+  sBitReader_t sReader = *io_psReader;
+  size_t i = 0;
+
+  for (; i < i_outputSize; i++) {
+    if (sReader.bitCount < HUFFMAN_MAX_CODE_LENGTH) {
+      refillBitReader(&sReader);
+    }
+    const decodeTableEntry_t entry =
+        i_aDecodeTable[peekBits(&sReader, HUFFMAN_DECODE_TABLE_BITS)];
+    if (entry == 0) {
+      break;
+    }
+    o_pOutput[i] = (uint8_t)(entry >> 4);
+    consumeBits(&sReader, entry & 0x0FU);
+  }
+
+  *io_psReader = sReader;
+  return i;
+}
+
+/**
+ * @brief The portable multi-symbol decode kernel.
+ *
+ * Each lookup stores all eight bytes of its entry and advances the output
+ * by its symbol count, so the dependency chain per lookup is the same as
+ * for decodePortable but covers several symbols.
+ *
+ * @param[in] i_aMultiSymbolTable The multi-symbol decode table.
+ * @param[inout] io_psReader The bit reader positioned at the first code.
+ * @param[out] o_pOutput The buffer to write the decoded bytes to.
+ * @param[in] i_outputSize The maximum number of bytes to decode.
+ * @return size_t The number of bytes decoded.
+ */
+static size_t decodeMultiSymbolPortable(
+    const multiSymbolEntry_t* i_aMultiSymbolTable, sBitReader_t* io_psReader,
+    uint8_t* o_pOutput, size_t i_outputSize) {
+  sBitReader_t sReader = *io_psReader;
+  size_t i = 0;
+
+  while (i + sizeof(multiSymbolEntry_t) <= i_outputSize) {
+    if (sReader.bitCount < HUFFMAN_DECODE_TABLE_BITS) {
+      refillBitReader(&sReader);
+    }
+    const multiSymbolEntry_t entry =
+        i_aMultiSymbolTable[peekBits(&sReader, HUFFMAN_DECODE_TABLE_BITS)];
+    const size_t count = (size_t)(entry >> 60);
+    if (count == 0) {
+      break;
+    }
+    storeLittleEndian64(&o_pOutput[i], entry);
+    consumeBits(&sReader, (size_t)(entry >> 56) & 0x0FU);
+    i += count;
+  }
+
+  *io_psReader = sReader;
+  return i;
+}
+
+/**
+ * @brief The portable nibble tree walk.
+ *
+ * @param[in] i_psTree The nibble tree.
+ * @param[inout] io_psReader The bit reader positioned at the code.
+ * @param[out] o_pSymbol The decoded symbol.
+ * @return int EXIT_SUCCESS if a symbol was decoded, else EXIT_FAILURE.
+ */
+static int walkNibbleTreePortable(const sHuffmanNibbleTree_t* i_psTree,
+                                  sBitReader_t* io_psReader,
+                                  uint8_t* o_pSymbol) {
+  size_t node = 0;
+  for (size_t depth = 0; depth < HUFFMAN_MAX_CODE_LENGTH;
+       depth += HUFFMAN_NIBBLE_TREE_BITS) {
+    const nibbleTreeEntry_t entry =
+        i_psTree->aaNodes[node][peekBits(io_psReader,
+                                         HUFFMAN_NIBBLE_TREE_BITS)];
+    const size_t length = entry & 0x0FU;
+    if (length != 0) {
+      consumeBits(io_psReader, length);
+      *o_pSymbol = (uint8_t)(entry >> 4);
+      return EXIT_SUCCESS;
+    }
+    if (entry == 0) {
+      break;
+    }
+    consumeBits(io_psReader, HUFFMAN_NIBBLE_TREE_BITS);
+    node = (size_t)(entry >> 4);
+  }
+
+  return EXIT_FAILURE;
+}
+
+#ifdef HUFFMAN_HAS_BMI2_KERNEL
+/**
+ * @brief Refill a bit reader with one unaligned load, without branching.
+ *
+ * This is the fast path of refillBitReader. The load is shifted in with
+ * shlx and the bit count is topped up to 56 or more.
+ *
+ * @param[inout] io_psReader The bit reader, with at least eight bytes left.
+ */
+__attribute__((target("bmi,bmi2"))) static inline void refillBitsBmi2(
+    sBitReader_t* io_psReader) {
+  io_psReader->bitBuffer |=
+      loadLittleEndian64(&io_psReader->pInput[io_psReader->position])
+      << io_psReader->bitCount;
+  io_psReader->position += (63 - io_psReader->bitCount) >> 3;
+  io_psReader->bitCount |= 56;
+}
+
+/**
+ * @brief Decode one code with a decode table, peeking it with bzhi.
+ *
+ * The table index is the low HUFFMAN_DECODE_TABLE_BITS bits of the buffer,
+ * and the code length is the low nibble of the entry, both taken with bzhi
+ * rather than by building masks. The code is consumed with shrx.
+ *
+ * @param[in] i_aDecodeTable The decode table.
+ * @param[inout] io_psReader The bit reader positioned at the code.
+ * @param[out] o_pSymbol The decoded symbol.
+ * @return bool Whether the code was in the table.
+ */
+__attribute__((target("bmi,bmi2"))) static inline bool decodeCodeBmi2(
+    const decodeTableEntry_t* i_aDecodeTable, sBitReader_t* io_psReader,
+    uint8_t* o_pSymbol) {
+  const uint32_t entry = i_aDecodeTable[_bzhi_u64(
+      io_psReader->bitBuffer, HUFFMAN_DECODE_TABLE_BITS)];
+  if (entry == 0) {
+    return false;
+  }
+  const uint32_t length = _bzhi_u32(entry, 4);
+  *o_pSymbol = (uint8_t)(entry >> 4);
+  io_psReader->bitBuffer >>= length;
+  io_psReader->bitCount -= length;
+  return true;
+}
+
+/**
+ * @brief Decode the codes of one multi-symbol table entry, peeking them
+ * with bzhi.
+ *
+ * The entry's bit count is taken with bextr and consumed with shrx.
+ *
+ * @param[in] i_aMultiSymbolTable The multi-symbol decode table.
+ * @param[inout] io_psReader The bit reader positioned at the first code.
+ * @param[out] o_pOutput The buffer to store the entry's eight bytes to.
+ * @return size_t The number of bytes decoded, or 0 for an invalid code.
+ */
+__attribute__((target("bmi,bmi2"))) static inline size_t
+decodeMultiSymbolCodeBmi2(const multiSymbolEntry_t* i_aMultiSymbolTable,
+                          sBitReader_t* io_psReader, uint8_t* o_pOutput) {
+  const multiSymbolEntry_t entry = i_aMultiSymbolTable[_bzhi_u64(
+      io_psReader->bitBuffer, HUFFMAN_DECODE_TABLE_BITS)];
+  const size_t count = (size_t)(entry >> 60);
+  if (count != 0) {
+    const size_t length = (size_t)_bextr_u64(entry, 56, 4);
+    storeLittleEndian64(o_pOutput, entry);
+    io_psReader->bitBuffer >>= length;
+    io_psReader->bitCount -= length;
+  }
+  return count;
+}
+
+/**
+ * @brief The BMI2 decode kernel.
+ *
+ * While a whole word of input remains, the buffer is refilled without a
+ * branch once per BMI2_CODES_PER_REFILL codes, so the only branches left
+ * are on codes missing from the table and are taken only to stop. The
+ * portable kernel's branch on the bits left depends on the code lengths,
+ * and is mispredicted when they vary. The last codes are decoded one at a
+ * time with the ordinary refill.
+ *
+ * @param[in] i_aDecodeTable The decode table.
+ * @param[inout] io_psReader The bit reader positioned at the first code.
+ * @param[out] o_pOutput The buffer to write the decoded bytes to.
+ * @param[in] i_outputSize The maximum number of bytes to decode.
+ * @return size_t The number of bytes decoded.
+ */
+__attribute__((target("bmi,bmi2"))) static size_t decodeBmi2(
+    const decodeTableEntry_t* i_aDecodeTable, sBitReader_t* io_psReader,
+    uint8_t* o_pOutput, size_t i_outputSize) {
+  sBitReader_t sReader = *io_psReader;
+  size_t i = 0;
+  bool isStopped = false;
+
+  while (!isStopped && i + BMI2_CODES_PER_REFILL <= i_outputSize &&
+         sReader.position + 8 <= sReader.size) {
+    refillBitsBmi2(&sReader);
+    for (size_t code = 0; code < BMI2_CODES_PER_REFILL; code++) {
+      if (!decodeCodeBmi2(i_aDecodeTable, &sReader, &o_pOutput[i])) {
+        isStopped = true;
+        break;
+      }
+      i++;
+    }
+  }
+
+  for (; !isStopped && i < i_outputSize; i++) {
+    if (sReader.bitCount < HUFFMAN_MAX_CODE_LENGTH) {
+      refillBitReader(&sReader);
+    }
+    if (!decodeCodeBmi2(i_aDecodeTable, &sReader, &o_pOutput[i])) {
+      break;
+    }
+  }
+
+  *io_psReader = sReader;
+  return i;
+}
+
+/**
+ * @brief The BMI2 multi-symbol decode kernel.
+ *
+ * Like decodeBmi2, the buffer is refilled without a branch once per
+ * BMI2_CODES_PER_REFILL lookups while enough input and output remain.
+ *
+ * @param[in] i_aMultiSymbolTable The multi-symbol decode table.
+ * @param[inout] io_psReader The bit reader positioned at the first code.
+ * @param[out] o_pOutput The buffer to write the decoded bytes to.
+ * @param[in] i_outputSize The maximum number of bytes to decode.
+ * @return size_t The number of bytes decoded.
+ */
+__attribute__((target("bmi,bmi2"))) static size_t decodeMultiSymbolBmi2(
+    const multiSymbolEntry_t* i_aMultiSymbolTable, sBitReader_t* io_psReader,
+    uint8_t* o_pOutput, size_t i_outputSize) {
+  sBitReader_t sReader = *io_psReader;
+  size_t i = 0;
+  bool isStopped = false;
+
+  while (!isStopped && i + BMI2_MULTI_SYMBOL_GROUP_SIZE <= i_outputSize &&
+         sReader.position + 8 <= sReader.size) {
+    refillBitsBmi2(&sReader);
+    for (size_t lookup = 0; lookup < BMI2_CODES_PER_REFILL; lookup++) {
+      const size_t count =
+          decodeMultiSymbolCodeBmi2(i_aMultiSymbolTable, &sReader,
+                                    &o_pOutput[i]);
+      if (count == 0) {
+        isStopped = true;
+        break;
+      }
+      i += count;
+    }
+  }
+
+  while (!isStopped && i + sizeof(multiSymbolEntry_t) <= i_outputSize) {
+    if (sReader.bitCount < HUFFMAN_DECODE_TABLE_BITS) {
+      refillBitReader(&sReader);
+    }
+    const size_t count =
+        decodeMultiSymbolCodeBmi2(i_aMultiSymbolTable, &sReader,
+                                  &o_pOutput[i]);
+    if (count == 0) {
+      break;
+    }
+    i += count;
+  }
+
+  *io_psReader = sReader;
+  return i;
+}
+
+/**
+ * @brief The BMI2 nibble tree walk.
+ *
+ * Each nibble is peeked with bzhi and consumed with shrx. The reader holds
+ * every bit of the code, so no refill is needed.
+ *
+ * @param[in] i_psTree The nibble tree.
+ * @param[inout] io_psReader The bit reader positioned at the code.
+ * @param[out] o_pSymbol The decoded symbol.
+ * @return int EXIT_SUCCESS if a symbol was decoded, else EXIT_FAILURE.
+ */
+__attribute__((target("bmi,bmi2"))) static int walkNibbleTreeBmi2(
+    const sHuffmanNibbleTree_t* i_psTree, sBitReader_t* io_psReader,
+    uint8_t* o_pSymbol) {
+  size_t node = 0;
+  for (size_t depth = 0; depth < HUFFMAN_MAX_CODE_LENGTH;
+       depth += HUFFMAN_NIBBLE_TREE_BITS) {
+    const uint32_t entry = i_psTree->aaNodes[node][_bzhi_u64(
+        io_psReader->bitBuffer, HUFFMAN_NIBBLE_TREE_BITS)];
+    const uint32_t length = _bzhi_u32(entry, 4);
+    if (length != 0) {
+      io_psReader->bitBuffer >>= length;
+      io_psReader->bitCount -= length;
+      *o_pSymbol = (uint8_t)(entry >> 4);
+      return EXIT_SUCCESS;
+    }
+    if (entry == 0) {
+      break;
+    }
+    io_psReader->bitBuffer >>= HUFFMAN_NIBBLE_TREE_BITS;
+    io_psReader->bitCount -= HUFFMAN_NIBBLE_TREE_BITS;
+    node = (size_t)(entry >> 4);
+  }
+
+  return EXIT_FAILURE;
+}
+
+/**
+ * @brief The BMI2 multi-symbol decode kernel, checksumming its output with
+ * SSE4.2 as it goes.
+ *
+ * The table lookups form a chain of dependent loads, which leaves the
+ * crc32 unit idle. Each lookup adds the eight bytes CHECKSUM_LAG behind the
+ * output to the checksum, which keeps up as a lookup decodes at most
+ * HUFFMAN_MULTI_SYMBOL_MAX_CODES.
+ *
+ * @param[in] i_aMultiSymbolTable The multi-symbol decode table.
+ * @param[inout] io_psReader The bit reader positioned at the first code.
+ * @param[out] o_pOutput The buffer to write the decoded bytes to.
+ * @param[in] i_outputSize The maximum number of bytes to decode.
+ * @param[inout] io_pChecksum The CRC32C checksum to add the bytes to.
+ * @return size_t The number of bytes decoded.
+ */
+__attribute__((target("bmi,bmi2,sse4.2"))) static size_t
+decodeMultiSymbolCrc32cBmi2(const multiSymbolEntry_t* i_aMultiSymbolTable,
+                            sBitReader_t* io_psReader, uint8_t* o_pOutput,
+                            size_t i_outputSize, uint32_t* io_pChecksum) {
+  sBitReader_t sReader = *io_psReader;
+  uint64_t crc = (uint32_t)~*io_pChecksum;
+  size_t i = 0;
+  size_t checked = 0;
+  bool isStopped = false;
+
+  while (!isStopped && i + BMI2_MULTI_SYMBOL_GROUP_SIZE <= i_outputSize &&
+         sReader.position + 8 <= sReader.size) {
+    refillBitsBmi2(&sReader);
+    for (size_t lookup = 0; lookup < BMI2_CODES_PER_REFILL; lookup++) {
+      const size_t count =
+          decodeMultiSymbolCodeBmi2(i_aMultiSymbolTable, &sReader,
+                                    &o_pOutput[i]);
+      if (count == 0) {
+        isStopped = true;
+        break;
+      }
+      i += count;
+      if (i >= checked + CHECKSUM_LAG) {
+        crc = _mm_crc32_u64(crc, loadLittleEndian64(&o_pOutput[checked]));
+        checked += 8;
+      }
+    }
+  }
+
+  while (!isStopped && i + sizeof(multiSymbolEntry_t) <= i_outputSize) {
+    if (sReader.bitCount < HUFFMAN_DECODE_TABLE_BITS) {
+      refillBitReader(&sReader);
+    }
+    const size_t count =
+        decodeMultiSymbolCodeBmi2(i_aMultiSymbolTable, &sReader,
+                                  &o_pOutput[i]);
+    if (count == 0) {
+      break;
+    }
+    i += count;
+    if (i >= checked + CHECKSUM_LAG) {
+      crc = _mm_crc32_u64(crc, loadLittleEndian64(&o_pOutput[checked]));
+      checked += 8;
+    }
+  }
+
+  *io_psReader = sReader;
+  *io_pChecksum =
+      updateCrc32c(~(uint32_t)crc, &o_pOutput[checked], i - checked);
+  return i;
+}
+
+/**
+ * @brief Select the fastest supported decode kernel at startup.
+ *
+ */
+__attribute__((constructor)) static void selectDecodeKernel(void) {
+  __builtin_cpu_init();
+  (void)setDecodeKernel(HUFFMAN_DECODE_KERNEL_BMI2);
+}
+#endif
+
+/**
+ * @brief Find whether a decode kernel can run on this CPU.
+ *
+ * @param[in] i_eKernel The decode kernel.
+ * @return bool Whether the kernel is built in and supported by the CPU.
+ */
+bool isDecodeKernelSupported(eHuffmanDecodeKernel_t i_eKernel) {
+  switch (i_eKernel) {
+    case HUFFMAN_DECODE_KERNEL_PORTABLE:
+      return true;
+#ifdef HUFFMAN_HAS_BMI2_KERNEL
+    case HUFFMAN_DECODE_KERNEL_BMI2:
+      return __builtin_cpu_supports("bmi") != 0 &&
+             __builtin_cpu_supports("bmi2") != 0;
+#endif
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief Find the decode kernel in use.
+ *
+ * @return eHuffmanDecodeKernel_t The decode kernel.
+ */
+eHuffmanDecodeKernel_t getDecodeKernel(void) { return g_eDecodeKernel; }
+
+/**
+ * @brief Select the decode kernel, e.g. to compare kernels.
+ *
+ * This function must not be called while other threads are decoding.
+ *
+ * @param[in] i_eKernel The decode kernel.
+ * @return int EXIT_SUCCESS if the kernel was selected, else EXIT_FAILURE if
+ * it is not supported.
+ */
+int setDecodeKernel(eHuffmanDecodeKernel_t i_eKernel) {
+  if (!isDecodeKernelSupported(i_eKernel)) {
+    return EXIT_FAILURE;
+  }
+
+  g_eDecodeKernel = i_eKernel;
+#ifdef HUFFMAN_HAS_BMI2_KERNEL
+  if (i_eKernel == HUFFMAN_DECODE_KERNEL_BMI2) {
+    g_pfnDecodeKernel = decodeBmi2;
+    g_pfnMultiSymbolKernel = decodeMultiSymbolBmi2;
+    g_pfnNibbleTreeKernel = walkNibbleTreeBmi2;
+    return EXIT_SUCCESS;
+  }
+#endif
+  g_pfnDecodeKernel = decodePortable;
+  g_pfnMultiSymbolKernel = decodeMultiSymbolPortable;
+  g_pfnNibbleTreeKernel = walkNibbleTreePortable;
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Get the name of a decode kernel.
+ *
+ * @param[in] i_eKernel The decode kernel.
+ * @return const char* The name of the kernel.
+ */
+const char* getDecodeKernelName(eHuffmanDecodeKernel_t i_eKernel) {
+  if ((int)i_eKernel < 0 || i_eKernel >= HUFFMAN_DECODE_KERNEL_MAX) {
+    return "unknown";
+  }
+  return KERNEL_NAMES[i_eKernel];
+}
+
+/**
+ * @brief Decode symbols with a decode table until a code is not in it.
+ *
+ * This function stops before the first code longer than
+ * HUFFMAN_DECODE_TABLE_BITS, leaving the reader positioned at it.
+ *
+ * @param[in] i_aDecodeTable The decode table.
+ * @param[inout] io_psReader The bit reader positioned at the first code.
+ * @param[out] o_pOutput The buffer to write the decoded bytes to.
+ * @param[in] i_outputSize The maximum number of bytes to decode.
+ * @return size_t The number of bytes decoded.
+ */
+size_t decodeTableSymbols(
+    const decodeTableEntry_t i_aDecodeTable[HUFFMAN_DECODE_TABLE_SIZE],
+    sBitReader_t* io_psReader, uint8_t* o_pOutput, size_t i_outputSize) {
+  return g_pfnDecodeKernel(i_aDecodeTable, io_psReader, o_pOutput,
+                           i_outputSize);
+}
+
+/**
+ * @brief Decode a code longer than the decode table width by walking a
+ * nibble tree.
+ *
+ * @param[in] i_psTree The nibble tree, or NULL if no code is longer than the
+ * decode table width, in which case any code the table stopped at is
+ * invalid.
+ * @param[inout] io_psReader The bit reader positioned at the code, holding at
+ * least HUFFMAN_MAX_CODE_LENGTH + 1 bits.
+ * @param[out] o_pSymbol The decoded symbol.
+ * @return int EXIT_SUCCESS if a symbol was decoded, else EXIT_FAILURE.
+ */
+int decodeNibbleTreeCode(const sHuffmanNibbleTree_t* i_psTree,
+                         sBitReader_t* io_psReader, uint8_t* o_pSymbol) {
+  if (i_psTree == NULL) {
+    return EXIT_FAILURE;
+  }
+  return g_pfnNibbleTreeKernel(i_psTree, io_psReader, o_pSymbol);
+}
+
+/**
+ * @brief Decode symbols with a multi-symbol decode table while at least
+ * eight bytes of output remain.
+ *
+ * This function stops early before an invalid code, leaving the reader
+ * positioned at it. The remaining symbols are decoded with
+ * decodeTableSymbols.
+ *
+ * @param[in] i_aMultiSymbolTable The multi-symbol decode table.
+ * @param[inout] io_psReader The bit reader positioned at the first code.
+ * @param[out] o_pOutput The buffer to write the decoded bytes to.
+ * @param[in] i_outputSize The maximum number of bytes to decode.
+ * @return size_t The number of bytes decoded.
+ */
+size_t decodeMultiSymbols(
+    const multiSymbolEntry_t i_aMultiSymbolTable[HUFFMAN_DECODE_TABLE_SIZE],
+    sBitReader_t* io_psReader, uint8_t* o_pOutput, size_t i_outputSize) {
+  return g_pfnMultiSymbolKernel(i_aMultiSymbolTable, io_psReader, o_pOutput,
+                                i_outputSize);
+}
+
+/**
+ * @brief Decode symbols with a multi-symbol decode table while at least
+ * eight bytes of output remain, adding them to a CRC32C checksum.
+ *
+ * With the BMI2 decode kernel and the SSE4.2 checksum kernel, the checksum
+ * is computed in the decode loop, a few lookups behind the output.
+ * Otherwise the bytes are checksummed once they have been decoded.
+ *
+ * @param[in] i_aMultiSymbolTable The multi-symbol decode table.
+ * @param[inout] io_psReader The bit reader positioned at the first code.
+ * @param[out] o_pOutput The buffer to write the decoded bytes to.
+ * @param[in] i_outputSize The maximum number of bytes to decode.
+ * @param[inout] io_pChecksum The checksum to add the decoded bytes to.
+ * @return size_t The number of bytes decoded.
+ */
+size_t decodeMultiSymbolsWithCrc32c(
+    const multiSymbolEntry_t i_aMultiSymbolTable[HUFFMAN_DECODE_TABLE_SIZE],
+    sBitReader_t* io_psReader, uint8_t* o_pOutput, size_t i_outputSize,
+    uint32_t* io_pChecksum) {
+#ifdef HUFFMAN_HAS_BMI2_KERNEL
+  if (g_eDecodeKernel == HUFFMAN_DECODE_KERNEL_BMI2 &&
+      getChecksumKernel() == HUFFMAN_CHECKSUM_KERNEL_SSE42) {
+    return decodeMultiSymbolCrc32cBmi2(i_aMultiSymbolTable, io_psReader,
+                                       o_pOutput, i_outputSize,
+                                       io_pChecksum);
+  }
+#endif
+  const size_t count = decodeMultiSymbols(i_aMultiSymbolTable, io_psReader,
+                                          o_pOutput, i_outputSize);
+  *io_pChecksum = updateCrc32c(*io_pChecksum, o_pOutput, count);
+  return count;
+}
@@ -0,0 +1,150 @@
+/**
+ * @file decodeKernel.h
+ * @brief Table-driven decoding kernels with runtime CPU dispatch.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ * A decode kernel decodes the codes that fit in a decode table from a bit
+ * reader. The portable kernel is always available. On x86-64 a BMI2 kernel
+ * is selected once at startup when cpuid reports BMI2 support. It peeks
+ * codes with bzhi, consumes them with shrx and refills the bit buffer with
+ * one unaligned load per four codes, without the branch on the number of
+ * bits left that the portable kernel mispredicts when code lengths vary.
+ *
+ * Blocks over alphabets of at most HUFFMAN_TINY_ALPHABET_SIZE symbols, such
+ * as hex digests or DNA bases, are decoded with a multi-symbol table that
+ * resolves every short code in a window per lookup. With the BMI2 decode
+ * kernel and the SSE4.2 checksum kernel, their CRC32C checksums are
+ * computed in the same loop.
+ */
+
+#ifndef DECODE_KERNEL_H
+#define DECODE_KERNEL_H
+
+/* Standard Library Includes */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Project Includes */
+
+#include "huffmanCoding/bitStream.h"
+#include "huffmanCoding/huffmanTree.h"
+
+/* Type Definitions */
+
+/**
+ * @brief The decode kernels.
+ */
+typedef enum eHuffmanDecodeKernel {
+  HUFFMAN_DECODE_KERNEL_PORTABLE, /**< Plain C, for any CPU. */
+  HUFFMAN_DECODE_KERNEL_BMI2,     /**< x86-64 with BMI1 and BMI2. */
+  HUFFMAN_DECODE_KERNEL_MAX
+} eHuffmanDecodeKernel_t;
+
+/* Function Prototypes */
+
+/**
+ * @brief Find whether a decode kernel can run on this CPU.
+ *
+ * @param[in] i_eKernel The decode kernel.
+ * @return bool Whether the kernel is built in and supported by the CPU.
+ */
+extern bool isDecodeKernelSupported(eHuffmanDecodeKernel_t i_eKernel);
+
+/**
+ * @brief Find the decode kernel in use.
+ *
+ * @return eHuffmanDecodeKernel_t The decode kernel.
+ */
+extern eHuffmanDecodeKernel_t getDecodeKernel(void);
+
+/**
+ * @brief Select the decode kernel, e.g. to compare kernels.
+ *
+ * This function must not be called while other threads are decoding.
+ *
+ * @param[in] i_eKernel The decode kernel.
+ * @return int EXIT_SUCCESS if the kernel was selected, else EXIT_FAILURE if
+ * it is not supported.
+ */
+extern int setDecodeKernel(eHuffmanDecodeKernel_t i_eKernel);
+
+/**
+ * @brief Get the name of a decode kernel.
+ *
+ * @param[in] i_eKernel The decode kernel.
+ * @return const char* The name of the kernel.
+ */
+extern const char* getDecodeKernelName(eHuffmanDecodeKernel_t i_eKernel);
+
+/**
+ * @brief Decode symbols with a decode table until a code is not in it.
+ *
+ * This function stops before the first code longer than
+ * HUFFMAN_DECODE_TABLE_BITS, leaving the reader positioned at it.
+ *
+ * @param[in] i_aDecodeTable The decode table.
+ * @param[inout] io_psReader The bit reader positioned at the first code.
+ * @param[out] o_pOutput The buffer to write the decoded bytes to.
+ * @param[in] i_outputSize The maximum number of bytes to decode.
+ * @return size_t The number of bytes decoded.
+ */
+extern size_t decodeTableSymbols(
+    const decodeTableEntry_t i_aDecodeTable[HUFFMAN_DECODE_TABLE_SIZE],
+    sBitReader_t* io_psReader, uint8_t* o_pOutput, size_t i_outputSize);
+
+/**
+ * @brief Decode a code longer than the decode table width by walking a
+ * nibble tree.
+ *
+ * @param[in] i_psTree The nibble tree, or NULL if no code is longer than the
+ * decode table width, in which case any code the table stopped at is
+ * invalid.
+ * @param[inout] io_psReader The bit reader positioned at the code, holding at
+ * least HUFFMAN_MAX_CODE_LENGTH + 1 bits.
+ * @param[out] o_pSymbol The decoded symbol.
+ * @return int EXIT_SUCCESS if a symbol was decoded, else EXIT_FAILURE.
+ */
+extern int decodeNibbleTreeCode(const sHuffmanNibbleTree_t* i_psTree,
+                                sBitReader_t* io_psReader, uint8_t* o_pSymbol);
+
+/**
+ * @brief Decode symbols with a multi-symbol decode table while at least
+ * eight bytes of output remain.
+ *
+ * This function stops early before an invalid code, leaving the reader
+ * positioned at it. The remaining symbols are decoded with
+ * decodeTableSymbols.
+ *
+ * @param[in] i_aMultiSymbolTable The multi-symbol decode table.
+ * @param[inout] io_psReader The bit reader positioned at the first code.
+ * @param[out] o_pOutput The buffer to write the decoded bytes to.
+ * @param[in] i_outputSize The maximum number of bytes to decode.
+ * @return size_t The number of bytes decoded.
+ */
+extern size_t decodeMultiSymbols(
+    const multiSymbolEntry_t i_aMultiSymbolTable[HUFFMAN_DECODE_TABLE_SIZE],
+    sBitReader_t* io_psReader, uint8_t* o_pOutput, size_t i_outputSize);
+
+/**
+ * @brief Decode symbols with a multi-symbol decode table while at least
+ * eight bytes of output remain, adding them to a CRC32C checksum.
+ *
+ * The bytes decoded and the reader are the same as decodeMultiSymbols's.
+ *
+ * @param[in] i_aMultiSymbolTable The multi-symbol decode table.
+ * @param[inout] io_psReader The bit reader positioned at the first code.
+ * @param[out] o_pOutput The buffer to write the decoded bytes to.
+ * @param[in] i_outputSize The maximum number of bytes to decode.
+ * @param[inout] io_pChecksum The checksum to add the decoded bytes to.
+ * @return size_t The number of bytes decoded.
+ */
+extern size_t decodeMultiSymbolsWithCrc32c(
+    const multiSymbolEntry_t i_aMultiSymbolTable[HUFFMAN_DECODE_TABLE_SIZE],
+    sBitReader_t* io_psReader, uint8_t* o_pOutput, size_t i_outputSize,
+    uint32_t* io_pChecksum);
+
+#endif  // DECODE_KERNEL_H
@@ -0,0 +1,572 @@
+/**
+ * @file encodeKernel.c
+ * @brief Code table encoding kernels with runtime CPU dispatch.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+/* Standard Library Includes */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#endif
+
+/* Project Includes */
+
+#include "huffmanCoding/bitStream.h"
+#include "huffmanCoding/encodeKernel.h"
+#include "huffmanCoding/huffmanTree.h"
+
+/* Constants */
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+/**< Whether the AVX2 kernel is built in. */
+#define HUFFMAN_HAS_AVX2_KERNEL
+#endif
+
+/**< Inputs shorter than this are not worth building the entry table for. */
+#define AVX2_MIN_INPUT_SIZE 512
+
+/**< The longest code the tiny alphabet tables can hold, so that each code
+ * and 1 << its length fit in a byte for pmaddubsw. */
+#define TINY_MAX_CODE_LENGTH 7
+
+/**< The name of each encode kernel. */
+static const char* const KERNEL_NAMES[HUFFMAN_ENCODE_KERNEL_MAX] = {
+    "portable", "avx2"};
+
+/* Type Definitions */
+
+/**
+ * @brief An encode kernel, with the signature of encodeTableSymbols.
+ */
+typedef void (*encodeKernelFunction_t)(const sHuffmanCodeTable_t*,
+                                       const uint8_t*, size_t, sBitWriter_t*);
+
+/**
+ * @brief The pshufb tables of an alphabet of at most
+ * HUFFMAN_TINY_ALPHABET_SIZE symbols.
+ *
+ * Each symbol is given one of 16 slots, its low nibble plus an offset chosen
+ * for its high nibble, modulo 16, so that a byte's slot is found with one
+ * lookup by its high nibble and an add.
+ */
+typedef struct sTinyAlphabet {
+  uint8_t aSlotOffsets[16]; /**< The slot offset of each high nibble. */
+  uint8_t aCodes[16];       /**< The code of the symbol in each slot. */
+  uint8_t aLengths[16];     /**< The code length of each slot. */
+  uint8_t aScales[16];      /**< 1 << the code length of each slot. */
+} sTinyAlphabet_t;
+
+/* Function Prototypes */
+
+/**
+ * @brief The portable encode kernel.
+ *
+ * @param[in] i_psCodeTable The canonical code table.
+ * @param[in] i_pInput The bytes to code.
+ * @param[in] i_inputSize The number of bytes to code.
+ * @param[inout] io_psWriter The bit writer to write the codes to.
+ */
+static void encodePortable(const sHuffmanCodeTable_t* i_psCodeTable,
+                           const uint8_t* i_pInput, size_t i_inputSize,
+                           sBitWriter_t* io_psWriter);
+
+#ifdef HUFFMAN_HAS_AVX2_KERNEL
+/**
+ * @brief Build the pshufb tables of a code table, if its alphabet is tiny.
+ *
+ * @param[in] i_psCodeTable The canonical code table.
+ * @param[out] o_psAlphabet The tables of the alphabet.
+ * @return bool Whether the code table has at most HUFFMAN_TINY_ALPHABET_SIZE
+ * symbols, codes of at most TINY_MAX_CODE_LENGTH bits and slots for every
+ * symbol.
+ */
+static bool createTinyAlphabet(const sHuffmanCodeTable_t* i_psCodeTable,
+                               sTinyAlphabet_t* o_psAlphabet);
+
+/**
+ * @brief Append up to 120 bits to a byte-aligned accumulator with unaligned
+ * 64-bit stores.
+ *
+ * @param[inout] io_psWriter The bit writer, holding fewer than 8 bits.
+ * @param[in] i_low The first 64 bits to write.
+ * @param[in] i_high The bits after the first 64.
+ * @param[in] i_count The number of bits to write, at most 120.
+ */
+static inline void appendWide(sBitWriter_t* io_psWriter, uint64_t i_low,
+                              uint64_t i_high, size_t i_count);
+
+/**
+ * @brief The AVX2 encode kernel.
+ *
+ * @param[in] i_psCodeTable The canonical code table.
+ * @param[in] i_pInput The bytes to code.
+ * @param[in] i_inputSize The number of bytes to code.
+ * @param[inout] io_psWriter The bit writer to write the codes to.
+ */
+__attribute__((target("avx2"))) static void encodeAvx2(
+    const sHuffmanCodeTable_t* i_psCodeTable, const uint8_t* i_pInput,
+    size_t i_inputSize, sBitWriter_t* io_psWriter);
+
+/**
+ * @brief Code groups of eight bytes with gathered entries.
+ *
+ * @param[in] i_psCodeTable The canonical code table.
+ * @param[in] i_pInput The bytes to code.
+ * @param[in] i_inputSize The number of bytes to code.
+ * @param[inout] io_psWriter The bit writer, holding fewer than 8 bits.
+ * @return size_t The number of bytes coded.
+ */
+__attribute__((target("avx2"))) static size_t encodeGroupsAvx2(
+    const sHuffmanCodeTable_t* i_psCodeTable, const uint8_t* i_pInput,
+    size_t i_inputSize, sBitWriter_t* io_psWriter);
+
+/**
+ * @brief Code groups of 32 bytes of a tiny alphabet with pshufb lookups.
+ *
+ * @param[in] i_psAlphabet The tables of the alphabet.
+ * @param[in] i_pInput The bytes to code.
+ * @param[in] i_inputSize The number of bytes to code.
+ * @param[inout] io_psWriter The bit writer, holding fewer than 8 bits.
+ * @return size_t The number of bytes coded.
+ */
+__attribute__((target("avx2"))) static size_t encodeTinyGroupsAvx2(
+    const sTinyAlphabet_t* i_psAlphabet, const uint8_t* i_pInput,
+    size_t i_inputSize, sBitWriter_t* io_psWriter);
+#endif
+
+/* Global Variables */
+
+/**< The encode kernel in use. */
+static eHuffmanEncodeKernel_t g_eEncodeKernel = HUFFMAN_ENCODE_KERNEL_PORTABLE;
+
+/**< The function of the encode kernel in use. */
+static encodeKernelFunction_t g_pfnEncodeKernel = encodePortable;
+
+/* Function Definitions */
+
+/**
+ * @brief The portable encode kernel.
+ *
+ * @param[in] i_psCodeTable The canonical code table.
+ * @param[in] i_pInput The bytes to code.
+ * @param[in] i_inputSize The number of bytes to code.
+ * @param[inout] io_psWriter The bit writer to write the codes to.
+ */
+static void encodePortable(const sHuffmanCodeTable_t* i_psCodeTable,
+                           const uint8_t* i_pInput, size_t i_inputSize,
+                           sBitWriter_t* io_psWriter) {
+  sBitWriter_t sWriter = *io_psWriter;
+  for (size_t i = 0; i < i_inputSize; i++) {
+    const uint8_t symbol = i_pInput[i];
+    writeBits(&sWriter, i_psCodeTable->aCodes[symbol],
+              i_psCodeTable->aCodeLengths[symbol]);
+  }
+  *io_psWriter = sWriter;
+}
+
+#ifdef HUFFMAN_HAS_AVX2_KERNEL
+/**
+ * @brief Build the pshufb tables of a code table, if its alphabet is tiny.
+ *
+ * The high nibbles are given slot offsets greedily, those with the most
+ * symbols first, taking the first offset whose slots are all free. This
+ * places common alphabets such as hex digits, DNA bases and decimal numbers,
+ * and any other alphabet is coded by the general kernel.
+ *
+ * @param[in] i_psCodeTable The canonical code table.
+ * @param[out] o_psAlphabet The tables of the alphabet.
+ * @return bool Whether the code table has at most HUFFMAN_TINY_ALPHABET_SIZE
+ * symbols, codes of at most TINY_MAX_CODE_LENGTH bits and slots for every
+ * symbol.
+ */
+static bool createTinyAlphabet(const sHuffmanCodeTable_t* i_psCodeTable,
+                               sTinyAlphabet_t* o_psAlphabet) {
+  /* The low nibbles of the symbols with each high nibble. */
+  uint16_t aGroups[16] = {0};
+  size_t symbolCount = 0;
+  for (size_t symbol = 0; symbol < HUFFMAN_ALPHABET_SIZE; symbol++) {
+    const size_t length = i_psCodeTable->aCodeLengths[symbol];
+    if (length == 0) {
+      continue;
+    }
+    if (length > TINY_MAX_CODE_LENGTH ||
+        ++symbolCount > HUFFMAN_TINY_ALPHABET_SIZE) {
+      return false;
+    }
+    aGroups[symbol >> 4] |= (uint16_t)(1U << (symbol & 0x0FU));
+  }
+
+  (void)memset(o_psAlphabet, 0, sizeof(*o_psAlphabet));
+  uint32_t usedSlots = 0;
+  for (int groupSize = 16; groupSize > 0; groupSize--) {
+    for (size_t high = 0; high < 16; high++) {
+      if (__builtin_popcount(aGroups[high]) != groupSize) {
+        continue;
+      }
+      size_t offset = 0;
+      uint32_t slots = 0;
+      for (; offset < 16; offset++) {
+        const uint32_t rotated = (uint32_t)aGroups[high] << offset;
+        slots = (rotated | (rotated >> 16)) & 0xFFFFU;
+        if ((slots & usedSlots) == 0) {
+          break;
+        }
+      }
+      if (offset == 16) {
+        return false;
+      }
+      usedSlots |= slots;
+      o_psAlphabet->aSlotOffsets[high] = (uint8_t)offset;
+    }
+  }
+
+  for (size_t symbol = 0; symbol < HUFFMAN_ALPHABET_SIZE; symbol++) {
+    const uint8_t length = i_psCodeTable->aCodeLengths[symbol];
+    if (length == 0) {
+      continue;
+    }
+    const size_t slot =
+        (symbol + o_psAlphabet->aSlotOffsets[symbol >> 4]) & 0x0FU;
+    o_psAlphabet->aCodes[slot] = (uint8_t)i_psCodeTable->aCodes[symbol];
+    o_psAlphabet->aLengths[slot] = length;
+    o_psAlphabet->aScales[slot] = (uint8_t)(1U << length);
+  }
+  return true;
+}
+
+/**
+ * @brief Append up to 120 bits to a byte-aligned accumulator with unaligned
+ * 64-bit stores.
+ *
+ * The stores write 16 bytes from the first byte that is not yet whole, all
+ * of which must lie within the output. The bits of the last partial byte
+ * are kept in the accumulator.
+ *
+ * @param[inout] io_psWriter The bit writer, holding fewer than 8 bits.
+ * @param[in] i_low The first 64 bits to write.
+ * @param[in] i_high The bits after the first 64.
+ * @param[in] i_count The number of bits to write, at most 120.
+ */
+static inline void appendWide(sBitWriter_t* io_psWriter, uint64_t i_low,
+                              uint64_t i_high, size_t i_count) {
+  const size_t bitCount = io_psWriter->bitCount;
+  const uint64_t firstWord = io_psWriter->bitBuffer | (i_low << bitCount);
+  const uint64_t secondWord =
+      ((i_low >> 1) >> (63 - bitCount)) | (i_high << bitCount);
+  uint8_t* pDest = &io_psWriter->pOutput[io_psWriter->position];
+  (void)memcpy(pDest, &firstWord, sizeof(firstWord));
+  (void)memcpy(pDest + sizeof(firstWord), &secondWord, sizeof(secondWord));
+
+  const size_t totalBits = bitCount + i_count;
+  const size_t wholeBytes = totalBits >> 3;
+  io_psWriter->position += wholeBytes;
+  io_psWriter->bitCount = totalBits & 7;
+  /* Select the word holding the partial byte without a branch, as whether
+     it is the second word is unpredictable. */
+  const uint64_t secondMask = (uint64_t)0 - (uint64_t)(totalBits >> 6);
+  io_psWriter->bitBuffer =
+      ((secondWord & secondMask) | (firstWord & ~secondMask)) >>
+      ((wholeBytes & 7) * 8);
+}
+
+/**
+ * @brief The AVX2 encode kernel.
+ *
+ * The accumulator is first reduced to fewer than 8 bits, then groups of
+ * bytes are coded with the tiny alphabet tables if the code table has them,
+ * else with gathered entries. The last bytes are coded by the portable
+ * kernel.
+ *
+ * @param[in] i_psCodeTable The canonical code table.
+ * @param[in] i_pInput The bytes to code.
+ * @param[in] i_inputSize The number of bytes to code.
+ * @param[inout] io_psWriter The bit writer to write the codes to.
+ */
+__attribute__((target("avx2"))) static void encodeAvx2(
+    const sHuffmanCodeTable_t* i_psCodeTable, const uint8_t* i_pInput,
+    size_t i_inputSize, sBitWriter_t* io_psWriter) {
+  if (i_inputSize < AVX2_MIN_INPUT_SIZE) {
+    encodePortable(i_psCodeTable, i_pInput, i_inputSize, io_psWriter);
+    return;
+  }
+
+  sBitWriter_t sWriter = *io_psWriter;
+
+  /* Leave fewer than 8 bits in the accumulator. */
+  const uint64_t pending = sWriter.bitBuffer;
+  (void)memcpy(&sWriter.pOutput[sWriter.position], &pending,
+               sizeof(pending));
+  sWriter.position += sWriter.bitCount >> 3;
+  sWriter.bitBuffer >>= sWriter.bitCount & ~(size_t)7;
+  sWriter.bitCount &= 7;
+
+  sTinyAlphabet_t sAlphabet;
+  const size_t i =
+      createTinyAlphabet(i_psCodeTable, &sAlphabet)
+          ? encodeTinyGroupsAvx2(&sAlphabet, i_pInput, i_inputSize, &sWriter)
+          : encodeGroupsAvx2(i_psCodeTable, i_pInput, i_inputSize, &sWriter);
+  *io_psWriter = sWriter;
+
+  encodePortable(i_psCodeTable, &i_pInput[i], i_inputSize - i, io_psWriter);
+}
+
+/**
+ * @brief Code groups of eight bytes with gathered entries.
+ *
+ * Each group of eight bytes gathers its codes and lengths from a table of
+ * packed entries into one vector. Neighbouring codes are joined in two
+ * steps, each shifting the later code by the summed lengths before it, so
+ * each half's four codes, at most 60 bits, end up in one word. The two
+ * words are joined and appended with 16-byte stores while at least 128 more
+ * bytes follow, whose codes of at least one bit each keep the stores within
+ * the output.
+ *
+ * The entries are gathered with scalar loads, as vpgatherdd is microcoded
+ * and slower than eight loads on recent Intel cores.
+ *
+ * @param[in] i_psCodeTable The canonical code table.
+ * @param[in] i_pInput The bytes to code.
+ * @param[in] i_inputSize The number of bytes to code.
+ * @param[inout] io_psWriter The bit writer, holding fewer than 8 bits.
+ * @return size_t The number of bytes coded.
+ */
+__attribute__((target("avx2"))) static size_t encodeGroupsAvx2(
+    const sHuffmanCodeTable_t* i_psCodeTable, const uint8_t* i_pInput,
+    size_t i_inputSize, sBitWriter_t* io_psWriter) {
+  /* Each entry holds a code in its low half and its length above it. */
+  uint32_t aEntries[HUFFMAN_ALPHABET_SIZE];
+  for (size_t symbol = 0; symbol < HUFFMAN_ALPHABET_SIZE; symbol++) {
+    aEntries[symbol] = i_psCodeTable->aCodes[symbol] |
+                       ((uint32_t)i_psCodeTable->aCodeLengths[symbol] << 16);
+  }
+
+  const __m256i codeMask = _mm256_set1_epi32(0xFFFF);
+  const __m256i lowMask = _mm256_set1_epi64x(0xFFFFFFFF);
+
+  size_t i = 0;
+  for (; i + 8 + 128 <= i_inputSize; i += 8) {
+    const uint8_t* p = &i_pInput[i];
+    const __m256i entries = _mm256_setr_epi32(
+        (int)aEntries[p[0]], (int)aEntries[p[1]], (int)aEntries[p[2]],
+        (int)aEntries[p[3]], (int)aEntries[p[4]], (int)aEntries[p[5]],
+        (int)aEntries[p[6]], (int)aEntries[p[7]]);
+    const __m256i codes = _mm256_and_si256(entries, codeMask);
+    const __m256i lengths = _mm256_srli_epi32(entries, 16);
+
+    /* Join each even code with the odd code after it, at most 30 bits. */
+    const __m256i oddShifted =
+        _mm256_sllv_epi32(codes, _mm256_slli_epi64(lengths, 32));
+    const __m256i pairs = _mm256_or_si256(
+        _mm256_and_si256(oddShifted, lowMask),
+        _mm256_srli_epi64(oddShifted, 32));
+    const __m256i pairLengths = _mm256_add_epi64(
+        _mm256_and_si256(lengths, lowMask), _mm256_srli_epi64(lengths, 32));
+
+    /* Join the two pairs in each half, at most 60 bits. */
+    const __m256i highShifted =
+        _mm256_sllv_epi64(pairs, _mm256_slli_si256(pairLengths, 8));
+    const __m256i quads =
+        _mm256_or_si256(highShifted, _mm256_srli_si256(highShifted, 8));
+    const __m256i quadLengths =
+        _mm256_add_epi64(pairLengths, _mm256_srli_si256(pairLengths, 8));
+
+    const __m128i quadsHigh = _mm256_extracti128_si256(quads, 1);
+    const __m128i lengthsHigh = _mm256_extracti128_si256(quadLengths, 1);
+    const uint64_t lowWord =
+        (uint64_t)_mm_cvtsi128_si64(_mm256_castsi256_si128(quads));
+    const uint64_t highWord = (uint64_t)_mm_cvtsi128_si64(quadsHigh);
+    const size_t lowCount =
+        (size_t)_mm_cvtsi128_si64(_mm256_castsi256_si128(quadLengths));
+    const size_t highCount = (size_t)_mm_cvtsi128_si64(lengthsHigh);
+
+    /* Join the two words into at most 120 bits. */
+    const uint64_t first = lowWord | (highWord << lowCount);
+    const uint64_t second = (highWord >> 1) >> (63 - lowCount);
+    appendWide(io_psWriter, first, second, lowCount + highCount);
+  }
+  return i;
+}
+
+/**
+ * @brief Code groups of 32 bytes of a tiny alphabet with pshufb lookups.
+ *
+ * Each byte's slot is looked up by its high nibble, and its code, length
+ * and scale by its slot, all from tables held in registers. Neighbouring
+ * codes are joined into 16-bit pairs by pmaddubsw, multiplying each odd code
+ * by the scale of the even code before it. Pairs are then joined into
+ * 32-bit and 64-bit words by shifting each later half by the length before
+ * it. The four words of at most 56 bits are appended two at a time while at
+ * least 128 more bytes follow.
+ *
+ * @param[in] i_psAlphabet The tables of the alphabet.
+ * @param[in] i_pInput The bytes to code.
+ * @param[in] i_inputSize The number of bytes to code.
+ * @param[inout] io_psWriter The bit writer, holding fewer than 8 bits.
+ * @return size_t The number of bytes coded.
+ */
+__attribute__((target("avx2"))) static size_t encodeTinyGroupsAvx2(
+    const sTinyAlphabet_t* i_psAlphabet, const uint8_t* i_pInput,
+    size_t i_inputSize, sBitWriter_t* io_psWriter) {
+  const __m256i slotOffsets = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128((const __m128i*)i_psAlphabet->aSlotOffsets));
+  const __m256i codeTable = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128((const __m128i*)i_psAlphabet->aCodes));
+  const __m256i lengthTable = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128((const __m128i*)i_psAlphabet->aLengths));
+  const __m256i scaleTable = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128((const __m128i*)i_psAlphabet->aScales));
+  const __m256i nibbleMask = _mm256_set1_epi8(0x0F);
+  const __m256i ones = _mm256_set1_epi8(1);
+  const __m256i pairMask = _mm256_set1_epi32(0xFFFF);
+  const __m256i lowMask = _mm256_set1_epi64x(0xFFFFFFFF);
+
+  size_t i = 0;
+  for (; i + 32 + 128 <= i_inputSize; i += 32) {
+    const __m256i bytes =
+        _mm256_loadu_si256((const __m256i*)&i_pInput[i]);
+    const __m256i highs =
+        _mm256_and_si256(_mm256_srli_epi16(bytes, 4), nibbleMask);
+    const __m256i slots = _mm256_and_si256(
+        _mm256_add_epi8(bytes, _mm256_shuffle_epi8(slotOffsets, highs)),
+        nibbleMask);
+    const __m256i codes = _mm256_shuffle_epi8(codeTable, slots);
+    const __m256i lengths = _mm256_shuffle_epi8(lengthTable, slots);
+    const __m256i scales = _mm256_shuffle_epi8(scaleTable, slots);
+
+    /* Join each even code with the odd code after it, at most 14 bits. */
+    const __m256i multipliers = _mm256_or_si256(
+        _mm256_slli_epi16(scales, 8), _mm256_set1_epi16(1));
+    const __m256i pairs = _mm256_maddubs_epi16(multipliers, codes);
+    const __m256i pairLengths = _mm256_maddubs_epi16(lengths, ones);
+
+    /* Join neighbouring pairs, at most 28 bits. */
+    const __m256i quads = _mm256_or_si256(
+        _mm256_and_si256(pairs, pairMask),
+        _mm256_sllv_epi32(_mm256_srli_epi32(pairs, 16),
+                          _mm256_and_si256(pairLengths, pairMask)));
+    const __m256i quadLengths =
+        _mm256_add_epi32(_mm256_and_si256(pairLengths, pairMask),
+                         _mm256_srli_epi32(pairLengths, 16));
+
+    /* Join neighbouring quads, at most 56 bits. */
+    const __m256i octets = _mm256_or_si256(
+        _mm256_and_si256(quads, lowMask),
+        _mm256_sllv_epi64(_mm256_srli_epi64(quads, 32),
+                          _mm256_and_si256(quadLengths, lowMask)));
+    const __m256i octetLengths =
+        _mm256_add_epi64(_mm256_and_si256(quadLengths, lowMask),
+                         _mm256_srli_epi64(quadLengths, 32));
+
+    uint64_t aWords[4];
+    uint64_t aCounts[4];
+    _mm256_storeu_si256((__m256i*)aWords, octets);
+    _mm256_storeu_si256((__m256i*)aCounts, octetLengths);
+    for (size_t k = 0; k < 4; k += 2) {
+      const uint64_t first = aWords[k] | (aWords[k + 1] << aCounts[k]);
+      const uint64_t second = (aWords[k + 1] >> 1) >> (63 - aCounts[k]);
+      appendWide(io_psWriter, first, second,
+                 (size_t)(aCounts[k] + aCounts[k + 1]));
+    }
+  }
+  return i;
+}
+
+/**
+ * @brief Select the fastest supported encode kernel at startup.
+ *
+ */
+__attribute__((constructor)) static void selectEncodeKernel(void) {
+  __builtin_cpu_init();
+  (void)setEncodeKernel(HUFFMAN_ENCODE_KERNEL_AVX2);
+}
+#endif
+
+/**
+ * @brief Find whether an encode kernel can run on this CPU.
+ *
+ * @param[in] i_eKernel The encode kernel.
+ * @return bool Whether the kernel is built in and supported by the CPU.
+ */
+bool isEncodeKernelSupported(eHuffmanEncodeKernel_t i_eKernel) {
+  switch (i_eKernel) {
+    case HUFFMAN_ENCODE_KERNEL_PORTABLE:
+      return true;
+#ifdef HUFFMAN_HAS_AVX2_KERNEL
+    case HUFFMAN_ENCODE_KERNEL_AVX2:
+      return __builtin_cpu_supports("avx2") != 0;
+#endif
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief Find the encode kernel in use.
+ *
+ * @return eHuffmanEncodeKernel_t The encode kernel.
+ */
+eHuffmanEncodeKernel_t getEncodeKernel(void) { return g_eEncodeKernel; }
+
+/**
+ * @brief Select the encode kernel, e.g. to compare kernels.
+ *
+ * This function must not be called while other threads are encoding.
+ *
+ * @param[in] i_eKernel The encode kernel.
+ * @return int EXIT_SUCCESS if the kernel was selected, else EXIT_FAILURE if
+ * it is not supported.
+ */
+int setEncodeKernel(eHuffmanEncodeKernel_t i_eKernel) {
+  if (!isEncodeKernelSupported(i_eKernel)) {
+    return EXIT_FAILURE;
+  }
+
+  g_eEncodeKernel = i_eKernel;
+#ifdef HUFFMAN_HAS_AVX2_KERNEL
+  if (i_eKernel == HUFFMAN_ENCODE_KERNEL_AVX2) {
+    g_pfnEncodeKernel = encodeAvx2;
+    return EXIT_SUCCESS;
+  }
+#endif
+  g_pfnEncodeKernel = encodePortable;
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Get the name of an encode kernel.
+ *
+ * @param[in] i_eKernel The encode kernel.
+ * @return const char* The name of the kernel.
+ */
+const char* getEncodeKernelName(eHuffmanEncodeKernel_t i_eKernel) {
+  if ((int)i_eKernel < 0 || i_eKernel >= HUFFMAN_ENCODE_KERNEL_MAX) {
+    return "unknown";
+  }
+  return KERNEL_NAMES[i_eKernel];
+}
+
+/**
+ * @brief Write the code of each byte with a canonical code table.
+ *
+ * Every byte must have a code in the table.
+ *
+ * @param[in] i_psCodeTable The canonical code table.
+ * @param[in] i_pInput The bytes to code.
+ * @param[in] i_inputSize The number of bytes to code.
+ * @param[inout] io_psWriter The bit writer to write the codes to.
+ */
+void encodeTableSymbols(const sHuffmanCodeTable_t* i_psCodeTable,
+                        const uint8_t* i_pInput, size_t i_inputSize,
+                        sBitWriter_t* io_psWriter) {
+  g_pfnEncodeKernel(i_psCodeTable, i_pInput, i_inputSize, io_psWriter);
+}
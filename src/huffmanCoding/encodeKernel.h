@@ -0,0 +1,93 @@
+/**
+ * @file encodeKernel.h
+ * @brief Code table encoding kernels with runtime CPU dispatch.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ * An encode kernel writes the code of each input byte to a bit writer. The
+ * portable kernel is always available. On x86-64 an AVX2 kernel, which
+ * gathers the codes of eight bytes at once and packs them in registers by
+ * the running sum of their lengths, is selected once at startup when cpuid
+ * reports AVX2 support. For alphabets of at most HUFFMAN_TINY_ALPHABET_SIZE
+ * symbols with codes of at most 7 bits, such as hex digests or DNA bases,
+ * the AVX2 kernel instead looks up the codes of 32 bytes at once with
+ * in-register pshufb tables. Every kernel writes identical bits.
+ */
+
+#ifndef ENCODE_KERNEL_H
+#define ENCODE_KERNEL_H
+
+/* Standard Library Includes */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Project Includes */
+
+#include "huffmanCoding/bitStream.h"
+#include "huffmanCoding/huffmanTree.h"
+
+/* Type Definitions */
+
+/**
+ * @brief The encode kernels.
+ */
+typedef enum eHuffmanEncodeKernel {
+  HUFFMAN_ENCODE_KERNEL_PORTABLE, /**< Plain C, for any CPU. */
+  HUFFMAN_ENCODE_KERNEL_AVX2,     /**< x86-64 with AVX2. */
+  HUFFMAN_ENCODE_KERNEL_MAX
+} eHuffmanEncodeKernel_t;
+
+/* Function Prototypes */
+
+/**
+ * @brief Find whether an encode kernel can run on this CPU.
+ *
+ * @param[in] i_eKernel The encode kernel.
+ * @return bool Whether the kernel is built in and supported by the CPU.
+ */
+extern bool isEncodeKernelSupported(eHuffmanEncodeKernel_t i_eKernel);
+
+/**
+ * @brief Find the encode kernel in use.
+ *
+ * @return eHuffmanEncodeKernel_t The encode kernel.
+ */
+extern eHuffmanEncodeKernel_t getEncodeKernel(void);
+
+/**
+ * @brief Select the encode kernel, e.g. to compare kernels.
+ *
+ * This function must not be called while other threads are encoding.
+ *
+ * @param[in] i_eKernel The encode kernel.
+ * @return int EXIT_SUCCESS if the kernel was selected, else EXIT_FAILURE if
+ * it is not supported.
+ */
+extern int setEncodeKernel(eHuffmanEncodeKernel_t i_eKernel);
+
+/**
+ * @brief Get the name of an encode kernel.
+ *
+ * @param[in] i_eKernel The encode kernel.
+ * @return const char* The name of the kernel.
+ */
+extern const char* getEncodeKernelName(eHuffmanEncodeKernel_t i_eKernel);
+
+/**
+ * @brief Write the code of each byte with a canonical code table.
+ *
+ * Every byte must have a code in the table.
+ *
+ * @param[in] i_psCodeTable The canonical code table.
+ * @param[in] i_pInput The bytes to code.
+ * @param[in] i_inputSize The number of bytes to code.
+ * @param[inout] io_psWriter The bit writer to write the codes to.
+ */
+extern void encodeTableSymbols(const sHuffmanCodeTable_t* i_psCodeTable,
+                               const uint8_t* i_pInput, size_t i_inputSize,
+                               sBitWriter_t* io_psWriter);
+
+#endif  // ENCODE_KERNEL_H
@@ -0,0 +1,298 @@
+/**
+ * @file histogram.c
+ * @brief Merge and serialize byte frequency tables.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+/* Standard Library Includes */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Project Includes */
+
+#include "huffmanCoding/histogram.h"
+#include "huffmanCoding/task3.h"
+#include "huffmanCoding/task4.h"
+
+/* Constants */
+
+/**< The magic bytes at the start of a serialized histogram. */
+static const uint8_t HISTOGRAM_MAGIC[4] = {'H', 'U', 'F', 'H'};
+
+/* Function Prototypes */
+
+/**
+ * @brief Add frequencies into a histogram, unless any would overflow.
+ *
+ * @param[inout] io_psHistogram The histogram.
+ * @param[in] i_aFrequencies The frequency of each byte value to add.
+ * @return int EXIT_SUCCESS if the frequencies were added, else EXIT_FAILURE.
+ */
+static int addFrequencies(
+    sHuffmanHistogram_t* io_psHistogram,
+    const size_t i_aFrequencies[LETTER_FREQUENCY_ALPHABET_SIZE]);
+
+/* Function Definitions */
+
+/**
+ * @brief Add frequencies into a histogram, unless any would overflow.
+ *
+ * @param[inout] io_psHistogram The histogram.
+ * @param[in] i_aFrequencies The frequency of each byte value to add.
+ * @return int EXIT_SUCCESS if the frequencies were added, else EXIT_FAILURE.
+ */
+static int addFrequencies(
+    sHuffmanHistogram_t* io_psHistogram,
+    const size_t i_aFrequencies[LETTER_FREQUENCY_ALPHABET_SIZE]) {
+  for (size_t i = 0; i < LETTER_FREQUENCY_ALPHABET_SIZE; i++) {
+    if (i_aFrequencies[i] > SIZE_MAX - io_psHistogram->aFrequencies[i]) {
+      (void)fprintf(stderr, "ERROR: Histogram frequency overflow\n");
+      return EXIT_FAILURE;
+    }
+  }
+
+  for (size_t i = 0; i < LETTER_FREQUENCY_ALPHABET_SIZE; i++) {
+    io_psHistogram->aFrequencies[i] += i_aFrequencies[i];
+  }
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Initialise a histogram with every frequency 0.
+ *
+ * @param[out] o_psHistogram The histogram to initialise.
+ */
+void initHuffmanHistogram(sHuffmanHistogram_t* o_psHistogram) {
+  (void)memset(o_psHistogram, 0, sizeof(*o_psHistogram));
+}
+
+/**
+ * @brief Count the bytes of a buffer into a histogram.
+ *
+ * @param[inout] io_psHistogram The histogram.
+ * @param[in] i_pData The bytes to count.
+ * @param[in] i_size The number of bytes to count.
+ * @return int EXIT_SUCCESS if the bytes were counted, else EXIT_FAILURE if a
+ * frequency would overflow, leaving the histogram unchanged.
+ */
+int addBytesToHuffmanHistogram(sHuffmanHistogram_t* io_psHistogram,
+                               const uint8_t* i_pData, size_t i_size) {
+  size_t aFrequencies[LETTER_FREQUENCY_ALPHABET_SIZE];
+  countByteFrequencies(i_pData, i_size, aFrequencies);
+  return addFrequencies(io_psHistogram, aFrequencies);
+}
+
+/**
+ * @brief Count the pairs of a letter-frequency list into a histogram.
+ *
+ * @param[inout] io_psHistogram The histogram.
+ * @param[in] i_psHead The head of the letter-frequency list.
+ * @return int EXIT_SUCCESS if the pairs were counted, else EXIT_FAILURE if a
+ * frequency would overflow, leaving the histogram unchanged.
+ */
+int addLetterFrequencyListToHuffmanHistogram(
+    sHuffmanHistogram_t* io_psHistogram,
+    const sLetterFrequencyNode_t* i_psHead) {
+  size_t aFrequencies[LETTER_FREQUENCY_ALPHABET_SIZE] = {0};
+  for (const sLetterFrequencyNode_t* psNode = i_psHead; psNode != NULL;
+       psNode = psNode->psNext) {
+    const uint8_t byte = (uint8_t)psNode->sLetterFrequencyPair.character;
+    if (psNode->sLetterFrequencyPair.frequency >
+        SIZE_MAX - aFrequencies[byte]) {
+      (void)fprintf(stderr, "ERROR: Histogram frequency overflow\n");
+      return EXIT_FAILURE;
+    }
+    aFrequencies[byte] += psNode->sLetterFrequencyPair.frequency;
+  }
+  return addFrequencies(io_psHistogram, aFrequencies);
+}
+
+/**
+ * @brief Add one histogram into another.
+ *
+ * Merging is associative and commutative, so shards may be merged in any
+ * order and grouping.
+ *
+ * @param[inout] io_psHistogram The histogram to add to.
+ * @param[in] i_psOther The histogram to add.
+ * @return int EXIT_SUCCESS if the histograms were merged, else EXIT_FAILURE
+ * if a frequency would overflow, leaving the histogram unchanged.
+ */
+int mergeHuffmanHistograms(sHuffmanHistogram_t* io_psHistogram,
+                           const sHuffmanHistogram_t* i_psOther) {
+  return addFrequencies(io_psHistogram, i_psOther->aFrequencies);
+}
+
+/**
+ * @brief Serialize a histogram.
+ *
+ * @param[in] i_psHistogram The histogram.
+ * @param[out] o_pOutput The buffer to write the histogram to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @param[out] o_pOutputSize The number of bytes written to the output.
+ * @return int EXIT_SUCCESS if the histogram was serialized, else
+ * EXIT_FAILURE.
+ */
+int serializeHuffmanHistogram(const sHuffmanHistogram_t* i_psHistogram,
+                              uint8_t* o_pOutput, size_t i_outputCapacity,
+                              size_t* o_pOutputSize) {
+  if (i_outputCapacity < HUFFMAN_HISTOGRAM_HEADER_SIZE) {
+    (void)fprintf(stderr, "ERROR: Output buffer is too small\n");
+    return EXIT_FAILURE;
+  }
+
+  (void)memset(o_pOutput, 0, HUFFMAN_HISTOGRAM_HEADER_SIZE);
+  (void)memcpy(o_pOutput, HISTOGRAM_MAGIC, sizeof(HISTOGRAM_MAGIC));
+  o_pOutput[4] = HUFFMAN_HISTOGRAM_VERSION;
+  uint8_t* pBitmap = &o_pOutput[8];
+  size_t position = HUFFMAN_HISTOGRAM_HEADER_SIZE;
+
+  for (size_t i = 0; i < LETTER_FREQUENCY_ALPHABET_SIZE; i++) {
+    uint64_t frequency = (uint64_t)i_psHistogram->aFrequencies[i];
+    if (frequency == 0) {
+      continue;
+    }
+    pBitmap[i / 8] |= (uint8_t)(1U << (i % 8));
+
+    /* Write the frequency seven bits at a time, lowest first. */
+    do {
+      if (position == i_outputCapacity) {
+        (void)fprintf(stderr, "ERROR: Output buffer is too small\n");
+        return EXIT_FAILURE;
+      }
+      const uint8_t bits = (uint8_t)(frequency & 0x7FU);
+      frequency >>= 7;
+      o_pOutput[position++] = (frequency != 0) ? (bits | 0x80U) : bits;
+    } while (frequency != 0);
+  }
+
+  *o_pOutputSize = position;
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Read a serialized histogram.
+ *
+ * @param[in] i_pInput The serialized histogram.
+ * @param[in] i_inputSize The number of bytes in the serialized histogram.
+ * @param[out] o_psHistogram The histogram.
+ * @return int EXIT_SUCCESS if the histogram is valid, else EXIT_FAILURE.
+ */
+int deserializeHuffmanHistogram(const uint8_t* i_pInput, size_t i_inputSize,
+                                sHuffmanHistogram_t* o_psHistogram) {
+  if (i_inputSize < HUFFMAN_HISTOGRAM_HEADER_SIZE ||
+      memcmp(i_pInput, HISTOGRAM_MAGIC, sizeof(HISTOGRAM_MAGIC)) != 0 ||
+      i_pInput[4] != HUFFMAN_HISTOGRAM_VERSION) {
+    (void)fprintf(stderr, "ERROR: Not a Huffman histogram\n");
+    return EXIT_FAILURE;
+  }
+
+  initHuffmanHistogram(o_psHistogram);
+  const uint8_t* pBitmap = &i_pInput[8];
+  size_t position = HUFFMAN_HISTOGRAM_HEADER_SIZE;
+
+  for (size_t i = 0; i < LETTER_FREQUENCY_ALPHABET_SIZE; i++) {
+    if ((pBitmap[i / 8] & (1U << (i % 8))) == 0) {
+      continue;
+    }
+
+    /* Every counted byte has a non-zero frequency that fits in a size_t. */
+    uint64_t frequency = 0;
+    unsigned shift = 0;
+    uint8_t byte = 0x80U;
+    while ((byte & 0x80U) != 0) {
+      if (position == i_inputSize || shift >= 64) {
+        (void)fprintf(stderr, "ERROR: Histogram is corrupt\n");
+        return EXIT_FAILURE;
+      }
+      byte = i_pInput[position++];
+      const uint64_t bits = (uint64_t)(byte & 0x7FU);
+      if (shift > 0 && (bits >> (64 - shift)) != 0) {
+        (void)fprintf(stderr, "ERROR: Histogram is corrupt\n");
+        return EXIT_FAILURE;
+      }
+      frequency |= bits << shift;
+      shift += 7;
+    }
+    if (frequency == 0 || frequency > SIZE_MAX) {
+      (void)fprintf(stderr, "ERROR: Histogram is corrupt\n");
+      return EXIT_FAILURE;
+    }
+    o_psHistogram->aFrequencies[i] = (size_t)frequency;
+  }
+
+  if (position != i_inputSize) {
+    (void)fprintf(stderr, "ERROR: Histogram is corrupt\n");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Write a serialized histogram to a file.
+ *
+ * @param[in] i_psHistogram The histogram.
+ * @param[in] i_pPath The path of the file to write.
+ * @return int EXIT_SUCCESS if the file was written, else EXIT_FAILURE.
+ */
+int writeHuffmanHistogramFile(const sHuffmanHistogram_t* i_psHistogram,
+                              const char* i_pPath) {
+  uint8_t aBuffer[HUFFMAN_HISTOGRAM_MAX_SERIALIZED_SIZE];
+  size_t size = 0;
+  if (serializeHuffmanHistogram(i_psHistogram, aBuffer, sizeof(aBuffer),
+                                &size) == EXIT_FAILURE) {
+    return EXIT_FAILURE;
+  }
+
+  FILE* pFile = fopen(i_pPath, "wb");
+  if (pFile == NULL) {
+    perror(i_pPath);
+    return EXIT_FAILURE;
+  }
+  int result = EXIT_SUCCESS;
+  if (fwrite(aBuffer, 1, size, pFile) != size) {
+    perror(i_pPath);
+    result = EXIT_FAILURE;
+  }
+  if (fclose(pFile) != 0 && result == EXIT_SUCCESS) {
+    perror(i_pPath);
+    result = EXIT_FAILURE;
+  }
+  return result;
+}
+
+/**
+ * @brief Read a serialized histogram from a file.
+ *
+ * @param[in] i_pPath The path of the file to read.
+ * @param[out] o_psHistogram The histogram.
+ * @return int EXIT_SUCCESS if the file holds a valid histogram, else
+ * EXIT_FAILURE.
+ */
+int readHuffmanHistogramFile(const char* i_pPath,
+                             sHuffmanHistogram_t* o_psHistogram) {
+  FILE* pFile = fopen(i_pPath, "rb");
+  if (pFile == NULL) {
+    perror(i_pPath);
+    return EXIT_FAILURE;
+  }
+
+  /* Read one byte more than the largest histogram to detect longer files. */
+  uint8_t aBuffer[HUFFMAN_HISTOGRAM_MAX_SERIALIZED_SIZE + 1];
+  const size_t size = fread(aBuffer, 1, sizeof(aBuffer), pFile);
+  const int isReadError = ferror(pFile);
+  (void)fclose(pFile);
+  if (isReadError != 0) {
+    perror(i_pPath);
+    return EXIT_FAILURE;
+  }
+
+  return deserializeHuffmanHistogram(aBuffer, size, o_psHistogram);
+}
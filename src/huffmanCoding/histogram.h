@@ -0,0 +1,156 @@
+/**
+ * @file histogram.h
+ * @brief Merge and serialize byte frequency tables.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ * A histogram holds the frequency of each byte value, as counted by
+ * countByteFrequencies or listed by createLetterFrequencyListFromText.
+ * Merging adds two histograms together, so shards of a data set can be
+ * counted separately, in any order and in any grouping, and merged into the
+ * histogram of the whole data set.
+ *
+ * A serialized histogram is laid out as follows:
+ *
+ *   header     "HUFH", uint8 version, 3 reserved bytes
+ *   bitmap     32 bytes, bit (b % 8) of byte (b / 8) set if b is counted
+ *   frequency* a LEB128 varint for each counted byte value, in ascending order
+ *
+ * so the histogram of text with few distinct bytes takes a few dozen bytes.
+ */
+
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+/* Standard Library Includes */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Project Includes */
+
+#include "huffmanCoding/task3.h"
+#include "huffmanCoding/task4.h"
+
+/* Constants */
+
+/**< The histogram serialization format version. */
+#define HUFFMAN_HISTOGRAM_VERSION 1
+
+/**< The number of bytes in a serialized histogram's header and bitmap. */
+#define HUFFMAN_HISTOGRAM_HEADER_SIZE (8 + LETTER_FREQUENCY_ALPHABET_SIZE / 8)
+
+/**< The most bytes in a serialized frequency. */
+#define HUFFMAN_HISTOGRAM_MAX_VARINT_SIZE 10
+
+/**< The most bytes in a serialized histogram. */
+#define HUFFMAN_HISTOGRAM_MAX_SERIALIZED_SIZE \
+  (HUFFMAN_HISTOGRAM_HEADER_SIZE +            \
+   LETTER_FREQUENCY_ALPHABET_SIZE * HUFFMAN_HISTOGRAM_MAX_VARINT_SIZE)
+
+/* Type Definitions */
+
+/**
+ * @brief The frequency of each byte value.
+ */
+typedef struct sHuffmanHistogram {
+  size_t aFrequencies[LETTER_FREQUENCY_ALPHABET_SIZE];
+} sHuffmanHistogram_t;
+
+/* Function Prototypes */
+
+/**
+ * @brief Initialise a histogram with every frequency 0.
+ *
+ * @param[out] o_psHistogram The histogram to initialise.
+ */
+extern void initHuffmanHistogram(sHuffmanHistogram_t* o_psHistogram);
+
+/**
+ * @brief Count the bytes of a buffer into a histogram.
+ *
+ * @param[inout] io_psHistogram The histogram.
+ * @param[in] i_pData The bytes to count.
+ * @param[in] i_size The number of bytes to count.
+ * @return int EXIT_SUCCESS if the bytes were counted, else EXIT_FAILURE if a
+ * frequency would overflow, leaving the histogram unchanged.
+ */
+extern int addBytesToHuffmanHistogram(sHuffmanHistogram_t* io_psHistogram,
+                                      const uint8_t* i_pData, size_t i_size);
+
+/**
+ * @brief Count the pairs of a letter-frequency list into a histogram.
+ *
+ * @param[inout] io_psHistogram The histogram.
+ * @param[in] i_psHead The head of the letter-frequency list.
+ * @return int EXIT_SUCCESS if the pairs were counted, else EXIT_FAILURE if a
+ * frequency would overflow, leaving the histogram unchanged.
+ */
+extern int addLetterFrequencyListToHuffmanHistogram(
+    sHuffmanHistogram_t* io_psHistogram,
+    const sLetterFrequencyNode_t* i_psHead);
+
+/**
+ * @brief Add one histogram into another.
+ *
+ * Merging is associative and commutative, so shards may be merged in any
+ * order and grouping.
+ *
+ * @param[inout] io_psHistogram The histogram to add to.
+ * @param[in] i_psOther The histogram to add.
+ * @return int EXIT_SUCCESS if the histograms were merged, else EXIT_FAILURE
+ * if a frequency would overflow, leaving the histogram unchanged.
+ */
+extern int mergeHuffmanHistograms(sHuffmanHistogram_t* io_psHistogram,
+                                  const sHuffmanHistogram_t* i_psOther);
+
+/**
+ * @brief Serialize a histogram.
+ *
+ * @param[in] i_psHistogram The histogram.
+ * @param[out] o_pOutput The buffer to write the histogram to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @param[out] o_pOutputSize The number of bytes written to the output.
+ * @return int EXIT_SUCCESS if the histogram was serialized, else
+ * EXIT_FAILURE.
+ */
+extern int serializeHuffmanHistogram(const sHuffmanHistogram_t* i_psHistogram,
+                                     uint8_t* o_pOutput,
+                                     size_t i_outputCapacity,
+                                     size_t* o_pOutputSize);
+
+/**
+ * @brief Read a serialized histogram.
+ *
+ * @param[in] i_pInput The serialized histogram.
+ * @param[in] i_inputSize The number of bytes in the serialized histogram.
+ * @param[out] o_psHistogram The histogram.
+ * @return int EXIT_SUCCESS if the histogram is valid, else EXIT_FAILURE.
+ */
+extern int deserializeHuffmanHistogram(const uint8_t* i_pInput,
+                                       size_t i_inputSize,
+                                       sHuffmanHistogram_t* o_psHistogram);
+
+/**
+ * @brief Write a serialized histogram to a file.
+ *
+ * @param[in] i_psHistogram The histogram.
+ * @param[in] i_pPath The path of the file to write.
+ * @return int EXIT_SUCCESS if the file was written, else EXIT_FAILURE.
+ */
+extern int writeHuffmanHistogramFile(const sHuffmanHistogram_t* i_psHistogram,
+                                     const char* i_pPath);
+
+/**
+ * @brief Read a serialized histogram from a file.
+ *
+ * @param[in] i_pPath The path of the file to read.
+ * @param[out] o_psHistogram The histogram.
+ * @return int EXIT_SUCCESS if the file holds a valid histogram, else
+ * EXIT_FAILURE.
+ */
+extern int readHuffmanHistogramFile(const char* i_pPath,
+                                    sHuffmanHistogram_t* o_psHistogram);
+
+#endif  // HISTOGRAM_H
@@ -0,0 +1,584 @@
+/**
+ * @file huffman.hpp
+ * @brief C++ interface to the Huffman codec.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ * Encoder, Decoder and CodeTable own their C contexts, tables and trees and
+ * are move-only. Input and output are passed as non-owning byte spans, so no
+ * bytes are copied in or out of the codec. Memory is allocated from a
+ * std::pmr::memory_resource, and only when an object is created or a table is
+ * built; compressing and decompressing never allocate. Errors are returned
+ * as values rather than thrown.
+ */
+
+#ifndef HUFFMAN_HPP
+#define HUFFMAN_HPP
+
+/* Standard Library Includes */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/* Project Includes */
+
+extern "C" {
+#include "huffmanCoding/allocator.h"
+#include "huffmanCoding/codec.h"
+#include "huffmanCoding/huffmanTree.h"
+#include "huffmanCoding/task4.h"
+#include "huffmanCoding/task6.h"
+}
+
+namespace huffman {
+
+/* Type Definitions */
+
+/**
+ * @brief The reason an operation failed.
+ */
+enum class Error {
+  None,            /**< The operation succeeded. */
+  OutOfMemory,     /**< The memory resource could not allocate. */
+  InvalidArgument, /**< An option or argument is out of range. */
+  OutputTooSmall,  /**< The output span cannot hold the result. */
+  CorruptInput,    /**< The input is not a valid container or table. */
+};
+
+/**
+ * @brief The outcome of an operation that produces bytes.
+ */
+struct Result {
+  Error error = Error::None;
+  std::size_t size = 0; /**< The number of bytes written on success. */
+
+  /**
+   * @brief Check whether the operation succeeded.
+   *
+   * @return true if the error is Error::None.
+   */
+  explicit operator bool() const noexcept { return error == Error::None; }
+};
+
+/**
+ * @brief A non-owning view of a contiguous range of bytes.
+ *
+ * @tparam T The byte type, const-qualified for read-only views.
+ */
+template <typename T>
+class BasicByteSpan {
+ public:
+  constexpr BasicByteSpan() noexcept = default;
+
+  /**
+   * @brief View a range of bytes.
+   *
+   * @param i_pData The first byte.
+   * @param i_size The number of bytes.
+   */
+  constexpr BasicByteSpan(T* i_pData, std::size_t i_size) noexcept
+      : m_pData(i_pData), m_size(i_size) {}
+
+  /**
+   * @brief View the bytes of an array.
+   *
+   * @param i_aData The array, which must outlive the span.
+   */
+  template <std::size_t N>
+  constexpr BasicByteSpan(T (&i_aData)[N]) noexcept
+      : m_pData(i_aData), m_size(N) {}
+
+  /**
+   * @brief View the bytes of a contiguous container, e.g. std::vector.
+   *
+   * @param i_container The container, which must outlive the span.
+   */
+  template <typename Container,
+            typename = std::enable_if_t<std::is_convertible_v<
+                decltype(std::declval<Container&>().data()), T*>>>
+  constexpr BasicByteSpan(Container& i_container) noexcept
+      : m_pData(i_container.data()), m_size(i_container.size()) {}
+
+  constexpr T* data() const noexcept { return m_pData; }
+  constexpr std::size_t size() const noexcept { return m_size; }
+  constexpr bool empty() const noexcept { return m_size == 0; }
+
+ private:
+  T* m_pData = nullptr;
+  std::size_t m_size = 0;
+};
+
+using ByteSpan = BasicByteSpan<const std::uint8_t>;
+using MutableByteSpan = BasicByteSpan<std::uint8_t>;
+
+namespace detail {
+
+/**
+ * @brief A C allocator that forwards to a memory resource.
+ *
+ * The C free function is not given the size of the allocation, so each
+ * allocation is prefixed with a header holding its size.
+ */
+struct ResourceAllocator {
+  sHuffmanAllocator_t sAllocator;
+  std::pmr::memory_resource* pResource;
+};
+
+/**
+ * @brief Allocation header, padded to keep the user memory aligned.
+ */
+union AllocationHeader {
+  std::max_align_t alignment;
+  std::size_t size;
+};
+
+/**
+ * @brief Allocate from the memory resource of a ResourceAllocator.
+ *
+ * @param io_pUser The ResourceAllocator.
+ * @param i_size The number of bytes to allocate.
+ * @return void* The allocated memory, else nullptr.
+ */
+inline void* allocateFromResource(void* io_pUser, std::size_t i_size) {
+  auto* pAllocator = static_cast<ResourceAllocator*>(io_pUser);
+  try {
+    auto* pHeader = static_cast<AllocationHeader*>(
+        pAllocator->pResource->allocate(sizeof(AllocationHeader) + i_size,
+                                        alignof(AllocationHeader)));
+    pHeader->size = i_size;
+    return pHeader + 1;
+  } catch (const std::bad_alloc&) {
+    return nullptr;
+  }
+}
+
+/**
+ * @brief Return memory to the memory resource of a ResourceAllocator.
+ *
+ * @param io_pUser The ResourceAllocator.
+ * @param io_pMemory The memory to free.
+ */
+inline void freeToResource(void* io_pUser, void* io_pMemory) {
+  auto* pAllocator = static_cast<ResourceAllocator*>(io_pUser);
+  AllocationHeader* pHeader = static_cast<AllocationHeader*>(io_pMemory) - 1;
+  pAllocator->pResource->deallocate(pHeader,
+                                    sizeof(AllocationHeader) + pHeader->size,
+                                    alignof(AllocationHeader));
+}
+
+/**
+ * @brief Destroy a ResourceAllocator created by createResourceAllocator.
+ */
+struct ResourceAllocatorDeleter {
+  void operator()(ResourceAllocator* io_pAllocator) const noexcept {
+    io_pAllocator->pResource->deallocate(io_pAllocator,
+                                         sizeof(ResourceAllocator),
+                                         alignof(ResourceAllocator));
+  }
+};
+
+using ResourceAllocatorPtr =
+    std::unique_ptr<ResourceAllocator, ResourceAllocatorDeleter>;
+
+/**
+ * @brief Create a ResourceAllocator in memory from its own resource, so that
+ * its address stays fixed while its owner is moved.
+ *
+ * @param i_pResource The memory resource.
+ * @return ResourceAllocatorPtr The allocator, else nullptr.
+ */
+inline ResourceAllocatorPtr createResourceAllocator(
+    std::pmr::memory_resource* i_pResource) noexcept {
+  try {
+    void* pMemory = i_pResource->allocate(sizeof(ResourceAllocator),
+                                          alignof(ResourceAllocator));
+    auto* pAllocator = new (pMemory) ResourceAllocator{
+        {allocateFromResource, freeToResource, nullptr}, i_pResource};
+    pAllocator->sAllocator.pUser = pAllocator;
+    return ResourceAllocatorPtr(pAllocator);
+  } catch (const std::bad_alloc&) {
+    return nullptr;
+  }
+}
+
+/**
+ * @brief Free a context with freeHuffmanContext.
+ */
+struct ContextDeleter {
+  void operator()(sHuffmanContext_t* io_psContext) const noexcept {
+    freeHuffmanContext(io_psContext);
+  }
+};
+
+using ContextPtr = std::unique_ptr<sHuffmanContext_t, ContextDeleter>;
+
+/**
+ * @brief Free a tree with the allocator that built it.
+ */
+struct TreeDeleter {
+  const sHuffmanAllocator_t* psAllocator = nullptr;
+
+  void operator()(sBinaryTreeNode_t* io_psRoot) const noexcept {
+    freeBinaryTreeWithAllocator(io_psRoot, psAllocator);
+  }
+};
+
+using TreePtr = std::unique_ptr<sBinaryTreeNode_t, TreeDeleter>;
+
+/**
+ * @brief Create a context allocated from a memory resource.
+ *
+ * @param i_pResource The memory resource.
+ * @param o_pAllocator The allocator the context frees itself with.
+ * @return ContextPtr The context, else nullptr.
+ */
+inline ContextPtr createContext(std::pmr::memory_resource* i_pResource,
+                                ResourceAllocatorPtr& o_pAllocator) noexcept {
+  o_pAllocator = createResourceAllocator(i_pResource);
+  if (o_pAllocator == nullptr) {
+    return nullptr;
+  }
+  return ContextPtr(createHuffmanContext(&o_pAllocator->sAllocator));
+}
+
+}  // namespace detail
+
+/* Classes */
+
+/**
+ * @brief Compresses buffers into Huffman containers.
+ *
+ * The encoder owns a context, so repeated calls reuse its scratch memory.
+ */
+class Encoder {
+ public:
+  /**
+   * @brief Create an encoder, allocating its context from a memory resource.
+   * Check isValid() afterwards.
+   *
+   * @param i_pResource The memory resource.
+   * @param i_blockSize The number of uncompressed bytes in each block.
+   */
+  explicit Encoder(
+      std::pmr::memory_resource* i_pResource = std::pmr::get_default_resource(),
+      std::size_t i_blockSize = HUFFMAN_DEFAULT_BLOCK_SIZE) noexcept
+      : m_pContext(detail::createContext(i_pResource, m_pAllocator)) {
+    initCompressOptions(&m_sOptions);
+    m_sOptions.blockSize = i_blockSize;
+  }
+
+  Encoder(const Encoder&) = delete;
+  Encoder& operator=(const Encoder&) = delete;
+  Encoder(Encoder&&) noexcept = default;
+  ~Encoder() = default;
+
+  /**
+   * @brief Take over another encoder's context, freeing this one's context
+   * before the allocator it was allocated with.
+   *
+   * @param io_other The encoder to move from.
+   * @return Encoder& This encoder.
+   */
+  Encoder& operator=(Encoder&& io_other) noexcept {
+    m_pContext = std::move(io_other.m_pContext);
+    m_pAllocator = std::move(io_other.m_pAllocator);
+    m_sOptions = io_other.m_sOptions;
+    return *this;
+  }
+
+  /**
+   * @brief Check whether the context was allocated.
+   *
+   * @return true if the encoder can be used.
+   */
+  bool isValid() const noexcept { return m_pContext != nullptr; }
+
+  /**
+   * @brief Find the output size that compress never exceeds.
+   *
+   * @param i_inputSize The number of bytes to compress.
+   * @return std::size_t The maximum compressed size.
+   */
+  std::size_t getBound(std::size_t i_inputSize) const noexcept {
+    return getCompressBound(i_inputSize, &m_sOptions);
+  }
+
+  /**
+   * @brief Compress a buffer into a container.
+   *
+   * @param i_input The bytes to compress.
+   * @param o_output The buffer to write the container to.
+   * @return Result The number of bytes written, else the error.
+   */
+  Result compress(ByteSpan i_input, MutableByteSpan o_output) noexcept {
+    if (!isValid()) {
+      return {Error::OutOfMemory, 0};
+    }
+    if (m_sOptions.blockSize == 0 ||
+        m_sOptions.blockSize > HUFFMAN_MAX_BLOCK_SIZE) {
+      return {Error::InvalidArgument, 0};
+    }
+
+    /* With a valid block size, the context can only run out of output. */
+    std::size_t outputSize = 0;
+    if (compressBufferWithContext(m_pContext.get(), i_input.data(),
+                                  i_input.size(), o_output.data(),
+                                  o_output.size(), &outputSize,
+                                  &m_sOptions) == EXIT_FAILURE) {
+      return {Error::OutputTooSmall, 0};
+    }
+    return {Error::None, outputSize};
+  }
+
+ private:
+  detail::ResourceAllocatorPtr m_pAllocator;
+  detail::ContextPtr m_pContext;
+  sHuffmanCompressOptions_t m_sOptions;
+};
+
+/**
+ * @brief Decompresses Huffman containers into buffers.
+ *
+ * The decoder owns a context, so repeated calls reuse its scratch memory and
+ * its decode table while the code lengths stay the same.
+ */
+class Decoder {
+ public:
+  /**
+   * @brief Create a decoder, allocating its context from a memory resource.
+   * Check isValid() afterwards.
+   *
+   * @param i_pResource The memory resource.
+   */
+  explicit Decoder(std::pmr::memory_resource* i_pResource =
+                       std::pmr::get_default_resource()) noexcept
+      : m_pContext(detail::createContext(i_pResource, m_pAllocator)) {}
+
+  Decoder(const Decoder&) = delete;
+  Decoder& operator=(const Decoder&) = delete;
+  Decoder(Decoder&&) noexcept = default;
+  ~Decoder() = default;
+
+  /**
+   * @brief Take over another decoder's context, freeing this one's context
+   * before the allocator it was allocated with.
+   *
+   * @param io_other The decoder to move from.
+   * @return Decoder& This decoder.
+   */
+  Decoder& operator=(Decoder&& io_other) noexcept {
+    m_pContext = std::move(io_other.m_pContext);
+    m_pAllocator = std::move(io_other.m_pAllocator);
+    return *this;
+  }
+
+  /**
+   * @brief Check whether the context was allocated.
+   *
+   * @return true if the decoder can be used.
+   */
+  bool isValid() const noexcept { return m_pContext != nullptr; }
+
+  /**
+   * @brief Read the uncompressed size of a container.
+   *
+   * @param i_input The container.
+   * @return Result The uncompressed size, else the error.
+   */
+  static Result getSize(ByteSpan i_input) noexcept {
+    std::size_t size = 0;
+    if (getDecompressedSize(i_input.data(), i_input.size(), &size) ==
+        EXIT_FAILURE) {
+      return {Error::CorruptInput, 0};
+    }
+    return {Error::None, size};
+  }
+
+  /**
+   * @brief Decompress a container into a buffer.
+   *
+   * @param i_input The container.
+   * @param o_output The buffer to write the uncompressed bytes to.
+   * @return Result The number of bytes written, else the error.
+   */
+  Result decompress(ByteSpan i_input, MutableByteSpan o_output) noexcept {
+    if (!isValid()) {
+      return {Error::OutOfMemory, 0};
+    }
+
+    const Result sSize = getSize(i_input);
+    if (!sSize) {
+      return sSize;
+    }
+    if (sSize.size > o_output.size()) {
+      return {Error::OutputTooSmall, 0};
+    }
+
+    std::size_t outputSize = 0;
+    if (decompressBufferWithContext(m_pContext.get(), i_input.data(),
+                                    i_input.size(), o_output.data(),
+                                    o_output.size(),
+                                    &outputSize) == EXIT_FAILURE) {
+      return {Error::CorruptInput, 0};
+    }
+    return {Error::None, outputSize};
+  }
+
+ private:
+  detail::ResourceAllocatorPtr m_pAllocator;
+  detail::ContextPtr m_pContext;
+};
+
+/**
+ * @brief A canonical Huffman code table and the tree it describes.
+ */
+class CodeTable {
+ public:
+  /**
+   * @brief Create an empty code table that allocates its tree from a memory
+   * resource.
+   *
+   * @param i_pResource The memory resource.
+   */
+  explicit CodeTable(std::pmr::memory_resource* i_pResource =
+                         std::pmr::get_default_resource()) noexcept
+      : m_pAllocator(detail::createResourceAllocator(i_pResource)) {}
+
+  CodeTable(const CodeTable&) = delete;
+  CodeTable& operator=(const CodeTable&) = delete;
+  CodeTable(CodeTable&&) noexcept = default;
+  ~CodeTable() = default;
+
+  /**
+   * @brief Take over another code table's tree, freeing this one's tree
+   * before the allocator it was allocated with.
+   *
+   * @param io_other The code table to move from.
+   * @return CodeTable& This code table.
+   */
+  CodeTable& operator=(CodeTable&& io_other) noexcept {
+    m_pTree = std::move(io_other.m_pTree);
+    m_pAllocator = std::move(io_other.m_pAllocator);
+    m_sTable = io_other.m_sTable;
+    return *this;
+  }
+
+  /**
+   * @brief Build the table from the byte frequencies of a buffer.
+   *
+   * @param i_input The bytes to count.
+   * @return Error Error::None on success.
+   */
+  Error build(ByteSpan i_input) noexcept {
+    std::array<std::size_t, HUFFMAN_ALPHABET_SIZE> aFrequencies;
+    countByteFrequencies(i_input.data(), i_input.size(), aFrequencies.data());
+    return build(aFrequencies);
+  }
+
+  /**
+   * @brief Build the table from symbol frequencies.
+   *
+   * @param i_aFrequencies The frequency of each symbol.
+   * @return Error Error::None on success.
+   */
+  Error build(const std::array<std::size_t, HUFFMAN_ALPHABET_SIZE>&
+                  i_aFrequencies) noexcept {
+    if (m_pAllocator == nullptr) {
+      return Error::OutOfMemory;
+    }
+
+    std::array<std::uint8_t, HUFFMAN_ALPHABET_SIZE> aCodeLengths;
+    if (createCodeLengthsFromFrequenciesWithAllocator(
+            i_aFrequencies.data(), aCodeLengths.data(),
+            &m_pAllocator->sAllocator) == EXIT_FAILURE) {
+      return Error::OutOfMemory;
+    }
+    return buildFromCodeLengths(aCodeLengths);
+  }
+
+  /**
+   * @brief Build the table from code lengths, e.g. read from a block header.
+   *
+   * @param i_aCodeLengths The code length of each symbol.
+   * @return Error Error::None on success.
+   */
+  Error buildFromCodeLengths(const std::array<std::uint8_t,
+                                              HUFFMAN_ALPHABET_SIZE>&
+                                 i_aCodeLengths) noexcept {
+    if (m_pAllocator == nullptr) {
+      return Error::OutOfMemory;
+    }
+
+    m_pTree.reset();
+    if (createCanonicalCodeTable(i_aCodeLengths.data(), &m_sTable) ==
+        EXIT_FAILURE) {
+      return Error::CorruptInput;
+    }
+
+    bool isEmpty = true;
+    for (const std::uint8_t length : i_aCodeLengths) {
+      isEmpty = isEmpty && (length == 0);
+    }
+    if (isEmpty) {
+      return Error::None;
+    }
+
+    m_pTree = detail::TreePtr(createHuffmanTreeFromCodeLengthsWithAllocator(
+                                  i_aCodeLengths.data(),
+                                  &m_pAllocator->sAllocator),
+                              detail::TreeDeleter{&m_pAllocator->sAllocator});
+    return (m_pTree != nullptr) ? Error::None : Error::OutOfMemory;
+  }
+
+  /**
+   * @brief Get the code length of a symbol, 0 if it is unused.
+   *
+   * @param i_symbol The symbol.
+   * @return std::uint8_t The code length in bits.
+   */
+  std::uint8_t getCodeLength(std::uint8_t i_symbol) const noexcept {
+    return m_sTable.aCodeLengths[i_symbol];
+  }
+
+  /**
+   * @brief Get the code of a symbol, stored least significant bit first.
+   *
+   * @param i_symbol The symbol.
+   * @return std::uint16_t The bit-reversed canonical code.
+   */
+  std::uint16_t getCode(std::uint8_t i_symbol) const noexcept {
+    return m_sTable.aCodes[i_symbol];
+  }
+
+  /**
+   * @brief Get the underlying C code table.
+   *
+   * @return const sHuffmanCodeTable_t& The canonical code table.
+   */
+  const sHuffmanCodeTable_t& getTable() const noexcept { return m_sTable; }
+
+  /**
+   * @brief Get the canonical Huffman tree, owned by the code table.
+   *
+   * @return const sBinaryTreeNode_t* The root, or nullptr if no symbols are
+   * used or no table has been built.
+   */
+  const sBinaryTreeNode_t* getTree() const noexcept { return m_pTree.get(); }
+
+ private:
+  detail::ResourceAllocatorPtr m_pAllocator;
+  detail::TreePtr m_pTree;
+  sHuffmanCodeTable_t m_sTable = {};
+};
+
+}  // namespace huffman
+
+#endif  // HUFFMAN_HPP
@@ -0,0 +1,879 @@
+/**
+ * @file huffmanTree.c
+ * @brief Build Huffman trees and canonical Huffman code tables.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+/* Standard Library Includes */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Project Includes */
+
+#include "huffmanCoding/allocator.h"
+#include "huffmanCoding/huffmanTree.h"
+#include "huffmanCoding/stats.h"
+#include "huffmanCoding/task3.h"
+#include "huffmanCoding/task4.h"
+#include "huffmanCoding/task5.h"
+#include "huffmanCoding/task6.h"
+
+/* Function Prototypes */
+
+/**
+ * @brief Recursively set the code length of each leaf below a node.
+ *
+ * @param[in] i_psNode The current node in the tree.
+ * @param[in] i_depth The depth of the current node.
+ * @param[out] o_aCodeLengths The code length of each symbol.
+ * @return size_t The maximum depth of a leaf below the node.
+ */
+static size_t assignCodeLengths(const sBinaryTreeNode_t* i_psNode,
+                                size_t i_depth,
+                                uint8_t o_aCodeLengths[HUFFMAN_ALPHABET_SIZE]);
+
+/**
+ * @brief Create a leaf node for the given symbol.
+ *
+ * @param[in] i_symbol The symbol of the leaf node.
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ * @return sBinaryTreeNode_t* The leaf node, else NULL.
+ */
+static sBinaryTreeNode_t* createLeafNode(
+    uint8_t i_symbol, const sHuffmanAllocator_t* i_psAllocator);
+
+/**
+ * @brief Free an array of binary trees.
+ *
+ * @param[inout] io_apsRoots The roots of the binary trees to free.
+ * @param[in] i_count The number of binary trees in the array.
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ */
+static void freeBinaryTreeNodes(sBinaryTreeNode_t** io_apsRoots,
+                                size_t i_count,
+                                const sHuffmanAllocator_t* i_psAllocator);
+
+/**
+ * @brief Reverse the order of the lowest bits of a code.
+ *
+ * @param[in] i_code The code to reverse.
+ * @param[in] i_length The number of bits in the code.
+ * @return uint16_t The bit-reversed code.
+ */
+static uint16_t reverseCode(uint16_t i_code, size_t i_length);
+
+/**
+ * @brief Check whether a node is popped before another node.
+ *
+ * @param[in] i_psWorkspace The tree workspace.
+ * @param[in] i_first The first node.
+ * @param[in] i_second The second node.
+ * @return true if the first node has a lower weight, or the same weight and
+ * was appended to the list first.
+ * @return false otherwise.
+ */
+static bool isLighterNode(const sHuffmanTreeWorkspace_t* i_psWorkspace,
+                          uint16_t i_first, uint16_t i_second);
+
+/**
+ * @brief Move a heap entry down until neither of its children is lighter.
+ *
+ * @param[inout] io_psWorkspace The tree workspace.
+ * @param[in] i_heapSize The number of nodes in the heap.
+ * @param[in] i_index The index of the heap entry to move.
+ */
+static void siftDownHeap(sHuffmanTreeWorkspace_t* io_psWorkspace,
+                         size_t i_heapSize, size_t i_index);
+
+/**
+ * @brief Build a Huffman tree in the workspace and read its code lengths.
+ *
+ * @param[in] i_aFrequencies The frequency of each symbol.
+ * @param[out] o_aCodeLengths The code length of each symbol.
+ * @param[inout] io_psWorkspace The tree workspace.
+ * @return size_t The maximum code length in the tree.
+ */
+static size_t buildCodeLengths(
+    const size_t i_aFrequencies[HUFFMAN_ALPHABET_SIZE],
+    uint8_t o_aCodeLengths[HUFFMAN_ALPHABET_SIZE],
+    sHuffmanTreeWorkspace_t* io_psWorkspace);
+
+/* Function Definitions */
+
+/**
+ * @brief Recursively set the code length of each leaf below a node.
+ *
+ * @param[in] i_psNode The current node in the tree.
+ * @param[in] i_depth The depth of the current node.
+ * @param[out] o_aCodeLengths The code length of each symbol.
+ * @return size_t The maximum depth of a leaf below the node.
+ */
+static size_t assignCodeLengths(const sBinaryTreeNode_t* i_psNode,
+                                size_t i_depth,
+                                uint8_t o_aCodeLengths[HUFFMAN_ALPHABET_SIZE]) {
+  if (i_psNode->psLeftChild == NULL && i_psNode->psRightChild == NULL) {
+    /* Clamp the depth to fit the table, deeper trees are rebuilt anyway. */
+    const size_t length = (i_depth > UINT8_MAX) ? UINT8_MAX : i_depth;
+    o_aCodeLengths[(uint8_t)i_psNode->psLetterFrequencyPair->character] =
+        (uint8_t)length;
+    return i_depth;
+  }
+
+  size_t maxDepth = 0;
+  if (i_psNode->psLeftChild != NULL) {
+    maxDepth =
+        assignCodeLengths(i_psNode->psLeftChild, i_depth + 1, o_aCodeLengths);
+  }
+  if (i_psNode->psRightChild != NULL) {
+    const size_t rightDepth =
+        assignCodeLengths(i_psNode->psRightChild, i_depth + 1, o_aCodeLengths);
+    maxDepth = (rightDepth > maxDepth) ? rightDepth : maxDepth;
+  }
+
+  return maxDepth;
+}
+
+/**
+ * @brief Create a leaf node for the given symbol.
+ *
+ * @param[in] i_symbol The symbol of the leaf node.
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ * @return sBinaryTreeNode_t* The leaf node, else NULL.
+ */
+static sBinaryTreeNode_t* createLeafNode(
+    uint8_t i_symbol, const sHuffmanAllocator_t* i_psAllocator) {
+  sBinaryTreeNode_t* psLeaf = (sBinaryTreeNode_t*)allocateHuffmanMemory(
+      i_psAllocator, sizeof(sBinaryTreeNode_t));
+  if (psLeaf == NULL) {
+    perror("ERROR: Failed to allocate memory for binary tree node");
+    return NULL;
+  }
+
+  psLeaf->psLetterFrequencyPair =
+      (sLetterFrequencyPair_t*)allocateHuffmanMemory(
+          i_psAllocator, sizeof(sLetterFrequencyPair_t));
+  if (psLeaf->psLetterFrequencyPair == NULL) {
+    perror("ERROR: Failed to allocate memory for letter-frequency pair");
+    freeHuffmanMemory(i_psAllocator, psLeaf);
+    return NULL;
+  }
+
+  psLeaf->psLetterFrequencyPair->character = (char)i_symbol;
+  psLeaf->psLetterFrequencyPair->frequency = 0;
+  psLeaf->psLeftChild = NULL;
+  psLeaf->psRightChild = NULL;
+
+  return psLeaf;
+}
+
+/**
+ * @brief Free an array of binary trees.
+ *
+ * @param[inout] io_apsRoots The roots of the binary trees to free.
+ * @param[in] i_count The number of binary trees in the array.
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ */
+static void freeBinaryTreeNodes(sBinaryTreeNode_t** io_apsRoots,
+                                size_t i_count,
+                                const sHuffmanAllocator_t* i_psAllocator) {
+  for (size_t i = 0; i < i_count; i++) {
+    freeBinaryTreeWithAllocator(io_apsRoots[i], i_psAllocator);
+    io_apsRoots[i] = NULL;
+  }
+}
+
+/**
+ * @brief Reverse the order of the lowest bits of a code.
+ *
+ * @param[in] i_code The code to reverse.
+ * @param[in] i_length The number of bits in the code.
+ * @return uint16_t The bit-reversed code.
+ */
+static uint16_t reverseCode(uint16_t i_code, size_t i_length) {
+  uint16_t reversed = 0;
+
+  for (size_t i = 0; i < i_length; i++) {
+    reversed = (uint16_t)((reversed << 1) | ((i_code >> i) & 1U));
+  }
+
+  return reversed;
+}
+
+/**
+ * @brief Check whether a node is popped before another node.
+ *
+ * @param[in] i_psWorkspace The tree workspace.
+ * @param[in] i_first The first node.
+ * @param[in] i_second The second node.
+ * @return true if the first node has a lower weight, or the same weight and
+ * was appended to the list first.
+ * @return false otherwise.
+ */
+static bool isLighterNode(const sHuffmanTreeWorkspace_t* i_psWorkspace,
+                          uint16_t i_first, uint16_t i_second) {
+  const size_t firstWeight = i_psWorkspace->aWeights[i_first];
+  const size_t secondWeight = i_psWorkspace->aWeights[i_second];
+  return (firstWeight < secondWeight) ||
+         (firstWeight == secondWeight && i_first < i_second);
+}
+
+/**
+ * @brief Move a heap entry down until neither of its children is lighter.
+ *
+ * @param[inout] io_psWorkspace The tree workspace.
+ * @param[in] i_heapSize The number of nodes in the heap.
+ * @param[in] i_index The index of the heap entry to move.
+ */
+static void siftDownHeap(sHuffmanTreeWorkspace_t* io_psWorkspace,
+                         size_t i_heapSize, size_t i_index) {
+  uint16_t* aHeap = io_psWorkspace->aHeap;
+  const uint16_t node = aHeap[i_index];
+
+  for (;;) {
+    size_t child = (2 * i_index) + 1;
+    if (child >= i_heapSize) {
+      break;
+    }
+    if (child + 1 < i_heapSize &&
+        isLighterNode(io_psWorkspace, aHeap[child + 1], aHeap[child])) {
+      child++;
+    }
+    if (!isLighterNode(io_psWorkspace, aHeap[child], node)) {
+      break;
+    }
+    aHeap[i_index] = aHeap[child];
+    i_index = child;
+  }
+
+  aHeap[i_index] = node;
+}
+
+/**
+ * @brief Build a Huffman tree in the workspace and read its code lengths.
+ *
+ * @param[in] i_aFrequencies The frequency of each symbol.
+ * @param[out] o_aCodeLengths The code length of each symbol.
+ * @param[inout] io_psWorkspace The tree workspace.
+ * @return size_t The maximum code length in the tree.
+ */
+static size_t buildCodeLengths(
+    const size_t i_aFrequencies[HUFFMAN_ALPHABET_SIZE],
+    uint8_t o_aCodeLengths[HUFFMAN_ALPHABET_SIZE],
+    sHuffmanTreeWorkspace_t* io_psWorkspace) {
+  (void)memset(o_aCodeLengths, 0, HUFFMAN_ALPHABET_SIZE * sizeof(uint8_t));
+
+  /* The leaves are the first nodes, in ascending symbol order. */
+  size_t leafCount = 0;
+  for (size_t symbol = 0; symbol < HUFFMAN_ALPHABET_SIZE; symbol++) {
+    if (i_aFrequencies[symbol] != 0) {
+      io_psWorkspace->aWeights[leafCount] = i_aFrequencies[symbol];
+      io_psWorkspace->aLeafSymbols[leafCount] = (uint8_t)symbol;
+      io_psWorkspace->aHeap[leafCount] = (uint16_t)leafCount;
+      leafCount++;
+    }
+  }
+
+  if (leafCount == 0) {
+    return 0;
+  }
+  if (leafCount == 1) {
+    /* A single symbol still needs one bit per occurrence. */
+    o_aCodeLengths[io_psWorkspace->aLeafSymbols[0]] = 1;
+    return 1;
+  }
+
+  size_t heapSize = leafCount;
+  for (size_t i = heapSize / 2; i-- > 0;) {
+    siftDownHeap(io_psWorkspace, heapSize, i);
+  }
+
+  /* Merge the two lightest nodes until only the root remains. */
+  size_t nodeCount = leafCount;
+  while (heapSize > 1) {
+    const uint16_t left = io_psWorkspace->aHeap[0];
+    io_psWorkspace->aHeap[0] = io_psWorkspace->aHeap[--heapSize];
+    siftDownHeap(io_psWorkspace, heapSize, 0);
+    const uint16_t right = io_psWorkspace->aHeap[0];
+
+    const uint16_t parent = (uint16_t)nodeCount++;
+    io_psWorkspace->aWeights[parent] =
+        io_psWorkspace->aWeights[left] + io_psWorkspace->aWeights[right];
+    io_psWorkspace->aParents[left] = parent;
+    io_psWorkspace->aParents[right] = parent;
+    io_psWorkspace->aHeap[0] = parent;
+    siftDownHeap(io_psWorkspace, heapSize, 0);
+  }
+
+  /* Parents are numbered after their children, so walk down from the root. */
+  const size_t root = nodeCount - 1;
+  io_psWorkspace->aDepths[root] = 0;
+  for (size_t node = root; node-- > 0;) {
+    io_psWorkspace->aDepths[node] = (uint16_t)(
+        io_psWorkspace->aDepths[io_psWorkspace->aParents[node]] + 1);
+  }
+
+  size_t maxLength = 0;
+  for (size_t leaf = 0; leaf < leafCount; leaf++) {
+    const size_t depth = io_psWorkspace->aDepths[leaf];
+    o_aCodeLengths[io_psWorkspace->aLeafSymbols[leaf]] =
+        (uint8_t)((depth > UINT8_MAX) ? UINT8_MAX : depth);
+    maxLength = (depth > maxLength) ? depth : maxLength;
+  }
+
+  return maxLength;
+}
+
+/**
+ * @brief Build a Huffman tree from a binary tree node linked list.
+ *
+ * This function repeatedly pops the two lowest frequency nodes from the list,
+ * merges them and pushes the merged node back onto the list, until a single
+ * node remains. That node is removed from the list and returned as the root.
+ * If any error occurs, then the list is freed and it returns NULL.
+ *
+ * @param[inout] io_psHead The pointer to the pointer to the head of the list.
+ * @return sBinaryTreeNode_t* The root of the Huffman tree, else NULL.
+ */
+sBinaryTreeNode_t* createHuffmanTree(sBinaryTreeListNode_t** io_psHead) {
+  return createHuffmanTreeWithAllocator(io_psHead, NULL);
+}
+
+/**
+ * @brief Build a Huffman tree from a binary tree node linked list allocated
+ * with the given allocator.
+ *
+ * @param[inout] io_psHead The pointer to the pointer to the head of the list.
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ * @return sBinaryTreeNode_t* The root of the Huffman tree, else NULL.
+ */
+sBinaryTreeNode_t* createHuffmanTreeWithAllocator(
+    sBinaryTreeListNode_t** io_psHead,
+    const sHuffmanAllocator_t* i_psAllocator) {
+  if (io_psHead == NULL || *io_psHead == NULL) {
+    perror("ERROR: Binary tree list head is NULL");
+    return NULL;
+  }
+
+  while ((*io_psHead)->psNext != NULL) {
+    sBinaryTreeNode_t* psLeftChild =
+        popLowestFrequencyBinaryTreeNodeWithAllocator(io_psHead, i_psAllocator);
+    sBinaryTreeNode_t* psRightChild =
+        popLowestFrequencyBinaryTreeNodeWithAllocator(io_psHead, i_psAllocator);
+
+    sBinaryTreeNode_t* psParent = mergeBinaryTreeNodesWithAllocator(
+        psLeftChild, psRightChild, i_psAllocator);
+    if (psParent == NULL) {
+      freeBinaryTreeWithAllocator(psLeftChild, i_psAllocator);
+      freeBinaryTreeWithAllocator(psRightChild, i_psAllocator);
+      freeBinaryTreeListWithAllocator(io_psHead, i_psAllocator);
+      return NULL;
+    }
+
+    if (pushBinaryTreeNodeWithAllocator(io_psHead, psParent, i_psAllocator) ==
+        EXIT_FAILURE) {
+      freeBinaryTreeWithAllocator(psParent, i_psAllocator);
+      freeBinaryTreeListWithAllocator(io_psHead, i_psAllocator);
+      return NULL;
+    }
+  }
+
+  return popLowestFrequencyBinaryTreeNodeWithAllocator(io_psHead,
+                                                       i_psAllocator);
+}
+
+/**
+ * @brief Find the code length of each leaf in a Huffman tree.
+ *
+ * This function walks the tree and sets the code length of each leaf's
+ * character to its depth. A tree consisting of a single leaf is given a code
+ * length of 1 so that the symbol is still encoded with one bit. The lengths of
+ * characters not in the tree are set to 0.
+ *
+ * @param[in] i_psRoot The root of the Huffman tree.
+ * @param[out] o_aCodeLengths The code length of each symbol.
+ * @return size_t The maximum code length in the tree.
+ */
+size_t getCodeLengthsFromHuffmanTree(
+    const sBinaryTreeNode_t* i_psRoot,
+    uint8_t o_aCodeLengths[HUFFMAN_ALPHABET_SIZE]) {
+  (void)memset(o_aCodeLengths, 0, HUFFMAN_ALPHABET_SIZE * sizeof(uint8_t));
+
+  if (i_psRoot == NULL) {
+    return 0;
+  }
+
+  size_t maxLength = assignCodeLengths(i_psRoot, 0, o_aCodeLengths);
+  if (maxLength == 0) {
+    /* A single symbol still needs one bit per occurrence. */
+    o_aCodeLengths[(uint8_t)i_psRoot->psLetterFrequencyPair->character] = 1;
+    maxLength = 1;
+  }
+
+  return maxLength;
+}
+
+/**
+ * @brief Create length-limited Huffman code lengths from symbol frequencies.
+ *
+ * This function builds a Huffman tree from the frequencies, using the
+ * letter-frequency and binary tree node lists, and reads the code lengths from
+ * it. If the tree is deeper than HUFFMAN_MAX_CODE_LENGTH, then the frequencies
+ * are halved, keeping every used symbol non-zero, and the tree is rebuilt.
+ *
+ * @param[in] i_aFrequencies The frequency of each symbol.
+ * @param[out] o_aCodeLengths The code length of each symbol.
+ * @return int EXIT_SUCCESS if the code lengths were created successfully, else
+ * EXIT_FAILURE.
+ */
+int createCodeLengthsFromFrequencies(
+    const size_t i_aFrequencies[HUFFMAN_ALPHABET_SIZE],
+    uint8_t o_aCodeLengths[HUFFMAN_ALPHABET_SIZE]) {
+  return createCodeLengthsFromFrequenciesWithAllocator(i_aFrequencies,
+                                                       o_aCodeLengths, NULL);
+}
+
+/**
+ * @brief Create length-limited Huffman code lengths from symbol frequencies,
+ * allocating the intermediate lists and trees with the given allocator.
+ *
+ * @param[in] i_aFrequencies The frequency of each symbol.
+ * @param[out] o_aCodeLengths The code length of each symbol.
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ * @return int EXIT_SUCCESS if the code lengths were created successfully, else
+ * EXIT_FAILURE.
+ */
+int createCodeLengthsFromFrequenciesWithAllocator(
+    const size_t i_aFrequencies[HUFFMAN_ALPHABET_SIZE],
+    uint8_t o_aCodeLengths[HUFFMAN_ALPHABET_SIZE],
+    const sHuffmanAllocator_t* i_psAllocator) {
+  size_t aFrequencies[HUFFMAN_ALPHABET_SIZE];
+  (void)memcpy(aFrequencies, i_aFrequencies, sizeof(aFrequencies));
+
+  for (;;) {
+    sLetterFrequencyNode_t* psLetterFrequencyHead = NULL;
+    sBinaryTreeListNode_t* psBinaryTreeListHead = NULL;
+
+    if (createLetterFrequencyListFromFrequenciesWithAllocator(
+            &psLetterFrequencyHead, aFrequencies, i_psAllocator) ==
+        EXIT_FAILURE) {
+      return EXIT_FAILURE;
+    }
+
+    if (psLetterFrequencyHead == NULL) {
+      /* No symbols are used, so no codes are needed. */
+      (void)memset(o_aCodeLengths, 0, HUFFMAN_ALPHABET_SIZE * sizeof(uint8_t));
+      return EXIT_SUCCESS;
+    }
+
+    /* The binary tree nodes take ownership of the letter-frequency pairs. */
+    if (createBinaryTreeNodeListFromLetterFrequencyPairListWithAllocator(
+            &psBinaryTreeListHead, psLetterFrequencyHead, i_psAllocator) ==
+        EXIT_FAILURE) {
+      return EXIT_FAILURE;
+    }
+
+    sBinaryTreeNode_t* psRoot =
+        createHuffmanTreeWithAllocator(&psBinaryTreeListHead, i_psAllocator);
+    if (psRoot == NULL) {
+      return EXIT_FAILURE;
+    }
+
+    const size_t maxLength =
+        getCodeLengthsFromHuffmanTree(psRoot, o_aCodeLengths);
+    freeBinaryTreeWithAllocator(psRoot, i_psAllocator);
+    HUFFMAN_STATS_MAX(maxTreeDepth, maxLength);
+
+    if (maxLength <= HUFFMAN_MAX_CODE_LENGTH) {
+      return EXIT_SUCCESS;
+    }
+    HUFFMAN_STATS_ADD(lengthLimitRebuilds, 1);
+
+    /* Flatten the distribution and try again. */
+    for (size_t symbol = 0; symbol < HUFFMAN_ALPHABET_SIZE; symbol++) {
+      aFrequencies[symbol] = (aFrequencies[symbol] + 1) / 2;
+    }
+  }
+}
+
+/**
+ * @brief Create length-limited Huffman code lengths from symbol frequencies
+ * without allocating.
+ *
+ * This function produces the same code lengths as
+ * createCodeLengthsFromFrequencies, using a binary heap over the workspace's
+ * node arrays in place of the letter-frequency and binary tree node lists.
+ *
+ * @param[in] i_aFrequencies The frequency of each symbol.
+ * @param[out] o_aCodeLengths The code length of each symbol.
+ * @param[inout] io_psWorkspace The scratch memory for building the tree.
+ */
+void createCodeLengthsWithWorkspace(
+    const size_t i_aFrequencies[HUFFMAN_ALPHABET_SIZE],
+    uint8_t o_aCodeLengths[HUFFMAN_ALPHABET_SIZE],
+    sHuffmanTreeWorkspace_t* io_psWorkspace) {
+  size_t aFrequencies[HUFFMAN_ALPHABET_SIZE];
+  (void)memcpy(aFrequencies, i_aFrequencies, sizeof(aFrequencies));
+
+  for (;;) {
+    const size_t maxLength =
+        buildCodeLengths(aFrequencies, o_aCodeLengths, io_psWorkspace);
+    HUFFMAN_STATS_MAX(maxTreeDepth, maxLength);
+
+    if (maxLength <= HUFFMAN_MAX_CODE_LENGTH) {
+      return;
+    }
+    HUFFMAN_STATS_ADD(lengthLimitRebuilds, 1);
+
+    /* Flatten the distribution and try again. */
+    for (size_t symbol = 0; symbol < HUFFMAN_ALPHABET_SIZE; symbol++) {
+      aFrequencies[symbol] = (aFrequencies[symbol] + 1) / 2;
+    }
+  }
+}
+
+/**
+ * @brief Create a canonical Huffman code table from code lengths.
+ *
+ * This function assigns canonical codes to each symbol, with shorter codes
+ * first and ties broken by symbol value. It returns EXIT_FAILURE if the
+ * lengths do not describe a complete prefix code, unless a single symbol is
+ * used with a code length of 1.
+ *
+ * @param[in] i_aCodeLengths The code length of each symbol.
+ * @param[out] o_psCodeTable The canonical code table.
+ * @return int EXIT_SUCCESS if the code table was created successfully, else
+ * EXIT_FAILURE.
+ */
+int createCanonicalCodeTable(
+    const uint8_t i_aCodeLengths[HUFFMAN_ALPHABET_SIZE],
+    sHuffmanCodeTable_t* o_psCodeTable) {
+  size_t aLengthCounts[HUFFMAN_MAX_CODE_LENGTH + 1] = {0};
+  uint16_t aNextCodes[HUFFMAN_MAX_CODE_LENGTH + 1] = {0};
+  size_t usedSymbols = 0;
+  size_t kraftSum = 0;
+
+  /* Count the number of codes of each length. */
+  for (size_t symbol = 0; symbol < HUFFMAN_ALPHABET_SIZE; symbol++) {
+    const size_t length = i_aCodeLengths[symbol];
+    if (length > HUFFMAN_MAX_CODE_LENGTH) {
+      (void)fprintf(stderr, "ERROR: Code length %zu is too long\n", length);
+      return EXIT_FAILURE;
+    }
+    if (length != 0) {
+      aLengthCounts[length]++;
+      usedSymbols++;
+      kraftSum += (size_t)1 << (HUFFMAN_MAX_CODE_LENGTH - length);
+    }
+  }
+
+  /* Check the code lengths describe a complete prefix code. */
+  const int isSingleSymbol = (usedSymbols == 1 && aLengthCounts[1] == 1);
+  if (usedSymbols != 0 && !isSingleSymbol &&
+      kraftSum != ((size_t)1 << HUFFMAN_MAX_CODE_LENGTH)) {
+    (void)fprintf(stderr, "ERROR: Code lengths are not a complete code\n");
+    return EXIT_FAILURE;
+  }
+
+  /* Find the first canonical code of each length. */
+  uint16_t code = 0;
+  for (size_t length = 1; length <= HUFFMAN_MAX_CODE_LENGTH; length++) {
+    code = (uint16_t)((code + aLengthCounts[length - 1]) << 1);
+    aNextCodes[length] = code;
+  }
+
+  /* Assign consecutive codes to the symbols of each length. */
+  for (size_t symbol = 0; symbol < HUFFMAN_ALPHABET_SIZE; symbol++) {
+    const size_t length = i_aCodeLengths[symbol];
+    o_psCodeTable->aCodeLengths[symbol] = (uint8_t)length;
+    o_psCodeTable->aCodes[symbol] =
+        (length == 0) ? 0 : reverseCode(aNextCodes[length]++, length);
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Create the tables for decoding canonical codes of the given lengths.
+ *
+ * The lengths must already have been validated by createCanonicalCodeTable.
+ *
+ * @param[in] i_aCodeLengths The code length of each symbol.
+ * @param[out] o_psDecoder The canonical decoding tables.
+ */
+void createCanonicalDecoder(const uint8_t i_aCodeLengths[HUFFMAN_ALPHABET_SIZE],
+                            sHuffmanCanonicalDecoder_t* o_psDecoder) {
+  uint16_t aNextOffsets[HUFFMAN_MAX_CODE_LENGTH + 1];
+
+  (void)memset(o_psDecoder->aCounts, 0, sizeof(o_psDecoder->aCounts));
+  o_psDecoder->maxLength = 0;
+  for (size_t symbol = 0; symbol < HUFFMAN_ALPHABET_SIZE; symbol++) {
+    const uint8_t length = i_aCodeLengths[symbol];
+    if (length != 0) {
+      o_psDecoder->aCounts[length]++;
+      o_psDecoder->maxLength =
+          (length > o_psDecoder->maxLength) ? length : o_psDecoder->maxLength;
+    }
+  }
+
+  /* Match the first codes assigned by createCanonicalCodeTable. */
+  uint16_t code = 0;
+  uint16_t offset = 0;
+  o_psDecoder->aFirstCodes[0] = 0;
+  o_psDecoder->aOffsets[0] = 0;
+  for (size_t length = 1; length <= HUFFMAN_MAX_CODE_LENGTH; length++) {
+    code = (uint16_t)((code + o_psDecoder->aCounts[length - 1]) << 1);
+    o_psDecoder->aFirstCodes[length] = code;
+    o_psDecoder->aOffsets[length] = offset;
+    aNextOffsets[length] = offset;
+    offset = (uint16_t)(offset + o_psDecoder->aCounts[length]);
+  }
+
+  /* Sort the symbols by code length, then by symbol value. */
+  for (size_t symbol = 0; symbol < HUFFMAN_ALPHABET_SIZE; symbol++) {
+    const uint8_t length = i_aCodeLengths[symbol];
+    if (length != 0) {
+      o_psDecoder->aSymbols[aNextOffsets[length]++] = (uint8_t)symbol;
+    }
+  }
+}
+
+/**
+ * @brief Fill a decode table from a canonical code table.
+ *
+ * Every entry whose low bits start with a code of at most
+ * HUFFMAN_DECODE_TABLE_BITS bits is set to that code's symbol and length.
+ * The remaining entries are left as 0.
+ *
+ * @param[in] i_psCodeTable The canonical code table.
+ * @param[out] o_aDecodeTable The decode table.
+ * @return size_t The maximum code length in the code table.
+ */
+size_t createDecodeTable(
+    const sHuffmanCodeTable_t* i_psCodeTable,
+    decodeTableEntry_t o_aDecodeTable[HUFFMAN_DECODE_TABLE_SIZE]) {
+  size_t maxLength = 0;
+
+  (void)memset(o_aDecodeTable, 0,
+               HUFFMAN_DECODE_TABLE_SIZE * sizeof(decodeTableEntry_t));
+
+  for (size_t symbol = 0; symbol < HUFFMAN_ALPHABET_SIZE; symbol++) {
+    const size_t length = i_psCodeTable->aCodeLengths[symbol];
+    if (length == 0) {
+      continue;
+    }
+    maxLength = (length > maxLength) ? length : maxLength;
+    if (length > HUFFMAN_DECODE_TABLE_BITS) {
+      continue;
+    }
+
+    const decodeTableEntry_t entry =
+        (decodeTableEntry_t)((symbol << 4) | length);
+    for (size_t i = i_psCodeTable->aCodes[symbol];
+         i < HUFFMAN_DECODE_TABLE_SIZE; i += (size_t)1 << length) {
+      o_aDecodeTable[i] = entry;
+    }
+  }
+
+  return maxLength;
+}
+
+/**
+ * @brief Fill a multi-symbol decode table from a decode table, for alphabets
+ * of at most HUFFMAN_TINY_ALPHABET_SIZE symbols.
+ *
+ * Each entry holds every whole code, up to HUFFMAN_MULTI_SYMBOL_MAX_CODES,
+ * that starts in the low HUFFMAN_DECODE_TABLE_BITS bits of its index, so
+ * short codes are decoded several per lookup. The table is only built when
+ * the alphabet is small enough and every code fits in the decode table, so
+ * that every entry of a complete code holds at least one symbol.
+ *
+ * @param[in] i_psCodeTable The canonical code table.
+ * @param[in] i_aDecodeTable The decode table of the code table.
+ * @param[out] o_aMultiSymbolTable The multi-symbol decode table.
+ * @return bool Whether the table was built.
+ */
+bool createMultiSymbolDecodeTable(
+    const sHuffmanCodeTable_t* i_psCodeTable,
+    const decodeTableEntry_t i_aDecodeTable[HUFFMAN_DECODE_TABLE_SIZE],
+    multiSymbolEntry_t o_aMultiSymbolTable[HUFFMAN_DECODE_TABLE_SIZE]) {
+  size_t symbolCount = 0;
+  for (size_t symbol = 0; symbol < HUFFMAN_ALPHABET_SIZE; symbol++) {
+    const size_t length = i_psCodeTable->aCodeLengths[symbol];
+    if (length > HUFFMAN_DECODE_TABLE_BITS) {
+      return false;
+    }
+    symbolCount += (length != 0) ? 1 : 0;
+  }
+  if (symbolCount > HUFFMAN_TINY_ALPHABET_SIZE) {
+    return false;
+  }
+
+  for (size_t i = 0; i < HUFFMAN_DECODE_TABLE_SIZE; i++) {
+    multiSymbolEntry_t entry = 0;
+    size_t consumed = 0;
+    size_t count = 0;
+    while (count < HUFFMAN_MULTI_SYMBOL_MAX_CODES) {
+      /* The bits above the index are unknown, so the code must end within
+         it. */
+      const decodeTableEntry_t single = i_aDecodeTable[i >> consumed];
+      const size_t length = single & 0x0FU;
+      if (single == 0 || consumed + length > HUFFMAN_DECODE_TABLE_BITS) {
+        break;
+      }
+      entry |= (multiSymbolEntry_t)(single >> 4) << (8 * count);
+      consumed += length;
+      count++;
+    }
+    o_aMultiSymbolTable[i] = entry | ((multiSymbolEntry_t)consumed << 56) |
+                             ((multiSymbolEntry_t)count << 60);
+  }
+
+  return true;
+}
+
+/**
+ * @brief Lay out the canonical Huffman tree of a code table as a nibble
+ * tree.
+ *
+ * The nodes are those of the tree from createHuffmanTreeFromCodeLengths at
+ * every HUFFMAN_NIBBLE_TREE_BITS-th level, found from the codes without
+ * building the tree.
+ *
+ * @param[in] i_psCodeTable The canonical code table.
+ * @param[out] o_psTree The nibble tree.
+ */
+void createNibbleTree(const sHuffmanCodeTable_t* i_psCodeTable,
+                      sHuffmanNibbleTree_t* o_psTree) {
+  const size_t mask = HUFFMAN_NIBBLE_TREE_FANOUT - 1;
+
+  (void)memset(o_psTree->aaNodes[0], 0, sizeof(o_psTree->aaNodes[0]));
+  o_psTree->nodeCount = 1;
+
+  /* Each pass adds the children of the nodes added by the previous pass, so
+   * the nodes are numbered level by level. */
+  for (size_t depth = 0; depth < HUFFMAN_MAX_CODE_LENGTH;
+       depth += HUFFMAN_NIBBLE_TREE_BITS) {
+    for (size_t symbol = 0; symbol < HUFFMAN_ALPHABET_SIZE; symbol++) {
+      const size_t length = i_psCodeTable->aCodeLengths[symbol];
+      if (length <= depth) {
+        continue;
+      }
+
+      /* Follow the first bits of the code down to its node at this depth. */
+      const size_t code = i_psCodeTable->aCodes[symbol];
+      size_t node = 0;
+      for (size_t bit = 0; bit < depth; bit += HUFFMAN_NIBBLE_TREE_BITS) {
+        node = (size_t)(o_psTree->aaNodes[node][(code >> bit) & mask] >> 4);
+      }
+
+      nibbleTreeEntry_t* aEntries = o_psTree->aaNodes[node];
+      const size_t index = (code >> depth) & mask;
+      const size_t remaining = length - depth;
+      if (remaining <= HUFFMAN_NIBBLE_TREE_BITS) {
+        const nibbleTreeEntry_t entry =
+            (nibbleTreeEntry_t)((symbol << 4) | remaining);
+        for (size_t i = index; i < HUFFMAN_NIBBLE_TREE_FANOUT;
+             i += (size_t)1 << remaining) {
+          aEntries[i] = entry;
+        }
+      } else if (aEntries[index] == 0) {
+        (void)memset(o_psTree->aaNodes[o_psTree->nodeCount], 0,
+                     sizeof(o_psTree->aaNodes[0]));
+        aEntries[index] = (nibbleTreeEntry_t)(o_psTree->nodeCount << 4);
+        o_psTree->nodeCount++;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Create the canonical Huffman tree described by code lengths.
+ *
+ * This function rebuilds, from the bottom level up, the binary tree whose
+ * left and right links spell out the canonical codes of the given lengths,
+ * merging each pair of nodes with mergeBinaryTreeNodes. The lengths must
+ * describe a complete prefix code. It returns NULL if any error occurs.
+ *
+ * @param[in] i_aCodeLengths The code length of each symbol.
+ * @return sBinaryTreeNode_t* The root of the canonical Huffman tree, else
+ * NULL.
+ */
+sBinaryTreeNode_t* createHuffmanTreeFromCodeLengths(
+    const uint8_t i_aCodeLengths[HUFFMAN_ALPHABET_SIZE]) {
+  return createHuffmanTreeFromCodeLengthsWithAllocator(i_aCodeLengths, NULL);
+}
+
+/**
+ * @brief Create the canonical Huffman tree described by code lengths,
+ * allocating the nodes with the given allocator.
+ *
+ * @param[in] i_aCodeLengths The code length of each symbol.
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ * @return sBinaryTreeNode_t* The root of the canonical Huffman tree, else
+ * NULL.
+ */
+sBinaryTreeNode_t* createHuffmanTreeFromCodeLengthsWithAllocator(
+    const uint8_t i_aCodeLengths[HUFFMAN_ALPHABET_SIZE],
+    const sHuffmanAllocator_t* i_psAllocator) {
+  /* Each level holds its leaves followed by the parents of the level below. */
+  sBinaryTreeNode_t* apsLevel[2 * HUFFMAN_ALPHABET_SIZE];
+  size_t levelCount = 0;
+
+  for (size_t length = HUFFMAN_MAX_CODE_LENGTH; length > 0; length--) {
+    sBinaryTreeNode_t* apsParents[HUFFMAN_ALPHABET_SIZE];
+    const size_t parentCount = levelCount;
+    (void)memcpy(apsParents, apsLevel, parentCount * sizeof(apsLevel[0]));
+    levelCount = 0;
+
+    /* Canonical codes place the leaves of a level before its parents. */
+    for (size_t symbol = 0; symbol < HUFFMAN_ALPHABET_SIZE; symbol++) {
+      if (i_aCodeLengths[symbol] != length) {
+        continue;
+      }
+      apsLevel[levelCount] = createLeafNode((uint8_t)symbol, i_psAllocator);
+      if (apsLevel[levelCount] == NULL) {
+        freeBinaryTreeNodes(apsLevel, levelCount, i_psAllocator);
+        freeBinaryTreeNodes(apsParents, parentCount, i_psAllocator);
+        return NULL;
+      }
+      levelCount++;
+    }
+    (void)memcpy(&apsLevel[levelCount], apsParents,
+                 parentCount * sizeof(apsLevel[0]));
+    levelCount += parentCount;
+
+    if (levelCount % 2 != 0) {
+      (void)fprintf(stderr, "ERROR: Code lengths are not a complete code\n");
+      freeBinaryTreeNodes(apsLevel, levelCount, i_psAllocator);
+      return NULL;
+    }
+
+    /* Merge each pair of nodes into a parent on the level above. */
+    for (size_t i = 0; i < levelCount; i += 2) {
+      sBinaryTreeNode_t* psParent = mergeBinaryTreeNodesWithAllocator(
+          apsLevel[i], apsLevel[i + 1], i_psAllocator);
+      if (psParent == NULL) {
+        freeBinaryTreeNodes(apsLevel, i / 2, i_psAllocator);
+        freeBinaryTreeNodes(&apsLevel[i], levelCount - i, i_psAllocator);
+        return NULL;
+      }
+      apsLevel[i / 2] = psParent;
+    }
+    levelCount /= 2;
+  }
+
+  if (levelCount != 1) {
+    (void)fprintf(stderr, "ERROR: Code lengths are not a complete code\n");
+    freeBinaryTreeNodes(apsLevel, levelCount, i_psAllocator);
+    return NULL;
+  }
+
+  return apsLevel[0];
+}
@@ -0,0 +1,340 @@
+/**
+ * @file huffmanTree.h
+ * @brief Build Huffman trees and canonical Huffman code tables.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+#ifndef HUFFMAN_TREE_H
+#define HUFFMAN_TREE_H
+
+/* Standard Library Includes */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Project Includes */
+
+#include "huffmanCoding/allocator.h"
+#include "huffmanCoding/task4.h"
+#include "huffmanCoding/task5.h"
+#include "huffmanCoding/task6.h"
+
+/* Constants */
+
+/**< The number of symbols in the Huffman alphabet. */
+#define HUFFMAN_ALPHABET_SIZE LETTER_FREQUENCY_ALPHABET_SIZE
+
+/**< The maximum length of a Huffman code in bits. */
+#define HUFFMAN_MAX_CODE_LENGTH 15
+
+/**< The maximum number of nodes in a Huffman tree over the alphabet. */
+#define HUFFMAN_MAX_TREE_NODES ((2 * HUFFMAN_ALPHABET_SIZE) - 1)
+
+/**< The number of code bits resolved by a single decode table lookup. */
+#define HUFFMAN_DECODE_TABLE_BITS 11
+
+/**< The number of entries in a decode table. */
+#define HUFFMAN_DECODE_TABLE_SIZE ((size_t)1 << HUFFMAN_DECODE_TABLE_BITS)
+
+/**< The most symbols in an alphabet decoded with a multi-symbol table. */
+#define HUFFMAN_TINY_ALPHABET_SIZE 16
+
+/**< The most codes resolved by a single multi-symbol table lookup. */
+#define HUFFMAN_MULTI_SYMBOL_MAX_CODES 7
+
+/**< The number of code bits resolved at each node of a nibble tree. */
+#define HUFFMAN_NIBBLE_TREE_BITS 4
+
+/**< The number of entries in each node of a nibble tree. */
+#define HUFFMAN_NIBBLE_TREE_FANOUT ((size_t)1 << HUFFMAN_NIBBLE_TREE_BITS)
+
+/**< The maximum number of nodes in a nibble tree over the alphabet. */
+#define HUFFMAN_MAX_NIBBLE_TREE_NODES (HUFFMAN_ALPHABET_SIZE - 1)
+
+/* Type Definitions */
+
+/**
+ * @brief Canonical Huffman code table.
+ *
+ * Codes are stored bit-reversed so they can be written least significant bit
+ * first, i.e. the first bit of a code is bit 0 of its entry. A symbol with a
+ * code length of 0 does not occur in the encoded data.
+ */
+typedef struct sHuffmanCodeTable {
+  uint16_t aCodes[HUFFMAN_ALPHABET_SIZE];
+  uint8_t aCodeLengths[HUFFMAN_ALPHABET_SIZE];
+} sHuffmanCodeTable_t;
+
+/**
+ * @brief Decode table entry, holding the symbol in the upper bits and the
+ * code length in the lowest 4 bits. An entry of 0 marks a code longer than
+ * HUFFMAN_DECODE_TABLE_BITS.
+ */
+typedef uint16_t decodeTableEntry_t;
+
+/**
+ * @brief Multi-symbol decode table entry, holding up to
+ * HUFFMAN_MULTI_SYMBOL_MAX_CODES symbols in its low bytes, first symbol
+ * lowest, the total length of their codes in bits 56 to 59 and the number of
+ * symbols in bits 60 to 63.
+ */
+typedef uint64_t multiSymbolEntry_t;
+
+/**
+ * @brief Scratch memory for building a Huffman tree without allocating.
+ *
+ * Nodes are numbered in the order they would be appended to the binary tree
+ * node list: the leaves in ascending symbol order, then each merged node. The
+ * heap orders nodes by weight and then by number, which picks the same nodes
+ * as popLowestFrequencyBinaryTreeNode.
+ */
+typedef struct sHuffmanTreeWorkspace {
+  size_t aWeights[HUFFMAN_MAX_TREE_NODES];
+  uint16_t aParents[HUFFMAN_MAX_TREE_NODES];
+  uint16_t aDepths[HUFFMAN_MAX_TREE_NODES];
+  uint16_t aHeap[HUFFMAN_ALPHABET_SIZE];
+  uint8_t aLeafSymbols[HUFFMAN_ALPHABET_SIZE];
+} sHuffmanTreeWorkspace_t;
+
+/**
+ * @brief Tables for decoding canonical codes one bit at a time.
+ *
+ * Codes of each length are consecutive integers when read most significant
+ * bit first, so a code of a given length is valid if it lies within the
+ * range starting at the first code of that length.
+ */
+typedef struct sHuffmanCanonicalDecoder {
+  uint16_t aFirstCodes[HUFFMAN_MAX_CODE_LENGTH + 1];
+  uint16_t aCounts[HUFFMAN_MAX_CODE_LENGTH + 1];
+  uint16_t aOffsets[HUFFMAN_MAX_CODE_LENGTH + 1];
+  uint8_t aSymbols[HUFFMAN_ALPHABET_SIZE];
+  uint8_t maxLength;
+} sHuffmanCanonicalDecoder_t;
+
+/**
+ * @brief Nibble tree entry, holding the symbol in the upper bits and the
+ * number of bits left in its code in the lowest 4 bits if the code ends in
+ * the node, else the index of the child node in the upper bits and 0 in the
+ * lowest 4 bits. An entry of 0 marks bits that start no code.
+ */
+typedef uint16_t nibbleTreeEntry_t;
+
+/**
+ * @brief Canonical Huffman tree laid out in an array, resolving
+ * HUFFMAN_NIBBLE_TREE_BITS bits per node.
+ *
+ * Each node is a table indexed by the next bits of a code, first bit lowest,
+ * so a 15-bit code is decoded in 4 steps rather than 15. The nodes are
+ * numbered level by level from the root, so the 32-byte root and the nodes
+ * of the next level sit together at the start of the array, instead of one
+ * node per bit scattered over the heap.
+ */
+typedef struct sHuffmanNibbleTree {
+  nibbleTreeEntry_t aaNodes[HUFFMAN_MAX_NIBBLE_TREE_NODES]
+                           [HUFFMAN_NIBBLE_TREE_FANOUT];
+  size_t nodeCount;
+} sHuffmanNibbleTree_t;
+
+/* Function Prototypes */
+
+/**
+ * @brief Build a Huffman tree from a binary tree node linked list.
+ *
+ * This function repeatedly pops the two lowest frequency nodes from the list,
+ * merges them and pushes the merged node back onto the list, until a single
+ * node remains. That node is removed from the list and returned as the root.
+ * If any error occurs, then the list is freed and it returns NULL.
+ *
+ * @param[inout] io_psHead The pointer to the pointer to the head of the list.
+ * @return sBinaryTreeNode_t* The root of the Huffman tree, else NULL.
+ */
+extern sBinaryTreeNode_t* createHuffmanTree(sBinaryTreeListNode_t** io_psHead);
+
+/**
+ * @brief Build a Huffman tree from a binary tree node linked list allocated
+ * with the given allocator.
+ *
+ * @param[inout] io_psHead The pointer to the pointer to the head of the list.
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ * @return sBinaryTreeNode_t* The root of the Huffman tree, else NULL.
+ */
+extern sBinaryTreeNode_t* createHuffmanTreeWithAllocator(
+    sBinaryTreeListNode_t** io_psHead,
+    const sHuffmanAllocator_t* i_psAllocator);
+
+/**
+ * @brief Find the code length of each leaf in a Huffman tree.
+ *
+ * This function walks the tree and sets the code length of each leaf's
+ * character to its depth. A tree consisting of a single leaf is given a code
+ * length of 1 so that the symbol is still encoded with one bit. The lengths of
+ * characters not in the tree are set to 0.
+ *
+ * @param[in] i_psRoot The root of the Huffman tree.
+ * @param[out] o_aCodeLengths The code length of each symbol.
+ * @return size_t The maximum code length in the tree.
+ */
+extern size_t getCodeLengthsFromHuffmanTree(
+    const sBinaryTreeNode_t* i_psRoot,
+    uint8_t o_aCodeLengths[HUFFMAN_ALPHABET_SIZE]);
+
+/**
+ * @brief Create length-limited Huffman code lengths from symbol frequencies.
+ *
+ * This function builds a Huffman tree from the frequencies, using the
+ * letter-frequency and binary tree node lists, and reads the code lengths from
+ * it. If the tree is deeper than HUFFMAN_MAX_CODE_LENGTH, then the frequencies
+ * are halved, keeping every used symbol non-zero, and the tree is rebuilt.
+ *
+ * @param[in] i_aFrequencies The frequency of each symbol.
+ * @param[out] o_aCodeLengths The code length of each symbol.
+ * @return int EXIT_SUCCESS if the code lengths were created successfully, else
+ * EXIT_FAILURE.
+ */
+extern int createCodeLengthsFromFrequencies(
+    const size_t i_aFrequencies[HUFFMAN_ALPHABET_SIZE],
+    uint8_t o_aCodeLengths[HUFFMAN_ALPHABET_SIZE]);
+
+/**
+ * @brief Create length-limited Huffman code lengths from symbol frequencies,
+ * allocating the intermediate lists and trees with the given allocator.
+ *
+ * @param[in] i_aFrequencies The frequency of each symbol.
+ * @param[out] o_aCodeLengths The code length of each symbol.
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ * @return int EXIT_SUCCESS if the code lengths were created successfully, else
+ * EXIT_FAILURE.
+ */
+extern int createCodeLengthsFromFrequenciesWithAllocator(
+    const size_t i_aFrequencies[HUFFMAN_ALPHABET_SIZE],
+    uint8_t o_aCodeLengths[HUFFMAN_ALPHABET_SIZE],
+    const sHuffmanAllocator_t* i_psAllocator);
+
+/**
+ * @brief Create length-limited Huffman code lengths from symbol frequencies
+ * without allocating.
+ *
+ * This function produces the same code lengths as
+ * createCodeLengthsFromFrequencies, using a binary heap over the workspace's
+ * node arrays in place of the letter-frequency and binary tree node lists.
+ *
+ * @param[in] i_aFrequencies The frequency of each symbol.
+ * @param[out] o_aCodeLengths The code length of each symbol.
+ * @param[inout] io_psWorkspace The scratch memory for building the tree.
+ */
+extern void createCodeLengthsWithWorkspace(
+    const size_t i_aFrequencies[HUFFMAN_ALPHABET_SIZE],
+    uint8_t o_aCodeLengths[HUFFMAN_ALPHABET_SIZE],
+    sHuffmanTreeWorkspace_t* io_psWorkspace);
+
+/**
+ * @brief Create a canonical Huffman code table from code lengths.
+ *
+ * This function assigns canonical codes to each symbol, with shorter codes
+ * first and ties broken by symbol value. It returns EXIT_FAILURE if the
+ * lengths do not describe a complete prefix code, unless a single symbol is
+ * used with a code length of 1.
+ *
+ * @param[in] i_aCodeLengths The code length of each symbol.
+ * @param[out] o_psCodeTable The canonical code table.
+ * @return int EXIT_SUCCESS if the code table was created successfully, else
+ * EXIT_FAILURE.
+ */
+extern int createCanonicalCodeTable(
+    const uint8_t i_aCodeLengths[HUFFMAN_ALPHABET_SIZE],
+    sHuffmanCodeTable_t* o_psCodeTable);
+
+/**
+ * @brief Create the tables for decoding canonical codes of the given lengths.
+ *
+ * The lengths must already have been validated by createCanonicalCodeTable.
+ *
+ * @param[in] i_aCodeLengths The code length of each symbol.
+ * @param[out] o_psDecoder The canonical decoding tables.
+ */
+extern void createCanonicalDecoder(
+    const uint8_t i_aCodeLengths[HUFFMAN_ALPHABET_SIZE],
+    sHuffmanCanonicalDecoder_t* o_psDecoder);
+
+/**
+ * @brief Fill a decode table from a canonical code table.
+ *
+ * Every entry whose low bits start with a code of at most
+ * HUFFMAN_DECODE_TABLE_BITS bits is set to that code's symbol and length.
+ * The remaining entries are left as 0.
+ *
+ * @param[in] i_psCodeTable The canonical code table.
+ * @param[out] o_aDecodeTable The decode table.
+ * @return size_t The maximum code length in the code table.
+ */
+extern size_t createDecodeTable(
+    const sHuffmanCodeTable_t* i_psCodeTable,
+    decodeTableEntry_t o_aDecodeTable[HUFFMAN_DECODE_TABLE_SIZE]);
+
+/**
+ * @brief Fill a multi-symbol decode table from a decode table, for alphabets
+ * of at most HUFFMAN_TINY_ALPHABET_SIZE symbols.
+ *
+ * Each entry holds every whole code, up to HUFFMAN_MULTI_SYMBOL_MAX_CODES,
+ * that starts in the low HUFFMAN_DECODE_TABLE_BITS bits of its index, so
+ * short codes are decoded several per lookup. The table is only built when
+ * the alphabet is small enough and every code fits in the decode table, so
+ * that every entry of a complete code holds at least one symbol.
+ *
+ * @param[in] i_psCodeTable The canonical code table.
+ * @param[in] i_aDecodeTable The decode table of the code table.
+ * @param[out] o_aMultiSymbolTable The multi-symbol decode table.
+ * @return bool Whether the table was built.
+ */
+extern bool createMultiSymbolDecodeTable(
+    const sHuffmanCodeTable_t* i_psCodeTable,
+    const decodeTableEntry_t i_aDecodeTable[HUFFMAN_DECODE_TABLE_SIZE],
+    multiSymbolEntry_t o_aMultiSymbolTable[HUFFMAN_DECODE_TABLE_SIZE]);
+
+/**
+ * @brief Lay out the canonical Huffman tree of a code table as a nibble
+ * tree.
+ *
+ * The nodes are those of the tree from createHuffmanTreeFromCodeLengths at
+ * every HUFFMAN_NIBBLE_TREE_BITS-th level, found from the codes without
+ * building the tree.
+ *
+ * @param[in] i_psCodeTable The canonical code table.
+ * @param[out] o_psTree The nibble tree.
+ */
+extern void createNibbleTree(const sHuffmanCodeTable_t* i_psCodeTable,
+                             sHuffmanNibbleTree_t* o_psTree);
+
+/**
+ * @brief Create the canonical Huffman tree described by code lengths.
+ *
+ * This function rebuilds, from the bottom level up, the binary tree whose
+ * left and right links spell out the canonical codes of the given lengths,
+ * merging each pair of nodes with mergeBinaryTreeNodes. The lengths must
+ * describe a complete prefix code. It returns NULL if any error occurs.
+ *
+ * @param[in] i_aCodeLengths The code length of each symbol.
+ * @return sBinaryTreeNode_t* The root of the canonical Huffman tree, else
+ * NULL.
+ */
+extern sBinaryTreeNode_t* createHuffmanTreeFromCodeLengths(
+    const uint8_t i_aCodeLengths[HUFFMAN_ALPHABET_SIZE]);
+
+/**
+ * @brief Create the canonical Huffman tree described by code lengths,
+ * allocating the nodes with the given allocator.
+ *
+ * @param[in] i_aCodeLengths The code length of each symbol.
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ * @return sBinaryTreeNode_t* The root of the canonical Huffman tree, else
+ * NULL.
+ */
+extern sBinaryTreeNode_t* createHuffmanTreeFromCodeLengthsWithAllocator(
+    const uint8_t i_aCodeLengths[HUFFMAN_ALPHABET_SIZE],
+    const sHuffmanAllocator_t* i_psAllocator);
+
+#endif  // HUFFMAN_TREE_H
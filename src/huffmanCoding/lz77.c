@@ -0,0 +1,1214 @@
+/**
+ * @file lz77.c
+ * @brief Compress and decompress buffers with an LZ77 front end and Huffman
+ * coded tokens.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+/* Standard Library Includes */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Project Includes */
+
+#include "huffmanCoding/allocator.h"
+#include "huffmanCoding/bitStream.h"
+#include "huffmanCoding/codec.h"
+#include "huffmanCoding/decodeKernel.h"
+#include "huffmanCoding/encodeKernel.h"
+#include "huffmanCoding/huffmanTree.h"
+#include "huffmanCoding/lz77.h"
+
+/* Constants */
+
+/**< The magic bytes at the start of an LZ77 container. */
+static const uint8_t HEADER_MAGIC[4] = {'H', 'U', 'F', 'L'};
+
+/**< The LZ77 container format version. */
+#define LZ77_FORMAT_VERSION 1
+
+/**< Length symbols below this code literal runs, the rest match lengths. */
+#define MATCH_LENGTH_SYMBOL_BASE 128
+
+/**< Values below this are coded by their symbol alone. */
+#define DIRECT_VALUE_COUNT 16
+
+/**< The number of hash bits of the fast level's single-entry table. */
+#define FAST_HASH_BITS 14
+
+/**< The number of hash bits of the greedy level's chain heads. */
+#define GREEDY_HASH_BITS 15
+
+/**< The number of chained candidates the greedy level compares. */
+#define GREEDY_MAX_CANDIDATES 16
+
+/**< Misses before the fast level's step grows by a byte. */
+#define FAST_SKIP_SHIFT 5
+
+/**< No match starts in the last bytes of a block, so that hashing the four
+ * bytes at a position never reads past the block. */
+#define MATCH_START_MARGIN 8
+
+/**< Refill the bit reader below this many bits, enough for a code and its
+ * extra bits. */
+#define TOKEN_REFILL_BITS 48
+
+/* Type Definitions */
+
+/**
+ * @brief The code tables of a block.
+ */
+typedef enum eLz77Table {
+  LZ77_TABLE_LITERALS,
+  LZ77_TABLE_LENGTHS,
+  LZ77_TABLE_DISTANCES,
+  LZ77_TABLE_COUNT
+} eLz77Table_t;
+
+/**
+ * @brief A run of literals followed by a match.
+ *
+ * The last sequence of a block has no match, and its match length and
+ * distance are 0.
+ */
+typedef struct sLz77Sequence {
+  uint32_t literalCount;
+  uint32_t matchLength;
+  uint32_t distance;
+} sLz77Sequence_t;
+
+/**
+ * @brief Scratch memory for compressing blocks.
+ */
+typedef struct sLz77Encoder {
+  const sHuffmanAllocator_t* psAllocator;
+  eHuffmanLz77Level_t eLevel;
+  sLz77Sequence_t* aSequences;
+  size_t sequenceCount;
+  uint32_t* aHashTable; /**< Heads of the chains, or the last positions. */
+  uint32_t* aChain;     /**< The previous position of each, or NULL. */
+  size_t aaFrequencies[LZ77_TABLE_COUNT][HUFFMAN_ALPHABET_SIZE];
+  uint64_t extraBits; /**< The number of raw bits after the length codes. */
+  uint8_t aaCodeLengths[LZ77_TABLE_COUNT][HUFFMAN_ALPHABET_SIZE];
+  sHuffmanCodeTable_t asCodeTables[LZ77_TABLE_COUNT];
+} sLz77Encoder_t;
+
+/**
+ * @brief The tables for decoding one alphabet of a block.
+ */
+typedef struct sLz77DecodeTable {
+  decodeTableEntry_t aDecodeTable[HUFFMAN_DECODE_TABLE_SIZE];
+  sHuffmanCanonicalDecoder_t sCanonicalDecoder;
+} sLz77DecodeTable_t;
+
+/* Function Prototypes */
+
+/**
+ * @brief Find the symbol and extra bits that code a length or distance.
+ *
+ * Values below DIRECT_VALUE_COUNT are their own symbol. Larger values are
+ * bucketed by their highest bit and the two bits below it, and the bits
+ * below those follow the symbol as extra bits.
+ *
+ * @param[in] i_value The value to code.
+ * @param[out] o_pExtraCount The number of extra bits, at most 28.
+ * @return uint32_t The symbol, less than MATCH_LENGTH_SYMBOL_BASE.
+ */
+static inline uint32_t getValueSymbol(uint32_t i_value,
+                                      uint32_t* o_pExtraCount);
+
+/**
+ * @brief Find the smallest value of a symbol and its number of extra bits.
+ *
+ * @param[in] i_symbol The symbol, less than MATCH_LENGTH_SYMBOL_BASE.
+ * @param[out] o_pExtraCount The number of extra bits.
+ * @return uint32_t The smallest value coded by the symbol.
+ */
+static inline uint32_t getSymbolBase(uint32_t i_symbol,
+                                     uint32_t* o_pExtraCount);
+
+/**
+ * @brief Hash the four bytes at a position.
+ *
+ * @param[in] i_pSource The first of the four bytes.
+ * @param[in] i_hashBits The number of bits in the hash.
+ * @return uint32_t The hash.
+ */
+static inline uint32_t hashBytes(const uint8_t* i_pSource, uint32_t i_hashBits);
+
+/**
+ * @brief Find how many bytes match from two positions.
+ *
+ * @param[in] i_pInput The block.
+ * @param[in] i_candidate The earlier position.
+ * @param[in] i_position The later position.
+ * @param[in] i_end The end of the block.
+ * @return size_t The number of matching bytes, stopping at the end.
+ */
+static inline size_t extendMatch(const uint8_t* i_pInput, size_t i_candidate,
+                                 size_t i_position, size_t i_end);
+
+/**
+ * @brief Record a sequence and count the symbols that code it.
+ *
+ * @param[inout] io_psEncoder The encoder.
+ * @param[in] i_pLiterals The literals of the sequence.
+ * @param[in] i_literalCount The number of literals.
+ * @param[in] i_matchLength The length of the match, or 0 if there is none.
+ * @param[in] i_distance The distance back to the match, or 0 if there is
+ * none.
+ */
+static void addSequence(sLz77Encoder_t* io_psEncoder,
+                        const uint8_t* i_pLiterals, size_t i_literalCount,
+                        size_t i_matchLength, size_t i_distance);
+
+/**
+ * @brief Parse a block into sequences with a single-entry hash table.
+ *
+ * @param[inout] io_psEncoder The encoder.
+ * @param[in] i_pInput The bytes of the block.
+ * @param[in] i_inputSize The number of bytes in the block.
+ */
+static void parseFast(sLz77Encoder_t* io_psEncoder, const uint8_t* i_pInput,
+                      size_t i_inputSize);
+
+/**
+ * @brief Parse a block into sequences with hash chains, taking the longest
+ * match found at each position.
+ *
+ * @param[inout] io_psEncoder The encoder.
+ * @param[in] i_pInput The bytes of the block.
+ * @param[in] i_inputSize The number of bytes in the block.
+ */
+static void parseGreedy(sLz77Encoder_t* io_psEncoder, const uint8_t* i_pInput,
+                        size_t i_inputSize);
+
+/**
+ * @brief Write the value of a length or distance after its code.
+ *
+ * @param[inout] io_psWriter The bit writer.
+ * @param[in] i_psCodeTable The code table of the symbol.
+ * @param[in] i_symbolBase The symbol of the first bucket in the table.
+ * @param[in] i_value The value to write.
+ */
+static inline void writeValue(sBitWriter_t* io_psWriter,
+                              const sHuffmanCodeTable_t* i_psCodeTable,
+                              uint32_t i_symbolBase, uint32_t i_value);
+
+/**
+ * @brief Compress a single block.
+ *
+ * @param[inout] io_psEncoder The encoder.
+ * @param[in] i_pInput The bytes of the block.
+ * @param[in] i_inputSize The number of bytes in the block.
+ * @param[out] o_pOutput The buffer to write the block to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @param[out] o_pBlockSize The number of bytes written.
+ * @return int EXIT_SUCCESS if the block was compressed successfully, else
+ * EXIT_FAILURE.
+ */
+static int encodeLz77Block(sLz77Encoder_t* io_psEncoder,
+                           const uint8_t* i_pInput, size_t i_inputSize,
+                           uint8_t* o_pOutput, size_t i_outputCapacity,
+                           size_t* o_pBlockSize);
+
+/**
+ * @brief Load the decoding tables of an alphabet from packed code lengths.
+ *
+ * @param[in] i_pCodeLengths The packed code lengths.
+ * @param[out] o_psTable The decoding tables.
+ * @return int EXIT_SUCCESS if the code lengths describe a valid code, else
+ * EXIT_FAILURE.
+ */
+static int loadLz77DecodeTable(const uint8_t* i_pCodeLengths,
+                               sLz77DecodeTable_t* o_psTable);
+
+/**
+ * @brief Decode a long code with the canonical decoding tables.
+ *
+ * @param[in] i_psDecoder The canonical decoding tables.
+ * @param[inout] io_psReader The bit reader positioned at the code.
+ * @param[out] o_pSymbol The decoded symbol.
+ * @return int EXIT_SUCCESS if a symbol was decoded, else EXIT_FAILURE.
+ */
+static int decodeLongCode(const sHuffmanCanonicalDecoder_t* i_psDecoder,
+                          sBitReader_t* io_psReader, uint32_t* o_pSymbol);
+
+/**
+ * @brief Decode a length or distance.
+ *
+ * @param[in] i_psTable The decoding tables of the alphabet.
+ * @param[inout] io_psReader The bit reader positioned at the code.
+ * @param[in] i_symbolBase The symbol of the first bucket in the table.
+ * @param[out] o_pValue The decoded value.
+ * @return int EXIT_SUCCESS if a value was decoded, else EXIT_FAILURE.
+ */
+static int decodeValue(const sLz77DecodeTable_t* i_psTable,
+                       sBitReader_t* io_psReader, uint32_t i_symbolBase,
+                       uint32_t* o_pValue);
+
+/**
+ * @brief Decode a run of literals.
+ *
+ * @param[in] i_psTable The decoding tables of the literals.
+ * @param[inout] io_psReader The bit reader positioned at the first code.
+ * @param[out] o_pOutput The buffer to write the literals to.
+ * @param[in] i_literalCount The number of literals.
+ * @return int EXIT_SUCCESS if the literals were decoded, else EXIT_FAILURE.
+ */
+static int decodeLiterals(const sLz77DecodeTable_t* i_psTable,
+                          sBitReader_t* io_psReader, uint8_t* o_pOutput,
+                          size_t i_literalCount);
+
+/**
+ * @brief Decompress a single block.
+ *
+ * @param[in] i_pInput The block, starting at its header.
+ * @param[in] i_inputSize The number of bytes available in the input.
+ * @param[out] o_pOutput The buffer to write the uncompressed bytes to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @param[out] o_pBlockSize The number of input bytes the block occupies.
+ * @param[out] o_pOutputSize The number of bytes written to the output.
+ * @return int EXIT_SUCCESS if the block was decompressed successfully, else
+ * EXIT_FAILURE.
+ */
+static int decodeLz77Block(const uint8_t* i_pInput, size_t i_inputSize,
+                           uint8_t* o_pOutput, size_t i_outputCapacity,
+                           size_t* o_pBlockSize, size_t* o_pOutputSize);
+
+/**
+ * @brief Find the level and block size to compress with.
+ *
+ * @param[in] i_psOptions The compression options, or NULL for the defaults.
+ * @param[out] o_psOptions The options with the defaults filled in.
+ * @return int EXIT_SUCCESS if the options are valid, else EXIT_FAILURE.
+ */
+static int getValidLz77Options(const sHuffmanLz77Options_t* i_psOptions,
+                               sHuffmanLz77Options_t* o_psOptions);
+
+/* Function Definitions */
+
+/**
+ * @brief Find the symbol and extra bits that code a length or distance.
+ *
+ * Values below DIRECT_VALUE_COUNT are their own symbol. Larger values are
+ * bucketed by their highest bit and the two bits below it, and the bits
+ * below those follow the symbol as extra bits.
+ *
+ * @param[in] i_value The value to code.
+ * @param[out] o_pExtraCount The number of extra bits, at most 28.
+ * @return uint32_t The symbol, less than MATCH_LENGTH_SYMBOL_BASE.
+ */
+static inline uint32_t getValueSymbol(uint32_t i_value,
+                                      uint32_t* o_pExtraCount) {
+  if (i_value < DIRECT_VALUE_COUNT) {
+    *o_pExtraCount = 0;
+    return i_value;
+  }
+
+  const uint32_t highBit = 31U - (uint32_t)__builtin_clz(i_value);
+  *o_pExtraCount = highBit - 2;
+  return DIRECT_VALUE_COUNT + ((highBit - 4) << 2) +
+         ((i_value >> (highBit - 2)) & 3U);
+}
+
+/**
+ * @brief Find the smallest value of a symbol and its number of extra bits.
+ *
+ * @param[in] i_symbol The symbol, less than MATCH_LENGTH_SYMBOL_BASE.
+ * @param[out] o_pExtraCount The number of extra bits.
+ * @return uint32_t The smallest value coded by the symbol.
+ */
+static inline uint32_t getSymbolBase(uint32_t i_symbol,
+                                     uint32_t* o_pExtraCount) {
+  if (i_symbol < DIRECT_VALUE_COUNT) {
+    *o_pExtraCount = 0;
+    return i_symbol;
+  }
+
+  const uint32_t bucket = i_symbol - DIRECT_VALUE_COUNT;
+  *o_pExtraCount = (bucket >> 2) + 2;
+  return (4U | (bucket & 3U)) << *o_pExtraCount;
+}
+
+/**
+ * @brief Hash the four bytes at a position.
+ *
+ * @param[in] i_pSource The first of the four bytes.
+ * @param[in] i_hashBits The number of bits in the hash.
+ * @return uint32_t The hash.
+ */
+static inline uint32_t hashBytes(const uint8_t* i_pSource,
+                                 uint32_t i_hashBits) {
+  return (loadLittleEndian32(i_pSource) * 2654435761U) >> (32 - i_hashBits);
+}
+
+/**
+ * @brief Find how many bytes match from two positions.
+ *
+ * Eight bytes are compared at a time, and the first differing byte is found
+ * from the lowest set bit of their difference.
+ *
+ * @param[in] i_pInput The block.
+ * @param[in] i_candidate The earlier position.
+ * @param[in] i_position The later position.
+ * @param[in] i_end The end of the block.
+ * @return size_t The number of matching bytes, stopping at the end.
+ */
+static inline size_t extendMatch(const uint8_t* i_pInput, size_t i_candidate,
+                                 size_t i_position, size_t i_end) {
+  size_t length = 0;
+  while (i_position + length + 8 <= i_end) {
+    const uint64_t difference =
+        loadLittleEndian64(&i_pInput[i_candidate + length]) ^
+        loadLittleEndian64(&i_pInput[i_position + length]);
+    if (difference != 0) {
+      return length + ((size_t)__builtin_ctzll(difference) >> 3);
+    }
+    length += 8;
+  }
+  while (i_position + length < i_end &&
+         i_pInput[i_candidate + length] == i_pInput[i_position + length]) {
+    length++;
+  }
+  return length;
+}
+
+/**
+ * @brief Record a sequence and count the symbols that code it.
+ *
+ * @param[inout] io_psEncoder The encoder.
+ * @param[in] i_pLiterals The literals of the sequence.
+ * @param[in] i_literalCount The number of literals.
+ * @param[in] i_matchLength The length of the match, or 0 if there is none.
+ * @param[in] i_distance The distance back to the match, or 0 if there is
+ * none.
+ */
+static void addSequence(sLz77Encoder_t* io_psEncoder,
+                        const uint8_t* i_pLiterals, size_t i_literalCount,
+                        size_t i_matchLength, size_t i_distance) {
+  sLz77Sequence_t* psSequence =
+      &io_psEncoder->aSequences[io_psEncoder->sequenceCount++];
+  psSequence->literalCount = (uint32_t)i_literalCount;
+  psSequence->matchLength = (uint32_t)i_matchLength;
+  psSequence->distance = (uint32_t)i_distance;
+
+  size_t* aLiteralFrequencies =
+      io_psEncoder->aaFrequencies[LZ77_TABLE_LITERALS];
+  for (size_t i = 0; i < i_literalCount; i++) {
+    aLiteralFrequencies[i_pLiterals[i]]++;
+  }
+
+  uint32_t extraCount = 0;
+  io_psEncoder->aaFrequencies[LZ77_TABLE_LENGTHS]
+                             [getValueSymbol((uint32_t)i_literalCount,
+                                             &extraCount)]++;
+  io_psEncoder->extraBits += extraCount;
+  if (i_matchLength == 0) {
+    return;
+  }
+
+  io_psEncoder->aaFrequencies[LZ77_TABLE_LENGTHS]
+                             [MATCH_LENGTH_SYMBOL_BASE +
+                              getValueSymbol((uint32_t)(i_matchLength -
+                                                        HUFFMAN_LZ77_MIN_MATCH),
+                                             &extraCount)]++;
+  io_psEncoder->extraBits += extraCount;
+  io_psEncoder->aaFrequencies[LZ77_TABLE_DISTANCES]
+                             [getValueSymbol((uint32_t)i_distance,
+                                             &extraCount)]++;
+  io_psEncoder->extraBits += extraCount;
+}
+
+/**
+ * @brief Parse a block into sequences with a single-entry hash table.
+ *
+ * Each position is hashed and compared with the last position of the same
+ * hash only. After repeated misses the parser steps over more bytes at a
+ * time, so incompressible data is skipped quickly.
+ *
+ * @param[inout] io_psEncoder The encoder.
+ * @param[in] i_pInput The bytes of the block.
+ * @param[in] i_inputSize The number of bytes in the block.
+ */
+static void parseFast(sLz77Encoder_t* io_psEncoder, const uint8_t* i_pInput,
+                      size_t i_inputSize) {
+  uint32_t* aHashTable = io_psEncoder->aHashTable;
+  (void)memset(aHashTable, 0, sizeof(uint32_t) << FAST_HASH_BITS);
+
+  const size_t limit = (i_inputSize > MATCH_START_MARGIN)
+                           ? i_inputSize - MATCH_START_MARGIN
+                           : 0;
+  size_t anchor = 0;
+  size_t position = 0;
+  size_t misses = 0;
+
+  while (position < limit) {
+    const uint32_t hash = hashBytes(&i_pInput[position], FAST_HASH_BITS);
+    size_t candidate = aHashTable[hash];
+    aHashTable[hash] = (uint32_t)position;
+
+    if (candidate >= position ||
+        loadLittleEndian32(&i_pInput[candidate]) !=
+            loadLittleEndian32(&i_pInput[position])) {
+      position += 1 + (misses++ >> FAST_SKIP_SHIFT);
+      continue;
+    }
+
+    size_t matchLength =
+        HUFFMAN_LZ77_MIN_MATCH +
+        extendMatch(i_pInput, candidate + HUFFMAN_LZ77_MIN_MATCH,
+                    position + HUFFMAN_LZ77_MIN_MATCH, i_inputSize);
+
+    /* Extend the match back over any literals that also match. */
+    while (position > anchor && candidate > 0 &&
+           i_pInput[position - 1] == i_pInput[candidate - 1]) {
+      position--;
+      candidate--;
+      matchLength++;
+    }
+
+    addSequence(io_psEncoder, &i_pInput[anchor], position - anchor,
+                matchLength, position - candidate);
+    position += matchLength;
+    anchor = position;
+    misses = 0;
+
+    /* Index a position inside the match to find the next one sooner. */
+    if (position - 2 < limit) {
+      aHashTable[hashBytes(&i_pInput[position - 2], FAST_HASH_BITS)] =
+          (uint32_t)(position - 2);
+    }
+  }
+
+  addSequence(io_psEncoder, &i_pInput[anchor], i_inputSize - anchor, 0, 0);
+}
+
+/**
+ * @brief Parse a block into sequences with hash chains, taking the longest
+ * match found at each position.
+ *
+ * Chain heads and links hold a position plus one, so that 0 ends a chain.
+ * Every position is added to its chain, including those inside matches.
+ *
+ * @param[inout] io_psEncoder The encoder.
+ * @param[in] i_pInput The bytes of the block.
+ * @param[in] i_inputSize The number of bytes in the block.
+ */
+static void parseGreedy(sLz77Encoder_t* io_psEncoder, const uint8_t* i_pInput,
+                        size_t i_inputSize) {
+  uint32_t* aHeads = io_psEncoder->aHashTable;
+  uint32_t* aChain = io_psEncoder->aChain;
+  (void)memset(aHeads, 0, sizeof(uint32_t) << GREEDY_HASH_BITS);
+
+  const size_t limit = (i_inputSize > MATCH_START_MARGIN)
+                           ? i_inputSize - MATCH_START_MARGIN
+                           : 0;
+  size_t anchor = 0;
+  size_t position = 0;
+
+  while (position < limit) {
+    const uint32_t hash = hashBytes(&i_pInput[position], GREEDY_HASH_BITS);
+    size_t bestLength = 0;
+    size_t bestCandidate = 0;
+    uint32_t link = aHeads[hash];
+
+    for (size_t i = 0; i < GREEDY_MAX_CANDIDATES && link != 0; i++) {
+      const size_t candidate = link - 1;
+      link = aChain[candidate];
+
+      /* Only a longer match can differ at the best length so far. */
+      if (i_pInput[candidate + bestLength] != i_pInput[position + bestLength]) {
+        continue;
+      }
+      const size_t length =
+          extendMatch(i_pInput, candidate, position, i_inputSize);
+      if (length > bestLength) {
+        bestLength = length;
+        bestCandidate = candidate;
+        if (position + bestLength == i_inputSize) {
+          break;
+        }
+      }
+    }
+
+    aChain[position] = aHeads[hash];
+    aHeads[hash] = (uint32_t)(position + 1);
+
+    if (bestLength < HUFFMAN_LZ77_MIN_MATCH) {
+      position++;
+      continue;
+    }
+
+    addSequence(io_psEncoder, &i_pInput[anchor], position - anchor,
+                bestLength, position - bestCandidate);
+    const size_t matchEnd = position + bestLength;
+    for (position++; position < matchEnd && position < limit; position++) {
+      const uint32_t matchHash =
+          hashBytes(&i_pInput[position], GREEDY_HASH_BITS);
+      aChain[position] = aHeads[matchHash];
+      aHeads[matchHash] = (uint32_t)(position + 1);
+    }
+    position = matchEnd;
+    anchor = position;
+  }
+
+  addSequence(io_psEncoder, &i_pInput[anchor], i_inputSize - anchor, 0, 0);
+}
+
+/**
+ * @brief Write the value of a length or distance after its code.
+ *
+ * @param[inout] io_psWriter The bit writer.
+ * @param[in] i_psCodeTable The code table of the symbol.
+ * @param[in] i_symbolBase The symbol of the first bucket in the table.
+ * @param[in] i_value The value to write.
+ */
+static inline void writeValue(sBitWriter_t* io_psWriter,
+                              const sHuffmanCodeTable_t* i_psCodeTable,
+                              uint32_t i_symbolBase, uint32_t i_value) {
+  uint32_t extraCount = 0;
+  const uint32_t symbol =
+      i_symbolBase + getValueSymbol(i_value, &extraCount);
+  writeBits(io_psWriter, i_psCodeTable->aCodes[symbol],
+            i_psCodeTable->aCodeLengths[symbol]);
+  if (extraCount > 0) {
+    writeBits(io_psWriter, i_value & ((1U << extraCount) - 1), extraCount);
+  }
+}
+
+/**
+ * @brief Compress a single block.
+ *
+ * This function parses the block into sequences, builds a canonical code
+ * table for each alphabet from the counted symbols and, if coding makes the
+ * block smaller, writes the tables followed by the coded sequences.
+ * Otherwise the block is stored as-is.
+ *
+ * @param[inout] io_psEncoder The encoder.
+ * @param[in] i_pInput The bytes of the block.
+ * @param[in] i_inputSize The number of bytes in the block.
+ * @param[out] o_pOutput The buffer to write the block to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @param[out] o_pBlockSize The number of bytes written.
+ * @return int EXIT_SUCCESS if the block was compressed successfully, else
+ * EXIT_FAILURE.
+ */
+static int encodeLz77Block(sLz77Encoder_t* io_psEncoder,
+                           const uint8_t* i_pInput, size_t i_inputSize,
+                           uint8_t* o_pOutput, size_t i_outputCapacity,
+                           size_t* o_pBlockSize) {
+  (void)memset(io_psEncoder->aaFrequencies, 0,
+               sizeof(io_psEncoder->aaFrequencies));
+  io_psEncoder->sequenceCount = 0;
+  io_psEncoder->extraBits = 0;
+
+  if (io_psEncoder->eLevel == HUFFMAN_LZ77_LEVEL_FAST) {
+    parseFast(io_psEncoder, i_pInput, i_inputSize);
+  } else {
+    parseGreedy(io_psEncoder, i_pInput, i_inputSize);
+  }
+
+  /* The coded size is known exactly before writing anything. */
+  uint64_t codedBits = io_psEncoder->extraBits;
+  for (size_t table = 0; table < LZ77_TABLE_COUNT; table++) {
+    if (createCodeLengthsFromFrequenciesWithAllocator(
+            io_psEncoder->aaFrequencies[table],
+            io_psEncoder->aaCodeLengths[table],
+            io_psEncoder->psAllocator) == EXIT_FAILURE ||
+        createCanonicalCodeTable(io_psEncoder->aaCodeLengths[table],
+                                 &io_psEncoder->asCodeTables[table]) ==
+            EXIT_FAILURE) {
+      return EXIT_FAILURE;
+    }
+    for (size_t symbol = 0; symbol < HUFFMAN_ALPHABET_SIZE; symbol++) {
+      codedBits += (uint64_t)io_psEncoder->aaFrequencies[table][symbol] *
+                   io_psEncoder->aaCodeLengths[table][symbol];
+    }
+  }
+
+  const size_t codedSize = (size_t)((codedBits + 7) / 8);
+  const int isStored = (HUFFMAN_LZ77_TABLES_SIZE + codedSize >= i_inputSize);
+  const size_t blockSize =
+      HUFFMAN_LZ77_BLOCK_HEADER_SIZE +
+      (isStored ? i_inputSize : HUFFMAN_LZ77_TABLES_SIZE + codedSize);
+
+  if (blockSize > i_outputCapacity) {
+    (void)fprintf(stderr, "ERROR: Output buffer is too small\n");
+    return EXIT_FAILURE;
+  }
+
+  storeLittleEndian32(&o_pOutput[0], (uint32_t)i_inputSize);
+  storeLittleEndian32(&o_pOutput[4],
+                      (uint32_t)(isStored ? i_inputSize : codedSize));
+  o_pOutput[8] = isStored ? HUFFMAN_BLOCK_FLAG_STORED : 0;
+  uint8_t* pBody = &o_pOutput[HUFFMAN_LZ77_BLOCK_HEADER_SIZE];
+  *o_pBlockSize = blockSize;
+
+  if (isStored) {
+    (void)memcpy(pBody, i_pInput, i_inputSize);
+    return EXIT_SUCCESS;
+  }
+
+  storeLittleEndian32(pBody, (uint32_t)io_psEncoder->sequenceCount);
+  for (size_t table = 0; table < LZ77_TABLE_COUNT; table++) {
+    const uint8_t* aCodeLengths = io_psEncoder->aaCodeLengths[table];
+    uint8_t* pPacked = &pBody[4 + (table * HUFFMAN_CODE_LENGTHS_SIZE)];
+    for (size_t i = 0; i < HUFFMAN_CODE_LENGTHS_SIZE; i++) {
+      pPacked[i] =
+          (uint8_t)(aCodeLengths[2 * i] | (aCodeLengths[(2 * i) + 1] << 4));
+    }
+  }
+
+  const sHuffmanCodeTable_t* psLiterals =
+      &io_psEncoder->asCodeTables[LZ77_TABLE_LITERALS];
+  const sHuffmanCodeTable_t* psLengths =
+      &io_psEncoder->asCodeTables[LZ77_TABLE_LENGTHS];
+  const sHuffmanCodeTable_t* psDistances =
+      &io_psEncoder->asCodeTables[LZ77_TABLE_DISTANCES];
+  sBitWriter_t sWriter;
+  initBitWriter(&sWriter, &pBody[HUFFMAN_LZ77_TABLES_SIZE]);
+  size_t position = 0;
+
+  for (size_t i = 0; i < io_psEncoder->sequenceCount; i++) {
+    const sLz77Sequence_t* psSequence = &io_psEncoder->aSequences[i];
+    writeValue(&sWriter, psLengths, 0, psSequence->literalCount);
+    encodeTableSymbols(psLiterals, &i_pInput[position],
+                       psSequence->literalCount, &sWriter);
+    position += psSequence->literalCount;
+    if (psSequence->matchLength == 0) {
+      break;
+    }
+
+    writeValue(&sWriter, psLengths, MATCH_LENGTH_SYMBOL_BASE,
+               psSequence->matchLength - HUFFMAN_LZ77_MIN_MATCH);
+    writeValue(&sWriter, psDistances, 0, psSequence->distance);
+    position += psSequence->matchLength;
+  }
+  (void)flushBitWriter(&sWriter);
+
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Load the decoding tables of an alphabet from packed code lengths.
+ *
+ * @param[in] i_pCodeLengths The packed code lengths.
+ * @param[out] o_psTable The decoding tables.
+ * @return int EXIT_SUCCESS if the code lengths describe a valid code, else
+ * EXIT_FAILURE.
+ */
+static int loadLz77DecodeTable(const uint8_t* i_pCodeLengths,
+                               sLz77DecodeTable_t* o_psTable) {
+  uint8_t aCodeLengths[HUFFMAN_ALPHABET_SIZE];
+  for (size_t i = 0; i < HUFFMAN_CODE_LENGTHS_SIZE; i++) {
+    aCodeLengths[2 * i] = i_pCodeLengths[i] & 0x0FU;
+    aCodeLengths[(2 * i) + 1] = i_pCodeLengths[i] >> 4;
+  }
+
+  sHuffmanCodeTable_t sCodeTable;
+  if (createCanonicalCodeTable(aCodeLengths, &sCodeTable) == EXIT_FAILURE) {
+    return EXIT_FAILURE;
+  }
+  (void)createDecodeTable(&sCodeTable, o_psTable->aDecodeTable);
+  createCanonicalDecoder(aCodeLengths, &o_psTable->sCanonicalDecoder);
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Decode a long code with the canonical decoding tables.
+ *
+ * This function reads the code one bit at a time, most significant bit
+ * first, until it lies within the codes of its length.
+ *
+ * @param[in] i_psDecoder The canonical decoding tables.
+ * @param[inout] io_psReader The bit reader positioned at the code.
+ * @param[out] o_pSymbol The decoded symbol.
+ * @return int EXIT_SUCCESS if a symbol was decoded, else EXIT_FAILURE.
+ */
+static int decodeLongCode(const sHuffmanCanonicalDecoder_t* i_psDecoder,
+                          sBitReader_t* io_psReader, uint32_t* o_pSymbol) {
+  uint32_t code = 0;
+
+  for (size_t length = 1; length <= i_psDecoder->maxLength; length++) {
+    code = (code << 1) | (uint32_t)peekBits(io_psReader, 1);
+    consumeBits(io_psReader, 1);
+
+    /* Codes below the first code of this length wrap to a large index. */
+    const uint32_t index = code - i_psDecoder->aFirstCodes[length];
+    if (index < i_psDecoder->aCounts[length]) {
+      *o_pSymbol = i_psDecoder->aSymbols[i_psDecoder->aOffsets[length] + index];
+      return EXIT_SUCCESS;
+    }
+  }
+
+  (void)fprintf(stderr, "ERROR: Invalid code in block\n");
+  return EXIT_FAILURE;
+}
+
+/**
+ * @brief Decode a length or distance.
+ *
+ * @param[in] i_psTable The decoding tables of the alphabet.
+ * @param[inout] io_psReader The bit reader positioned at the code.
+ * @param[in] i_symbolBase The symbol of the first bucket in the table.
+ * @param[out] o_pValue The decoded value.
+ * @return int EXIT_SUCCESS if a value was decoded, else EXIT_FAILURE.
+ */
+static int decodeValue(const sLz77DecodeTable_t* i_psTable,
+                       sBitReader_t* io_psReader, uint32_t i_symbolBase,
+                       uint32_t* o_pValue) {
+  if (io_psReader->bitCount < TOKEN_REFILL_BITS) {
+    refillBitReader(io_psReader);
+  }
+
+  uint32_t symbol = 0;
+  const decodeTableEntry_t entry =
+      i_psTable->aDecodeTable[peekBits(io_psReader, HUFFMAN_DECODE_TABLE_BITS)];
+  if (entry != 0) {
+    consumeBits(io_psReader, entry & 0x0FU);
+    symbol = (uint32_t)(entry >> 4);
+  } else if (decodeLongCode(&i_psTable->sCanonicalDecoder, io_psReader,
+                            &symbol) == EXIT_FAILURE) {
+    return EXIT_FAILURE;
+  }
+
+  if (symbol < i_symbolBase ||
+      symbol - i_symbolBase >= MATCH_LENGTH_SYMBOL_BASE) {
+    (void)fprintf(stderr, "ERROR: Invalid token in block\n");
+    return EXIT_FAILURE;
+  }
+
+  uint32_t extraCount = 0;
+  *o_pValue = getSymbolBase(symbol - i_symbolBase, &extraCount);
+  if (extraCount > 0) {
+    *o_pValue += (uint32_t)peekBits(io_psReader, extraCount);
+    consumeBits(io_psReader, extraCount);
+  }
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Decode a run of literals.
+ *
+ * Codes up to the decode table width are decoded by the decode kernel, and
+ * longer codes with the canonical decoder.
+ *
+ * @param[in] i_psTable The decoding tables of the literals.
+ * @param[inout] io_psReader The bit reader positioned at the first code.
+ * @param[out] o_pOutput The buffer to write the literals to.
+ * @param[in] i_literalCount The number of literals.
+ * @return int EXIT_SUCCESS if the literals were decoded, else EXIT_FAILURE.
+ */
+static int decodeLiterals(const sLz77DecodeTable_t* i_psTable,
+                          sBitReader_t* io_psReader, uint8_t* o_pOutput,
+                          size_t i_literalCount) {
+  size_t i = 0;
+  while (i < i_literalCount) {
+    i += decodeTableSymbols(i_psTable->aDecodeTable, io_psReader,
+                            &o_pOutput[i], i_literalCount - i);
+    if (i == i_literalCount) {
+      break;
+    }
+
+    /* The kernel stopped at a code longer than the table width. */
+    if (io_psReader->bitCount < HUFFMAN_MAX_CODE_LENGTH) {
+      refillBitReader(io_psReader);
+    }
+    uint32_t symbol = 0;
+    if (decodeLongCode(&i_psTable->sCanonicalDecoder, io_psReader, &symbol) ==
+        EXIT_FAILURE) {
+      return EXIT_FAILURE;
+    }
+    o_pOutput[i++] = (uint8_t)symbol;
+  }
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Decompress a single block.
+ *
+ * Matches are copied eight bytes at a time when they are at least eight
+ * bytes back and the copy stays within the block, and byte by byte
+ * otherwise, which also repeats overlapping matches correctly.
+ *
+ * @param[in] i_pInput The block, starting at its header.
+ * @param[in] i_inputSize The number of bytes available in the input.
+ * @param[out] o_pOutput The buffer to write the uncompressed bytes to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @param[out] o_pBlockSize The number of input bytes the block occupies.
+ * @param[out] o_pOutputSize The number of bytes written to the output.
+ * @return int EXIT_SUCCESS if the block was decompressed successfully, else
+ * EXIT_FAILURE.
+ */
+static int decodeLz77Block(const uint8_t* i_pInput, size_t i_inputSize,
+                           uint8_t* o_pOutput, size_t i_outputCapacity,
+                           size_t* o_pBlockSize, size_t* o_pOutputSize) {
+  if (i_inputSize < HUFFMAN_LZ77_BLOCK_HEADER_SIZE) {
+    (void)fprintf(stderr, "ERROR: Truncated block header\n");
+    return EXIT_FAILURE;
+  }
+
+  const size_t outputSize = loadLittleEndian32(&i_pInput[0]);
+  const size_t payloadSize = loadLittleEndian32(&i_pInput[4]);
+  const bool isStored = (i_pInput[8] & HUFFMAN_BLOCK_FLAG_STORED) != 0;
+  const uint8_t* pBody = &i_pInput[HUFFMAN_LZ77_BLOCK_HEADER_SIZE];
+  const size_t bodyCapacity = i_inputSize - HUFFMAN_LZ77_BLOCK_HEADER_SIZE;
+
+  if (outputSize > i_outputCapacity) {
+    (void)fprintf(stderr, "ERROR: Output buffer is too small\n");
+    return EXIT_FAILURE;
+  }
+
+  if (isStored) {
+    if (payloadSize != outputSize || payloadSize > bodyCapacity) {
+      (void)fprintf(stderr, "ERROR: Malformed stored block\n");
+      return EXIT_FAILURE;
+    }
+    (void)memcpy(o_pOutput, pBody, payloadSize);
+    *o_pBlockSize = HUFFMAN_LZ77_BLOCK_HEADER_SIZE + payloadSize;
+    *o_pOutputSize = outputSize;
+    return EXIT_SUCCESS;
+  }
+
+  if (bodyCapacity < HUFFMAN_LZ77_TABLES_SIZE ||
+      payloadSize > bodyCapacity - HUFFMAN_LZ77_TABLES_SIZE) {
+    (void)fprintf(stderr, "ERROR: Truncated block\n");
+    return EXIT_FAILURE;
+  }
+
+  sLz77DecodeTable_t asTables[LZ77_TABLE_COUNT];
+  for (size_t table = 0; table < LZ77_TABLE_COUNT; table++) {
+    if (loadLz77DecodeTable(&pBody[4 + (table * HUFFMAN_CODE_LENGTHS_SIZE)],
+                            &asTables[table]) == EXIT_FAILURE) {
+      return EXIT_FAILURE;
+    }
+  }
+
+  const size_t sequenceCount = loadLittleEndian32(pBody);
+  sBitReader_t sReader;
+  initBitReader(&sReader, &pBody[HUFFMAN_LZ77_TABLES_SIZE], payloadSize);
+  size_t position = 0;
+
+  for (size_t i = 0; i < sequenceCount; i++) {
+    uint32_t literalCount = 0;
+    if (decodeValue(&asTables[LZ77_TABLE_LENGTHS], &sReader, 0,
+                    &literalCount) == EXIT_FAILURE) {
+      return EXIT_FAILURE;
+    }
+    if (literalCount > outputSize - position) {
+      (void)fprintf(stderr, "ERROR: Literals overrun block\n");
+      return EXIT_FAILURE;
+    }
+    if (decodeLiterals(&asTables[LZ77_TABLE_LITERALS], &sReader,
+                       &o_pOutput[position], literalCount) == EXIT_FAILURE) {
+      return EXIT_FAILURE;
+    }
+    position += literalCount;
+    if (i + 1 == sequenceCount) {
+      break;
+    }
+
+    uint32_t matchLength = 0;
+    uint32_t distance = 0;
+    if (decodeValue(&asTables[LZ77_TABLE_LENGTHS], &sReader,
+                    MATCH_LENGTH_SYMBOL_BASE, &matchLength) == EXIT_FAILURE ||
+        decodeValue(&asTables[LZ77_TABLE_DISTANCES], &sReader, 0,
+                    &distance) == EXIT_FAILURE) {
+      return EXIT_FAILURE;
+    }
+    const size_t copyLength = (size_t)matchLength + HUFFMAN_LZ77_MIN_MATCH;
+    if (distance == 0 || distance > position ||
+        copyLength > outputSize - position) {
+      (void)fprintf(stderr, "ERROR: Invalid match in block\n");
+      return EXIT_FAILURE;
+    }
+
+    uint8_t* pDest = &o_pOutput[position];
+    const uint8_t* pSource = pDest - distance;
+    if (distance >= 8 && outputSize - position >= copyLength + 8) {
+      for (size_t copied = 0; copied < copyLength; copied += 8) {
+        (void)memcpy(&pDest[copied], &pSource[copied], 8);
+      }
+    } else {
+      for (size_t copied = 0; copied < copyLength; copied++) {
+        pDest[copied] = pSource[copied];
+      }
+    }
+    position += copyLength;
+  }
+
+  if (position != outputSize || getBitReaderPosition(&sReader) > payloadSize) {
+    (void)fprintf(stderr, "ERROR: Block payload does not match its size\n");
+    return EXIT_FAILURE;
+  }
+
+  *o_pBlockSize =
+      HUFFMAN_LZ77_BLOCK_HEADER_SIZE + HUFFMAN_LZ77_TABLES_SIZE + payloadSize;
+  *o_pOutputSize = outputSize;
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Find the level and block size to compress with.
+ *
+ * @param[in] i_psOptions The compression options, or NULL for the defaults.
+ * @param[out] o_psOptions The options with the defaults filled in.
+ * @return int EXIT_SUCCESS if the options are valid, else EXIT_FAILURE.
+ */
+static int getValidLz77Options(const sHuffmanLz77Options_t* i_psOptions,
+                               sHuffmanLz77Options_t* o_psOptions) {
+  if (i_psOptions == NULL) {
+    initLz77Options(o_psOptions);
+    return EXIT_SUCCESS;
+  }
+  *o_psOptions = *i_psOptions;
+
+  if ((int)o_psOptions->eLevel < 0 ||
+      o_psOptions->eLevel >= HUFFMAN_LZ77_LEVEL_MAX) {
+    (void)fprintf(stderr, "ERROR: Invalid LZ77 level %d\n",
+                  (int)o_psOptions->eLevel);
+    return EXIT_FAILURE;
+  }
+  if (o_psOptions->blockSize == 0 ||
+      o_psOptions->blockSize > HUFFMAN_MAX_BLOCK_SIZE) {
+    (void)fprintf(stderr, "ERROR: Invalid block size %zu\n",
+                  o_psOptions->blockSize);
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Initialise LZ77 compression options to their defaults.
+ *
+ * @param[out] o_psOptions The options to initialise.
+ */
+void initLz77Options(sHuffmanLz77Options_t* o_psOptions) {
+  o_psOptions->eLevel = HUFFMAN_LZ77_LEVEL_FAST;
+  o_psOptions->blockSize = HUFFMAN_DEFAULT_BLOCK_SIZE;
+  o_psOptions->psAllocator = NULL;
+}
+
+/**
+ * @brief Find the maximum LZ77 container size for an input size.
+ *
+ * @param[in] i_inputSize The number of bytes to compress.
+ * @param[in] i_psOptions The compression options, or NULL for the defaults.
+ * @return size_t The output capacity that compressLz77Buffer never exceeds.
+ */
+size_t getLz77CompressBound(size_t i_inputSize,
+                            const sHuffmanLz77Options_t* i_psOptions) {
+  const size_t blockSize = (i_psOptions != NULL && i_psOptions->blockSize != 0)
+                               ? i_psOptions->blockSize
+                               : HUFFMAN_DEFAULT_BLOCK_SIZE;
+  const size_t blockCount = (i_inputSize + blockSize - 1) / blockSize;
+
+  /* Blocks that would not shrink are stored, so never exceed their input. */
+  return HUFFMAN_LZ77_HEADER_SIZE + i_inputSize +
+         (blockCount *
+          (HUFFMAN_LZ77_BLOCK_HEADER_SIZE + HUFFMAN_LZ77_TABLES_SIZE)) +
+         4;
+}
+
+/**
+ * @brief Compress a buffer into an LZ77 container.
+ *
+ * This function allocates the sequence buffer and hash tables once, with the
+ * allocator in the options, and reuses them for every block. The code
+ * lengths of each alphabet are built with
+ * createCodeLengthsFromFrequenciesWithAllocator, as for byte blocks. It
+ * returns EXIT_FAILURE if the options are invalid, the output is too small
+ * or memory cannot be allocated.
+ *
+ * @param[in] i_pInput The bytes to compress.
+ * @param[in] i_inputSize The number of bytes to compress.
+ * @param[out] o_pOutput The buffer to write the container to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @param[out] o_pOutputSize The number of bytes written to the output.
+ * @param[in] i_psOptions The compression options, or NULL for the defaults.
+ * @return int EXIT_SUCCESS if the input was compressed successfully, else
+ * EXIT_FAILURE.
+ */
+int compressLz77Buffer(const uint8_t* i_pInput, size_t i_inputSize,
+                       uint8_t* o_pOutput, size_t i_outputCapacity,
+                       size_t* o_pOutputSize,
+                       const sHuffmanLz77Options_t* i_psOptions) {
+  sHuffmanLz77Options_t sOptions;
+  if (getValidLz77Options(i_psOptions, &sOptions) == EXIT_FAILURE) {
+    return EXIT_FAILURE;
+  }
+  if (i_outputCapacity < HUFFMAN_LZ77_HEADER_SIZE) {
+    (void)fprintf(stderr, "ERROR: Output buffer is too small\n");
+    return EXIT_FAILURE;
+  }
+
+  /* Every sequence but the last has a match of at least the minimum. */
+  const size_t blockSize =
+      (i_inputSize < sOptions.blockSize) ? i_inputSize : sOptions.blockSize;
+  const size_t sequenceCapacity = (blockSize / HUFFMAN_LZ77_MIN_MATCH) + 1;
+  const bool isGreedy = (sOptions.eLevel == HUFFMAN_LZ77_LEVEL_GREEDY);
+  const size_t hashBits = isGreedy ? GREEDY_HASH_BITS : FAST_HASH_BITS;
+
+  sLz77Encoder_t sEncoder;
+  sEncoder.psAllocator = sOptions.psAllocator;
+  sEncoder.eLevel = sOptions.eLevel;
+  sEncoder.aSequences = (sLz77Sequence_t*)allocateHuffmanMemory(
+      sOptions.psAllocator, sequenceCapacity * sizeof(sLz77Sequence_t));
+  sEncoder.aHashTable = (uint32_t*)allocateHuffmanMemory(
+      sOptions.psAllocator, sizeof(uint32_t) << hashBits);
+  sEncoder.aChain =
+      isGreedy ? (uint32_t*)allocateHuffmanMemory(
+                     sOptions.psAllocator, (blockSize + 1) * sizeof(uint32_t))
+               : NULL;
+
+  int result = EXIT_SUCCESS;
+  if (sEncoder.aSequences == NULL || sEncoder.aHashTable == NULL ||
+      (isGreedy && sEncoder.aChain == NULL)) {
+    perror("ERROR: Failed to allocate memory for LZ77 encoder");
+    result = EXIT_FAILURE;
+  }
+
+  /* Write the container header. */
+  size_t position = HUFFMAN_LZ77_HEADER_SIZE;
+  if (result == EXIT_SUCCESS) {
+    (void)memcpy(o_pOutput, HEADER_MAGIC, sizeof(HEADER_MAGIC));
+    o_pOutput[4] = LZ77_FORMAT_VERSION;
+    o_pOutput[5] = (uint8_t)sOptions.eLevel;
+    o_pOutput[6] = 0;
+    o_pOutput[7] = 0;
+    storeLittleEndian32(&o_pOutput[8], (uint32_t)i_inputSize);
+    storeLittleEndian32(&o_pOutput[12],
+                        (uint32_t)((uint64_t)i_inputSize >> 32));
+  }
+
+  /* Write each block. */
+  for (size_t offset = 0; result == EXIT_SUCCESS && offset < i_inputSize;
+       offset += sOptions.blockSize) {
+    const size_t remaining = i_inputSize - offset;
+    const size_t inputSize =
+        (remaining < sOptions.blockSize) ? remaining : sOptions.blockSize;
+    size_t writtenSize = 0;
+    result = encodeLz77Block(&sEncoder, &i_pInput[offset], inputSize,
+                             &o_pOutput[position], i_outputCapacity - position,
+                             &writtenSize);
+    position += writtenSize;
+  }
+
+  /* Write the end marker. */
+  if (result == EXIT_SUCCESS) {
+    if (i_outputCapacity - position < 4) {
+      (void)fprintf(stderr, "ERROR: Output buffer is too small\n");
+      result = EXIT_FAILURE;
+    } else {
+      storeLittleEndian32(&o_pOutput[position], 0);
+      *o_pOutputSize = position + 4;
+    }
+  }
+
+  freeHuffmanMemory(sOptions.psAllocator, sEncoder.aSequences);
+  freeHuffmanMemory(sOptions.psAllocator, sEncoder.aHashTable);
+  freeHuffmanMemory(sOptions.psAllocator, sEncoder.aChain);
+  return result;
+}
+
+/**
+ * @brief Read the uncompressed size of an LZ77 container.
+ *
+ * @param[in] i_pInput The container.
+ * @param[in] i_inputSize The number of bytes in the container.
+ * @param[out] o_pDecompressedSize The total uncompressed size.
+ * @return int EXIT_SUCCESS if the size was read successfully, else
+ * EXIT_FAILURE.
+ */
+int getLz77DecompressedSize(const uint8_t* i_pInput, size_t i_inputSize,
+                            size_t* o_pDecompressedSize) {
+  if (i_inputSize < HUFFMAN_LZ77_HEADER_SIZE + 4 ||
+      memcmp(i_pInput, HEADER_MAGIC, sizeof(HEADER_MAGIC)) != 0) {
+    (void)fprintf(stderr, "ERROR: Not an LZ77 container\n");
+    return EXIT_FAILURE;
+  }
+  if (i_pInput[4] != LZ77_FORMAT_VERSION) {
+    (void)fprintf(stderr, "ERROR: Unsupported LZ77 format version %u\n",
+                  (unsigned)i_pInput[4]);
+    return EXIT_FAILURE;
+  }
+
+  const uint64_t decompressedSize =
+      loadLittleEndian32(&i_pInput[8]) |
+      ((uint64_t)loadLittleEndian32(&i_pInput[12]) << 32);
+  if (decompressedSize > SIZE_MAX) {
+    (void)fprintf(stderr, "ERROR: Container is too large\n");
+    return EXIT_FAILURE;
+  }
+
+  *o_pDecompressedSize = (size_t)decompressedSize;
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Decompress an LZ77 container into a buffer.
+ *
+ * This function decodes each block in turn, with the decoding tables of each
+ * block on the stack. It returns EXIT_FAILURE if the container is malformed
+ * or the output is too small.
+ *
+ * @param[in] i_pInput The container.
+ * @param[in] i_inputSize The number of bytes in the container.
+ * @param[out] o_pOutput The buffer to write the uncompressed bytes to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @param[out] o_pOutputSize The number of bytes written to the output.
+ * @return int EXIT_SUCCESS if the container was decompressed successfully,
+ * else EXIT_FAILURE.
+ */
+int decompressLz77Buffer(const uint8_t* i_pInput, size_t i_inputSize,
+                         uint8_t* o_pOutput, size_t i_outputCapacity,
+                         size_t* o_pOutputSize) {
+  size_t decompressedSize = 0;
+  if (getLz77DecompressedSize(i_pInput, i_inputSize, &decompressedSize) ==
+      EXIT_FAILURE) {
+    return EXIT_FAILURE;
+  }
+  if (decompressedSize > i_outputCapacity) {
+    (void)fprintf(stderr, "ERROR: Output buffer is too small\n");
+    return EXIT_FAILURE;
+  }
+
+  /* Blocks run from the header up to the end marker. */
+  const size_t blocksEnd = i_inputSize - 4;
+  size_t position = HUFFMAN_LZ77_HEADER_SIZE;
+  size_t outputPosition = 0;
+
+  while (position < blocksEnd) {
+    size_t blockSize = 0;
+    size_t outputSize = 0;
+    if (decodeLz77Block(&i_pInput[position], blocksEnd - position,
+                        &o_pOutput[outputPosition],
+                        decompressedSize - outputPosition, &blockSize,
+                        &outputSize) == EXIT_FAILURE) {
+      return EXIT_FAILURE;
+    }
+    if (outputSize == 0) {
+      (void)fprintf(stderr, "ERROR: Empty block\n");
+      return EXIT_FAILURE;
+    }
+    position += blockSize;
+    outputPosition += outputSize;
+  }
+
+  if (position != blocksEnd || loadLittleEndian32(&i_pInput[blocksEnd]) != 0 ||
+      outputPosition != decompressedSize) {
+    (void)fprintf(stderr, "ERROR: Missing end of blocks marker\n");
+    return EXIT_FAILURE;
+  }
+
+  *o_pOutputSize = outputPosition;
+  return EXIT_SUCCESS;
+}
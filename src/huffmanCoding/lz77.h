@@ -0,0 +1,147 @@
+/**
+ * @file lz77.h
+ * @brief Compress and decompress buffers with an LZ77 front end and Huffman
+ * coded tokens.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ * Each block is parsed into sequences of a run of literal bytes followed by a
+ * match, a length and a distance back into the block. Literals are coded
+ * with one canonical code table, literal run and match lengths with a second
+ * and distances with a third, each built from the token frequencies of the
+ * block with the letter-frequency and binary tree node lists. Lengths and
+ * distances are coded as a bucket symbol followed by raw extra bits. The
+ * container is laid out as follows, with every integer stored little-endian:
+ *
+ *   header   "HUFL", uint8 version, uint8 level, uint16 reserved,
+ *            uint64 total uncompressed size
+ *   block*   uint32 uncompressed size (non-zero), uint32 payload size,
+ *            uint8 block flags, [uint32 sequence count, 3 x 128 bytes of
+ *            4-bit code lengths], payload
+ *   end      uint32 0
+ *
+ * A coded block's payload holds, for each sequence, the literal run length,
+ * the literals and then, for every sequence but the last, the match length
+ * and distance. Blocks are stored as-is when coding would not make them
+ * smaller. Matches never cross blocks, so blocks decode independently.
+ */
+
+#ifndef LZ77_H
+#define LZ77_H
+
+/* Standard Library Includes */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Project Includes */
+
+#include "huffmanCoding/allocator.h"
+#include "huffmanCoding/huffmanTree.h"
+
+/* Constants */
+
+/**< The number of bytes in the LZ77 container header. */
+#define HUFFMAN_LZ77_HEADER_SIZE 16
+
+/**< The number of bytes in an LZ77 block header, excluding the tables. */
+#define HUFFMAN_LZ77_BLOCK_HEADER_SIZE 9
+
+/**< The number of bytes of sequence count and code lengths in a block. */
+#define HUFFMAN_LZ77_TABLES_SIZE (4 + (3 * (HUFFMAN_ALPHABET_SIZE / 2)))
+
+/**< The shortest match the match finders emit. */
+#define HUFFMAN_LZ77_MIN_MATCH 4
+
+/* Type Definitions */
+
+/**
+ * @brief The match finder levels, from fastest to strongest.
+ */
+typedef enum eHuffmanLz77Level {
+  HUFFMAN_LZ77_LEVEL_FAST,   /**< One candidate per hash, skipping ahead. */
+  HUFFMAN_LZ77_LEVEL_GREEDY, /**< The longest of several chained candidates. */
+  HUFFMAN_LZ77_LEVEL_MAX
+} eHuffmanLz77Level_t;
+
+/**
+ * @brief Options that control LZ77 compression.
+ */
+typedef struct sHuffmanLz77Options {
+  eHuffmanLz77Level_t eLevel;
+  size_t blockSize;
+  const sHuffmanAllocator_t* psAllocator; /**< NULL for the default. */
+} sHuffmanLz77Options_t;
+
+/* Function Prototypes */
+
+/**
+ * @brief Initialise LZ77 compression options to their defaults.
+ *
+ * @param[out] o_psOptions The options to initialise.
+ */
+extern void initLz77Options(sHuffmanLz77Options_t* o_psOptions);
+
+/**
+ * @brief Find the maximum LZ77 container size for an input size.
+ *
+ * @param[in] i_inputSize The number of bytes to compress.
+ * @param[in] i_psOptions The compression options, or NULL for the defaults.
+ * @return size_t The output capacity that compressLz77Buffer never exceeds.
+ */
+extern size_t getLz77CompressBound(size_t i_inputSize,
+                                   const sHuffmanLz77Options_t* i_psOptions);
+
+/**
+ * @brief Compress a buffer into an LZ77 container.
+ *
+ * It returns EXIT_FAILURE if the options are invalid, the output is too
+ * small or memory cannot be allocated.
+ *
+ * @param[in] i_pInput The bytes to compress.
+ * @param[in] i_inputSize The number of bytes to compress.
+ * @param[out] o_pOutput The buffer to write the container to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @param[out] o_pOutputSize The number of bytes written to the output.
+ * @param[in] i_psOptions The compression options, or NULL for the defaults.
+ * @return int EXIT_SUCCESS if the input was compressed successfully, else
+ * EXIT_FAILURE.
+ */
+extern int compressLz77Buffer(const uint8_t* i_pInput, size_t i_inputSize,
+                              uint8_t* o_pOutput, size_t i_outputCapacity,
+                              size_t* o_pOutputSize,
+                              const sHuffmanLz77Options_t* i_psOptions);
+
+/**
+ * @brief Read the uncompressed size of an LZ77 container.
+ *
+ * @param[in] i_pInput The container.
+ * @param[in] i_inputSize The number of bytes in the container.
+ * @param[out] o_pDecompressedSize The total uncompressed size.
+ * @return int EXIT_SUCCESS if the size was read successfully, else
+ * EXIT_FAILURE.
+ */
+extern int getLz77DecompressedSize(const uint8_t* i_pInput,
+                                   size_t i_inputSize,
+                                   size_t* o_pDecompressedSize);
+
+/**
+ * @brief Decompress an LZ77 container into a buffer.
+ *
+ * It returns EXIT_FAILURE if the container is malformed or the output is
+ * too small. Decompressing never allocates.
+ *
+ * @param[in] i_pInput The container.
+ * @param[in] i_inputSize The number of bytes in the container.
+ * @param[out] o_pOutput The buffer to write the uncompressed bytes to.
+ * @param[in] i_outputCapacity The number of bytes available in the output.
+ * @param[out] o_pOutputSize The number of bytes written to the output.
+ * @return int EXIT_SUCCESS if the container was decompressed successfully,
+ * else EXIT_FAILURE.
+ */
+extern int decompressLz77Buffer(const uint8_t* i_pInput, size_t i_inputSize,
+                                uint8_t* o_pOutput, size_t i_outputCapacity,
+                                size_t* o_pOutputSize);
+
+#endif  // LZ77_H
@@ -0,0 +1,573 @@
+/**
+ * @file parallelDecoder.c
+ * @brief Decode one large payload with several threads.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+/* Standard Library Includes */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Project Includes */
+
+#include "huffmanCoding/allocator.h"
+#include "huffmanCoding/bitStream.h"
+#include "huffmanCoding/decodeKernel.h"
+#include "huffmanCoding/huffmanTree.h"
+#include "huffmanCoding/parallelDecoder.h"
+
+/* Type Definitions */
+
+struct sParallelDecode;
+
+/**
+ * @brief The state of one range of a parallel decode.
+ */
+typedef struct sDecodeRange {
+  struct sParallelDecode* psDecode;
+  size_t index;
+  uint64_t startBit; /**< The guessed first bit, exact for the first range. */
+  uint64_t endBit;   /**< The next range's first bit, or the payload's end. */
+  sBitReader_t sReader;
+  uint64_t* pBoundaries; /**< The bit offsets of the first codes decoded. */
+  size_t boundaryCount;
+  bool isWindowPublished;
+  uint8_t* pOutput;
+  size_t outputCapacity;
+  size_t symbolCount;
+  size_t firstSymbol; /**< The first symbol on a true code boundary. */
+  bool isValid;
+  pthread_t thread;
+  bool isThreadStarted;
+} sDecodeRange_t;
+
+/**
+ * @brief The state shared by the ranges of a parallel decode.
+ */
+typedef struct sParallelDecode {
+  const decodeTableEntry_t* pDecodeTable;
+  const sHuffmanNibbleTree_t* psTree; /**< NULL if no codes are long. */
+  size_t rangeCount;
+  pthread_mutex_t mutex;
+  pthread_cond_t published;
+  sDecodeRange_t asRanges[HUFFMAN_MAX_DECODE_THREADS];
+} sParallelDecode_t;
+
+/* Function Prototypes */
+
+/**
+ * @brief Find the number of bits a reader has consumed.
+ *
+ * @param[in] i_psReader The bit reader.
+ * @return uint64_t The offset of the reader's next bit.
+ */
+static uint64_t getBitOffset(const sBitReader_t* i_psReader);
+
+/**
+ * @brief Decode a number of symbols.
+ *
+ * @param[in] i_psDecode The decoding tables.
+ * @param[inout] io_psReader The bit reader positioned at the first code.
+ * @param[out] o_pOutput The buffer to write the decoded bytes to.
+ * @param[in] i_outputSize The number of bytes to decode.
+ * @return int EXIT_SUCCESS if the symbols were decoded successfully, else
+ * EXIT_FAILURE.
+ */
+static int decodeSymbols(const sParallelDecode_t* i_psDecode,
+                         sBitReader_t* io_psReader, uint8_t* o_pOutput,
+                         size_t i_outputSize);
+
+/**
+ * @brief Decode a range's codes until one ends at or after a bit.
+ *
+ * @param[inout] io_psRange The range.
+ * @param[in] i_endBit The bit to decode up to.
+ * @return bool Whether the codes were valid and fit in the range's buffer.
+ */
+static bool decodeToBit(sDecodeRange_t* io_psRange, uint64_t i_endBit);
+
+/**
+ * @brief Record the boundaries of a range's first codes for the range
+ * before it.
+ *
+ * @param[inout] io_psRange The range, which must not be the first.
+ */
+static void recordBoundaries(sDecodeRange_t* io_psRange);
+
+/**
+ * @brief Decode the rest of a range and synchronise with the next range.
+ *
+ * @param[inout] io_psRange The range.
+ */
+static void decodeRange(sDecodeRange_t* io_psRange);
+
+/**
+ * @brief Record a range's boundaries and then decode it on its own thread.
+ *
+ * @param[inout] io_pRange The range, an sDecodeRange_t.
+ * @return void* NULL.
+ */
+static void* decodeRangeThread(void* io_pRange);
+
+/**
+ * @brief Decode a payload on the calling thread.
+ *
+ * @param[in] i_psDecode The decoding tables.
+ * @param[in] i_pPayload The coded payload.
+ * @param[in] i_payloadSize The number of bytes in the payload.
+ * @param[out] o_pOutput The buffer to write the decoded bytes to.
+ * @param[in] i_outputSize The number of bytes to decode.
+ * @return int EXIT_SUCCESS if the payload was decoded successfully, else
+ * EXIT_FAILURE.
+ */
+static int decodeSerial(const sParallelDecode_t* i_psDecode,
+                        const uint8_t* i_pPayload, size_t i_payloadSize,
+                        uint8_t* o_pOutput, size_t i_outputSize);
+
+/**
+ * @brief Join the symbols of every range into the output.
+ *
+ * @param[in] i_psDecode The decoded ranges.
+ * @param[in] i_payloadSize The number of bytes in the payload.
+ * @param[out] o_pOutput The buffer holding the first range's symbols.
+ * @param[in] i_outputSize The number of bytes to decode.
+ * @return bool Whether every range synchronised and the symbols are the
+ * payload's.
+ */
+static bool stitchRanges(const sParallelDecode_t* i_psDecode,
+                         size_t i_payloadSize, uint8_t* o_pOutput,
+                         size_t i_outputSize);
+
+/* Function Definitions */
+
+/**
+ * @brief Find the number of bits a reader has consumed.
+ *
+ * @param[in] i_psReader The bit reader.
+ * @return uint64_t The offset of the reader's next bit.
+ */
+static uint64_t getBitOffset(const sBitReader_t* i_psReader) {
+  return ((uint64_t)i_psReader->position * 8) - i_psReader->bitCount;
+}
+
+/**
+ * @brief Decode a number of symbols.
+ *
+ * Codes up to the decode table width are looked up with decodeTableSymbols,
+ * and longer codes are decoded with the nibble tree.
+ *
+ * @param[in] i_psDecode The decoding tables.
+ * @param[inout] io_psReader The bit reader positioned at the first code.
+ * @param[out] o_pOutput The buffer to write the decoded bytes to.
+ * @param[in] i_outputSize The number of bytes to decode.
+ * @return int EXIT_SUCCESS if the symbols were decoded successfully, else
+ * EXIT_FAILURE.
+ */
+static int decodeSymbols(const sParallelDecode_t* i_psDecode,
+                         sBitReader_t* io_psReader, uint8_t* o_pOutput,
+                         size_t i_outputSize) {
+  size_t i = 0;
+  while (true) {
+    i += decodeTableSymbols(i_psDecode->pDecodeTable, io_psReader,
+                            &o_pOutput[i], i_outputSize - i);
+    if (i == i_outputSize) {
+      break;
+    }
+
+    /* The kernel stopped at a code longer than the table width. */
+    if (io_psReader->bitCount <= HUFFMAN_MAX_CODE_LENGTH) {
+      refillBitReader(io_psReader);
+    }
+    if (decodeNibbleTreeCode(i_psDecode->psTree, io_psReader, &o_pOutput[i]) ==
+        EXIT_FAILURE) {
+      return EXIT_FAILURE;
+    }
+    i++;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Decode a range's codes until one ends at or after a bit.
+ *
+ * No code is longer than HUFFMAN_MAX_CODE_LENGTH bits, so the symbols are
+ * decoded in runs that cannot pass the bit, and then one at a time.
+ *
+ * @param[inout] io_psRange The range.
+ * @param[in] i_endBit The bit to decode up to.
+ * @return bool Whether the codes were valid and fit in the range's buffer.
+ */
+static bool decodeToBit(sDecodeRange_t* io_psRange, uint64_t i_endBit) {
+  while (true) {
+    const uint64_t bit = getBitOffset(&io_psRange->sReader);
+    if (bit >= i_endBit) {
+      return true;
+    }
+
+    size_t count = (size_t)((i_endBit - bit) / HUFFMAN_MAX_CODE_LENGTH);
+    if (count == 0) {
+      count = 1;
+    }
+    const size_t remaining =
+        io_psRange->outputCapacity - io_psRange->symbolCount;
+    if (remaining == 0) {
+      return false;
+    }
+    if (count > remaining) {
+      count = remaining;
+    }
+
+    if (decodeSymbols(io_psRange->psDecode, &io_psRange->sReader,
+                      &io_psRange->pOutput[io_psRange->symbolCount],
+                      count) == EXIT_FAILURE) {
+      return false;
+    }
+    io_psRange->symbolCount += count;
+  }
+}
+
+/**
+ * @brief Record the boundaries of a range's first codes for the range
+ * before it.
+ *
+ * Up to HUFFMAN_SYNC_WINDOW_SIZE codes starting before the end of the range
+ * are decoded one at a time from the guessed first bit, and the boundaries
+ * are published even if a code is invalid, so the range before never waits
+ * forever.
+ *
+ * @param[inout] io_psRange The range, which must not be the first.
+ */
+static void recordBoundaries(sDecodeRange_t* io_psRange) {
+  sParallelDecode_t* psDecode = io_psRange->psDecode;
+
+  while (io_psRange->boundaryCount < HUFFMAN_SYNC_WINDOW_SIZE &&
+         io_psRange->symbolCount < io_psRange->outputCapacity) {
+    const uint64_t bit = getBitOffset(&io_psRange->sReader);
+    if (bit >= io_psRange->endBit) {
+      break;
+    }
+    if (decodeSymbols(psDecode, &io_psRange->sReader,
+                      &io_psRange->pOutput[io_psRange->symbolCount],
+                      1) == EXIT_FAILURE) {
+      io_psRange->isValid = false;
+      break;
+    }
+    io_psRange->pBoundaries[io_psRange->boundaryCount++] = bit;
+    io_psRange->symbolCount++;
+  }
+
+  (void)pthread_mutex_lock(&psDecode->mutex);
+  io_psRange->isWindowPublished = true;
+  (void)pthread_cond_broadcast(&psDecode->published);
+  (void)pthread_mutex_unlock(&psDecode->mutex);
+}
+
+/**
+ * @brief Decode the rest of a range and synchronise with the next range.
+ *
+ * The range is decoded up to the next range's guessed first bit, and then
+ * one code at a time until a code ends on one of the boundaries the next
+ * range recorded. From there on both ranges decode the same codes, so the
+ * next range's symbols before that boundary are discarded.
+ *
+ * @param[inout] io_psRange The range.
+ */
+static void decodeRange(sDecodeRange_t* io_psRange) {
+  sParallelDecode_t* psDecode = io_psRange->psDecode;
+
+  if (io_psRange->isValid) {
+    io_psRange->isValid = decodeToBit(io_psRange, io_psRange->endBit);
+  }
+  if (!io_psRange->isValid || io_psRange->index + 1 == psDecode->rangeCount) {
+    return;
+  }
+
+  sDecodeRange_t* psNext = &psDecode->asRanges[io_psRange->index + 1];
+  (void)pthread_mutex_lock(&psDecode->mutex);
+  while (!psNext->isWindowPublished) {
+    (void)pthread_cond_wait(&psDecode->published, &psDecode->mutex);
+  }
+  (void)pthread_mutex_unlock(&psDecode->mutex);
+
+  size_t j = 0;
+  while (true) {
+    const uint64_t bit = getBitOffset(&io_psRange->sReader);
+    while (j < psNext->boundaryCount && psNext->pBoundaries[j] < bit) {
+      j++;
+    }
+    if (j == psNext->boundaryCount) {
+      io_psRange->isValid = false;
+      return;
+    }
+    if (psNext->pBoundaries[j] == bit) {
+      psNext->firstSymbol = j;
+      return;
+    }
+
+    if (io_psRange->symbolCount == io_psRange->outputCapacity ||
+        decodeSymbols(psDecode, &io_psRange->sReader,
+                      &io_psRange->pOutput[io_psRange->symbolCount],
+                      1) == EXIT_FAILURE) {
+      io_psRange->isValid = false;
+      return;
+    }
+    io_psRange->symbolCount++;
+  }
+}
+
+/**
+ * @brief Record a range's boundaries and then decode it on its own thread.
+ *
+ * @param[inout] io_pRange The range, an sDecodeRange_t.
+ * @return void* NULL.
+ */
+static void* decodeRangeThread(void* io_pRange) {
+  sDecodeRange_t* psRange = (sDecodeRange_t*)io_pRange;
+
+  recordBoundaries(psRange);
+  decodeRange(psRange);
+
+  return NULL;
+}
+
+/**
+ * @brief Decode a payload on the calling thread.
+ *
+ * @param[in] i_psDecode The decoding tables.
+ * @param[in] i_pPayload The coded payload.
+ * @param[in] i_payloadSize The number of bytes in the payload.
+ * @param[out] o_pOutput The buffer to write the decoded bytes to.
+ * @param[in] i_outputSize The number of bytes to decode.
+ * @return int EXIT_SUCCESS if the payload was decoded successfully, else
+ * EXIT_FAILURE.
+ */
+static int decodeSerial(const sParallelDecode_t* i_psDecode,
+                        const uint8_t* i_pPayload, size_t i_payloadSize,
+                        uint8_t* o_pOutput, size_t i_outputSize) {
+  sBitReader_t sReader;
+  initBitReader(&sReader, i_pPayload, i_payloadSize);
+
+  if (decodeSymbols(i_psDecode, &sReader, o_pOutput, i_outputSize) ==
+      EXIT_FAILURE) {
+    (void)fprintf(stderr, "ERROR: Invalid code in block\n");
+    return EXIT_FAILURE;
+  }
+
+  if (getBitReaderPosition(&sReader) > i_payloadSize) {
+    (void)fprintf(stderr, "ERROR: Block payload is truncated\n");
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Join the symbols of every range into the output.
+ *
+ * Each range after the first contributes its symbols from the boundary the
+ * range before it synchronised on. Every symbol the ranges decoded starts
+ * before the end of the payload, so the last symbol of the output only needs
+ * checking against the end when no symbol follows it.
+ *
+ * @param[in] i_psDecode The decoded ranges.
+ * @param[in] i_payloadSize The number of bytes in the payload.
+ * @param[out] o_pOutput The buffer holding the first range's symbols.
+ * @param[in] i_outputSize The number of bytes to decode.
+ * @return bool Whether every range synchronised and the symbols are the
+ * payload's.
+ */
+static bool stitchRanges(const sParallelDecode_t* i_psDecode,
+                         size_t i_payloadSize, uint8_t* o_pOutput,
+                         size_t i_outputSize) {
+  for (size_t r = 0; r < i_psDecode->rangeCount; r++) {
+    if (!i_psDecode->asRanges[r].isValid) {
+      return false;
+    }
+  }
+
+  size_t position = i_psDecode->asRanges[0].symbolCount;
+  bool isOutputFull = false;
+  for (size_t r = 1; r < i_psDecode->rangeCount && !isOutputFull; r++) {
+    const sDecodeRange_t* psRange = &i_psDecode->asRanges[r];
+    size_t count = psRange->symbolCount - psRange->firstSymbol;
+    if (count > i_outputSize - position) {
+      count = i_outputSize - position;
+      isOutputFull = true;
+    }
+    (void)memcpy(&o_pOutput[position],
+                 &psRange->pOutput[psRange->firstSymbol], count);
+    position += count;
+  }
+
+  if (position < i_outputSize) {
+    return false;
+  }
+  const sDecodeRange_t* psLast =
+      &i_psDecode->asRanges[i_psDecode->rangeCount - 1];
+  return isOutputFull ||
+         (getBitOffset(&psLast->sReader) <= (uint64_t)i_payloadSize * 8);
+}
+
+/**
+ * @brief Decode a payload with several threads.
+ *
+ * This function uses fewer threads than requested when there would be fewer
+ * than HUFFMAN_PARALLEL_MIN_DECODE_SIZE payload bytes for each, and decodes
+ * on the calling thread alone when there is only one. It also decodes on the
+ * calling thread if the threads' buffers cannot be allocated or a thread
+ * fails to synchronise. A range whose thread cannot be started is decoded on
+ * the calling thread.
+ *
+ * The first range is decoded straight into the output and the others into
+ * buffers sized for the most symbols their bits and the next range's
+ * boundaries can hold, so invalid payloads never write past them.
+ *
+ * @param[in] i_aDecodeTable The decode table.
+ * @param[in] i_psTree The nibble tree, for codes longer than the decode table
+ * width, or NULL if there are none.
+ * @param[in] i_pPayload The coded payload.
+ * @param[in] i_payloadSize The number of bytes in the payload.
+ * @param[out] o_pOutput The buffer to write the decoded bytes to.
+ * @param[in] i_outputSize The number of bytes to decode.
+ * @param[in] i_threadCount The number of threads to use, including the
+ * calling thread.
+ * @param[in] i_psAllocator The allocator for the threads' buffers, or NULL
+ * for the default.
+ * @return int EXIT_SUCCESS if the payload was decoded successfully, else
+ * EXIT_FAILURE.
+ */
+int decodeTableSymbolsParallel(
+    const decodeTableEntry_t i_aDecodeTable[HUFFMAN_DECODE_TABLE_SIZE],
+    const sHuffmanNibbleTree_t* i_psTree, const uint8_t* i_pPayload,
+    size_t i_payloadSize, uint8_t* o_pOutput, size_t i_outputSize,
+    size_t i_threadCount, const sHuffmanAllocator_t* i_psAllocator) {
+  sParallelDecode_t sDecode;
+  sDecode.pDecodeTable = i_aDecodeTable;
+  sDecode.psTree = i_psTree;
+
+  size_t rangeCount = i_payloadSize / HUFFMAN_PARALLEL_MIN_DECODE_SIZE;
+  if (rangeCount > i_threadCount) {
+    rangeCount = i_threadCount;
+  }
+  if (rangeCount > HUFFMAN_MAX_DECODE_THREADS) {
+    rangeCount = HUFFMAN_MAX_DECODE_THREADS;
+  }
+
+  /* The first canonical code is all zeros and has the shortest length. */
+  const size_t minLength = i_aDecodeTable[0] & 0x0FU;
+  if (rangeCount <= 1 || minLength == 0) {
+    return decodeSerial(&sDecode, i_pPayload, i_payloadSize, o_pOutput,
+                        i_outputSize);
+  }
+  sDecode.rangeCount = rangeCount;
+
+  /* A range holds the codes up to its end and those synchronising past it,
+     which end within the next range's boundaries. */
+  const uint64_t payloadBits = (uint64_t)i_payloadSize * 8;
+  size_t memorySize = 0;
+  for (size_t r = 0; r < rangeCount; r++) {
+    sDecodeRange_t* psRange = &sDecode.asRanges[r];
+    psRange->psDecode = &sDecode;
+    psRange->index = r;
+    psRange->startBit = (payloadBits * r) / rangeCount;
+    psRange->endBit = (payloadBits * (r + 1)) / rangeCount;
+    psRange->outputCapacity = i_outputSize;
+    if (r > 0) {
+      const uint64_t capacity =
+          ((psRange->endBit - psRange->startBit +
+            ((uint64_t)HUFFMAN_SYNC_WINDOW_SIZE * HUFFMAN_MAX_CODE_LENGTH)) /
+           minLength) +
+          1;
+      if (capacity < i_outputSize) {
+        psRange->outputCapacity = (size_t)capacity;
+      }
+      memorySize += (HUFFMAN_SYNC_WINDOW_SIZE * sizeof(uint64_t)) +
+                    psRange->outputCapacity;
+    }
+  }
+
+  uint8_t* pMemory = (uint8_t*)allocateHuffmanMemory(i_psAllocator,
+                                                     memorySize);
+  if (pMemory == NULL) {
+    return decodeSerial(&sDecode, i_pPayload, i_payloadSize, o_pOutput,
+                        i_outputSize);
+  }
+
+  /* The boundaries come first, as they need the stricter alignment. */
+  uint8_t* pNext = pMemory;
+  for (size_t r = 0; r < rangeCount; r++) {
+    sDecodeRange_t* psRange = &sDecode.asRanges[r];
+    psRange->pBoundaries = NULL;
+    psRange->pOutput = o_pOutput;
+    if (r > 0) {
+      psRange->pBoundaries = (uint64_t*)(void*)pNext;
+      pNext += HUFFMAN_SYNC_WINDOW_SIZE * sizeof(uint64_t);
+    }
+  }
+  for (size_t r = 1; r < rangeCount; r++) {
+    sDecode.asRanges[r].pOutput = pNext;
+    pNext += sDecode.asRanges[r].outputCapacity;
+  }
+
+  for (size_t r = 0; r < rangeCount; r++) {
+    sDecodeRange_t* psRange = &sDecode.asRanges[r];
+    initBitReader(&psRange->sReader, i_pPayload, i_payloadSize);
+    seekBitReader(&psRange->sReader, psRange->startBit);
+    psRange->boundaryCount = 0;
+    psRange->isWindowPublished = false;
+    psRange->symbolCount = 0;
+    psRange->firstSymbol = 0;
+    psRange->isValid = true;
+    psRange->isThreadStarted = false;
+  }
+  (void)pthread_mutex_init(&sDecode.mutex, NULL);
+  (void)pthread_cond_init(&sDecode.published, NULL);
+
+  /* Ranges only wait on the boundaries of the range after them, so the
+     calling thread records the boundaries of any range whose thread did not
+     start before decoding the first range and then those ranges, in order. */
+  for (size_t r = 1; r < rangeCount; r++) {
+    sDecodeRange_t* psRange = &sDecode.asRanges[r];
+    psRange->isThreadStarted = (pthread_create(&psRange->thread, NULL,
+                                               decodeRangeThread,
+                                               psRange) == 0);
+  }
+  for (size_t r = 1; r < rangeCount; r++) {
+    if (!sDecode.asRanges[r].isThreadStarted) {
+      recordBoundaries(&sDecode.asRanges[r]);
+    }
+  }
+  for (size_t r = 0; r < rangeCount; r++) {
+    if (!sDecode.asRanges[r].isThreadStarted) {
+      decodeRange(&sDecode.asRanges[r]);
+    }
+  }
+  for (size_t r = 1; r < rangeCount; r++) {
+    if (sDecode.asRanges[r].isThreadStarted) {
+      (void)pthread_join(sDecode.asRanges[r].thread, NULL);
+    }
+  }
+
+  const bool isDecoded =
+      stitchRanges(&sDecode, i_payloadSize, o_pOutput, i_outputSize);
+
+  (void)pthread_cond_destroy(&sDecode.published);
+  (void)pthread_mutex_destroy(&sDecode.mutex);
+  freeHuffmanMemory(i_psAllocator, pMemory);
+
+  if (!isDecoded) {
+    return decodeSerial(&sDecode, i_pPayload, i_payloadSize, o_pOutput,
+                        i_outputSize);
+  }
+  return EXIT_SUCCESS;
+}
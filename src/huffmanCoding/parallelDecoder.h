@@ -0,0 +1,77 @@
+/**
+ * @file parallelDecoder.h
+ * @brief Decode one large payload with several threads.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ * A payload without sync points has no known symbol boundaries after its
+ * first bit, so the payload is split into one range of bits per thread and
+ * each thread after the first guesses that its range starts on a boundary.
+ * Huffman codes resynchronise quickly, so a thread that started mid-code
+ * soon decodes the same boundaries as the thread before it. Each thread
+ * records the bit offsets of its first codes, and the thread before it
+ * decodes past the end of its own range until it reaches one of them. The
+ * symbols before that boundary are discarded and the rest are kept. If a
+ * thread does not reach one of the recorded boundaries, the payload is
+ * decoded again on the calling thread. The container format is unchanged.
+ */
+
+#ifndef PARALLEL_DECODER_H
+#define PARALLEL_DECODER_H
+
+/* Standard Library Includes */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Project Includes */
+
+#include "huffmanCoding/allocator.h"
+#include "huffmanCoding/huffmanTree.h"
+
+/* Constants */
+
+/**< The fewest payload bytes each thread of the parallel decoder decodes. */
+#define HUFFMAN_PARALLEL_MIN_DECODE_SIZE ((size_t)64 * 1024)
+
+/**< The most threads the parallel decoder runs. */
+#define HUFFMAN_MAX_DECODE_THREADS 64
+
+/**< The number of code boundaries each thread records for the thread before
+ * it to synchronise with. */
+#define HUFFMAN_SYNC_WINDOW_SIZE 4096
+
+/* Function Prototypes */
+
+/**
+ * @brief Decode a payload with several threads.
+ *
+ * This function uses fewer threads than requested when there would be fewer
+ * than HUFFMAN_PARALLEL_MIN_DECODE_SIZE payload bytes for each, and decodes
+ * on the calling thread alone when there is only one. It also decodes on the
+ * calling thread if the threads' buffers cannot be allocated or a thread
+ * fails to synchronise. A range whose thread cannot be started is decoded on
+ * the calling thread.
+ *
+ * @param[in] i_aDecodeTable The decode table.
+ * @param[in] i_psTree The nibble tree, for codes longer than the decode table
+ * width, or NULL if there are none.
+ * @param[in] i_pPayload The coded payload.
+ * @param[in] i_payloadSize The number of bytes in the payload.
+ * @param[out] o_pOutput The buffer to write the decoded bytes to.
+ * @param[in] i_outputSize The number of bytes to decode.
+ * @param[in] i_threadCount The number of threads to use, including the
+ * calling thread.
+ * @param[in] i_psAllocator The allocator for the threads' buffers, or NULL
+ * for the default.
+ * @return int EXIT_SUCCESS if the payload was decoded successfully, else
+ * EXIT_FAILURE.
+ */
+extern int decodeTableSymbolsParallel(
+    const decodeTableEntry_t i_aDecodeTable[HUFFMAN_DECODE_TABLE_SIZE],
+    const sHuffmanNibbleTree_t* i_psTree, const uint8_t* i_pPayload,
+    size_t i_payloadSize, uint8_t* o_pOutput, size_t i_outputSize,
+    size_t i_threadCount, const sHuffmanAllocator_t* i_psAllocator);
+
+#endif  // PARALLEL_DECODER_H
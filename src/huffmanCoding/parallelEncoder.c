@@ -0,0 +1,277 @@
+/**
+ * @file parallelEncoder.c
+ * @brief Code one large buffer with several threads.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+/* Standard Library Includes */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/* Project Includes */
+
+#include "huffmanCoding/bitStream.h"
+#include "huffmanCoding/encodeKernel.h"
+#include "huffmanCoding/huffmanTree.h"
+#include "huffmanCoding/parallelEncoder.h"
+#include "huffmanCoding/task4.h"
+
+/* Constants */
+
+/**< The number of bytes at the start of each range that are written to a
+ * private buffer. This is more than the previous range's kernel stores past
+ * its last byte, so the threads never write the same bytes. */
+#define BOUNDARY_SIZE 32
+
+/* Type Definitions */
+
+struct sParallelEncode;
+
+/**
+ * @brief The state of one range of a parallel encode.
+ */
+typedef struct sEncodeRange {
+  struct sParallelEncode* psEncode;
+  size_t index;
+  const uint8_t* pInput;
+  size_t inputSize;
+  uint64_t startBit;
+  uint8_t aBoundary[BOUNDARY_SIZE + 8]; /**< The range's first bytes. */
+  size_t boundarySize;
+  pthread_t thread;
+  bool isThreadStarted;
+} sEncodeRange_t;
+
+/**
+ * @brief The state shared by the ranges of a parallel encode.
+ */
+typedef struct sParallelEncode {
+  const sHuffmanCodeTable_t* psCodeTable;
+  uint8_t* pOutput;
+  pthread_mutex_t mutex;
+  pthread_cond_t published;
+  size_t publishedCount;    /**< The number of ranges with a known start. */
+  uint64_t publishedEndBit; /**< The end of the last published range. */
+  sEncodeRange_t asRanges[HUFFMAN_MAX_ENCODE_THREADS];
+} sParallelEncode_t;
+
+/* Function Prototypes */
+
+/**
+ * @brief Sum the code lengths of a range.
+ *
+ * @param[in] i_aCodeLengths The code length of each symbol.
+ * @param[in] i_pInput The bytes of the range.
+ * @param[in] i_inputSize The number of bytes in the range.
+ * @return uint64_t The number of bits the range codes to.
+ */
+static uint64_t sumCodeLengths(
+    const uint8_t i_aCodeLengths[HUFFMAN_ALPHABET_SIZE],
+    const uint8_t* i_pInput, size_t i_inputSize);
+
+/**
+ * @brief Find the first bit of a range from the ranges before it.
+ *
+ * @param[inout] io_psRange The range, whose start is set.
+ * @param[in] i_bitCount The number of bits the range codes to.
+ */
+static void publishRange(sEncodeRange_t* io_psRange, uint64_t i_bitCount);
+
+/**
+ * @brief Code one range of a parallel encode.
+ *
+ * @param[inout] io_pRange The range, an sEncodeRange_t.
+ * @return void* NULL.
+ */
+static void* encodeRange(void* io_pRange);
+
+/* Function Definitions */
+
+/**
+ * @brief Sum the code lengths of a range.
+ *
+ * The bytes are counted first, as the histogram's independent counters are
+ * faster than a chain of length lookups.
+ *
+ * @param[in] i_aCodeLengths The code length of each symbol.
+ * @param[in] i_pInput The bytes of the range.
+ * @param[in] i_inputSize The number of bytes in the range.
+ * @return uint64_t The number of bits the range codes to.
+ */
+static uint64_t sumCodeLengths(
+    const uint8_t i_aCodeLengths[HUFFMAN_ALPHABET_SIZE],
+    const uint8_t* i_pInput, size_t i_inputSize) {
+  size_t aFrequencies[HUFFMAN_ALPHABET_SIZE] = {0};
+  countByteFrequencies(i_pInput, i_inputSize, aFrequencies);
+
+  uint64_t bitCount = 0;
+  for (size_t symbol = 0; symbol < HUFFMAN_ALPHABET_SIZE; symbol++) {
+    bitCount += (uint64_t)aFrequencies[symbol] * i_aCodeLengths[symbol];
+  }
+  return bitCount;
+}
+
+/**
+ * @brief Find the first bit of a range from the ranges before it.
+ *
+ * Each range waits for the range before it to publish its end, which is the
+ * range's start, and then publishes its own end. Only the sums are ordered,
+ * so the threads count their ranges in parallel.
+ *
+ * @param[inout] io_psRange The range, whose start is set.
+ * @param[in] i_bitCount The number of bits the range codes to.
+ */
+static void publishRange(sEncodeRange_t* io_psRange, uint64_t i_bitCount) {
+  sParallelEncode_t* psEncode = io_psRange->psEncode;
+
+  (void)pthread_mutex_lock(&psEncode->mutex);
+  while (psEncode->publishedCount < io_psRange->index) {
+    (void)pthread_cond_wait(&psEncode->published, &psEncode->mutex);
+  }
+  io_psRange->startBit = psEncode->publishedEndBit;
+  psEncode->publishedEndBit += i_bitCount;
+  psEncode->publishedCount++;
+  (void)pthread_cond_broadcast(&psEncode->published);
+  (void)pthread_mutex_unlock(&psEncode->mutex);
+}
+
+/**
+ * @brief Code one range of a parallel encode.
+ *
+ * The codes are written from the range's first bit. Whole words go straight
+ * to the output once BOUNDARY_SIZE bytes have been written to the range's
+ * private buffer, which holds the byte shared with the range before.
+ *
+ * @param[inout] io_pRange The range, an sEncodeRange_t.
+ * @return void* NULL.
+ */
+static void* encodeRange(void* io_pRange) {
+  sEncodeRange_t* psRange = (sEncodeRange_t*)io_pRange;
+  const sHuffmanCodeTable_t* psCodeTable = psRange->psEncode->psCodeTable;
+
+  publishRange(psRange, sumCodeLengths(psCodeTable->aCodeLengths,
+                                       psRange->pInput, psRange->inputSize));
+
+  sBitWriter_t sWriter;
+  initBitWriter(&sWriter, psRange->aBoundary);
+  sWriter.bitCount = (size_t)(psRange->startBit & 7);
+
+  size_t i = 0;
+  for (; i < psRange->inputSize && sWriter.position < BOUNDARY_SIZE; i++) {
+    const uint8_t symbol = psRange->pInput[i];
+    writeBits(&sWriter, psCodeTable->aCodes[symbol],
+              psCodeTable->aCodeLengths[symbol]);
+  }
+  if (i == psRange->inputSize) {
+    psRange->boundarySize = flushBitWriter(&sWriter);
+    return NULL;
+  }
+
+  /* Continue in the output after the bytes in the private buffer. */
+  psRange->boundarySize = sWriter.position;
+  sWriter.pOutput = &psRange->psEncode->pOutput[psRange->startBit >> 3];
+  encodeTableSymbols(psCodeTable, &psRange->pInput[i],
+                     psRange->inputSize - i, &sWriter);
+  (void)flushBitWriter(&sWriter);
+
+  return NULL;
+}
+
+/**
+ * @brief Code a buffer with several threads.
+ *
+ * This function uses fewer threads than requested when there would be fewer
+ * than HUFFMAN_PARALLEL_MIN_RANGE_SIZE bytes for each, and codes on the
+ * calling thread alone when there is only one. A range whose thread cannot
+ * be started is coded on the calling thread. Once every range is coded, the
+ * private buffers are merged into the output in order, joining the bits of
+ * each shared byte.
+ *
+ * @param[in] i_psCodeTable The canonical code table.
+ * @param[in] i_pInput The bytes to code.
+ * @param[in] i_inputSize The number of bytes to code.
+ * @param[in] i_threadCount The number of threads to use, including the
+ * calling thread.
+ * @param[out] o_pOutput The buffer to write the codes to, with room for the
+ * coded size.
+ * @return size_t The number of bytes written, with the last byte padded with
+ * zeros.
+ */
+size_t encodeTableSymbolsParallel(const sHuffmanCodeTable_t* i_psCodeTable,
+                                  const uint8_t* i_pInput, size_t i_inputSize,
+                                  size_t i_threadCount, uint8_t* o_pOutput) {
+  size_t rangeCount = i_inputSize / HUFFMAN_PARALLEL_MIN_RANGE_SIZE;
+  if (rangeCount > i_threadCount) {
+    rangeCount = i_threadCount;
+  }
+  if (rangeCount > HUFFMAN_MAX_ENCODE_THREADS) {
+    rangeCount = HUFFMAN_MAX_ENCODE_THREADS;
+  }
+
+  if (rangeCount <= 1) {
+    sBitWriter_t sWriter;
+    initBitWriter(&sWriter, o_pOutput);
+    encodeTableSymbols(i_psCodeTable, i_pInput, i_inputSize, &sWriter);
+    return flushBitWriter(&sWriter);
+  }
+
+  sParallelEncode_t sEncode;
+  sEncode.psCodeTable = i_psCodeTable;
+  sEncode.pOutput = o_pOutput;
+  (void)pthread_mutex_init(&sEncode.mutex, NULL);
+  (void)pthread_cond_init(&sEncode.published, NULL);
+  sEncode.publishedCount = 0;
+  sEncode.publishedEndBit = 0;
+
+  for (size_t r = 0; r < rangeCount; r++) {
+    sEncodeRange_t* psRange = &sEncode.asRanges[r];
+    const size_t start = (i_inputSize * r) / rangeCount;
+    psRange->psEncode = &sEncode;
+    psRange->index = r;
+    psRange->pInput = &i_pInput[start];
+    psRange->inputSize = ((i_inputSize * (r + 1)) / rangeCount) - start;
+    psRange->isThreadStarted = false;
+  }
+
+  /* Ranges only wait on earlier ranges, so the calling thread codes the
+     first range and then any whose thread did not start, in order. */
+  for (size_t r = 1; r < rangeCount; r++) {
+    sEncodeRange_t* psRange = &sEncode.asRanges[r];
+    psRange->isThreadStarted =
+        (pthread_create(&psRange->thread, NULL, encodeRange, psRange) == 0);
+  }
+  for (size_t r = 0; r < rangeCount; r++) {
+    if (!sEncode.asRanges[r].isThreadStarted) {
+      (void)encodeRange(&sEncode.asRanges[r]);
+    }
+  }
+  for (size_t r = 1; r < rangeCount; r++) {
+    if (sEncode.asRanges[r].isThreadStarted) {
+      (void)pthread_join(sEncode.asRanges[r].thread, NULL);
+    }
+  }
+
+  /* Merge the private buffers, joining each shared byte. */
+  for (size_t r = 0; r < rangeCount; r++) {
+    const sEncodeRange_t* psRange = &sEncode.asRanges[r];
+    if (psRange->boundarySize == 0) {
+      continue;
+    }
+    uint8_t* pDest = &o_pOutput[psRange->startBit >> 3];
+    const uint8_t sharedBits =
+        ((psRange->startBit & 7) != 0) ? pDest[0] : (uint8_t)0;
+    (void)memcpy(pDest, psRange->aBoundary, psRange->boundarySize);
+    pDest[0] |= sharedBits;
+  }
+
+  (void)pthread_cond_destroy(&sEncode.published);
+  (void)pthread_mutex_destroy(&sEncode.mutex);
+  return (size_t)((sEncode.publishedEndBit + 7) / 8);
+}
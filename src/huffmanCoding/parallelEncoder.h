@@ -0,0 +1,62 @@
+/**
+ * @file parallelEncoder.h
+ * @brief Code one large buffer with several threads.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ * The input is split into one range per thread. Each thread sums the code
+ * lengths of its range, and the ranges publish their sums in order, so each
+ * range's first output bit is the prefix sum of the ranges before it. Each
+ * thread then codes its range straight into the output. Neighbouring ranges
+ * share the byte at their boundary, so each thread writes the start of its
+ * range into a private buffer, which is merged into the output once every
+ * thread has finished. The output is identical to that of the serial encode
+ * kernels.
+ */
+
+#ifndef PARALLEL_ENCODER_H
+#define PARALLEL_ENCODER_H
+
+/* Standard Library Includes */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Project Includes */
+
+#include "huffmanCoding/huffmanTree.h"
+
+/* Constants */
+
+/**< The fewest bytes each thread of the parallel encoder codes. */
+#define HUFFMAN_PARALLEL_MIN_RANGE_SIZE ((size_t)64 * 1024)
+
+/**< The most threads the parallel encoder runs. */
+#define HUFFMAN_MAX_ENCODE_THREADS 64
+
+/* Function Prototypes */
+
+/**
+ * @brief Code a buffer with several threads.
+ *
+ * This function uses fewer threads than requested when there would be fewer
+ * than HUFFMAN_PARALLEL_MIN_RANGE_SIZE bytes for each, and codes on the
+ * calling thread alone when there is only one. A range whose thread cannot
+ * be started is coded on the calling thread.
+ *
+ * @param[in] i_psCodeTable The canonical code table.
+ * @param[in] i_pInput The bytes to code.
+ * @param[in] i_inputSize The number of bytes to code.
+ * @param[in] i_threadCount The number of threads to use, including the
+ * calling thread.
+ * @param[out] o_pOutput The buffer to write the codes to, with room for the
+ * coded size.
+ * @return size_t The number of bytes written, with the last byte padded with
+ * zeros.
+ */
+extern size_t encodeTableSymbolsParallel(
+    const sHuffmanCodeTable_t* i_psCodeTable, const uint8_t* i_pInput,
+    size_t i_inputSize, size_t i_threadCount, uint8_t* o_pOutput);
+
+#endif  // PARALLEL_ENCODER_H
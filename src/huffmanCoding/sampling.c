@@ -0,0 +1,204 @@
+/**
+ * @file sampling.c
+ * @brief Estimate the byte frequencies of large blocks from a sample.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+/* Standard Library Includes */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Project Includes */
+
+#include "huffmanCoding/huffmanTree.h"
+#include "huffmanCoding/sampling.h"
+#include "huffmanCoding/task4.h"
+
+/* Constants */
+
+/**< The first state of the sequence choosing the run in each window. */
+#define SAMPLE_SEED 0x9E3779B9U
+
+/* Function Prototypes */
+
+/**
+ * @brief Advance a xorshift32 sequence.
+ *
+ * @param[inout] io_pState The state, which must not be 0.
+ * @return uint32_t The next value in the sequence.
+ */
+static uint32_t nextSampleRandom(uint32_t* io_pState);
+
+/**
+ * @brief Find the number of bits needed to code some frequencies with some
+ * code lengths.
+ *
+ * @param[in] i_aFrequencies The frequency of each symbol.
+ * @param[in] i_aCodeLengths The code length of each symbol.
+ * @return uint64_t The number of coded bits.
+ */
+static uint64_t getCodedBitCount(
+    const size_t i_aFrequencies[HUFFMAN_ALPHABET_SIZE],
+    const uint8_t i_aCodeLengths[HUFFMAN_ALPHABET_SIZE]);
+
+/* Function Definitions */
+
+/**
+ * @brief Estimate the frequency of every byte value in a buffer from a
+ * sample.
+ *
+ * An interval of 0 or 1 counts every byte exactly, without the floor.
+ *
+ * @param[in] i_pData The buffer to sample.
+ * @param[in] i_size The number of bytes in the buffer.
+ * @param[in] i_sampleInterval The number of runs in each sampled window.
+ * @param[out] o_aFrequencies The estimated frequency of each byte value.
+ * @return size_t The number of distinct byte values in the sample.
+ */
+size_t sampleByteFrequencies(const uint8_t* i_pData, size_t i_size,
+                             size_t i_sampleInterval,
+                             size_t o_aFrequencies[HUFFMAN_ALPHABET_SIZE]) {
+  size_t distinct = 0;
+  if (i_sampleInterval <= 1) {
+    countByteFrequencies(i_pData, i_size, o_aFrequencies);
+    for (size_t symbol = 0; symbol < HUFFMAN_ALPHABET_SIZE; symbol++) {
+      distinct += (o_aFrequencies[symbol] > 0) ? 1 : 0;
+    }
+    return distinct;
+  }
+
+  (void)memset(o_aFrequencies, 0, HUFFMAN_ALPHABET_SIZE * sizeof(size_t));
+  const size_t windowSize = i_sampleInterval * HUFFMAN_SAMPLE_RUN_SIZE;
+  uint32_t state = SAMPLE_SEED;
+  size_t sampledSize = 0;
+  for (size_t window = 0; window < i_size; window += windowSize) {
+    const size_t remaining = i_size - window;
+    const size_t windowRuns =
+        (remaining < windowSize)
+            ? (remaining + HUFFMAN_SAMPLE_RUN_SIZE - 1) /
+                  HUFFMAN_SAMPLE_RUN_SIZE
+            : i_sampleInterval;
+    const size_t start = window + ((nextSampleRandom(&state) % windowRuns) *
+                                   HUFFMAN_SAMPLE_RUN_SIZE);
+    const size_t end = (i_size - start < HUFFMAN_SAMPLE_RUN_SIZE)
+                           ? i_size
+                           : start + HUFFMAN_SAMPLE_RUN_SIZE;
+    for (size_t i = start; i < end; i++) {
+      o_aFrequencies[i_pData[i]]++;
+    }
+    sampledSize += end - start;
+  }
+
+  /* Scale the counts up to the block, and give every byte a code. */
+  for (size_t symbol = 0; symbol < HUFFMAN_ALPHABET_SIZE; symbol++) {
+    if (o_aFrequencies[symbol] == 0) {
+      o_aFrequencies[symbol] = 1;
+      continue;
+    }
+    distinct++;
+    o_aFrequencies[symbol] =
+        (size_t)(((uint64_t)o_aFrequencies[symbol] * i_size) / sampledSize);
+  }
+
+  return distinct;
+}
+
+/**
+ * @brief Find whether a block's frequencies are sampled when compressing.
+ *
+ * Blocks under HUFFMAN_SAMPLE_MIN_BLOCK_SIZE bytes are still in the cache
+ * when they are coded, so they are always counted exactly.
+ *
+ * @param[in] i_size The number of bytes in the block.
+ * @param[in] i_sampleInterval The number of runs in each sampled window.
+ * @return bool Whether the block's frequencies are sampled.
+ */
+bool isBlockSampled(size_t i_size, size_t i_sampleInterval) {
+  return i_sampleInterval > 1 && i_size >= HUFFMAN_SAMPLE_MIN_BLOCK_SIZE;
+}
+
+/**
+ * @brief Add the coded size of a block with exactly counted and with sampled
+ * frequencies to a running total.
+ *
+ * The block is counted exactly as well as sampled, so this is for reporting
+ * the ratio loss of an interval before compressing with it. Blocks that would
+ * not be sampled, or whose sample has a tiny alphabet, are counted exactly
+ * when compressing, so add the same size to both totals.
+ *
+ * @param[in] i_pData The block.
+ * @param[in] i_size The number of bytes in the block.
+ * @param[in] i_sampleInterval The number of runs in each sampled window.
+ * @param[inout] io_psLoss The running total to add to.
+ * @return int EXIT_SUCCESS if the sizes were found, else EXIT_FAILURE if the
+ * code lengths could not be built.
+ */
+int addSamplingLoss(const uint8_t* i_pData, size_t i_size,
+                    size_t i_sampleInterval,
+                    sHuffmanSamplingLoss_t* io_psLoss) {
+  size_t aFrequencies[HUFFMAN_ALPHABET_SIZE];
+  size_t aSampledFrequencies[HUFFMAN_ALPHABET_SIZE];
+  uint8_t aCodeLengths[HUFFMAN_ALPHABET_SIZE];
+  countByteFrequencies(i_pData, i_size, aFrequencies);
+  if (createCodeLengthsFromFrequencies(aFrequencies, aCodeLengths) ==
+      EXIT_FAILURE) {
+    return EXIT_FAILURE;
+  }
+  const uint64_t exactBits = getCodedBitCount(aFrequencies, aCodeLengths);
+  io_psLoss->exactBits += exactBits;
+
+  if (!isBlockSampled(i_size, i_sampleInterval) ||
+      sampleByteFrequencies(i_pData, i_size, i_sampleInterval,
+                            aSampledFrequencies) <=
+          HUFFMAN_TINY_ALPHABET_SIZE) {
+    io_psLoss->sampledBits += exactBits;
+    return EXIT_SUCCESS;
+  }
+  if (createCodeLengthsFromFrequencies(aSampledFrequencies, aCodeLengths) ==
+      EXIT_FAILURE) {
+    return EXIT_FAILURE;
+  }
+  io_psLoss->sampledBits += getCodedBitCount(aFrequencies, aCodeLengths);
+
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Advance a xorshift32 sequence.
+ *
+ * @param[inout] io_pState The state, which must not be 0.
+ * @return uint32_t The next value in the sequence.
+ */
+static uint32_t nextSampleRandom(uint32_t* io_pState) {
+  uint32_t state = *io_pState;
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  *io_pState = state;
+  return state;
+}
+
+/**
+ * @brief Find the number of bits needed to code some frequencies with some
+ * code lengths.
+ *
+ * @param[in] i_aFrequencies The frequency of each symbol.
+ * @param[in] i_aCodeLengths The code length of each symbol.
+ * @return uint64_t The number of coded bits.
+ */
+static uint64_t getCodedBitCount(
+    const size_t i_aFrequencies[HUFFMAN_ALPHABET_SIZE],
+    const uint8_t i_aCodeLengths[HUFFMAN_ALPHABET_SIZE]) {
+  uint64_t bits = 0;
+  for (size_t symbol = 0; symbol < HUFFMAN_ALPHABET_SIZE; symbol++) {
+    bits += (uint64_t)i_aFrequencies[symbol] * i_aCodeLengths[symbol];
+  }
+  return bits;
+}
@@ -0,0 +1,104 @@
+/**
+ * @file sampling.h
+ * @brief Estimate the byte frequencies of large blocks from a sample.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ * Counting every byte of a multi-megabyte block reads it from memory once
+ * before it is coded, only to choose a code table that a sample would get
+ * almost right. A sample takes one run of HUFFMAN_SAMPLE_RUN_SIZE bytes from
+ * each window of i_sampleInterval runs. The run within each window is chosen
+ * by a fixed pseudo-random sequence, so data that repeats with the window's
+ * period is not always sampled at the same phase, and the same block always
+ * gives the same estimate. Whole runs are read so that the skipped cache
+ * lines are not fetched at all.
+ *
+ * The sampled counts are scaled up to the block size, and every byte value
+ * is given a frequency of at least 1. A byte the sample missed therefore
+ * still has a code, of up to HUFFMAN_MAX_CODE_LENGTH bits.
+ */
+
+#ifndef SAMPLING_H
+#define SAMPLING_H
+
+/* Standard Library Includes */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Project Includes */
+
+#include "huffmanCoding/huffmanTree.h"
+
+/* Constants */
+
+/**< The number of consecutive bytes counted from each sampled window. */
+#define HUFFMAN_SAMPLE_RUN_SIZE 256
+
+/**< The fewest bytes in a block whose frequencies are sampled. */
+#define HUFFMAN_SAMPLE_MIN_BLOCK_SIZE ((size_t)1 << 20)
+
+/* Type Definitions */
+
+/**
+ * @brief The coded size of data with exactly counted and with sampled
+ * frequencies.
+ */
+typedef struct sHuffmanSamplingLoss {
+  uint64_t exactBits;   /**< Payload bits with exactly counted frequencies. */
+  uint64_t sampledBits; /**< Payload bits with sampled frequencies. */
+} sHuffmanSamplingLoss_t;
+
+/* Function Prototypes */
+
+/**
+ * @brief Estimate the frequency of every byte value in a buffer from a
+ * sample.
+ *
+ * An interval of 0 or 1 counts every byte exactly, without the floor.
+ *
+ * @param[in] i_pData The buffer to sample.
+ * @param[in] i_size The number of bytes in the buffer.
+ * @param[in] i_sampleInterval The number of runs in each sampled window.
+ * @param[out] o_aFrequencies The estimated frequency of each byte value.
+ * @return size_t The number of distinct byte values in the sample.
+ */
+extern size_t sampleByteFrequencies(
+    const uint8_t* i_pData, size_t i_size, size_t i_sampleInterval,
+    size_t o_aFrequencies[HUFFMAN_ALPHABET_SIZE]);
+
+/**
+ * @brief Find whether a block's frequencies are sampled when compressing.
+ *
+ * Blocks under HUFFMAN_SAMPLE_MIN_BLOCK_SIZE bytes are still in the cache
+ * when they are coded, so they are always counted exactly.
+ *
+ * @param[in] i_size The number of bytes in the block.
+ * @param[in] i_sampleInterval The number of runs in each sampled window.
+ * @return bool Whether the block's frequencies are sampled.
+ */
+extern bool isBlockSampled(size_t i_size, size_t i_sampleInterval);
+
+/**
+ * @brief Add the coded size of a block with exactly counted and with sampled
+ * frequencies to a running total.
+ *
+ * The block is counted exactly as well as sampled, so this is for reporting
+ * the ratio loss of an interval before compressing with it. Blocks that would
+ * not be sampled, or whose sample has a tiny alphabet, are counted exactly
+ * when compressing, so add the same size to both totals.
+ *
+ * @param[in] i_pData The block.
+ * @param[in] i_size The number of bytes in the block.
+ * @param[in] i_sampleInterval The number of runs in each sampled window.
+ * @param[inout] io_psLoss The running total to add to.
+ * @return int EXIT_SUCCESS if the sizes were found, else EXIT_FAILURE if the
+ * code lengths could not be built.
+ */
+extern int addSamplingLoss(const uint8_t* i_pData, size_t i_size,
+                           size_t i_sampleInterval,
+                           sHuffmanSamplingLoss_t* io_psLoss);
+
+#endif  // SAMPLING_H
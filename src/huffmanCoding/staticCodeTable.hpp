@@ -0,0 +1,409 @@
+/**
+ * @file staticCodeTable.hpp
+ * @brief Huffman code tables built at compile time from known frequencies.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ * When the symbol distribution of a class of inputs is known in advance, its
+ * code lengths, canonical codes and decode tables can be computed by the
+ * compiler and stored as static data:
+ *
+ *   static constexpr huffman::StaticCodeTable TABLE =
+ *       huffman::makeStaticCodeTable(FREQUENCIES);
+ *
+ * The tables match those the runtime tree builder produces for the same
+ * frequencies. encodeWithStaticTable and decodeWithStaticTable code raw bit
+ * streams with such a table, with no table in the output and no work at
+ * startup.
+ */
+
+#ifndef STATIC_CODE_TABLE_HPP
+#define STATIC_CODE_TABLE_HPP
+
+/* Standard Library Includes */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/* Project Includes */
+
+#include "huffmanCoding/huffman.hpp"
+
+extern "C" {
+#include "huffmanCoding/bitStream.h"
+#include "huffmanCoding/huffmanTree.h"
+}
+
+namespace huffman {
+
+/* Constants */
+
+/**< The number of code bits resolved by a single decode table lookup. */
+constexpr std::size_t STATIC_DECODE_TABLE_BITS = 11;
+
+/**< The number of entries in a static decode table. */
+constexpr std::size_t STATIC_DECODE_TABLE_SIZE = std::size_t{1}
+                                                 << STATIC_DECODE_TABLE_BITS;
+
+/* Type Definitions */
+
+/**
+ * @brief Code lengths, canonical codes and decode tables for one
+ * distribution.
+ *
+ * Decode table entries hold the symbol in the upper bits and the code length
+ * in the lowest 4 bits. An entry of 0 marks a code longer than
+ * STATIC_DECODE_TABLE_BITS, which is decoded with the canonical tables.
+ */
+struct StaticCodeTable {
+  std::array<std::uint8_t, HUFFMAN_ALPHABET_SIZE> codeLengths = {};
+  std::array<std::uint16_t, HUFFMAN_ALPHABET_SIZE> codes = {}; /**< LSB first */
+  std::array<std::uint16_t, STATIC_DECODE_TABLE_SIZE> decodeTable = {};
+  std::array<std::uint16_t, HUFFMAN_MAX_CODE_LENGTH + 1> firstCodes = {};
+  std::array<std::uint16_t, HUFFMAN_MAX_CODE_LENGTH + 1> counts = {};
+  std::array<std::uint16_t, HUFFMAN_MAX_CODE_LENGTH + 1> offsets = {};
+  std::array<std::uint8_t, HUFFMAN_ALPHABET_SIZE> symbols = {};
+  std::uint8_t maxLength = 0;
+};
+
+namespace detail {
+
+/**
+ * @brief Node arrays for building a Huffman tree at compile time, laid out
+ * as in sHuffmanTreeWorkspace_t.
+ */
+struct StaticTreeWorkspace {
+  std::array<std::size_t, HUFFMAN_MAX_TREE_NODES> weights = {};
+  std::array<std::uint16_t, HUFFMAN_MAX_TREE_NODES> parents = {};
+  std::array<std::uint16_t, HUFFMAN_MAX_TREE_NODES> depths = {};
+  std::array<std::uint16_t, HUFFMAN_ALPHABET_SIZE> heap = {};
+  std::array<std::uint8_t, HUFFMAN_ALPHABET_SIZE> leafSymbols = {};
+};
+
+/**
+ * @brief Check whether a node is merged before another node, ordering by
+ * weight and then by node number as the runtime builder does.
+ *
+ * @param i_sWorkspace The tree workspace.
+ * @param i_first The first node.
+ * @param i_second The second node.
+ * @return true if the first node is lighter.
+ */
+constexpr bool isLighterStaticNode(const StaticTreeWorkspace& i_sWorkspace,
+                                   std::uint16_t i_first,
+                                   std::uint16_t i_second) {
+  const std::size_t firstWeight = i_sWorkspace.weights[i_first];
+  const std::size_t secondWeight = i_sWorkspace.weights[i_second];
+  return (firstWeight < secondWeight) ||
+         (firstWeight == secondWeight && i_first < i_second);
+}
+
+/**
+ * @brief Move a heap entry down until neither of its children is lighter.
+ *
+ * @param io_sWorkspace The tree workspace.
+ * @param i_heapSize The number of nodes in the heap.
+ * @param i_index The index of the heap entry to move.
+ */
+constexpr void siftDownStaticHeap(StaticTreeWorkspace& io_sWorkspace,
+                                  std::size_t i_heapSize,
+                                  std::size_t i_index) {
+  const std::uint16_t node = io_sWorkspace.heap[i_index];
+
+  for (;;) {
+    std::size_t child = (2 * i_index) + 1;
+    if (child >= i_heapSize) {
+      break;
+    }
+    if (child + 1 < i_heapSize &&
+        isLighterStaticNode(io_sWorkspace, io_sWorkspace.heap[child + 1],
+                            io_sWorkspace.heap[child])) {
+      child++;
+    }
+    if (!isLighterStaticNode(io_sWorkspace, io_sWorkspace.heap[child],
+                             node)) {
+      break;
+    }
+    io_sWorkspace.heap[i_index] = io_sWorkspace.heap[child];
+    i_index = child;
+  }
+
+  io_sWorkspace.heap[i_index] = node;
+}
+
+/**
+ * @brief Build a Huffman tree and read its code lengths, without limiting
+ * them.
+ *
+ * @param i_aFrequencies The frequency of each symbol.
+ * @param o_aCodeLengths The code length of each symbol.
+ * @return std::size_t The maximum code length in the tree.
+ */
+constexpr std::size_t buildStaticCodeLengths(
+    const std::array<std::size_t, HUFFMAN_ALPHABET_SIZE>& i_aFrequencies,
+    std::array<std::uint8_t, HUFFMAN_ALPHABET_SIZE>& o_aCodeLengths) {
+  StaticTreeWorkspace sWorkspace;
+  o_aCodeLengths = {};
+
+  /* The leaves are the first nodes, in ascending symbol order. */
+  std::size_t leafCount = 0;
+  for (std::size_t symbol = 0; symbol < HUFFMAN_ALPHABET_SIZE; symbol++) {
+    if (i_aFrequencies[symbol] != 0) {
+      sWorkspace.weights[leafCount] = i_aFrequencies[symbol];
+      sWorkspace.leafSymbols[leafCount] = (std::uint8_t)symbol;
+      sWorkspace.heap[leafCount] = (std::uint16_t)leafCount;
+      leafCount++;
+    }
+  }
+
+  if (leafCount == 0) {
+    return 0;
+  }
+  if (leafCount == 1) {
+    /* A single symbol still needs one bit per occurrence. */
+    o_aCodeLengths[sWorkspace.leafSymbols[0]] = 1;
+    return 1;
+  }
+
+  std::size_t heapSize = leafCount;
+  for (std::size_t i = heapSize / 2; i-- > 0;) {
+    siftDownStaticHeap(sWorkspace, heapSize, i);
+  }
+
+  /* Merge the two lightest nodes until only the root remains. */
+  std::size_t nodeCount = leafCount;
+  while (heapSize > 1) {
+    const std::uint16_t left = sWorkspace.heap[0];
+    sWorkspace.heap[0] = sWorkspace.heap[--heapSize];
+    siftDownStaticHeap(sWorkspace, heapSize, 0);
+    const std::uint16_t right = sWorkspace.heap[0];
+
+    const auto parent = (std::uint16_t)nodeCount++;
+    sWorkspace.weights[parent] =
+        sWorkspace.weights[left] + sWorkspace.weights[right];
+    sWorkspace.parents[left] = parent;
+    sWorkspace.parents[right] = parent;
+    sWorkspace.heap[0] = parent;
+    siftDownStaticHeap(sWorkspace, heapSize, 0);
+  }
+
+  /* Parents are numbered after their children, so walk down from the root. */
+  const std::size_t root = nodeCount - 1;
+  sWorkspace.depths[root] = 0;
+  for (std::size_t node = root; node-- > 0;) {
+    sWorkspace.depths[node] =
+        (std::uint16_t)(sWorkspace.depths[sWorkspace.parents[node]] + 1);
+  }
+
+  std::size_t maxLength = 0;
+  for (std::size_t leaf = 0; leaf < leafCount; leaf++) {
+    const std::size_t depth = sWorkspace.depths[leaf];
+    o_aCodeLengths[sWorkspace.leafSymbols[leaf]] =
+        (std::uint8_t)((depth > UINT8_MAX) ? UINT8_MAX : depth);
+    maxLength = (depth > maxLength) ? depth : maxLength;
+  }
+
+  return maxLength;
+}
+
+/**
+ * @brief Reverse the order of the lowest bits of a code.
+ *
+ * @param i_code The code to reverse.
+ * @param i_length The number of bits in the code.
+ * @return std::uint16_t The bit-reversed code.
+ */
+constexpr std::uint16_t reverseStaticCode(std::uint16_t i_code,
+                                          std::size_t i_length) {
+  std::uint16_t reversed = 0;
+
+  for (std::size_t i = 0; i < i_length; i++) {
+    reversed = (std::uint16_t)((reversed << 1) | ((i_code >> i) & 1U));
+  }
+
+  return reversed;
+}
+
+}  // namespace detail
+
+/* Function Definitions */
+
+/**
+ * @brief Create length-limited code lengths from symbol frequencies, as
+ * createCodeLengthsFromFrequencies does at runtime.
+ *
+ * @param i_aFrequencies The frequency of each symbol.
+ * @return std::array<std::uint8_t, HUFFMAN_ALPHABET_SIZE> The code length of
+ * each symbol.
+ */
+constexpr std::array<std::uint8_t, HUFFMAN_ALPHABET_SIZE>
+createStaticCodeLengths(
+    const std::array<std::size_t, HUFFMAN_ALPHABET_SIZE>& i_aFrequencies) {
+  std::array<std::size_t, HUFFMAN_ALPHABET_SIZE> aFrequencies = i_aFrequencies;
+  std::array<std::uint8_t, HUFFMAN_ALPHABET_SIZE> aCodeLengths = {};
+
+  /* Flatten the distribution until the tree is shallow enough. */
+  while (detail::buildStaticCodeLengths(aFrequencies, aCodeLengths) >
+         HUFFMAN_MAX_CODE_LENGTH) {
+    for (std::size_t symbol = 0; symbol < HUFFMAN_ALPHABET_SIZE; symbol++) {
+      aFrequencies[symbol] = (aFrequencies[symbol] + 1) / 2;
+    }
+  }
+
+  return aCodeLengths;
+}
+
+/**
+ * @brief Create the code lengths, canonical codes and decode tables for a
+ * distribution.
+ *
+ * Symbols with a frequency of 0 get no code, so give every symbol that may
+ * occur in the inputs a non-zero frequency.
+ *
+ * @param i_aFrequencies The frequency of each symbol.
+ * @return StaticCodeTable The code table.
+ */
+constexpr StaticCodeTable makeStaticCodeTable(
+    const std::array<std::size_t, HUFFMAN_ALPHABET_SIZE>& i_aFrequencies) {
+  StaticCodeTable sTable;
+  sTable.codeLengths = createStaticCodeLengths(i_aFrequencies);
+
+  for (std::size_t symbol = 0; symbol < HUFFMAN_ALPHABET_SIZE; symbol++) {
+    const std::uint8_t length = sTable.codeLengths[symbol];
+    if (length != 0) {
+      sTable.counts[length]++;
+      sTable.maxLength =
+          (length > sTable.maxLength) ? length : sTable.maxLength;
+    }
+  }
+
+  /* Find the first canonical code of each length, as the runtime does. */
+  std::array<std::uint16_t, HUFFMAN_MAX_CODE_LENGTH + 1> aNextCodes = {};
+  std::array<std::uint16_t, HUFFMAN_MAX_CODE_LENGTH + 1> aNextOffsets = {};
+  std::uint16_t code = 0;
+  std::uint16_t offset = 0;
+  for (std::size_t length = 1; length <= HUFFMAN_MAX_CODE_LENGTH; length++) {
+    code = (std::uint16_t)((code + sTable.counts[length - 1]) << 1);
+    sTable.firstCodes[length] = code;
+    sTable.offsets[length] = offset;
+    aNextCodes[length] = code;
+    aNextOffsets[length] = offset;
+    offset = (std::uint16_t)(offset + sTable.counts[length]);
+  }
+
+  /* Assign consecutive codes to the symbols of each length. */
+  for (std::size_t symbol = 0; symbol < HUFFMAN_ALPHABET_SIZE; symbol++) {
+    const std::size_t length = sTable.codeLengths[symbol];
+    if (length == 0) {
+      continue;
+    }
+    sTable.codes[symbol] =
+        detail::reverseStaticCode(aNextCodes[length]++, length);
+    sTable.symbols[aNextOffsets[length]++] = (std::uint8_t)symbol;
+
+    if (length <= STATIC_DECODE_TABLE_BITS) {
+      const auto entry = (std::uint16_t)((symbol << 4) | length);
+      for (std::size_t i = sTable.codes[symbol]; i < STATIC_DECODE_TABLE_SIZE;
+           i += std::size_t{1} << length) {
+        sTable.decodeTable[i] = entry;
+      }
+    }
+  }
+
+  return sTable;
+}
+
+/**
+ * @brief Encode bytes as a raw bit stream with a static code table.
+ *
+ * @param i_sTable The code table.
+ * @param i_input The bytes to encode.
+ * @param o_output The buffer to write the bit stream to.
+ * @return Result The number of bytes written, else Error::InvalidArgument if
+ * a byte has no code or Error::OutputTooSmall.
+ */
+inline Result encodeWithStaticTable(const StaticCodeTable& i_sTable,
+                                    ByteSpan i_input,
+                                    MutableByteSpan o_output) noexcept {
+  /* The coded size is known exactly before writing anything. */
+  std::uint64_t bitCount = 0;
+  for (std::size_t i = 0; i < i_input.size(); i++) {
+    const std::uint8_t length = i_sTable.codeLengths[i_input.data()[i]];
+    if (length == 0) {
+      return {Error::InvalidArgument, 0};
+    }
+    bitCount += length;
+  }
+  const auto outputSize = (std::size_t)((bitCount + 7) / 8);
+  if (outputSize > o_output.size()) {
+    return {Error::OutputTooSmall, 0};
+  }
+
+  sBitWriter_t sWriter;
+  initBitWriter(&sWriter, o_output.data());
+  for (std::size_t i = 0; i < i_input.size(); i++) {
+    const std::uint8_t symbol = i_input.data()[i];
+    writeBits(&sWriter, i_sTable.codes[symbol], i_sTable.codeLengths[symbol]);
+  }
+
+  return {Error::None, flushBitWriter(&sWriter)};
+}
+
+/**
+ * @brief Decode a raw bit stream written by encodeWithStaticTable.
+ *
+ * This function decodes exactly as many symbols as fit in the output.
+ *
+ * @param i_sTable The code table the stream was encoded with.
+ * @param i_input The bit stream.
+ * @param o_output The buffer to write the decoded bytes to.
+ * @return Result The number of bytes written, else Error::CorruptInput.
+ */
+inline Result decodeWithStaticTable(const StaticCodeTable& i_sTable,
+                                    ByteSpan i_input,
+                                    MutableByteSpan o_output) noexcept {
+  sBitReader_t sReader;
+  initBitReader(&sReader, i_input.data(), i_input.size());
+
+  for (std::size_t i = 0; i < o_output.size(); i++) {
+    if (sReader.bitCount < HUFFMAN_MAX_CODE_LENGTH) {
+      refillBitReader(&sReader);
+    }
+
+    const std::uint16_t entry =
+        i_sTable.decodeTable[peekBits(&sReader, STATIC_DECODE_TABLE_BITS)];
+    if (entry != 0) {
+      o_output.data()[i] = (std::uint8_t)(entry >> 4);
+      consumeBits(&sReader, entry & 0x0FU);
+      continue;
+    }
+
+    /* Read a long code one bit at a time, most significant bit first. */
+    std::uint32_t code = 0;
+    bool isDecoded = false;
+    for (std::size_t length = 1; length <= i_sTable.maxLength; length++) {
+      code = (code << 1) | (std::uint32_t)peekBits(&sReader, 1);
+      consumeBits(&sReader, 1);
+      const std::uint32_t index = code - i_sTable.firstCodes[length];
+      if (index < i_sTable.counts[length]) {
+        o_output.data()[i] = i_sTable.symbols[i_sTable.offsets[length] + index];
+        isDecoded = true;
+        break;
+      }
+    }
+    if (!isDecoded) {
+      return {Error::CorruptInput, 0};
+    }
+  }
+
+  if (getBitReaderPosition(&sReader) > i_input.size()) {
+    return {Error::CorruptInput, 0};
+  }
+  return {Error::None, o_output.size()};
+}
+
+}  // namespace huffman
+
+#endif  // STATIC_CODE_TABLE_HPP
@@ -0,0 +1,219 @@
+/**
+ * @file stats.c
+ * @brief Per-stage timing and counter instrumentation.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+/* Feature Test Macros */
+
+#define _POSIX_C_SOURCE 200809L
+
+/* Standard Library Includes */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Project Includes */
+
+#include "huffmanCoding/huffmanTree.h"
+#include "huffmanCoding/stats.h"
+
+/* Global Variables */
+
+/**< The statistics of the current thread. */
+static _Thread_local sHuffmanStats_t g_sStats;
+
+/**< The stage the current thread's allocations belong to. */
+static _Thread_local eHuffmanStage_t g_eAllocationStage = HUFFMAN_STAGE_MAX;
+
+/**< The name of each stage in the JSON output. */
+static const char* const STAGE_NAMES[HUFFMAN_STAGE_MAX] = {
+    "read", "histogram", "tree_build", "table_build", "encode", "decode", "io"};
+
+/* Function Prototypes */
+
+/**
+ * @brief Write a JSON array of unsigned integers.
+ *
+ * @param[inout] io_pFile The file to write to.
+ * @param[in] i_aValues The values to write.
+ * @param[in] i_count The number of values.
+ */
+static void writeJsonArray(FILE* io_pFile, const uint64_t* i_aValues,
+                           size_t i_count);
+
+/* Function Definitions */
+
+/**
+ * @brief Write a JSON array of unsigned integers.
+ *
+ * @param[inout] io_pFile The file to write to.
+ * @param[in] i_aValues The values to write.
+ * @param[in] i_count The number of values.
+ */
+static void writeJsonArray(FILE* io_pFile, const uint64_t* i_aValues,
+                           size_t i_count) {
+  (void)fputc('[', io_pFile);
+  for (size_t i = 0; i < i_count; i++) {
+    (void)fprintf(io_pFile, "%s%" PRIu64, (i == 0) ? "" : ", ", i_aValues[i]);
+  }
+  (void)fputc(']', io_pFile);
+}
+
+/**
+ * @brief Check whether the instrumentation was compiled in.
+ *
+ * @return true if statistics are being recorded.
+ * @return false if the recording macros compile to nothing.
+ */
+bool isHuffmanStatsEnabled(void) {
+#ifdef HUFFMAN_ENABLE_STATS
+  return true;
+#else
+  return false;
+#endif
+}
+
+/**
+ * @brief Copy the current thread's statistics.
+ *
+ * @param[out] o_psStats The statistics recorded since the last reset.
+ */
+void getHuffmanStats(sHuffmanStats_t* o_psStats) { *o_psStats = g_sStats; }
+
+/**
+ * @brief Reset the current thread's statistics to zero.
+ */
+void resetHuffmanStats(void) { (void)memset(&g_sStats, 0, sizeof(g_sStats)); }
+
+/**
+ * @brief Get the name of a stage as used in the JSON output.
+ *
+ * @param[in] i_eStage The stage.
+ * @return const char* The name of the stage.
+ */
+const char* getHuffmanStageName(eHuffmanStage_t i_eStage) {
+  if ((int)i_eStage < 0 || i_eStage >= HUFFMAN_STAGE_MAX) {
+    return "unknown";
+  }
+  return STAGE_NAMES[i_eStage];
+}
+
+/**
+ * @brief Write statistics as a single JSON object.
+ *
+ * The object is written without a trailing newline so that it can be nested
+ * inside other JSON documents.
+ *
+ * @param[inout] io_pFile The file to write to.
+ * @param[in] i_psStats The statistics to write.
+ * @return int EXIT_SUCCESS if the object was written successfully, else
+ * EXIT_FAILURE.
+ */
+int writeHuffmanStatsJson(FILE* io_pFile, const sHuffmanStats_t* i_psStats) {
+  (void)fprintf(io_pFile, "{\"enabled\": %s, \"stages\": {",
+                isHuffmanStatsEnabled() ? "true" : "false");
+  for (size_t stage = 0; stage < HUFFMAN_STAGE_MAX; stage++) {
+    (void)fprintf(io_pFile,
+                  "%s\"%s\": {\"ns\": %" PRIu64 ", \"calls\": %" PRIu64
+                  ", \"bytes\": %" PRIu64 "}",
+                  (stage == 0) ? "" : ", ", STAGE_NAMES[stage],
+                  i_psStats->aStageNanoseconds[stage],
+                  i_psStats->aStageCalls[stage], i_psStats->aStageBytes[stage]);
+  }
+
+  (void)fprintf(io_pFile,
+                "}, \"symbols_encoded\": %" PRIu64
+                ", \"symbols_decoded\": %" PRIu64
+                ", \"blocks_encoded\": %" PRIu64
+                ", \"blocks_decoded\": %" PRIu64 ", \"blocks_stored\": %" PRIu64
+                ", \"blocks_sampled\": %" PRIu64 ", \"allocations\": %" PRIu64
+                ", \"frees\": %" PRIu64 ", \"max_tree_depth\": %" PRIu64
+                ", \"length_limit_rebuilds\": %" PRIu64
+                ", \"code_length_histogram\": ",
+                i_psStats->symbolsEncoded, i_psStats->symbolsDecoded,
+                i_psStats->blocksEncoded, i_psStats->blocksDecoded,
+                i_psStats->blocksStored, i_psStats->blocksSampled,
+                i_psStats->allocations, i_psStats->frees,
+                i_psStats->maxTreeDepth, i_psStats->lengthLimitRebuilds);
+  writeJsonArray(io_pFile, i_psStats->aCodeLengthHistogram,
+                 HUFFMAN_MAX_CODE_LENGTH + 1);
+  (void)fputc('}', io_pFile);
+
+  return ferror(io_pFile) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/**
+ * @brief Set the stage that the current thread's allocations belong to.
+ *
+ * @param[in] i_eStage The stage, or HUFFMAN_STAGE_MAX for none.
+ * @return eHuffmanStage_t The previous stage, to be restored afterwards.
+ */
+eHuffmanStage_t setHuffmanAllocationStage(eHuffmanStage_t i_eStage) {
+  const eHuffmanStage_t ePrevious = g_eAllocationStage;
+  g_eAllocationStage = i_eStage;
+  return ePrevious;
+}
+
+/**
+ * @brief Get the stage that the current thread's allocations belong to.
+ *
+ * @return eHuffmanStage_t The stage, or HUFFMAN_STAGE_MAX for none.
+ */
+eHuffmanStage_t getHuffmanAllocationStage(void) { return g_eAllocationStage; }
+
+/**
+ * @brief Read the monotonic clock.
+ *
+ * @return uint64_t The monotonic time in nanoseconds.
+ */
+uint64_t getMonotonicNanoseconds(void) {
+  struct timespec sTime;
+  (void)clock_gettime(CLOCK_MONOTONIC, &sTime);
+  return ((uint64_t)sTime.tv_sec * 1000000000U) + (uint64_t)sTime.tv_nsec;
+}
+
+/**
+ * @brief Get the current thread's statistics for recording.
+ *
+ * @return sHuffmanStats_t* The current thread's statistics.
+ */
+sHuffmanStats_t* getHuffmanStatsInstance(void) { return &g_sStats; }
+
+/**
+ * @brief Record the time and bytes of a completed stage.
+ *
+ * @param[in] i_eStage The stage that completed.
+ * @param[in] i_startNanoseconds The monotonic time the stage started.
+ * @param[in] i_bytes The number of bytes the stage processed.
+ */
+void recordHuffmanStage(eHuffmanStage_t i_eStage, uint64_t i_startNanoseconds,
+                        uint64_t i_bytes) {
+  g_sStats.aStageNanoseconds[i_eStage] +=
+      getMonotonicNanoseconds() - i_startNanoseconds;
+  g_sStats.aStageCalls[i_eStage]++;
+  g_sStats.aStageBytes[i_eStage] += i_bytes;
+}
+
+/**
+ * @brief Add the code lengths of a code table to the code length histogram.
+ *
+ * @param[in] i_aCodeLengths The code length of each symbol.
+ */
+void recordHuffmanCodeLengths(
+    const uint8_t i_aCodeLengths[HUFFMAN_ALPHABET_SIZE]) {
+  for (size_t symbol = 0; symbol < HUFFMAN_ALPHABET_SIZE; symbol++) {
+    if (i_aCodeLengths[symbol] != 0 &&
+        i_aCodeLengths[symbol] <= HUFFMAN_MAX_CODE_LENGTH) {
+      g_sStats.aCodeLengthHistogram[i_aCodeLengths[symbol]]++;
+    }
+  }
+}
@@ -0,0 +1,194 @@
+/**
+ * @file stats.h
+ * @brief Per-stage timing and counter instrumentation.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ * Instrumentation is recorded per thread when the project is built with
+ * HUFFMAN_ENABLE_STATS defined. Otherwise the recording macros expand to
+ * nothing, and the query functions report zeroed statistics. The allocation
+ * stage is tracked regardless, so that allocators can attribute memory to the
+ * stage that requested it.
+ */
+
+#ifndef STATS_H
+#define STATS_H
+
+/* Standard Library Includes */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/* Project Includes */
+
+#include "huffmanCoding/huffmanTree.h"
+
+/* Type Definitions */
+
+/**
+ * @brief Stages of compression and decompression that are timed.
+ */
+typedef enum eHuffmanStage {
+  HUFFMAN_STAGE_READ,        /**< Reading input files, e.g. readTextFile. */
+  HUFFMAN_STAGE_HISTOGRAM,   /**< Counting symbol frequencies. */
+  HUFFMAN_STAGE_TREE_BUILD,  /**< Building trees and canonical code tables. */
+  HUFFMAN_STAGE_TABLE_BUILD, /**< Building decode tables. */
+  HUFFMAN_STAGE_ENCODE,      /**< Writing coded payloads. */
+  HUFFMAN_STAGE_DECODE,      /**< Reading coded payloads. */
+  HUFFMAN_STAGE_IO,          /**< Writing output files. */
+  HUFFMAN_STAGE_MAX          /**< Outside of any stage. */
+} eHuffmanStage_t;
+
+/**
+ * @brief Statistics recorded by the instrumentation.
+ */
+typedef struct sHuffmanStats {
+  uint64_t aStageNanoseconds[HUFFMAN_STAGE_MAX];
+  uint64_t aStageCalls[HUFFMAN_STAGE_MAX];
+  uint64_t aStageBytes[HUFFMAN_STAGE_MAX];
+  uint64_t symbolsEncoded;
+  uint64_t symbolsDecoded;
+  uint64_t blocksEncoded;
+  uint64_t blocksDecoded;
+  uint64_t blocksStored;
+  uint64_t blocksSampled;
+  uint64_t allocations;
+  uint64_t frees;
+  uint64_t maxTreeDepth;
+  uint64_t lengthLimitRebuilds;
+  uint64_t aCodeLengthHistogram[HUFFMAN_MAX_CODE_LENGTH + 1];
+} sHuffmanStats_t;
+
+/* Macros */
+
+#ifdef HUFFMAN_ENABLE_STATS
+
+/**< Start timing a stage in the current scope. */
+#define HUFFMAN_STATS_BEGIN_STAGE(stage) \
+  const uint64_t huffmanStatsStart_##stage = getMonotonicNanoseconds()
+
+/**< Stop timing a stage started in the current scope. */
+#define HUFFMAN_STATS_END_STAGE(stage, bytes) \
+  recordHuffmanStage((stage), huffmanStatsStart_##stage, (bytes))
+
+/**< Add a value to a counter of the current thread's statistics. */
+#define HUFFMAN_STATS_ADD(field, value) \
+  (getHuffmanStatsInstance()->field += (uint64_t)(value))
+
+/**< Raise a counter of the current thread's statistics to a value. */
+#define HUFFMAN_STATS_MAX(field, value)                          \
+  do {                                                           \
+    sHuffmanStats_t* psHuffmanStats = getHuffmanStatsInstance(); \
+    if ((uint64_t)(value) > psHuffmanStats->field) {             \
+      psHuffmanStats->field = (uint64_t)(value);                 \
+    }                                                            \
+  } while (0)
+
+/**< Add the code lengths of a code table to the code length histogram. */
+#define HUFFMAN_STATS_CODE_LENGTHS(codeLengths) \
+  recordHuffmanCodeLengths(codeLengths)
+
+#else
+
+#define HUFFMAN_STATS_BEGIN_STAGE(stage) ((void)0)
+#define HUFFMAN_STATS_END_STAGE(stage, bytes) ((void)0)
+#define HUFFMAN_STATS_ADD(field, value) ((void)0)
+#define HUFFMAN_STATS_MAX(field, value) ((void)0)
+#define HUFFMAN_STATS_CODE_LENGTHS(codeLengths) ((void)0)
+
+#endif /* HUFFMAN_ENABLE_STATS */
+
+/* Function Prototypes */
+
+/**
+ * @brief Check whether the instrumentation was compiled in.
+ *
+ * @return true if statistics are being recorded.
+ * @return false if the recording macros compile to nothing.
+ */
+extern bool isHuffmanStatsEnabled(void);
+
+/**
+ * @brief Copy the current thread's statistics.
+ *
+ * @param[out] o_psStats The statistics recorded since the last reset.
+ */
+extern void getHuffmanStats(sHuffmanStats_t* o_psStats);
+
+/**
+ * @brief Reset the current thread's statistics to zero.
+ */
+extern void resetHuffmanStats(void);
+
+/**
+ * @brief Get the name of a stage as used in the JSON output.
+ *
+ * @param[in] i_eStage The stage.
+ * @return const char* The name of the stage.
+ */
+extern const char* getHuffmanStageName(eHuffmanStage_t i_eStage);
+
+/**
+ * @brief Write statistics as a single JSON object.
+ *
+ * The object is written without a trailing newline so that it can be nested
+ * inside other JSON documents.
+ *
+ * @param[inout] io_pFile The file to write to.
+ * @param[in] i_psStats The statistics to write.
+ * @return int EXIT_SUCCESS if the object was written successfully, else
+ * EXIT_FAILURE.
+ */
+extern int writeHuffmanStatsJson(FILE* io_pFile,
+                                 const sHuffmanStats_t* i_psStats);
+
+/**
+ * @brief Set the stage that the current thread's allocations belong to.
+ *
+ * @param[in] i_eStage The stage, or HUFFMAN_STAGE_MAX for none.
+ * @return eHuffmanStage_t The previous stage, to be restored afterwards.
+ */
+extern eHuffmanStage_t setHuffmanAllocationStage(eHuffmanStage_t i_eStage);
+
+/**
+ * @brief Get the stage that the current thread's allocations belong to.
+ *
+ * @return eHuffmanStage_t The stage, or HUFFMAN_STAGE_MAX for none.
+ */
+extern eHuffmanStage_t getHuffmanAllocationStage(void);
+
+/**
+ * @brief Read the monotonic clock.
+ *
+ * @return uint64_t The monotonic time in nanoseconds.
+ */
+extern uint64_t getMonotonicNanoseconds(void);
+
+/**
+ * @brief Get the current thread's statistics for recording.
+ *
+ * @return sHuffmanStats_t* The current thread's statistics.
+ */
+extern sHuffmanStats_t* getHuffmanStatsInstance(void);
+
+/**
+ * @brief Record the time and bytes of a completed stage.
+ *
+ * @param[in] i_eStage The stage that completed.
+ * @param[in] i_startNanoseconds The monotonic time the stage started.
+ * @param[in] i_bytes The number of bytes the stage processed.
+ */
+extern void recordHuffmanStage(eHuffmanStage_t i_eStage,
+                               uint64_t i_startNanoseconds, uint64_t i_bytes);
+
+/**
+ * @brief Add the code lengths of a code table to the code length histogram.
+ *
+ * @param[in] i_aCodeLengths The code length of each symbol.
+ */
+extern void recordHuffmanCodeLengths(
+    const uint8_t i_aCodeLengths[HUFFMAN_ALPHABET_SIZE]);
+
+#endif  // STATS_H
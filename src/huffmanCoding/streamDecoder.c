@@ -0,0 +1,818 @@
+/**
+ * @file streamDecoder.c
+ * @brief Decompress Huffman containers incrementally in bounded memory.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+/* Standard Library Includes */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Project Includes */
+
+#include "huffmanCoding/allocator.h"
+#include "huffmanCoding/bitStream.h"
+#include "huffmanCoding/checksum.h"
+#include "huffmanCoding/codec.h"
+#include "huffmanCoding/decodeKernel.h"
+#include "huffmanCoding/huffmanTree.h"
+#include "huffmanCoding/stats.h"
+#include "huffmanCoding/streamDecoder.h"
+
+/* Constants */
+
+/**< The magic bytes at the start of a container. */
+static const uint8_t HEADER_MAGIC[4] = {'H', 'U', 'F', 'F'};
+
+/**< The magic bytes at the end of a container. */
+static const uint8_t TRAILER_MAGIC[4] = {'H', 'U', 'F', 'X'};
+
+/**< The number of bytes in an entry of the block index. */
+#define INDEX_ENTRY_SIZE 8
+
+/**< The payload bytes of the chunk from which codes are decoded with the
+ * decode kernel rather than one at a time. */
+#define STREAM_KERNEL_MIN_INPUT 64
+
+/* Type Definitions */
+
+/**
+ * @brief The part of the container a stream decoder expects next.
+ */
+typedef enum eStreamState {
+  STREAM_STATE_HEADER,       /**< The container header. */
+  STREAM_STATE_BLOCK_SIZE,   /**< A block's size, or the end marker. */
+  STREAM_STATE_BLOCK_HEADER, /**< The rest of a block header. */
+  STREAM_STATE_CODE_LENGTHS, /**< A coded block's packed code lengths. */
+  STREAM_STATE_SYNC_COUNT,   /**< A coded block's sync point count. */
+  STREAM_STATE_SYNC_POINTS,  /**< A coded block's sync points, skipped. */
+  STREAM_STATE_CODED,        /**< A coded block's payload. */
+  STREAM_STATE_STORED,       /**< A stored block's payload. */
+  STREAM_STATE_PADDING,      /**< Payload bytes after the last code. */
+  STREAM_STATE_CHECKSUM,     /**< A block's checksum. */
+  STREAM_STATE_INDEX,        /**< The block index. */
+  STREAM_STATE_TRAILER,      /**< The trailer. */
+  STREAM_STATE_END,          /**< Nothing, the container has been decoded. */
+  STREAM_STATE_ERROR         /**< Nothing, the container is malformed. */
+} eStreamState_t;
+
+/**
+ * @brief Working memory of an incremental container decoder.
+ *
+ * Headers that are split across chunks are gathered in the staging buffer,
+ * which is large enough for the packed code lengths. Payload bytes are only
+ * ever held in the bit buffer. The block offsets are not kept for checking
+ * the block index, only a hash of them.
+ */
+struct sHuffmanStreamDecoder {
+  const sHuffmanAllocator_t* psAllocator;
+  eStreamState_t eState;
+  uint8_t aStaging[HUFFMAN_CODE_LENGTHS_SIZE];
+  size_t stagingSize;
+  uint64_t bitBuffer;
+  size_t bitCount;
+  size_t payloadRemaining; /**< Payload bytes of the block not consumed. */
+  size_t symbolsRemaining; /**< Bytes of the block not yet decoded. */
+  bool hasSyncPoints;
+  bool hasChecksum;
+  uint32_t checksum; /**< The checksum of the block's bytes so far. */
+  uint64_t syncPointsRemaining; /**< Sync point bytes not consumed. */
+  uint64_t containerPosition; /**< Bytes consumed before the current call. */
+  uint64_t decompressedSize;
+  size_t blockCount;
+  size_t indexRemaining; /**< Entries of the block index not yet read. */
+  uint64_t blockOffsetHash;
+  uint64_t indexHash;
+  bool isDecodeTableValid;
+  uint8_t aDecodeTableLengths[HUFFMAN_CODE_LENGTHS_SIZE]; /**< Packed. */
+  uint8_t aCodeLengths[HUFFMAN_ALPHABET_SIZE];
+  sHuffmanCodeTable_t sCodeTable;
+  sHuffmanCanonicalDecoder_t sCanonicalDecoder;
+  decodeTableEntry_t aDecodeTable[HUFFMAN_DECODE_TABLE_SIZE];
+};
+
+/* Function Prototypes */
+
+/**
+ * @brief Mark a stream decoder as failed.
+ *
+ * @param[inout] io_psDecoder The stream decoder.
+ * @param[in] i_pMessage The error to report.
+ */
+static void failStream(sHuffmanStreamDecoder_t* io_psDecoder,
+                       const char* i_pMessage);
+
+/**
+ * @brief Mix a value into a running hash.
+ *
+ * @param[in] i_hash The hash so far.
+ * @param[in] i_value The value to mix in.
+ * @return uint64_t The new hash.
+ */
+static uint64_t mixHash(uint64_t i_hash, uint64_t i_value);
+
+/**
+ * @brief Gather input into the staging buffer until it holds a given number
+ * of bytes.
+ *
+ * @param[inout] io_psDecoder The stream decoder.
+ * @param[in] i_pInput The chunk of the container.
+ * @param[in] i_inputSize The number of bytes in the chunk.
+ * @param[inout] io_pInputPosition The position in the chunk.
+ * @param[in] i_size The number of bytes the staging buffer must hold.
+ * @return bool Whether the staging buffer holds i_size bytes.
+ */
+static bool stageInput(sHuffmanStreamDecoder_t* io_psDecoder,
+                       const uint8_t* i_pInput, size_t i_inputSize,
+                       size_t* io_pInputPosition, size_t i_size);
+
+/**
+ * @brief Load the decoding tables from the staged code lengths.
+ *
+ * @param[inout] io_psDecoder The stream decoder.
+ * @return int EXIT_SUCCESS if the tables were loaded successfully, else
+ * EXIT_FAILURE.
+ */
+static int loadStreamTables(sHuffmanStreamDecoder_t* io_psDecoder);
+
+/**
+ * @brief Decode a long code from the bits available in the bit buffer.
+ *
+ * @param[in] i_psDecoder The canonical decoding tables.
+ * @param[in] i_bits The bit buffer.
+ * @param[in] i_bitCount The number of valid bits in the bit buffer.
+ * @param[out] o_pSymbol The decoded symbol.
+ * @return size_t The length of the code, 0 if more bits are needed, or more
+ * than HUFFMAN_MAX_CODE_LENGTH if the code is invalid.
+ */
+static size_t decodeStreamCode(const sHuffmanCanonicalDecoder_t* i_psDecoder,
+                               uint64_t i_bits, size_t i_bitCount,
+                               uint8_t* o_pSymbol);
+
+/**
+ * @brief Decode as much of a coded payload as the input and output allow.
+ *
+ * @param[inout] io_psDecoder The stream decoder.
+ * @param[in] i_pInput The chunk of the container.
+ * @param[in] i_inputSize The number of bytes in the chunk.
+ * @param[inout] io_pInputPosition The position in the chunk.
+ * @param[out] o_pOutput The output window.
+ * @param[in] i_outputCapacity The number of bytes in the window.
+ * @param[inout] io_pOutputPosition The position in the window.
+ * @return eHuffmanStreamStatus_t HUFFMAN_STREAM_END if the block has been
+ * decoded, HUFFMAN_STREAM_CONTINUE if more input or output space is needed,
+ * else HUFFMAN_STREAM_ERROR.
+ */
+static eHuffmanStreamStatus_t decodeStreamPayload(
+    sHuffmanStreamDecoder_t* io_psDecoder, const uint8_t* i_pInput,
+    size_t i_inputSize, size_t* io_pInputPosition, uint8_t* o_pOutput,
+    size_t i_outputCapacity, size_t* io_pOutputPosition);
+
+/**
+ * @brief Parse a staged block header and start its payload.
+ *
+ * @param[inout] io_psDecoder The stream decoder.
+ * @param[in] i_blockOffset The offset of the block in the container.
+ */
+static void startStreamBlock(sHuffmanStreamDecoder_t* io_psDecoder,
+                             uint64_t i_blockOffset);
+
+/**
+ * @brief Check a staged trailer against the blocks decoded.
+ *
+ * @param[inout] io_psDecoder The stream decoder.
+ */
+static void finishStream(sHuffmanStreamDecoder_t* io_psDecoder);
+
+/* Function Definitions */
+
+/**
+ * @brief Mark a stream decoder as failed.
+ *
+ * @param[inout] io_psDecoder The stream decoder.
+ * @param[in] i_pMessage The error to report.
+ */
+static void failStream(sHuffmanStreamDecoder_t* io_psDecoder,
+                       const char* i_pMessage) {
+  (void)fprintf(stderr, "ERROR: %s\n", i_pMessage);
+  io_psDecoder->eState = STREAM_STATE_ERROR;
+}
+
+/**
+ * @brief Mix a value into a running hash.
+ *
+ * @param[in] i_hash The hash so far.
+ * @param[in] i_value The value to mix in.
+ * @return uint64_t The new hash.
+ */
+static uint64_t mixHash(uint64_t i_hash, uint64_t i_value) {
+  return (i_hash ^ i_value) * 0x100000001B3ULL;
+}
+
+/**
+ * @brief Gather input into the staging buffer until it holds a given number
+ * of bytes.
+ *
+ * @param[inout] io_psDecoder The stream decoder.
+ * @param[in] i_pInput The chunk of the container.
+ * @param[in] i_inputSize The number of bytes in the chunk.
+ * @param[inout] io_pInputPosition The position in the chunk.
+ * @param[in] i_size The number of bytes the staging buffer must hold.
+ * @return bool Whether the staging buffer holds i_size bytes.
+ */
+static bool stageInput(sHuffmanStreamDecoder_t* io_psDecoder,
+                       const uint8_t* i_pInput, size_t i_inputSize,
+                       size_t* io_pInputPosition, size_t i_size) {
+  const size_t needed = i_size - io_psDecoder->stagingSize;
+  const size_t available = i_inputSize - *io_pInputPosition;
+  const size_t count = (available < needed) ? available : needed;
+
+  if (count > 0) {
+    (void)memcpy(&io_psDecoder->aStaging[io_psDecoder->stagingSize],
+                 &i_pInput[*io_pInputPosition], count);
+  }
+  io_psDecoder->stagingSize += count;
+  *io_pInputPosition += count;
+
+  return io_psDecoder->stagingSize == i_size;
+}
+
+/**
+ * @brief Load the decoding tables from the staged code lengths.
+ *
+ * The tables are only rebuilt when the code lengths differ from those they
+ * were built from.
+ *
+ * @param[inout] io_psDecoder The stream decoder.
+ * @return int EXIT_SUCCESS if the tables were loaded successfully, else
+ * EXIT_FAILURE.
+ */
+static int loadStreamTables(sHuffmanStreamDecoder_t* io_psDecoder) {
+  const uint8_t* pCodeLengths = io_psDecoder->aStaging;
+  if (io_psDecoder->isDecodeTableValid &&
+      memcmp(io_psDecoder->aDecodeTableLengths, pCodeLengths,
+             HUFFMAN_CODE_LENGTHS_SIZE) == 0) {
+    return EXIT_SUCCESS;
+  }
+
+  HUFFMAN_STATS_BEGIN_STAGE(HUFFMAN_STAGE_TABLE_BUILD);
+  io_psDecoder->isDecodeTableValid = false;
+  for (size_t i = 0; i < HUFFMAN_CODE_LENGTHS_SIZE; i++) {
+    io_psDecoder->aCodeLengths[2 * i] = pCodeLengths[i] & 0x0FU;
+    io_psDecoder->aCodeLengths[(2 * i) + 1] = pCodeLengths[i] >> 4;
+  }
+  if (createCanonicalCodeTable(io_psDecoder->aCodeLengths,
+                               &io_psDecoder->sCodeTable) == EXIT_FAILURE) {
+    return EXIT_FAILURE;
+  }
+
+  (void)createDecodeTable(&io_psDecoder->sCodeTable,
+                          io_psDecoder->aDecodeTable);
+  createCanonicalDecoder(io_psDecoder->aCodeLengths,
+                         &io_psDecoder->sCanonicalDecoder);
+  (void)memcpy(io_psDecoder->aDecodeTableLengths, pCodeLengths,
+               HUFFMAN_CODE_LENGTHS_SIZE);
+  io_psDecoder->isDecodeTableValid = true;
+  HUFFMAN_STATS_END_STAGE(HUFFMAN_STAGE_TABLE_BUILD, 0);
+
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Decode a long code from the bits available in the bit buffer.
+ *
+ * This function reads the code one bit at a time, most significant bit
+ * first, and stops rather than reading past the valid bits so the code can
+ * be finished once more input arrives. The codec's nibble tree is not used,
+ * as it alone would fill the decoder's 8 KiB and it reads 4 bits at a time.
+ *
+ * @param[in] i_psDecoder The canonical decoding tables.
+ * @param[in] i_bits The bit buffer.
+ * @param[in] i_bitCount The number of valid bits in the bit buffer.
+ * @param[out] o_pSymbol The decoded symbol.
+ * @return size_t The length of the code, 0 if more bits are needed, or more
+ * than HUFFMAN_MAX_CODE_LENGTH if the code is invalid.
+ */
+static size_t decodeStreamCode(const sHuffmanCanonicalDecoder_t* i_psDecoder,
+                               uint64_t i_bits, size_t i_bitCount,
+                               uint8_t* o_pSymbol) {
+  uint32_t code = 0;
+
+  for (size_t length = 1; length <= i_psDecoder->maxLength; length++) {
+    if (length > i_bitCount) {
+      return 0;
+    }
+    code = (code << 1) | (uint32_t)((i_bits >> (length - 1)) & 1U);
+
+    /* Codes below the first code of this length wrap to a large index. */
+    const uint32_t index = code - i_psDecoder->aFirstCodes[length];
+    if (index < i_psDecoder->aCounts[length]) {
+      *o_pSymbol = i_psDecoder->aSymbols[i_psDecoder->aOffsets[length] + index];
+      return length;
+    }
+  }
+
+  return HUFFMAN_MAX_CODE_LENGTH + 1;
+}
+
+/**
+ * @brief Decode as much of a coded payload as the input and output allow.
+ *
+ * While at least STREAM_KERNEL_MIN_INPUT bytes of the payload are in the
+ * chunk, codes are decoded with decodeTableSymbols, at most as many as fit
+ * in those bytes at the decode table width, so that none runs past them.
+ * Otherwise payload bytes are moved into the bit buffer, a whole word at a
+ * time when the chunk allows. A symbol is only written once every bit of
+ * its code is in the bit buffer, so a code split across chunks stays in the
+ * bit buffer until the next call. Past the end of the payload the bit
+ * buffer supplies zero bits, as the bit reader in bitStream.h does.
+ *
+ * @param[inout] io_psDecoder The stream decoder.
+ * @param[in] i_pInput The chunk of the container.
+ * @param[in] i_inputSize The number of bytes in the chunk.
+ * @param[inout] io_pInputPosition The position in the chunk.
+ * @param[out] o_pOutput The output window.
+ * @param[in] i_outputCapacity The number of bytes in the window.
+ * @param[inout] io_pOutputPosition The position in the window.
+ * @return eHuffmanStreamStatus_t HUFFMAN_STREAM_END if the block has been
+ * decoded, HUFFMAN_STREAM_CONTINUE if more input or output space is needed,
+ * else HUFFMAN_STREAM_ERROR.
+ */
+static eHuffmanStreamStatus_t decodeStreamPayload(
+    sHuffmanStreamDecoder_t* io_psDecoder, const uint8_t* i_pInput,
+    size_t i_inputSize, size_t* io_pInputPosition, uint8_t* o_pOutput,
+    size_t i_outputCapacity, size_t* io_pOutputPosition) {
+  const decodeTableEntry_t* aDecodeTable = io_psDecoder->aDecodeTable;
+  uint64_t bitBuffer = io_psDecoder->bitBuffer;
+  size_t bitCount = io_psDecoder->bitCount;
+  size_t payloadRemaining = io_psDecoder->payloadRemaining;
+  size_t inputPosition = *io_pInputPosition;
+  size_t outputPosition = *io_pOutputPosition;
+  size_t outputEnd = outputPosition + io_psDecoder->symbolsRemaining;
+  eHuffmanStreamStatus_t eStatus = HUFFMAN_STREAM_END;
+
+  outputEnd = (outputEnd < i_outputCapacity) ? outputEnd : i_outputCapacity;
+  while (outputPosition < outputEnd) {
+    size_t usable = i_inputSize - inputPosition;
+    usable = (usable < payloadRemaining) ? usable : payloadRemaining;
+    if (usable >= STREAM_KERNEL_MIN_INPUT) {
+      sBitReader_t sReader;
+      initBitReader(&sReader, &i_pInput[inputPosition], usable);
+      sReader.bitBuffer = bitBuffer;
+      sReader.bitCount = bitCount;
+      size_t limit = (bitCount + (usable * 8)) / HUFFMAN_DECODE_TABLE_BITS;
+      limit = (limit < outputEnd - outputPosition) ? limit
+                                                   : outputEnd - outputPosition;
+      const size_t count = decodeTableSymbols(
+          aDecodeTable, &sReader, &o_pOutput[outputPosition], limit);
+
+      /* Drop the zero bytes the reader supplied past the usable bytes. */
+      if (sReader.position > usable) {
+        sReader.bitCount -= (sReader.position - usable) * 8;
+        sReader.position = usable;
+      }
+      bitBuffer = sReader.bitBuffer;
+      bitCount = sReader.bitCount;
+      inputPosition += sReader.position;
+      payloadRemaining -= sReader.position;
+      outputPosition += count;
+      if (count > 0) {
+        continue;
+      }
+    }
+
+    if (bitCount < HUFFMAN_MAX_CODE_LENGTH) {
+      const size_t available = i_inputSize - inputPosition;
+      if (available >= 8 && payloadRemaining >= 8) {
+        /* Fast path, load a whole word and keep the bytes that fit. */
+        const size_t count = (63 - bitCount) >> 3;
+        bitBuffer |= loadLittleEndian64(&i_pInput[inputPosition]) << bitCount;
+        inputPosition += count;
+        payloadRemaining -= count;
+        bitCount |= 56;
+      } else {
+        while (bitCount <= 56 && inputPosition < i_inputSize &&
+               payloadRemaining > 0) {
+          bitBuffer |= (uint64_t)i_pInput[inputPosition++] << bitCount;
+          bitCount += 8;
+          payloadRemaining--;
+        }
+      }
+    }
+
+    const decodeTableEntry_t entry =
+        aDecodeTable[bitBuffer & (HUFFMAN_DECODE_TABLE_SIZE - 1)];
+    size_t length = entry & 0x0FU;
+    uint8_t symbol = (uint8_t)(entry >> 4);
+    if (entry == 0 || length > bitCount) {
+      length = decodeStreamCode(&io_psDecoder->sCanonicalDecoder, bitBuffer,
+                                bitCount, &symbol);
+      if (length == 0 && payloadRemaining > 0) {
+        /* The rest of the code is in the next chunk. */
+        eStatus = HUFFMAN_STREAM_CONTINUE;
+        break;
+      }
+      if (length == 0 || length > HUFFMAN_MAX_CODE_LENGTH) {
+        failStream(io_psDecoder, (length == 0) ? "Block payload is truncated"
+                                               : "Invalid code in block");
+        return HUFFMAN_STREAM_ERROR;
+      }
+    }
+
+    o_pOutput[outputPosition++] = symbol;
+    bitBuffer >>= length;
+    bitCount -= length;
+  }
+
+  const size_t outputSize = outputPosition - *io_pOutputPosition;
+  io_psDecoder->symbolsRemaining -= outputSize;
+  if (io_psDecoder->symbolsRemaining > 0) {
+    eStatus = HUFFMAN_STREAM_CONTINUE;
+  }
+  HUFFMAN_STATS_ADD(symbolsDecoded, outputSize);
+
+  io_psDecoder->bitBuffer = bitBuffer;
+  io_psDecoder->bitCount = bitCount;
+  io_psDecoder->payloadRemaining = payloadRemaining;
+  *io_pInputPosition = inputPosition;
+  *io_pOutputPosition = outputPosition;
+  return eStatus;
+}
+
+/**
+ * @brief Parse a staged block header and start its payload.
+ *
+ * @param[inout] io_psDecoder The stream decoder.
+ * @param[in] i_blockOffset The offset of the block in the container.
+ */
+static void startStreamBlock(sHuffmanStreamDecoder_t* io_psDecoder,
+                             uint64_t i_blockOffset) {
+  const size_t outputSize = loadLittleEndian32(&io_psDecoder->aStaging[0]);
+  const size_t payloadSize = loadLittleEndian32(&io_psDecoder->aStaging[4]);
+  const bool isStored =
+      (io_psDecoder->aStaging[8] & HUFFMAN_BLOCK_FLAG_STORED) != 0;
+  io_psDecoder->hasSyncPoints =
+      (io_psDecoder->aStaging[8] & HUFFMAN_BLOCK_FLAG_SYNC_POINTS) != 0;
+  io_psDecoder->hasChecksum =
+      (io_psDecoder->aStaging[8] & HUFFMAN_BLOCK_FLAG_CHECKSUM) != 0;
+  io_psDecoder->checksum = 0;
+
+  if (isStored && payloadSize != outputSize) {
+    failStream(io_psDecoder, "Malformed stored block");
+    return;
+  }
+
+  io_psDecoder->symbolsRemaining = outputSize;
+  io_psDecoder->payloadRemaining = payloadSize;
+  io_psDecoder->bitBuffer = 0;
+  io_psDecoder->bitCount = 0;
+  io_psDecoder->decompressedSize += outputSize;
+  io_psDecoder->blockCount++;
+  io_psDecoder->blockOffsetHash =
+      mixHash(io_psDecoder->blockOffsetHash, i_blockOffset);
+  io_psDecoder->eState =
+      isStored ? STREAM_STATE_STORED : STREAM_STATE_CODE_LENGTHS;
+}
+
+/**
+ * @brief Check a staged trailer against the blocks decoded.
+ *
+ * @param[inout] io_psDecoder The stream decoder.
+ */
+static void finishStream(sHuffmanStreamDecoder_t* io_psDecoder) {
+  const uint8_t* pTrailer = io_psDecoder->aStaging;
+
+  if (memcmp(&pTrailer[12], TRAILER_MAGIC, sizeof(TRAILER_MAGIC)) != 0) {
+    failStream(io_psDecoder, "Missing container trailer");
+  } else if (loadLittleEndian64(&pTrailer[0]) !=
+                 io_psDecoder->decompressedSize ||
+             loadLittleEndian32(&pTrailer[8]) != io_psDecoder->blockCount) {
+    failStream(io_psDecoder, "Trailer does not match blocks");
+  } else {
+    io_psDecoder->eState = STREAM_STATE_END;
+  }
+}
+
+/**
+ * @brief Find the working memory of a stream decoder.
+ *
+ * @return size_t The number of bytes createStreamDecoder allocates, which is
+ * all the memory a stream decoder ever uses.
+ */
+size_t getStreamDecoderSize(void) { return sizeof(sHuffmanStreamDecoder_t); }
+
+/**
+ * @brief Create a stream decoder, ready for the start of a container.
+ *
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ * @return sHuffmanStreamDecoder_t* The stream decoder, else NULL.
+ */
+sHuffmanStreamDecoder_t* createStreamDecoder(
+    const sHuffmanAllocator_t* i_psAllocator) {
+  sHuffmanStreamDecoder_t* psDecoder =
+      (sHuffmanStreamDecoder_t*)allocateHuffmanMemory(
+          i_psAllocator, sizeof(sHuffmanStreamDecoder_t));
+  if (psDecoder == NULL) {
+    perror("ERROR: Failed to allocate memory for stream decoder");
+    return NULL;
+  }
+
+  psDecoder->psAllocator = i_psAllocator;
+  psDecoder->isDecodeTableValid = false;
+  resetStreamDecoder(psDecoder);
+
+  return psDecoder;
+}
+
+/**
+ * @brief Free a stream decoder created by createStreamDecoder.
+ *
+ * @param[inout] io_psDecoder The stream decoder to free, or NULL.
+ */
+void freeStreamDecoder(sHuffmanStreamDecoder_t* io_psDecoder) {
+  if (io_psDecoder == NULL) {
+    return;
+  }
+
+  freeHuffmanMemory(io_psDecoder->psAllocator, io_psDecoder);
+}
+
+/**
+ * @brief Prepare a stream decoder for the start of a new container.
+ *
+ * The decode tables are kept, as the next container may use the same code
+ * lengths.
+ *
+ * @param[inout] io_psDecoder The stream decoder to reset.
+ */
+void resetStreamDecoder(sHuffmanStreamDecoder_t* io_psDecoder) {
+  io_psDecoder->eState = STREAM_STATE_HEADER;
+  io_psDecoder->stagingSize = 0;
+  io_psDecoder->bitBuffer = 0;
+  io_psDecoder->bitCount = 0;
+  io_psDecoder->payloadRemaining = 0;
+  io_psDecoder->symbolsRemaining = 0;
+  io_psDecoder->hasSyncPoints = false;
+  io_psDecoder->hasChecksum = false;
+  io_psDecoder->checksum = 0;
+  io_psDecoder->syncPointsRemaining = 0;
+  io_psDecoder->containerPosition = 0;
+  io_psDecoder->decompressedSize = 0;
+  io_psDecoder->blockCount = 0;
+  io_psDecoder->indexRemaining = 0;
+  io_psDecoder->blockOffsetHash = 0;
+  io_psDecoder->indexHash = 0;
+}
+
+/**
+ * @brief Decode as much of a container as the input and output allow.
+ *
+ * This function consumes input until it runs out, the output is full or the
+ * container ends. Input that has been consumed is held by the decoder, so
+ * the next call continues with the input that follows it. It returns
+ * HUFFMAN_STREAM_CONTINUE until the trailer has been validated, after which
+ * it returns HUFFMAN_STREAM_END and consumes no more input. Once it has
+ * returned HUFFMAN_STREAM_ERROR the decoder must be reset.
+ *
+ * @param[inout] io_psDecoder The stream decoder.
+ * @param[in] i_pInput The next chunk of the container.
+ * @param[in] i_inputSize The number of bytes in the chunk.
+ * @param[out] o_pInputConsumed The number of bytes consumed from the chunk.
+ * @param[out] o_pOutput The output window to write decoded bytes to.
+ * @param[in] i_outputCapacity The number of bytes available in the window.
+ * @param[out] o_pOutputSize The number of bytes written to the window.
+ * @return eHuffmanStreamStatus_t The status of the stream.
+ */
+eHuffmanStreamStatus_t decompressStream(sHuffmanStreamDecoder_t* io_psDecoder,
+                                        const uint8_t* i_pInput,
+                                        size_t i_inputSize,
+                                        size_t* o_pInputConsumed,
+                                        uint8_t* o_pOutput,
+                                        size_t i_outputCapacity,
+                                        size_t* o_pOutputSize) {
+  size_t inputPosition = 0;
+  size_t outputPosition = 0;
+  bool isBlocked = false;
+
+  while (!isBlocked && io_psDecoder->eState != STREAM_STATE_END &&
+         io_psDecoder->eState != STREAM_STATE_ERROR) {
+    switch (io_psDecoder->eState) {
+      case STREAM_STATE_HEADER:
+        isBlocked = !stageInput(io_psDecoder, i_pInput, i_inputSize,
+                                &inputPosition, HUFFMAN_HEADER_SIZE);
+        if (isBlocked) {
+          break;
+        }
+        if (memcmp(io_psDecoder->aStaging, HEADER_MAGIC,
+                   sizeof(HEADER_MAGIC)) != 0 ||
+            io_psDecoder->aStaging[4] != HUFFMAN_FORMAT_VERSION) {
+          failStream(io_psDecoder, "Not a Huffman container");
+          break;
+        }
+        io_psDecoder->stagingSize = 0;
+        io_psDecoder->eState = STREAM_STATE_BLOCK_SIZE;
+        break;
+
+      case STREAM_STATE_BLOCK_SIZE:
+        isBlocked = !stageInput(io_psDecoder, i_pInput, i_inputSize,
+                                &inputPosition, sizeof(uint32_t));
+        if (isBlocked) {
+          break;
+        }
+        if (loadLittleEndian32(io_psDecoder->aStaging) == 0) {
+          io_psDecoder->stagingSize = 0;
+          io_psDecoder->indexRemaining = io_psDecoder->blockCount;
+          io_psDecoder->eState = STREAM_STATE_INDEX;
+        } else {
+          io_psDecoder->eState = STREAM_STATE_BLOCK_HEADER;
+        }
+        break;
+
+      case STREAM_STATE_BLOCK_HEADER:
+        isBlocked = !stageInput(io_psDecoder, i_pInput, i_inputSize,
+                                &inputPosition, HUFFMAN_BLOCK_HEADER_SIZE);
+        if (isBlocked) {
+          break;
+        }
+        startStreamBlock(io_psDecoder, io_psDecoder->containerPosition +
+                                           inputPosition -
+                                           HUFFMAN_BLOCK_HEADER_SIZE);
+        io_psDecoder->stagingSize = 0;
+        break;
+
+      case STREAM_STATE_CODE_LENGTHS:
+        isBlocked = !stageInput(io_psDecoder, i_pInput, i_inputSize,
+                                &inputPosition, HUFFMAN_CODE_LENGTHS_SIZE);
+        if (isBlocked) {
+          break;
+        }
+        if (loadStreamTables(io_psDecoder) == EXIT_FAILURE) {
+          failStream(io_psDecoder, "Invalid code lengths in block");
+          break;
+        }
+        io_psDecoder->stagingSize = 0;
+        io_psDecoder->eState = io_psDecoder->hasSyncPoints
+                                   ? STREAM_STATE_SYNC_COUNT
+                                   : STREAM_STATE_CODED;
+        break;
+
+      case STREAM_STATE_SYNC_COUNT:
+        isBlocked = !stageInput(io_psDecoder, i_pInput, i_inputSize,
+                                &inputPosition, 4);
+        if (isBlocked) {
+          break;
+        }
+        /* Decoding from the start of the block needs no sync points. */
+        io_psDecoder->syncPointsRemaining =
+            (uint64_t)loadLittleEndian32(io_psDecoder->aStaging) *
+            HUFFMAN_SYNC_POINT_SIZE;
+        io_psDecoder->stagingSize = 0;
+        io_psDecoder->eState = STREAM_STATE_SYNC_POINTS;
+        break;
+
+      case STREAM_STATE_SYNC_POINTS: {
+        uint64_t count = i_inputSize - inputPosition;
+        count = (count < io_psDecoder->syncPointsRemaining)
+                    ? count
+                    : io_psDecoder->syncPointsRemaining;
+        inputPosition += (size_t)count;
+        io_psDecoder->syncPointsRemaining -= count;
+        if (io_psDecoder->syncPointsRemaining == 0) {
+          io_psDecoder->eState = STREAM_STATE_CODED;
+        } else {
+          isBlocked = true;
+        }
+        break;
+      }
+
+      case STREAM_STATE_CODED: {
+        const size_t outputStart = outputPosition;
+        const eHuffmanStreamStatus_t eStatus = decodeStreamPayload(
+            io_psDecoder, i_pInput, i_inputSize, &inputPosition, o_pOutput,
+            i_outputCapacity, &outputPosition);
+        if (io_psDecoder->hasChecksum) {
+          io_psDecoder->checksum =
+              updateCrc32c(io_psDecoder->checksum, &o_pOutput[outputStart],
+                           outputPosition - outputStart);
+        }
+        isBlocked = (eStatus == HUFFMAN_STREAM_CONTINUE);
+        if (eStatus == HUFFMAN_STREAM_END) {
+          HUFFMAN_STATS_ADD(blocksDecoded, 1);
+          io_psDecoder->eState = STREAM_STATE_PADDING;
+        }
+        break;
+      }
+
+      case STREAM_STATE_STORED: {
+        size_t count = i_inputSize - inputPosition;
+        const size_t space = i_outputCapacity - outputPosition;
+        count = (count < space) ? count : space;
+        count = (count < io_psDecoder->payloadRemaining)
+                    ? count
+                    : io_psDecoder->payloadRemaining;
+        if (count > 0) {
+          (void)memcpy(&o_pOutput[outputPosition], &i_pInput[inputPosition],
+                       count);
+          if (io_psDecoder->hasChecksum) {
+            io_psDecoder->checksum = updateCrc32c(
+                io_psDecoder->checksum, &o_pOutput[outputPosition], count);
+          }
+        }
+        inputPosition += count;
+        outputPosition += count;
+        io_psDecoder->payloadRemaining -= count;
+        if (io_psDecoder->payloadRemaining == 0) {
+          HUFFMAN_STATS_ADD(blocksDecoded, 1);
+          io_psDecoder->eState = io_psDecoder->hasChecksum
+                                     ? STREAM_STATE_CHECKSUM
+                                     : STREAM_STATE_BLOCK_SIZE;
+        } else {
+          isBlocked = true;
+        }
+        break;
+      }
+
+      case STREAM_STATE_PADDING: {
+        size_t count = i_inputSize - inputPosition;
+        count = (count < io_psDecoder->payloadRemaining)
+                    ? count
+                    : io_psDecoder->payloadRemaining;
+        inputPosition += count;
+        io_psDecoder->payloadRemaining -= count;
+        if (io_psDecoder->payloadRemaining == 0) {
+          io_psDecoder->eState = io_psDecoder->hasChecksum
+                                     ? STREAM_STATE_CHECKSUM
+                                     : STREAM_STATE_BLOCK_SIZE;
+        } else {
+          isBlocked = true;
+        }
+        break;
+      }
+
+      case STREAM_STATE_CHECKSUM:
+        isBlocked = !stageInput(io_psDecoder, i_pInput, i_inputSize,
+                                &inputPosition, HUFFMAN_CHECKSUM_SIZE);
+        if (isBlocked) {
+          break;
+        }
+        if (loadLittleEndian32(io_psDecoder->aStaging) !=
+            io_psDecoder->checksum) {
+          failStream(io_psDecoder, "Block checksum mismatch");
+          break;
+        }
+        io_psDecoder->stagingSize = 0;
+        io_psDecoder->eState = STREAM_STATE_BLOCK_SIZE;
+        break;
+
+      case STREAM_STATE_INDEX:
+        if (io_psDecoder->indexRemaining == 0) {
+          if (io_psDecoder->indexHash != io_psDecoder->blockOffsetHash) {
+            failStream(io_psDecoder, "Block index does not match blocks");
+            break;
+          }
+          io_psDecoder->eState = STREAM_STATE_TRAILER;
+          break;
+        }
+        isBlocked = !stageInput(io_psDecoder, i_pInput, i_inputSize,
+                                &inputPosition, INDEX_ENTRY_SIZE);
+        if (isBlocked) {
+          break;
+        }
+        io_psDecoder->indexHash =
+            mixHash(io_psDecoder->indexHash,
+                    loadLittleEndian64(io_psDecoder->aStaging));
+        io_psDecoder->indexRemaining--;
+        io_psDecoder->stagingSize = 0;
+        break;
+
+      case STREAM_STATE_TRAILER:
+        isBlocked = !stageInput(io_psDecoder, i_pInput, i_inputSize,
+                                &inputPosition, HUFFMAN_TRAILER_SIZE);
+        if (isBlocked) {
+          break;
+        }
+        finishStream(io_psDecoder);
+        io_psDecoder->stagingSize = 0;
+        break;
+
+      default:
+        break;
+    }
+  }
+
+  io_psDecoder->containerPosition += inputPosition;
+  *o_pInputConsumed = inputPosition;
+  *o_pOutputSize = outputPosition;
+
+  if (io_psDecoder->eState == STREAM_STATE_ERROR) {
+    return HUFFMAN_STREAM_ERROR;
+  }
+  return (io_psDecoder->eState == STREAM_STATE_END) ? HUFFMAN_STREAM_END
+                                                    : HUFFMAN_STREAM_CONTINUE;
+}
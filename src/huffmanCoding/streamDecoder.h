@@ -0,0 +1,105 @@
+/**
+ * @file streamDecoder.h
+ * @brief Decompress Huffman containers incrementally in bounded memory.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ * A stream decoder accepts a container from codec.h in chunks of any size
+ * and writes the decoded bytes straight into the caller's output window. Its
+ * working memory is a single fixed-size allocation holding the decode tables
+ * and the bit buffer, so it does not grow with the size of the container or
+ * its blocks. Decoding resumes from where it stopped, including part way
+ * through a code or a header, whenever more input or output is supplied.
+ * Block checksums are updated as each window is written and checked when
+ * the block ends.
+ */
+
+#ifndef STREAM_DECODER_H
+#define STREAM_DECODER_H
+
+/* Standard Library Includes */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Project Includes */
+
+#include "huffmanCoding/allocator.h"
+
+/* Type Definitions */
+
+/**
+ * @brief The result of a call to decompressStream.
+ */
+typedef enum eHuffmanStreamStatus {
+  HUFFMAN_STREAM_ERROR = -1, /**< The container is malformed. */
+  HUFFMAN_STREAM_CONTINUE,   /**< More input or output space is needed. */
+  HUFFMAN_STREAM_END         /**< The whole container has been decoded. */
+} eHuffmanStreamStatus_t;
+
+/**
+ * @brief Opaque, incremental container decoder.
+ *
+ * A stream decoder must not be used by more than one thread at a time.
+ */
+typedef struct sHuffmanStreamDecoder sHuffmanStreamDecoder_t;
+
+/* Function Prototypes */
+
+/**
+ * @brief Find the working memory of a stream decoder.
+ *
+ * @return size_t The number of bytes createStreamDecoder allocates, which is
+ * all the memory a stream decoder ever uses.
+ */
+extern size_t getStreamDecoderSize(void);
+
+/**
+ * @brief Create a stream decoder, ready for the start of a container.
+ *
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ * @return sHuffmanStreamDecoder_t* The stream decoder, else NULL.
+ */
+extern sHuffmanStreamDecoder_t* createStreamDecoder(
+    const sHuffmanAllocator_t* i_psAllocator);
+
+/**
+ * @brief Free a stream decoder created by createStreamDecoder.
+ *
+ * @param[inout] io_psDecoder The stream decoder to free, or NULL.
+ */
+extern void freeStreamDecoder(sHuffmanStreamDecoder_t* io_psDecoder);
+
+/**
+ * @brief Prepare a stream decoder for the start of a new container.
+ *
+ * @param[inout] io_psDecoder The stream decoder to reset.
+ */
+extern void resetStreamDecoder(sHuffmanStreamDecoder_t* io_psDecoder);
+
+/**
+ * @brief Decode as much of a container as the input and output allow.
+ *
+ * This function consumes input until it runs out, the output is full or the
+ * container ends. Input that has been consumed is held by the decoder, so
+ * the next call continues with the input that follows it. It returns
+ * HUFFMAN_STREAM_CONTINUE until the trailer has been validated, after which
+ * it returns HUFFMAN_STREAM_END and consumes no more input. Once it has
+ * returned HUFFMAN_STREAM_ERROR the decoder must be reset.
+ *
+ * @param[inout] io_psDecoder The stream decoder.
+ * @param[in] i_pInput The next chunk of the container.
+ * @param[in] i_inputSize The number of bytes in the chunk.
+ * @param[out] o_pInputConsumed The number of bytes consumed from the chunk.
+ * @param[out] o_pOutput The output window to write decoded bytes to.
+ * @param[in] i_outputCapacity The number of bytes available in the window.
+ * @param[out] o_pOutputSize The number of bytes written to the window.
+ * @return eHuffmanStreamStatus_t The status of the stream.
+ */
+extern eHuffmanStreamStatus_t decompressStream(
+    sHuffmanStreamDecoder_t* io_psDecoder, const uint8_t* i_pInput,
+    size_t i_inputSize, size_t* o_pInputConsumed, uint8_t* o_pOutput,
+    size_t i_outputCapacity, size_t* o_pOutputSize);
+
+#endif  // STREAM_DECODER_H
@@ -12,6 +12,7 @@
 
 /* Project Imports */
 
+#include "huffmanCoding/stats.h"
 #include "huffmanCoding/task2.h"
 
 /* Type Definitons */
@@ -35,6 +36,8 @@ typedef FILE *pFile_t;
  * EXIT_SUCCESS
  */
 int readTextFile(const char *i_filePath, char *o_dest) {
+  HUFFMAN_STATS_BEGIN_STAGE(HUFFMAN_STAGE_READ);
+
   // Check if the file could not be opened
   pFile_t pFile = fopen(i_filePath, "r");
   if (pFile == NULL) {
@@ -55,5 +58,6 @@ int readTextFile(const char *i_filePath, char *o_dest) {
 
   (void)fclose(pFile);
 
+  HUFFMAN_STATS_END_STAGE(HUFFMAN_STAGE_READ, bytesRead);
   return EXIT_SUCCESS;
 }
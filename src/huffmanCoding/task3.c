@@ -14,6 +14,7 @@
 
 /* Project Includes */
 
+#include "huffmanCoding/allocator.h"
 #include "huffmanCoding/task3.h"
 
 /* Function Definitons */
@@ -35,13 +36,32 @@
  */
 int appendLetterFrequencyPair(const char i_character, size_t i_frequency,
                               sLetterFrequencyNode_t** io_psHead) {
+  return appendLetterFrequencyPairWithAllocator(i_character, i_frequency,
+                                                io_psHead, NULL);
+}
+
+/**
+ * @brief Append a new letter-frequency pair to a linked list, allocating the
+ * node with the given allocator.
+ *
+ * @param[in] i_character The letter-frequency pair character value.
+ * @param[in] i_frequency The letter-frequency pair frequency value.
+ * @param[inout] io_psHead The pointer to the pointer to the head of the list.
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ * @return int EXIT_SUCCESS if the node was added successfully, else
+ * EXIT_FAILURE.
+ */
+int appendLetterFrequencyPairWithAllocator(
+    const char i_character, size_t i_frequency,
+    sLetterFrequencyNode_t** io_psHead,
+    const sHuffmanAllocator_t* i_psAllocator) {
   /* Allocate memory for the new node. */
   sLetterFrequencyNode_t* psLetterFrequencyNode =
-      (sLetterFrequencyNode_t*)malloc(sizeof(sLetterFrequencyNode_t));
+      (sLetterFrequencyNode_t*)allocateHuffmanMemory(
+          i_psAllocator, sizeof(sLetterFrequencyNode_t));
 
   if (psLetterFrequencyNode == NULL) {
     perror("ERROR");
-    free(psLetterFrequencyNode);
     return EXIT_FAILURE;
   }
 
@@ -76,12 +96,25 @@ int appendLetterFrequencyPair(const char i_character, size_t i_frequency,
  * @param[inout] io_psHead The pointer to the pointer to the head of the list.
  */
 void freeLetterFrequencyPairList(sLetterFrequencyNode_t** io_psHead) {
+  freeLetterFrequencyPairListWithAllocator(io_psHead, NULL);
+}
+
+/**
+ * @brief Free a letter-frequency pair linked list allocated with the given
+ * allocator.
+ *
+ * @param[inout] io_psHead The pointer to the pointer to the head of the list.
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ */
+void freeLetterFrequencyPairListWithAllocator(
+    sLetterFrequencyNode_t** io_psHead,
+    const sHuffmanAllocator_t* i_psAllocator) {
   sLetterFrequencyNode_t* psCurrent = *io_psHead;
   sLetterFrequencyNode_t* psNext = NULL;
 
   while (psCurrent != NULL) {
     psNext = psCurrent->psNext;
-    free(psCurrent);
+    freeHuffmanMemory(i_psAllocator, psCurrent);
     psCurrent = psNext;
   }
 
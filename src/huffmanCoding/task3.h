@@ -13,6 +13,10 @@
 
 #include <stddef.h>
 
+/* Project Includes */
+
+#include "huffmanCoding/allocator.h"
+
 /* Type Definitions */
 
 /**
@@ -52,6 +56,21 @@ typedef struct sLetterFrequencyNode {
 extern int appendLetterFrequencyPair(char i_character, size_t i_frequency,
                                      sLetterFrequencyNode_t** io_psHead);
 
+/**
+ * @brief Append a new letter-frequency pair to a linked list, allocating the
+ * node with the given allocator.
+ *
+ * @param[in] i_character The letter-frequency pair character value.
+ * @param[in] i_frequency The letter-frequency pair frequency value.
+ * @param[inout] io_psHead The pointer to the pointer to the head of the list.
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ * @return int EXIT_SUCCESS if the node was added successfully, else
+ * EXIT_FAILURE.
+ */
+extern int appendLetterFrequencyPairWithAllocator(
+    char i_character, size_t i_frequency, sLetterFrequencyNode_t** io_psHead,
+    const sHuffmanAllocator_t* i_psAllocator);
+
 /**
  * @brief Free the allocated memory of a letter-frequency pair linked list.
  *
@@ -64,4 +83,15 @@ extern int appendLetterFrequencyPair(char i_character, size_t i_frequency,
  */
 extern void freeLetterFrequencyPairList(sLetterFrequencyNode_t** io_psHead);
 
+/**
+ * @brief Free a letter-frequency pair linked list allocated with the given
+ * allocator.
+ *
+ * @param[inout] io_psHead The pointer to the pointer to the head of the list.
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ */
+extern void freeLetterFrequencyPairListWithAllocator(
+    sLetterFrequencyNode_t** io_psHead,
+    const sHuffmanAllocator_t* i_psAllocator);
+
 #endif /* TASK3_H */
@@ -11,10 +11,13 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
 /* Project Includes */
 
+#include "huffmanCoding/allocator.h"
 #include "huffmanCoding/task3.h"
 #include "huffmanCoding/task4.h"
 
@@ -112,6 +115,23 @@ bool characterFrequencyNodeExists(const char i_character,
  */
 int createLetterFrequencyListFromText(sLetterFrequencyNode_t** io_psHead,
                                       const char* i_text) {
+  return createLetterFrequencyListFromTextWithAllocator(io_psHead, i_text,
+                                                        NULL);
+}
+
+/**
+ * @brief Create a letter-frequency linked list from the given text, allocating
+ * the nodes with the given allocator.
+ *
+ * @param[inout] io_psHead The pointer to the pointer to the head of the list.
+ * @param[in] i_text The text to create the linked list from.
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ * @return int EXIT_SUCCESS if the list was created successfully, else
+ * EXIT_FAILURE.
+ */
+int createLetterFrequencyListFromTextWithAllocator(
+    sLetterFrequencyNode_t** io_psHead, const char* i_text,
+    const sHuffmanAllocator_t* i_psAllocator) {
   for (size_t i = 0; i_text[i] != '\0'; i++) {
     char character = i_text[i];
     if (characterFrequencyNodeExists(character, *io_psHead)) {
@@ -119,9 +139,82 @@ int createLetterFrequencyListFromText(sLetterFrequencyNode_t** io_psHead,
     }
 
     size_t frequency = countCharacterFrequency(character, i_text);
-    if (appendLetterFrequencyPair(character, frequency, io_psHead) ==
+    if (appendLetterFrequencyPairWithAllocator(character, frequency, io_psHead,
+                                               i_psAllocator) ==
+        EXIT_FAILURE) {
+      freeLetterFrequencyPairListWithAllocator(io_psHead, i_psAllocator);
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Count the frequency of every byte value in a buffer.
+ *
+ * This function performs a single pass over the buffer and increments the
+ * frequency of each byte value it encounters. Unlike
+ * createLetterFrequencyListFromText, the buffer may contain NULL bytes.
+ *
+ * @param[in] i_pData The buffer to count the byte frequencies of.
+ * @param[in] i_size The number of bytes in the buffer.
+ * @param[out] o_aFrequencies The frequency of each byte value.
+ */
+void countByteFrequencies(
+    const uint8_t* i_pData, size_t i_size,
+    size_t o_aFrequencies[LETTER_FREQUENCY_ALPHABET_SIZE]) {
+  (void)memset(o_aFrequencies, 0,
+               LETTER_FREQUENCY_ALPHABET_SIZE * sizeof(size_t));
+
+  for (size_t i = 0; i < i_size; i++) {
+    o_aFrequencies[i_pData[i]]++;
+  }
+}
+
+/**
+ * @brief Create a letter-frequency linked list from a table of frequencies.
+ *
+ * This function appends a letter-frequency pair for every byte value with a
+ * non-zero frequency, in ascending byte order. If an error occurs allocating
+ * the memory for a new node, then the list is freed and it returns
+ * EXIT_FAILURE.
+ *
+ * @param[inout] io_psHead The pointer to the pointer to the head of the list.
+ * @param[in] i_aFrequencies The frequency of each byte value.
+ * @return int EXIT_SUCCESS if the list was created successfully, else
+ * EXIT_FAILURE.
+ */
+int createLetterFrequencyListFromFrequencies(
+    sLetterFrequencyNode_t** io_psHead,
+    const size_t i_aFrequencies[LETTER_FREQUENCY_ALPHABET_SIZE]) {
+  return createLetterFrequencyListFromFrequenciesWithAllocator(
+      io_psHead, i_aFrequencies, NULL);
+}
+
+/**
+ * @brief Create a letter-frequency linked list from a table of frequencies,
+ * allocating the nodes with the given allocator.
+ *
+ * @param[inout] io_psHead The pointer to the pointer to the head of the list.
+ * @param[in] i_aFrequencies The frequency of each byte value.
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ * @return int EXIT_SUCCESS if the list was created successfully, else
+ * EXIT_FAILURE.
+ */
+int createLetterFrequencyListFromFrequenciesWithAllocator(
+    sLetterFrequencyNode_t** io_psHead,
+    const size_t i_aFrequencies[LETTER_FREQUENCY_ALPHABET_SIZE],
+    const sHuffmanAllocator_t* i_psAllocator) {
+  for (size_t symbol = 0; symbol < LETTER_FREQUENCY_ALPHABET_SIZE; symbol++) {
+    if (i_aFrequencies[symbol] == 0) {
+      continue;
+    }
+
+    if (appendLetterFrequencyPairWithAllocator(
+            (char)symbol, i_aFrequencies[symbol], io_psHead, i_psAllocator) ==
         EXIT_FAILURE) {
-      freeLetterFrequencyPairList(io_psHead);
+      freeLetterFrequencyPairListWithAllocator(io_psHead, i_psAllocator);
       return EXIT_FAILURE;
     }
   }
@@ -10,10 +10,21 @@
 #ifndef TASK4_H
 #define TASK4_H
 
+/* Standard Library Includes */
+
+#include <stddef.h>
+#include <stdint.h>
+
 /* Project Includes */
 
+#include "huffmanCoding/allocator.h"
 #include "huffmanCoding/task3.h"
 
+/* Constants */
+
+/**< The number of distinct byte values a letter can take. */
+#define LETTER_FREQUENCY_ALPHABET_SIZE 256
+
 /* Function Prototypes */
 
 /**
@@ -32,4 +43,65 @@
 extern int createLetterFrequencyListFromText(sLetterFrequencyNode_t** io_psHead,
                                              const char* i_text);
 
+/**
+ * @brief Create a letter-frequency linked list from the given text, allocating
+ * the nodes with the given allocator.
+ *
+ * @param[inout] io_psHead The pointer to the pointer to the head of the list.
+ * @param[in] i_text The text to create the linked list from.
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ * @return int EXIT_SUCCESS if the list was created successfully, else
+ * EXIT_FAILURE.
+ */
+extern int createLetterFrequencyListFromTextWithAllocator(
+    sLetterFrequencyNode_t** io_psHead, const char* i_text,
+    const sHuffmanAllocator_t* i_psAllocator);
+
+/**
+ * @brief Count the frequency of every byte value in a buffer.
+ *
+ * This function performs a single pass over the buffer and increments the
+ * frequency of each byte value it encounters. Unlike
+ * createLetterFrequencyListFromText, the buffer may contain NULL bytes.
+ *
+ * @param[in] i_pData The buffer to count the byte frequencies of.
+ * @param[in] i_size The number of bytes in the buffer.
+ * @param[out] o_aFrequencies The frequency of each byte value.
+ */
+extern void countByteFrequencies(
+    const uint8_t* i_pData, size_t i_size,
+    size_t o_aFrequencies[LETTER_FREQUENCY_ALPHABET_SIZE]);
+
+/**
+ * @brief Create a letter-frequency linked list from a table of frequencies.
+ *
+ * This function appends a letter-frequency pair for every byte value with a
+ * non-zero frequency, in ascending byte order. If an error occurs allocating
+ * the memory for a new node, then the list is freed and it returns
+ * EXIT_FAILURE.
+ *
+ * @param[inout] io_psHead The pointer to the pointer to the head of the list.
+ * @param[in] i_aFrequencies The frequency of each byte value.
+ * @return int EXIT_SUCCESS if the list was created successfully, else
+ * EXIT_FAILURE.
+ */
+extern int createLetterFrequencyListFromFrequencies(
+    sLetterFrequencyNode_t** io_psHead,
+    const size_t i_aFrequencies[LETTER_FREQUENCY_ALPHABET_SIZE]);
+
+/**
+ * @brief Create a letter-frequency linked list from a table of frequencies,
+ * allocating the nodes with the given allocator.
+ *
+ * @param[inout] io_psHead The pointer to the pointer to the head of the list.
+ * @param[in] i_aFrequencies The frequency of each byte value.
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ * @return int EXIT_SUCCESS if the list was created successfully, else
+ * EXIT_FAILURE.
+ */
+extern int createLetterFrequencyListFromFrequenciesWithAllocator(
+    sLetterFrequencyNode_t** io_psHead,
+    const size_t i_aFrequencies[LETTER_FREQUENCY_ALPHABET_SIZE],
+    const sHuffmanAllocator_t* i_psAllocator);
+
 #endif  // TASK4_H
@@ -13,6 +13,7 @@
 
 /* Project Includes */
 
+#include "huffmanCoding/allocator.h"
 #include "huffmanCoding/task3.h"
 #include "huffmanCoding/task5.h"
 
@@ -33,9 +34,24 @@
  */
 sBinaryTreeNode_t *mergeBinaryTreeNodes(sBinaryTreeNode_t *i_psLeftChild,
                                         sBinaryTreeNode_t *i_psRightChild) {
+  return mergeBinaryTreeNodesWithAllocator(i_psLeftChild, i_psRightChild, NULL);
+}
+
+/**
+ * @brief Merge two binary tree nodes together, allocating the merged node with
+ * the given allocator.
+ *
+ * @param[in] i_psLeftChild Pointer to the merged node left child.
+ * @param[in] i_psRightChild Pointer to the merged node right child.
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ * @return sBinaryTreeNode_t* Pointer to the merged parent node.
+ */
+sBinaryTreeNode_t *mergeBinaryTreeNodesWithAllocator(
+    sBinaryTreeNode_t *i_psLeftChild, sBinaryTreeNode_t *i_psRightChild,
+    const sHuffmanAllocator_t *i_psAllocator) {
   /* Allocate memory for the merged binary tree node. */
-  sBinaryTreeNode_t *psParent =
-      (sBinaryTreeNode_t *)malloc(sizeof(sBinaryTreeNode_t));
+  sBinaryTreeNode_t *psParent = (sBinaryTreeNode_t *)allocateHuffmanMemory(
+      i_psAllocator, sizeof(sBinaryTreeNode_t));
   if (psParent == NULL) {
     perror("ERROR");
     return NULL;
@@ -43,13 +59,15 @@ sBinaryTreeNode_t *mergeBinaryTreeNodes(sBinaryTreeNode_t *i_psLeftChild,
 
   /* Allocate memory for merged binary tree node's letter-frequency pair. */
   psParent->psLetterFrequencyPair =
-      (sLetterFrequencyPair_t *)malloc(sizeof(sLetterFrequencyPair_t));
+      (sLetterFrequencyPair_t *)allocateHuffmanMemory(
+          i_psAllocator, sizeof(sLetterFrequencyPair_t));
   if (psParent->psLetterFrequencyPair == NULL) {
     perror("ERROR");
-    free(psParent);
+    freeHuffmanMemory(i_psAllocator, psParent);
     return NULL;
   }
 
+  psParent->psLetterFrequencyPair->character = '\0';
   psParent->psLetterFrequencyPair->frequency =
       i_psLeftChild->psLetterFrequencyPair->frequency +
       i_psRightChild->psLetterFrequencyPair->frequency;
@@ -70,18 +88,27 @@ sBinaryTreeNode_t *mergeBinaryTreeNodes(sBinaryTreeNode_t *i_psLeftChild,
  * @param[inout] io_psRoot The pointer to the binary tree root node.
  */
 void freeBinaryTree(sBinaryTreeNode_t *io_psRoot) {
+  freeBinaryTreeWithAllocator(io_psRoot, NULL);
+}
+
+/**
+ * @brief Free the memory of a binary tree allocated with the given allocator.
+ *
+ * @param[inout] io_psRoot The pointer to the binary tree root node.
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ */
+void freeBinaryTreeWithAllocator(sBinaryTreeNode_t *io_psRoot,
+                                 const sHuffmanAllocator_t *i_psAllocator) {
   if (io_psRoot == NULL) {
     return;
   }
 
   /* Recursively free the left and right child nodes. */
-  freeBinaryTree(io_psRoot->psLeftChild);
-  freeBinaryTree(io_psRoot->psRightChild);
+  freeBinaryTreeWithAllocator(io_psRoot->psLeftChild, i_psAllocator);
+  freeBinaryTreeWithAllocator(io_psRoot->psRightChild, i_psAllocator);
 
-  if (io_psRoot->psLetterFrequencyPair != NULL) {
-    free(io_psRoot->psLetterFrequencyPair);
-  }
+  freeHuffmanMemory(i_psAllocator, io_psRoot->psLetterFrequencyPair);
 
   /* Free the final root node. */
-  free(io_psRoot);
+  freeHuffmanMemory(i_psAllocator, io_psRoot);
 }
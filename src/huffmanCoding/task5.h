@@ -12,6 +12,7 @@
 
 /* Project Includes */
 
+#include "huffmanCoding/allocator.h"
 #include "huffmanCoding/task3.h"
 
 /* Type Defintions */
@@ -44,6 +45,19 @@ typedef struct sBinaryTreeNode {
 extern sBinaryTreeNode_t* mergeBinaryTreeNodes(
     sBinaryTreeNode_t* i_psLeftChild, sBinaryTreeNode_t* i_psRightChild);
 
+/**
+ * @brief Merge two binary tree nodes together, allocating the merged node with
+ * the given allocator.
+ *
+ * @param[in] i_psLeftChild Pointer to the merged node left child.
+ * @param[in] i_psRightChild Pointer to the merged node right child.
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ * @return sBinaryTreeNode_t* Pointer to the merged parent node.
+ */
+extern sBinaryTreeNode_t* mergeBinaryTreeNodesWithAllocator(
+    sBinaryTreeNode_t* i_psLeftChild, sBinaryTreeNode_t* i_psRightChild,
+    const sHuffmanAllocator_t* i_psAllocator);
+
 /**
  * @brief Free the memory of a binary tree.
  *
@@ -54,4 +68,13 @@ extern sBinaryTreeNode_t* mergeBinaryTreeNodes(
  */
 extern void freeBinaryTree(sBinaryTreeNode_t* io_psRoot);
 
+/**
+ * @brief Free the memory of a binary tree allocated with the given allocator.
+ *
+ * @param[inout] io_psRoot The pointer to the binary tree root node.
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ */
+extern void freeBinaryTreeWithAllocator(
+    sBinaryTreeNode_t* io_psRoot, const sHuffmanAllocator_t* i_psAllocator);
+
 #endif  // TASK5_H
@@ -14,6 +14,7 @@
 
 /* Project Includes */
 
+#include "huffmanCoding/allocator.h"
 #include "huffmanCoding/task3.h"
 #include "huffmanCoding/task5.h"
 #include "huffmanCoding/task6.h"
@@ -32,12 +33,14 @@
  * @param[inout] io_psHead The pointer to the pointer to the head of the list.
  * @param[in] i_psLetterFrequencyNode The pointer to the letter-frequency pair
  * to assign to the new node.
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
  * @return int EXIT_SUCCESS if the node was added successfully, else
  * EXIT_FAILURE
  */
 static int appendBinaryTreeNode(
     sBinaryTreeListNode_t** io_psHead,
-    sLetterFrequencyNode_t* i_psLetterFrequencyNode);
+    sLetterFrequencyNode_t* i_psLetterFrequencyNode,
+    const sHuffmanAllocator_t* i_psAllocator);
 
 /* Function Defintions */
 
@@ -53,12 +56,14 @@ static int appendBinaryTreeNode(
  * @param[inout] io_psHead The pointer to the pointer to the head of the list.
  * @param[in] i_psLetterFrequencyNode The pointer to the letter-frequency pair
  * to assign to the new node.
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
  * @return int EXIT_SUCCESS if the node was added successfully, else
  * EXIT_FAILURE
  */
 static int appendBinaryTreeNode(
     sBinaryTreeListNode_t** io_psHead,
-    sLetterFrequencyNode_t* i_psLetterFrequencyNode) {
+    sLetterFrequencyNode_t* i_psLetterFrequencyNode,
+    const sHuffmanAllocator_t* i_psAllocator) {
   if (io_psHead == NULL) {
     perror("ERROR: Head pointer is NULL");
     return EXIT_FAILURE;
@@ -69,38 +74,25 @@ static int appendBinaryTreeNode(
     return EXIT_FAILURE;
   }
 
-  /* Allocate the memory for the binary tree list node */
-  sBinaryTreeListNode_t* psBinaryTreeListNode =
-      (sBinaryTreeListNode_t*)malloc(sizeof(sBinaryTreeListNode_t));
-  if (psBinaryTreeListNode == NULL) {
-    perror("ERROR: Failed to allocate memory for binary tree list node");
-    return EXIT_FAILURE;
-  }
-
-  /* Assign the binary tree node letter-frequency pair. */
-  psBinaryTreeListNode->psBinaryTreeNode =
-      (sBinaryTreeNode_t*)malloc(sizeof(sBinaryTreeNode_t));
-  if (psBinaryTreeListNode->psBinaryTreeNode == NULL) {
+  /* Allocate the memory for the binary tree node. */
+  sBinaryTreeNode_t* psBinaryTreeNode =
+      (sBinaryTreeNode_t*)allocateHuffmanMemory(i_psAllocator,
+                                                sizeof(sBinaryTreeNode_t));
+  if (psBinaryTreeNode == NULL) {
     perror("ERROR: Failed to allocate memory for binary tree node");
-    free(psBinaryTreeListNode);
     return EXIT_FAILURE;
   }
 
   /* Assign the binary tree node values */
-  psBinaryTreeListNode->psNext = NULL;
-  psBinaryTreeListNode->psBinaryTreeNode->psLetterFrequencyPair =
+  psBinaryTreeNode->psLetterFrequencyPair =
       &i_psLetterFrequencyNode->sLetterFrequencyPair;
+  psBinaryTreeNode->psLeftChild = NULL;
+  psBinaryTreeNode->psRightChild = NULL;
 
-  if (*io_psHead == NULL) {
-    /* Make the new binary tree node the head if the list is empty. */
-    *io_psHead = psBinaryTreeListNode;
-  } else {
-    /* Append the new binary tree node to the end of the list. */
-    sBinaryTreeListNode_t* psCurrent = *io_psHead;
-    while (psCurrent->psNext != NULL) {
-      psCurrent = psCurrent->psNext;
-    }
-    psCurrent->psNext = psBinaryTreeListNode;
+  if (pushBinaryTreeNodeWithAllocator(io_psHead, psBinaryTreeNode,
+                                      i_psAllocator) == EXIT_FAILURE) {
+    freeHuffmanMemory(i_psAllocator, psBinaryTreeNode);
+    return EXIT_FAILURE;
   }
 
   return EXIT_SUCCESS;
@@ -113,7 +105,7 @@ static int appendBinaryTreeNode(
  * This function iterates through the provided letter-frequency pair linked
  * list, creates a new binary tree node with the pair, and appends the new
  * binary tree node list. If any errors occur, creating the new node or adding
- * it to the list, then it returns EXIT_FAILURE.
+ * it to the list, then both lists are freed and it returns EXIT_FAILURE.
  *
  * @param[inout] io_psHead The pointer to the pointer to the head of the list.
  * @param[in] i_psLetterFrequencyPairHead The pointer to the head of the
@@ -124,6 +116,25 @@ static int appendBinaryTreeNode(
 extern int createBinaryTreeNodeListFromLetterFrequencyPairList(
     sBinaryTreeListNode_t** io_psHead,
     sLetterFrequencyNode_t* i_psLetterFrequencyPairHead) {
+  return createBinaryTreeNodeListFromLetterFrequencyPairListWithAllocator(
+      io_psHead, i_psLetterFrequencyPairHead, NULL);
+}
+
+/**
+ * @brief Create a binary tree node linked list from a letter-frequency pair
+ * list, allocating the nodes with the given allocator.
+ *
+ * @param[inout] io_psHead The pointer to the pointer to the head of the list.
+ * @param[in] i_psLetterFrequencyPairHead The pointer to the head of the
+ * letter-frequency pair list.
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ * @return int EXIT_SUCCESS if the list was created successfully, else
+ * EXIT_FAILURE.
+ */
+int createBinaryTreeNodeListFromLetterFrequencyPairListWithAllocator(
+    sBinaryTreeListNode_t** io_psHead,
+    sLetterFrequencyNode_t* i_psLetterFrequencyPairHead,
+    const sHuffmanAllocator_t* i_psAllocator) {
   if (i_psLetterFrequencyPairHead == NULL) {
     perror("ERROR: Letter-frequency list head is NULL");
     return EXIT_FAILURE;
@@ -134,9 +145,12 @@ extern int createBinaryTreeNodeListFromLetterFrequencyPairList(
 
   while (psCurrent != NULL) {
     psNext = psCurrent->psNext;
-    if (appendBinaryTreeNode(io_psHead, psCurrent) == EXIT_FAILURE) {
+    if (appendBinaryTreeNode(io_psHead, psCurrent, i_psAllocator) ==
+        EXIT_FAILURE) {
       perror("ERROR: Unable to add binary tree list node");
-      freeBinaryTreeList(io_psHead);
+      /* Free the pairs the list has not yet taken ownership of. */
+      freeLetterFrequencyPairListWithAllocator(&psCurrent, i_psAllocator);
+      freeBinaryTreeListWithAllocator(io_psHead, i_psAllocator);
       return EXIT_FAILURE;
     }
     psCurrent = psNext;
@@ -145,6 +159,70 @@ extern int createBinaryTreeNodeListFromLetterFrequencyPairList(
   return EXIT_SUCCESS;
 }
 
+/**
+ * @brief Push an existing binary tree node onto a binary tree node linked
+ * list.
+ *
+ * This function appends a new list node that refers to the given binary tree
+ * node, e.g. a node returned by mergeBinaryTreeNodes. The list takes ownership
+ * of the binary tree node. If unable to allocate the memory for the new list
+ * node, then it returns EXIT_FAILURE and ownership stays with the caller.
+ *
+ * @param[inout] io_psHead The pointer to the pointer to the head of the list.
+ * @param[in] i_psBinaryTreeNode The binary tree node to add to the list.
+ * @return int EXIT_SUCCESS if the node was added successfully, else
+ * EXIT_FAILURE.
+ */
+int pushBinaryTreeNode(sBinaryTreeListNode_t** io_psHead,
+                       sBinaryTreeNode_t* i_psBinaryTreeNode) {
+  return pushBinaryTreeNodeWithAllocator(io_psHead, i_psBinaryTreeNode, NULL);
+}
+
+/**
+ * @brief Push an existing binary tree node onto a binary tree node linked
+ * list, allocating the list node with the given allocator.
+ *
+ * @param[inout] io_psHead The pointer to the pointer to the head of the list.
+ * @param[in] i_psBinaryTreeNode The binary tree node to add to the list.
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ * @return int EXIT_SUCCESS if the node was added successfully, else
+ * EXIT_FAILURE.
+ */
+int pushBinaryTreeNodeWithAllocator(sBinaryTreeListNode_t** io_psHead,
+                                    sBinaryTreeNode_t* i_psBinaryTreeNode,
+                                    const sHuffmanAllocator_t* i_psAllocator) {
+  if (io_psHead == NULL) {
+    perror("ERROR: Head pointer is NULL");
+    return EXIT_FAILURE;
+  }
+
+  /* Allocate the memory for the binary tree list node */
+  sBinaryTreeListNode_t* psBinaryTreeListNode =
+      (sBinaryTreeListNode_t*)allocateHuffmanMemory(
+          i_psAllocator, sizeof(sBinaryTreeListNode_t));
+  if (psBinaryTreeListNode == NULL) {
+    perror("ERROR: Failed to allocate memory for binary tree list node");
+    return EXIT_FAILURE;
+  }
+
+  psBinaryTreeListNode->psBinaryTreeNode = i_psBinaryTreeNode;
+  psBinaryTreeListNode->psNext = NULL;
+
+  if (*io_psHead == NULL) {
+    /* Make the new binary tree node the head if the list is empty. */
+    *io_psHead = psBinaryTreeListNode;
+  } else {
+    /* Append the new binary tree node to the end of the list. */
+    sBinaryTreeListNode_t* psCurrent = *io_psHead;
+    while (psCurrent->psNext != NULL) {
+      psCurrent = psCurrent->psNext;
+    }
+    psCurrent->psNext = psBinaryTreeListNode;
+  }
+
+  return EXIT_SUCCESS;
+}
+
 /**
  * @brief Pop the lowest frequency binary tree node from the list.
  *
@@ -158,6 +236,21 @@ extern int createBinaryTreeNodeListFromLetterFrequencyPairList(
  */
 sBinaryTreeNode_t* popLowestFrequencyBinaryTreeNode(
     sBinaryTreeListNode_t** io_psHead) {
+  return popLowestFrequencyBinaryTreeNodeWithAllocator(io_psHead, NULL);
+}
+
+/**
+ * @brief Pop the lowest frequency binary tree node from a list allocated with
+ * the given allocator.
+ *
+ * @param[inout] io_psHead The pointer to the pointer to the head of the list.
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ * @return sBinaryTreeNode_t* The pointer to the binary tree node with the
+ * lowest letter-frequency pair.
+ */
+sBinaryTreeNode_t* popLowestFrequencyBinaryTreeNodeWithAllocator(
+    sBinaryTreeListNode_t** io_psHead,
+    const sHuffmanAllocator_t* i_psAllocator) {
   if (io_psHead == NULL || *io_psHead == NULL) {
     perror("ERROR: Binary tree list head is NULL");
     return NULL;
@@ -188,18 +281,30 @@ sBinaryTreeNode_t* popLowestFrequencyBinaryTreeNode(
   psLowest->psNext = NULL;
 
   sBinaryTreeNode_t* psReturnNode = psLowest->psBinaryTreeNode;
-  free(psLowest);
+  freeHuffmanMemory(i_psAllocator, psLowest);
   return psReturnNode;
 }
 
 extern void freeBinaryTreeList(sBinaryTreeListNode_t** io_psHead) {
+  freeBinaryTreeListWithAllocator(io_psHead, NULL);
+}
+
+/**
+ * @brief Free a binary tree node linked list, and the binary trees it holds,
+ * allocated with the given allocator.
+ *
+ * @param[inout] io_psHead The pointer to the pointer to the head of the list.
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ */
+void freeBinaryTreeListWithAllocator(sBinaryTreeListNode_t** io_psHead,
+                                     const sHuffmanAllocator_t* i_psAllocator) {
   sBinaryTreeListNode_t* psCurrent = *io_psHead;
   sBinaryTreeListNode_t* psNext = NULL;
 
   while (psCurrent != NULL) {
     psNext = psCurrent->psNext;
-    freeBinaryTree(psCurrent->psBinaryTreeNode);
-    free(psCurrent);
+    freeBinaryTreeWithAllocator(psCurrent->psBinaryTreeNode, i_psAllocator);
+    freeHuffmanMemory(i_psAllocator, psCurrent);
     psCurrent = psNext;
   }
 
@@ -12,6 +12,7 @@
 
 /* Project Includes */
 
+#include "huffmanCoding/allocator.h"
 #include "huffmanCoding/task3.h"
 #include "huffmanCoding/task5.h"
 
@@ -35,7 +36,7 @@ typedef struct sBinaryTreeListNode {
  * This function iterates through the provided letter-frequency pair linked
  * list, creates a new binary tree node with the pair, and appends the new
  * binary tree node list. If any errors occur, creating the new node or adding
- * it to the list, then it returns EXIT_FAILURE.
+ * it to the list, then both lists are freed and it returns EXIT_FAILURE.
  *
  * @param[inout] io_psHead The pointer to the pointer to the head of the list.
  * @param[in] i_psLetterFrequencyPairHead The pointer to the head of the
@@ -47,6 +48,53 @@ extern int createBinaryTreeNodeListFromLetterFrequencyPairList(
     sBinaryTreeListNode_t** io_psHead,
     sLetterFrequencyNode_t* i_psLetterFrequencyPairHead);
 
+/**
+ * @brief Create a binary tree node linked list from a letter-frequency pair
+ * list, allocating the nodes with the given allocator.
+ *
+ * @param[inout] io_psHead The pointer to the pointer to the head of the list.
+ * @param[in] i_psLetterFrequencyPairHead The pointer to the head of the
+ * letter-frequency pair list.
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ * @return int EXIT_SUCCESS if the list was created successfully, else
+ * EXIT_FAILURE.
+ */
+extern int createBinaryTreeNodeListFromLetterFrequencyPairListWithAllocator(
+    sBinaryTreeListNode_t** io_psHead,
+    sLetterFrequencyNode_t* i_psLetterFrequencyPairHead,
+    const sHuffmanAllocator_t* i_psAllocator);
+
+/**
+ * @brief Push an existing binary tree node onto a binary tree node linked
+ * list.
+ *
+ * This function appends a new list node that refers to the given binary tree
+ * node, e.g. a node returned by mergeBinaryTreeNodes. The list takes ownership
+ * of the binary tree node. If unable to allocate the memory for the new list
+ * node, then it returns EXIT_FAILURE and ownership stays with the caller.
+ *
+ * @param[inout] io_psHead The pointer to the pointer to the head of the list.
+ * @param[in] i_psBinaryTreeNode The binary tree node to add to the list.
+ * @return int EXIT_SUCCESS if the node was added successfully, else
+ * EXIT_FAILURE.
+ */
+extern int pushBinaryTreeNode(sBinaryTreeListNode_t** io_psHead,
+                              sBinaryTreeNode_t* i_psBinaryTreeNode);
+
+/**
+ * @brief Push an existing binary tree node onto a binary tree node linked
+ * list, allocating the list node with the given allocator.
+ *
+ * @param[inout] io_psHead The pointer to the pointer to the head of the list.
+ * @param[in] i_psBinaryTreeNode The binary tree node to add to the list.
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ * @return int EXIT_SUCCESS if the node was added successfully, else
+ * EXIT_FAILURE.
+ */
+extern int pushBinaryTreeNodeWithAllocator(
+    sBinaryTreeListNode_t** io_psHead, sBinaryTreeNode_t* i_psBinaryTreeNode,
+    const sHuffmanAllocator_t* i_psAllocator);
+
 extern sBinaryTreeNode_t* popLowestFrequencyBinaryTreeNode(
     sBinaryTreeListNode_t** io_psHead);
 /**
@@ -62,4 +110,28 @@ extern sBinaryTreeNode_t* popLowestFrequencyBinaryTreeNode(
  */
 extern void freeBinaryTreeList(sBinaryTreeListNode_t** io_psHead);
 
+/**
+ * @brief Pop the lowest frequency binary tree node from a list allocated with
+ * the given allocator.
+ *
+ * @param[inout] io_psHead The pointer to the pointer to the head of the list.
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ * @return sBinaryTreeNode_t* The pointer to the binary tree node with the
+ * lowest letter-frequency pair.
+ */
+extern sBinaryTreeNode_t* popLowestFrequencyBinaryTreeNodeWithAllocator(
+    sBinaryTreeListNode_t** io_psHead,
+    const sHuffmanAllocator_t* i_psAllocator);
+
+/**
+ * @brief Free a binary tree node linked list, and the binary trees it holds,
+ * allocated with the given allocator.
+ *
+ * @param[inout] io_psHead The pointer to the pointer to the head of the list.
+ * @param[in] i_psAllocator The allocator, or NULL for the default.
+ */
+extern void freeBinaryTreeListWithAllocator(
+    sBinaryTreeListNode_t** io_psHead,
+    const sHuffmanAllocator_t* i_psAllocator);
+
 #endif  // TASK6_H
@@ -0,0 +1,238 @@
+/**
+ * @file trackingAllocator.c
+ * @brief Allocator that records call counts and peak memory per stage.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+/* Standard Library Includes */
+
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Project Includes */
+
+#include "huffmanCoding/allocator.h"
+#include "huffmanCoding/stats.h"
+#include "huffmanCoding/trackingAllocator.h"
+
+/* Type Definitions */
+
+/**
+ * @brief Header placed before each tracked allocation, padded so that the
+ * memory returned to the caller stays maximally aligned.
+ */
+typedef union uAllocationHeader {
+  max_align_t alignment;
+  struct {
+    size_t size;
+    eHuffmanStage_t eStage;
+  } sInfo;
+} uAllocationHeader_t;
+
+/* Function Prototypes */
+
+/**
+ * @brief Allocate memory with the backing allocator and record it.
+ *
+ * @param[inout] io_pUser The tracking allocator.
+ * @param[in] i_size The number of bytes to allocate.
+ * @return void* The allocated memory, else NULL.
+ */
+static void* trackingAlloc(void* io_pUser, size_t i_size);
+
+/**
+ * @brief Free memory with the backing allocator and record it.
+ *
+ * @param[inout] io_pUser The tracking allocator.
+ * @param[in] io_pMemory The memory to free.
+ */
+static void trackingFree(void* io_pUser, void* io_pMemory);
+
+/**
+ * @brief Record an allocation in a set of counters.
+ *
+ * @param[inout] io_psStats The counters.
+ * @param[in] i_size The number of bytes allocated.
+ */
+static void recordAllocation(sHuffmanAllocationStats_t* io_psStats,
+                             size_t i_size);
+
+/**
+ * @brief Reset a set of counters, keeping the bytes still allocated.
+ *
+ * @param[inout] io_psStats The counters.
+ */
+static void resetAllocationStats(sHuffmanAllocationStats_t* io_psStats);
+
+/**
+ * @brief Write allocation counters as a JSON object.
+ *
+ * @param[inout] io_pFile The file to write to.
+ * @param[in] i_psStats The counters.
+ */
+static void writeAllocationStatsJson(
+    FILE* io_pFile, const sHuffmanAllocationStats_t* i_psStats);
+
+/* Function Definitions */
+
+/**
+ * @brief Record an allocation in a set of counters.
+ *
+ * @param[inout] io_psStats The counters.
+ * @param[in] i_size The number of bytes allocated.
+ */
+static void recordAllocation(sHuffmanAllocationStats_t* io_psStats,
+                             size_t i_size) {
+  io_psStats->allocations++;
+  io_psStats->currentBytes += i_size;
+  if (io_psStats->currentBytes > io_psStats->peakBytes) {
+    io_psStats->peakBytes = io_psStats->currentBytes;
+  }
+}
+
+/**
+ * @brief Allocate memory with the backing allocator and record it.
+ *
+ * @param[inout] io_pUser The tracking allocator.
+ * @param[in] i_size The number of bytes to allocate.
+ * @return void* The allocated memory, else NULL.
+ */
+static void* trackingAlloc(void* io_pUser, size_t i_size) {
+  sHuffmanTrackingAllocator_t* psTracker =
+      (sHuffmanTrackingAllocator_t*)io_pUser;
+
+  if (i_size > SIZE_MAX - sizeof(uAllocationHeader_t)) {
+    return NULL;
+  }
+
+  const sHuffmanAllocator_t* psBacking = psTracker->psBacking;
+  uAllocationHeader_t* puHeader = (uAllocationHeader_t*)psBacking->pfnAlloc(
+      psBacking->pUser, sizeof(uAllocationHeader_t) + i_size);
+  if (puHeader == NULL) {
+    return NULL;
+  }
+
+  const eHuffmanStage_t eStage = getHuffmanAllocationStage();
+  puHeader->sInfo.size = i_size;
+  puHeader->sInfo.eStage = eStage;
+
+  recordAllocation(&psTracker->sTotal, i_size);
+  recordAllocation(&psTracker->aStages[eStage], i_size);
+
+  return &puHeader[1];
+}
+
+/**
+ * @brief Free memory with the backing allocator and record it.
+ *
+ * @param[inout] io_pUser The tracking allocator.
+ * @param[in] io_pMemory The memory to free.
+ */
+static void trackingFree(void* io_pUser, void* io_pMemory) {
+  sHuffmanTrackingAllocator_t* psTracker =
+      (sHuffmanTrackingAllocator_t*)io_pUser;
+  uAllocationHeader_t* puHeader = &((uAllocationHeader_t*)io_pMemory)[-1];
+  const size_t size = puHeader->sInfo.size;
+  sHuffmanAllocationStats_t* psStage =
+      &psTracker->aStages[puHeader->sInfo.eStage];
+
+  psTracker->sTotal.frees++;
+  psTracker->sTotal.currentBytes -= size;
+  psStage->frees++;
+  psStage->currentBytes -= size;
+
+  psTracker->psBacking->pfnFree(psTracker->psBacking->pUser, puHeader);
+}
+
+/**
+ * @brief Reset a set of counters, keeping the bytes still allocated.
+ *
+ * @param[inout] io_psStats The counters.
+ */
+static void resetAllocationStats(sHuffmanAllocationStats_t* io_psStats) {
+  io_psStats->allocations = 0;
+  io_psStats->frees = 0;
+  io_psStats->peakBytes = io_psStats->currentBytes;
+}
+
+/**
+ * @brief Write allocation counters as a JSON object.
+ *
+ * @param[inout] io_pFile The file to write to.
+ * @param[in] i_psStats The counters.
+ */
+static void writeAllocationStatsJson(
+    FILE* io_pFile, const sHuffmanAllocationStats_t* i_psStats) {
+  (void)fprintf(io_pFile,
+                "{\"allocations\": %" PRIu64 ", \"frees\": %" PRIu64
+                ", \"current_bytes\": %zu, \"peak_bytes\": %zu}",
+                i_psStats->allocations, i_psStats->frees,
+                i_psStats->currentBytes, i_psStats->peakBytes);
+}
+
+/**
+ * @brief Initialise a tracking allocator with zeroed counters.
+ *
+ * @param[out] o_psTracker The tracking allocator to initialise.
+ * @param[in] i_psBacking The allocator to forward to, or NULL for the default.
+ */
+void initTrackingAllocator(sHuffmanTrackingAllocator_t* o_psTracker,
+                           const sHuffmanAllocator_t* i_psBacking) {
+  (void)memset(o_psTracker, 0, sizeof(*o_psTracker));
+  o_psTracker->sAllocator.pfnAlloc = trackingAlloc;
+  o_psTracker->sAllocator.pfnFree = trackingFree;
+  o_psTracker->sAllocator.pUser = o_psTracker;
+  o_psTracker->psBacking =
+      (i_psBacking != NULL) ? i_psBacking : getDefaultHuffmanAllocator();
+}
+
+/**
+ * @brief Reset the counters of a tracking allocator.
+ *
+ * The current bytes are kept, so that memory still allocated is freed without
+ * the counters underflowing, and the peaks restart from them.
+ *
+ * @param[inout] io_psTracker The tracking allocator.
+ */
+void resetTrackingAllocator(sHuffmanTrackingAllocator_t* io_psTracker) {
+  resetAllocationStats(&io_psTracker->sTotal);
+  for (size_t stage = 0; stage <= HUFFMAN_STAGE_MAX; stage++) {
+    resetAllocationStats(&io_psTracker->aStages[stage]);
+  }
+}
+
+/**
+ * @brief Write the counters of a tracking allocator as a single JSON object.
+ *
+ * The object is written without a trailing newline so that it can be nested
+ * inside other JSON documents.
+ *
+ * @param[inout] io_pFile The file to write to.
+ * @param[in] i_psTracker The tracking allocator.
+ * @return int EXIT_SUCCESS if the object was written successfully, else
+ * EXIT_FAILURE.
+ */
+int writeTrackingAllocatorJson(FILE* io_pFile,
+                               const sHuffmanTrackingAllocator_t* i_psTracker) {
+  (void)fprintf(io_pFile, "{\"total\": ");
+  writeAllocationStatsJson(io_pFile, &i_psTracker->sTotal);
+
+  (void)fprintf(io_pFile, ", \"stages\": {");
+  for (size_t stage = 0; stage <= HUFFMAN_STAGE_MAX; stage++) {
+    (void)fprintf(io_pFile, "%s\"%s\": ", (stage == 0) ? "" : ", ",
+                  (stage == HUFFMAN_STAGE_MAX)
+                      ? "none"
+                      : getHuffmanStageName((eHuffmanStage_t)stage));
+    writeAllocationStatsJson(io_pFile, &i_psTracker->aStages[stage]);
+  }
+  (void)fputs("}}", io_pFile);
+
+  return ferror(io_pFile) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file trackingAllocator.h
+ * @brief Allocator that records call counts and peak memory per stage.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ * The tracking allocator forwards to a backing allocator and attributes each
+ * allocation to the current allocation stage, see setHuffmanAllocationStage.
+ * Memory is attributed to the stage that allocated it even if it is freed in a
+ * later stage. A tracking allocator must only be used by one thread at a time.
+ */
+
+#ifndef TRACKING_ALLOCATOR_H
+#define TRACKING_ALLOCATOR_H
+
+/* Standard Library Includes */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/* Project Includes */
+
+#include "huffmanCoding/allocator.h"
+#include "huffmanCoding/stats.h"
+
+/* Type Definitions */
+
+/**
+ * @brief Allocation counters of a stage, or of all stages.
+ */
+typedef struct sHuffmanAllocationStats {
+  uint64_t allocations;
+  uint64_t frees;
+  size_t currentBytes;
+  size_t peakBytes;
+} sHuffmanAllocationStats_t;
+
+/**
+ * @brief Allocator that records allocation counters.
+ *
+ * Pass sAllocator to the WithAllocator functions. The counters of memory
+ * allocated outside of any stage are kept at index HUFFMAN_STAGE_MAX.
+ */
+typedef struct sHuffmanTrackingAllocator {
+  sHuffmanAllocator_t sAllocator;
+  const sHuffmanAllocator_t* psBacking;
+  sHuffmanAllocationStats_t sTotal;
+  sHuffmanAllocationStats_t aStages[HUFFMAN_STAGE_MAX + 1];
+} sHuffmanTrackingAllocator_t;
+
+/* Function Prototypes */
+
+/**
+ * @brief Initialise a tracking allocator with zeroed counters.
+ *
+ * @param[out] o_psTracker The tracking allocator to initialise.
+ * @param[in] i_psBacking The allocator to forward to, or NULL for the default.
+ */
+extern void initTrackingAllocator(sHuffmanTrackingAllocator_t* o_psTracker,
+                                  const sHuffmanAllocator_t* i_psBacking);
+
+/**
+ * @brief Reset the counters of a tracking allocator.
+ *
+ * The current bytes are kept, so that memory still allocated is freed without
+ * the counters underflowing, and the peaks restart from them.
+ *
+ * @param[inout] io_psTracker The tracking allocator.
+ */
+extern void resetTrackingAllocator(sHuffmanTrackingAllocator_t* io_psTracker);
+
+/**
+ * @brief Write the counters of a tracking allocator as a single JSON object.
+ *
+ * The object is written without a trailing newline so that it can be nested
+ * inside other JSON documents.
+ *
+ * @param[inout] io_pFile The file to write to.
+ * @param[in] i_psTracker The tracking allocator.
+ * @return int EXIT_SUCCESS if the object was written successfully, else
+ * EXIT_FAILURE.
+ */
+extern int writeTrackingAllocatorJson(
+    FILE* io_pFile, const sHuffmanTrackingAllocator_t* i_psTracker);
+
+#endif  // TRACKING_ALLOCATOR_H
@@ -7,19 +7,501 @@
  * Copyright (c) 2024 Oliver Parsons
  */
 
+#define _POSIX_C_SOURCE 200809L
+
 /* Standard Library Includes */
 
+#include <inttypes.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 /* Project Includes */
 
+#include "huffmanCoding/allocator.h"
+#include "huffmanCoding/archive.h"
+#include "huffmanCoding/codec.h"
+#include "huffmanCoding/containerFile.h"
+#include "huffmanCoding/daemon.h"
+#include "huffmanCoding/histogram.h"
+#include "huffmanCoding/huffmanTree.h"
+#include "huffmanCoding/sampling.h"
+
+/********************************* Constants **********************************/
+
+/**< The number of bytes read from a file at a time when counting it. */
+#define COUNT_CHUNK_SIZE ((size_t)64 * 1024)
+
+/**< The number of match offsets found at a time when searching. */
+#define SEARCH_RESULT_COUNT ((size_t)1024)
+
+/**< The sample interval reported on when none is given. */
+#define DEFAULT_SAMPLE_INTERVAL ((size_t)8)
+
+/**< The block size reported on when none is given. */
+#define DEFAULT_SAMPLE_BLOCK_SIZE ((size_t)4 << 20)
+
+/***************************** Global Variables *******************************/
+
+/**< The running daemon, stopped by SIGINT and SIGTERM. */
+static sHuffmanDaemon_t* g_psDaemon = NULL;
+
 /*************************** Function Definitions  ****************************/
 
+/**
+ * @brief Print the command line usage.
+ *
+ * @param i_program The name of the program.
+ */
+static void printUsage(const char* i_program) {
+  (void)fprintf(stderr,
+                "Usage: %s daemon SOCKET [WORKERS]\n"
+                "       %s archive [-j THREADS] ARCHIVE PATH...\n"
+                "       %s list ARCHIVE\n"
+                "       %s extract ARCHIVE NAME OUTPUT\n"
+                "       %s histogram SHARD FILE...\n"
+                "       %s merge OUTPUT SHARD...\n"
+                "       %s append CONTAINER FILE...\n"
+                "       %s search CONTAINER PATTERN\n"
+                "       %s sample FILE [INTERVAL [BLOCK_SIZE]]\n",
+                i_program, i_program, i_program, i_program, i_program,
+                i_program, i_program, i_program, i_program);
+}
+
+/**
+ * @brief Stop the running daemon.
+ *
+ * @param i_signal The signal received.
+ */
+static void handleStopSignal(int i_signal) {
+  (void)i_signal;
+  if (g_psDaemon != NULL) {
+    stopHuffmanDaemon(g_psDaemon);
+  }
+}
+
+/**
+ * @brief Serve compression requests on a Unix domain socket until stopped.
+ *
+ * @param i_program The name of the program.
+ * @param argc Number of command arguments, after the command name.
+ * @param argv Command arguments, after the command name.
+ * @return EXIT_SUCCESS if the daemon stopped cleanly, else EXIT_FAILURE.
+ */
+static int runDaemonCommand(const char* i_program, int argc, char** argv) {
+  if (argc < 1 || argc > 2) {
+    printUsage(i_program);
+    return EXIT_FAILURE;
+  }
+
+  sHuffmanDaemonOptions_t sOptions;
+  initDaemonOptions(&sOptions);
+  sOptions.pSocketPath = argv[0];
+  if (argc == 2) {
+    sOptions.workerCount = (size_t)strtoull(argv[1], NULL, 10);
+  }
+
+  g_psDaemon = createHuffmanDaemon(&sOptions);
+  if (g_psDaemon == NULL) {
+    return EXIT_FAILURE;
+  }
+
+  struct sigaction sAction;
+  (void)memset(&sAction, 0, sizeof(sAction));
+  sAction.sa_handler = handleStopSignal;
+  (void)sigemptyset(&sAction.sa_mask);
+  (void)sigaction(SIGINT, &sAction, NULL);
+  (void)sigaction(SIGTERM, &sAction, NULL);
+
+  const int result = runHuffmanDaemon(g_psDaemon);
+  freeHuffmanDaemon(g_psDaemon);
+  g_psDaemon = NULL;
+  return result;
+}
+
+/**
+ * @brief Compress files and directories into an archive.
+ *
+ * @param i_program The name of the program.
+ * @param argc Number of command arguments, after the command name.
+ * @param argv Command arguments, after the command name.
+ * @return EXIT_SUCCESS if the archive was written, else EXIT_FAILURE.
+ */
+static int runArchiveCommand(const char* i_program, int argc, char** argv) {
+  sHuffmanArchiveOptions_t sOptions;
+  initArchiveOptions(&sOptions);
+  if (argc >= 2 && strcmp(argv[0], "-j") == 0) {
+    sOptions.threadCount = (size_t)strtoull(argv[1], NULL, 10);
+    argc -= 2;
+    argv += 2;
+  }
+  if (argc < 2) {
+    printUsage(i_program);
+    return EXIT_FAILURE;
+  }
+
+  return createArchive((const char* const*)&argv[1], (size_t)argc - 1,
+                       argv[0], &sOptions);
+}
+
+/**
+ * @brief Print the size and name of each file in an archive.
+ *
+ * @param i_program The name of the program.
+ * @param argc Number of command arguments, after the command name.
+ * @param argv Command arguments, after the command name.
+ * @return EXIT_SUCCESS if the archive was listed, else EXIT_FAILURE.
+ */
+static int runListCommand(const char* i_program, int argc, char** argv) {
+  if (argc != 1) {
+    printUsage(i_program);
+    return EXIT_FAILURE;
+  }
+
+  sHuffmanArchive_t* psArchive = openArchive(argv[0]);
+  if (psArchive == NULL) {
+    return EXIT_FAILURE;
+  }
+  for (size_t i = 0; i < getArchiveEntryCount(psArchive); i++) {
+    (void)printf("%12llu %s\n",
+                 (unsigned long long)getArchiveEntrySize(psArchive, i),
+                 getArchiveEntryName(psArchive, i));
+  }
+  closeArchive(psArchive);
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Extract one file from an archive.
+ *
+ * @param i_program The name of the program.
+ * @param argc Number of command arguments, after the command name.
+ * @param argv Command arguments, after the command name.
+ * @return EXIT_SUCCESS if the file was extracted, else EXIT_FAILURE.
+ */
+static int runExtractCommand(const char* i_program, int argc, char** argv) {
+  if (argc != 3) {
+    printUsage(i_program);
+    return EXIT_FAILURE;
+  }
+
+  sHuffmanArchive_t* psArchive = openArchive(argv[0]);
+  if (psArchive == NULL) {
+    return EXIT_FAILURE;
+  }
+  size_t index = 0;
+  if (findArchiveEntry(psArchive, argv[1], &index) == EXIT_FAILURE) {
+    (void)fprintf(stderr, "ERROR: %s is not in the archive\n", argv[1]);
+    closeArchive(psArchive);
+    return EXIT_FAILURE;
+  }
+
+  const uint64_t size = getArchiveEntrySize(psArchive, index);
+  uint8_t* pOutput =
+      (size < SIZE_MAX) ? (uint8_t*)allocateHuffmanMemory(NULL, size + 1)
+                        : NULL;
+  int result = (pOutput != NULL &&
+                extractArchiveEntry(psArchive, index, pOutput, (size_t)size) ==
+                    EXIT_SUCCESS)
+                   ? EXIT_SUCCESS
+                   : EXIT_FAILURE;
+  closeArchive(psArchive);
+
+  if (result == EXIT_SUCCESS) {
+    FILE* pFile = fopen(argv[2], "wb");
+    if (pFile == NULL || fwrite(pOutput, 1, size, pFile) != size) {
+      perror(argv[2]);
+      result = EXIT_FAILURE;
+    }
+    if (pFile != NULL && fclose(pFile) != 0) {
+      perror(argv[2]);
+      result = EXIT_FAILURE;
+    }
+  }
+  freeHuffmanMemory(NULL, pOutput);
+  return result;
+}
+
+/**
+ * @brief Count the bytes of files into a histogram shard.
+ *
+ * @param i_program The name of the program.
+ * @param argc Number of command arguments, after the command name.
+ * @param argv Command arguments, after the command name.
+ * @return EXIT_SUCCESS if the shard was written, else EXIT_FAILURE.
+ */
+static int runHistogramCommand(const char* i_program, int argc, char** argv) {
+  if (argc < 2) {
+    printUsage(i_program);
+    return EXIT_FAILURE;
+  }
+
+  uint8_t* pChunk = (uint8_t*)allocateHuffmanMemory(NULL, COUNT_CHUNK_SIZE);
+  if (pChunk == NULL) {
+    return EXIT_FAILURE;
+  }
+
+  sHuffmanHistogram_t sHistogram;
+  initHuffmanHistogram(&sHistogram);
+  int result = EXIT_SUCCESS;
+  for (int i = 1; i < argc && result == EXIT_SUCCESS; i++) {
+    FILE* pFile = fopen(argv[i], "rb");
+    if (pFile == NULL) {
+      perror(argv[i]);
+      result = EXIT_FAILURE;
+      break;
+    }
+    size_t size = 0;
+    while (result == EXIT_SUCCESS &&
+           (size = fread(pChunk, 1, COUNT_CHUNK_SIZE, pFile)) > 0) {
+      result = addBytesToHuffmanHistogram(&sHistogram, pChunk, size);
+    }
+    if (ferror(pFile) != 0) {
+      perror(argv[i]);
+      result = EXIT_FAILURE;
+    }
+    (void)fclose(pFile);
+  }
+  freeHuffmanMemory(NULL, pChunk);
+
+  if (result == EXIT_SUCCESS) {
+    result = writeHuffmanHistogramFile(&sHistogram, argv[0]);
+  }
+  return result;
+}
+
+/**
+ * @brief Merge histogram shards and print the code lengths built from them.
+ *
+ * @param i_program The name of the program.
+ * @param argc Number of command arguments, after the command name.
+ * @param argv Command arguments, after the command name.
+ * @return EXIT_SUCCESS if the shards were merged, else EXIT_FAILURE.
+ */
+static int runMergeCommand(const char* i_program, int argc, char** argv) {
+  if (argc < 2) {
+    printUsage(i_program);
+    return EXIT_FAILURE;
+  }
+
+  sHuffmanHistogram_t sHistogram;
+  initHuffmanHistogram(&sHistogram);
+  for (int i = 1; i < argc; i++) {
+    sHuffmanHistogram_t sShard;
+    if (readHuffmanHistogramFile(argv[i], &sShard) == EXIT_FAILURE ||
+        mergeHuffmanHistograms(&sHistogram, &sShard) == EXIT_FAILURE) {
+      (void)fprintf(stderr, "ERROR: Could not merge %s\n", argv[i]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (writeHuffmanHistogramFile(&sHistogram, argv[0]) == EXIT_FAILURE) {
+    return EXIT_FAILURE;
+  }
+
+  /* Every shard builds the same table from the merged histogram. */
+  uint8_t aCodeLengths[HUFFMAN_ALPHABET_SIZE];
+  if (createCodeLengthsFromFrequencies(sHistogram.aFrequencies,
+                                       aCodeLengths) == EXIT_FAILURE) {
+    return EXIT_FAILURE;
+  }
+  for (size_t i = 0; i < HUFFMAN_ALPHABET_SIZE; i++) {
+    if (aCodeLengths[i] != 0) {
+      (void)printf("%3zu %20zu %2u\n", i, sHistogram.aFrequencies[i],
+                   (unsigned)aCodeLengths[i]);
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Append files, or standard input for "-", to a container file.
+ *
+ * Each file is appended one block at a time, so it is never held in memory
+ * whole.
+ *
+ * @param i_program The name of the program.
+ * @param argc Number of command arguments, after the command name.
+ * @param argv Command arguments, after the command name.
+ * @return EXIT_SUCCESS if the files were appended, else EXIT_FAILURE.
+ */
+static int runAppendCommand(const char* i_program, int argc, char** argv) {
+  if (argc < 2) {
+    printUsage(i_program);
+    return EXIT_FAILURE;
+  }
+
+  uint8_t* pChunk =
+      (uint8_t*)allocateHuffmanMemory(NULL, HUFFMAN_DEFAULT_BLOCK_SIZE);
+  if (pChunk == NULL) {
+    return EXIT_FAILURE;
+  }
+
+  int result = EXIT_SUCCESS;
+  for (int i = 1; i < argc && result == EXIT_SUCCESS; i++) {
+    const int isStandardInput = (strcmp(argv[i], "-") == 0);
+    FILE* pFile = isStandardInput ? stdin : fopen(argv[i], "rb");
+    if (pFile == NULL) {
+      perror(argv[i]);
+      result = EXIT_FAILURE;
+      break;
+    }
+    size_t size = 0;
+    while (result == EXIT_SUCCESS &&
+           (size = fread(pChunk, 1, HUFFMAN_DEFAULT_BLOCK_SIZE, pFile)) > 0) {
+      result = appendToContainerFile(argv[0], pChunk, size, NULL);
+    }
+    if (ferror(pFile) != 0) {
+      perror(argv[i]);
+      result = EXIT_FAILURE;
+    }
+    if (!isStandardInput) {
+      (void)fclose(pFile);
+    }
+  }
+  freeHuffmanMemory(NULL, pChunk);
+  return result;
+}
+
+/**
+ * @brief Print the uncompressed offset of each match of a pattern in a
+ * container file, without decompressing it.
+ *
+ * @param i_program The name of the program.
+ * @param argc Number of command arguments, after the command name.
+ * @param argv Command arguments, after the command name.
+ * @return EXIT_SUCCESS if the file was searched, else EXIT_FAILURE.
+ */
+static int runSearchCommand(const char* i_program, int argc, char** argv) {
+  if (argc != 2) {
+    printUsage(i_program);
+    return EXIT_FAILURE;
+  }
+
+  size_t aOffsets[SEARCH_RESULT_COUNT];
+  size_t count = SEARCH_RESULT_COUNT;
+  size_t offset = 0;
+  while (count == SEARCH_RESULT_COUNT) {
+    if (searchContainerFile(argv[0], (const uint8_t*)argv[1],
+                            strlen(argv[1]), offset, aOffsets,
+                            SEARCH_RESULT_COUNT, &count) == EXIT_FAILURE) {
+      return EXIT_FAILURE;
+    }
+    for (size_t i = 0; i < count; i++) {
+      (void)printf("%zu\n", aOffsets[i]);
+    }
+    offset = (count > 0) ? aOffsets[count - 1] + 1 : offset;
+  }
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Report how much larger a file would compress with sampled
+ * frequencies than with exactly counted ones.
+ *
+ * @param i_program The name of the program.
+ * @param argc Number of command arguments, after the command name.
+ * @param argv Command arguments, after the command name.
+ * @return EXIT_SUCCESS if the file was measured, else EXIT_FAILURE.
+ */
+static int runSampleCommand(const char* i_program, int argc, char** argv) {
+  if (argc < 1 || argc > 3) {
+    printUsage(i_program);
+    return EXIT_FAILURE;
+  }
+  const size_t interval = (argc >= 2) ? (size_t)strtoull(argv[1], NULL, 10)
+                                      : DEFAULT_SAMPLE_INTERVAL;
+  const size_t blockSize = (argc >= 3) ? (size_t)strtoull(argv[2], NULL, 10)
+                                       : DEFAULT_SAMPLE_BLOCK_SIZE;
+  if (blockSize == 0 || blockSize > HUFFMAN_MAX_BLOCK_SIZE) {
+    (void)fprintf(stderr, "ERROR: Invalid block size\n");
+    return EXIT_FAILURE;
+  }
+
+  FILE* pFile = fopen(argv[0], "rb");
+  if (pFile == NULL) {
+    perror(argv[0]);
+    return EXIT_FAILURE;
+  }
+  uint8_t* pBlock = (uint8_t*)allocateHuffmanMemory(NULL, blockSize);
+  if (pBlock == NULL) {
+    (void)fclose(pFile);
+    return EXIT_FAILURE;
+  }
+
+  sHuffmanSamplingLoss_t sLoss = {0, 0};
+  int result = EXIT_SUCCESS;
+  size_t size = 0;
+  while (result == EXIT_SUCCESS &&
+         (size = fread(pBlock, 1, blockSize, pFile)) > 0) {
+    result = addSamplingLoss(pBlock, size, interval, &sLoss);
+  }
+  if (ferror(pFile) != 0) {
+    perror(argv[0]);
+    result = EXIT_FAILURE;
+  }
+  (void)fclose(pFile);
+  freeHuffmanMemory(NULL, pBlock);
+
+  if (result == EXIT_SUCCESS) {
+    (void)printf("exact payload: %" PRIu64 " bytes\n"
+                 "sampled payload: %" PRIu64 " bytes\n"
+                 "estimated loss: %.3f%%\n",
+                 (sLoss.exactBits + 7) / 8, (sLoss.sampledBits + 7) / 8,
+                 (sLoss.exactBits > 0)
+                     ? 100.0 *
+                           ((double)sLoss.sampledBits /
+                                (double)sLoss.exactBits -
+                            1.0)
+                     : 0.0);
+  }
+  return result;
+}
+
 /**
  * @brief Program entry function.
  *
  * Data compression algorithm using Huffman Codes.
  *
+ * @param argc Number of command line arguments.
+ * @param argv Command line arguments.
  * @return EXIT_SUCCESS if successful, else EXIT_FAILURE.
  */
-int main(void) { return EXIT_SUCCESS; }
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    printUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  if (strcmp(argv[1], "daemon") == 0) {
+    return runDaemonCommand(argv[0], argc - 2, &argv[2]);
+  }
+  if (strcmp(argv[1], "archive") == 0) {
+    return runArchiveCommand(argv[0], argc - 2, &argv[2]);
+  }
+  if (strcmp(argv[1], "list") == 0) {
+    return runListCommand(argv[0], argc - 2, &argv[2]);
+  }
+  if (strcmp(argv[1], "extract") == 0) {
+    return runExtractCommand(argv[0], argc - 2, &argv[2]);
+  }
+  if (strcmp(argv[1], "histogram") == 0) {
+    return runHistogramCommand(argv[0], argc - 2, &argv[2]);
+  }
+  if (strcmp(argv[1], "merge") == 0) {
+    return runMergeCommand(argv[0], argc - 2, &argv[2]);
+  }
+  if (strcmp(argv[1], "append") == 0) {
+    return runAppendCommand(argv[0], argc - 2, &argv[2]);
+  }
+  if (strcmp(argv[1], "search") == 0) {
+    return runSearchCommand(argv[0], argc - 2, &argv[2]);
+  }
+  if (strcmp(argv[1], "sample") == 0) {
+    return runSampleCommand(argv[0], argc - 2, &argv[2]);
+  }
+
+  printUsage(argv[0]);
+  return EXIT_FAILURE;
+}
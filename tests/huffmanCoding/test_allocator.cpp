@@ -0,0 +1,145 @@
+/**
+ * @file test_allocator.cpp
+ * @brief Unit tests for allocator.c.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+/* External Includes */
+
+#include <gtest/gtest.h>
+
+/* Standard Library Includes */
+
+#include <cstddef>
+#include <cstdlib>
+
+/* Project Includes */
+
+extern "C" {
+#include "huffmanCoding/allocator.h"
+#include "huffmanCoding/huffmanTree.h"
+#include "huffmanCoding/task3.h"
+#include "huffmanCoding/task5.h"
+#include "huffmanCoding/task6.h"
+}
+
+/* Test Fixtures */
+
+/**
+ * @brief Counting allocator test fixture, failing after a set number of
+ * allocations.
+ *
+ */
+class AllocatorTest : public ::testing::Test {
+ protected:
+  size_t allocations = 0;
+  size_t frees = 0;
+  size_t allocationLimit = SIZE_MAX;
+  sHuffmanAllocator_t sAllocator = {countingAlloc, countingFree, this};
+
+  static void* countingAlloc(void* io_pUser, size_t i_size) {
+    AllocatorTest* pTest = (AllocatorTest*)io_pUser;
+    if (pTest->allocations == pTest->allocationLimit) {
+      return NULL;
+    }
+    pTest->allocations++;
+    return malloc(i_size);
+  }
+
+  static void countingFree(void* io_pUser, void* io_pMemory) {
+    ((AllocatorTest*)io_pUser)->frees++;
+    free(io_pMemory);
+  }
+};
+
+/* Unit Tests */
+
+/**
+ * @brief Test the default allocator allocates and frees memory.
+ *
+ */
+TEST_F(AllocatorTest, test_defaultAllocator) {
+  void* pMemory = allocateHuffmanMemory(NULL, 16);
+  ASSERT_NE(pMemory, nullptr);
+  freeHuffmanMemory(getDefaultHuffmanAllocator(), pMemory);
+  freeHuffmanMemory(NULL, NULL);
+}
+
+/**
+ * @brief Test letter-frequency lists use the given allocator.
+ *
+ */
+TEST_F(AllocatorTest, test_appendLetterFrequencyPairWithAllocator) {
+  sLetterFrequencyNode_t* psHead = NULL;
+
+  ASSERT_EQ(appendLetterFrequencyPairWithAllocator('a', 1, &psHead,
+                                                   &sAllocator),
+            EXIT_SUCCESS);
+  ASSERT_EQ(appendLetterFrequencyPairWithAllocator('b', 2, &psHead,
+                                                   &sAllocator),
+            EXIT_SUCCESS);
+  EXPECT_EQ(allocations, 2U);
+
+  freeLetterFrequencyPairListWithAllocator(&psHead, &sAllocator);
+  EXPECT_EQ(frees, 2U);
+  EXPECT_EQ(psHead, nullptr);
+}
+
+/**
+ * @brief Test merging and freeing binary tree nodes use the given allocator.
+ *
+ */
+TEST_F(AllocatorTest, test_mergeBinaryTreeNodesWithAllocator) {
+  sLetterFrequencyNode_t* psHead = NULL;
+  sBinaryTreeListNode_t* psList = NULL;
+  ASSERT_EQ(appendLetterFrequencyPairWithAllocator('a', 1, &psHead,
+                                                   &sAllocator),
+            EXIT_SUCCESS);
+  ASSERT_EQ(appendLetterFrequencyPairWithAllocator('b', 2, &psHead,
+                                                   &sAllocator),
+            EXIT_SUCCESS);
+  ASSERT_EQ(createBinaryTreeNodeListFromLetterFrequencyPairListWithAllocator(
+                &psList, psHead, &sAllocator),
+            EXIT_SUCCESS);
+
+  sBinaryTreeNode_t* psRoot = createHuffmanTreeWithAllocator(&psList,
+                                                             &sAllocator);
+  ASSERT_NE(psRoot, nullptr);
+  EXPECT_EQ(psRoot->psLetterFrequencyPair->frequency, 3U);
+
+  freeBinaryTreeWithAllocator(psRoot, &sAllocator);
+  EXPECT_GT(allocations, 2U);
+  EXPECT_EQ(allocations, frees);
+}
+
+/**
+ * @brief Test every allocation failure is reported without leaking memory.
+ *
+ */
+TEST_F(AllocatorTest, test_createCodeLengthsAllocationFailure) {
+  size_t aFrequencies[HUFFMAN_ALPHABET_SIZE] = {0};
+  uint8_t aCodeLengths[HUFFMAN_ALPHABET_SIZE];
+  for (size_t symbol = 'a'; symbol <= 'h'; symbol++) {
+    aFrequencies[symbol] = symbol;
+  }
+
+  /* Find how many allocations succeed, then fail each one in turn. */
+  ASSERT_EQ(createCodeLengthsFromFrequenciesWithAllocator(
+                aFrequencies, aCodeLengths, &sAllocator),
+            EXIT_SUCCESS);
+  const size_t required = allocations;
+  EXPECT_EQ(frees, required);
+
+  for (size_t limit = 0; limit < required; limit++) {
+    allocations = 0;
+    frees = 0;
+    allocationLimit = limit;
+    EXPECT_EQ(createCodeLengthsFromFrequenciesWithAllocator(
+                  aFrequencies, aCodeLengths, &sAllocator),
+              EXIT_FAILURE);
+    EXPECT_EQ(allocations, frees) << "allocation limit " << limit;
+  }
+}
@@ -0,0 +1,266 @@
+/**
+ * @file test_archive.cpp
+ * @brief Unit tests for archive.c.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+/* External Includes */
+
+#include <gtest/gtest.h>
+
+/* Standard Library Includes */
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+/* Project Includes */
+
+#include "testUtils.hpp"
+
+extern "C" {
+#include "huffmanCoding/archive.h"
+}
+
+/* Test Fixtures */
+
+/**
+ * @brief Archive test fixture, with a directory of files to archive.
+ *
+ */
+class ArchiveTest : public ::testing::Test {
+ protected:
+  std::string directory;
+  std::string archivePath;
+  std::vector<std::string> paths;
+  std::vector<std::vector<uint8_t>> contents;
+
+  void SetUp() override {
+    directory = "/tmp/huffman_archive_" + std::to_string(getpid());
+    archivePath = directory + ".hfa";
+    ASSERT_EQ(mkdir(directory.c_str(), 0700), 0);
+    ASSERT_EQ(mkdir((directory + "/sub").c_str(), 0700), 0);
+
+    /* Small files to batch, an empty file and files split into parts. */
+    const size_t aSizes[] = {0, 1, 700, 5000, 20000, 150000, 600000};
+    for (size_t i = 0; i < sizeof(aSizes) / sizeof(aSizes[0]); i++) {
+      const std::string name = ((i % 2 == 0) ? "/sub/f" : "/f") +
+                               std::to_string(i);
+      addFile(directory + name,
+              generateGeometricBytes(aSizes[i], 0.2, (uint32_t)i + 1));
+    }
+  }
+
+  void TearDown() override {
+    for (const std::string& path : paths) {
+      (void)std::remove(path.c_str());
+    }
+    (void)rmdir((directory + "/sub").c_str());
+    (void)rmdir(directory.c_str());
+    (void)std::remove(archivePath.c_str());
+  }
+
+  /**
+   * @brief Write a file to archive.
+   *
+   * @param i_path The path of the file.
+   * @param i_bytes The file's bytes.
+   */
+  void addFile(const std::string& i_path, const std::vector<uint8_t>& i_bytes) {
+    FILE* pFile = std::fopen(i_path.c_str(), "wb");
+    ASSERT_NE(pFile, nullptr);
+    /* An empty vector's data may be null, which fwrite does not accept. */
+    if (!i_bytes.empty()) {
+      ASSERT_EQ(std::fwrite(i_bytes.data(), 1, i_bytes.size(), pFile),
+                i_bytes.size());
+    }
+    ASSERT_EQ(std::fclose(pFile), 0);
+    paths.push_back(i_path);
+    contents.push_back(i_bytes);
+  }
+
+  /**
+   * @brief Options that split and batch the test's files.
+   *
+   * @param i_threadCount The number of threads to compress with.
+   * @return sHuffmanArchiveOptions_t The options.
+   */
+  static sHuffmanArchiveOptions_t smallOptions(size_t i_threadCount) {
+    sHuffmanArchiveOptions_t sOptions;
+    initArchiveOptions(&sOptions);
+    sOptions.threadCount = i_threadCount;
+    sOptions.smallFileSize = 8000;
+    sOptions.batchSize = 6000;
+    sOptions.partSize = 100000;
+    return sOptions;
+  }
+
+  /**
+   * @brief Read a whole file.
+   *
+   * @param i_path The path of the file.
+   * @return std::vector<uint8_t> The file's bytes.
+   */
+  static std::vector<uint8_t> readFile(const std::string& i_path) {
+    std::vector<uint8_t> bytes;
+    FILE* pFile = std::fopen(i_path.c_str(), "rb");
+    if (pFile != NULL) {
+      uint8_t aBuffer[4096];
+      size_t count = 0;
+      while ((count = std::fread(aBuffer, 1, sizeof(aBuffer), pFile)) > 0) {
+        bytes.insert(bytes.end(), aBuffer, aBuffer + count);
+      }
+      (void)std::fclose(pFile);
+    }
+    return bytes;
+  }
+
+  /**
+   * @brief Check every file extracts from the archive unchanged.
+   */
+  void checkArchive() {
+    sHuffmanArchive_t* psArchive = openArchive(archivePath.c_str());
+    ASSERT_NE(psArchive, nullptr);
+    ASSERT_EQ(getArchiveEntryCount(psArchive), paths.size());
+
+    for (size_t i = 0; i < paths.size(); i++) {
+      size_t index = 0;
+      ASSERT_EQ(findArchiveEntry(psArchive, paths[i].c_str(), &index),
+                EXIT_SUCCESS)
+          << paths[i];
+      ASSERT_EQ(getArchiveEntrySize(psArchive, index), contents[i].size());
+      std::vector<uint8_t> output(contents[i].size());
+      ASSERT_EQ(extractArchiveEntry(psArchive, index, output.data(),
+                                    output.size()),
+                EXIT_SUCCESS)
+          << paths[i];
+      ASSERT_EQ(output, contents[i]) << paths[i];
+    }
+
+    closeArchive(psArchive);
+  }
+};
+
+/* Unit Tests */
+
+/**
+ * @brief Test files named one by one round trip.
+ *
+ */
+TEST_F(ArchiveTest, test_createArchive_Files) {
+  std::vector<const char*> apPaths;
+  for (const std::string& path : paths) {
+    apPaths.push_back(path.c_str());
+  }
+  const sHuffmanArchiveOptions_t sOptions = smallOptions(3);
+  ASSERT_EQ(createArchive(apPaths.data(), apPaths.size(), archivePath.c_str(),
+                          &sOptions),
+            EXIT_SUCCESS);
+  checkArchive();
+
+  sHuffmanArchive_t* psArchive = openArchive(archivePath.c_str());
+  ASSERT_NE(psArchive, nullptr);
+  for (size_t i = 0; i < paths.size(); i++) {
+    ASSERT_STREQ(getArchiveEntryName(psArchive, i), paths[i].c_str());
+  }
+  size_t index = 0;
+  ASSERT_EQ(findArchiveEntry(psArchive, "missing", &index), EXIT_FAILURE);
+  closeArchive(psArchive);
+}
+
+/**
+ * @brief Test a directory is added in name order, and the archive does not
+ * depend on the number of threads.
+ *
+ */
+TEST_F(ArchiveTest, test_createArchive_Directory) {
+  const char* apPaths[] = {directory.c_str()};
+  sHuffmanArchiveOptions_t sOptions = smallOptions(1);
+  ASSERT_EQ(createArchive(apPaths, 1, archivePath.c_str(), &sOptions),
+            EXIT_SUCCESS);
+  checkArchive();
+  const std::vector<uint8_t> serial = readFile(archivePath);
+
+  sOptions.threadCount = 4;
+  ASSERT_EQ(createArchive(apPaths, 1, archivePath.c_str(), &sOptions),
+            EXIT_SUCCESS);
+  ASSERT_EQ(readFile(archivePath), serial);
+
+  sHuffmanArchive_t* psArchive = openArchive(archivePath.c_str());
+  ASSERT_NE(psArchive, nullptr);
+  for (size_t i = 1; i < getArchiveEntryCount(psArchive); i++) {
+    ASSERT_LT(std::string(getArchiveEntryName(psArchive, i - 1)),
+              std::string(getArchiveEntryName(psArchive, i)));
+  }
+  closeArchive(psArchive);
+
+  /* The default options batch every file, as they are all small. */
+  ASSERT_EQ(createArchive(apPaths, 1, archivePath.c_str(), NULL),
+            EXIT_SUCCESS);
+  checkArchive();
+}
+
+/**
+ * @brief Test missing inputs fail without leaving an archive behind, and
+ * damaged archives are rejected.
+ *
+ */
+TEST_F(ArchiveTest, test_openArchive_Invalid) {
+  const char* apMissing[] = {"/tmp/huffman_archive_missing"};
+  ASSERT_EQ(createArchive(apMissing, 1, archivePath.c_str(), NULL),
+            EXIT_FAILURE);
+  ASSERT_NE(access(archivePath.c_str(), F_OK), 0);
+  ASSERT_EQ(openArchive(archivePath.c_str()), nullptr);
+
+  const char* apPaths[] = {directory.c_str()};
+  const sHuffmanArchiveOptions_t sOptions = smallOptions(2);
+  ASSERT_EQ(createArchive(apPaths, 1, archivePath.c_str(), &sOptions),
+            EXIT_SUCCESS);
+  const std::vector<uint8_t> archive = readFile(archivePath);
+
+  /* A truncated archive has no trailer. */
+  ASSERT_EQ(truncate(archivePath.c_str(), (off_t)archive.size() - 1), 0);
+  ASSERT_EQ(openArchive(archivePath.c_str()), nullptr);
+
+  /* A directory pointing past its end. */
+  std::vector<uint8_t> damaged = archive;
+  damaged[damaged.size() - 16] ^= 0x01;
+  damaged[damaged.size() - 10] = 0xFF;
+  FILE* pFile = std::fopen(archivePath.c_str(), "wb");
+  ASSERT_NE(pFile, nullptr);
+  ASSERT_EQ(std::fwrite(damaged.data(), 1, damaged.size(), pFile),
+            damaged.size());
+  ASSERT_EQ(std::fclose(pFile), 0);
+  ASSERT_EQ(openArchive(archivePath.c_str()), nullptr);
+
+  /* A damaged member only fails the entries stored in it. */
+  damaged = archive;
+  damaged[HUFFMAN_ARCHIVE_HEADER_SIZE] ^= 0x55;
+  pFile = std::fopen(archivePath.c_str(), "wb");
+  ASSERT_NE(pFile, nullptr);
+  ASSERT_EQ(std::fwrite(damaged.data(), 1, damaged.size(), pFile),
+            damaged.size());
+  ASSERT_EQ(std::fclose(pFile), 0);
+  sHuffmanArchive_t* psArchive = openArchive(archivePath.c_str());
+  ASSERT_NE(psArchive, nullptr);
+  std::vector<uint8_t> output(1 << 20);
+  ASSERT_EQ(extractArchiveEntry(psArchive, 0, output.data(), output.size()),
+            EXIT_FAILURE);
+  ASSERT_EQ(extractArchiveEntry(psArchive, 2, output.data(), output.size()),
+            EXIT_SUCCESS);
+  ASSERT_EQ(extractArchiveEntry(psArchive, 2, output.data(), 10),
+            EXIT_FAILURE);
+  ASSERT_EQ(extractArchiveEntry(psArchive, getArchiveEntryCount(psArchive),
+                                output.data(), output.size()),
+            EXIT_FAILURE);
+  closeArchive(psArchive);
+}
@@ -0,0 +1,182 @@
+/**
+ * @file test_checksum.cpp
+ * @brief Unit tests for checksum.c.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+/* External Includes */
+
+#include <gtest/gtest.h>
+
+/* Standard Library Includes */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+/* Project Includes */
+
+extern "C" {
+#include "huffmanCoding/checksum.h"
+#include "huffmanCoding/huffmanTree.h"
+#include "huffmanCoding/task4.h"
+}
+
+/* Test Fixtures */
+
+/**
+ * @brief Checksum kernel test fixture, restoring the selected kernel.
+ *
+ */
+class ChecksumTest : public ::testing::Test {
+ protected:
+  eHuffmanChecksumKernel_t ePrevious = HUFFMAN_CHECKSUM_KERNEL_PORTABLE;
+
+  /**
+   * @brief Remember the kernel selected at startup.
+   *
+   */
+  void SetUp() override { ePrevious = getChecksumKernel(); }
+
+  /**
+   * @brief Restore the kernel selected at startup.
+   *
+   */
+  void TearDown() override { (void)setChecksumKernel(ePrevious); }
+};
+
+/* Unit Tests */
+
+/**
+ * @brief Test the kernel selected at startup is supported and unsupported
+ * kernels cannot be selected.
+ *
+ */
+TEST_F(ChecksumTest, test_setChecksumKernel) {
+  ASSERT_TRUE(isChecksumKernelSupported(getChecksumKernel()));
+  ASSERT_TRUE(isChecksumKernelSupported(HUFFMAN_CHECKSUM_KERNEL_PORTABLE));
+  ASSERT_FALSE(isChecksumKernelSupported(HUFFMAN_CHECKSUM_KERNEL_MAX));
+  ASSERT_EQ(setChecksumKernel(HUFFMAN_CHECKSUM_KERNEL_MAX), EXIT_FAILURE);
+
+  ASSERT_EQ(setChecksumKernel(HUFFMAN_CHECKSUM_KERNEL_PORTABLE),
+            EXIT_SUCCESS);
+  ASSERT_EQ(getChecksumKernel(), HUFFMAN_CHECKSUM_KERNEL_PORTABLE);
+  ASSERT_EQ(std::string(getChecksumKernelName(HUFFMAN_CHECKSUM_KERNEL_SSE42)),
+            "sse4.2");
+  ASSERT_EQ(std::string(getChecksumKernelName(HUFFMAN_CHECKSUM_KERNEL_MAX)),
+            "unknown");
+}
+
+/**
+ * @brief Test each supported kernel gives the standard CRC32C check values,
+ * and that updating in pieces gives the checksum of the whole.
+ *
+ */
+TEST_F(ChecksumTest, test_updateCrc32c) {
+  const std::string check = "123456789";
+  const std::vector<uint8_t> zeros(32, 0);
+  const std::vector<uint8_t> ones(32, 0xFF);
+
+  for (int kernel = 0; kernel < HUFFMAN_CHECKSUM_KERNEL_MAX; kernel++) {
+    const auto eKernel = static_cast<eHuffmanChecksumKernel_t>(kernel);
+    if (!isChecksumKernelSupported(eKernel)) {
+      continue;
+    }
+    ASSERT_EQ(setChecksumKernel(eKernel), EXIT_SUCCESS);
+
+    ASSERT_EQ(updateCrc32c(0, nullptr, 0), 0U);
+    ASSERT_EQ(updateCrc32c(0, reinterpret_cast<const uint8_t*>(check.data()),
+                           check.size()),
+              0xE3069283U);
+    ASSERT_EQ(updateCrc32c(0, zeros.data(), zeros.size()), 0x8A9136AAU);
+    ASSERT_EQ(updateCrc32c(0, ones.data(), ones.size()), 0x62A8AB43U);
+
+    const uint32_t first = updateCrc32c(
+        0, reinterpret_cast<const uint8_t*>(check.data()), 4);
+    ASSERT_EQ(updateCrc32c(first,
+                           reinterpret_cast<const uint8_t*>(&check[4]), 5),
+              0xE3069283U);
+  }
+}
+
+/**
+ * @brief Test every kernel agrees on inputs long enough to be split into
+ * lanes, at every alignment and length around the lane boundaries.
+ *
+ */
+TEST_F(ChecksumTest, test_updateCrc32c_KernelsAgree) {
+  std::mt19937 generator(7);
+  std::uniform_int_distribution<int> distribution(0, 255);
+  std::vector<uint8_t> input(20000);
+  for (uint8_t& byte : input) {
+    byte = static_cast<uint8_t>(distribution(generator));
+  }
+
+  ASSERT_EQ(setChecksumKernel(HUFFMAN_CHECKSUM_KERNEL_PORTABLE),
+            EXIT_SUCCESS);
+  std::vector<uint32_t> expected;
+  const size_t sizes[] = {3071, 3072, 3073, 6151, 9216, 19990};
+  for (size_t offset = 0; offset < 8; offset++) {
+    for (const size_t size : sizes) {
+      expected.push_back(updateCrc32c(0x12345678U, &input[offset], size));
+    }
+  }
+
+  for (int kernel = 0; kernel < HUFFMAN_CHECKSUM_KERNEL_MAX; kernel++) {
+    const auto eKernel = static_cast<eHuffmanChecksumKernel_t>(kernel);
+    if (!isChecksumKernelSupported(eKernel)) {
+      continue;
+    }
+    ASSERT_EQ(setChecksumKernel(eKernel), EXIT_SUCCESS);
+
+    size_t i = 0;
+    for (size_t offset = 0; offset < 8; offset++) {
+      for (const size_t size : sizes) {
+        ASSERT_EQ(updateCrc32c(0x12345678U, &input[offset], size),
+                  expected[i++])
+            << getChecksumKernelName(eKernel) << " at " << offset << "+"
+            << size;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Test counting with a checksum gives the same frequencies as
+ * countByteFrequencies and the same checksum as updateCrc32c.
+ *
+ */
+TEST_F(ChecksumTest, test_countByteFrequenciesWithCrc32c) {
+  std::mt19937 generator(11);
+  std::uniform_int_distribution<int> distribution(0, 15);
+  std::vector<uint8_t> input(4099);
+  for (uint8_t& byte : input) {
+    byte = static_cast<uint8_t>(distribution(generator) * 17);
+  }
+
+  for (int kernel = 0; kernel < HUFFMAN_CHECKSUM_KERNEL_MAX; kernel++) {
+    const auto eKernel = static_cast<eHuffmanChecksumKernel_t>(kernel);
+    if (!isChecksumKernelSupported(eKernel)) {
+      continue;
+    }
+    ASSERT_EQ(setChecksumKernel(eKernel), EXIT_SUCCESS);
+
+    for (const size_t size : {size_t{0}, size_t{7}, input.size()}) {
+      std::vector<size_t> expected(HUFFMAN_ALPHABET_SIZE);
+      std::vector<size_t> frequencies(HUFFMAN_ALPHABET_SIZE, 1);
+      countByteFrequencies(input.data(), size, expected.data());
+
+      ASSERT_EQ(countByteFrequenciesWithCrc32c(input.data(), size,
+                                               frequencies.data()),
+                updateCrc32c(0, input.data(), size));
+      ASSERT_EQ(frequencies, expected);
+    }
+  }
+}
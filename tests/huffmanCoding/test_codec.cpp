@@ -0,0 +1,1132 @@
+/**
+ * @file test_codec.cpp
+ * @brief Unit tests for codec.c.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+/* External Includes */
+
+#include <gtest/gtest.h>
+
+/* Standard Library Includes */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+/* Project Includes */
+
+extern "C" {
+#include "huffmanCoding/codec.h"
+#include "huffmanCoding/sampling.h"
+#include "huffmanCoding/stats.h"
+#include "huffmanCoding/trackingAllocator.h"
+}
+
+/* Test Fixtures */
+
+/**
+ * @brief Compression round trip test fixture.
+ *
+ */
+class CodecTest : public ::testing::Test {
+ protected:
+  std::vector<uint8_t> compressed;
+  std::vector<uint8_t> decompressed;
+  sHuffmanContext_t* psContext = NULL;
+
+  /**
+   * @brief Free the context.
+   *
+   */
+  void TearDown() override { freeHuffmanContext(psContext); }
+
+  /**
+   * @brief Compress and decompress the input, asserting each step succeeds.
+   *
+   * @param i_input The bytes to compress.
+   * @param i_psOptions The compression options, or NULL for the defaults.
+   */
+  void roundTrip(const std::vector<uint8_t>& i_input,
+                 const sHuffmanCompressOptions_t* i_psOptions = NULL) {
+    size_t compressedSize = 0;
+    compressed.resize(getCompressBound(i_input.size(), i_psOptions));
+    ASSERT_EQ(compressBuffer(i_input.data(), i_input.size(), compressed.data(),
+                             compressed.size(), &compressedSize, i_psOptions),
+              EXIT_SUCCESS);
+    compressed.resize(compressedSize);
+
+    size_t decompressedSize = 0;
+    ASSERT_EQ(getDecompressedSize(compressed.data(), compressed.size(),
+                                  &decompressedSize),
+              EXIT_SUCCESS);
+    ASSERT_EQ(decompressedSize, i_input.size());
+
+    size_t outputSize = 0;
+    decompressed.resize(decompressedSize);
+    ASSERT_EQ(decompressBuffer(compressed.data(), compressed.size(),
+                               decompressed.data(), decompressed.size(),
+                               &outputSize),
+              EXIT_SUCCESS);
+    ASSERT_EQ(outputSize, i_input.size());
+    ASSERT_EQ(decompressed, i_input);
+  }
+
+  /**
+   * @brief Round trip the input with the context, asserting the container is
+   * identical to compressBuffer's.
+   *
+   * @param i_input The bytes to compress.
+   * @param i_psOptions The compression options, or NULL for the defaults.
+   */
+  void contextRoundTrip(const std::vector<uint8_t>& i_input,
+                        const sHuffmanCompressOptions_t* i_psOptions = NULL) {
+    roundTrip(i_input, i_psOptions);
+
+    size_t compressedSize = 0;
+    std::vector<uint8_t> output(getCompressBound(i_input.size(), i_psOptions));
+    ASSERT_EQ(compressBufferWithContext(psContext, i_input.data(),
+                                        i_input.size(), output.data(),
+                                        output.size(), &compressedSize,
+                                        i_psOptions),
+              EXIT_SUCCESS);
+    output.resize(compressedSize);
+    ASSERT_EQ(output, compressed);
+
+    size_t outputSize = 0;
+    std::vector<uint8_t> result(i_input.size());
+    ASSERT_EQ(decompressBufferWithContext(psContext, output.data(),
+                                          output.size(), result.data(),
+                                          result.size(), &outputSize),
+              EXIT_SUCCESS);
+    ASSERT_EQ(outputSize, i_input.size());
+    ASSERT_EQ(result, i_input);
+  }
+
+  /**
+   * @brief Compress and decompress buffers as a batch with the context,
+   * asserting each step succeeds and the offsets delimit each buffer.
+   *
+   * @param i_buffers The buffers to compress.
+   */
+  void batchRoundTrip(const std::vector<std::vector<uint8_t>>& i_buffers) {
+    std::vector<const uint8_t*> inputs;
+    std::vector<size_t> inputSizes;
+    size_t totalSize = 0;
+    for (const std::vector<uint8_t>& buffer : i_buffers) {
+      inputs.push_back(buffer.data());
+      inputSizes.push_back(buffer.size());
+      totalSize += buffer.size();
+    }
+
+    size_t compressedSize = 0;
+    std::vector<size_t> offsets(i_buffers.size() + 1);
+    compressed.resize(getBatchCompressBound(i_buffers.size(), totalSize));
+    ASSERT_EQ(compressBatchWithContext(psContext, inputs.data(),
+                                       inputSizes.data(), i_buffers.size(),
+                                       compressed.data(), compressed.size(),
+                                       offsets.data(), &compressedSize),
+              EXIT_SUCCESS);
+    ASSERT_EQ(offsets.back(), compressedSize);
+    compressed.resize(compressedSize);
+
+    size_t bufferCount = 0;
+    size_t decompressedSize = 0;
+    ASSERT_EQ(getBatchInfo(compressed.data(), compressed.size(), &bufferCount,
+                           &decompressedSize),
+              EXIT_SUCCESS);
+    ASSERT_EQ(bufferCount, i_buffers.size());
+    ASSERT_EQ(decompressedSize, totalSize);
+
+    size_t outputSize = 0;
+    decompressed.resize(decompressedSize);
+    ASSERT_EQ(decompressBatchWithContext(psContext, compressed.data(),
+                                         compressed.size(), decompressed.data(),
+                                         decompressed.size(), offsets.data(),
+                                         &outputSize),
+              EXIT_SUCCESS);
+    ASSERT_EQ(outputSize, totalSize);
+    for (size_t i = 0; i < i_buffers.size(); i++) {
+      ASSERT_EQ(std::vector<uint8_t>(decompressed.begin() + offsets[i],
+                                     decompressed.begin() + offsets[i + 1]),
+                i_buffers[i])
+          << "buffer " << i;
+    }
+  }
+};
+
+/* Unit Tests */
+
+/**
+ * @brief Test a round trip of the example text compresses it.
+ *
+ */
+TEST_F(CodecTest, test_compressBuffer_Text) {
+  const char* text =
+      "to be or not to be, that is the question: whether 'tis nobler in the "
+      "mind to suffer the slings and arrows of outrageous fortune, or to take "
+      "arms against a sea of troubles and by opposing end them.";
+  std::vector<uint8_t> input(text, text + strlen(text));
+  std::vector<uint8_t> repeated;
+  for (int i = 0; i < 50; i++) {
+    repeated.insert(repeated.end(), input.begin(), input.end());
+  }
+
+  roundTrip(repeated);
+
+  ASSERT_LT(compressed.size(), repeated.size());
+}
+
+/**
+ * @brief Test a round trip of an empty input.
+ *
+ */
+TEST_F(CodecTest, test_compressBuffer_Empty) { roundTrip({}); }
+
+/**
+ * @brief Test a round trip of a single repeated symbol.
+ *
+ */
+TEST_F(CodecTest, test_compressBuffer_SingleSymbol) {
+  std::vector<uint8_t> input(10000, 'x');
+
+  roundTrip(input);
+
+  /* One bit per symbol plus the container overhead. */
+  ASSERT_LT(compressed.size(), input.size() / 8 + 256);
+}
+
+/**
+ * @brief Test uniformly random bytes are stored rather than expanded.
+ *
+ */
+TEST_F(CodecTest, test_compressBuffer_Random) {
+  std::mt19937 generator(1);
+  std::vector<uint8_t> input(100000);
+  for (uint8_t& byte : input) {
+    byte = (uint8_t)generator();
+  }
+
+  roundTrip(input);
+
+  ASSERT_LE(compressed.size(), getCompressBound(input.size(), NULL));
+}
+
+/**
+ * @brief Test a round trip with long codes that need the tree fallback.
+ *
+ */
+TEST_F(CodecTest, test_compressBuffer_LongCodes) {
+  /* A Fibonacci distribution gives codes up to the maximum length. */
+  std::vector<uint8_t> input;
+  size_t previous = 1;
+  size_t current = 1;
+  for (uint8_t symbol = 0; symbol < 24; symbol++) {
+    input.insert(input.end(), current, symbol);
+    const size_t next = previous + current;
+    previous = current;
+    current = next;
+  }
+  std::shuffle(input.begin(), input.end(), std::mt19937(2));
+
+  roundTrip(input);
+}
+
+/**
+ * @brief Test a round trip across many small blocks.
+ *
+ */
+TEST_F(CodecTest, test_compressBuffer_SmallBlocks) {
+  sHuffmanCompressOptions_t sOptions;
+  initCompressOptions(&sOptions);
+  sOptions.blockSize = 100;
+
+  std::mt19937 generator(3);
+  std::geometric_distribution<int> distribution(0.2);
+  std::vector<uint8_t> input(5000);
+  for (uint8_t& byte : input) {
+    byte = (uint8_t)distribution(generator);
+  }
+
+  roundTrip(input, &sOptions);
+}
+
+/**
+ * @brief Test compressing with an invalid block size.
+ *
+ */
+TEST_F(CodecTest, test_compressBuffer_InvalidBlockSize) {
+  sHuffmanCompressOptions_t sOptions;
+  initCompressOptions(&sOptions);
+  sOptions.blockSize = 0;
+  uint8_t output[64];
+  size_t outputSize = 0;
+
+  int retcode = compressBuffer((const uint8_t*)"abc", 3, output,
+                               sizeof(output), &outputSize, &sOptions);
+
+  ASSERT_EQ(retcode, EXIT_FAILURE);
+}
+
+/**
+ * @brief Test compressing into an output buffer that is too small.
+ *
+ */
+TEST_F(CodecTest, test_compressBuffer_OutputTooSmall) {
+  std::vector<uint8_t> input(1000, 'a');
+  uint8_t output[32];
+  size_t outputSize = 0;
+
+  int retcode = compressBuffer(input.data(), input.size(), output,
+                               sizeof(output), &outputSize, NULL);
+
+  ASSERT_EQ(retcode, EXIT_FAILURE);
+}
+
+/**
+ * @brief Test appending to a container decompresses to the concatenated
+ * inputs, and similar blocks share their code lengths.
+ *
+ */
+TEST_F(CodecTest, test_appendBuffer) {
+  /* Every byte value appears in both parts, so the lengths can be reused. */
+  std::mt19937 generator(4);
+  std::geometric_distribution<int> distribution(0.1);
+  std::vector<uint8_t> input(30000);
+  for (uint8_t& byte : input) {
+    byte = (uint8_t)(distribution(generator) % 32);
+  }
+  const std::vector<uint8_t> first(input.begin(), input.begin() + 20000);
+  roundTrip(first);
+  size_t firstBlockSize = HUFFMAN_BLOCK_HEADER_SIZE + HUFFMAN_CODE_LENGTHS_SIZE;
+  for (size_t i = 0; i < 4; i++) {
+    firstBlockSize += (size_t)compressed[HUFFMAN_HEADER_SIZE + 4 + i]
+                      << (8 * i);
+  }
+
+  size_t compressedSize = 0;
+  std::vector<uint8_t> container = compressed;
+  container.resize(getAppendBound(compressed.size(), 10000, NULL));
+  ASSERT_EQ(appendBuffer(container.data(), compressed.size(), container.size(),
+                         &input[20000], 10000, &compressedSize, NULL),
+            EXIT_SUCCESS);
+  container.resize(compressedSize);
+
+  std::vector<uint8_t> output(input.size());
+  size_t outputSize = 0;
+  ASSERT_EQ(decompressBuffer(container.data(), container.size(),
+                             output.data(), output.size(), &outputSize),
+            EXIT_SUCCESS);
+  ASSERT_EQ(output, input);
+  ASSERT_EQ(decompressRange(container.data(), container.size(), 19990, 20,
+                            output.data()),
+            EXIT_SUCCESS);
+  ASSERT_TRUE(std::equal(&input[19990], &input[20010], output.data()));
+
+  /* The appended block was coded with the first block's code lengths. */
+  const uint8_t* pFirstLengths = &container[HUFFMAN_HEADER_SIZE +
+                                            HUFFMAN_BLOCK_HEADER_SIZE];
+  ASSERT_EQ(memcmp(pFirstLengths, pFirstLengths + firstBlockSize,
+                   HUFFMAN_CODE_LENGTHS_SIZE),
+            0);
+
+  /* Appending to an empty container gives the same bytes as compressing. */
+  roundTrip({});
+  container = compressed;
+  container.resize(getAppendBound(compressed.size(), input.size(), NULL));
+  ASSERT_EQ(appendBuffer(container.data(), compressed.size(), container.size(),
+                         input.data(), input.size(), &compressedSize, NULL),
+            EXIT_SUCCESS);
+  container.resize(compressedSize);
+  roundTrip(input);
+  ASSERT_EQ(container, compressed);
+}
+
+/**
+ * @brief Test appending to a damaged container, or without room, fails and
+ * leaves the container unchanged.
+ *
+ */
+TEST_F(CodecTest, test_appendBuffer_Invalid) {
+  std::vector<uint8_t> input(5000);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] = (uint8_t)("abcdefgh"[i % 8]);
+  }
+  roundTrip(input);
+  const std::vector<uint8_t> original = compressed;
+  std::vector<uint8_t> container = compressed;
+  container.resize(getAppendBound(compressed.size(), input.size(), NULL));
+  size_t compressedSize = 0;
+
+  /* Too little room for the new block. */
+  ASSERT_EQ(appendBuffer(container.data(), compressed.size(),
+                         compressed.size() + 40, input.data(), input.size(),
+                         &compressedSize, NULL),
+            EXIT_FAILURE);
+  ASSERT_TRUE(std::equal(original.begin(), original.end(), container.begin()));
+
+  /* A block index pointing away from the last block. */
+  container[compressed.size() - HUFFMAN_TRAILER_SIZE - 8] ^= 0x01;
+  ASSERT_EQ(appendBuffer(container.data(), compressed.size(), container.size(),
+                         input.data(), input.size(), &compressedSize, NULL),
+            EXIT_FAILURE);
+  container[compressed.size() - HUFFMAN_TRAILER_SIZE - 8] ^= 0x01;
+
+  /* A missing end marker, or a missing trailer. */
+  container[compressed.size() - HUFFMAN_TRAILER_SIZE - 12] = 0xFF;
+  ASSERT_EQ(appendBuffer(container.data(), compressed.size(), container.size(),
+                         input.data(), input.size(), &compressedSize, NULL),
+            EXIT_FAILURE);
+  container[compressed.size() - HUFFMAN_TRAILER_SIZE - 12] = 0;
+  ASSERT_EQ(appendBuffer(container.data(), compressed.size() - 1,
+                         container.size(), input.data(), input.size(),
+                         &compressedSize, NULL),
+            EXIT_FAILURE);
+  ASSERT_TRUE(std::equal(original.begin(), original.end(), container.begin()));
+}
+
+/**
+ * @brief Test decompressing a corrupted container fails cleanly.
+ *
+ */
+TEST_F(CodecTest, test_decompressBuffer_Corrupted) {
+  std::vector<uint8_t> input(2000);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] = (uint8_t)("abcdefgh"[i % 8]);
+  }
+  roundTrip(input);
+
+  /* Truncate the container. */
+  std::vector<uint8_t> truncated(compressed.begin(), compressed.end() - 5);
+  size_t outputSize = 0;
+  ASSERT_EQ(decompressBuffer(truncated.data(), truncated.size(),
+                             decompressed.data(), decompressed.size(),
+                             &outputSize),
+            EXIT_FAILURE);
+
+  /* Break the magic bytes. */
+  compressed[0] = 'X';
+  ASSERT_EQ(decompressBuffer(compressed.data(), compressed.size(),
+                             decompressed.data(), decompressed.size(),
+                             &outputSize),
+            EXIT_FAILURE);
+}
+
+/**
+ * @brief Test a container whose trailer disagrees with its blocks on the
+ * uncompressed size is rejected, with or without a context.
+ *
+ */
+TEST_F(CodecTest, test_decompressBuffer_TrailerSizeMismatch) {
+  psContext = createHuffmanContext(NULL);
+  ASSERT_NE(psContext, nullptr);
+
+  std::vector<uint8_t> input(2000);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] = (uint8_t)("abcdefgh"[i % 8]);
+  }
+  contextRoundTrip(input);
+
+  /* The total is stored little-endian at the start of the trailer, so
+   * these claim 2001 and 1999 bytes. */
+  const size_t total = compressed.size() - HUFFMAN_TRAILER_SIZE;
+  for (int delta : {1, -1}) {
+    std::vector<uint8_t> corrupted = compressed;
+    corrupted[total] = (uint8_t)(corrupted[total] + delta);
+    size_t outputSize = 0;
+    ASSERT_EQ(decompressBuffer(corrupted.data(), corrupted.size(),
+                               decompressed.data(), decompressed.size(),
+                               &outputSize),
+              EXIT_FAILURE)
+        << delta;
+    ASSERT_EQ(decompressBufferWithContext(
+                  psContext, corrupted.data(), corrupted.size(),
+                  decompressed.data(), decompressed.size(), &outputSize),
+              EXIT_FAILURE)
+        << delta;
+  }
+}
+
+/**
+ * @brief Test blocks with checksums round trip, with every kind of block,
+ * and grow the container by the checksums alone.
+ *
+ */
+TEST_F(CodecTest, test_compressBuffer_Checksum) {
+  std::vector<uint8_t> input(40000);
+  std::mt19937 generator(12);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] = (i < 10000) ? (uint8_t)generator()
+                           : (uint8_t)("etaoinshrdlu"[generator() % 12]);
+  }
+  sHuffmanCompressOptions_t sOptions;
+  initCompressOptions(&sOptions);
+  sOptions.blockSize = 10000;
+  roundTrip(input, &sOptions);
+  const std::vector<uint8_t> plain = compressed;
+
+  sOptions.isChecksumEnabled = true;
+  roundTrip(input, &sOptions);
+  ASSERT_EQ(compressed.size(), plain.size() + (4 * HUFFMAN_CHECKSUM_SIZE));
+  ASSERT_EQ(compressed[HUFFMAN_HEADER_SIZE + 8],
+            HUFFMAN_BLOCK_FLAG_STORED | HUFFMAN_BLOCK_FLAG_CHECKSUM);
+
+  /* Sync points, threads and contexts verify the same checksums. */
+  sOptions.syncInterval = 100;
+  psContext = createHuffmanContext(NULL);
+  ASSERT_NE(psContext, nullptr);
+  contextRoundTrip(input, &sOptions);
+  std::vector<uint8_t> range(50);
+  ASSERT_EQ(decompressRange(compressed.data(), compressed.size(), 25000,
+                            range.size(), range.data()),
+            EXIT_SUCCESS);
+  ASSERT_TRUE(std::equal(range.begin(), range.end(), &input[25000]));
+
+  sOptions.syncInterval = 0;
+  roundTrip(input, &sOptions);
+  size_t outputSize = 0;
+  ASSERT_EQ(decompressBufferWithThreads(compressed.data(), compressed.size(),
+                                        decompressed.data(),
+                                        decompressed.size(), &outputSize, 4),
+            EXIT_SUCCESS);
+  ASSERT_EQ(decompressed, input);
+}
+
+/**
+ * @brief Test a block whose bytes or checksum are corrupted fails to
+ * decompress.
+ *
+ */
+TEST_F(CodecTest, test_decompressBuffer_ChecksumMismatch) {
+  std::vector<uint8_t> input(3000);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] = (uint8_t)((i < 1000) ? (i * 131) % 251 : "abcd"[i % 4]);
+  }
+  sHuffmanCompressOptions_t sOptions;
+  initCompressOptions(&sOptions);
+  sOptions.blockSize = 1000;
+  sOptions.isChecksumEnabled = true;
+  roundTrip(input, &sOptions);
+  const std::vector<uint8_t> original = compressed;
+  size_t outputSize = 0;
+
+  /* A byte of the stored first block. */
+  compressed[HUFFMAN_HEADER_SIZE + HUFFMAN_BLOCK_HEADER_SIZE + 10] ^= 0x01;
+  ASSERT_EQ(decompressBuffer(compressed.data(), compressed.size(),
+                             decompressed.data(), decompressed.size(),
+                             &outputSize),
+            EXIT_FAILURE);
+
+  /* The checksum of the first block. */
+  compressed = original;
+  compressed[HUFFMAN_HEADER_SIZE + HUFFMAN_BLOCK_HEADER_SIZE + 1000] ^= 0x80;
+  ASSERT_EQ(decompressBuffer(compressed.data(), compressed.size(),
+                             decompressed.data(), decompressed.size(),
+                             &outputSize),
+            EXIT_FAILURE);
+
+  /* A code of the last block that still decodes to a valid symbol. */
+  compressed = original;
+  compressed[compressed.size() - HUFFMAN_TRAILER_SIZE - (3 * 8) - 4 -
+             HUFFMAN_CHECKSUM_SIZE - 1] ^= 0x01;
+  ASSERT_EQ(decompressBuffer(compressed.data(), compressed.size(),
+                             decompressed.data(), decompressed.size(),
+                             &outputSize),
+            EXIT_FAILURE);
+}
+
+/**
+ * @brief Test blocks with sampled frequencies round trip and compress almost
+ * as well, and that tiny alphabets and threads still count every byte.
+ *
+ */
+TEST_F(CodecTest, test_compressBuffer_Sampled) {
+  std::vector<uint8_t> input(2 * HUFFMAN_SAMPLE_MIN_BLOCK_SIZE);
+  std::mt19937 generator(15);
+  std::geometric_distribution<int> distribution(0.08);
+  for (uint8_t& byte : input) {
+    byte = (uint8_t)(' ' + (distribution(generator) % 64));
+  }
+  sHuffmanCompressOptions_t sOptions;
+  initCompressOptions(&sOptions);
+  sOptions.blockSize = HUFFMAN_SAMPLE_MIN_BLOCK_SIZE;
+  roundTrip(input, &sOptions);
+  const std::vector<uint8_t> exact = compressed;
+
+  sOptions.sampleInterval = 8;
+  resetHuffmanStats();
+  psContext = createHuffmanContext(NULL);
+  ASSERT_NE(psContext, nullptr);
+  contextRoundTrip(input, &sOptions);
+  ASSERT_LT(compressed.size(), exact.size() + (exact.size() / 100));
+  sHuffmanStats_t sStats;
+  getHuffmanStats(&sStats);
+  EXPECT_EQ(sStats.blocksSampled, 4U);
+  EXPECT_EQ(sStats.blocksStored, 0U);
+
+  /* The codes are only known to fit once they are written. */
+  const std::vector<uint8_t> sampled = compressed;
+  std::vector<uint8_t> output(sampled.size());
+  size_t outputSize = 0;
+  ASSERT_EQ(compressBuffer(input.data(), input.size(), output.data(),
+                           output.size(), &outputSize, &sOptions),
+            EXIT_SUCCESS);
+  ASSERT_EQ(output, sampled);
+  ASSERT_EQ(compressBuffer(input.data(), input.size(), output.data(),
+                           output.size() - 1, &outputSize, &sOptions),
+            EXIT_FAILURE);
+
+  sOptions.syncInterval = 4096;
+  roundTrip(input, &sOptions);
+  std::vector<uint8_t> range(300);
+  ASSERT_EQ(decompressRange(compressed.data(), compressed.size(), 1500000,
+                            range.size(), range.data()),
+            EXIT_SUCCESS);
+  ASSERT_TRUE(std::equal(range.begin(), range.end(), &input[1500000]));
+
+  sOptions.syncInterval = 0;
+  sOptions.threadCount = 4;
+  roundTrip(input, &sOptions);
+  ASSERT_EQ(compressed, exact);
+
+  for (uint8_t& byte : input) {
+    byte = (uint8_t)"ACGT"[generator() % 4];
+  }
+  sOptions.threadCount = 1;
+  sOptions.sampleInterval = 0;
+  roundTrip(input, &sOptions);
+  const std::vector<uint8_t> tiny = compressed;
+  sOptions.sampleInterval = 8;
+  roundTrip(input, &sOptions);
+  ASSERT_EQ(compressed, tiny);
+}
+
+/**
+ * @brief Test a block whose sample is unlike the rest of it is stored once
+ * its codes outgrow it.
+ *
+ */
+TEST_F(CodecTest, test_compressBuffer_SampledStored) {
+  /* Each run uses 17 bytes, and a single run is sampled. */
+  std::vector<uint8_t> input(HUFFMAN_SAMPLE_MIN_BLOCK_SIZE);
+  for (size_t i = 0; i < input.size(); i++) {
+    const size_t run = i / HUFFMAN_SAMPLE_RUN_SIZE;
+    input[i] = (uint8_t)((run * 17) + ((i * 7) % 17));
+  }
+  sHuffmanCompressOptions_t sOptions;
+  initCompressOptions(&sOptions);
+  sOptions.blockSize = input.size();
+  sOptions.sampleInterval = input.size() / HUFFMAN_SAMPLE_RUN_SIZE;
+
+  for (const size_t syncInterval : {size_t{0}, size_t{1000}}) {
+    sOptions.syncInterval = syncInterval;
+    resetHuffmanStats();
+    roundTrip(input, &sOptions);
+    ASSERT_EQ(compressed[HUFFMAN_HEADER_SIZE + 8], HUFFMAN_BLOCK_FLAG_STORED);
+    sHuffmanStats_t sStats;
+    getHuffmanStats(&sStats);
+    EXPECT_EQ(sStats.blocksSampled, 1U);
+    EXPECT_GT(sStats.aStageBytes[HUFFMAN_STAGE_ENCODE], 0U);
+  }
+}
+
+/**
+ * @brief Test a context produces the same containers as compressBuffer and
+ * decompresses them, across inputs that reuse and replace its tables.
+ *
+ */
+TEST_F(CodecTest, test_compressBufferWithContext) {
+  psContext = createHuffmanContext(NULL);
+  ASSERT_NE(psContext, nullptr);
+
+  sHuffmanCompressOptions_t sOptions;
+  initCompressOptions(&sOptions);
+  sOptions.blockSize = 100;
+
+  /* Long codes need the canonical decoder rather than the table alone. */
+  std::vector<uint8_t> longCodes;
+  size_t previous = 1;
+  size_t current = 1;
+  for (uint8_t symbol = 0; symbol < 24; symbol++) {
+    longCodes.insert(longCodes.end(), current, symbol);
+    const size_t next = previous + current;
+    previous = current;
+    current = next;
+  }
+  std::shuffle(longCodes.begin(), longCodes.end(), std::mt19937(2));
+
+  std::mt19937 generator(3);
+  std::geometric_distribution<int> distribution(0.2);
+  std::vector<uint8_t> geometric(5000);
+  for (uint8_t& byte : geometric) {
+    byte = (uint8_t)distribution(generator);
+  }
+
+  contextRoundTrip({});
+  contextRoundTrip(std::vector<uint8_t>(1000, 'z'));
+  contextRoundTrip(std::vector<uint8_t>(1000, 'z'));
+  contextRoundTrip(longCodes);
+  contextRoundTrip(geometric, &sOptions);
+  resetHuffmanContext(psContext);
+  contextRoundTrip(longCodes);
+  contextRoundTrip(geometric);
+}
+
+/**
+ * @brief Test a context only allocates when it is created.
+ *
+ */
+TEST_F(CodecTest, test_compressBufferWithContext_NoAllocations) {
+  sHuffmanTrackingAllocator_t sTracker;
+  initTrackingAllocator(&sTracker, NULL);
+  psContext = createHuffmanContext(&sTracker.sAllocator);
+  ASSERT_NE(psContext, nullptr);
+  ASSERT_EQ(sTracker.sTotal.allocations, 1U);
+
+  std::vector<uint8_t> input(3000);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] = (uint8_t)((i * i) % 61);
+  }
+  std::vector<uint8_t> output(getCompressBound(input.size(), NULL));
+  std::vector<uint8_t> result(input.size());
+
+  for (int i = 0; i < 10; i++) {
+    size_t compressedSize = 0;
+    size_t outputSize = 0;
+    ASSERT_EQ(compressBufferWithContext(psContext, input.data(), input.size(),
+                                        output.data(), output.size(),
+                                        &compressedSize, NULL),
+              EXIT_SUCCESS);
+    ASSERT_EQ(decompressBufferWithContext(psContext, output.data(),
+                                          compressedSize, result.data(),
+                                          result.size(), &outputSize),
+              EXIT_SUCCESS);
+    ASSERT_EQ(result, input);
+  }
+
+  ASSERT_EQ(sTracker.sTotal.allocations, 1U);
+  ASSERT_EQ(sTracker.sTotal.frees, 0U);
+
+  freeHuffmanContext(psContext);
+  psContext = NULL;
+  ASSERT_EQ(sTracker.sTotal.frees, 1U);
+  ASSERT_EQ(sTracker.sTotal.currentBytes, 0U);
+}
+
+/**
+ * @brief Test small inputs compress without allocating, even with long
+ * codes, and larger inputs still use the allocator.
+ *
+ */
+TEST_F(CodecTest, test_compressBuffer_SmallInputNoAllocations) {
+  /* A Fibonacci distribution over 15 symbols fits in the small input size
+     and gives codes longer than the decode table. */
+  std::vector<uint8_t> input;
+  size_t previous = 1;
+  size_t current = 1;
+  for (uint8_t symbol = 0; symbol < 15; symbol++) {
+    input.insert(input.end(), current, symbol);
+    const size_t next = previous + current;
+    previous = current;
+    current = next;
+  }
+  std::shuffle(input.begin(), input.end(), std::mt19937(3));
+  ASSERT_LE(input.size(), HUFFMAN_SMALL_INPUT_SIZE);
+
+  sHuffmanTrackingAllocator_t sTracker;
+  initTrackingAllocator(&sTracker, NULL);
+  sHuffmanCompressOptions_t sOptions;
+  initCompressOptions(&sOptions);
+  sOptions.psAllocator = &sTracker.sAllocator;
+
+  for (size_t size : {(size_t)0, (size_t)1, (size_t)100, input.size()}) {
+    const std::vector<uint8_t> part(input.begin(), input.begin() + size);
+    std::vector<uint8_t> output(getCompressBound(size, &sOptions));
+    size_t compressedSize = 0;
+    ASSERT_EQ(compressBuffer(part.data(), part.size(), output.data(),
+                             output.size(), &compressedSize, &sOptions),
+              EXIT_SUCCESS);
+    std::vector<uint8_t> result(size);
+    size_t outputSize = 0;
+    ASSERT_EQ(decompressBuffer(output.data(), compressedSize, result.data(),
+                               result.size(), &outputSize),
+              EXIT_SUCCESS);
+    ASSERT_EQ(result, part);
+  }
+  ASSERT_EQ(sTracker.sTotal.allocations, 0U);
+
+  input.resize(HUFFMAN_SMALL_INPUT_SIZE + 1, 0);
+  std::vector<uint8_t> output(getCompressBound(input.size(), &sOptions));
+  size_t compressedSize = 0;
+  ASSERT_EQ(compressBuffer(input.data(), input.size(), output.data(),
+                           output.size(), &compressedSize, &sOptions),
+            EXIT_SUCCESS);
+  ASSERT_GT(sTracker.sTotal.allocations, 0U);
+  ASSERT_EQ(sTracker.sTotal.currentBytes, 0U);
+}
+
+/**
+ * @brief Test a context rejects a corrupted container and still decodes
+ * afterwards.
+ *
+ */
+TEST_F(CodecTest, test_decompressBufferWithContext_Corrupted) {
+  psContext = createHuffmanContext(NULL);
+  ASSERT_NE(psContext, nullptr);
+
+  std::vector<uint8_t> input(2000);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] = (uint8_t)("abcdefgh"[i % 8]);
+  }
+  contextRoundTrip(input);
+
+  /* Break the code lengths of the first block. */
+  std::vector<uint8_t> corrupted = compressed;
+  corrupted[HUFFMAN_HEADER_SIZE + HUFFMAN_BLOCK_HEADER_SIZE] = 0xFF;
+  size_t outputSize = 0;
+  ASSERT_EQ(decompressBufferWithContext(psContext, corrupted.data(),
+                                        corrupted.size(), decompressed.data(),
+                                        decompressed.size(), &outputSize),
+            EXIT_FAILURE);
+
+  contextRoundTrip(input);
+}
+
+/**
+ * @brief Test a corrupted single-symbol block is rejected, both by a stack
+ * context and by a context left with the long codes of an earlier block.
+ *
+ */
+TEST_F(CodecTest, test_decompressBuffer_SingleSymbolCorrupted) {
+  psContext = createHuffmanContext(NULL);
+  ASSERT_NE(psContext, nullptr);
+
+  std::vector<uint8_t> longCodes;
+  size_t previous = 1;
+  size_t current = 1;
+  for (uint8_t symbol = 0; symbol < 24; symbol++) {
+    longCodes.insert(longCodes.end(), current, symbol);
+    const size_t next = previous + current;
+    previous = current;
+    current = next;
+  }
+  contextRoundTrip(longCodes);
+
+  /* The only code is a single 0 bit, so a 1 bit starts no code. Flipping
+   * the last code leaves only padding after it, which an earlier block's
+   * tree would decode as a symbol. */
+  contextRoundTrip(std::vector<uint8_t>(2001, 'x'));
+  compressed[HUFFMAN_HEADER_SIZE + HUFFMAN_BLOCK_HEADER_SIZE +
+             HUFFMAN_CODE_LENGTHS_SIZE + 250] ^= 0x01;
+  size_t outputSize = 0;
+  ASSERT_EQ(decompressBuffer(compressed.data(), compressed.size(),
+                             decompressed.data(), decompressed.size(),
+                             &outputSize),
+            EXIT_FAILURE);
+  ASSERT_EQ(decompressBufferWithContext(psContext, compressed.data(),
+                                        compressed.size(), decompressed.data(),
+                                        decompressed.size(), &outputSize),
+            EXIT_FAILURE);
+}
+
+/**
+ * @brief Test ranges decoded from sync points match the input, including
+ * ranges that span blocks and blocks with codes longer than the table.
+ *
+ */
+TEST_F(CodecTest, test_decompressRange) {
+  psContext = createHuffmanContext(NULL);
+  ASSERT_NE(psContext, nullptr);
+
+  std::vector<uint8_t> input;
+  size_t previous = 1;
+  size_t current = 1;
+  for (uint8_t symbol = 0; symbol < 20; symbol++) {
+    input.insert(input.end(), current, symbol);
+    const size_t next = previous + current;
+    previous = current;
+    current = next;
+  }
+  std::shuffle(input.begin(), input.end(), std::mt19937(11));
+
+  sHuffmanCompressOptions_t sOptions;
+  initCompressOptions(&sOptions);
+  sOptions.blockSize = 4096;
+  sOptions.syncInterval = 100;
+  contextRoundTrip(input, &sOptions);
+  ASSERT_EQ(compressed[HUFFMAN_HEADER_SIZE + 8],
+            HUFFMAN_BLOCK_FLAG_SYNC_POINTS);
+
+  const size_t aRanges[][2] = {{0, 1},     {99, 2},    {100, 100},
+                               {4000, 200}, {4095, 1}, {4096, 4096},
+                               {5000, 9000}, {0, input.size()},
+                               {input.size() - 1, 1}, {input.size(), 0}};
+  for (const size_t* range : aRanges) {
+    const std::vector<uint8_t> expected(input.begin() + range[0],
+                                        input.begin() + range[0] + range[1]);
+    std::vector<uint8_t> output(range[1]);
+    ASSERT_EQ(decompressRange(compressed.data(), compressed.size(), range[0],
+                              range[1], output.data()),
+              EXIT_SUCCESS);
+    ASSERT_EQ(output, expected) << "offset " << range[0];
+    std::fill(output.begin(), output.end(), 0);
+    ASSERT_EQ(decompressRangeWithContext(psContext, compressed.data(),
+                                         compressed.size(), range[0],
+                                         range[1], output.data()),
+              EXIT_SUCCESS);
+    ASSERT_EQ(output, expected) << "offset " << range[0];
+  }
+
+  /* Containers without sync points decode ranges from block starts. */
+  sOptions.syncInterval = 0;
+  roundTrip(input, &sOptions);
+  std::vector<uint8_t> output(3000);
+  ASSERT_EQ(decompressRange(compressed.data(), compressed.size(), 7000,
+                            output.size(), output.data()),
+            EXIT_SUCCESS);
+  ASSERT_TRUE(std::equal(output.begin(), output.end(), input.begin() + 7000));
+}
+
+/**
+ * @brief Test ranges past the end of a container and malformed sync points
+ * are rejected.
+ *
+ */
+TEST_F(CodecTest, test_decompressRange_Invalid) {
+  std::vector<uint8_t> input(5000);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] = (uint8_t)((i * i) % 23);
+  }
+  sHuffmanCompressOptions_t sOptions;
+  initCompressOptions(&sOptions);
+  sOptions.syncInterval = 64;
+  roundTrip(input, &sOptions);
+
+  uint8_t output[16];
+  ASSERT_EQ(decompressRange(compressed.data(), compressed.size(),
+                            input.size() - 8, 16, output),
+            EXIT_FAILURE);
+  ASSERT_EQ(decompressRange(compressed.data(), compressed.size(), 8,
+                            SIZE_MAX, output),
+            EXIT_FAILURE);
+
+  /* Point the last sync point past the end of the payload. */
+  const size_t syncPoints = HUFFMAN_HEADER_SIZE + HUFFMAN_BLOCK_HEADER_SIZE +
+                            HUFFMAN_CODE_LENGTHS_SIZE + 4;
+  const size_t syncPointCount = (input.size() - 1) / 64;
+  compressed[syncPoints + ((syncPointCount - 1) * HUFFMAN_SYNC_POINT_SIZE) +
+             11] = 0x7F;
+  ASSERT_EQ(decompressRange(compressed.data(), compressed.size(),
+                            input.size() - 4, 4, output),
+            EXIT_FAILURE);
+  ASSERT_EQ(decompressRange(compressed.data(), compressed.size(), 0, 16,
+                            output),
+            EXIT_SUCCESS);
+  ASSERT_TRUE(std::equal(output, output + 16, input.begin()));
+}
+
+/**
+ * @brief Test searching a container finds the same offsets as searching its
+ * input, including matches that span blocks, and with or without sync points.
+ *
+ */
+TEST_F(CodecTest, test_searchContainer) {
+  psContext = createHuffmanContext(NULL);
+  ASSERT_NE(psContext, nullptr);
+
+  std::mt19937 generator(13);
+  std::geometric_distribution<int> distribution(0.3);
+  std::vector<uint8_t> input(20000);
+  for (uint8_t& byte : input) {
+    byte = (uint8_t)distribution(generator);
+  }
+  const std::vector<uint8_t> aPatterns[] = {
+      {0},
+      {1, 0, 2},
+      std::vector<uint8_t>(input.begin() + 2990, input.begin() + 3020),
+      std::vector<uint8_t>(input.begin() + 100, input.begin() + 356),
+      {0xFF}};
+
+  sHuffmanCompressOptions_t sOptions;
+  initCompressOptions(&sOptions);
+  sOptions.blockSize = 3000;
+  for (uint32_t syncInterval : {0U, 1U, 64U}) {
+    sOptions.syncInterval = syncInterval;
+    roundTrip(input, &sOptions);
+
+    for (const std::vector<uint8_t>& pattern : aPatterns) {
+      std::vector<size_t> expected;
+      for (auto it = input.begin();
+           (it = std::search(it, input.end(), pattern.begin(),
+                             pattern.end())) != input.end();
+           ++it) {
+        expected.push_back((size_t)(it - input.begin()));
+      }
+
+      std::vector<size_t> offsets(input.size());
+      size_t count = 0;
+      ASSERT_EQ(searchContainer(compressed.data(), compressed.size(),
+                                pattern.data(), pattern.size(), 0,
+                                offsets.data(), offsets.size(), &count),
+                EXIT_SUCCESS);
+      offsets.resize(count);
+      ASSERT_EQ(offsets, expected) << "sync interval " << syncInterval;
+
+      /* Resume after a capped search, as a caller paging through hits does. */
+      if (expected.size() > 2) {
+        ASSERT_EQ(searchContainerWithContext(
+                      psContext, compressed.data(), compressed.size(),
+                      pattern.data(), pattern.size(), expected[1] + 1,
+                      offsets.data(), 1, &count),
+                  EXIT_SUCCESS);
+        ASSERT_EQ(count, 1U);
+        ASSERT_EQ(offsets[0], expected[2]);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Test searches with invalid patterns or corrupt containers are
+ * rejected.
+ *
+ */
+TEST_F(CodecTest, test_searchContainer_Invalid) {
+  std::vector<uint8_t> input(5000);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] = (uint8_t)((i * i) % 23);
+  }
+  roundTrip(input);
+
+  const std::vector<uint8_t> pattern(HUFFMAN_MAX_SEARCH_PATTERN_SIZE + 1, 1);
+  size_t offsets[4];
+  size_t count = 0;
+  ASSERT_EQ(searchContainer(compressed.data(), compressed.size(),
+                            pattern.data(), 0, 0, offsets, 4, &count),
+            EXIT_FAILURE);
+  ASSERT_EQ(searchContainer(compressed.data(), compressed.size(),
+                            pattern.data(), pattern.size(), 0, offsets, 4,
+                            &count),
+            EXIT_FAILURE);
+  ASSERT_EQ(searchContainer(compressed.data(), compressed.size(),
+                            pattern.data(), 1, 0, offsets, 0, &count),
+            EXIT_FAILURE);
+
+  /* Searching past the end finds nothing. */
+  ASSERT_EQ(searchContainer(compressed.data(), compressed.size(),
+                            pattern.data(), 1, input.size(), offsets, 4,
+                            &count),
+            EXIT_SUCCESS);
+  ASSERT_EQ(count, 0U);
+
+  compressed[0] = 'X';
+  ASSERT_EQ(searchContainer(compressed.data(), compressed.size(),
+                            pattern.data(), 1, 0, offsets, 4, &count),
+            EXIT_FAILURE);
+}
+
+/**
+ * @brief Test a batch of small messages shares one table and compresses
+ * better than coding each message on its own.
+ *
+ */
+TEST_F(CodecTest, test_compressBatchWithContext) {
+  psContext = createHuffmanContext(NULL);
+  ASSERT_NE(psContext, nullptr);
+
+  const char* words[] = {"get", "put", "user", "id", "status", "ok", "error"};
+  std::mt19937 generator(5);
+  std::vector<std::vector<uint8_t>> buffers(200);
+  size_t separateSize = 0;
+  for (std::vector<uint8_t>& buffer : buffers) {
+    const size_t wordCount = generator() % 12;
+    for (size_t i = 0; i < wordCount; i++) {
+      const char* word = words[generator() % 7];
+      buffer.insert(buffer.end(), word, word + strlen(word));
+      buffer.push_back(' ');
+    }
+
+    size_t compressedSize = 0;
+    std::vector<uint8_t> output(getCompressBound(buffer.size(), NULL));
+    ASSERT_EQ(compressBufferWithContext(psContext, buffer.data(),
+                                        buffer.size(), output.data(),
+                                        output.size(), &compressedSize, NULL),
+              EXIT_SUCCESS);
+    separateSize += compressedSize;
+  }
+
+  batchRoundTrip(buffers);
+
+  ASSERT_LT(compressed.size(), separateSize / 2);
+  ASSERT_EQ(compressed[5] & HUFFMAN_BLOCK_FLAG_STORED, 0);
+}
+
+/**
+ * @brief Test batches that are stored, empty or only hold a single symbol.
+ *
+ */
+TEST_F(CodecTest, test_compressBatchWithContext_Edges) {
+  psContext = createHuffmanContext(NULL);
+  ASSERT_NE(psContext, nullptr);
+
+  std::mt19937 generator(6);
+  std::vector<std::vector<uint8_t>> random(20, std::vector<uint8_t>(64));
+  for (std::vector<uint8_t>& buffer : random) {
+    for (uint8_t& byte : buffer) {
+      byte = (uint8_t)generator();
+    }
+  }
+  batchRoundTrip(random);
+  ASSERT_NE(compressed[5] & HUFFMAN_BLOCK_FLAG_STORED, 0);
+
+  batchRoundTrip({});
+  batchRoundTrip({{}, {}, {}});
+  batchRoundTrip({std::vector<uint8_t>(500, 'a'), {}, {'a'}});
+}
+
+/**
+ * @brief Test a corrupted or truncated batch and a small output are
+ * rejected.
+ *
+ */
+TEST_F(CodecTest, test_decompressBatchWithContext_Corrupted) {
+  psContext = createHuffmanContext(NULL);
+  ASSERT_NE(psContext, nullptr);
+  batchRoundTrip({std::vector<uint8_t>(300, 'x'), {'x', 'y', 'z'},
+                  std::vector<uint8_t>(200, 'y')});
+
+  size_t outputSize = 0;
+  std::vector<uint8_t> corrupted = compressed;
+  corrupted[0] = 'X';
+  ASSERT_EQ(decompressBatchWithContext(psContext, corrupted.data(),
+                                       corrupted.size(), decompressed.data(),
+                                       decompressed.size(), NULL, &outputSize),
+            EXIT_FAILURE);
+
+  ASSERT_EQ(decompressBatchWithContext(psContext, compressed.data(),
+                                       compressed.size() - 1,
+                                       decompressed.data(),
+                                       decompressed.size(), NULL, &outputSize),
+            EXIT_FAILURE);
+
+  ASSERT_EQ(decompressBatchWithContext(psContext, compressed.data(),
+                                       compressed.size(), decompressed.data(),
+                                       decompressed.size() - 1, NULL,
+                                       &outputSize),
+            EXIT_FAILURE);
+
+  /* A payload size pointing past the end of the batch. */
+  corrupted = compressed;
+  corrupted[HUFFMAN_BATCH_HEADER_SIZE + HUFFMAN_CODE_LENGTHS_SIZE + 4] = 0xFF;
+  ASSERT_EQ(decompressBatchWithContext(psContext, corrupted.data(),
+                                       corrupted.size(), decompressed.data(),
+                                       decompressed.size(), NULL, &outputSize),
+            EXIT_FAILURE);
+}
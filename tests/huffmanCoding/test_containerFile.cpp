@@ -0,0 +1,155 @@
+/**
+ * @file test_containerFile.cpp
+ * @brief Unit tests for containerFile.c.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+/* External Includes */
+
+#include <gtest/gtest.h>
+
+/* Standard Library Includes */
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+/* Project Includes */
+
+extern "C" {
+#include "huffmanCoding/codec.h"
+#include "huffmanCoding/containerFile.h"
+}
+
+/* Test Fixtures */
+
+/**
+ * @brief Container file test fixture, with a path to append to.
+ *
+ */
+class ContainerFileTest : public ::testing::Test {
+ protected:
+  std::string path;
+
+  void SetUp() override {
+    path = "/tmp/huffman_container_" + std::to_string(getpid());
+    (void)std::remove(path.c_str());
+  }
+
+  void TearDown() override { (void)std::remove(path.c_str()); }
+
+  /**
+   * @brief Read a whole file.
+   *
+   * @return std::vector<uint8_t> The file's bytes.
+   */
+  std::vector<uint8_t> readFile() const {
+    std::vector<uint8_t> bytes;
+    FILE* pFile = std::fopen(path.c_str(), "rb");
+    if (pFile != NULL) {
+      uint8_t aBuffer[4096];
+      size_t count = 0;
+      while ((count = std::fread(aBuffer, 1, sizeof(aBuffer), pFile)) > 0) {
+        bytes.insert(bytes.end(), aBuffer, aBuffer + count);
+      }
+      (void)std::fclose(pFile);
+    }
+    return bytes;
+  }
+};
+
+/* Unit Tests */
+
+/**
+ * @brief Test a file built by several appends decompresses to all of them.
+ *
+ */
+TEST_F(ContainerFileTest, test_appendToContainerFile) {
+  sHuffmanCompressOptions_t sOptions;
+  initCompressOptions(&sOptions);
+  sOptions.blockSize = 3000;
+
+  std::mt19937 generator(5);
+  std::geometric_distribution<int> distribution(0.2);
+  std::vector<uint8_t> expected;
+  for (size_t size : {0, 1, 2500, 7000, 400}) {
+    std::vector<uint8_t> input(size);
+    for (uint8_t& byte : input) {
+      byte = (uint8_t)distribution(generator);
+    }
+    ASSERT_EQ(appendToContainerFile(path.c_str(), input.data(), input.size(),
+                                    &sOptions),
+              EXIT_SUCCESS);
+    expected.insert(expected.end(), input.begin(), input.end());
+
+    const std::vector<uint8_t> container = readFile();
+    size_t outputSize = 0;
+    ASSERT_EQ(getDecompressedSize(container.data(), container.size(),
+                                  &outputSize),
+              EXIT_SUCCESS);
+    ASSERT_EQ(outputSize, expected.size());
+    std::vector<uint8_t> output(outputSize);
+    ASSERT_EQ(decompressBuffer(container.data(), container.size(),
+                               output.data(), output.size(), &outputSize),
+              EXIT_SUCCESS);
+    ASSERT_EQ(output, expected);
+  }
+}
+
+/**
+ * @brief Test appending to a file that is not a container leaves it
+ * unchanged.
+ *
+ */
+TEST_F(ContainerFileTest, test_appendToContainerFile_Invalid) {
+  const char text[] = "not a container";
+  FILE* pFile = std::fopen(path.c_str(), "wb");
+  ASSERT_NE(pFile, nullptr);
+  ASSERT_EQ(std::fwrite(text, 1, sizeof(text), pFile), sizeof(text));
+  ASSERT_EQ(std::fclose(pFile), 0);
+
+  ASSERT_EQ(appendToContainerFile(path.c_str(), (const uint8_t*)"abc", 3,
+                                  NULL),
+            EXIT_FAILURE);
+  ASSERT_EQ(readFile(), std::vector<uint8_t>(text, text + sizeof(text)));
+  ASSERT_EQ(appendToContainerFile("/tmp/huffman_missing/container",
+                                  (const uint8_t*)"abc", 3, NULL),
+            EXIT_FAILURE);
+}
+
+/**
+ * @brief Test searching a container file finds each appended match.
+ *
+ */
+TEST_F(ContainerFileTest, test_searchContainerFile) {
+  const std::string text = "one needle, two needles";
+  ASSERT_EQ(appendToContainerFile(path.c_str(), (const uint8_t*)text.data(),
+                                  text.size(), NULL),
+            EXIT_SUCCESS);
+  ASSERT_EQ(appendToContainerFile(path.c_str(), (const uint8_t*)text.data(),
+                                  text.size(), NULL),
+            EXIT_SUCCESS);
+
+  size_t aOffsets[8];
+  size_t count = 0;
+  ASSERT_EQ(searchContainerFile(path.c_str(), (const uint8_t*)"needle", 6, 0,
+                                aOffsets, 8, &count),
+            EXIT_SUCCESS);
+  const size_t aExpected[] = {4, 16, 27, 39};
+  ASSERT_EQ(count, 4U);
+  ASSERT_TRUE(std::equal(aOffsets, aOffsets + count, aExpected));
+  ASSERT_EQ(searchContainerFile("/tmp/huffman_missing/container",
+                                (const uint8_t*)"needle", 6, 0, aOffsets, 8,
+                                &count),
+            EXIT_FAILURE);
+}
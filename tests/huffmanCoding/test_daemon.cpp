@@ -0,0 +1,313 @@
+/**
+ * @file test_daemon.cpp
+ * @brief Unit tests for daemon.c and daemonClient.c.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+/* External Includes */
+
+#include <gtest/gtest.h>
+
+/* Standard Library Includes */
+
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* Project Includes */
+
+#include "testUtils.hpp"
+
+extern "C" {
+#include "huffmanCoding/codec.h"
+#include "huffmanCoding/daemon.h"
+#include "huffmanCoding/daemonClient.h"
+}
+
+/* Test Fixtures */
+
+/**
+ * @brief Daemon test fixture, running a daemon on its own thread.
+ *
+ */
+class DaemonTest : public ::testing::Test {
+ protected:
+  std::string socketPath;
+  sHuffmanDaemon_t* psDaemon = NULL;
+  std::thread daemonThread;
+  int daemonResult = EXIT_FAILURE;
+
+  void SetUp() override {
+    socketPath = "/tmp/huffman_test_" + std::to_string(getpid()) + ".sock";
+    sHuffmanDaemonOptions_t sOptions;
+    initDaemonOptions(&sOptions);
+    sOptions.pSocketPath = socketPath.c_str();
+    sOptions.workerCount = 3;
+    sOptions.maxConnections = 8;
+    psDaemon = createHuffmanDaemon(&sOptions);
+    ASSERT_NE(psDaemon, nullptr);
+    daemonThread =
+        std::thread([this]() { daemonResult = runHuffmanDaemon(psDaemon); });
+  }
+
+  void TearDown() override {
+    if (psDaemon != NULL) {
+      stopHuffmanDaemon(psDaemon);
+      daemonThread.join();
+      EXPECT_EQ(daemonResult, EXIT_SUCCESS);
+      freeHuffmanDaemon(psDaemon);
+      EXPECT_NE(access(socketPath.c_str(), F_OK), 0);
+    }
+  }
+
+  /**
+   * @brief Compress and decompress a buffer through the daemon and check the
+   * round trip.
+   *
+   * @param io_psClient The connected client.
+   * @param i_input The bytes to compress.
+   */
+  static void roundTrip(sHuffmanDaemonClient_t* io_psClient,
+                        const std::vector<uint8_t>& i_input) {
+    std::vector<uint8_t> compressed(getCompressBound(i_input.size(), NULL));
+    size_t compressedSize = 0;
+    ASSERT_EQ(requestHuffmanDaemon(io_psClient, HUFFMAN_DAEMON_COMPRESS,
+                                   i_input.data(), i_input.size(),
+                                   compressed.data(), compressed.size(),
+                                   &compressedSize),
+              EXIT_SUCCESS);
+    compressed.resize(compressedSize);
+
+    /* The daemon writes the same container as compressBuffer. */
+    std::vector<uint8_t> expected(getCompressBound(i_input.size(), NULL));
+    size_t expectedSize = 0;
+    ASSERT_EQ(compressBuffer(i_input.data(), i_input.size(), expected.data(),
+                             expected.size(), &expectedSize, NULL),
+              EXIT_SUCCESS);
+    expected.resize(expectedSize);
+    ASSERT_EQ(compressed, expected);
+
+    std::vector<uint8_t> output(i_input.size());
+    size_t outputSize = 0;
+    ASSERT_EQ(requestHuffmanDaemon(io_psClient, HUFFMAN_DAEMON_DECOMPRESS,
+                                   compressed.data(), compressed.size(),
+                                   output.data(), output.size(), &outputSize),
+              EXIT_SUCCESS);
+    ASSERT_EQ(outputSize, i_input.size());
+    ASSERT_EQ(output, i_input);
+  }
+};
+
+/* Unit Tests */
+
+/**
+ * @brief Test requests of several sizes round trip over one connection.
+ *
+ */
+TEST_F(DaemonTest, test_requestHuffmanDaemon_RoundTrip) {
+  sHuffmanDaemonClient_t sClient;
+  ASSERT_EQ(connectHuffmanDaemon(&sClient, socketPath.c_str()),
+            EXIT_SUCCESS);
+
+  const size_t aSizes[] = {0, 1, 1000, 300000, (size_t)2 << 20};
+  for (size_t size : aSizes) {
+    roundTrip(&sClient, generateGeometricBytes(size, 0.2, (uint32_t)size));
+    ASSERT_FALSE(HasFailure()) << size;
+  }
+
+  disconnectHuffmanDaemon(&sClient);
+}
+
+/**
+ * @brief Test clients on several threads are served concurrently.
+ *
+ */
+TEST_F(DaemonTest, test_requestHuffmanDaemon_Concurrent) {
+  std::vector<std::thread> threads;
+  std::vector<int> failures(8, 0);
+  for (size_t t = 0; t < failures.size(); t++) {
+    threads.emplace_back([this, t, &failures]() {
+      sHuffmanDaemonClient_t sClient;
+      if (connectHuffmanDaemon(&sClient, socketPath.c_str()) ==
+          EXIT_FAILURE) {
+        failures[t]++;
+        return;
+      }
+      for (unsigned i = 0; i < 20; i++) {
+        const std::vector<uint8_t> input =
+            generateGeometricBytes(1000 + (t * 5000) + i, 0.2,
+                                   (uint32_t)(t * 100) + i);
+        std::vector<uint8_t> compressed(getCompressBound(input.size(), NULL));
+        std::vector<uint8_t> output(input.size());
+        size_t compressedSize = 0;
+        size_t outputSize = 0;
+        if (requestHuffmanDaemon(&sClient, HUFFMAN_DAEMON_COMPRESS,
+                                 input.data(), input.size(),
+                                 compressed.data(), compressed.size(),
+                                 &compressedSize) == EXIT_FAILURE ||
+            requestHuffmanDaemon(&sClient, HUFFMAN_DAEMON_DECOMPRESS,
+                                 compressed.data(), compressedSize,
+                                 output.data(), output.size(),
+                                 &outputSize) == EXIT_FAILURE ||
+            output != input) {
+          failures[t]++;
+        }
+      }
+      disconnectHuffmanDaemon(&sClient);
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  for (int failure : failures) {
+    ASSERT_EQ(failure, 0);
+  }
+}
+
+/**
+ * @brief Test failed requests are answered and leave the connection usable.
+ *
+ */
+TEST_F(DaemonTest, test_requestHuffmanDaemon_Invalid) {
+  sHuffmanDaemonClient_t sClient;
+  ASSERT_EQ(connectHuffmanDaemon(&sClient, socketPath.c_str()),
+            EXIT_SUCCESS);
+  const std::vector<uint8_t> input = generateGeometricBytes(10000, 0.2, 1);
+  std::vector<uint8_t> output(getCompressBound(input.size(), NULL));
+  size_t outputSize = 0;
+
+  /* Not a container. */
+  ASSERT_EQ(requestHuffmanDaemon(&sClient, HUFFMAN_DAEMON_DECOMPRESS,
+                                 input.data(), input.size(), output.data(),
+                                 output.size(), &outputSize),
+            EXIT_FAILURE);
+
+  /* An unknown operation. */
+  ASSERT_EQ(requestHuffmanDaemon(&sClient, (eHuffmanDaemonOperation_t)99,
+                                 input.data(), input.size(), output.data(),
+                                 output.size(), &outputSize),
+            EXIT_FAILURE);
+
+  /* A response that does not fit in the output. */
+  ASSERT_EQ(requestHuffmanDaemon(&sClient, HUFFMAN_DAEMON_COMPRESS,
+                                 input.data(), input.size(), output.data(), 10,
+                                 &outputSize),
+            EXIT_FAILURE);
+
+  roundTrip(&sClient, input);
+  disconnectHuffmanDaemon(&sClient);
+}
+
+/**
+ * @brief Test the largest compress request is served and its container, which
+ * is larger, can be decompressed, while a larger request closes the
+ * connection before its payload is sent.
+ *
+ */
+TEST_F(DaemonTest, test_requestHuffmanDaemon_MaxMessageSize) {
+  sHuffmanDaemonClient_t sClient;
+  ASSERT_EQ(connectHuffmanDaemon(&sClient, socketPath.c_str()),
+            EXIT_SUCCESS);
+
+  /* Random bytes are stored, so the container exceeds the message limit. */
+  std::mt19937 generator(1);
+  std::vector<uint8_t> input(HUFFMAN_DAEMON_MAX_MESSAGE_SIZE);
+  for (size_t i = 0; i < input.size(); i += 4) {
+    const uint32_t word = generator();
+    (void)memcpy(&input[i], &word, sizeof(word));
+  }
+  std::vector<uint8_t> compressed(HUFFMAN_DAEMON_MAX_CONTAINER_SIZE);
+  size_t compressedSize = 0;
+  ASSERT_EQ(requestHuffmanDaemon(&sClient, HUFFMAN_DAEMON_COMPRESS,
+                                 input.data(), input.size(),
+                                 compressed.data(), compressed.size(),
+                                 &compressedSize),
+            EXIT_SUCCESS);
+  ASSERT_GT(compressedSize, HUFFMAN_DAEMON_MAX_MESSAGE_SIZE);
+
+  std::vector<uint8_t> output(input.size());
+  size_t outputSize = 0;
+  ASSERT_EQ(requestHuffmanDaemon(&sClient, HUFFMAN_DAEMON_DECOMPRESS,
+                                 compressed.data(), compressedSize,
+                                 output.data(), output.size(), &outputSize),
+            EXIT_SUCCESS);
+  ASSERT_EQ(outputSize, input.size());
+  ASSERT_TRUE(output == input);
+
+  /* Only the header of a request one byte too large is sent. */
+  uint8_t aHeader[HUFFMAN_DAEMON_HEADER_SIZE] = {HUFFMAN_DAEMON_COMPRESS};
+  const uint32_t tooLarge = (uint32_t)HUFFMAN_DAEMON_MAX_MESSAGE_SIZE + 1;
+  for (size_t i = 0; i < 4; i++) {
+    aHeader[4 + i] = (uint8_t)(tooLarge >> (8 * i));
+  }
+  ASSERT_EQ(write(sClient.socket, aHeader, sizeof(aHeader)),
+            (ssize_t)sizeof(aHeader));
+  ASSERT_EQ(read(sClient.socket, aHeader, sizeof(aHeader)), 0);
+
+  disconnectHuffmanDaemon(&sClient);
+}
+
+/**
+ * @brief Test connections beyond the limit are closed, while those already
+ * open are still served.
+ *
+ */
+TEST_F(DaemonTest, test_requestHuffmanDaemon_TooManyConnections) {
+  const std::vector<uint8_t> input = generateGeometricBytes(1000, 0.2, 1);
+  std::vector<uint8_t> output(getCompressBound(input.size(), NULL));
+  size_t outputSize = 0;
+
+  /* Each request is answered, so its connection has been accepted. */
+  std::vector<sHuffmanDaemonClient_t> clients(8);
+  for (sHuffmanDaemonClient_t& sClient : clients) {
+    ASSERT_EQ(connectHuffmanDaemon(&sClient, socketPath.c_str()),
+              EXIT_SUCCESS);
+    ASSERT_EQ(requestHuffmanDaemon(&sClient, HUFFMAN_DAEMON_COMPRESS,
+                                   input.data(), input.size(), output.data(),
+                                   output.size(), &outputSize),
+              EXIT_SUCCESS);
+  }
+
+  sHuffmanDaemonClient_t sExtra;
+  ASSERT_EQ(connectHuffmanDaemon(&sExtra, socketPath.c_str()), EXIT_SUCCESS);
+  ASSERT_EQ(requestHuffmanDaemon(&sExtra, HUFFMAN_DAEMON_COMPRESS,
+                                 input.data(), input.size(), output.data(),
+                                 output.size(), &outputSize),
+            EXIT_FAILURE);
+  disconnectHuffmanDaemon(&sExtra);
+
+  roundTrip(&clients[0], input);
+  for (sHuffmanDaemonClient_t& sClient : clients) {
+    disconnectHuffmanDaemon(&sClient);
+  }
+}
+
+/**
+ * @brief Test invalid options are rejected and connecting to a missing
+ * daemon fails.
+ *
+ */
+TEST(DaemonOptionsTest, test_createHuffmanDaemon_Invalid) {
+  sHuffmanDaemonOptions_t sOptions;
+  initDaemonOptions(&sOptions);
+  ASSERT_EQ(createHuffmanDaemon(&sOptions), nullptr);
+
+  const std::string longPath(200, 'x');
+  sOptions.pSocketPath = longPath.c_str();
+  ASSERT_EQ(createHuffmanDaemon(&sOptions), nullptr);
+
+  sHuffmanDaemonClient_t sClient;
+  ASSERT_EQ(connectHuffmanDaemon(&sClient, "/tmp/huffman_missing.sock"),
+            EXIT_FAILURE);
+}
@@ -0,0 +1,332 @@
+/**
+ * @file test_decodeKernel.cpp
+ * @brief Unit tests for decodeKernel.c.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+/* External Includes */
+
+#include <gtest/gtest.h>
+
+/* Standard Library Includes */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+/* Project Includes */
+
+extern "C" {
+#include "huffmanCoding/bitStream.h"
+#include "huffmanCoding/checksum.h"
+#include "huffmanCoding/codec.h"
+#include "huffmanCoding/decodeKernel.h"
+#include "huffmanCoding/huffmanTree.h"
+}
+
+/* Test Fixtures */
+
+/**
+ * @brief Decode kernel test fixture, restoring the selected decode and
+ * checksum kernels.
+ *
+ */
+class DecodeKernelTest : public ::testing::Test {
+ protected:
+  eHuffmanDecodeKernel_t ePrevious = HUFFMAN_DECODE_KERNEL_PORTABLE;
+  eHuffmanChecksumKernel_t ePreviousChecksum =
+      HUFFMAN_CHECKSUM_KERNEL_PORTABLE;
+
+  /**
+   * @brief Remember the kernels selected at startup.
+   *
+   */
+  void SetUp() override {
+    ePrevious = getDecodeKernel();
+    ePreviousChecksum = getChecksumKernel();
+  }
+
+  /**
+   * @brief Restore the kernels selected at startup.
+   *
+   */
+  void TearDown() override {
+    (void)setDecodeKernel(ePrevious);
+    (void)setChecksumKernel(ePreviousChecksum);
+  }
+};
+
+/* Unit Tests */
+
+/**
+ * @brief Test selecting decode kernels and their names.
+ *
+ */
+TEST_F(DecodeKernelTest, test_setDecodeKernel) {
+  ASSERT_TRUE(isDecodeKernelSupported(HUFFMAN_DECODE_KERNEL_PORTABLE));
+  ASSERT_EQ(setDecodeKernel(HUFFMAN_DECODE_KERNEL_PORTABLE), EXIT_SUCCESS);
+  ASSERT_EQ(getDecodeKernel(), HUFFMAN_DECODE_KERNEL_PORTABLE);
+  ASSERT_STREQ(getDecodeKernelName(HUFFMAN_DECODE_KERNEL_PORTABLE),
+               "portable");
+  ASSERT_STREQ(getDecodeKernelName(HUFFMAN_DECODE_KERNEL_BMI2), "bmi2");
+  ASSERT_STREQ(getDecodeKernelName(HUFFMAN_DECODE_KERNEL_MAX), "unknown");
+
+  if (isDecodeKernelSupported(HUFFMAN_DECODE_KERNEL_BMI2)) {
+    ASSERT_EQ(setDecodeKernel(HUFFMAN_DECODE_KERNEL_BMI2), EXIT_SUCCESS);
+    ASSERT_EQ(getDecodeKernel(), HUFFMAN_DECODE_KERNEL_BMI2);
+  } else {
+    ASSERT_EQ(setDecodeKernel(HUFFMAN_DECODE_KERNEL_BMI2), EXIT_FAILURE);
+    ASSERT_EQ(getDecodeKernel(), HUFFMAN_DECODE_KERNEL_PORTABLE);
+  }
+  ASSERT_EQ(setDecodeKernel(HUFFMAN_DECODE_KERNEL_MAX), EXIT_FAILURE);
+}
+
+/**
+ * @brief Test decoding stops before a code longer than the table, leaving
+ * the reader positioned at it.
+ *
+ */
+TEST_F(DecodeKernelTest, test_decodeTableSymbols) {
+  /* Symbols 0 to 10 have lengths 1 to 11, and symbols 11 and 12 length 12. */
+  uint8_t aCodeLengths[HUFFMAN_ALPHABET_SIZE] = {0};
+  for (uint8_t symbol = 0; symbol < 11; symbol++) {
+    aCodeLengths[symbol] = (uint8_t)(symbol + 1);
+  }
+  aCodeLengths[11] = 12;
+  aCodeLengths[12] = 12;
+  sHuffmanCodeTable_t sCodeTable;
+  ASSERT_EQ(createCanonicalCodeTable(aCodeLengths, &sCodeTable),
+            EXIT_SUCCESS);
+  std::vector<decodeTableEntry_t> decodeTable(HUFFMAN_DECODE_TABLE_SIZE);
+  ASSERT_EQ(createDecodeTable(&sCodeTable, decodeTable.data()), 12U);
+
+  /* The long code falls at each position of the BMI2 kernel's groups. */
+  for (size_t prefix = 1000; prefix < 1004; prefix++) {
+    std::vector<uint8_t> symbols;
+    std::mt19937 generator(12);
+    for (size_t i = 0; i < prefix; i++) {
+      symbols.push_back((uint8_t)(generator() % 11));
+    }
+    symbols.push_back(12);
+    symbols.push_back(3);
+
+    std::vector<uint8_t> payload(symbols.size() * 2 + 8);
+    sBitWriter_t sWriter;
+    initBitWriter(&sWriter, payload.data());
+    for (uint8_t symbol : symbols) {
+      writeBits(&sWriter, sCodeTable.aCodes[symbol],
+                sCodeTable.aCodeLengths[symbol]);
+    }
+    payload.resize(flushBitWriter(&sWriter));
+
+    for (int kernel = 0; kernel < HUFFMAN_DECODE_KERNEL_MAX; kernel++) {
+      if (setDecodeKernel((eHuffmanDecodeKernel_t)kernel) == EXIT_FAILURE) {
+        continue;
+      }
+      sBitReader_t sReader;
+      initBitReader(&sReader, payload.data(), payload.size());
+      std::vector<uint8_t> output(symbols.size());
+      ASSERT_EQ(decodeTableSymbols(decodeTable.data(), &sReader,
+                                   output.data(), output.size()),
+                prefix)
+          << getDecodeKernelName((eHuffmanDecodeKernel_t)kernel);
+      ASSERT_TRUE(std::equal(output.begin(), output.begin() + prefix,
+                             symbols.begin()));
+      refillBitReader(&sReader);
+      ASSERT_EQ(peekBits(&sReader, 12), sCodeTable.aCodes[12]);
+
+      /* Decoding stops at the output size, wherever it falls. */
+      initBitReader(&sReader, payload.data(), payload.size());
+      ASSERT_EQ(decodeTableSymbols(decodeTable.data(), &sReader,
+                                   output.data(), prefix - 3),
+                prefix - 3);
+      ASSERT_EQ(decodeTableSymbols(decodeTable.data(), &sReader,
+                                   &output[prefix - 3], output.size()),
+                3U);
+      ASSERT_TRUE(std::equal(output.begin(), output.begin() + prefix,
+                             symbols.begin()));
+    }
+  }
+}
+
+/**
+ * @brief Test multi-symbol tables are only built for tiny alphabets with
+ * short codes, and decode the same symbols as the decode table with each
+ * supported decode kernel, with or without a checksum computed by each
+ * supported checksum kernel.
+ *
+ */
+TEST_F(DecodeKernelTest, test_decodeMultiSymbols) {
+  std::vector<decodeTableEntry_t> decodeTable(HUFFMAN_DECODE_TABLE_SIZE);
+  std::vector<multiSymbolEntry_t> multiSymbolTable(HUFFMAN_DECODE_TABLE_SIZE);
+  sHuffmanCodeTable_t sCodeTable;
+
+  /* 17 symbols, or codes longer than the decode table, get no table. */
+  uint8_t aCodeLengths[HUFFMAN_ALPHABET_SIZE] = {0};
+  for (size_t symbol = 0; symbol < 15; symbol++) {
+    aCodeLengths[symbol] = 4;
+  }
+  aCodeLengths[15] = 5;
+  aCodeLengths[16] = 5;
+  ASSERT_EQ(createCanonicalCodeTable(aCodeLengths, &sCodeTable),
+            EXIT_SUCCESS);
+  (void)createDecodeTable(&sCodeTable, decodeTable.data());
+  ASSERT_FALSE(createMultiSymbolDecodeTable(&sCodeTable, decodeTable.data(),
+                                            multiSymbolTable.data()));
+  (void)std::fill(aCodeLengths, aCodeLengths + 17, 0);
+  for (uint8_t symbol = 0; symbol < 12; symbol++) {
+    aCodeLengths['a' + symbol] = (uint8_t)(symbol + 1);
+  }
+  aCodeLengths['a' + 12] = 12;
+  ASSERT_EQ(createCanonicalCodeTable(aCodeLengths, &sCodeTable),
+            EXIT_SUCCESS);
+  (void)createDecodeTable(&sCodeTable, decodeTable.data());
+  ASSERT_FALSE(createMultiSymbolDecodeTable(&sCodeTable, decodeTable.data(),
+                                            multiSymbolTable.data()));
+
+  /* DNA bases with lengths 1, 2, 3 and 3, and codes up to the table width. */
+  for (const std::vector<uint8_t>& lengths :
+       {std::vector<uint8_t>{1, 2, 3, 3},
+        std::vector<uint8_t>{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 11}}) {
+    (void)std::fill(aCodeLengths, aCodeLengths + HUFFMAN_ALPHABET_SIZE, 0);
+    const std::string alphabet = "ACGTNacgtnXY";
+    for (size_t i = 0; i < lengths.size(); i++) {
+      aCodeLengths[(uint8_t)alphabet[i]] = lengths[i];
+    }
+    ASSERT_EQ(createCanonicalCodeTable(aCodeLengths, &sCodeTable),
+              EXIT_SUCCESS);
+    (void)createDecodeTable(&sCodeTable, decodeTable.data());
+    ASSERT_TRUE(createMultiSymbolDecodeTable(
+        &sCodeTable, decodeTable.data(), multiSymbolTable.data()));
+
+    std::vector<uint8_t> symbols(5000);
+    std::mt19937 generator(14);
+    std::geometric_distribution<size_t> distribution(0.4);
+    for (uint8_t& symbol : symbols) {
+      symbol = (uint8_t)alphabet[distribution(generator) % lengths.size()];
+    }
+    std::vector<uint8_t> payload(symbols.size() * 2 + 8);
+    sBitWriter_t sWriter;
+    initBitWriter(&sWriter, payload.data());
+    for (uint8_t symbol : symbols) {
+      writeBits(&sWriter, sCodeTable.aCodes[symbol],
+                sCodeTable.aCodeLengths[symbol]);
+    }
+    payload.resize(flushBitWriter(&sWriter));
+
+    for (int kernel = 0; kernel < HUFFMAN_DECODE_KERNEL_MAX; kernel++) {
+      if (setDecodeKernel((eHuffmanDecodeKernel_t)kernel) == EXIT_FAILURE) {
+        continue;
+      }
+      sBitReader_t sReader;
+      initBitReader(&sReader, payload.data(), payload.size());
+      std::vector<uint8_t> output(symbols.size());
+      size_t count = decodeMultiSymbols(multiSymbolTable.data(), &sReader,
+                                        output.data(), output.size());
+      ASSERT_GE(count, output.size() - 7)
+          << getDecodeKernelName((eHuffmanDecodeKernel_t)kernel);
+      count += decodeTableSymbols(decodeTable.data(), &sReader,
+                                  &output[count], output.size() - count);
+      ASSERT_EQ(count, output.size());
+      ASSERT_EQ(output, symbols);
+      ASSERT_EQ(getBitReaderPosition(&sReader), payload.size());
+
+      for (int checksumKernel = 0;
+           checksumKernel < HUFFMAN_CHECKSUM_KERNEL_MAX; checksumKernel++) {
+        if (setChecksumKernel((eHuffmanChecksumKernel_t)checksumKernel) ==
+            EXIT_FAILURE) {
+          continue;
+        }
+        initBitReader(&sReader, payload.data(), payload.size());
+        std::vector<uint8_t> checked(symbols.size());
+        uint32_t checksum = 0x12345678U;
+        count = decodeMultiSymbolsWithCrc32c(multiSymbolTable.data(),
+                                             &sReader, checked.data(),
+                                             checked.size(), &checksum);
+        ASSERT_GE(count, checked.size() - 7);
+        ASSERT_TRUE(std::equal(checked.begin(), checked.begin() + count,
+                               symbols.begin()));
+        ASSERT_EQ(checksum,
+                  updateCrc32c(0x12345678U, symbols.data(), count))
+            << getDecodeKernelName((eHuffmanDecodeKernel_t)kernel) << " "
+            << getChecksumKernelName(
+                   (eHuffmanChecksumKernel_t)checksumKernel);
+      }
+    }
+  }
+
+  /* A single symbol's table stops at the unused code. */
+  (void)std::fill(aCodeLengths, aCodeLengths + HUFFMAN_ALPHABET_SIZE, 0);
+  aCodeLengths['A'] = 1;
+  ASSERT_EQ(createCanonicalCodeTable(aCodeLengths, &sCodeTable),
+            EXIT_SUCCESS);
+  (void)createDecodeTable(&sCodeTable, decodeTable.data());
+  ASSERT_TRUE(createMultiSymbolDecodeTable(&sCodeTable, decodeTable.data(),
+                                           multiSymbolTable.data()));
+  const uint8_t aPayload[] = {0x00, 0x00, 0x80, 0xFF};
+  for (int kernel = 0; kernel < HUFFMAN_DECODE_KERNEL_MAX; kernel++) {
+    if (setDecodeKernel((eHuffmanDecodeKernel_t)kernel) == EXIT_FAILURE) {
+      continue;
+    }
+    sBitReader_t sReader;
+    initBitReader(&sReader, aPayload, sizeof(aPayload));
+    std::vector<uint8_t> output(64);
+    ASSERT_EQ(decodeMultiSymbols(multiSymbolTable.data(), &sReader,
+                                 output.data(), output.size()),
+              23U);
+    ASSERT_EQ(output[22], 'A');
+  }
+}
+
+/**
+ * @brief Test containers with long codes decode identically with each
+ * supported decode kernel, with and without a context.
+ *
+ */
+TEST_F(DecodeKernelTest, test_decodeTableSymbols_Codec) {
+  std::vector<uint8_t> input;
+  size_t previous = 1;
+  size_t current = 1;
+  for (uint8_t symbol = 0; symbol < 22; symbol++) {
+    input.insert(input.end(), current, symbol);
+    const size_t next = previous + current;
+    previous = current;
+    current = next;
+  }
+  std::shuffle(input.begin(), input.end(), std::mt19937(13));
+
+  std::vector<uint8_t> compressed(getCompressBound(input.size(), NULL));
+  size_t compressedSize = 0;
+  ASSERT_EQ(compressBuffer(input.data(), input.size(), compressed.data(),
+                           compressed.size(), &compressedSize, NULL),
+            EXIT_SUCCESS);
+
+  sHuffmanContext_t* psContext = createHuffmanContext(NULL);
+  ASSERT_NE(psContext, nullptr);
+  for (int kernel = 0; kernel < HUFFMAN_DECODE_KERNEL_MAX; kernel++) {
+    if (setDecodeKernel((eHuffmanDecodeKernel_t)kernel) == EXIT_FAILURE) {
+      continue;
+    }
+    std::vector<uint8_t> output(input.size());
+    size_t outputSize = 0;
+    ASSERT_EQ(decompressBuffer(compressed.data(), compressedSize,
+                               output.data(), output.size(), &outputSize),
+              EXIT_SUCCESS);
+    ASSERT_EQ(output, input)
+        << getDecodeKernelName((eHuffmanDecodeKernel_t)kernel);
+    std::fill(output.begin(), output.end(), 0);
+    ASSERT_EQ(decompressBufferWithContext(psContext, compressed.data(),
+                                          compressedSize, output.data(),
+                                          output.size(), &outputSize),
+              EXIT_SUCCESS);
+    ASSERT_EQ(output, input);
+  }
+  freeHuffmanContext(psContext);
+}
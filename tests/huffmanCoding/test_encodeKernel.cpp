@@ -0,0 +1,239 @@
+/**
+ * @file test_encodeKernel.cpp
+ * @brief Unit tests for encodeKernel.c.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+/* External Includes */
+
+#include <gtest/gtest.h>
+
+/* Standard Library Includes */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+/* Project Includes */
+
+extern "C" {
+#include "huffmanCoding/bitStream.h"
+#include "huffmanCoding/codec.h"
+#include "huffmanCoding/encodeKernel.h"
+#include "huffmanCoding/huffmanTree.h"
+}
+
+/* Test Fixtures */
+
+/**
+ * @brief Encode kernel test fixture, restoring the selected kernel.
+ *
+ */
+class EncodeKernelTest : public ::testing::Test {
+ protected:
+  eHuffmanEncodeKernel_t ePrevious = HUFFMAN_ENCODE_KERNEL_PORTABLE;
+
+  /**
+   * @brief Remember the kernel selected at startup.
+   *
+   */
+  void SetUp() override { ePrevious = getEncodeKernel(); }
+
+  /**
+   * @brief Restore the kernel selected at startup.
+   *
+   */
+  void TearDown() override { (void)setEncodeKernel(ePrevious); }
+
+  /**
+   * @brief Code bytes with the selected kernel after some pending bits.
+   *
+   * @param i_psCodeTable The canonical code table.
+   * @param i_symbols The bytes to code.
+   * @param i_pendingCount The number of bits to write before the bytes.
+   * @return std::vector<uint8_t> The flushed output.
+   */
+  static std::vector<uint8_t> encode(const sHuffmanCodeTable_t* i_psCodeTable,
+                                     const std::vector<uint8_t>& i_symbols,
+                                     size_t i_pendingCount) {
+    std::vector<uint8_t> output(i_symbols.size() * 2 + 8);
+    sBitWriter_t sWriter;
+    initBitWriter(&sWriter, output.data());
+    writeBits(&sWriter, 0x5A5A5A5AU & ((1U << i_pendingCount) - 1),
+              i_pendingCount);
+    encodeTableSymbols(i_psCodeTable, i_symbols.data(), i_symbols.size(),
+                       &sWriter);
+    output.resize(flushBitWriter(&sWriter));
+    return output;
+  }
+};
+
+/* Unit Tests */
+
+/**
+ * @brief Test the kernel selected at startup is supported and unsupported
+ * kernels cannot be selected.
+ *
+ */
+TEST_F(EncodeKernelTest, test_setEncodeKernel) {
+  ASSERT_TRUE(isEncodeKernelSupported(getEncodeKernel()));
+  ASSERT_TRUE(isEncodeKernelSupported(HUFFMAN_ENCODE_KERNEL_PORTABLE));
+  ASSERT_FALSE(isEncodeKernelSupported(HUFFMAN_ENCODE_KERNEL_MAX));
+  ASSERT_EQ(setEncodeKernel(HUFFMAN_ENCODE_KERNEL_MAX), EXIT_FAILURE);
+
+  ASSERT_EQ(setEncodeKernel(HUFFMAN_ENCODE_KERNEL_PORTABLE), EXIT_SUCCESS);
+  ASSERT_EQ(getEncodeKernel(), HUFFMAN_ENCODE_KERNEL_PORTABLE);
+  ASSERT_EQ(std::string(getEncodeKernelName(HUFFMAN_ENCODE_KERNEL_AVX2)),
+            "avx2");
+  ASSERT_EQ(std::string(getEncodeKernelName(HUFFMAN_ENCODE_KERNEL_MAX)),
+            "unknown");
+}
+
+/**
+ * @brief Test each supported kernel writes the same bits as the portable
+ * kernel, for codes up to the maximum length, every size around the vector
+ * thresholds and any number of pending bits.
+ *
+ */
+TEST_F(EncodeKernelTest, test_encodeTableSymbols) {
+  /* Symbols 0 to 14 have lengths 1 to 15, and symbol 15 length 15. */
+  uint8_t aCodeLengths[HUFFMAN_ALPHABET_SIZE] = {0};
+  for (uint8_t symbol = 0; symbol < 15; symbol++) {
+    aCodeLengths[symbol] = (uint8_t)(symbol + 1);
+  }
+  aCodeLengths[15] = 15;
+  sHuffmanCodeTable_t sCodeTable;
+  ASSERT_EQ(createCanonicalCodeTable(aCodeLengths, &sCodeTable),
+            EXIT_SUCCESS);
+
+  std::mt19937 generator(37);
+  std::vector<uint8_t> symbols;
+  for (size_t i = 0; i < 4096; i++) {
+    /* Mostly short codes, with runs of the longest codes. */
+    symbols.push_back((i / 512 % 2 == 0) ? (uint8_t)(generator() % 4)
+                                         : (uint8_t)(generator() % 16));
+  }
+
+  const size_t aSizes[] = {0, 1, 7, 135, 511, 512, 513, 647, 1000, 4096};
+  for (size_t size : aSizes) {
+    const std::vector<uint8_t> input(symbols.begin(), symbols.begin() + size);
+    for (size_t pendingCount = 0; pendingCount < 32; pendingCount += 3) {
+      ASSERT_EQ(setEncodeKernel(HUFFMAN_ENCODE_KERNEL_PORTABLE), EXIT_SUCCESS);
+      const std::vector<uint8_t> expected =
+          encode(&sCodeTable, input, pendingCount);
+      for (int kernel = 0; kernel < HUFFMAN_ENCODE_KERNEL_MAX; kernel++) {
+        if (setEncodeKernel((eHuffmanEncodeKernel_t)kernel) == EXIT_FAILURE) {
+          continue;
+        }
+        ASSERT_EQ(encode(&sCodeTable, input, pendingCount), expected)
+            << getEncodeKernelName((eHuffmanEncodeKernel_t)kernel) << " "
+            << size << " " << pendingCount;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Test each supported kernel writes the same bits as the portable
+ * kernel for tiny alphabets, including alphabets whose nibbles collide and
+ * alphabets with codes too long for the tiny alphabet tables.
+ *
+ */
+TEST_F(EncodeKernelTest, test_encodeTableSymbols_TinyAlphabet) {
+  const std::string aAlphabets[] = {
+      "ACGT", "0123456789abcdef", "0123456789,.-\n",
+      std::string("\x00\x10\x20\x30\x40\x50\x60\x70\x80\x90\xA0\xB0"
+                  "\xC0\xD0\xE0\xF0",
+                  16),
+      "abcdefghijklmnop"};
+  std::mt19937 generator(39);
+
+  for (const std::string& alphabet : aAlphabets) {
+    /* Skew the frequencies so the codes have several lengths, and for the
+       last alphabet beyond the tiny table's longest code. */
+    const double skew = (alphabet == aAlphabets[4]) ? 0.6 : 0.25;
+    std::geometric_distribution<size_t> distribution(skew);
+    std::vector<uint8_t> symbols(4099);
+    for (uint8_t& symbol : symbols) {
+      symbol = (uint8_t)alphabet[distribution(generator) % alphabet.size()];
+    }
+    for (char symbol : alphabet) {
+      symbols[(uint8_t)symbol % symbols.size()] = (uint8_t)symbol;
+    }
+
+    size_t aFrequencies[HUFFMAN_ALPHABET_SIZE] = {0};
+    uint8_t aCodeLengths[HUFFMAN_ALPHABET_SIZE] = {0};
+    for (uint8_t symbol : symbols) {
+      aFrequencies[symbol]++;
+    }
+    ASSERT_EQ(createCodeLengthsFromFrequencies(aFrequencies, aCodeLengths),
+              EXIT_SUCCESS);
+    sHuffmanCodeTable_t sCodeTable;
+    ASSERT_EQ(createCanonicalCodeTable(aCodeLengths, &sCodeTable),
+              EXIT_SUCCESS);
+
+    for (size_t size : {0, 159, 160, 161, 192, 1000, 4099}) {
+      const std::vector<uint8_t> input(symbols.begin(),
+                                       symbols.begin() + size);
+      for (size_t pendingCount = 0; pendingCount < 32; pendingCount += 5) {
+        ASSERT_EQ(setEncodeKernel(HUFFMAN_ENCODE_KERNEL_PORTABLE),
+                  EXIT_SUCCESS);
+        const std::vector<uint8_t> expected =
+            encode(&sCodeTable, input, pendingCount);
+        for (int kernel = 0; kernel < HUFFMAN_ENCODE_KERNEL_MAX; kernel++) {
+          if (setEncodeKernel((eHuffmanEncodeKernel_t)kernel) ==
+              EXIT_FAILURE) {
+            continue;
+          }
+          ASSERT_EQ(encode(&sCodeTable, input, pendingCount), expected)
+              << getEncodeKernelName((eHuffmanEncodeKernel_t)kernel) << " "
+              << alphabet << " " << size << " " << pendingCount;
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief Test containers are identical with each supported kernel.
+ *
+ */
+TEST_F(EncodeKernelTest, test_encodeTableSymbols_Codec) {
+  std::vector<uint8_t> input(100000);
+  std::mt19937 generator(38);
+  std::geometric_distribution<int> distribution(0.2);
+  for (uint8_t& byte : input) {
+    byte = (uint8_t)distribution(generator);
+  }
+
+  std::vector<uint8_t> expected;
+  for (int kernel = 0; kernel < HUFFMAN_ENCODE_KERNEL_MAX; kernel++) {
+    if (setEncodeKernel((eHuffmanEncodeKernel_t)kernel) == EXIT_FAILURE) {
+      continue;
+    }
+    std::vector<uint8_t> compressed(getCompressBound(input.size(), NULL));
+    size_t compressedSize = 0;
+    ASSERT_EQ(compressBuffer(input.data(), input.size(), compressed.data(),
+                             compressed.size(), &compressedSize, NULL),
+              EXIT_SUCCESS);
+    compressed.resize(compressedSize);
+    if (expected.empty()) {
+      expected = compressed;
+    }
+    ASSERT_EQ(compressed, expected)
+        << getEncodeKernelName((eHuffmanEncodeKernel_t)kernel);
+
+    std::vector<uint8_t> output(input.size());
+    size_t outputSize = 0;
+    ASSERT_EQ(decompressBuffer(compressed.data(), compressed.size(),
+                               output.data(), output.size(), &outputSize),
+              EXIT_SUCCESS);
+    ASSERT_EQ(output, input);
+  }
+}
@@ -0,0 +1,235 @@
+/**
+ * @file test_histogram.cpp
+ * @brief Unit tests for histogram.c.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+/* External Includes */
+
+#include <gtest/gtest.h>
+
+/* Standard Library Includes */
+
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+/* Project Includes */
+
+extern "C" {
+#include "huffmanCoding/histogram.h"
+#include "huffmanCoding/task3.h"
+#include "huffmanCoding/task4.h"
+}
+
+/* Test Fixtures */
+
+/**
+ * @brief Histogram test fixture, with data split into shards.
+ *
+ */
+class HistogramTest : public ::testing::Test {
+ protected:
+  std::vector<uint8_t> data;
+  std::vector<sHuffmanHistogram_t> shards;
+
+  void SetUp() override {
+    std::mt19937 generator(7);
+    std::geometric_distribution<int> distribution(0.05);
+    data.resize(100000);
+    for (uint8_t& byte : data) {
+      byte = (uint8_t)distribution(generator);
+    }
+
+    const size_t aBounds[] = {0, 10, 30000, 30000, 75000, data.size()};
+    for (size_t i = 0; i + 1 < sizeof(aBounds) / sizeof(aBounds[0]); i++) {
+      sHuffmanHistogram_t sShard;
+      initHuffmanHistogram(&sShard);
+      ASSERT_EQ(addBytesToHuffmanHistogram(&sShard, &data[aBounds[i]],
+                                           aBounds[i + 1] - aBounds[i]),
+                EXIT_SUCCESS);
+      shards.push_back(sShard);
+    }
+  }
+
+  /**
+   * @brief Check two histograms hold the same frequencies.
+   *
+   * @param i_sExpected The expected histogram.
+   * @param i_sActual The actual histogram.
+   */
+  static void expectEqual(const sHuffmanHistogram_t& i_sExpected,
+                          const sHuffmanHistogram_t& i_sActual) {
+    for (size_t i = 0; i < LETTER_FREQUENCY_ALPHABET_SIZE; i++) {
+      ASSERT_EQ(i_sExpected.aFrequencies[i], i_sActual.aFrequencies[i]) << i;
+    }
+  }
+};
+
+/* Unit Tests */
+
+/**
+ * @brief Test merging shards in any order and grouping gives the histogram
+ * of the whole data.
+ *
+ */
+TEST_F(HistogramTest, test_mergeHuffmanHistograms) {
+  sHuffmanHistogram_t sWhole;
+  countByteFrequencies(data.data(), data.size(), sWhole.aFrequencies);
+
+  /* Left to right. */
+  sHuffmanHistogram_t sForward;
+  initHuffmanHistogram(&sForward);
+  for (const sHuffmanHistogram_t& sShard : shards) {
+    ASSERT_EQ(mergeHuffmanHistograms(&sForward, &sShard), EXIT_SUCCESS);
+  }
+  expectEqual(sWhole, sForward);
+
+  /* Right to left, merging pairs first. */
+  sHuffmanHistogram_t sLeft = shards[3];
+  ASSERT_EQ(mergeHuffmanHistograms(&sLeft, &shards[4]), EXIT_SUCCESS);
+  sHuffmanHistogram_t sRight = shards[1];
+  ASSERT_EQ(mergeHuffmanHistograms(&sRight, &shards[0]), EXIT_SUCCESS);
+  ASSERT_EQ(mergeHuffmanHistograms(&sRight, &shards[2]), EXIT_SUCCESS);
+  ASSERT_EQ(mergeHuffmanHistograms(&sLeft, &sRight), EXIT_SUCCESS);
+  expectEqual(sWhole, sLeft);
+
+  /* An overflowing merge leaves the histogram unchanged. */
+  sHuffmanHistogram_t sFull;
+  initHuffmanHistogram(&sFull);
+  sFull.aFrequencies[0] = SIZE_MAX;
+  sHuffmanHistogram_t sCopy = sLeft;
+  ASSERT_EQ(mergeHuffmanHistograms(&sLeft, &sFull), EXIT_FAILURE);
+  expectEqual(sCopy, sLeft);
+}
+
+/**
+ * @brief Test a letter-frequency list counts into the same histogram as its
+ * text.
+ *
+ */
+TEST_F(HistogramTest, test_addLetterFrequencyListToHuffmanHistogram) {
+  const char* text = "to be or not to be";
+  sLetterFrequencyNode_t* psHead = NULL;
+  ASSERT_EQ(createLetterFrequencyListFromText(&psHead, text), EXIT_SUCCESS);
+
+  sHuffmanHistogram_t sList;
+  initHuffmanHistogram(&sList);
+  ASSERT_EQ(addLetterFrequencyListToHuffmanHistogram(&sList, psHead),
+            EXIT_SUCCESS);
+  freeLetterFrequencyPairList(&psHead);
+
+  sHuffmanHistogram_t sText;
+  initHuffmanHistogram(&sText);
+  ASSERT_EQ(addBytesToHuffmanHistogram(&sText, (const uint8_t*)text,
+                                       std::string(text).size()),
+            EXIT_SUCCESS);
+  expectEqual(sText, sList);
+}
+
+/**
+ * @brief Test histograms survive serialization, including the largest
+ * frequencies, and are stored compactly.
+ *
+ */
+TEST_F(HistogramTest, test_serializeHuffmanHistogram_RoundTrip) {
+  uint8_t aBuffer[HUFFMAN_HISTOGRAM_MAX_SERIALIZED_SIZE];
+  size_t size = 0;
+  sHuffmanHistogram_t sOutput;
+
+  sHuffmanHistogram_t sEmpty;
+  initHuffmanHistogram(&sEmpty);
+  ASSERT_EQ(serializeHuffmanHistogram(&sEmpty, aBuffer, sizeof(aBuffer),
+                                      &size),
+            EXIT_SUCCESS);
+  ASSERT_EQ(size, (size_t)HUFFMAN_HISTOGRAM_HEADER_SIZE);
+  ASSERT_EQ(deserializeHuffmanHistogram(aBuffer, size, &sOutput),
+            EXIT_SUCCESS);
+  expectEqual(sEmpty, sOutput);
+
+  sHuffmanHistogram_t sLarge;
+  for (size_t i = 0; i < LETTER_FREQUENCY_ALPHABET_SIZE; i++) {
+    sLarge.aFrequencies[i] = SIZE_MAX - i;
+  }
+  ASSERT_EQ(serializeHuffmanHistogram(&sLarge, aBuffer, sizeof(aBuffer),
+                                      &size),
+            EXIT_SUCCESS);
+  ASSERT_EQ(deserializeHuffmanHistogram(aBuffer, size, &sOutput),
+            EXIT_SUCCESS);
+  expectEqual(sLarge, sOutput);
+
+  ASSERT_EQ(serializeHuffmanHistogram(&shards[0], aBuffer, sizeof(aBuffer),
+                                      &size),
+            EXIT_SUCCESS);
+  ASSERT_LE(size, (size_t)HUFFMAN_HISTOGRAM_HEADER_SIZE + 10);
+  ASSERT_EQ(deserializeHuffmanHistogram(aBuffer, size, &sOutput),
+            EXIT_SUCCESS);
+  expectEqual(shards[0], sOutput);
+
+  /* Files written by one process are read back by another. */
+  const std::string path =
+      "/tmp/huffman_histogram_" + std::to_string(getpid());
+  ASSERT_EQ(writeHuffmanHistogramFile(&shards[2], path.c_str()),
+            EXIT_SUCCESS);
+  ASSERT_EQ(readHuffmanHistogramFile(path.c_str(), &sOutput), EXIT_SUCCESS);
+  expectEqual(shards[2], sOutput);
+  (void)std::remove(path.c_str());
+}
+
+/**
+ * @brief Test damaged serialized histograms are rejected.
+ *
+ */
+TEST_F(HistogramTest, test_deserializeHuffmanHistogram_Invalid) {
+  uint8_t aBuffer[HUFFMAN_HISTOGRAM_MAX_SERIALIZED_SIZE];
+  size_t size = 0;
+  sHuffmanHistogram_t sOutput;
+  ASSERT_EQ(serializeHuffmanHistogram(&shards[1], aBuffer, sizeof(aBuffer),
+                                      &size),
+            EXIT_SUCCESS);
+
+  /* An output too small for the header or the frequencies. */
+  size_t unused = 0;
+  ASSERT_EQ(serializeHuffmanHistogram(&shards[1], aBuffer, 10, &unused),
+            EXIT_FAILURE);
+  ASSERT_EQ(serializeHuffmanHistogram(&shards[1], aBuffer, size - 1, &unused),
+            EXIT_FAILURE);
+
+  /* Truncated, or with trailing bytes. */
+  ASSERT_EQ(deserializeHuffmanHistogram(aBuffer, size - 1, &sOutput),
+            EXIT_FAILURE);
+  ASSERT_EQ(deserializeHuffmanHistogram(aBuffer, size + 1, &sOutput),
+            EXIT_FAILURE);
+
+  /* A bad magic. */
+  std::vector<uint8_t> damaged(aBuffer, aBuffer + size);
+  damaged[0] = 'X';
+  ASSERT_EQ(deserializeHuffmanHistogram(damaged.data(), size, &sOutput),
+            EXIT_FAILURE);
+
+  /* A counted byte with a zero frequency. */
+  uint8_t aZero[HUFFMAN_HISTOGRAM_HEADER_SIZE + 1] = {
+      'H', 'U', 'F', 'H', HUFFMAN_HISTOGRAM_VERSION};
+  aZero[8] = 0x01;
+  ASSERT_EQ(deserializeHuffmanHistogram(aZero, sizeof(aZero), &sOutput),
+            EXIT_FAILURE);
+
+  /* A frequency wider than 64 bits. */
+  std::vector<uint8_t> wide(aZero, aZero + HUFFMAN_HISTOGRAM_HEADER_SIZE);
+  wide.insert(wide.end(), 9, 0xFF);
+  wide.push_back(0x02);
+  ASSERT_EQ(deserializeHuffmanHistogram(wide.data(), wide.size(), &sOutput),
+            EXIT_FAILURE);
+  ASSERT_EQ(readHuffmanHistogramFile("/tmp/huffman_histogram_missing",
+                                     &sOutput),
+            EXIT_FAILURE);
+}
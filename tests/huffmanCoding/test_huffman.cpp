@@ -0,0 +1,229 @@
+/**
+ * @file test_huffman.cpp
+ * @brief Unit tests for huffman.hpp.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+/* External Includes */
+
+#include <gtest/gtest.h>
+
+/* Standard Library Includes */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+/* Project Includes */
+
+#include "huffmanCoding/huffman.hpp"
+
+/* Test Fixtures */
+
+/**
+ * @brief Memory resource that counts the calls to an upstream resource.
+ *
+ */
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  size_t allocations = 0;
+  size_t deallocations = 0;
+  size_t currentBytes = 0;
+
+ private:
+  void* do_allocate(size_t i_bytes, size_t i_alignment) override {
+    allocations++;
+    currentBytes += i_bytes;
+    return std::pmr::new_delete_resource()->allocate(i_bytes, i_alignment);
+  }
+
+  void do_deallocate(void* io_pMemory, size_t i_bytes,
+                     size_t i_alignment) override {
+    deallocations++;
+    currentBytes -= i_bytes;
+    std::pmr::new_delete_resource()->deallocate(io_pMemory, i_bytes,
+                                                i_alignment);
+  }
+
+  bool do_is_equal(
+      const std::pmr::memory_resource& i_other) const noexcept override {
+    return this == &i_other;
+  }
+};
+
+/**
+ * @brief C++ interface test fixture.
+ *
+ */
+class HuffmanTest : public ::testing::Test {
+ protected:
+  CountingResource resource;
+  std::vector<uint8_t> input;
+
+  /**
+   * @brief Create an input with a skewed byte distribution.
+   *
+   */
+  void SetUp() override {
+    input.resize(4000);
+    for (size_t i = 0; i < input.size(); i++) {
+      input[i] = (uint8_t)((i * i) % 37);
+    }
+  }
+};
+
+/* Unit Tests */
+
+/**
+ * @brief Test a round trip through an encoder and decoder allocates only
+ * from the memory resource, and only when they are created.
+ *
+ */
+TEST_F(HuffmanTest, test_Encoder_RoundTrip) {
+  {
+    huffman::Encoder encoder(&resource, 1000);
+    huffman::Decoder decoder(&resource);
+    ASSERT_TRUE(encoder.isValid());
+    ASSERT_TRUE(decoder.isValid());
+    const size_t allocations = resource.allocations;
+    ASSERT_GT(allocations, 0U);
+
+    std::vector<uint8_t> compressed(encoder.getBound(input.size()));
+    std::vector<uint8_t> output(input.size());
+    for (int i = 0; i < 3; i++) {
+      const huffman::Result sCompressed = encoder.compress(input, compressed);
+      ASSERT_TRUE(sCompressed);
+      ASSERT_LT(sCompressed.size, input.size());
+
+      const huffman::ByteSpan container(compressed.data(), sCompressed.size);
+      ASSERT_EQ(huffman::Decoder::getSize(container).size, input.size());
+      const huffman::Result sDecompressed =
+          decoder.decompress(container, output);
+      ASSERT_TRUE(sDecompressed);
+      ASSERT_EQ(sDecompressed.size, input.size());
+      ASSERT_EQ(output, input);
+    }
+
+    ASSERT_EQ(resource.allocations, allocations);
+  }
+
+  ASSERT_EQ(resource.deallocations, resource.allocations);
+  ASSERT_EQ(resource.currentBytes, 0U);
+}
+
+/**
+ * @brief Test errors are reported as values.
+ *
+ */
+TEST_F(HuffmanTest, test_Encoder_Errors) {
+  huffman::Encoder encoder(&resource);
+  huffman::Decoder decoder(&resource);
+  std::vector<uint8_t> compressed(encoder.getBound(input.size()));
+  std::vector<uint8_t> output(input.size());
+
+  /* The output is too small. */
+  uint8_t small[16];
+  ASSERT_EQ(encoder.compress(input, small).error,
+            huffman::Error::OutputTooSmall);
+
+  const huffman::Result sCompressed = encoder.compress(input, compressed);
+  ASSERT_TRUE(sCompressed);
+  compressed.resize(sCompressed.size);
+  ASSERT_EQ(decoder.decompress(compressed, small).error,
+            huffman::Error::OutputTooSmall);
+
+  /* The container is corrupted. */
+  compressed[0] = 'X';
+  ASSERT_EQ(decoder.decompress(compressed, output).error,
+            huffman::Error::CorruptInput);
+
+  /* The block size is invalid. */
+  huffman::Encoder invalid(&resource, 0);
+  ASSERT_EQ(invalid.compress(input, output).error,
+            huffman::Error::InvalidArgument);
+}
+
+/**
+ * @brief Test moving an encoder and decoder transfers their contexts.
+ *
+ */
+TEST_F(HuffmanTest, test_Encoder_Move) {
+  {
+    huffman::Encoder encoder(&resource);
+    huffman::Decoder decoder(&resource);
+    huffman::Encoder movedEncoder(std::move(encoder));
+    huffman::Decoder movedDecoder = huffman::Decoder(&resource);
+    movedDecoder = std::move(decoder);
+    ASSERT_FALSE(encoder.isValid());
+    ASSERT_FALSE(decoder.isValid());
+
+    std::vector<uint8_t> compressed(movedEncoder.getBound(input.size()));
+    std::vector<uint8_t> output(input.size());
+    const huffman::Result sCompressed =
+        movedEncoder.compress(input, compressed);
+    ASSERT_TRUE(sCompressed);
+    ASSERT_TRUE(movedDecoder.decompress(
+        huffman::ByteSpan(compressed.data(), sCompressed.size), output));
+    ASSERT_EQ(output, input);
+
+    ASSERT_EQ(encoder.compress(input, compressed).error,
+              huffman::Error::OutOfMemory);
+  }
+
+  ASSERT_EQ(resource.currentBytes, 0U);
+}
+
+/**
+ * @brief Test a code table matches the C code table and owns its tree.
+ *
+ */
+TEST_F(HuffmanTest, test_CodeTable_Build) {
+  {
+    huffman::CodeTable table(&resource);
+    ASSERT_EQ(table.build(input), huffman::Error::None);
+    ASSERT_NE(table.getTree(), nullptr);
+
+    size_t aFrequencies[HUFFMAN_ALPHABET_SIZE];
+    uint8_t aCodeLengths[HUFFMAN_ALPHABET_SIZE];
+    sHuffmanCodeTable_t sCodeTable;
+    countByteFrequencies(input.data(), input.size(), aFrequencies);
+    ASSERT_EQ(createCodeLengthsFromFrequencies(aFrequencies, aCodeLengths),
+              EXIT_SUCCESS);
+    ASSERT_EQ(createCanonicalCodeTable(aCodeLengths, &sCodeTable),
+              EXIT_SUCCESS);
+    for (size_t symbol = 0; symbol < HUFFMAN_ALPHABET_SIZE; symbol++) {
+      ASSERT_EQ(table.getCodeLength((uint8_t)symbol),
+                sCodeTable.aCodeLengths[symbol]);
+      ASSERT_EQ(table.getCode((uint8_t)symbol), sCodeTable.aCodes[symbol]);
+    }
+
+    /* Moving the table moves the tree without copying it. */
+    const sBinaryTreeNode_t* psTree = table.getTree();
+    huffman::CodeTable moved = std::move(table);
+    ASSERT_EQ(moved.getTree(), psTree);
+    ASSERT_EQ(table.getTree(), nullptr);
+  }
+
+  ASSERT_EQ(resource.currentBytes, 0U);
+}
+
+/**
+ * @brief Test building a code table from invalid code lengths.
+ *
+ */
+TEST_F(HuffmanTest, test_CodeTable_InvalidCodeLengths) {
+  huffman::CodeTable table(&resource);
+  std::array<uint8_t, HUFFMAN_ALPHABET_SIZE> aCodeLengths = {};
+  aCodeLengths['a'] = 1;
+  aCodeLengths['b'] = 2;
+
+  ASSERT_EQ(table.buildFromCodeLengths(aCodeLengths),
+            huffman::Error::CorruptInput);
+  ASSERT_EQ(table.getTree(), nullptr);
+}
@@ -0,0 +1,353 @@
+/**
+ * @file test_huffmanTree.cpp
+ * @brief Unit tests for huffmanTree.c.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+/* External Includes */
+
+#include <gtest/gtest.h>
+
+/* Standard Library Includes */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+/* Project Includes */
+
+extern "C" {
+#include "huffmanCoding/huffmanTree.h"
+#include "huffmanCoding/task3.h"
+#include "huffmanCoding/task4.h"
+#include "huffmanCoding/task5.h"
+#include "huffmanCoding/task6.h"
+}
+
+/* Test Fixtures */
+
+/**
+ * @brief Huffman tree test fixture.
+ *
+ */
+class HuffmanTreeTest : public ::testing::Test {
+ protected:
+  sBinaryTreeNode_t* psRoot = NULL;
+  size_t aFrequencies[HUFFMAN_ALPHABET_SIZE] = {0};
+  uint8_t aCodeLengths[HUFFMAN_ALPHABET_SIZE] = {0};
+
+  /**
+   * @brief Set the frequencies of "to be or not to be".
+   *
+   */
+  void SetUp() override {
+    aFrequencies[' '] = 5;
+    aFrequencies['o'] = 4;
+    aFrequencies['t'] = 3;
+    aFrequencies['b'] = 2;
+    aFrequencies['e'] = 2;
+    aFrequencies['n'] = 1;
+    aFrequencies['r'] = 1;
+  }
+
+  /**
+   * @brief Free the Huffman tree.
+   *
+   */
+  void TearDown() override { freeBinaryTree(psRoot); }
+};
+
+/* Unit Tests */
+
+/**
+ * @brief Test building a Huffman tree from a binary tree node list.
+ *
+ */
+TEST_F(HuffmanTreeTest, test_createHuffmanTree) {
+  sLetterFrequencyNode_t* psLetterFrequencyHead = NULL;
+  sBinaryTreeListNode_t* psHead = NULL;
+  (void)createLetterFrequencyListFromText(&psLetterFrequencyHead,
+                                          "to be or not to be");
+  (void)createBinaryTreeNodeListFromLetterFrequencyPairList(
+      &psHead, psLetterFrequencyHead);
+
+  psRoot = createHuffmanTree(&psHead);
+
+  ASSERT_NE(psRoot, nullptr);
+  ASSERT_EQ(psHead, nullptr);
+  ASSERT_EQ(psRoot->psLetterFrequencyPair->frequency, 18);
+
+  /* Assert the tree gives the 47 bit encoding from the README. */
+  size_t maxLength = getCodeLengthsFromHuffmanTree(psRoot, aCodeLengths);
+  size_t totalBits = 0;
+  for (size_t symbol = 0; symbol < HUFFMAN_ALPHABET_SIZE; symbol++) {
+    totalBits += aFrequencies[symbol] * aCodeLengths[symbol];
+  }
+  ASSERT_EQ(totalBits, 47);
+  ASSERT_EQ(maxLength, 4);
+}
+
+/**
+ * @brief Test building a Huffman tree from an empty list.
+ *
+ */
+TEST_F(HuffmanTreeTest, test_createHuffmanTree_EmptyList) {
+  sBinaryTreeListNode_t* psHead = NULL;
+
+  psRoot = createHuffmanTree(&psHead);
+
+  ASSERT_EQ(psRoot, nullptr);
+}
+
+/**
+ * @brief Test a single symbol is given a one bit code.
+ *
+ */
+TEST_F(HuffmanTreeTest, test_createCodeLengthsFromFrequencies_SingleSymbol) {
+  size_t aSingleFrequencies[HUFFMAN_ALPHABET_SIZE] = {0};
+  aSingleFrequencies['x'] = 100;
+
+  int retcode =
+      createCodeLengthsFromFrequencies(aSingleFrequencies, aCodeLengths);
+
+  ASSERT_EQ(retcode, EXIT_SUCCESS);
+  ASSERT_EQ(aCodeLengths['x'], 1);
+  ASSERT_EQ(aCodeLengths['y'], 0);
+}
+
+/**
+ * @brief Test code lengths are limited for a Fibonacci distribution, which
+ * would otherwise build a tree as deep as the alphabet.
+ *
+ */
+TEST_F(HuffmanTreeTest, test_createCodeLengthsFromFrequencies_LengthLimited) {
+  size_t aFibonacci[HUFFMAN_ALPHABET_SIZE] = {0};
+  aFibonacci[0] = 1;
+  aFibonacci[1] = 1;
+  for (size_t symbol = 2; symbol < 40; symbol++) {
+    aFibonacci[symbol] = aFibonacci[symbol - 1] + aFibonacci[symbol - 2];
+  }
+
+  int retcode = createCodeLengthsFromFrequencies(aFibonacci, aCodeLengths);
+
+  ASSERT_EQ(retcode, EXIT_SUCCESS);
+  for (size_t symbol = 0; symbol < 40; symbol++) {
+    ASSERT_GE(aCodeLengths[symbol], 1);
+    ASSERT_LE(aCodeLengths[symbol], HUFFMAN_MAX_CODE_LENGTH);
+  }
+
+  /* Assert the limited lengths still form a complete prefix code. */
+  sHuffmanCodeTable_t sCodeTable;
+  ASSERT_EQ(createCanonicalCodeTable(aCodeLengths, &sCodeTable), EXIT_SUCCESS);
+}
+
+/**
+ * @brief Test assigning canonical codes to code lengths.
+ *
+ */
+TEST_F(HuffmanTreeTest, test_createCanonicalCodeTable) {
+  uint8_t aLengths[HUFFMAN_ALPHABET_SIZE] = {0};
+  aLengths['a'] = 1;
+  aLengths['b'] = 2;
+  aLengths['c'] = 3;
+  aLengths['d'] = 3;
+  sHuffmanCodeTable_t sCodeTable;
+
+  int retcode = createCanonicalCodeTable(aLengths, &sCodeTable);
+
+  /* Codes are 0, 10, 110 and 111, stored least significant bit first. */
+  ASSERT_EQ(retcode, EXIT_SUCCESS);
+  ASSERT_EQ(sCodeTable.aCodes['a'], 0x0);
+  ASSERT_EQ(sCodeTable.aCodes['b'], 0x1);
+  ASSERT_EQ(sCodeTable.aCodes['c'], 0x3);
+  ASSERT_EQ(sCodeTable.aCodes['d'], 0x7);
+  ASSERT_EQ(sCodeTable.aCodeLengths['d'], 3);
+}
+
+/**
+ * @brief Test rejecting code lengths that are not a complete prefix code.
+ *
+ */
+TEST_F(HuffmanTreeTest, test_createCanonicalCodeTable_IncompleteCode) {
+  uint8_t aLengths[HUFFMAN_ALPHABET_SIZE] = {0};
+  aLengths['a'] = 1;
+  aLengths['b'] = 2;
+  sHuffmanCodeTable_t sCodeTable;
+
+  int retcode = createCanonicalCodeTable(aLengths, &sCodeTable);
+
+  ASSERT_EQ(retcode, EXIT_FAILURE);
+}
+
+/**
+ * @brief Test rebuilding the canonical tree from code lengths.
+ *
+ */
+TEST_F(HuffmanTreeTest, test_createHuffmanTreeFromCodeLengths) {
+  uint8_t aLengths[HUFFMAN_ALPHABET_SIZE] = {0};
+  aLengths['a'] = 1;
+  aLengths['b'] = 2;
+  aLengths['c'] = 3;
+  aLengths['d'] = 3;
+
+  psRoot = createHuffmanTreeFromCodeLengths(aLengths);
+
+  /* Assert the tree spells out the codes 0, 10, 110 and 111. */
+  ASSERT_NE(psRoot, nullptr);
+  ASSERT_EQ(psRoot->psLeftChild->psLetterFrequencyPair->character, 'a');
+  ASSERT_EQ(psRoot->psRightChild->psLeftChild->psLetterFrequencyPair->character,
+            'b');
+  ASSERT_EQ(psRoot->psRightChild->psRightChild->psLeftChild
+                ->psLetterFrequencyPair->character,
+            'c');
+  ASSERT_EQ(psRoot->psRightChild->psRightChild->psRightChild
+                ->psLetterFrequencyPair->character,
+            'd');
+
+  /* Assert reading the lengths back gives the same lengths. */
+  (void)getCodeLengthsFromHuffmanTree(psRoot, aCodeLengths);
+  for (size_t symbol = 0; symbol < HUFFMAN_ALPHABET_SIZE; symbol++) {
+    ASSERT_EQ(aCodeLengths[symbol], aLengths[symbol]);
+  }
+}
+
+/**
+ * @brief Test building code lengths in a workspace matches building them from
+ * the linked lists, including when the lengths need limiting.
+ *
+ */
+TEST_F(HuffmanTreeTest, test_createCodeLengthsWithWorkspace) {
+  sHuffmanTreeWorkspace_t sWorkspace;
+  uint8_t aWorkspaceLengths[HUFFMAN_ALPHABET_SIZE];
+
+  size_t aFibonacci[HUFFMAN_ALPHABET_SIZE] = {0};
+  aFibonacci[0] = 1;
+  aFibonacci[1] = 1;
+  for (size_t symbol = 2; symbol < 40; symbol++) {
+    aFibonacci[symbol] = aFibonacci[symbol - 1] + aFibonacci[symbol - 2];
+  }
+
+  /* Repeated frequencies exercise the tie-breaking order. */
+  size_t aFlat[HUFFMAN_ALPHABET_SIZE];
+  for (size_t symbol = 0; symbol < HUFFMAN_ALPHABET_SIZE; symbol++) {
+    aFlat[symbol] = 1 + (symbol % 3);
+  }
+
+  const size_t* apDistributions[] = {aFrequencies, aFibonacci, aFlat};
+  for (const size_t* pDistribution : apDistributions) {
+    ASSERT_EQ(createCodeLengthsFromFrequencies(pDistribution, aCodeLengths),
+              EXIT_SUCCESS);
+    createCodeLengthsWithWorkspace(pDistribution, aWorkspaceLengths,
+                                   &sWorkspace);
+    for (size_t symbol = 0; symbol < HUFFMAN_ALPHABET_SIZE; symbol++) {
+      ASSERT_EQ(aWorkspaceLengths[symbol], aCodeLengths[symbol])
+          << "symbol " << symbol;
+    }
+  }
+}
+
+/**
+ * @brief Test the canonical decoder tables match the canonical code table.
+ *
+ */
+TEST_F(HuffmanTreeTest, test_createCanonicalDecoder) {
+  uint8_t aLengths[HUFFMAN_ALPHABET_SIZE] = {0};
+  aLengths['d'] = 3;
+  aLengths['c'] = 3;
+  aLengths['b'] = 2;
+  aLengths['a'] = 1;
+  sHuffmanCanonicalDecoder_t sDecoder;
+
+  createCanonicalDecoder(aLengths, &sDecoder);
+
+  /* Codes are 0, 10, 110 and 111, read most significant bit first. */
+  ASSERT_EQ(sDecoder.maxLength, 3);
+  ASSERT_EQ(sDecoder.aFirstCodes[1], 0);
+  ASSERT_EQ(sDecoder.aFirstCodes[2], 2);
+  ASSERT_EQ(sDecoder.aFirstCodes[3], 6);
+  ASSERT_EQ(sDecoder.aCounts[3], 2);
+  ASSERT_EQ(sDecoder.aSymbols[sDecoder.aOffsets[1]], 'a');
+  ASSERT_EQ(sDecoder.aSymbols[sDecoder.aOffsets[2]], 'b');
+  ASSERT_EQ(sDecoder.aSymbols[sDecoder.aOffsets[3]], 'c');
+  ASSERT_EQ(sDecoder.aSymbols[sDecoder.aOffsets[3] + 1], 'd');
+}
+
+/**
+ * @brief Test a decode table resolves every code from its low bits, and
+ * leaves codes longer than the table width to the fallback.
+ *
+ */
+TEST_F(HuffmanTreeTest, test_createDecodeTable) {
+  uint8_t aLengths[HUFFMAN_ALPHABET_SIZE] = {0};
+  for (size_t symbol = 0; symbol < 12; symbol++) {
+    aLengths[symbol] = (uint8_t)(symbol + 1);
+  }
+  aLengths[12] = 12;
+  sHuffmanCodeTable_t sCodeTable;
+  ASSERT_EQ(createCanonicalCodeTable(aLengths, &sCodeTable), EXIT_SUCCESS);
+  decodeTableEntry_t aDecodeTable[HUFFMAN_DECODE_TABLE_SIZE];
+
+  ASSERT_EQ(createDecodeTable(&sCodeTable, aDecodeTable), 12U);
+
+  for (size_t symbol = 0; symbol < 13; symbol++) {
+    const decodeTableEntry_t entry =
+        aDecodeTable[sCodeTable.aCodes[symbol] &
+                     (HUFFMAN_DECODE_TABLE_SIZE - 1)];
+    if (aLengths[symbol] > HUFFMAN_DECODE_TABLE_BITS) {
+      ASSERT_EQ(entry, 0) << "symbol " << symbol;
+    } else {
+      ASSERT_EQ(entry >> 4, symbol);
+      ASSERT_EQ(entry & 0x0FU, aLengths[symbol]);
+    }
+  }
+}
+
+/**
+ * @brief Test a nibble tree decodes every code of a skewed alphabet, with its
+ * nodes numbered level by level, and leaves unused bits as 0.
+ *
+ */
+TEST_F(HuffmanTreeTest, test_createNibbleTree) {
+  uint8_t aLengths[HUFFMAN_ALPHABET_SIZE] = {0};
+  for (size_t symbol = 0; symbol < HUFFMAN_MAX_CODE_LENGTH; symbol++) {
+    aLengths[symbol] = (uint8_t)(symbol + 1);
+  }
+  aLengths[HUFFMAN_MAX_CODE_LENGTH] = HUFFMAN_MAX_CODE_LENGTH;
+  sHuffmanCodeTable_t sCodeTable;
+  ASSERT_EQ(createCanonicalCodeTable(aLengths, &sCodeTable), EXIT_SUCCESS);
+  sHuffmanNibbleTree_t sTree;
+
+  createNibbleTree(&sCodeTable, &sTree);
+
+  /* One node at each of the depths 0, 4, 8 and 12. */
+  ASSERT_EQ(sTree.nodeCount, 4U);
+  for (size_t symbol = 0; symbol <= HUFFMAN_MAX_CODE_LENGTH; symbol++) {
+    size_t code = sCodeTable.aCodes[symbol];
+    size_t node = 0;
+    size_t length = 0;
+    nibbleTreeEntry_t entry = 0;
+    while (((entry = sTree.aaNodes[node][code & 0x0FU]) & 0x0FU) == 0) {
+      ASSERT_NE(entry, 0) << "symbol " << symbol;
+      ASSERT_GT((size_t)(entry >> 4), node);
+      node = entry >> 4;
+      code >>= HUFFMAN_NIBBLE_TREE_BITS;
+      length += HUFFMAN_NIBBLE_TREE_BITS;
+    }
+    ASSERT_EQ(entry >> 4, symbol);
+    ASSERT_EQ(length + (entry & 0x0FU), aLengths[symbol]);
+  }
+
+  /* A single symbol has a 1-bit code, so codes starting with 1 are
+   * invalid. */
+  uint8_t aSingle[HUFFMAN_ALPHABET_SIZE] = {0};
+  aSingle['a'] = 1;
+  ASSERT_EQ(createCanonicalCodeTable(aSingle, &sCodeTable), EXIT_SUCCESS);
+  createNibbleTree(&sCodeTable, &sTree);
+  ASSERT_EQ(sTree.nodeCount, 1U);
+  for (size_t i = 0; i < HUFFMAN_NIBBLE_TREE_FANOUT; i++) {
+    ASSERT_EQ(sTree.aaNodes[0][i], ((i % 2) == 0) ? ('a' << 4) | 1 : 0);
+  }
+}
@@ -0,0 +1,292 @@
+/**
+ * @file test_lz77.cpp
+ * @brief Unit tests for lz77.c.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+/* External Includes */
+
+#include <gtest/gtest.h>
+
+/* Standard Library Includes */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+/* Project Includes */
+
+extern "C" {
+#include "huffmanCoding/codec.h"
+#include "huffmanCoding/lz77.h"
+#include "huffmanCoding/trackingAllocator.h"
+}
+
+/* Test Fixtures */
+
+/**
+ * @brief LZ77 test fixture.
+ *
+ */
+class Lz77Test : public ::testing::Test {
+ protected:
+  /**
+   * @brief Generate repetitive log lines.
+   *
+   * @param i_size The number of bytes to generate.
+   * @return std::vector<uint8_t> The log lines.
+   */
+  static std::vector<uint8_t> logLines(size_t i_size) {
+    static const char* const aLevels[] = {"INFO", "WARN", "DEBUG", "ERROR"};
+    static const char* const aMessages[] = {
+        "request completed", "cache miss for key", "connection reset by peer",
+        "retrying upload", "user logged in"};
+    std::mt19937 generator(39);
+    std::string text;
+    while (text.size() < i_size) {
+      text += "2026-10-19T12:" + std::to_string(generator() % 60) + ":" +
+              std::to_string(generator() % 60) + " [" +
+              aLevels[generator() % 4] + "] worker-" +
+              std::to_string(generator() % 8) + ": " +
+              aMessages[generator() % 5] + " id=" +
+              std::to_string(generator() % 100000) + "\n";
+    }
+    return std::vector<uint8_t>(text.begin(), text.begin() + (long)i_size);
+  }
+
+  /**
+   * @brief Compress and decompress a buffer and check the round trip.
+   *
+   * @param i_input The bytes to compress.
+   * @param i_psOptions The compression options, or NULL for the defaults.
+   * @return std::vector<uint8_t> The compressed container.
+   */
+  static std::vector<uint8_t> roundTrip(
+      const std::vector<uint8_t>& i_input,
+      const sHuffmanLz77Options_t* i_psOptions) {
+    std::vector<uint8_t> compressed(
+        getLz77CompressBound(i_input.size(), i_psOptions));
+    size_t compressedSize = 0;
+    EXPECT_EQ(compressLz77Buffer(i_input.data(), i_input.size(),
+                                 compressed.data(), compressed.size(),
+                                 &compressedSize, i_psOptions),
+              EXIT_SUCCESS);
+    compressed.resize(compressedSize);
+
+    size_t decompressedSize = 0;
+    EXPECT_EQ(getLz77DecompressedSize(compressed.data(), compressed.size(),
+                                      &decompressedSize),
+              EXIT_SUCCESS);
+    EXPECT_EQ(decompressedSize, i_input.size());
+
+    std::vector<uint8_t> output(i_input.size());
+    size_t outputSize = 0;
+    EXPECT_EQ(decompressLz77Buffer(compressed.data(), compressed.size(),
+                                   output.data(), output.size(), &outputSize),
+              EXIT_SUCCESS);
+    EXPECT_EQ(outputSize, i_input.size());
+    EXPECT_EQ(output, i_input);
+    return compressed;
+  }
+};
+
+/* Unit Tests */
+
+/**
+ * @brief Test buffers round trip at each level and block size.
+ *
+ */
+TEST_F(Lz77Test, test_compressLz77Buffer_RoundTrip) {
+  std::vector<uint8_t> random(50000);
+  std::mt19937 generator(40);
+  for (uint8_t& byte : random) {
+    byte = (uint8_t)generator();
+  }
+
+  /* Geometric bytes give codes longer than the decode table width. */
+  std::vector<uint8_t> longCodes(70000);
+  std::geometric_distribution<int> distribution(0.5);
+  for (uint8_t& byte : longCodes) {
+    byte = (uint8_t)distribution(generator);
+  }
+
+  const std::vector<std::vector<uint8_t>> inputs = {
+      {},
+      {'a'},
+      std::vector<uint8_t>(7, 'b'),
+      std::vector<uint8_t>(100000, 'c'),
+      logLines(300000),
+      random,
+      longCodes,
+  };
+  const size_t aBlockSizes[] = {1, 100, 4096, HUFFMAN_DEFAULT_BLOCK_SIZE};
+
+  for (int level = 0; level < HUFFMAN_LZ77_LEVEL_MAX; level++) {
+    for (size_t blockSize : aBlockSizes) {
+      sHuffmanLz77Options_t sOptions;
+      initLz77Options(&sOptions);
+      sOptions.eLevel = (eHuffmanLz77Level_t)level;
+      sOptions.blockSize = blockSize;
+      for (const std::vector<uint8_t>& input : inputs) {
+        if (blockSize < 100 && input.size() > 1000) {
+          continue;
+        }
+        (void)roundTrip(input, &sOptions);
+        ASSERT_FALSE(HasFailure())
+            << "level " << level << " block " << blockSize << " size "
+            << input.size();
+      }
+    }
+  }
+}
+
+/**
+ * @brief Test matches make log lines smaller than the plain codec does, and
+ * the greedy level smaller than the fast level.
+ *
+ */
+TEST_F(Lz77Test, test_compressLz77Buffer_Ratio) {
+  const std::vector<uint8_t> input = logLines(1 << 20);
+
+  std::vector<uint8_t> plain(getCompressBound(input.size(), NULL));
+  size_t plainSize = 0;
+  ASSERT_EQ(compressBuffer(input.data(), input.size(), plain.data(),
+                           plain.size(), &plainSize, NULL),
+            EXIT_SUCCESS);
+
+  sHuffmanLz77Options_t sOptions;
+  initLz77Options(&sOptions);
+  const size_t fastSize = roundTrip(input, &sOptions).size();
+  sOptions.eLevel = HUFFMAN_LZ77_LEVEL_GREEDY;
+  const size_t greedySize = roundTrip(input, &sOptions).size();
+
+  ASSERT_LT(fastSize, plainSize * 3 / 4);
+  ASSERT_LE(greedySize, fastSize);
+}
+
+/**
+ * @brief Test incompressible blocks are stored and stay within the bound.
+ *
+ */
+TEST_F(Lz77Test, test_compressLz77Buffer_Stored) {
+  std::vector<uint8_t> input(10000);
+  std::mt19937 generator(41);
+  for (uint8_t& byte : input) {
+    byte = (uint8_t)generator();
+  }
+
+  const std::vector<uint8_t> compressed = roundTrip(input, NULL);
+  ASSERT_EQ(compressed.size(), HUFFMAN_LZ77_HEADER_SIZE +
+                                   HUFFMAN_LZ77_BLOCK_HEADER_SIZE +
+                                   input.size() + 4);
+  ASSERT_EQ(compressed[HUFFMAN_LZ77_HEADER_SIZE + 8],
+            HUFFMAN_BLOCK_FLAG_STORED);
+}
+
+/**
+ * @brief Test the encoder's memory comes from the given allocator and is
+ * freed.
+ *
+ */
+TEST_F(Lz77Test, test_compressLz77Buffer_Allocator) {
+  const std::vector<uint8_t> input = logLines(100000);
+  sHuffmanTrackingAllocator_t sTracker;
+  initTrackingAllocator(&sTracker, NULL);
+
+  sHuffmanLz77Options_t sOptions;
+  initLz77Options(&sOptions);
+  sOptions.eLevel = HUFFMAN_LZ77_LEVEL_GREEDY;
+  sOptions.psAllocator = &sTracker.sAllocator;
+  (void)roundTrip(input, &sOptions);
+
+  ASSERT_GT(sTracker.sTotal.allocations, 0U);
+  ASSERT_EQ(sTracker.sTotal.frees, sTracker.sTotal.allocations);
+  ASSERT_EQ(sTracker.sTotal.currentBytes, 0U);
+}
+
+/**
+ * @brief Test invalid options and small outputs are rejected.
+ *
+ */
+TEST_F(Lz77Test, test_compressLz77Buffer_Invalid) {
+  const std::vector<uint8_t> input = logLines(10000);
+  std::vector<uint8_t> output(getLz77CompressBound(input.size(), NULL));
+  size_t outputSize = 0;
+
+  sHuffmanLz77Options_t sOptions;
+  initLz77Options(&sOptions);
+  sOptions.eLevel = HUFFMAN_LZ77_LEVEL_MAX;
+  ASSERT_EQ(compressLz77Buffer(input.data(), input.size(), output.data(),
+                               output.size(), &outputSize, &sOptions),
+            EXIT_FAILURE);
+
+  initLz77Options(&sOptions);
+  sOptions.blockSize = 0;
+  ASSERT_EQ(compressLz77Buffer(input.data(), input.size(), output.data(),
+                               output.size(), &outputSize, &sOptions),
+            EXIT_FAILURE);
+
+  ASSERT_EQ(compressLz77Buffer(input.data(), input.size(), output.data(), 100,
+                               &outputSize, NULL),
+            EXIT_FAILURE);
+}
+
+/**
+ * @brief Test corrupted and truncated containers are rejected without
+ * writing past the output.
+ *
+ */
+TEST_F(Lz77Test, test_decompressLz77Buffer_Invalid) {
+  const std::vector<uint8_t> input = logLines(20000);
+  const std::vector<uint8_t> compressed = roundTrip(input, NULL);
+  std::vector<uint8_t> output(input.size());
+  size_t outputSize = 0;
+
+  /* Truncated containers. */
+  for (size_t size = 0; size < compressed.size(); size += 97) {
+    ASSERT_EQ(decompressLz77Buffer(compressed.data(), size, output.data(),
+                                   output.size(), &outputSize),
+              EXIT_FAILURE)
+        << size;
+  }
+
+  /* Too small an output. */
+  ASSERT_EQ(decompressLz77Buffer(compressed.data(), compressed.size(),
+                                 output.data(), output.size() - 1,
+                                 &outputSize),
+            EXIT_FAILURE);
+
+  /* Wrong magic and version. */
+  std::vector<uint8_t> corrupted = compressed;
+  corrupted[0] = 'X';
+  ASSERT_EQ(decompressLz77Buffer(corrupted.data(), corrupted.size(),
+                                 output.data(), output.size(), &outputSize),
+            EXIT_FAILURE);
+  corrupted = compressed;
+  corrupted[4] = 99;
+  ASSERT_EQ(decompressLz77Buffer(corrupted.data(), corrupted.size(),
+                                 output.data(), output.size(), &outputSize),
+            EXIT_FAILURE);
+
+  /* Flipped payload bits either fail or decode to the right size. */
+  std::mt19937 generator(42);
+  for (int i = 0; i < 200; i++) {
+    corrupted = compressed;
+    const size_t position =
+        HUFFMAN_LZ77_HEADER_SIZE +
+        (generator() % (compressed.size() - HUFFMAN_LZ77_HEADER_SIZE - 4));
+    corrupted[position] ^= (uint8_t)(1U << (generator() % 8));
+    outputSize = 0;
+    if (decompressLz77Buffer(corrupted.data(), corrupted.size(),
+                             output.data(), output.size(),
+                             &outputSize) == EXIT_SUCCESS) {
+      ASSERT_EQ(outputSize, input.size());
+    }
+  }
+}
@@ -0,0 +1,178 @@
+/**
+ * @file test_parallelDecoder.cpp
+ * @brief Unit tests for parallelDecoder.c.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+/* External Includes */
+
+#include <gtest/gtest.h>
+
+/* Standard Library Includes */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+/* Project Includes */
+
+#include "testUtils.hpp"
+
+extern "C" {
+#include "huffmanCoding/bitStream.h"
+#include "huffmanCoding/codec.h"
+#include "huffmanCoding/encodeKernel.h"
+#include "huffmanCoding/huffmanTree.h"
+#include "huffmanCoding/parallelDecoder.h"
+#include "huffmanCoding/task4.h"
+#include "huffmanCoding/trackingAllocator.h"
+}
+
+/* Test Fixtures */
+
+/**
+ * @brief Parallel decoder test fixture.
+ *
+ */
+class ParallelDecoderTest : public ::testing::Test {
+ protected:
+  uint8_t aCodeLengths[HUFFMAN_ALPHABET_SIZE];
+  sHuffmanCodeTable_t sCodeTable;
+  decodeTableEntry_t aDecodeTable[HUFFMAN_DECODE_TABLE_SIZE];
+  sHuffmanNibbleTree_t sTree;
+
+  /**
+   * @brief Build the coding tables of a buffer.
+   *
+   * @param i_input The bytes to build the tables from.
+   */
+  void buildTables(const std::vector<uint8_t>& i_input) {
+    size_t aFrequencies[HUFFMAN_ALPHABET_SIZE] = {0};
+    countByteFrequencies(i_input.data(), i_input.size(), aFrequencies);
+    ASSERT_EQ(createCodeLengthsFromFrequencies(aFrequencies, aCodeLengths),
+              EXIT_SUCCESS);
+    ASSERT_EQ(createCanonicalCodeTable(aCodeLengths, &sCodeTable),
+              EXIT_SUCCESS);
+    (void)createDecodeTable(&sCodeTable, aDecodeTable);
+    createNibbleTree(&sCodeTable, &sTree);
+  }
+
+  /**
+   * @brief Code a buffer.
+   *
+   * @param i_input The bytes to code.
+   * @return std::vector<uint8_t> The flushed payload.
+   */
+  std::vector<uint8_t> encode(const std::vector<uint8_t>& i_input) {
+    std::vector<uint8_t> payload(i_input.size() * 2 + 8);
+    sBitWriter_t sWriter;
+    initBitWriter(&sWriter, payload.data());
+    encodeTableSymbols(&sCodeTable, i_input.data(), i_input.size(), &sWriter);
+    payload.resize(flushBitWriter(&sWriter));
+    return payload;
+  }
+};
+
+/* Unit Tests */
+
+/**
+ * @brief Test the parallel decoder decodes the same bytes as were coded, for
+ * any number of threads and with codes longer than the table width.
+ *
+ */
+TEST_F(ParallelDecoderTest, test_decodeTableSymbolsParallel) {
+  const double aProbabilities[] = {0.5, 0.3, 0.05};
+  const size_t aSizes[] = {0, 1, 100000, 1000003};
+  const size_t aThreadCounts[] = {0, 1, 2, 3, 4, 7, 16};
+
+  for (double probability : aProbabilities) {
+    const std::vector<uint8_t> symbols =
+        generateGeometricBytes(aSizes[3], probability, 41);
+    buildTables(symbols);
+    ASSERT_FALSE(HasFailure());
+
+    for (size_t size : aSizes) {
+      const std::vector<uint8_t> input(symbols.begin(),
+                                       symbols.begin() + (long)size);
+      const std::vector<uint8_t> payload = encode(input);
+      for (size_t threadCount : aThreadCounts) {
+        std::vector<uint8_t> output(size, 0xA5);
+        ASSERT_EQ(decodeTableSymbolsParallel(
+                      aDecodeTable, &sTree, payload.data(), payload.size(),
+                      output.data(), output.size(), threadCount, NULL),
+                  EXIT_SUCCESS)
+            << probability << " " << size << " " << threadCount;
+        ASSERT_EQ(output, input)
+            << probability << " " << size << " " << threadCount;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Test truncated payloads fail as they do when decoded serially, and
+ * the threads' buffers come from the given allocator.
+ *
+ */
+TEST_F(ParallelDecoderTest, test_decodeTableSymbolsParallel_Invalid) {
+  const std::vector<uint8_t> input = generateGeometricBytes(1000000, 0.1, 42);
+  buildTables(input);
+  ASSERT_FALSE(HasFailure());
+  const std::vector<uint8_t> payload = encode(input);
+
+  sHuffmanTrackingAllocator_t sTracker;
+  initTrackingAllocator(&sTracker, NULL);
+  std::vector<uint8_t> output(input.size());
+  ASSERT_EQ(decodeTableSymbolsParallel(aDecodeTable, &sTree,
+                                       payload.data(), payload.size() - 1,
+                                       output.data(), output.size(), 4,
+                                       &sTracker.sAllocator),
+            EXIT_FAILURE);
+  ASSERT_EQ(decodeTableSymbolsParallel(aDecodeTable, &sTree,
+                                       payload.data(), payload.size(),
+                                       output.data(), output.size(), 4,
+                                       &sTracker.sAllocator),
+            EXIT_SUCCESS);
+  ASSERT_EQ(output, input);
+  ASSERT_EQ(sTracker.sTotal.allocations, 2U);
+  ASSERT_EQ(sTracker.sTotal.frees, sTracker.sTotal.allocations);
+}
+
+/**
+ * @brief Test containers decompressed with several threads match those
+ * decompressed with one, including blocks with sync points.
+ *
+ */
+TEST_F(ParallelDecoderTest, test_decompressBufferWithThreads) {
+  const std::vector<uint8_t> input =
+      generateGeometricBytes((size_t)3 << 20, 0.1, 43);
+
+  for (size_t syncInterval : {(size_t)0, (size_t)65536}) {
+    sHuffmanCompressOptions_t sOptions;
+    initCompressOptions(&sOptions);
+    sOptions.blockSize = (size_t)1 << 20;
+    sOptions.syncInterval = syncInterval;
+    std::vector<uint8_t> compressed(getCompressBound(input.size(), &sOptions));
+    size_t compressedSize = 0;
+    ASSERT_EQ(compressBuffer(input.data(), input.size(), compressed.data(),
+                             compressed.size(), &compressedSize, &sOptions),
+              EXIT_SUCCESS);
+    compressed.resize(compressedSize);
+
+    for (size_t threadCount : {(size_t)1, (size_t)4}) {
+      std::vector<uint8_t> output(input.size());
+      size_t outputSize = 0;
+      ASSERT_EQ(decompressBufferWithThreads(compressed.data(),
+                                            compressed.size(), output.data(),
+                                            output.size(), &outputSize,
+                                            threadCount),
+                EXIT_SUCCESS);
+      ASSERT_EQ(outputSize, input.size());
+      ASSERT_EQ(output, input);
+    }
+  }
+}
@@ -0,0 +1,162 @@
+/**
+ * @file test_parallelEncoder.cpp
+ * @brief Unit tests for parallelEncoder.c.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+/* External Includes */
+
+#include <gtest/gtest.h>
+
+/* Standard Library Includes */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+/* Project Includes */
+
+extern "C" {
+#include "huffmanCoding/bitStream.h"
+#include "huffmanCoding/codec.h"
+#include "huffmanCoding/encodeKernel.h"
+#include "huffmanCoding/huffmanTree.h"
+#include "huffmanCoding/parallelEncoder.h"
+#include "huffmanCoding/task4.h"
+}
+
+/* Test Fixtures */
+
+/**
+ * @brief Parallel encoder test fixture.
+ *
+ */
+class ParallelEncoderTest : public ::testing::Test {
+ protected:
+  sHuffmanCodeTable_t sCodeTable;
+
+  /**
+   * @brief Build the code table of a buffer.
+   *
+   * @param i_input The bytes to build the code table from.
+   */
+  void buildCodeTable(const std::vector<uint8_t>& i_input) {
+    size_t aFrequencies[HUFFMAN_ALPHABET_SIZE] = {0};
+    uint8_t aCodeLengths[HUFFMAN_ALPHABET_SIZE] = {0};
+    countByteFrequencies(i_input.data(), i_input.size(), aFrequencies);
+    ASSERT_EQ(createCodeLengthsFromFrequencies(aFrequencies, aCodeLengths),
+              EXIT_SUCCESS);
+    ASSERT_EQ(createCanonicalCodeTable(aCodeLengths, &sCodeTable),
+              EXIT_SUCCESS);
+  }
+
+  /**
+   * @brief Code a buffer on the calling thread.
+   *
+   * @param i_input The bytes to code.
+   * @return std::vector<uint8_t> The flushed output.
+   */
+  std::vector<uint8_t> encodeSerial(const std::vector<uint8_t>& i_input) {
+    std::vector<uint8_t> output(i_input.size() * 2 + 8);
+    sBitWriter_t sWriter;
+    initBitWriter(&sWriter, output.data());
+    encodeTableSymbols(&sCodeTable, i_input.data(), i_input.size(), &sWriter);
+    output.resize(flushBitWriter(&sWriter));
+    return output;
+  }
+
+  /**
+   * @brief Code a buffer with several threads.
+   *
+   * @param i_input The bytes to code.
+   * @param i_threadCount The number of threads.
+   * @return std::vector<uint8_t> The output.
+   */
+  std::vector<uint8_t> encodeParallel(const std::vector<uint8_t>& i_input,
+                                      size_t i_threadCount) {
+    std::vector<uint8_t> output(i_input.size() * 2 + 8, 0xA5);
+    output.resize(encodeTableSymbolsParallel(&sCodeTable, i_input.data(),
+                                             i_input.size(), i_threadCount,
+                                             output.data()));
+    return output;
+  }
+};
+
+/* Unit Tests */
+
+/**
+ * @brief Test the parallel encoder writes the same bits as the serial
+ * encoder, for any number of threads and range boundaries at any bit.
+ *
+ */
+TEST_F(ParallelEncoderTest, test_encodeTableSymbolsParallel) {
+  /* Geometric bytes give codes of every length up to the maximum. */
+  std::mt19937 generator(40);
+  std::geometric_distribution<int> distribution(0.3);
+  std::vector<uint8_t> symbols(HUFFMAN_PARALLEL_MIN_RANGE_SIZE * 9 + 1234);
+  for (uint8_t& byte : symbols) {
+    byte = (uint8_t)distribution(generator);
+  }
+  buildCodeTable(symbols);
+
+  const size_t aSizes[] = {0,
+                           1,
+                           HUFFMAN_PARALLEL_MIN_RANGE_SIZE * 2 - 1,
+                           HUFFMAN_PARALLEL_MIN_RANGE_SIZE * 2,
+                           HUFFMAN_PARALLEL_MIN_RANGE_SIZE * 5 + 3,
+                           symbols.size()};
+  const size_t aThreadCounts[] = {0, 1, 2, 3, 4, 7, 16};
+  for (size_t size : aSizes) {
+    const std::vector<uint8_t> input(symbols.begin(), symbols.begin() + size);
+    const std::vector<uint8_t> expected = encodeSerial(input);
+    for (size_t threadCount : aThreadCounts) {
+      ASSERT_EQ(encodeParallel(input, threadCount), expected)
+          << size << " " << threadCount;
+    }
+  }
+}
+
+/**
+ * @brief Test containers compressed with several threads are identical to
+ * those compressed with one.
+ *
+ */
+TEST_F(ParallelEncoderTest, test_compressBuffer_Threads) {
+  std::mt19937 generator(41);
+  std::geometric_distribution<int> distribution(0.1);
+  std::vector<uint8_t> input((size_t)3 << 20);
+  for (uint8_t& byte : input) {
+    byte = (uint8_t)distribution(generator);
+  }
+
+  sHuffmanCompressOptions_t sOptions;
+  initCompressOptions(&sOptions);
+  sOptions.blockSize = HUFFMAN_MAX_BLOCK_SIZE;
+  std::vector<uint8_t> expected(getCompressBound(input.size(), &sOptions));
+  size_t expectedSize = 0;
+  ASSERT_EQ(compressBuffer(input.data(), input.size(), expected.data(),
+                           expected.size(), &expectedSize, &sOptions),
+            EXIT_SUCCESS);
+  expected.resize(expectedSize);
+
+  sOptions.threadCount = 4;
+  std::vector<uint8_t> compressed(getCompressBound(input.size(), &sOptions));
+  size_t compressedSize = 0;
+  ASSERT_EQ(compressBuffer(input.data(), input.size(), compressed.data(),
+                           compressed.size(), &compressedSize, &sOptions),
+            EXIT_SUCCESS);
+  compressed.resize(compressedSize);
+  ASSERT_EQ(compressed, expected);
+
+  std::vector<uint8_t> output(input.size());
+  size_t outputSize = 0;
+  ASSERT_EQ(decompressBuffer(compressed.data(), compressed.size(),
+                             output.data(), output.size(), &outputSize),
+            EXIT_SUCCESS);
+  ASSERT_EQ(output, input);
+}
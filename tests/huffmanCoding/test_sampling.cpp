@@ -0,0 +1,121 @@
+/**
+ * @file test_sampling.cpp
+ * @brief Unit tests for sampling.c.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+/* External Includes */
+
+#include <gtest/gtest.h>
+
+/* Standard Library Includes */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <vector>
+
+/* Project Includes */
+
+extern "C" {
+#include "huffmanCoding/huffmanTree.h"
+#include "huffmanCoding/sampling.h"
+#include "huffmanCoding/task4.h"
+}
+
+/* Unit Tests */
+
+/**
+ * @brief Test an interval of 0 or 1 counts every byte, and that a sample is
+ * scaled to the buffer and gives every byte value a frequency.
+ *
+ */
+TEST(SamplingTest, test_sampleByteFrequencies) {
+  std::vector<uint8_t> input(100000);
+  std::mt19937 generator(16);
+  for (uint8_t& byte : input) {
+    byte = (uint8_t)('a' + (generator() % 20));
+  }
+  std::vector<size_t> expected(HUFFMAN_ALPHABET_SIZE);
+  std::vector<size_t> frequencies(HUFFMAN_ALPHABET_SIZE);
+  countByteFrequencies(input.data(), input.size(), expected.data());
+
+  for (const size_t interval : {size_t{0}, size_t{1}}) {
+    ASSERT_EQ(sampleByteFrequencies(input.data(), input.size(), interval,
+                                    frequencies.data()),
+              20U);
+    ASSERT_EQ(frequencies, expected);
+  }
+
+  ASSERT_EQ(sampleByteFrequencies(input.data(), input.size(), 8,
+                                  frequencies.data()),
+            20U);
+  for (size_t symbol = 0; symbol < HUFFMAN_ALPHABET_SIZE; symbol++) {
+    if (expected[symbol] == 0) {
+      ASSERT_EQ(frequencies[symbol], 1U);
+    } else {
+      ASSERT_NEAR((double)frequencies[symbol], (double)expected[symbol],
+                  0.2 * (double)expected[symbol]);
+    }
+  }
+  const size_t total =
+      std::accumulate(frequencies.begin(), frequencies.end(), size_t{0});
+  ASSERT_NEAR((double)total, (double)input.size(), 0.01 * input.size());
+
+  /* The same buffer always gives the same sample. */
+  std::vector<size_t> again(HUFFMAN_ALPHABET_SIZE);
+  (void)sampleByteFrequencies(input.data(), input.size(), 8, again.data());
+  ASSERT_EQ(again, frequencies);
+
+  /* A buffer shorter than a window still samples a run. */
+  ASSERT_EQ(sampleByteFrequencies(input.data(), 3, 8, frequencies.data()),
+            (size_t)(1 + (input[0] != input[1]) +
+                     (input[2] != input[0] && input[2] != input[1])));
+  ASSERT_EQ(sampleByteFrequencies(input.data(), 0, 8, frequencies.data()),
+            0U);
+}
+
+/**
+ * @brief Test which blocks are sampled.
+ *
+ */
+TEST(SamplingTest, test_isBlockSampled) {
+  ASSERT_TRUE(isBlockSampled(HUFFMAN_SAMPLE_MIN_BLOCK_SIZE, 2));
+  ASSERT_FALSE(isBlockSampled(HUFFMAN_SAMPLE_MIN_BLOCK_SIZE - 1, 8));
+  ASSERT_FALSE(isBlockSampled(HUFFMAN_SAMPLE_MIN_BLOCK_SIZE, 1));
+  ASSERT_FALSE(isBlockSampled(HUFFMAN_SAMPLE_MIN_BLOCK_SIZE, 0));
+}
+
+/**
+ * @brief Test the reported loss is nothing for blocks counted exactly and
+ * small for a sampled block.
+ *
+ */
+TEST(SamplingTest, test_addSamplingLoss) {
+  std::vector<uint8_t> input(HUFFMAN_SAMPLE_MIN_BLOCK_SIZE);
+  std::mt19937 generator(17);
+  std::geometric_distribution<int> distribution(0.1);
+  for (uint8_t& byte : input) {
+    byte = (uint8_t)(distribution(generator) % 48);
+  }
+
+  sHuffmanSamplingLoss_t sLoss = {0, 0};
+  ASSERT_EQ(addSamplingLoss(input.data(), input.size() - 1, 8, &sLoss),
+            EXIT_SUCCESS);
+  ASSERT_GT(sLoss.exactBits, 0U);
+  ASSERT_EQ(sLoss.sampledBits, sLoss.exactBits);
+
+  /* The totals accumulate over blocks. */
+  const sHuffmanSamplingLoss_t sSmall = sLoss;
+  ASSERT_EQ(addSamplingLoss(input.data(), input.size(), 8, &sLoss),
+            EXIT_SUCCESS);
+  const uint64_t exactBits = sLoss.exactBits - sSmall.exactBits;
+  const uint64_t sampledBits = sLoss.sampledBits - sSmall.sampledBits;
+  ASSERT_GE(sampledBits, exactBits);
+  ASSERT_LT(sampledBits, exactBits + (exactBits / 100));
+}
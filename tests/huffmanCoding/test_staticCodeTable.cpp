@@ -0,0 +1,184 @@
+/**
+ * @file test_staticCodeTable.cpp
+ * @brief Unit tests for staticCodeTable.hpp.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+/* External Includes */
+
+#include <gtest/gtest.h>
+
+/* Standard Library Includes */
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+/* Project Includes */
+
+#include "huffmanCoding/staticCodeTable.hpp"
+
+/* Constants */
+
+/**
+ * @brief The frequencies of "to be or not to be".
+ *
+ * @return std::array<size_t, HUFFMAN_ALPHABET_SIZE> The frequencies.
+ */
+static constexpr std::array<size_t, HUFFMAN_ALPHABET_SIZE>
+makeTextFrequencies() {
+  std::array<size_t, HUFFMAN_ALPHABET_SIZE> aFrequencies = {};
+  aFrequencies[' '] = 5;
+  aFrequencies['o'] = 4;
+  aFrequencies['t'] = 3;
+  aFrequencies['b'] = 2;
+  aFrequencies['e'] = 2;
+  aFrequencies['n'] = 1;
+  aFrequencies['r'] = 1;
+  return aFrequencies;
+}
+
+/**
+ * @brief A Fibonacci distribution, which needs its code lengths limited.
+ *
+ * @return std::array<size_t, HUFFMAN_ALPHABET_SIZE> The frequencies.
+ */
+static constexpr std::array<size_t, HUFFMAN_ALPHABET_SIZE>
+makeFibonacciFrequencies() {
+  std::array<size_t, HUFFMAN_ALPHABET_SIZE> aFrequencies = {};
+  aFrequencies[0] = 1;
+  aFrequencies[1] = 1;
+  for (size_t symbol = 2; symbol < 40; symbol++) {
+    aFrequencies[symbol] = aFrequencies[symbol - 1] + aFrequencies[symbol - 2];
+  }
+  return aFrequencies;
+}
+
+/**
+ * @brief A hex dump distribution, with ties between many symbols.
+ *
+ * @return std::array<size_t, HUFFMAN_ALPHABET_SIZE> The frequencies.
+ */
+static constexpr std::array<size_t, HUFFMAN_ALPHABET_SIZE>
+makeHexDumpFrequencies() {
+  std::array<size_t, HUFFMAN_ALPHABET_SIZE> aFrequencies = {};
+  for (size_t symbol = 0; symbol < HUFFMAN_ALPHABET_SIZE; symbol++) {
+    aFrequencies[symbol] = 1;
+  }
+  for (const char* pDigit = "0123456789abcdef"; *pDigit != '\0'; pDigit++) {
+    aFrequencies[(uint8_t)*pDigit] = 100;
+  }
+  aFrequencies[' '] = 120;
+  aFrequencies['\n'] = 8;
+  return aFrequencies;
+}
+
+/**< Tables generated by the compiler. */
+static constexpr huffman::StaticCodeTable TEXT_TABLE =
+    huffman::makeStaticCodeTable(makeTextFrequencies());
+static constexpr huffman::StaticCodeTable FIBONACCI_TABLE =
+    huffman::makeStaticCodeTable(makeFibonacciFrequencies());
+static constexpr huffman::StaticCodeTable HEX_DUMP_TABLE =
+    huffman::makeStaticCodeTable(makeHexDumpFrequencies());
+
+static_assert(TEXT_TABLE.codeLengths[' '] == 2, "' ' is the most frequent");
+static_assert(FIBONACCI_TABLE.maxLength == HUFFMAN_MAX_CODE_LENGTH,
+              "Fibonacci code lengths are limited");
+
+/* Helper Functions */
+
+/**
+ * @brief Assert a static code table matches the runtime tree builder.
+ *
+ * @param i_sTable The static code table.
+ * @param i_aFrequencies The frequencies it was generated from.
+ */
+static void expectMatchesRuntime(
+    const huffman::StaticCodeTable& i_sTable,
+    const std::array<size_t, HUFFMAN_ALPHABET_SIZE>& i_aFrequencies) {
+  uint8_t aCodeLengths[HUFFMAN_ALPHABET_SIZE];
+  sHuffmanCodeTable_t sCodeTable;
+  sHuffmanCanonicalDecoder_t sDecoder;
+  ASSERT_EQ(createCodeLengthsFromFrequencies(i_aFrequencies.data(),
+                                             aCodeLengths),
+            EXIT_SUCCESS);
+  ASSERT_EQ(createCanonicalCodeTable(aCodeLengths, &sCodeTable), EXIT_SUCCESS);
+  createCanonicalDecoder(aCodeLengths, &sDecoder);
+
+  size_t symbolCount = 0;
+  for (size_t symbol = 0; symbol < HUFFMAN_ALPHABET_SIZE; symbol++) {
+    EXPECT_EQ(i_sTable.codeLengths[symbol], sCodeTable.aCodeLengths[symbol])
+        << "symbol " << symbol;
+    EXPECT_EQ(i_sTable.codes[symbol], sCodeTable.aCodes[symbol])
+        << "symbol " << symbol;
+  }
+  for (size_t length = 1; length <= HUFFMAN_MAX_CODE_LENGTH; length++) {
+    EXPECT_EQ(i_sTable.firstCodes[length], sDecoder.aFirstCodes[length]);
+    EXPECT_EQ(i_sTable.counts[length], sDecoder.aCounts[length]);
+    EXPECT_EQ(i_sTable.offsets[length], sDecoder.aOffsets[length]);
+    symbolCount += sDecoder.aCounts[length];
+  }
+
+  /* Only the symbols that have a code are filled in by the decoder. */
+  for (size_t i = 0; i < symbolCount; i++) {
+    EXPECT_EQ(i_sTable.symbols[i], sDecoder.aSymbols[i]) << "index " << i;
+  }
+  EXPECT_EQ(i_sTable.maxLength, sDecoder.maxLength);
+}
+
+/* Unit Tests */
+
+/**
+ * @brief Test compile-time tables match the runtime tree builder.
+ *
+ */
+TEST(StaticCodeTableTest, test_makeStaticCodeTable_MatchesRuntime) {
+  expectMatchesRuntime(TEXT_TABLE, makeTextFrequencies());
+  expectMatchesRuntime(FIBONACCI_TABLE, makeFibonacciFrequencies());
+  expectMatchesRuntime(HEX_DUMP_TABLE, makeHexDumpFrequencies());
+}
+
+/**
+ * @brief Test a round trip through a static table, including long codes.
+ *
+ */
+TEST(StaticCodeTableTest, test_encodeWithStaticTable_RoundTrip) {
+  std::vector<uint8_t> input;
+  for (uint8_t symbol = 0; symbol < 40; symbol++) {
+    input.insert(input.end(), (size_t)(40 - symbol) * 3, symbol);
+  }
+  std::shuffle(input.begin(), input.end(), std::mt19937(4));
+
+  std::vector<uint8_t> encoded(input.size() * 2);
+  const huffman::Result sEncoded =
+      huffman::encodeWithStaticTable(FIBONACCI_TABLE, input, encoded);
+  ASSERT_TRUE(sEncoded);
+
+  std::vector<uint8_t> decoded(input.size());
+  const huffman::Result sDecoded = huffman::decodeWithStaticTable(
+      FIBONACCI_TABLE, huffman::ByteSpan(encoded.data(), sEncoded.size),
+      decoded);
+  ASSERT_TRUE(sDecoded);
+  ASSERT_EQ(decoded, input);
+}
+
+/**
+ * @brief Test encoding a byte the static table has no code for.
+ *
+ */
+TEST(StaticCodeTableTest, test_encodeWithStaticTable_UncodedSymbol) {
+  const uint8_t input[] = {'t', 'o', 'x'};
+  uint8_t output[16];
+
+  const huffman::Result sResult =
+      huffman::encodeWithStaticTable(TEXT_TABLE, input, output);
+
+  ASSERT_EQ(sResult.error, huffman::Error::InvalidArgument);
+}
@@ -0,0 +1,216 @@
+/**
+ * @file test_stats.cpp
+ * @brief Unit tests for stats.c.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+/* External Includes */
+
+#include <gtest/gtest.h>
+
+/* Standard Library Includes */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/* Project Includes */
+
+extern "C" {
+#include "huffmanCoding/codec.h"
+#include "huffmanCoding/stats.h"
+#include "huffmanCoding/task2.h"
+}
+
+/* Test Fixtures */
+
+/**
+ * @brief Instrumentation test fixture, starting each test from zero.
+ *
+ */
+class StatsTest : public ::testing::Test {
+ protected:
+  void SetUp() override { resetHuffmanStats(); }
+};
+
+/* Unit Tests */
+
+/**
+ * @brief Test the instrumentation is compiled into the tests.
+ *
+ */
+TEST_F(StatsTest, test_isHuffmanStatsEnabled) {
+  EXPECT_TRUE(isHuffmanStatsEnabled());
+}
+
+/**
+ * @brief Test a round trip records every stage and counter.
+ *
+ */
+TEST_F(StatsTest, test_roundTripCounters) {
+  const std::string text = "to be or not to be";
+  std::vector<uint8_t> input(text.begin(), text.end());
+  /* Larger than the small input size, so that trees are built with the
+     allocator. */
+  input.resize(8192, 'e');
+  sHuffmanCompressOptions_t sOptions;
+  initCompressOptions(&sOptions);
+  sOptions.blockSize = 2048;
+
+  std::vector<uint8_t> compressed(getCompressBound(input.size(), &sOptions));
+  size_t compressedSize = 0;
+  ASSERT_EQ(compressBuffer(input.data(), input.size(), compressed.data(),
+                           compressed.size(), &compressedSize, &sOptions),
+            EXIT_SUCCESS);
+
+  std::vector<uint8_t> output(input.size());
+  size_t outputSize = 0;
+  ASSERT_EQ(decompressBuffer(compressed.data(), compressedSize, output.data(),
+                             output.size(), &outputSize),
+            EXIT_SUCCESS);
+
+  sHuffmanStats_t sStats;
+  getHuffmanStats(&sStats);
+
+  EXPECT_EQ(sStats.blocksEncoded, 4U);
+  EXPECT_EQ(sStats.blocksDecoded, 4U);
+  EXPECT_EQ(sStats.blocksStored, 0U);
+  EXPECT_EQ(sStats.symbolsEncoded, input.size());
+  EXPECT_EQ(sStats.symbolsDecoded, input.size());
+  EXPECT_EQ(sStats.aStageCalls[HUFFMAN_STAGE_HISTOGRAM], 4U);
+  EXPECT_EQ(sStats.aStageBytes[HUFFMAN_STAGE_HISTOGRAM], input.size());
+  EXPECT_EQ(sStats.aStageCalls[HUFFMAN_STAGE_TREE_BUILD], 4U);
+  EXPECT_EQ(sStats.aStageCalls[HUFFMAN_STAGE_TABLE_BUILD], 4U);
+  EXPECT_EQ(sStats.aStageBytes[HUFFMAN_STAGE_ENCODE], input.size());
+  EXPECT_EQ(sStats.aStageBytes[HUFFMAN_STAGE_DECODE], input.size());
+  EXPECT_GT(sStats.maxTreeDepth, 0U);
+
+  /* Every allocation made while building trees is freed again. */
+  EXPECT_GT(sStats.allocations, 0U);
+  EXPECT_EQ(sStats.allocations, sStats.frees);
+
+  /* The first block uses 7 symbols, the others only 'e'. */
+  uint64_t codes = 0;
+  for (size_t length = 0; length <= HUFFMAN_MAX_CODE_LENGTH; length++) {
+    codes += sStats.aCodeLengthHistogram[length];
+  }
+  EXPECT_EQ(codes, 7U + 3U);
+  EXPECT_GE(sStats.aCodeLengthHistogram[1], 3U);
+}
+
+/**
+ * @brief Test stored blocks and length-limited rebuilds are counted.
+ *
+ */
+TEST_F(StatsTest, test_storedAndRebuildCounters) {
+  /* Fibonacci frequencies force code lengths above the limit. */
+  std::vector<uint8_t> input;
+  size_t previous = 1;
+  size_t current = 1;
+  for (int symbol = 0; symbol < 20; symbol++) {
+    input.insert(input.end(), current, (uint8_t)('A' + symbol));
+    const size_t next = previous + current;
+    previous = current;
+    current = next;
+  }
+
+  std::vector<uint8_t> compressed(getCompressBound(input.size(), NULL));
+  size_t compressedSize = 0;
+  ASSERT_EQ(compressBuffer(input.data(), input.size(), compressed.data(),
+                           compressed.size(), &compressedSize, NULL),
+            EXIT_SUCCESS);
+
+  sHuffmanStats_t sStats;
+  getHuffmanStats(&sStats);
+  EXPECT_GT(sStats.lengthLimitRebuilds, 0U);
+  EXPECT_GT(sStats.maxTreeDepth, (uint64_t)HUFFMAN_MAX_CODE_LENGTH);
+
+  /* A buffer of distinct bytes cannot shrink, so it is stored. */
+  resetHuffmanStats();
+  std::vector<uint8_t> distinct(256);
+  for (size_t i = 0; i < distinct.size(); i++) {
+    distinct[i] = (uint8_t)i;
+  }
+  ASSERT_EQ(compressBuffer(distinct.data(), distinct.size(), compressed.data(),
+                           compressed.size(), &compressedSize, NULL),
+            EXIT_SUCCESS);
+  getHuffmanStats(&sStats);
+  EXPECT_EQ(sStats.blocksStored, 1U);
+  EXPECT_EQ(sStats.symbolsEncoded, 0U);
+}
+
+/**
+ * @brief Test reading a file is timed as the read stage.
+ *
+ */
+TEST_F(StatsTest, test_readTextFileStage) {
+  char *buffer = (char *)malloc(MAX_FILE_SIZE);
+  ASSERT_NE(buffer, nullptr);
+  ASSERT_EQ(readTextFile("../../data/Example.txt", buffer), EXIT_SUCCESS);
+
+  sHuffmanStats_t sStats;
+  getHuffmanStats(&sStats);
+  EXPECT_EQ(sStats.aStageCalls[HUFFMAN_STAGE_READ], 1U);
+  EXPECT_EQ(sStats.aStageBytes[HUFFMAN_STAGE_READ], strlen(buffer));
+  free(buffer);
+}
+
+/**
+ * @brief Test resetting clears every counter.
+ *
+ */
+TEST_F(StatsTest, test_resetHuffmanStats) {
+  HUFFMAN_STATS_ADD(allocations, 3);
+  resetHuffmanStats();
+
+  sHuffmanStats_t sStats;
+  getHuffmanStats(&sStats);
+  EXPECT_EQ(sStats.allocations, 0U);
+}
+
+/**
+ * @brief Test the statistics are written as JSON.
+ *
+ */
+TEST_F(StatsTest, test_writeHuffmanStatsJson) {
+  sHuffmanStats_t sStats = {};
+  sStats.blocksEncoded = 2;
+  sStats.aStageCalls[HUFFMAN_STAGE_DECODE] = 5;
+  sStats.aCodeLengthHistogram[3] = 7;
+
+  char *buffer = NULL;
+  size_t size = 0;
+  FILE *pFile = open_memstream(&buffer, &size);
+  ASSERT_NE(pFile, nullptr);
+  EXPECT_EQ(writeHuffmanStatsJson(pFile, &sStats), EXIT_SUCCESS);
+  (void)fclose(pFile);
+
+  const std::string json(buffer, size);
+  free(buffer);
+  EXPECT_EQ(json.front(), '{');
+  EXPECT_EQ(json.back(), '}');
+  EXPECT_NE(json.find("\"enabled\": true"), std::string::npos);
+  EXPECT_NE(json.find("\"blocks_encoded\": 2"), std::string::npos);
+  EXPECT_NE(json.find("\"decode\": {\"ns\": 0, \"calls\": 5"),
+            std::string::npos);
+  EXPECT_NE(json.find("\"code_length_histogram\": [0, 0, 0, 7, 0"),
+            std::string::npos);
+}
+
+/**
+ * @brief Test the stage names used in the JSON output.
+ *
+ */
+TEST_F(StatsTest, test_getHuffmanStageName) {
+  EXPECT_STREQ(getHuffmanStageName(HUFFMAN_STAGE_READ), "read");
+  EXPECT_STREQ(getHuffmanStageName(HUFFMAN_STAGE_TREE_BUILD), "tree_build");
+  EXPECT_STREQ(getHuffmanStageName(HUFFMAN_STAGE_IO), "io");
+  EXPECT_STREQ(getHuffmanStageName(HUFFMAN_STAGE_MAX), "unknown");
+}
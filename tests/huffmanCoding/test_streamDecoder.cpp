@@ -0,0 +1,292 @@
+/**
+ * @file test_streamDecoder.cpp
+ * @brief Unit tests for streamDecoder.c.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+/* External Includes */
+
+#include <gtest/gtest.h>
+
+/* Standard Library Includes */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+/* Project Includes */
+
+extern "C" {
+#include "huffmanCoding/codec.h"
+#include "huffmanCoding/streamDecoder.h"
+#include "huffmanCoding/trackingAllocator.h"
+}
+
+/* Test Fixtures */
+
+/**
+ * @brief Stream decoder test fixture.
+ *
+ */
+class StreamDecoderTest : public ::testing::Test {
+ protected:
+  sHuffmanTrackingAllocator_t sTracker;
+  sHuffmanStreamDecoder_t* psDecoder = NULL;
+  std::vector<uint8_t> compressed;
+
+  /**
+   * @brief Create a stream decoder that allocates from the tracker.
+   *
+   */
+  void SetUp() override {
+    initTrackingAllocator(&sTracker, NULL);
+    psDecoder = createStreamDecoder(&sTracker.sAllocator);
+    ASSERT_NE(psDecoder, nullptr);
+  }
+
+  /**
+   * @brief Free the stream decoder.
+   *
+   */
+  void TearDown() override { freeStreamDecoder(psDecoder); }
+
+  /**
+   * @brief Compress an input into the compressed container.
+   *
+   * @param i_input The bytes to compress.
+   * @param i_blockSize The number of uncompressed bytes in each block.
+   * @param i_syncInterval The number of bytes between sync points.
+   * @param i_isChecksumEnabled Whether blocks end with a checksum.
+   */
+  void compress(const std::vector<uint8_t>& i_input,
+                size_t i_blockSize = HUFFMAN_DEFAULT_BLOCK_SIZE,
+                size_t i_syncInterval = 0, bool i_isChecksumEnabled = false) {
+    sHuffmanCompressOptions_t sOptions;
+    initCompressOptions(&sOptions);
+    sOptions.blockSize = i_blockSize;
+    sOptions.syncInterval = i_syncInterval;
+    sOptions.isChecksumEnabled = i_isChecksumEnabled;
+
+    size_t compressedSize = 0;
+    compressed.resize(getCompressBound(i_input.size(), &sOptions));
+    ASSERT_EQ(compressBuffer(i_input.data(), i_input.size(), compressed.data(),
+                             compressed.size(), &compressedSize, &sOptions),
+              EXIT_SUCCESS);
+    compressed.resize(compressedSize);
+  }
+
+  /**
+   * @brief Decode the compressed container in chunks through a small output
+   * window.
+   *
+   * @param i_chunkSize The number of bytes fed to each call.
+   * @param i_windowSize The number of bytes in the output window.
+   * @param o_output The decoded bytes.
+   * @return eHuffmanStreamStatus_t The last status returned.
+   */
+  eHuffmanStreamStatus_t decodeInChunks(size_t i_chunkSize,
+                                        size_t i_windowSize,
+                                        std::vector<uint8_t>& o_output) {
+    std::vector<uint8_t> window(i_windowSize);
+    eHuffmanStreamStatus_t eStatus = HUFFMAN_STREAM_CONTINUE;
+    size_t position = 0;
+
+    resetStreamDecoder(psDecoder);
+    o_output.clear();
+    while (eStatus == HUFFMAN_STREAM_CONTINUE) {
+      const size_t chunkSize =
+          std::min(i_chunkSize, compressed.size() - position);
+      size_t consumed = 0;
+      size_t outputSize = 0;
+      eStatus = decompressStream(psDecoder, compressed.data() + position,
+                                 chunkSize, &consumed, window.data(),
+                                 window.size(), &outputSize);
+      o_output.insert(o_output.end(), window.begin(),
+                      window.begin() + outputSize);
+      position += consumed;
+
+      /* A call that makes no progress on the last chunk has run dry. */
+      if (eStatus == HUFFMAN_STREAM_CONTINUE && consumed == 0 &&
+          outputSize == 0) {
+        break;
+      }
+    }
+
+    return eStatus;
+  }
+};
+
+/* Unit Tests */
+
+/**
+ * @brief Test decoding in chunks of every size up to a word, and through
+ * output windows of a single byte, splitting headers and codes.
+ *
+ */
+TEST_F(StreamDecoderTest, test_decompressStream_Chunks) {
+  std::vector<uint8_t> input;
+  size_t previous = 1;
+  size_t current = 1;
+  for (uint8_t symbol = 0; symbol < 20; symbol++) {
+    input.insert(input.end(), current, symbol);
+    const size_t next = previous + current;
+    previous = current;
+    current = next;
+  }
+  std::shuffle(input.begin(), input.end(), std::mt19937(7));
+  input.insert(input.end(), 300, 'x');
+  compress(input, 4096);
+
+  std::vector<uint8_t> output;
+  for (size_t chunkSize = 1; chunkSize <= 9; chunkSize++) {
+    ASSERT_EQ(decodeInChunks(chunkSize, 4096, output), HUFFMAN_STREAM_END);
+    ASSERT_EQ(output, input) << "chunk size " << chunkSize;
+  }
+  ASSERT_EQ(decodeInChunks(compressed.size(), 1, output), HUFFMAN_STREAM_END);
+  ASSERT_EQ(output, input);
+  ASSERT_EQ(decodeInChunks(4096, 13, output), HUFFMAN_STREAM_END);
+  ASSERT_EQ(output, input);
+}
+
+/**
+ * @brief Test decoding stored blocks, empty containers and inputs with a
+ * single symbol.
+ *
+ */
+TEST_F(StreamDecoderTest, test_decompressStream_Edges) {
+  std::vector<uint8_t> output;
+
+  std::vector<uint8_t> random(5000);
+  std::mt19937 generator(8);
+  for (uint8_t& byte : random) {
+    byte = (uint8_t)generator();
+  }
+  compress(random, 1000);
+  ASSERT_EQ(decodeInChunks(333, 77, output), HUFFMAN_STREAM_END);
+  ASSERT_EQ(output, random);
+
+  compress({});
+  ASSERT_EQ(decodeInChunks(3, 1, output), HUFFMAN_STREAM_END);
+  ASSERT_TRUE(output.empty());
+
+  const std::vector<uint8_t> single(2000, 'q');
+  compress(single, 512);
+  ASSERT_EQ(decodeInChunks(5, 100, output), HUFFMAN_STREAM_END);
+  ASSERT_EQ(output, single);
+}
+
+/**
+ * @brief Test blocks with sync points are decoded, with the sync points
+ * split across chunks.
+ *
+ */
+TEST_F(StreamDecoderTest, test_decompressStream_SyncPoints) {
+  std::vector<uint8_t> input(20000);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] = (uint8_t)("etaoinshrdlu"[(i * 7) % 12]);
+  }
+  compress(input, 8192, 32);
+  ASSERT_EQ(compressed[HUFFMAN_HEADER_SIZE + 8],
+            HUFFMAN_BLOCK_FLAG_SYNC_POINTS);
+
+  std::vector<uint8_t> output;
+  for (size_t chunkSize : {1, 5, 4096}) {
+    ASSERT_EQ(decodeInChunks(chunkSize, 1000, output), HUFFMAN_STREAM_END);
+    ASSERT_EQ(output, input) << "chunk size " << chunkSize;
+  }
+}
+
+/**
+ * @brief Test block checksums are verified across chunks and windows, for
+ * stored and coded blocks.
+ *
+ */
+TEST_F(StreamDecoderTest, test_decompressStream_Checksum) {
+  std::vector<uint8_t> input(6000);
+  std::mt19937 generator(10);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] = (i < 2000) ? (uint8_t)generator() : (uint8_t)("acgt"[i % 4]);
+  }
+  compress(input, 2000, 0, true);
+  const std::vector<uint8_t> original = compressed;
+
+  std::vector<uint8_t> output;
+  for (size_t chunkSize : {1, 3, 4096}) {
+    ASSERT_EQ(decodeInChunks(chunkSize, 333, output), HUFFMAN_STREAM_END);
+    ASSERT_EQ(output, input) << "chunk size " << chunkSize;
+  }
+
+  /* A byte of the stored first block, and the checksum of the second. */
+  compressed[HUFFMAN_HEADER_SIZE + HUFFMAN_BLOCK_HEADER_SIZE] ^= 0x01;
+  ASSERT_EQ(decodeInChunks(7, 100, output), HUFFMAN_STREAM_ERROR);
+  compressed = original;
+  compressed[HUFFMAN_HEADER_SIZE + (2 * HUFFMAN_BLOCK_HEADER_SIZE) + 2000 +
+             HUFFMAN_CHECKSUM_SIZE + HUFFMAN_CODE_LENGTHS_SIZE + 500] ^= 0x01;
+  ASSERT_EQ(decodeInChunks(7, 100, output), HUFFMAN_STREAM_ERROR);
+}
+
+/**
+ * @brief Test the stream decoder only ever uses the memory allocated when it
+ * was created, however large the container.
+ *
+ */
+TEST_F(StreamDecoderTest, test_decompressStream_BoundedMemory) {
+  std::vector<uint8_t> input(1 << 20);
+  std::mt19937 generator(9);
+  std::geometric_distribution<int> distribution(0.1);
+  for (uint8_t& byte : input) {
+    byte = (uint8_t)distribution(generator);
+  }
+  compress(input);
+
+  std::vector<uint8_t> output;
+  ASSERT_EQ(decodeInChunks(65536, 16384, output), HUFFMAN_STREAM_END);
+  ASSERT_EQ(output, input);
+
+  ASSERT_EQ(sTracker.sTotal.allocations, 1U);
+  ASSERT_EQ(sTracker.sTotal.peakBytes, getStreamDecoderSize());
+  ASSERT_LT(getStreamDecoderSize(), 8192U);
+}
+
+/**
+ * @brief Test a truncated or corrupted container is rejected.
+ *
+ */
+TEST_F(StreamDecoderTest, test_decompressStream_Corrupted) {
+  std::vector<uint8_t> input(3000);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] = (uint8_t)((i * i) % 23);
+  }
+  compress(input, 1000);
+  const std::vector<uint8_t> original = compressed;
+  std::vector<uint8_t> output;
+
+  /* Without the trailer the stream never ends. */
+  compressed.resize(compressed.size() - 1);
+  ASSERT_EQ(decodeInChunks(64, 256, output), HUFFMAN_STREAM_CONTINUE);
+
+  compressed = original;
+  compressed[0] = 'X';
+  ASSERT_EQ(decodeInChunks(64, 256, output), HUFFMAN_STREAM_ERROR);
+
+  /* A block index entry that does not match its block. */
+  compressed = original;
+  compressed[compressed.size() - HUFFMAN_TRAILER_SIZE - 8] ^= 0x01;
+  ASSERT_EQ(decodeInChunks(64, 256, output), HUFFMAN_STREAM_ERROR);
+
+  /* A trailer whose size does not match the blocks. */
+  compressed = original;
+  compressed[compressed.size() - HUFFMAN_TRAILER_SIZE] ^= 0x01;
+  ASSERT_EQ(decodeInChunks(64, 256, output), HUFFMAN_STREAM_ERROR);
+
+  /* The decoder recovers once reset. */
+  compressed = original;
+  ASSERT_EQ(decodeInChunks(64, 256, output), HUFFMAN_STREAM_END);
+  ASSERT_EQ(output, input);
+}
@@ -96,3 +96,48 @@ TEST_F(Task4Test, test_createLetterFrequencyListFromText) {
   ASSERT_EQ(psN->sLetterFrequencyPair.frequency, 1);
   ASSERT_EQ(psN->psNext, nullptr);
 }
+
+/**
+ * @brief Test counting the byte frequencies of a buffer containing NULL bytes.
+ *
+ */
+TEST_F(Task4Test, test_countByteFrequencies) {
+  const uint8_t data[] = {0x00, 'a', 0xFF, 'a', 0x00, 'a'};
+  size_t aFrequencies[LETTER_FREQUENCY_ALPHABET_SIZE];
+
+  countByteFrequencies(data, sizeof(data), aFrequencies);
+
+  ASSERT_EQ(aFrequencies[0x00], 2);
+  ASSERT_EQ(aFrequencies['a'], 3);
+  ASSERT_EQ(aFrequencies[0xFF], 1);
+  ASSERT_EQ(aFrequencies['b'], 0);
+}
+
+/**
+ * @brief Test creating a letter-frequency linked list from a frequency table.
+ *
+ */
+TEST_F(Task4Test, test_createLetterFrequencyListFromFrequencies) {
+  size_t aFrequencies[LETTER_FREQUENCY_ALPHABET_SIZE] = {0};
+  aFrequencies['z'] = 1;
+  aFrequencies['a'] = 4;
+  aFrequencies[0xFF] = 2;
+
+  int retcode = createLetterFrequencyListFromFrequencies(&psHead, aFrequencies);
+
+  ASSERT_EQ(retcode, EXIT_SUCCESS);
+
+  /* Assert the pairs are in ascending byte order. */
+  sLetterFrequencyNode_t* psA = psHead;
+  ASSERT_EQ(psA->sLetterFrequencyPair.character, 'a');
+  ASSERT_EQ(psA->sLetterFrequencyPair.frequency, 4);
+
+  sLetterFrequencyNode_t* psZ = psA->psNext;
+  ASSERT_EQ(psZ->sLetterFrequencyPair.character, 'z');
+  ASSERT_EQ(psZ->sLetterFrequencyPair.frequency, 1);
+
+  sLetterFrequencyNode_t* psFF = psZ->psNext;
+  ASSERT_EQ((uint8_t)psFF->sLetterFrequencyPair.character, 0xFF);
+  ASSERT_EQ(psFF->sLetterFrequencyPair.frequency, 2);
+  ASSERT_EQ(psFF->psNext, nullptr);
+}
@@ -85,6 +85,13 @@ TEST_F(Task6Test, test_createBinaryTreeNodeListFromLetterFrequencyPairList) {
   sBinaryTreeListNode_t* psW = psZ->psNext;
   ASSERT_EQ(psW->psBinaryTreeNode->psLetterFrequencyPair->character, 'w');
   ASSERT_EQ(psW->psBinaryTreeNode->psLetterFrequencyPair->frequency, 3);
+
+  /* Assert each binary tree node is created as a leaf node. */
+  for (sBinaryTreeListNode_t* psCurrent = psHead; psCurrent != NULL;
+       psCurrent = psCurrent->psNext) {
+    ASSERT_EQ(psCurrent->psBinaryTreeNode->psLeftChild, nullptr);
+    ASSERT_EQ(psCurrent->psBinaryTreeNode->psRightChild, nullptr);
+  }
 }
 
 /**
@@ -163,3 +170,25 @@ TEST_F(Task6Test, test_popLowestFrequencyBinaryTreeNode_singleItemList) {
   /* Assert the list is now empty. */
   ASSERT_EQ(psHead, nullptr);
 }
+
+/**
+ * @brief Test pushing an existing binary tree node onto the end of the list.
+ *
+ */
+TEST_F(Task6Test, test_pushBinaryTreeNode) {
+  (void)createLetterFrequencyListFromText(&psLetterFrequencyHead, "xxyyy");
+  (void)createBinaryTreeNodeListFromLetterFrequencyPairList(
+      &psHead, psLetterFrequencyHead);
+
+  sBinaryTreeNode_t* psLeftChild = popLowestFrequencyBinaryTreeNode(&psHead);
+  sBinaryTreeNode_t* psRightChild = popLowestFrequencyBinaryTreeNode(&psHead);
+  sBinaryTreeNode_t* psParent =
+      mergeBinaryTreeNodes(psLeftChild, psRightChild);
+
+  int retcode = pushBinaryTreeNode(&psHead, psParent);
+
+  ASSERT_EQ(retcode, EXIT_SUCCESS);
+  ASSERT_EQ(psHead->psBinaryTreeNode, psParent);
+  ASSERT_EQ(psHead->psNext, nullptr);
+  ASSERT_EQ(psHead->psBinaryTreeNode->psLetterFrequencyPair->frequency, 5);
+}
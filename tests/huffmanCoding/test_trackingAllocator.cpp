@@ -0,0 +1,184 @@
+/**
+ * @file test_trackingAllocator.cpp
+ * @brief Unit tests for trackingAllocator.c.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ *
+ */
+
+/* External Includes */
+
+#include <gtest/gtest.h>
+
+/* Standard Library Includes */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+/* Project Includes */
+
+extern "C" {
+#include "huffmanCoding/allocator.h"
+#include "huffmanCoding/codec.h"
+#include "huffmanCoding/stats.h"
+#include "huffmanCoding/trackingAllocator.h"
+}
+
+/* Test Fixtures */
+
+/**
+ * @brief Tracking allocator test fixture.
+ *
+ */
+class TrackingAllocatorTest : public ::testing::Test {
+ protected:
+  sHuffmanTrackingAllocator_t sTracker;
+
+  void SetUp() override { initTrackingAllocator(&sTracker, NULL); }
+};
+
+/* Unit Tests */
+
+/**
+ * @brief Test allocations are attributed to the current stage.
+ *
+ */
+TEST_F(TrackingAllocatorTest, test_stageAttribution) {
+  const eHuffmanStage_t ePrevious =
+      setHuffmanAllocationStage(HUFFMAN_STAGE_TREE_BUILD);
+  void* pFirst = allocateHuffmanMemory(&sTracker.sAllocator, 100);
+  void* pSecond = allocateHuffmanMemory(&sTracker.sAllocator, 28);
+  (void)setHuffmanAllocationStage(ePrevious);
+  ASSERT_NE(pFirst, nullptr);
+  ASSERT_NE(pSecond, nullptr);
+
+  /* Memory stays attributed to the stage that allocated it. */
+  freeHuffmanMemory(&sTracker.sAllocator, pFirst);
+  void* pThird = allocateHuffmanMemory(&sTracker.sAllocator, 10);
+  ASSERT_NE(pThird, nullptr);
+
+  const sHuffmanAllocationStats_t& sTreeBuild =
+      sTracker.aStages[HUFFMAN_STAGE_TREE_BUILD];
+  EXPECT_EQ(sTreeBuild.allocations, 2U);
+  EXPECT_EQ(sTreeBuild.frees, 1U);
+  EXPECT_EQ(sTreeBuild.currentBytes, 28U);
+  EXPECT_EQ(sTreeBuild.peakBytes, 128U);
+  EXPECT_EQ(sTracker.aStages[HUFFMAN_STAGE_MAX].allocations, 1U);
+  EXPECT_EQ(sTracker.sTotal.currentBytes, 38U);
+  EXPECT_EQ(sTracker.sTotal.peakBytes, 128U);
+
+  freeHuffmanMemory(&sTracker.sAllocator, pSecond);
+  freeHuffmanMemory(&sTracker.sAllocator, pThird);
+  EXPECT_EQ(sTracker.sTotal.currentBytes, 0U);
+  EXPECT_EQ(sTracker.sTotal.frees, 3U);
+
+  resetTrackingAllocator(&sTracker);
+  EXPECT_EQ(sTracker.sTotal.allocations, 0U);
+  EXPECT_EQ(sTracker.sTotal.peakBytes, 0U);
+}
+
+/**
+ * @brief Test a compression round trip reports memory per stage.
+ *
+ */
+TEST_F(TrackingAllocatorTest, test_roundTripPerStage) {
+  /* Fibonacci frequencies need codes longer than the decode table. */
+  std::vector<uint8_t> input;
+  size_t previous = 1;
+  size_t current = 1;
+  for (int symbol = 0; symbol < 16; symbol++) {
+    input.insert(input.end(), current, (uint8_t)('A' + symbol));
+    const size_t next = previous + current;
+    previous = current;
+    current = next;
+  }
+
+  sHuffmanCompressOptions_t sOptions;
+  initCompressOptions(&sOptions);
+  sOptions.psAllocator = &sTracker.sAllocator;
+
+  std::vector<uint8_t> compressed(getCompressBound(input.size(), &sOptions));
+  size_t compressedSize = 0;
+  ASSERT_EQ(compressBuffer(input.data(), input.size(), compressed.data(),
+                           compressed.size(), &compressedSize, &sOptions),
+            EXIT_SUCCESS);
+
+  std::vector<uint8_t> output(input.size());
+  size_t outputSize = 0;
+  ASSERT_EQ(decompressBuffer(compressed.data(), compressedSize, output.data(),
+                             output.size(), &outputSize),
+            EXIT_SUCCESS);
+  EXPECT_EQ(output, input);
+
+  const sHuffmanAllocationStats_t& sTreeBuild =
+      sTracker.aStages[HUFFMAN_STAGE_TREE_BUILD];
+  EXPECT_GT(sTreeBuild.allocations, 0U);
+  EXPECT_GT(sTreeBuild.peakBytes, 0U);
+  EXPECT_EQ(sTracker.aStages[HUFFMAN_STAGE_MAX].allocations, 0U);
+  EXPECT_EQ(sTracker.sTotal.allocations, sTreeBuild.allocations);
+  EXPECT_EQ(sTracker.sTotal.allocations, sTracker.sTotal.frees);
+  EXPECT_EQ(sTracker.sTotal.currentBytes, 0U);
+}
+
+/**
+ * @brief Test the deprecated decompressBufferWithAllocator still decodes,
+ * and leaves its allocator unused now that decoding never allocates.
+ *
+ */
+TEST_F(TrackingAllocatorTest, test_decompressBufferWithAllocator) {
+  /* Fibonacci frequencies need codes longer than the decode table. */
+  std::vector<uint8_t> input;
+  size_t previous = 1;
+  size_t current = 1;
+  for (int symbol = 0; symbol < 16; symbol++) {
+    input.insert(input.end(), current, (uint8_t)('A' + symbol));
+    const size_t next = previous + current;
+    previous = current;
+    current = next;
+  }
+  std::vector<uint8_t> compressed(getCompressBound(input.size(), NULL));
+  size_t compressedSize = 0;
+  ASSERT_EQ(compressBuffer(input.data(), input.size(), compressed.data(),
+                           compressed.size(), &compressedSize, NULL),
+            EXIT_SUCCESS);
+
+  std::vector<uint8_t> output(input.size());
+  size_t outputSize = 0;
+  ASSERT_EQ(decompressBufferWithAllocator(compressed.data(), compressedSize,
+                                          output.data(), output.size(),
+                                          &outputSize, &sTracker.sAllocator),
+            EXIT_SUCCESS);
+  EXPECT_EQ(output, input);
+  EXPECT_EQ(sTracker.sTotal.allocations, 0U);
+}
+
+/**
+ * @brief Test the counters are written as JSON.
+ *
+ */
+TEST_F(TrackingAllocatorTest, test_writeTrackingAllocatorJson) {
+  void* pMemory = allocateHuffmanMemory(&sTracker.sAllocator, 64);
+  ASSERT_NE(pMemory, nullptr);
+
+  char* buffer = NULL;
+  size_t size = 0;
+  FILE* pFile = open_memstream(&buffer, &size);
+  ASSERT_NE(pFile, nullptr);
+  EXPECT_EQ(writeTrackingAllocatorJson(pFile, &sTracker), EXIT_SUCCESS);
+  (void)fclose(pFile);
+  freeHuffmanMemory(&sTracker.sAllocator, pMemory);
+
+  const std::string json(buffer, size);
+  free(buffer);
+  EXPECT_NE(json.find("\"total\": {\"allocations\": 1, \"frees\": 0, "
+                      "\"current_bytes\": 64, \"peak_bytes\": 64}"),
+            std::string::npos);
+  EXPECT_NE(json.find("\"tree_build\": {\"allocations\": 0"),
+            std::string::npos);
+  EXPECT_NE(json.find("\"none\": {\"allocations\": 1"), std::string::npos);
+}
@@ -0,0 +1,45 @@
+/**
+ * @file testUtils.hpp
+ * @brief Shared input generators for the unit tests and benchmarks.
+ * @date 2026-10-19
+ *
+ * Copyright (c) 2024 Oliver Parsons
+ */
+
+#ifndef TEST_UTILS_HPP
+#define TEST_UTILS_HPP
+
+/* Standard Library Includes */
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+/* Function Definitions */
+
+/**
+ * @brief Generate bytes with a geometric distribution.
+ *
+ * Byte value k has probability p * (1 - p)^k, so small probabilities give
+ * codes of every length up to the maximum and large ones give a few short
+ * codes.
+ *
+ * @param i_size The number of bytes to generate.
+ * @param i_probability The distribution's parameter, p.
+ * @param i_seed The seed for the pseudo-random generator.
+ * @return std::vector<uint8_t> The generated bytes.
+ */
+inline std::vector<uint8_t> generateGeometricBytes(size_t i_size,
+                                                   double i_probability,
+                                                   uint32_t i_seed) {
+  std::mt19937 generator(i_seed);
+  std::geometric_distribution<int> distribution(i_probability);
+  std::vector<uint8_t> bytes(i_size);
+  for (uint8_t& byte : bytes) {
+    byte = (uint8_t)distribution(generator);
+  }
+  return bytes;
+}
+
+#endif  // TEST_UTILS_HPP